@@ -100,6 +100,10 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
     connect(&_requestTimer, SIGNAL(timeout()), SLOT(sendAssignmentRequest()));
     _requestTimer.start(ASSIGNMENT_REQUEST_INTERVAL_MSECS);
 
+    // while we wait, do the expensive part of the assignment setup, so that we can take over
+    // immediately when the domain-server hands us one to replace a failed assignment-client
+    AssignmentFactory::prepareForStandby(requestAssignmentType);
+
     // connections to AccountManager for authentication
     connect(DependencyManager::get<AccountManager>().data(), &AccountManager::authRequired,
             this, &AssignmentClient::handleAuthenticationRequest);
@@ -163,15 +167,25 @@ void AssignmentClient::sendStatusPacketToACM() {
     auto nodeList = DependencyManager::get<NodeList>();
     
     quint8 assignmentType = Assignment::Type::AllTypes;
+    QUuid assignmentUUID;
 
     if (_currentAssignment) {
         assignmentType = _currentAssignment->getType();
+        assignmentUUID = _currentAssignment->getUUID();
     }
 
-    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus, sizeof(assignmentType) + NUM_BYTES_RFC4122_UUID);
+    qint64 processID = QCoreApplication::applicationPid();
+
+    auto statusPacket = NLPacket::create(PacketType::AssignmentClientStatus,
+                                         NUM_BYTES_RFC4122_UUID + sizeof(assignmentType) + NUM_BYTES_RFC4122_UUID + sizeof(processID));
 
     statusPacket->write(_childAssignmentUUID.toRfc4122());
     statusPacket->writePrimitive(assignmentType);
+
+    // let the monitor know which deployed assignment we run and who we are, so that if this process dies
+    // it can tell the domain-server right away instead of waiting for our node to go silent
+    statusPacket->write(assignmentUUID.toRfc4122());
+    statusPacket->writePrimitive(processID);
     
     nodeList->sendPacket(std::move(statusPacket), _assignmentClientMonitorSocket);
 }
@@ -324,4 +338,6 @@ void AssignmentClient::assignmentCompleted() {
     nodeList->resetNodeInterestSet();
     
     _isAssigned = false;
+
+    AssignmentFactory::prepareForStandby(_requestAssignment.getType());
 }
@@ -22,8 +22,16 @@ public:
     Assignment::Type getChildType() { return _childType; }
     void setChildType(Assignment::Type childType) { _childType = childType; }
 
+    const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
+    void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
+
+    qint64 getProcessID() const { return _processID; }
+    void setProcessID(qint64 processID) { _processID = processID; }
+
 private:
     Assignment::Type _childType;
+    QUuid _assignmentUUID;
+    qint64 _processID { 0 };
 };
 
 #endif // hifi_AssignmentClientChildData_h
@@ -122,10 +122,64 @@ void AssignmentClientMonitor::childProcessFinished(qint64 pid, quint16 listenPor
             qCritical() << qPrintable(message.arg("crashed"));
             break;
     }
+
+    // if the child was running an assignment, tell the domain-server right away so it can hand it to a standby
+    // child, rather than have it wait for the dead node to go silent
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer childNode;
+    nodeList->eachNodeBreakable([&](const SharedNodePointer& node) {
+        auto childData = static_cast<AssignmentClientChildData*>(node->getLinkedData());
+        if (childData && childData->getProcessID() == pid) {
+            childNode = node;
+            return false;
+        }
+        return true;
+    });
+
+    if (childNode) {
+        auto childData = static_cast<AssignmentClientChildData*>(childNode->getLinkedData());
+        if (!childData->getAssignmentUUID().isNull()) {
+            sendAssignmentClientFailed(childData->getAssignmentUUID());
+        }
+        nodeList->killNodeWithUUID(childNode->getUUID());
+    }
+
+    // make sure a spare is ready to take over the next failure
+    if (!_isStopping) {
+        QTimer::singleShot(0, this, &AssignmentClientMonitor::checkSpares);
+    }
+}
+
+void AssignmentClientMonitor::sendAssignmentClientFailed(const QUuid& assignmentUUID) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    QString hostname = _assignmentServerHostname.isEmpty() ? DEFAULT_ASSIGNMENT_SERVER_HOSTNAME : _assignmentServerHostname;
+    quint16 port = _assignmentServerPort;
+    if (hostname == "localhost") {
+        // the children check the local domain-server port in case it restarted, do the same
+        quint16 localAssignmentServerPort;
+        if (nodeList->getLocalServerPortFromSharedMemory(DOMAIN_SERVER_LOCAL_PORT_SMEM_KEY, localAssignmentServerPort)
+            && localAssignmentServerPort != 0) {
+            port = localAssignmentServerPort;
+        }
+    }
+
+    HifiSockAddr assignmentServerSocket { hostname, port, true };
+    if (assignmentServerSocket.isNull()) {
+        qWarning() << "Could not resolve domain-server address" << hostname << "to report failed assignment";
+        return;
+    }
+
+    qDebug() << "Reporting failed assignment" << uuidStringWithoutCurlyBraces(assignmentUUID) << "to" << assignmentServerSocket;
+
+    auto failedPacket = NLPacket::create(PacketType::AssignmentClientFailed, NUM_BYTES_RFC4122_UUID);
+    failedPacket->write(assignmentUUID.toRfc4122());
+    nodeList->sendPacket(std::move(failedPacket), assignmentServerSocket);
 }
 
 void AssignmentClientMonitor::stopChildProcesses() {
     qDebug() << "Stopping child processes";
+    _isStopping = true;
     auto nodeList = DependencyManager::get<NodeList>();
 
     // ask child processes to terminate
@@ -370,6 +424,14 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
 
         childData->setChildType(Assignment::Type(assignmentType));
 
+        // newer children also tell us the deployed assignment they run and their process ID
+        qint64 processID;
+        if (message->getBytesLeftToRead() >= NUM_BYTES_RFC4122_UUID + (qint64)sizeof(processID)) {
+            childData->setAssignmentUUID(QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID)));
+            message->readPrimitive(&processID);
+            childData->setProcessID(processID);
+        }
+
         // note when this child talked
         matchingNode->setLastHeardMicrostamp(usecTimestampNow());
     }
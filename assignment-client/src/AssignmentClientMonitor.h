@@ -55,6 +55,7 @@ public slots:
 
 private:
     void spawnChildClient();
+    void sendAssignmentClientFailed(const QUuid& assignmentUUID);
     void simultaneousWaitOnChildren(int waitMsecs);
     void adjustOSResources(unsigned int numForks) const;
 
@@ -80,6 +81,7 @@ private:
     QSet<quint16> _childListenPorts;
 
     bool _wantsChildFileLogging { false };
+    bool _isStopping { false };
 };
 
 #endif // hifi_AssignmentClientMonitor_h
@@ -17,6 +17,7 @@
 #include "assets/AssetServer.h"
 #include "audio/AudioMixer.h"
 #include "avatars/AvatarMixer.h"
+#include "entities/EntityPhysicsServer.h"
 #include "entities/EntityServer.h"
 #include "messages/MessagesMixer.h"
 #include "scripts/EntityScriptServer.h"
@@ -45,7 +46,21 @@ ThreadedAssignment* AssignmentFactory::unpackAssignment(ReceivedMessage& message
             return new MessagesMixer(message);
         case Assignment::EntityScriptServerType:
             return new EntityScriptServer(message);
+        case Assignment::EntityPhysicsServerType:
+            return new EntityPhysicsServer(message);
         default:
             return nullptr;
     }
 }
+
+void AssignmentFactory::prepareForStandby(Assignment::Type type) {
+    // plugin loading happens once per process with the filter of the first plugin manager, so
+    // only prepare for assignment types this client is dedicated to
+    switch (type) {
+        case Assignment::AudioMixerType:
+            AudioMixer::prepareForStandby();
+            break;
+        default:
+            break;
+    }
+}
@@ -17,6 +17,10 @@
 class AssignmentFactory {
 public:
     static ThreadedAssignment* unpackAssignment(ReceivedMessage& message);
+
+    // Performs the setup that does not depend on the domain ahead of time, for an idle assignment-client
+    // waiting on an assignment of the given type as a hot standby.
+    static void prepareForStandby(Assignment::Type type);
 };
 
 #endif // hifi_AssignmentFactory_h
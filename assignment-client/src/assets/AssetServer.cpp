@@ -113,11 +113,16 @@ QString getBakeMapping(const AssetUtils::AssetHash& hash, const QString& relativ
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
+// the oven keeps what it baked here, so textures shared by several uploaded models are only baked once. It is next to the
+// assets rather than in the default folders of the oven or Interface, whose caches evict their files on their own
+static const QString BAKED_CACHE_SUBDIR = "baked_cache";
+
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath,
+                                                     _resourcesDirectory.absoluteFilePath(BAKED_CACHE_SUBDIR));
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
@@ -25,7 +25,9 @@
 class BakeAssetTask : public QObject, public QRunnable {
     Q_OBJECT
 public:
-    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+    // Bakes reuse what the oven has baked before from bakedCacheDirectory, when it is set
+    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                  const QString& bakedCacheDirectory = QString());
 
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
@@ -46,6 +48,7 @@ private:
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
+    QString _bakedCacheDirectory;
     std::unique_ptr<QProcess> _ovenProcess { nullptr };
     std::atomic<bool> _wasAborted { false };
 };
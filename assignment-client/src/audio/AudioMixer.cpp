@@ -17,6 +17,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonValue>
+#include <QtCore/QTimer>
 #include <shared/QtHelpers.h>
 
 #include <LogHandler.h>
@@ -48,6 +49,7 @@ static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
 static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
+static const int SHARD_HANDOFF_CHECK_INTERVAL_MSECS = 1000;
 
 int AudioMixer::_numStaticJitterFrames{ DISABLE_STATIC_JITTER_FRAMES };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
@@ -57,6 +59,7 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 vector<AudioMixer::ZoneDescription> AudioMixer::_audioZones;
 vector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 vector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+AudioMixerShards AudioMixer::_shards;
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -66,17 +69,21 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     // This prevents previous assignment settings from sticking around
     clearDomainSettings();
 
+    // a mixer for one shard of a domain is handed "--shard <index>" as its payload
+    _shards.setShard(AudioMixerShards::NO_SHARD);
+    QStringList payloadArguments = QString(getPayload()).split(" ", QString::SkipEmptyParts);
+    int shardArgumentIndex = payloadArguments.indexOf("--shard");
+    if (shardArgumentIndex >= 0 && shardArgumentIndex + 1 < payloadArguments.size()) {
+        bool ok;
+        int shard = payloadArguments[shardArgumentIndex + 1].toInt(&ok);
+        if (ok && shard >= 0) {
+            _shards.setShard(shard);
+        }
+    }
+
     // hash the available codecs (on the mixer)
     _availableCodecs.clear(); // Make sure struct is clean
-    auto pluginManager = DependencyManager::set<PluginManager>();
-    // Only load codec plugins; for now assume codec plugins have 'codec' in their name.
-    auto codecPluginFilter = [](const QJsonObject& metaData) {
-        QJsonValue nameValue = metaData["MetaData"]["name"];
-        return nameValue.toString().contains("codec", Qt::CaseInsensitive);
-    };
-    pluginManager->setPluginFilter(codecPluginFilter);
-
-    auto codecPlugins = pluginManager->getCodecPlugins();
+    auto codecPlugins = getCodecPluginManager()->getCodecPlugins();
     for_each(codecPlugins.cbegin(), codecPlugins.cend(),
         [&](const CodecPluginPointer& codec) {
             _availableCodecs[codec->getName()] = codec;
@@ -107,6 +114,7 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
     packetReceiver.registerListener(PacketType::NodeMuteRequest, this, "handleNodeMuteRequestPacket");
     packetReceiver.registerListener(PacketType::KillAvatar, this, "handleKillAvatarPacket");
+    packetReceiver.registerListener(PacketType::AudioShardPeers, this, "handleAudioShardPeersPacket");
 
     packetReceiver.registerListenerForTypes({
         PacketType::ReplicatedMicrophoneAudioNoEcho,
@@ -118,6 +126,43 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     );
 
     connect(nodeList.data(), &NodeList::nodeKilled, this, &AudioMixer::handleNodeKilled);
+
+    if (_shards.getShard() != AudioMixerShards::NO_SHARD) {
+        // the agents homed on the mixers of the other shards never talk to us, at most their streams are forwarded to us,
+        // so we leave it to the domain-server to tell us when agents leave rather than drop them as silent
+        connect(nodeList.data(), &NodeList::nodeAdded, this, [](SharedNodePointer node) {
+            if (node->getType() == NodeType::Agent && !node->isReplicated()) {
+                node->setIsForcedNeverSilent(true);
+            }
+        });
+    }
+}
+
+QSharedPointer<PluginManager> AudioMixer::getCodecPluginManager() {
+    // re-use the plugin manager of a standby preparation, its codecs are already loaded
+    if (DependencyManager::isSet<PluginManager>()) {
+        return DependencyManager::get<PluginManager>();
+    }
+
+    auto pluginManager = DependencyManager::set<PluginManager>();
+    // Only load codec plugins; for now assume codec plugins have 'codec' in their name.
+    auto codecPluginFilter = [](const QJsonObject& metaData) {
+        QJsonValue nameValue = metaData["MetaData"]["name"];
+        return nameValue.toString().contains("codec", Qt::CaseInsensitive);
+    };
+    pluginManager->setPluginFilter(codecPluginFilter);
+    return pluginManager;
+}
+
+void AudioMixer::prepareForStandby() {
+    // loading and initializing the codec plugins is the slowest part of standing up a mixer
+    getCodecPluginManager()->getCodecPlugins();
+
+    // run the HRTF once so that its kernels are dispatched and its tables are paged in
+    int16_t input[HRTF_BLOCK] = {};
+    float output[2 * HRTF_BLOCK] = {};
+    AudioHRTF hrtf;
+    hrtf.render(input, output, 0, 0.0f, 1.0f, 0.0f, HRTF_BLOCK);
 }
 
 void AudioMixer::aboutToFinish() {
@@ -139,6 +184,25 @@ void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> mess
     // Node ID is now part of user data, since replicated audio packets are non-sourced.
     QUuid nodeID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
 
+    PacketType rewrittenType = PacketTypeEnum::getReplicatedPacketMapping().key(message->getType());
+
+    if (_shards.isPeer(message->getSenderSockAddr())) {
+        // this is the stream of an agent homed on the mixer of a neighbouring shard,
+        // which we already know about from the domain-server - queue it as if the agent had sent it to us
+        auto forwardedNode = nodeList->nodeWithUUID(nodeID);
+        if (!forwardedNode || forwardedNode->isUpstream() || rewrittenType == PacketType::Unknown) {
+            return;
+        }
+
+        auto forwardedMessage = QSharedPointer<ReceivedMessage>::create(message->getMessage().mid(NUM_BYTES_RFC4122_UUID),
+                                                                        rewrittenType, versionForPacketType(rewrittenType),
+                                                                        message->getSenderSockAddr(),
+                                                                        forwardedNode->getLocalID());
+
+        getOrCreateClientData(forwardedNode.data())->queuePacket(forwardedMessage, forwardedNode);
+        return;
+    }
+
     auto replicatedNode = nodeList->addOrUpdateNode(nodeID, NodeType::Agent,
                                                     message->getSenderSockAddr(), message->getSenderSockAddr(),
                                                     Node::NULL_LOCAL_ID, true, true);
@@ -147,8 +211,6 @@ void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> mess
     // construct a "fake" audio received message from the byte array and packet list information
     auto audioData = message->getMessage().mid(NUM_BYTES_RFC4122_UUID);
 
-    PacketType rewrittenType = PacketTypeEnum::getReplicatedPacketMapping().key(message->getType());
-
     if (rewrittenType == PacketType::Unknown) {
         qCDebug(audio) << "Cannot unwrap replicated packet type not present in REPLICATED_PACKET_WRAPPING";
     }
@@ -243,6 +305,68 @@ void AudioMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet,
     }
 }
 
+void AudioMixer::handleAudioShardPeersPacket(QSharedPointer<ReceivedMessage> message) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // this packet is non-sourced, so make sure it came from our domain-server
+    if (message->getSenderSockAddr() != nodeList->getDomainHandler().getSockAddr()) {
+        return;
+    }
+
+    QDataStream packetStream(message->getMessage());
+
+    quint8 numPeers;
+    packetStream >> numPeers;
+
+    AudioMixerShards::Peers peers;
+    for (int i = 0; i < numPeers; ++i) {
+        quint8 shard;
+        HifiSockAddr publicSocket;
+        HifiSockAddr localSocket;
+        packetStream >> shard >> publicSocket >> localSocket;
+
+        // mixers behind the same public address as us are reached on their local socket
+        bool isLocalPeer = publicSocket.getAddress() == nodeList->getPublicSockAddr().getAddress();
+        peers.push_back({ shard, isLocalPeer ? localSocket : publicSocket });
+    }
+
+    qCDebug(audio) << "Mixing shard" << _shards.getShard() << "with" << peers.size() << "neighbouring shard mixers";
+    _shards.setPeers(std::move(peers));
+}
+
+void AudioMixer::checkShardHandoffs() {
+    if (!_shards.isEnabled()) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto& domainHandler = nodeList->getDomainHandler();
+    if (!domainHandler.isConnected()) {
+        return;
+    }
+
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        auto clientData = dynamic_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (node->getType() != NodeType::Agent || node->isUpstream() || !clientData || clientData->isShardForwarded()) {
+            return;
+        }
+
+        auto avatarAudioStream = clientData->getAvatarAudioStream();
+        if (!avatarAudioStream) {
+            return;
+        }
+
+        int shard = _shards.handoffShardForPosition(avatarAudioStream->getPosition());
+        if (shard != AudioMixerShards::NO_SHARD) {
+            // ask the domain-server to move this listener to the mixer for the shard it walked into
+            auto handoffPacket = NLPacket::create(PacketType::AudioShardHandoff, NUM_BYTES_RFC4122_UUID + sizeof(quint8), true);
+            handoffPacket->write(node->getUUID().toRfc4122());
+            handoffPacket->writePrimitive((quint8)shard);
+            nodeList->sendPacket(std::move(handoffPacket), domainHandler.getSockAddr());
+        }
+    });
+}
+
 void AudioMixer::removeHRTFsForFinishedInjector(const QUuid& streamID) {
     auto injectorClientData = qobject_cast<AudioMixerClientData*>(sender());
 
@@ -282,6 +406,10 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["threads"] = _slavePool.numThreads();
 
+    if (_shards.isEnabled()) {
+        statsObject["shard"] = _shards.getShard();
+    }
+
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
@@ -413,6 +541,12 @@ void AudioMixer::start() {
         parseSettingsObject(settingsObject);
     }
 
+    if (_shards.isEnabled()) {
+        QTimer* shardHandoffTimer = new QTimer(this);
+        connect(shardHandoffTimer, &QTimer::timeout, this, &AudioMixer::checkShardHandoffs);
+        shardHandoffTimer->start(SHARD_HANDOFF_CHECK_INTERVAL_MSECS);
+    }
+
     // mix state
     unsigned int frame = 1;
 
@@ -553,6 +687,7 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _shards.clear();
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -805,6 +940,8 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
     }
+
+    _shards.parseSettingsObject(settingsObject);
 }
 
 AudioMixer::Timer::Timing::Timing(uint64_t& sum) : _sum(sum) {
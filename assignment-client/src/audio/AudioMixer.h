@@ -20,6 +20,7 @@
 
 #include <plugins/Forward.h>
 
+#include "AudioMixerShards.h"
 #include "AudioMixerStats.h"
 #include "AudioMixerSlavePool.h"
 
@@ -50,12 +51,16 @@ public:
         float wetLevel;
     };
 
+    // Loads codecs and warms up the HRTF ahead of an assignment, for an assignment-client on hot standby.
+    static void prepareForStandby();
+
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const std::vector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static const AudioMixerShards& getShards() { return _shards; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -76,10 +81,12 @@ private slots:
     void handleNodeMuteRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleNodeKilled(SharedNodePointer killedNode);
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void handleAudioShardPeersPacket(QSharedPointer<ReceivedMessage> packet);
 
     void queueAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> packet);
     void removeHRTFsForFinishedInjector(const QUuid& streamID);
+    void checkShardHandoffs();
     void start();
 
 private:
@@ -94,6 +101,8 @@ private:
     void parseSettingsObject(const QJsonObject& settingsObject);
     void clearDomainSettings();
 
+    static QSharedPointer<PluginManager> getCodecPluginManager();
+
     p_high_resolution_clock::time_point _idealFrameTimestamp;
     p_high_resolution_clock::time_point _startFrameTimestamp;
 
@@ -147,6 +156,7 @@ private:
     static std::vector<ZoneDescription> _audioZones;
     static std::vector<ZoneSettings> _zoneSettings;
     static std::vector<ReverbSettings> _zoneReverbSettings;
+    static AudioMixerShards _shards;
 
     float _throttleStartTarget = 0.9f;
     float _throttleBackoffTarget = 0.44f;
@@ -70,13 +70,22 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
             case PacketType::MicrophoneAudioWithEcho:
             case PacketType::InjectAudio:
             case PacketType::SilentAudioFrame: {
-                if (node->isUpstream()) {
+                // streams forwarded by the mixer of another shard did not negotiate a codec with us
+                bool isShardForwarded = !node->isUpstream() && AudioMixer::getShards().isPeer(packet->getSenderSockAddr());
+                if (node->getType() == NodeType::Agent && packet->getType() != PacketType::InjectAudio) {
+                    _isShardForwarded = isShardForwarded;
+                }
+
+                if (node->isUpstream() || isShardForwarded) {
                     setupCodecForReplicatedAgent(packet);
                 }
 
                 processStreamPacket(*packet, addedStreams);
 
-                optionallyReplicatePacket(*packet, *node);
+                if (!isShardForwarded) {
+                    optionallyReplicatePacket(*packet, *node);
+                    optionallyForwardPacketToShards(*packet, *node);
+                }
                 break;
             }
             case PacketType::AudioStreamStats: {
@@ -173,6 +182,36 @@ void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, c
 
 }
 
+void AudioMixerClientData::optionallyForwardPacketToShards(ReceivedMessage& message, const Node& node) {
+    const auto& shards = AudioMixer::getShards();
+    auto avatarAudioStream = getAvatarAudioStream();
+    if (!shards.isEnabled() || node.isUpstream() || !avatarAudioStream) {
+        return;
+    }
+
+    PacketType mirroredType = PacketTypeEnum::getReplicatedPacketMapping().value(message.getType());
+    if (mirroredType == PacketType::Unknown) {
+        return;
+    }
+
+    // streams carry their own position, but the avatar decides which mixers can hear this node
+    std::unique_ptr<NLPacket> packet;
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    shards.eachPeerNear(avatarAudioStream->getPosition(), [&](const AudioMixerShards::Peer& peer) {
+        // construct the packet only once, if we have any peers to send to
+        if (!packet) {
+            packet = NLPacket::create(mirroredType);
+
+            // the replicated types are non-sourced, so the ID of the node goes in the payload
+            packet->write(node.getUUID().toRfc4122());
+            packet->write(message.getMessage());
+        }
+
+        nodeList->sendUnreliablePacket(*packet, peer.sockAddr);
+    });
+}
+
 void AudioMixerClientData::negotiateAudioFormat(ReceivedMessage& message, const SharedNodePointer& node) {
     quint8 numberOfCodecs;
     message.readPrimitive(&numberOfCodecs);
@@ -113,6 +113,9 @@ public:
 
     void setupCodecForReplicatedAgent(QSharedPointer<ReceivedMessage> message);
 
+    // true while the mic stream of this agent reaches us from the mixer of another shard, rather than from the agent
+    bool isShardForwarded() const { return _isShardForwarded; }
+
     struct MixableStream {
         float approximateVolume { 0.0f };
         NodeIDStreamID nodeStreamID;
@@ -177,6 +180,7 @@ private:
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
     void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
+    void optionallyForwardPacketToShards(ReceivedMessage& packet, const Node& node);
 
     void setGainForAvatar(QUuid nodeID, float gain);
 
@@ -202,6 +206,7 @@ private:
 
     bool _shouldMuteClient { false };
     bool _requestsDomainListData { false };
+    std::atomic_bool _isShardForwarded { false };
 
     std::vector<AddedStream> _newAddedStreams;
 
@@ -0,0 +1,124 @@
+//
+//  AudioMixerShards.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerShards.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonArray>
+
+#include "AudioLogging.h"
+
+static const QString AUDIO_SHARDING_GROUP_KEY = "audio_sharding";
+static const float DEFAULT_SHARD_BORDER_DISTANCE = 50.0f;
+
+// how far past the edge of its region a listener has to be before it is moved to another mixer,
+// so that listeners walking along a border do not bounce between mixers
+static const float SHARD_HANDOFF_HYSTERESIS = 2.0f;
+
+void AudioMixerShards::clear() {
+    _regions.clear();
+    _borderDistance = DEFAULT_SHARD_BORDER_DISTANCE;
+    setPeers({});
+}
+
+void AudioMixerShards::parseSettingsObject(const QJsonObject& settingsObject) {
+    // the peers come from the domain-server separately from its settings, so they are kept
+    _regions.clear();
+    _borderDistance = DEFAULT_SHARD_BORDER_DISTANCE;
+
+    if (!settingsObject.contains(AUDIO_SHARDING_GROUP_KEY)) {
+        return;
+    }
+    QJsonObject shardingGroupObject = settingsObject[AUDIO_SHARDING_GROUP_KEY].toObject();
+
+    const QString BORDER_DISTANCE = "border_distance";
+    _borderDistance = (float)shardingGroupObject[BORDER_DISTANCE].toDouble(DEFAULT_SHARD_BORDER_DISTANCE);
+
+    const QString SHARDS = "shards";
+    if (shardingGroupObject[SHARDS].isArray()) {
+        const QJsonArray& shards = shardingGroupObject[SHARDS].toArray();
+
+        const QString X_MIN = "x_min";
+        const QString X_MAX = "x_max";
+        const QString Z_MIN = "z_min";
+        const QString Z_MAX = "z_max";
+
+        for (int i = 0; i < shards.count(); ++i) {
+            QJsonObject shardObject = shards[i].toObject();
+
+            bool ok, allOk = true;
+            Region region;
+            region.xMin = shardObject.value(X_MIN).toString().toFloat(&ok);
+            allOk &= ok;
+            region.xMax = shardObject.value(X_MAX).toString().toFloat(&ok);
+            allOk &= ok;
+            region.zMin = shardObject.value(Z_MIN).toString().toFloat(&ok);
+            allOk &= ok;
+            region.zMax = shardObject.value(Z_MAX).toString().toFloat(&ok);
+            allOk &= ok;
+
+            if (!allOk) {
+                // the shards are numbered by their position in the list, so a broken entry disables sharding
+                qCWarning(audio) << "Invalid audio shard" << i << "- audio sharding disabled";
+                _regions.clear();
+                return;
+            }
+
+            _regions.push_back(region);
+            qCDebug(audio) << "Added audio shard" << i << "( x:" << region.xMin << "to" << region.xMax
+                << ", z:" << region.zMin << "to" << region.zMax << ")";
+        }
+    }
+
+    if (isEnabled()) {
+        qCDebug(audio) << "Mixing shard" << _shard << "of" << _regions.size() << "with border distance" << _borderDistance;
+    }
+}
+
+void AudioMixerShards::setPeers(Peers peers) {
+    std::atomic_store(&_peers, std::shared_ptr<const Peers>(std::make_shared<Peers>(std::move(peers))));
+}
+
+bool AudioMixerShards::isPeer(const HifiSockAddr& sockAddr) const {
+    auto peers = getPeers();
+    return std::any_of(peers->cbegin(), peers->cend(), [&](const Peer& peer) {
+        return peer.sockAddr == sockAddr;
+    });
+}
+
+float AudioMixerShards::distanceToRegion(const glm::vec3& position, int shard) const {
+    const auto& region = _regions[shard];
+    float dx = glm::max(glm::max(region.xMin - position.x, position.x - region.xMax), 0.0f);
+    float dz = glm::max(glm::max(region.zMin - position.z, position.z - region.zMax), 0.0f);
+    return glm::sqrt(dx * dx + dz * dz);
+}
+
+int AudioMixerShards::shardForPosition(const glm::vec3& position) const {
+    for (int shard = 0; shard < (int)_regions.size(); ++shard) {
+        if (distanceToRegion(position, shard) == 0.0f) {
+            return shard;
+        }
+    }
+    return NO_SHARD;
+}
+
+int AudioMixerShards::handoffShardForPosition(const glm::vec3& position) const {
+    if (!isEnabled() || _shard >= (int)_regions.size() || distanceToRegion(position, _shard) <= SHARD_HANDOFF_HYSTERESIS) {
+        return NO_SHARD;
+    }
+
+    // listeners outside of every region stay where they are
+    int shard = shardForPosition(position);
+    if (shard == _shard) {
+        return NO_SHARD;
+    }
+    return shard;
+}
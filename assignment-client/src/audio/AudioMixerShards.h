@@ -0,0 +1,87 @@
+//
+//  AudioMixerShards.h
+//  assignment-client/src/audio
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerShards_h
+#define hifi_AudioMixerShards_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+#include <glm/glm.hpp>
+
+#include <HifiSockAddr.h>
+
+// When a domain splits its audio across several mixers, each mixer owns a region of the domain (a shard).
+// Listeners are homed on the mixer of the region they are in, and each mixer forwards the streams of its
+// listeners that are close to another region to the mixer of that region, so they can be heard across borders.
+class AudioMixerShards {
+public:
+    struct Peer {
+        int shard;
+        HifiSockAddr sockAddr;
+    };
+    using Peers = std::vector<Peer>;
+
+    static const int NO_SHARD = -1;
+
+    void parseSettingsObject(const QJsonObject& settingsObject);
+    void clear();
+
+    // the shard of this mixer, from its assignment payload
+    void setShard(int shard) { _shard = shard; }
+    int getShard() const { return _shard; }
+
+    bool isEnabled() const { return _shard != NO_SHARD && _regions.size() > 1; }
+    int getNumShards() const { return (int)_regions.size(); }
+
+    int shardForPosition(const glm::vec3& position) const;
+
+    // the shard a listener at this position should move to, or NO_SHARD if it should stay on this mixer
+    int handoffShardForPosition(const glm::vec3& position) const;
+
+    // set from the main thread, read by the mixer slaves
+    void setPeers(Peers peers);
+    std::shared_ptr<const Peers> getPeers() const { return std::atomic_load(&_peers); }
+    bool isPeer(const HifiSockAddr& sockAddr) const;
+
+    // calls functor with each peer whose region is within the border distance of position
+    template <typename Functor>
+    void eachPeerNear(const glm::vec3& position, Functor functor) const;
+
+private:
+    struct Region {
+        float xMin;
+        float xMax;
+        float zMin;
+        float zMax;
+    };
+
+    float distanceToRegion(const glm::vec3& position, int shard) const;
+
+    std::vector<Region> _regions;
+    float _borderDistance { 0.0f };
+    int _shard { NO_SHARD };
+    std::shared_ptr<const Peers> _peers { std::make_shared<const Peers>() };
+};
+
+template <typename Functor>
+void AudioMixerShards::eachPeerNear(const glm::vec3& position, Functor functor) const {
+    auto peers = getPeers();
+    for (const auto& peer : *peers) {
+        if (peer.shard != _shard && peer.shard < getNumShards() &&
+            distanceToRegion(position, peer.shard) <= _borderDistance) {
+            functor(peer);
+        }
+    }
+}
+
+#endif // hifi_AudioMixerShards_h
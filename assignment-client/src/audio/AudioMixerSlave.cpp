@@ -77,7 +77,8 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         return;
     }
 
-    if (node->isUpstream()) {
+    // agents homed on the mixer of another shard get their mix from there
+    if (node->isUpstream() || data->isShardForwarded()) {
         return;
     }
 
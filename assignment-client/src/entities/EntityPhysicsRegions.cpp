@@ -0,0 +1,63 @@
+//
+//  EntityPhysicsRegions.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsRegions.h"
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+
+#include <OctreeConstants.h>
+
+int EntityPhysicsRegions::parseAssignmentPayload(const QByteArray& payload) {
+    QStringList payloadArguments = QString(payload).split(" ", QString::SkipEmptyParts);
+    int regionArgumentIndex = payloadArguments.indexOf("--region");
+    if (regionArgumentIndex >= 0 && regionArgumentIndex + 1 < payloadArguments.size()) {
+        bool ok;
+        int region = payloadArguments[regionArgumentIndex + 1].toInt(&ok);
+        if (ok && region >= 0) {
+            return region;
+        }
+    }
+    return NO_REGION;
+}
+
+bool EntityPhysicsRegions::parseRegion(const QJsonArray& regions, int region, AABox& box) {
+    if (region < 0 || region >= regions.size()) {
+        return false;
+    }
+
+    const QString X_MIN = "x_min";
+    const QString X_MAX = "x_max";
+    const QString Z_MIN = "z_min";
+    const QString Z_MAX = "z_max";
+
+    QJsonObject regionObject = regions[region].toObject();
+    bool ok, allOk = true;
+    float xMin = regionObject.value(X_MIN).toString().toFloat(&ok);
+    allOk &= ok;
+    float xMax = regionObject.value(X_MAX).toString().toFloat(&ok);
+    allOk &= ok;
+    float zMin = regionObject.value(Z_MIN).toString().toFloat(&ok);
+    allOk &= ok;
+    float zMax = regionObject.value(Z_MAX).toString().toFloat(&ok);
+    allOk &= ok;
+    if (!allOk || xMin >= xMax || zMin >= zMax) {
+        return false;
+    }
+
+    glm::vec3 corner(xMin, -HALF_TREE_SCALE, zMin);
+    glm::vec3 dimensions(xMax - xMin, TREE_SCALE, zMax - zMin);
+    box = AABox(corner, dimensions);
+    return true;
+}
+
+AABox EntityPhysicsRegions::getWholeDomain() {
+    return AABox(glm::vec3(-HALF_TREE_SCALE), (float)TREE_SCALE);
+}
@@ -0,0 +1,35 @@
+//
+//  EntityPhysicsRegions.h
+//  assignment-client/src/entities
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsRegions_h
+#define hifi_EntityPhysicsRegions_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonArray>
+
+#include <AABox.h>
+
+// When a domain splits its physics across several entity-physics-servers, each server simulates a region of the domain.
+// The domain-server tells a server which region is its own in the payload of its assignment, and the region is a box on
+// the ground, from the physics_server settings, that goes all the way up and down.
+class EntityPhysicsRegions {
+public:
+    static const int NO_REGION = -1;
+
+    // "--region <index>", NO_REGION for a server of the whole domain
+    static int parseAssignmentPayload(const QByteArray& payload);
+
+    // The box of a region in the regions of the settings, false if it isn't there or isn't a box
+    static bool parseRegion(const QJsonArray& regions, int region, AABox& box);
+
+    static AABox getWholeDomain();
+};
+
+#endif // hifi_EntityPhysicsRegions_h
@@ -0,0 +1,252 @@
+//
+//  EntityPhysicsServer.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsServer.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
+#include <EntityMotionState.h>
+#include <NodeList.h>
+#include <PhysicsHelpers.h>
+#include <SimulationFlags.h>
+#include <UUID.h>
+
+#include "AssignmentParentFinder.h"
+#include "PhysicsDynamicFactory.h"
+
+static const QString ENTITY_PHYSICS_SERVER_LOGGING_NAME = "entity-physics-server";
+static const QString PHYSICS_SERVER_SETTINGS_KEY = "physics_server";
+
+EntityPhysicsServer::EntityPhysicsServer(ReceivedMessage& message) : ThreadedAssignment(message) {
+    DependencyManager::registerInheritance<EntityDynamicFactoryInterface, PhysicsDynamicFactory>();
+    DependencyManager::set<PhysicsDynamicFactory>();
+
+    DependencyManager::registerInheritance<SpatialParentFinder, AssignmentParentFinder>();
+
+    // without a region the server simulates everything
+    _regionIndex = EntityPhysicsRegions::parseAssignmentPayload(getPayload());
+
+    auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
+    packetReceiver.registerListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
+                                            this, "handleOctreePacket");
+}
+
+void EntityPhysicsServer::run() {
+    ThreadedAssignment::commonInit(ENTITY_PHYSICS_SERVER_LOGGING_NAME, NodeType::EntityPhysicsServer);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    DomainHandler& domainHandler = nodeList->getDomainHandler();
+    connect(&domainHandler, &DomainHandler::settingsReceived, this, &EntityPhysicsServer::handleSettings);
+
+    connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &EntityPhysicsServer::nodeKilled);
+
+    // the ownership of the simulation is claimed with our session UUID
+    Physics::setSessionUUID(nodeList->getSessionUUID());
+    connect(nodeList.data(), &NodeList::uuidChanged, this, [](const QUuid& sessionUUID) {
+        Physics::setSessionUUID(sessionUUID);
+    });
+
+    nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::EntityServer });
+
+    _entityViewer.init();
+    auto tree = _entityViewer.getTree();
+    DependencyManager::set<AssignmentParentFinder>(tree);
+
+    ObjectMotionState::setShapeManager(&_shapeManager);
+    EntityMotionState::setVolunteerPriority(SERVER_SIMULATION_PRIORITY);
+
+    _physicsEngine = std::make_shared<PhysicsEngine>(Vectors::ZERO);
+    _physicsEngine->init();
+
+    // replaces the SimpleEntitySimulation the viewer made for itself
+    _entitySimulation = std::make_shared<PhysicalEntitySimulation>();
+    _entitySimulation->init(tree, _physicsEngine, &_entityEditSender);
+    tree->setSimulation(_entitySimulation);
+
+    // until the settings tell us otherwise we have the whole domain
+    setRegion(EntityPhysicsRegions::getWholeDomain());
+
+    _entityEditSender.setPacketsPerSecond(DEFAULT_MAX_ENTITY_PPS);
+
+    _tickTimer = new QTimer(this);
+    connect(_tickTimer, &QTimer::timeout, this, &EntityPhysicsServer::simulate);
+    _tickTimer->start(MSECS_PER_SECOND / _tickRate);
+}
+
+void EntityPhysicsServer::setRegion(const AABox& region) {
+    _region = region;
+    _entitySimulation->setSimulationRegion(region);
+
+    // ask for all that could collide with what we simulate, which is what is around the region
+    _entityViewer.setPosition(region.calcCenter());
+    _entityViewer.setCenterRadius(0.5f * glm::length(region.getScale()) + PhysicalEntitySimulation::SIMULATION_REGION_MARGIN);
+}
+
+void EntityPhysicsServer::handleSettings() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    const QJsonObject& settingsObject = nodeList->getDomainHandler().getSettingsObject();
+
+    if (!settingsObject.contains(PHYSICS_SERVER_SETTINGS_KEY)) {
+        qWarning() << "Received settings from the domain-server with no physics_server section.";
+        return;
+    }
+    QJsonObject physicsServerSettings = settingsObject[PHYSICS_SERVER_SETTINGS_KEY].toObject();
+
+    static const QString TICK_RATE = "tick_rate";
+    static const QString MAX_ENTITY_PPS = "max_entity_pps";
+    static const QString REGIONS = "regions";
+
+    _tickRate = glm::clamp(physicsServerSettings[TICK_RATE].toInt(DEFAULT_TICK_RATE), 1, (int)NUM_SUBSTEPS_PER_SECOND);
+    if (_tickTimer) {
+        _tickTimer->setInterval(MSECS_PER_SECOND / _tickRate);
+    }
+    _entityEditSender.setPacketsPerSecond(std::max(0, physicsServerSettings[MAX_ENTITY_PPS].toInt(DEFAULT_MAX_ENTITY_PPS)));
+
+    if (_regionIndex != EntityPhysicsRegions::NO_REGION) {
+        AABox region;
+        if (EntityPhysicsRegions::parseRegion(physicsServerSettings[REGIONS].toArray(), _regionIndex, region)) {
+            setRegion(region);
+        } else {
+            qWarning() << "Physics region" << _regionIndex << "is missing or invalid in the settings - simulating the whole domain";
+        }
+    }
+
+    qDebug() << "Simulating physics region" << _regionIndex << _region << "at" << _tickRate << "Hz";
+}
+
+void EntityPhysicsServer::simulate() {
+    auto tree = _entityViewer.getTree();
+    if (!tree || Physics::getSessionUUID().isNull()) {
+        return;
+    }
+    quint64 start = usecTimestampNow();
+
+    _entityViewer.queryOctree();
+
+    // the same sequence as the interface runs every frame, without the avatars
+    tree->preUpdate();
+    _entitySimulation->removeDeadEntities();
+    {
+        PhysicsEngine::Transaction transaction;
+        _entitySimulation->buildPhysicsTransaction(transaction);
+        _physicsEngine->processTransaction(transaction);
+        _entitySimulation->handleProcessedPhysicsTransaction(transaction);
+    }
+
+    _entitySimulation->applyDynamicChanges();
+    _physicsEngine->forEachDynamic([&](EntityDynamicPointer dynamic) {
+        dynamic->prepareForPhysicsSimulation();
+    });
+
+    tree->withWriteLock([&] {
+        _physicsEngine->stepSimulation();
+    });
+
+    if (_physicsEngine->hasOutgoingChanges()) {
+        auto& collisionEvents = _physicsEngine->getCollisionEvents();
+
+        tree->withWriteLock([&] {
+            _entitySimulation->handleChangedMotionStates(_physicsEngine->getChangedMotionStates());
+            _entitySimulation->handleDeactivatedMotionStates(_physicsEngine->getDeactivatedMotionStates());
+        });
+
+        _entitySimulation->handleCollisionEvents(collisionEvents);
+    }
+
+    tree->update(true);
+
+    // the updates and bids of this tick leave together, as few packets as they fit in
+    _entityEditSender.releaseQueuedMessages();
+    _entityEditSender.process();
+
+    uint64_t simulationTime = usecTimestampNow() - start;
+    _simulationTime += simulationTime;
+    _maxSimulationTime = std::max(_maxSimulationTime, simulationTime);
+    ++_numTicks;
+}
+
+void EntityPhysicsServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    auto packetType = message->getType();
+
+    if (packetType == PacketType::OctreeStats) {
+        int statsMessageLength = OctreeHeadlessViewer::parseOctreeStats(message, senderNode);
+        if (message->getSize() > statsMessageLength) {
+            // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
+            int piggyBackedSizeWithHeader = message->getSize() - statsMessageLength;
+
+            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
+
+            auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
+            message = QSharedPointer<ReceivedMessage>::create(*newPacket);
+        } else {
+            return; // bail since no piggyback data
+        }
+
+        packetType = message->getType();
+    } // fall through to piggyback message
+
+    if (packetType == PacketType::EntityData) {
+        _entityViewer.processDatagram(*message, senderNode);
+    } else if (packetType == PacketType::EntityErase) {
+        _entityViewer.processEraseMessage(*message, senderNode);
+    }
+}
+
+void EntityPhysicsServer::nodeKilled(SharedNodePointer killedNode) {
+    if (killedNode->getType() == NodeType::EntityServer) {
+        // what we simulated is gone with the entity-server, we start over from what the next one sends
+        clear();
+    }
+}
+
+void EntityPhysicsServer::clear() {
+    _entityViewer.clear();
+}
+
+void EntityPhysicsServer::sendStatsPacket() {
+    QJsonObject statsObject;
+
+    QJsonObject physicsStats;
+    physicsStats["region"] = _regionIndex;
+    physicsStats["tick_rate"] = _tickRate;
+    physicsStats["ticks"] = (double)_numTicks;
+    physicsStats["collision_objects"] = _physicsEngine ? _physicsEngine->getNumCollisionObjects() : 0;
+    physicsStats["avg_tick_usecs"] = _numTicks > 0 ? (double)(_simulationTime / _numTicks) : 0.0;
+    physicsStats["max_tick_usecs"] = (double)_maxSimulationTime;
+    statsObject["physics_stats"] = physicsStats;
+
+    _numTicks = 0;
+    _simulationTime = 0;
+    _maxSimulationTime = 0;
+
+    addPacketStatsAndSendStatsPacket(statsObject);
+}
+
+void EntityPhysicsServer::aboutToFinish() {
+    if (_tickTimer) {
+        _tickTimer->stop();
+    }
+
+    clear();
+    if (_entitySimulation) {
+        _entityViewer.getTree()->setSimulation(nullptr);
+        _entitySimulation->setEntityTree(nullptr);
+        _entitySimulation.reset();
+    }
+    _physicsEngine.reset();
+
+    EntityMotionState::setVolunteerPriority(VOLUNTEER_SIMULATION_PRIORITY);
+
+    DependencyManager::destroy<AssignmentParentFinder>();
+    DependencyManager::destroy<PhysicsDynamicFactory>();
+}
@@ -0,0 +1,74 @@
+//
+//  EntityPhysicsServer.h
+//  assignment-client/src/entities
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsServer_h
+#define hifi_EntityPhysicsServer_h
+
+#include <QtCore/QTimer>
+
+#include <AABox.h>
+#include <EntityEditPacketSender.h>
+#include <PhysicalEntitySimulation.h>
+#include <PhysicsEngine.h>
+#include <ShapeManager.h>
+#include <ThreadedAssignment.h>
+
+#include "EntityPhysicsRegions.h"
+#include "EntityTreeHeadlessViewer.h"
+
+/// Handles assignments of type EntityPhysicsServer - simulation of the dynamic entities of a region of the domain.
+///
+/// The server sees the entities of its region through an EntityTreeHeadlessViewer and runs them in its own PhysicsEngine,
+/// volunteering for their simulation ownership at SERVER_SIMULATION_PRIORITY so that clients only take them over when they
+/// poke or grab them. At every tick it steps the simulation and sends what changed to the entity-server in batched edits,
+/// so the cost of the physics of a region, and the bandwidth of its updates, doesn't depend on which clients are around.
+class EntityPhysicsServer : public ThreadedAssignment {
+    Q_OBJECT
+public:
+    EntityPhysicsServer(ReceivedMessage& message);
+
+    virtual void aboutToFinish() override;
+
+    static const int DEFAULT_TICK_RATE { 30 }; // Hz
+    static const int DEFAULT_MAX_ENTITY_PPS { 9000 };
+
+public slots:
+    void run() override;
+    void nodeKilled(SharedNodePointer killedNode);
+    void sendStatsPacket() override;
+
+private slots:
+    void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleSettings();
+    void simulate();
+
+private:
+    void setRegion(const AABox& region);
+    void clear();
+
+    int _regionIndex { EntityPhysicsRegions::NO_REGION };
+    AABox _region;
+
+    QTimer* _tickTimer { nullptr };
+    int _tickRate { DEFAULT_TICK_RATE };
+
+    ShapeManager _shapeManager;
+    PhysicsEnginePointer _physicsEngine;
+    PhysicalEntitySimulationPointer _entitySimulation;
+    EntityEditPacketSender _entityEditSender;
+    EntityTreeHeadlessViewer _entityViewer;
+
+    // stats since the last stats packet
+    uint32_t _numTicks { 0 };
+    uint64_t _simulationTime { 0 }; // usecs
+    uint64_t _maxSimulationTime { 0 }; // usecs
+};
+
+#endif // hifi_EntityPhysicsServer_h
@@ -0,0 +1,74 @@
+//
+//  PhysicsDynamicFactory.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsDynamicFactory.h"
+
+#include <ObjectActionOffset.h>
+#include <ObjectActionTractor.h>
+#include <ObjectActionTravelOriented.h>
+#include <ObjectConstraintBallSocket.h>
+#include <ObjectConstraintConeTwist.h>
+#include <ObjectConstraintHinge.h>
+#include <ObjectConstraintSlider.h>
+
+EntityDynamicPointer physicsDynamicFactory(EntityDynamicType type, const QUuid& id, EntityItemPointer ownerEntity) {
+    switch (type) {
+        case DYNAMIC_TYPE_OFFSET:
+            return std::make_shared<ObjectActionOffset>(id, ownerEntity);
+        case DYNAMIC_TYPE_SPRING:
+        case DYNAMIC_TYPE_TRACTOR:
+            return std::make_shared<ObjectActionTractor>(id, ownerEntity);
+        case DYNAMIC_TYPE_TRAVEL_ORIENTED:
+            return std::make_shared<ObjectActionTravelOriented>(id, ownerEntity);
+        case DYNAMIC_TYPE_HINGE:
+            return std::make_shared<ObjectConstraintHinge>(id, ownerEntity);
+        case DYNAMIC_TYPE_SLIDER:
+            return std::make_shared<ObjectConstraintSlider>(id, ownerEntity);
+        case DYNAMIC_TYPE_BALL_SOCKET:
+            return std::make_shared<ObjectConstraintBallSocket>(id, ownerEntity);
+        case DYNAMIC_TYPE_CONE_TWIST:
+            return std::make_shared<ObjectConstraintConeTwist>(id, ownerEntity);
+        default:
+            return EntityDynamicPointer();
+    }
+}
+
+EntityDynamicPointer PhysicsDynamicFactory::factory(EntityDynamicType type,
+                                                    const QUuid& id,
+                                                    EntityItemPointer ownerEntity,
+                                                    QVariantMap arguments) {
+    EntityDynamicPointer dynamic = physicsDynamicFactory(type, id, ownerEntity);
+    if (dynamic) {
+        bool ok = dynamic->updateArguments(arguments);
+        if (ok && !dynamic->lifetimeIsOver()) {
+            return dynamic;
+        }
+    }
+    return nullptr;
+}
+
+EntityDynamicPointer PhysicsDynamicFactory::factoryBA(EntityItemPointer ownerEntity, QByteArray data) {
+    QDataStream serializedDynamicDataStream(data);
+    EntityDynamicType type;
+    QUuid id;
+
+    serializedDynamicDataStream >> type;
+    serializedDynamicDataStream >> id;
+
+    EntityDynamicPointer dynamic = physicsDynamicFactory(type, id, ownerEntity);
+
+    if (dynamic) {
+        dynamic->deserialize(data);
+        if (dynamic->lifetimeIsOver()) {
+            return nullptr;
+        }
+    }
+    return dynamic;
+}
@@ -0,0 +1,29 @@
+//
+//  PhysicsDynamicFactory.h
+//  assignment-client/src/entities
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsDynamicFactory_h
+#define hifi_PhysicsDynamicFactory_h
+
+#include <EntityDynamicFactoryInterface.h>
+
+// Makes the actions and constraints of entities for the entity-physics-server, as the physics engine runs them.
+// The holds and far grabs of avatars are simulated by whoever does the grabbing, so they aren't made here.
+class PhysicsDynamicFactory : public EntityDynamicFactoryInterface {
+public:
+    PhysicsDynamicFactory() : EntityDynamicFactoryInterface() { }
+    virtual ~PhysicsDynamicFactory() { }
+    virtual EntityDynamicPointer factory(EntityDynamicType type,
+                                        const QUuid& id,
+                                        EntityItemPointer ownerEntity,
+                                        QVariantMap arguments) override;
+    virtual EntityDynamicPointer factoryBA(EntityItemPointer ownerEntity, QByteArray data) override;
+};
+
+#endif // hifi_PhysicsDynamicFactory_h
@@ -1204,7 +1204,7 @@ void OctreeServer::beginRunning() {
 
     // we need to ask the DS about agents so we can ping/reply with them
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer,
-        NodeType::AvatarMixer });
+        NodeType::EntityPhysicsServer, NodeType::AvatarMixer });
 
     beforeRun(); // after payload has been processed
 
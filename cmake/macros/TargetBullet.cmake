@@ -17,6 +17,13 @@ macro(TARGET_BULLET)
         list(APPEND BULLET_LIBRARIES ${LIB_DIR}/libBulletSoftBody.a)
     else()
         find_package(Bullet REQUIRED)
+        # the vcpkg port of bullet is built for multithreading, which changes what some of its headers declare
+        if (DEFINED VCPKG_INSTALL_ROOT)
+            string(FIND "${BULLET_INCLUDE_DIRS}" "${VCPKG_INSTALL_ROOT}" BULLET_VCPKG_INDEX)
+            if (BULLET_VCPKG_INDEX EQUAL 0)
+                target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
+            endif()
+        endif()
    endif()
     # perform the system include hack for OS X to ignore warnings
     if (APPLE)
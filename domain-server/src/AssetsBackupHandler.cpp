@@ -11,8 +11,16 @@
 
 #include "AssetsBackupHandler.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include <QJsonDocument>
 #include <QDate>
+#include <QTemporaryDir>
 #include <QtCore/QLoggingCategory>
 
 #if !defined(__clang__) && defined(__GNUC__)
@@ -22,6 +30,7 @@
 
 #include <quazip5/quazipfile.h>
 #include <quazip5/quazipdir.h>
+#include <zlib.h>
 
 #if !defined(__clang__) && defined(__GNUC__)
 #pragma GCC diagnostic pop
@@ -378,6 +387,83 @@ void AssetsBackupHandler::deleteBackup(const QString& backupName) {
     qDebug() << "Deleted asset backup:" << backupName;
 }
 
+namespace {
+    // Chunk size used to stream assets through zlib and into the archive, so that
+    // consolidating a large asset store never holds a whole file in memory.
+    const qint64 CONSOLIDATION_CHUNK_SIZE = 64 * 1024;
+    // Bounds the number of compressed assets waiting on disk to be appended to the archive.
+    const size_t MAX_PENDING_COMPRESSED_ASSETS = 16;
+    const unsigned int MAX_CONSOLIDATION_THREADS = 4;
+
+    struct CompressedAsset {
+        AssetUtils::AssetHash hash;
+        QString compressedFilePath;
+        qint64 uncompressedSize { 0 };
+        quint32 crc { 0 };
+        bool success { false };
+    };
+
+    // Deflates `sourcePath` into `destinationPath` as a raw deflate stream, the way zip
+    // stores entries, so that the result can be appended to the archive without recompressing.
+    bool compressAssetFile(const QString& sourcePath, const QString& destinationPath, CompressedAsset& asset) {
+        QFile source { sourcePath };
+        if (!source.open(QFile::ReadOnly)) {
+            qCCritical(asset_backup) << "Could not open asset file" << source.fileName();
+            return false;
+        }
+        QFile destination { destinationPath };
+        if (!destination.open(QFile::WriteOnly | QFile::Truncate)) {
+            qCCritical(asset_backup) << "Could not open temporary file" << destination.fileName();
+            return false;
+        }
+
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+        if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+
+        QByteArray input;
+        QByteArray output { (int)CONSOLIDATION_CHUNK_SIZE, Qt::Uninitialized };
+        uLong crc = crc32(0L, Z_NULL, 0);
+        qint64 totalSize = 0;
+        bool success = true;
+        int flush = Z_NO_FLUSH;
+
+        do {
+            input = source.read(CONSOLIDATION_CHUNK_SIZE);
+            if (input.isEmpty() && source.error() != QFile::NoError) {
+                qCCritical(asset_backup) << "Could not read asset file" << source.fileName();
+                success = false;
+                break;
+            }
+            flush = source.atEnd() ? Z_FINISH : Z_NO_FLUSH;
+            crc = crc32(crc, reinterpret_cast<const Bytef*>(input.constData()), (uInt)input.size());
+            totalSize += input.size();
+
+            stream.next_in = reinterpret_cast<Bytef*>(input.data());
+            stream.avail_in = (uInt)input.size();
+            do {
+                stream.next_out = reinterpret_cast<Bytef*>(output.data());
+                stream.avail_out = (uInt)output.size();
+                deflate(&stream, flush);
+                auto produced = output.size() - (qint64)stream.avail_out;
+                if (destination.write(output.constData(), produced) != produced) {
+                    qCCritical(asset_backup) << "Could not write temporary file" << destination.fileName();
+                    success = false;
+                    break;
+                }
+            } while (stream.avail_out == 0);
+        } while (success && flush != Z_FINISH);
+
+        deflateEnd(&stream);
+
+        asset.uncompressedSize = totalSize;
+        asset.crc = (quint32)crc;
+        return success;
+    }
+}
+
 void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -394,29 +480,103 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
         return;
     }
 
+    // Several paths can map to the same content, only store each hash once.
+    std::set<AssetUtils::AssetHash> uniqueHashes;
     for (const auto& mapping : it->mappings) {
-        const auto& hash = mapping.second;
+        uniqueHashes.insert(mapping.second);
+    }
+    const vector<AssetUtils::AssetHash> hashes { begin(uniqueHashes), end(uniqueHashes) };
+    if (hashes.empty()) {
+        return;
+    }
 
-        QDir assetsDir { _assetsDirectory };
-        QFile file { assetsDir.filePath(hash) };
-        if (!file.open(QFile::ReadOnly)) {
-            qCCritical(asset_backup) << "Could not open asset file" << file.fileName();
-            continue;
-        }
+    QTemporaryDir compressionDir;
+    if (!compressionDir.isValid()) {
+        qCCritical(asset_backup) << "Could not create temporary directory to consolidate backup" << backupName;
+        return;
+    }
 
-        QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ZIP_ASSETS_FOLDER + "/" + hash))) {
-            qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
-            continue;
+    // Workers compress assets in parallel into temporary files, while this thread
+    // appends the finished ones to the archive, the only part that has to be serial.
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<CompressedAsset> compressedAssets;
+    std::atomic<size_t> nextHash { 0 };
+    std::atomic<bool> cancelled { false };
+
+    auto numThreads = std::max(1u, std::min(std::thread::hardware_concurrency(), MAX_CONSOLIDATION_THREADS));
+    numThreads = std::min(numThreads, (unsigned int)hashes.size());
+
+    QDir assetsDir { _assetsDirectory };
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        workers.emplace_back([&] {
+            size_t index;
+            while (!cancelled && (index = nextHash++) < hashes.size()) {
+                {
+                    std::unique_lock<std::mutex> lock { mutex };
+                    condition.wait(lock, [&] {
+                        return cancelled || compressedAssets.size() < MAX_PENDING_COMPRESSED_ASSETS;
+                    });
+                }
+
+                CompressedAsset asset;
+                asset.hash = hashes[index];
+                asset.compressedFilePath = compressionDir.filePath(asset.hash);
+                asset.success = !cancelled &&
+                    compressAssetFile(assetsDir.filePath(asset.hash), asset.compressedFilePath, asset);
+
+                {
+                    std::lock_guard<std::mutex> lock { mutex };
+                    compressedAssets.push_back(std::move(asset));
+                }
+                condition.notify_all();
+            }
+        });
+    }
+
+    QByteArray buffer;
+    for (size_t appended = 0; appended < hashes.size() && !cancelled; ++appended) {
+        CompressedAsset asset;
+        {
+            std::unique_lock<std::mutex> lock { mutex };
+            condition.wait(lock, [&] { return !compressedAssets.empty(); });
+            asset = std::move(compressedAssets.front());
+            compressedAssets.pop_front();
         }
-        zipFile.write(file.readAll());
-        zipFile.close();
-        if (zipFile.getZipError() != UNZ_OK) {
-            qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
-            continue;
+        condition.notify_all();
+
+        if (asset.success) {
+            QFile compressedFile { asset.compressedFilePath };
+            QuaZipNewInfo info { ZIP_ASSETS_FOLDER + "/" + asset.hash };
+            info.uncompressedSize = asset.uncompressedSize;
+
+            QuaZipFile zipFile { &zip };
+            if (!compressedFile.open(QFile::ReadOnly)) {
+                qCCritical(asset_backup) << "Could not open compressed asset file" << compressedFile.fileName();
+            } else if (!zipFile.open(QIODevice::WriteOnly, info, nullptr, asset.crc, Z_DEFLATED, Z_DEFAULT_COMPRESSION, true)) {
+                qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
+            } else {
+                while (!(buffer = compressedFile.read(CONSOLIDATION_CHUNK_SIZE)).isEmpty()) {
+                    zipFile.write(buffer);
+                }
+                zipFile.close();
+                if (zipFile.getZipError() != UNZ_OK) {
+                    qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
+                    if (zip.getZipError() != UNZ_OK) {
+                        // The archive itself is broken, there is no point compressing the rest.
+                        cancelled = true;
+                        condition.notify_all();
+                    }
+                }
+            }
         }
+        QFile::remove(asset.compressedFilePath);
     }
 
+    for (auto& worker : workers) {
+        worker.join();
+    }
 }
 
 void AssetsBackupHandler::refreshMappings() {
@@ -455,8 +615,7 @@ void AssetsBackupHandler::refreshMappings() {
 }
 
 void AssetsBackupHandler::downloadMissingFiles(const AssetUtils::Mappings& mappings) {
-    auto wasEmpty = _assetsLeftToRequest.empty();
-
+    // Assets are content addressed, so only hashes we have never seen need to be fetched.
     for (const auto& mapping : mappings) {
         const auto& hash = mapping.second;
         if (_assetsOnDisk.find(hash) == end(_assetsOnDisk)) {
@@ -464,40 +623,45 @@ void AssetsBackupHandler::downloadMissingFiles(const AssetUtils::Mappings& mappi
         }
     }
 
-    // If we were empty, that means no download chain was already going, start one.
-    if (wasEmpty) {
-        downloadNextMissingFile();
-    }
+    downloadNextMissingFile();
 }
 
 void AssetsBackupHandler::downloadNextMissingFile() {
-    if (_assetsLeftToRequest.empty()) {
-        return;
-    }
-    auto hash = *begin(_assetsLeftToRequest);
+    static const size_t MAX_ASSET_REQUESTS_IN_FLIGHT = 8;
 
     auto assetClient = DependencyManager::get<AssetClient>();
-    auto assetRequest = assetClient->createRequest(hash);
 
-    QObject::connect(assetRequest, &AssetRequest::finished, this, [this](AssetRequest* request) {
-        if (request->getError() == AssetRequest::NoError) {
-            qCDebug(asset_backup) << "Backing up asset" << request->getHash();
+    for (const auto& hash : _assetsLeftToRequest) {
+        if (_assetsBeingRequested.size() >= MAX_ASSET_REQUESTS_IN_FLIGHT) {
+            break;
+        }
+        if (!_assetsBeingRequested.insert(hash).second) {
+            continue;
+        }
+
+        auto assetRequest = assetClient->createRequest(hash);
 
-            bool success = writeAssetFile(request->getHash(), request->getData());
-            if (!success) {
-                qCCritical(asset_backup) << "Failed to write asset file" << request->getHash();
+        QObject::connect(assetRequest, &AssetRequest::finished, this, [this](AssetRequest* request) {
+            if (request->getError() == AssetRequest::NoError) {
+                qCDebug(asset_backup) << "Backing up asset" << request->getHash();
+
+                bool success = writeAssetFile(request->getHash(), request->getData());
+                if (!success) {
+                    qCCritical(asset_backup) << "Failed to write asset file" << request->getHash();
+                }
+            } else {
+                qCCritical(asset_backup) << "Failed to backup asset" << request->getHash();
             }
-        } else {
-            qCCritical(asset_backup) << "Failed to backup asset" << request->getHash();
-        }
 
-        _assetsLeftToRequest.erase(request->getHash());
-        downloadNextMissingFile();
+            _assetsLeftToRequest.erase(request->getHash());
+            _assetsBeingRequested.erase(request->getHash());
+            downloadNextMissingFile();
 
-        request->deleteLater();
-    });
+            request->deleteLater();
+        });
 
-    assetRequest->start();
+        assetRequest->start();
+    }
 }
 
 bool AssetsBackupHandler::writeAssetFile(const AssetUtils::AssetHash& hash, const QByteArray& data) {
@@ -87,6 +87,7 @@ private:
 
     // Internal storage for backup in progress
     std::set<AssetUtils::AssetHash> _assetsLeftToRequest;
+    std::set<AssetUtils::AssetHash> _assetsBeingRequested;
 
     // Internal storage for restore in progress
     std::vector<AssetUtils::AssetHash> _assetsLeftToUpload;
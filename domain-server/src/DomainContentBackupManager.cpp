@@ -554,6 +554,10 @@ void DomainContentBackupManager::backup() {
     auto nowDateTime = QDateTime::currentDateTime();
     auto nowSeconds = nowDateTime.toSecsSinceEpoch();
 
+    // When several rules are due on the same tick, their backups hold the same content:
+    // build the archive once and copy it for the other rules instead of zipping everything again.
+    QString firstBackupPath;
+
     for (BackupRule& rule : _backupRules) {
         auto secondsSinceLastBackup = nowSeconds - rule.lastBackupSeconds;
 
@@ -561,7 +565,14 @@ void DomainContentBackupManager::backup() {
 
             bool success;
             QString path;
-            std::tie(success, path) =  createBackup(AUTOMATIC_BACKUP_PREFIX, rule.extensionFormat);
+            if (firstBackupPath.isEmpty()) {
+                std::tie(success, path) = createBackup(AUTOMATIC_BACKUP_PREFIX, rule.extensionFormat);
+                if (success) {
+                    firstBackupPath = path;
+                }
+            } else {
+                std::tie(success, path) = copyBackup(firstBackupPath, AUTOMATIC_BACKUP_PREFIX, rule.extensionFormat);
+            }
             if (!success) {
                 qCWarning(domain_server) << "Failed to create backup for" << rule.name << "at" << path;
                 continue;
@@ -739,3 +750,31 @@ std::pair<bool, QString> DomainContentBackupManager::createBackup(const QString&
 
     return { true, path };
 }
+
+std::pair<bool, QString> DomainContentBackupManager::copyBackup(const QString& sourcePath, const QString& prefix,
+                                                                const QString& name) {
+    auto timestamp = QDateTime::currentDateTime().toString(DATETIME_FORMAT);
+    auto fileName = prefix + name + "-" + timestamp + ".zip";
+    auto path = _backupDirectory + "/" + fileName;
+    if (!QFile::copy(sourcePath, path)) {
+        qCWarning(domain_server) << "Failed to copy backup" << sourcePath << "to" << path;
+        return { false, path };
+    }
+
+    // Let the handlers know about the new backup, as if they had written it themselves.
+    QuaZip zip(path);
+    if (!zip.open(QuaZip::mdUnzip)) {
+        qCWarning(domain_server) << "Failed to open zip file at " << path;
+        qCWarning(domain_server) << "    ERROR:" << zip.getZipError();
+        QFile::remove(path);
+        return { false, path };
+    }
+
+    for (auto& handler : _backupHandlers) {
+        handler->loadBackup(fileName, zip);
+    }
+
+    zip.close();
+
+    return { true, path };
+}
@@ -118,6 +118,7 @@ protected:
     void parseBackupRules(const QVariantList& backupRules);
 
     std::pair<bool, QString> createBackup(const QString& prefix, const QString& name);
+    std::pair<bool, QString> copyBackup(const QString& sourcePath, const QString& prefix, const QString& name);
 
     bool recoverFromBackupZip(const QString& backupName, QuaZip& backupZip, const QString& username, const QString& sourceFilename, bool rollingBack = false);
 
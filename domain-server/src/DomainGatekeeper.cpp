@@ -51,7 +51,7 @@ QUuid DomainGatekeeper::assignmentUUIDForPendingAssignment(const QUuid& tempUUID
 
 const NodeSet STATICALLY_ASSIGNED_NODES = NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer
         << NodeType::EntityServer << NodeType::AssetServer << NodeType::MessagesMixer
-        << NodeType::EntityScriptServer;
+        << NodeType::EntityScriptServer << NodeType::EntityPhysicsServer;
 
 void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessage> message) {
     if (message->getSize() == 0) {
@@ -75,7 +75,8 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
     }
 
     static const NodeSet VALID_NODE_TYPES {
-        NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::AssetServer, NodeType::EntityServer, NodeType::Agent, NodeType::MessagesMixer, NodeType::EntityScriptServer
+        NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::AssetServer, NodeType::EntityServer, NodeType::Agent, NodeType::MessagesMixer, NodeType::EntityScriptServer,
+        NodeType::EntityPhysicsServer
     };
 
     if (!VALID_NODE_TYPES.contains(nodeConnection.nodeType)) {
@@ -264,8 +265,8 @@ NodePermissions DomainGatekeeper::setPermissionsForUser(bool isLocalUser, QStrin
 
 void DomainGatekeeper::updateNodePermissions() {
     // If the permissions were changed on the domain-server webpage (and nothing else was), a restart isn't required --
-    // we reprocess the permissions map and update the nodes here.  The node list is frequently sent out to all
-    // the connected nodes, so these changes are propagated to other nodes.
+    // we reprocess the permissions map and update the nodes here.  Nodes whose permissions changed are recorded in the
+    // domain list change log, so these changes are propagated to other nodes with their next domain list.
 
     QList<SharedNodePointer> nodesToKill;
 
@@ -312,6 +313,11 @@ void DomainGatekeeper::updateNodePermissions() {
             userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        if (node->getPermissions().permissions != userPerms.permissions) {
+            // the other nodes hear about this change with their next domain list
+            _server->_domainListChanges.recordAddedOrUpdated(*node);
+        }
+
         node->setPermissions(userPerms);
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
@@ -360,6 +366,7 @@ SharedNodePointer DomainGatekeeper::processAssignmentConnectRequest(const NodeCo
 
     // set assignment related data on the linked data for this node
     nodeData->setAssignmentUUID(matchingQueuedAssignment->getUUID());
+    nodeData->setDeployedAssignmentUUID(nodeConnection.connectUUID);
     nodeData->setWalletUUID(it->second.getWalletUUID());
     nodeData->setNodeVersion(it->second.getNodeVersion());
     nodeData->setHardwareAddress(nodeConnection.hardwareAddress);
@@ -0,0 +1,73 @@
+//
+//  DomainListChangeLog.cpp
+//  domain-server/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainListChangeLog.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <UUIDHasher.h>
+
+// enough history for every node in a busy domain to miss a few check-ins without needing a full list
+const size_t MAX_DOMAIN_LIST_CHANGES = 4096;
+
+void DomainListChangeLog::record(const Node& node, EntryType type) {
+    ++_currentRevision;
+
+    if (_currentRevision == LimitedNodeList::NULL_DOMAIN_LIST_REVISION) {
+        // the revision wrapped around - drop the history so that every node gets a full list next
+        _changes.clear();
+        _currentRevision = LimitedNodeList::NULL_DOMAIN_LIST_REVISION + 1;
+        return;
+    }
+
+    _changes.push_back({ _currentRevision, node.getUUID(), node.getType(), type });
+
+    while (_changes.size() > MAX_DOMAIN_LIST_CHANGES) {
+        _changes.pop_front();
+    }
+}
+
+bool DomainListChangeLog::getChangesSince(Revision revision, std::vector<Change>& changes) const {
+    changes.clear();
+
+    if (revision == LimitedNodeList::NULL_DOMAIN_LIST_REVISION || revision > _currentRevision) {
+        // this node has never received a complete list, or it is from before a wrap-around or restart
+        return false;
+    }
+
+    if (revision == _currentRevision) {
+        return true;
+    }
+
+    // the first change after the given revision has to still be in our history
+    if (_changes.empty() || _changes.front().revision > revision + 1) {
+        return false;
+    }
+
+    // only the most recent change for each node matters to the receiver
+    std::unordered_map<QUuid, size_t> changeIndexForNode;
+
+    auto it = std::upper_bound(_changes.begin(), _changes.end(), revision, [](Revision value, const Change& change) {
+        return value < change.revision;
+    });
+
+    for (; it != _changes.end(); ++it) {
+        auto existing = changeIndexForNode.find(it->nodeUUID);
+        if (existing != changeIndexForNode.end()) {
+            changes[existing->second] = *it;
+        } else {
+            changeIndexForNode[it->nodeUUID] = changes.size();
+            changes.push_back(*it);
+        }
+    }
+
+    return true;
+}
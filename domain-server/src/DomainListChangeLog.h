@@ -0,0 +1,51 @@
+//
+//  DomainListChangeLog.h
+//  domain-server/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainListChangeLog_h
+#define hifi_DomainListChangeLog_h
+
+#include <deque>
+#include <vector>
+
+#include <QtCore/QUuid>
+
+#include <LimitedNodeList.h>
+
+// Keeps a bounded history of node additions, updates and removals so that a node checking in
+// can be sent only what changed since the last revision of the node list it fully received.
+class DomainListChangeLog {
+public:
+    using Revision = LimitedNodeList::DomainListRevision;
+    using EntryType = LimitedNodeList::DomainListEntryType;
+
+    struct Change {
+        Revision revision;
+        QUuid nodeUUID;
+        NodeType_t nodeType;
+        EntryType type;
+    };
+
+    Revision getCurrentRevision() const { return _currentRevision; }
+
+    void recordAddedOrUpdated(const Node& node) { record(node, EntryType::NodeAddedOrUpdated); }
+    void recordRemoved(const Node& node) { record(node, EntryType::NodeRemoved); }
+
+    // fills changes with the latest change for each node since the given revision
+    // returns false if that revision is unknown or has been pruned, in which case a full list must be sent
+    bool getChangesSince(Revision revision, std::vector<Change>& changes) const;
+
+private:
+    void record(const Node& node, EntryType type);
+
+    std::deque<Change> _changes;
+    Revision _currentRevision { LimitedNodeList::NULL_DOMAIN_LIST_REVISION + 1 };
+};
+
+#endif // hifi_DomainListChangeLog_h
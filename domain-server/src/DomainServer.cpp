@@ -164,6 +164,10 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     _gatekeeper(this),
     _httpManager(QHostAddress::AnyIPv4, DOMAIN_SERVER_HTTP_PORT, QString("%1/resources/web/").arg(QCoreApplication::applicationDirPath()), this)
 {
+    // keep admin traffic (uploads, backup downloads, the web interface) from holding up node check-ins
+    const int NUM_HTTP_WORKER_THREADS = 2;
+    _httpManager.startWorkerThreads(NUM_HTTP_WORKER_THREADS);
+
     if (_parentPID != -1) {
         watchParentProcess(_parentPID);
     }
@@ -762,11 +766,13 @@ void DomainServer::setupNodeListAndAssignments() {
     // register as the packet receiver for the types we want
     PacketReceiver& packetReceiver = nodeList->getPacketReceiver();
     packetReceiver.registerListener(PacketType::RequestAssignment, this, "processRequestAssignmentPacket");
+    packetReceiver.registerListener(PacketType::AssignmentClientFailed, this, "processAssignmentClientFailedPacket");
     packetReceiver.registerListener(PacketType::DomainListRequest, this, "processListRequestPacket");
     packetReceiver.registerListener(PacketType::DomainServerPathQuery, this, "processPathQueryPacket");
     packetReceiver.registerListener(PacketType::NodeJsonStats, this, "processNodeJSONStatsPacket");
     packetReceiver.registerListener(PacketType::DomainDisconnectRequest, this, "processNodeDisconnectRequestPacket");
     packetReceiver.registerListener(PacketType::AvatarZonePresence, this, "processAvatarZonePresencePacket");
+    packetReceiver.registerListener(PacketType::AudioShardHandoff, this, "processAudioShardHandoffPacket");
 
     // NodeList won't be available to the settings manager when it is created, so call registerListener here
     packetReceiver.registerListener(PacketType::DomainSettingsRequest, &_settingsManager, "processSettingsRequestPacket");
@@ -1059,6 +1065,38 @@ void DomainServer::populateDefaultStaticAssignmentsExcludingTypes(const QSet<Ass
                 continue;
             }
 
+            if (defaultedType == Assignment::EntityPhysicsServerType) {
+                // entity-physics-servers are only assigned when enabled, one per physics region if the domain has them
+                const QString PHYSICS_SERVER_ENABLED_KEY_PATH = "physics_server.enabled";
+                const QString PHYSICS_REGIONS_KEY_PATH = "physics_server.regions";
+                if (!_settingsManager.valueOrDefaultValueForKeyPath(PHYSICS_SERVER_ENABLED_KEY_PATH).toBool()) {
+                    continue;
+                }
+
+                int numPhysicsRegions = _settingsManager.valueForKeyPath(PHYSICS_REGIONS_KEY_PATH).toList().size();
+                for (int region = 0; region < numPhysicsRegions; ++region) {
+                    Assignment* regionAssignment = new Assignment(Assignment::CreateCommand, Assignment::EntityPhysicsServerType);
+                    regionAssignment->setPayload(QString("--region %1").arg(region).toUtf8());
+                    addStaticAssignmentToAssignmentHash(regionAssignment);
+                }
+                if (numPhysicsRegions > 0) {
+                    continue;
+                }
+            }
+
+            if (defaultedType == Assignment::AudioMixerType) {
+                // a domain split into audio shards gets one audio-mixer per shard, told which shard it mixes
+                int numAudioShards = getNumAudioShards();
+                if (numAudioShards > 1) {
+                    for (int shard = 0; shard < numAudioShards; ++shard) {
+                        Assignment* shardAssignment = new Assignment(Assignment::CreateCommand, Assignment::AudioMixerType);
+                        shardAssignment->setPayload(QString("--shard %1").arg(shard).toUtf8());
+                        addStaticAssignmentToAssignmentHash(shardAssignment);
+                    }
+                    continue;
+                }
+            }
+
             // type has not been set from a command line or config file config, use the default
             // by clearing whatever exists and writing a single default assignment with no payload
             Assignment* newAssignment = new Assignment(Assignment::CreateCommand, (Assignment::Type) defaultedType);
@@ -1071,9 +1109,22 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
+    // newer nodes follow the request with the revision of the last domain list they fully received,
+    // so that we only need to send them what changed since
+    DomainListChangeLog::Revision knownRevision = LimitedNodeList::NULL_DOMAIN_LIST_REVISION;
+    if (!packetStream.atEnd()) {
+        packetStream >> knownRevision;
+    }
+
     // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+
+        // the other nodes need to hear about the new sockets with their next domain list
+        _domainListChanges.recordAddedOrUpdated(*sendingNode);
+    }
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
@@ -1099,12 +1150,23 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false, knownRevision);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
     auto nodeAData = static_cast<DomainServerNodeData*>(nodeA->getLinkedData());
-    return nodeAData && nodeAData->getNodeInterestSet().contains(nodeB->getType());
+    if (!nodeAData || !nodeAData->getNodeInterestSet().contains(nodeB->getType())) {
+        return false;
+    }
+
+    // agents in a domain split into audio shards only know about the mixer they are homed on
+    if (nodeA->getType() == NodeType::Agent && nodeB->getType() == NodeType::AudioMixer) {
+        auto nodeBData = static_cast<DomainServerNodeData*>(nodeB->getLinkedData());
+        return !nodeBData || nodeBData->getAudioShard() == DomainServerNodeData::NO_AUDIO_SHARD
+            || nodeBData->getAudioShard() == nodeAData->getAudioShard();
+    }
+
+    return true;
 }
 
 unsigned int DomainServer::countConnectedUsers() {
@@ -1177,11 +1239,84 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
+    if (newNode->getType() == NodeType::AudioMixer) {
+        // pull the shard this mixer was deployed for from the payload of its assignment, before agents hear about it
+        int audioShard = DomainServerNodeData::NO_AUDIO_SHARD;
+
+        SharedAssignmentPointer matchingAssignment = _allAssignments.value(nodeData->getAssignmentUUID());
+        if (matchingAssignment) {
+            QStringList payloadArguments = QString(matchingAssignment->getPayload()).split(" ", QString::SkipEmptyParts);
+            int shardArgumentIndex = payloadArguments.indexOf("--shard");
+            if (shardArgumentIndex >= 0 && shardArgumentIndex + 1 < payloadArguments.size()) {
+                bool ok;
+                int shard = payloadArguments[shardArgumentIndex + 1].toInt(&ok);
+                if (ok && shard >= 0) {
+                    audioShard = shard;
+                }
+            }
+        }
+
+        nodeData->setAudioShard(audioShard);
+    } else if (newNode->getType() == NodeType::Agent && getNumAudioShards() > 1) {
+        // agents start on the mixer of the first shard, which hands them off once it knows where they are
+        nodeData->setAudioShard(0);
+    }
+
+    // record the addition so that nodes which miss the broadcast below pick it up with their next domain list
+    _domainListChanges.recordAddedOrUpdated(*newNode);
+
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
+
+    if (newNode->getType() == NodeType::AudioMixer && nodeData->getAudioShard() != DomainServerNodeData::NO_AUDIO_SHARD) {
+        sendAudioShardPeers();
+    }
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr &senderSockAddr,
+                                        bool newConnection, DomainListChangeLog::Revision knownRevision) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+
+    // figure out which entries this node needs - when it has fully received a recent revision of the list we only
+    // send it the additions and removals since that revision, otherwise it gets every node it is interested in
+    std::vector<DomainListChangeLog::Change> changes;
+    bool isDelta = !newConnection && _domainListChanges.getChangesSince(knownRevision, changes);
+
+    std::vector<SharedNodePointer> addedNodes;
+    std::vector<QUuid> removedNodeUUIDs;
+
+    if (nodeInterestSet.size() > 0 && nodeData->isAuthenticated()) {
+        if (isDelta) {
+            for (const auto& change : changes) {
+                if (change.nodeUUID == node->getUUID() || !nodeInterestSet.contains(change.nodeType)) {
+                    continue;
+                }
+
+                // a node that is still around but that this node is no longer interested in (e.g. the audio-mixer of
+                // a shard it left) is removed as well
+                auto otherNode = limitedNodeList->nodeWithUUID(change.nodeUUID);
+                if (otherNode && isInInterestSet(node, otherNode)) {
+                    if (change.type == DomainListChangeLog::EntryType::NodeAddedOrUpdated) {
+                        addedNodes.push_back(otherNode);
+                    }
+                } else {
+                    removedNodeUUIDs.push_back(change.nodeUUID);
+                }
+            }
+        } else {
+            // if this authenticated node has any interest types, send back those nodes as well
+            limitedNodeList->eachNode([this, node, &addedNodes](const SharedNodePointer& otherNode) {
+                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                    addedNodes.push_back(otherNode);
+                }
+            });
+        }
+    }
+
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
@@ -1189,8 +1324,6 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
@@ -1202,35 +1335,43 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+
+    // the revision this list brings the node to, the revision it is a delta from (null for a full list), the sequence
+    // number of this list and its total number of entries, so the node can tell when it has received every packet of
+    // this particular list, even when another list for the same revision is on its way
+    extendedHeaderStream << _domainListChanges.getCurrentRevision();
+    extendedHeaderStream << (isDelta ? knownRevision : LimitedNodeList::NULL_DOMAIN_LIST_REVISION);
+    extendedHeaderStream << ++_domainListSequenceNumber;
+    extendedHeaderStream << quint32(addedNodes.size() + removedNodeUUIDs.size());
+
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+    for (const auto& otherNode : addedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-    if (nodeInterestSet.size() > 0) {
+        domainListStream << quint8(LimitedNodeList::NodeAddedOrUpdated);
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
+    }
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+    for (const auto& removedNodeUUID : removedNodeUUIDs) {
+        domainListPackets->startSegment();
+
+        domainListStream << quint8(LimitedNodeList::NodeRemoved);
+        domainListStream << removedNodeUUID;
+
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -1300,18 +1441,104 @@ void DomainServer::broadcastNewNode(const SharedNodePointer& addedNode) {
     );
 }
 
+int DomainServer::getNumAudioShards() {
+    const QString AUDIO_SHARDS_KEY_PATH = "audio_sharding.shards";
+    return _settingsManager.valueForKeyPath(AUDIO_SHARDS_KEY_PATH).toList().size();
+}
+
+void DomainServer::sendAudioShardPeers() {
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    std::vector<SharedNodePointer> shardMixers;
+    limitedNodeList->eachNode([&shardMixers](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (node->getType() == NodeType::AudioMixer && nodeData
+            && nodeData->getAudioShard() != DomainServerNodeData::NO_AUDIO_SHARD) {
+            shardMixers.push_back(node);
+        }
+    });
+
+    // tell each mixer of a shard where the mixers of the other shards are, so it can forward streams across borders
+    for (const auto& mixer : shardMixers) {
+        auto peersPacket = NLPacket::create(PacketType::AudioShardPeers, -1, true);
+        QDataStream peersStream(peersPacket.get());
+
+        peersStream << quint8(shardMixers.size() - 1);
+        for (const auto& peer : shardMixers) {
+            if (peer != mixer) {
+                auto peerData = static_cast<DomainServerNodeData*>(peer->getLinkedData());
+                peersStream << quint8(peerData->getAudioShard()) << peer->getPublicSocket() << peer->getLocalSocket();
+            }
+        }
+
+        limitedNodeList->sendPacket(std::move(peersPacket), *mixer);
+    }
+}
+
+void DomainServer::processAudioShardHandoffPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+    auto mixerData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
+
+    if (sendingNode->getType() != NodeType::AudioMixer || !mixerData
+        || mixerData->getAudioShard() == DomainServerNodeData::NO_AUDIO_SHARD) {
+        return;
+    }
+
+    QUuid agentUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    quint8 newShard;
+    message->readPrimitive(&newShard);
+
+    auto agent = limitedNodeList->nodeWithUUID(agentUUID);
+    auto agentData = agent ? static_cast<DomainServerNodeData*>(agent->getLinkedData()) : nullptr;
+
+    // only the mixer an agent is homed on can move it, which also drops repeats of a handoff that already happened
+    if (!agentData || agent->getType() != NodeType::Agent || agentData->getAudioShard() != mixerData->getAudioShard()) {
+        return;
+    }
+
+    SharedNodePointer newMixer;
+    limitedNodeList->eachNode([&newMixer, newShard](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (node->getType() == NodeType::AudioMixer && nodeData && nodeData->getAudioShard() == newShard) {
+            newMixer = node;
+        }
+    });
+
+    if (!newMixer) {
+        // the mixer for that shard is not up yet, the agent stays where it is and its mixer will ask again
+        return;
+    }
+
+    qDebug() << "Handing agent" << uuidStringWithoutCurlyBraces(agentUUID) << "off from audio shard"
+        << mixerData->getAudioShard() << "to" << newShard;
+
+    agentData->setAudioShard(newShard);
+
+    if (!agentData->getNodeInterestSet().contains(NodeType::AudioMixer)) {
+        return;
+    }
+
+    // the agent swaps the mixer it knows about with its next domain list, which removes the mixers it is no longer
+    // interested in and adds the one it now is
+    _domainListChanges.recordAddedOrUpdated(*sendingNode);
+    _domainListChanges.recordAddedOrUpdated(*newMixer);
+}
+
+bool DomainServer::isAllowedAssignmentClientAddress(const QHostAddress& address) const {
+    auto isHostAddressInSubnet = [&address](const Subnet& mask) -> bool {
+        return address.isInSubnet(mask);
+    };
+
+    return std::any_of(_acSubnetWhitelist.begin(), _acSubnetWhitelist.end(), isHostAddressInSubnet);
+}
+
 void DomainServer::processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> message) {
     // construct the requested assignment from the packet data
     Assignment requestAssignment(*message);
 
     auto senderAddr = message->getSenderSockAddr().getAddress();
 
-    auto isHostAddressInSubnet = [&senderAddr](const Subnet& mask) -> bool {
-        return senderAddr.isInSubnet(mask);
-    };
-
-    auto it = find_if(_acSubnetWhitelist.begin(), _acSubnetWhitelist.end(), isHostAddressInSubnet);
-    if (it == _acSubnetWhitelist.end()) {
+    if (!isAllowedAssignmentClientAddress(senderAddr)) {
         HIFI_FDEBUG("Received an assignment connect request from a disallowed ip address:"
             << senderAddr.toString());
         return;
@@ -1326,42 +1553,132 @@ void DomainServer::processRequestAssignmentPacket(QSharedPointer<ReceivedMessage
 
     SharedAssignmentPointer assignmentToDeploy = deployableAssignmentForRequest(requestAssignment);
 
+    auto standby = std::find_if(_standbyAssignmentClients.begin(), _standbyAssignmentClients.end(),
+                           [&](const StandbyAssignmentClient& standby) {
+        return standby.sockAddr == message->getSenderSockAddr();
+    });
+
     if (assignmentToDeploy) {
-        qDebug() << "Deploying assignment -" << *assignmentToDeploy.data() << "- to" << message->getSenderSockAddr();
+        if (standby != _standbyAssignmentClients.end()) {
+            _standbyAssignmentClients.erase(standby);
+        }
 
-        // give this assignment out, either the type matches or the requestor said they will take any
-        static std::unique_ptr<NLPacket> assignmentPacket;
+        deployAssignment(assignmentToDeploy, requestAssignment, message->getSenderSockAddr());
+    } else {
+        // remember this idle assignment-client, it can take over the next assignment that fails
+        if (standby != _standbyAssignmentClients.end()) {
+            standby->request = requestAssignment;
+            standby->lastRequestUsecs = usecTimestampNow();
+        } else {
+            _standbyAssignmentClients.push_back({ requestAssignment, message->getSenderSockAddr(), usecTimestampNow() });
+        }
 
-        if (!assignmentPacket) {
-            assignmentPacket = NLPacket::create(PacketType::CreateAssignment);
+        static bool printedAssignmentRequestMessage = false;
+        if (!printedAssignmentRequestMessage && requestAssignment.getType() != Assignment::AgentType) {
+            printedAssignmentRequestMessage = true;
+            qDebug() << "Unable to fulfill assignment request of type" << requestAssignment.getType()
+                << "from" << message->getSenderSockAddr();
         }
+    }
+}
 
-        // setup a copy of this assignment that will have a unique UUID, for packaging purposes
-        Assignment uniqueAssignment(*assignmentToDeploy.data());
-        uniqueAssignment.setUUID(QUuid::createUuid());
+void DomainServer::deployAssignment(const SharedAssignmentPointer& assignment, const Assignment& requestAssignment,
+                                    const HifiSockAddr& sockAddr) {
+    qDebug() << "Deploying assignment -" << *assignment.data() << "- to" << sockAddr;
 
-        // reset the assignmentPacket
-        assignmentPacket->reset();
+    // give this assignment out, either the type matches or the requestor said they will take any
+    static std::unique_ptr<NLPacket> assignmentPacket;
 
-        QDataStream assignmentStream(assignmentPacket.get());
+    if (!assignmentPacket) {
+        assignmentPacket = NLPacket::create(PacketType::CreateAssignment);
+    }
 
-        assignmentStream << uniqueAssignment;
+    // setup a copy of this assignment that will have a unique UUID, for packaging purposes
+    Assignment uniqueAssignment(*assignment.data());
+    uniqueAssignment.setUUID(QUuid::createUuid());
 
-        auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-        limitedNodeList->sendUnreliablePacket(*assignmentPacket, message->getSenderSockAddr());
+    // reset the assignmentPacket
+    assignmentPacket->reset();
 
-        // give the information for that deployed assignment to the gatekeeper so it knows to that that node
-        // in when it comes back around
-        _gatekeeper.addPendingAssignedNode(uniqueAssignment.getUUID(), assignmentToDeploy->getUUID(),
-                                           requestAssignment.getWalletUUID(), requestAssignment.getNodeVersion());
-    } else {
-        static bool printedAssignmentRequestMessage = false;
-        if (!printedAssignmentRequestMessage && requestAssignment.getType() != Assignment::AgentType) {
-            printedAssignmentRequestMessage = true;
-            qDebug() << "Unable to fulfill assignment request of type" << requestAssignment.getType()
-                << "from" << message->getSenderSockAddr();
+    QDataStream assignmentStream(assignmentPacket.get());
+
+    assignmentStream << uniqueAssignment;
+
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+    limitedNodeList->sendUnreliablePacket(*assignmentPacket, sockAddr);
+
+    // give the information for that deployed assignment to the gatekeeper so it knows to that that node
+    // in when it comes back around
+    _gatekeeper.addPendingAssignedNode(uniqueAssignment.getUUID(), assignment->getUUID(),
+                                       requestAssignment.getWalletUUID(), requestAssignment.getNodeVersion());
+}
+
+void DomainServer::deployAssignmentToStandby(const SharedAssignmentPointer& assignment) {
+    // standby assignment-clients re-request every second while idle, one we have not heard from
+    // in a while has likely been given something else to do or gone away
+    static const quint64 STANDBY_ASSIGNMENT_CLIENT_TIMEOUT_USECS = 2 * USECS_PER_SECOND;
+
+    auto now = usecTimestampNow();
+    _standbyAssignmentClients.erase(std::remove_if(_standbyAssignmentClients.begin(), _standbyAssignmentClients.end(),
+                                              [&](const StandbyAssignmentClient& standby) {
+        return now - standby.lastRequestUsecs > STANDBY_ASSIGNMENT_CLIENT_TIMEOUT_USECS;
+    }), _standbyAssignmentClients.end());
+
+    // prefer a client dedicated to this type, it has already prepared for it
+    auto bestStandby = _standbyAssignmentClients.end();
+    for (auto it = _standbyAssignmentClients.begin(); it != _standbyAssignmentClients.end(); ++it) {
+        const Assignment& request = it->request;
+        bool typesMatch = request.getType() == assignment->getType();
+        bool poolsMatch = request.getPool() == assignment->getPool();
+
+        if ((typesMatch || request.getType() == Assignment::AllTypes) && poolsMatch) {
+            if (bestStandby == _standbyAssignmentClients.end() || typesMatch) {
+                bestStandby = it;
+            }
+            if (typesMatch) {
+                break;
+            }
         }
     }
+
+    if (bestStandby != _standbyAssignmentClients.end()) {
+        // the assignment stays queued until the standby connects, as it would for a regular request
+        auto standby = *bestStandby;
+        _standbyAssignmentClients.erase(bestStandby);
+        deployAssignment(assignment, standby.request, standby.sockAddr);
+    }
+}
+
+void DomainServer::processAssignmentClientFailedPacket(QSharedPointer<ReceivedMessage> message) {
+    // sent by an assignment-client monitor when one of its children died while running an assignment
+    if (!isAllowedAssignmentClientAddress(message->getSenderSockAddr().getAddress())) {
+        return;
+    }
+
+    auto deployedAssignmentUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    if (deployedAssignmentUUID.isNull()) {
+        return;
+    }
+
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    SharedNodePointer failedNode;
+    limitedNodeList->eachNodeBreakable([&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (nodeData && nodeData->getDeployedAssignmentUUID() == deployedAssignmentUUID) {
+            failedNode = node;
+            return false;
+        }
+        return true;
+    });
+
+    if (failedNode) {
+        qDebug() << "Assignment-client monitor at" << message->getSenderSockAddr() << "reported node"
+            << uuidStringWithoutCurlyBraces(failedNode->getUUID()) << "as failed, removing it";
+
+        // this requeues its assignment, which goes straight to a standby assignment-client if we have one
+        handleKillNode(failedNode);
+    }
 }
 
 void DomainServer::setupPendingAssignmentCredits() {
@@ -1966,7 +2283,6 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
     const QString URI_ASSIGNMENT = "/assignment";
     const QString URI_NODES = "/nodes";
     const QString URI_SETTINGS = "/settings";
-    const QString URI_CONTENT_UPLOAD = "/content/upload";
     const QString URI_RESTART = "/restart";
     const QString URI_API_METAVERSE_INFO = "/api/metaverse_info";
     const QString URI_API_PLACES = "/api/places";
@@ -1974,7 +2290,6 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
     const QString URI_API_DOMAINS_ID = "/api/domains/";
     const QString URI_API_BACKUPS = "/api/backups";
     const QString URI_API_BACKUPS_ID = "/api/backups/";
-    const QString URI_API_BACKUPS_DOWNLOAD_ID = "/api/backups/download/";
     const QString URI_API_BACKUPS_RECOVER = "/api/backups/recover/";
 
     const QString UUID_REGEX_STRING = "[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}";
@@ -2181,30 +2496,6 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             });
             _contentManager->getAllBackupsAndStatus(deferred);
             return true;
-        } else if (url.path().startsWith(URI_API_BACKUPS_DOWNLOAD_ID)) {
-            auto id = url.path().mid(QString(URI_API_BACKUPS_DOWNLOAD_ID).length());
-            auto info = _contentManager->consolidateBackup(id);
-
-            if (info.state == ConsolidatedBackupInfo::COMPLETE_WITH_SUCCESS) {
-                auto file { std::unique_ptr<QFile>(new QFile(info.absoluteFilePath)) };
-                if (file->open(QIODevice::ReadOnly)) {
-                    constexpr const char* CONTENT_TYPE_ZIP = "application/zip";
-                    auto downloadedFilename = id;
-                    downloadedFilename.replace(QRegularExpression(".zip$"), ".content.zip");
-                    auto contentDisposition = "attachment; filename=\"" + downloadedFilename + "\"";
-                    connectionPtr->respond(HTTPConnection::StatusCode200, std::move(file), CONTENT_TYPE_ZIP, {
-                        { "Content-Disposition", contentDisposition.toUtf8() }
-                    });
-                } else {
-                    qCritical(domain_server) << "Unable to load consolidated backup at:" << info.absoluteFilePath;
-                    connectionPtr->respond(HTTPConnection::StatusCode500, "Error opening backup");
-                }
-            } else if (info.state == ConsolidatedBackupInfo::COMPLETE_WITH_ERROR) {
-                connectionPtr->respond(HTTPConnection::StatusCode500, ("Error creating backup: " + info.error).toUtf8());
-            } else {
-                connectionPtr->respond(HTTPConnection::StatusCode400, "Backup unavailable");
-            }
-            return true;
         } else if (url.path().startsWith(URI_API_BACKUPS_ID)) {
             auto id = url.path().mid(QString(URI_API_BACKUPS_ID).length());
             auto info = _contentManager->consolidateBackup(id);
@@ -2312,35 +2603,6 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             connection->respond(HTTPConnection::StatusCode200);
 
             return true;
-        } else if (url.path() == URI_CONTENT_UPLOAD) {
-            // this is an entity file upload, ask the HTTPConnection to parse the data
-            QList<FormData> formData = connection->parseFormData();
-
-            if (formData.size() > 0 && formData[0].second.size() > 0) {
-                auto& firstFormData = formData[0];
-
-                // check the file extension to see what kind of file this is
-                // to make sure we handle this filetype for a content restore
-                auto dispositionValue = QString(firstFormData.first.value("Content-Disposition"));
-                QRegExp formDataFieldsRegex(R":(name="(restore-file.*)".*filename="(.+)"):");
-                auto matchIndex = formDataFieldsRegex.indexIn(dispositionValue);
-
-                QString formItemName = "";
-                QString uploadedFilename = "";
-                if (matchIndex != -1) {
-                    formItemName = formDataFieldsRegex.cap(1);
-                    uploadedFilename = formDataFieldsRegex.cap(2);
-                }
-
-                // Received a chunk
-                processPendingContent(connection, formItemName, uploadedFilename, firstFormData.second);
-            } else {
-                // respond with a 400 for failure
-                connection->respond(HTTPConnection::StatusCode400);
-            }
-
-            return true;
-
         } else if (url.path() == URI_API_BACKUPS) {
             auto params = connection->parseUrlEncodedForm();
             auto it = params.find("name");
@@ -2532,6 +2794,85 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 static const QString HIFI_SESSION_COOKIE_KEY = "DS_WEB_SESSION_UUID";
 static const QString STATE_QUERY_KEY = "state";
 
+bool DomainServer::handleHTTPRequestOnConnectionThread(HTTPConnection* connection, const QUrl& url) {
+    // uploaded content and backup downloads can be large - parse, store and stream them on the connection's
+    // HTTP worker thread, so that node check-ins aren't held up behind them
+    const QString URI_CONTENT_UPLOAD = "/content/upload";
+    const QString URI_API_BACKUPS_DOWNLOAD_ID = "/api/backups/download/";
+
+    bool isContentUpload = connection->requestOperation() == QNetworkAccessManager::PostOperation
+        && url.path() == URI_CONTENT_UPLOAD;
+    bool isBackupDownload = connection->requestOperation() == QNetworkAccessManager::GetOperation
+        && url.path().startsWith(URI_API_BACKUPS_DOWNLOAD_ID);
+
+    if (!isContentUpload && !isBackupDownload) {
+        return false;
+    }
+
+    bool isAuthenticated { false };
+    QString username;
+    std::tie(isAuthenticated, username) = isAuthenticatedRequest(connection);
+    if (!isAuthenticated) {
+        // this is not an authenticated request
+        // return true from the handler since it was handled with a 401 or re-direct to auth
+        return true;
+    }
+
+    if (isContentUpload) {
+        // this is an entity file upload, ask the HTTPConnection to parse the data
+        QList<FormData> formData = connection->parseFormData();
+
+        if (formData.size() > 0 && formData[0].second.size() > 0) {
+            auto& firstFormData = formData[0];
+
+            // check the file extension to see what kind of file this is
+            // to make sure we handle this filetype for a content restore
+            auto dispositionValue = QString(firstFormData.first.value("Content-Disposition"));
+            QRegExp formDataFieldsRegex(R":(name="(restore-file.*)".*filename="(.+)"):");
+            auto matchIndex = formDataFieldsRegex.indexIn(dispositionValue);
+
+            QString formItemName = "";
+            QString uploadedFilename = "";
+            if (matchIndex != -1) {
+                formItemName = formDataFieldsRegex.cap(1);
+                uploadedFilename = formDataFieldsRegex.cap(2);
+            }
+
+            // Received a chunk
+            processPendingContent(connection, formItemName, uploadedFilename, firstFormData.second, username);
+        } else {
+            // respond with a 400 for failure
+            connection->respond(HTTPConnection::StatusCode400);
+        }
+
+        return true;
+    }
+
+    auto id = url.path().mid(QString(URI_API_BACKUPS_DOWNLOAD_ID).length());
+    auto info = _contentManager->consolidateBackup(id);
+
+    if (info.state == ConsolidatedBackupInfo::COMPLETE_WITH_SUCCESS) {
+        auto file { std::unique_ptr<QFile>(new QFile(info.absoluteFilePath)) };
+        if (file->open(QIODevice::ReadOnly)) {
+            constexpr const char* CONTENT_TYPE_ZIP = "application/zip";
+            auto downloadedFilename = id;
+            downloadedFilename.replace(QRegularExpression(".zip$"), ".content.zip");
+            auto contentDisposition = "attachment; filename=\"" + downloadedFilename + "\"";
+            connection->respond(HTTPConnection::StatusCode200, std::move(file), CONTENT_TYPE_ZIP, {
+                { "Content-Disposition", contentDisposition.toUtf8() }
+            });
+        } else {
+            qCritical(domain_server) << "Unable to load consolidated backup at:" << info.absoluteFilePath;
+            connection->respond(HTTPConnection::StatusCode500, "Error opening backup");
+        }
+    } else if (info.state == ConsolidatedBackupInfo::COMPLETE_WITH_ERROR) {
+        connection->respond(HTTPConnection::StatusCode500, ("Error creating backup: " + info.error).toUtf8());
+    } else {
+        connection->respond(HTTPConnection::StatusCode400, "Backup unavailable");
+    }
+    return true;
+}
+
 bool DomainServer::handleHTTPSRequest(HTTPSConnection* connection, const QUrl &url, bool skipSubHandler) {
     if (url.path() == URI_OAUTH) {
 
@@ -2542,7 +2883,13 @@ bool DomainServer::handleHTTPSRequest(HTTPSConnection* connection, const QUrl &u
 
         QUuid stateUUID = QUuid(codeURLQuery.queryItemValue(STATE_QUERY_KEY));
 
-        if (!authorizationCode.isEmpty() && !stateUUID.isNull() && _webAuthenticationStateSet.remove(stateUUID)) {
+        bool isPendingState { false };
+        if (!stateUUID.isNull()) {
+            std::lock_guard<std::mutex> lock { _webSessionsMutex };
+            isPendingState = _webAuthenticationStateSet.remove(stateUUID);
+        }
+
+        if (!authorizationCode.isEmpty() && isPendingState) {
             // fire off a request with this code and state to get an access token for the user
 
             const QString OAUTH_TOKEN_REQUEST_PATH = "/oauth/token";
@@ -2579,21 +2926,24 @@ bool DomainServer::handleHTTPSRequest(HTTPSConnection* connection, const QUrl &u
     }
 }
 
-bool DomainServer::processPendingContent(HTTPConnection* connection, QString itemName, QString filename, QByteArray dataChunk) {
+bool DomainServer::processPendingContent(HTTPConnection* connection, QString itemName, QString filename, QByteArray dataChunk,
+                                         QString username) {
     static const QString UPLOAD_SESSION_KEY { "X-Session-Id" };
     QByteArray sessionIdBytes = connection->requestHeader(UPLOAD_SESSION_KEY);
     int sessionId = sessionIdBytes.toInt();
 
     bool newUpload = itemName == "restore-file" || itemName == "restore-file-chunk-initial" || itemName == "restore-file-chunk-only";
-    bool isAuthenticated;
-    QString username;
-    std::tie(isAuthenticated, username) = isAuthenticatedRequest(connection);
+
+    // this runs on the HTTP worker threads, so uploads in progress are guarded
+    std::unique_lock<std::mutex> lock { _pendingContentMutex };
 
     if (filename.endsWith(".zip", Qt::CaseInsensitive)) {
         static const QString TEMPORARY_CONTENT_FILEPATH { QDir::tempPath() + "/hifiUploadContent_XXXXXX.zip" };
 
         if (_pendingContentFiles.find(sessionId) == _pendingContentFiles.end()) {
             if (!newUpload) {
+                qCDebug(domain_server) << "Content upload with invalid session ID received";
+                connection->respond(HTTPConnection::StatusCode400);
                 return false;
             }
             std::unique_ptr<QTemporaryFile> newTemp(new QTemporaryFile(TEMPORARY_CONTENT_FILEPATH));
@@ -2606,7 +2956,7 @@ bool DomainServer::processPendingContent(HTTPConnection* connection, QString ite
         QTemporaryFile& _pendingFileContent = *_pendingContentFiles[sessionId];
         if (!_pendingFileContent.open()) {
             _pendingContentFiles.erase(sessionId);
-            connection->respond(HTTPConnection::StatusCode400);
+            connection->respond(HTTPConnection::StatusCode500);
             return false;
         }
         _pendingFileContent.seek(_pendingFileContent.size());
@@ -2619,6 +2969,7 @@ bool DomainServer::processPendingContent(HTTPConnection* connection, QString ite
             auto deferred = makePromise("recoverFromUploadedBackup");
 
             deferred->then([this, sessionId](QString error, QVariantMap result) {
+                std::lock_guard<std::mutex> lock { _pendingContentMutex };
                 _pendingContentFiles.erase(sessionId);
             });
 
@@ -2628,18 +2979,27 @@ bool DomainServer::processPendingContent(HTTPConnection* connection, QString ite
         || filename.endsWith(".json.gz", Qt::CaseInsensitive)) {
         if (_pendingUploadedContents.find(sessionId) == _pendingUploadedContents.end() && !newUpload) {
             qCDebug(domain_server) << "Json upload with invalid session ID received";
+            connection->respond(HTTPConnection::StatusCode400);
             return false;
         }
         QByteArray& _pendingUploadedContent = _pendingUploadedContents[sessionId];
         _pendingUploadedContent += dataChunk;
 
         if (itemName == "restore-file" || itemName == "restore-file-chunk-final" || itemName == "restore-file-chunk-only") {
-            // invoke our method to hand the new octree file off to the octree server
-            if (!handleOctreeFileReplacement(_pendingUploadedContent, filename, QString(), username)) {
-                connection->respond(HTTPConnection::StatusCode400);
-                return false;
-            }
+            QByteArray uploadedContent = _pendingUploadedContent;
             _pendingUploadedContents.erase(sessionId);
+            lock.unlock();
+
+            // hand the new octree file off to the octree server on our thread, and respond once it has been taken.
+            // The connection stays alive until it has responded, unless the HTTP manager is torn down on our thread first.
+            QPointer<HTTPConnection> connectionPtr { connection };
+            QMetaObject::invokeMethod(this, [this, connectionPtr, uploadedContent, filename, username] {
+                bool replaced = handleOctreeFileReplacement(uploadedContent, filename, QString(), username);
+                if (connectionPtr) {
+                    connectionPtr->respond(replaced ? HTTPConnection::StatusCode204 : HTTPConnection::StatusCode400);
+                }
+            }, Qt::QueuedConnection);
+            return true;
         }
         connection->respond(HTTPConnection::StatusCode204);
     } else {
@@ -2740,9 +3100,12 @@ std::pair<bool, QString>  DomainServer::isAuthenticatedRequest(HTTPConnection* c
                 << "These cannot be combined - using OAuth for authentication.";
         }
 
+        std::unique_lock<std::mutex> sessionsLock { _webSessionsMutex };
         if (!cookieUUID.isNull() && _cookieSessionHash.contains(cookieUUID)) {
             // pull the QJSONObject for the user with this cookie UUID
             DomainServerWebSessionData sessionData = _cookieSessionHash.value(cookieUUID);
+            sessionsLock.unlock();
+
             QString profileUsername = sessionData.getUsername();
 
             if (_settingsManager.valueForKeyPath(ADMIN_USERS_CONFIG_KEY).toStringList().contains(profileUsername)) {
@@ -2767,6 +3130,8 @@ std::pair<bool, QString>  DomainServer::isAuthenticatedRequest(HTTPConnection* c
             // the user does not have allowed username or role, return 401
             return { false, QString() };
         } else {
+            sessionsLock.unlock();
+
             static const QByteArray REQUESTED_WITH_HEADER = "X-Requested-With";
             static const QString XML_REQUESTED_WITH = "XMLHttpRequest";
 
@@ -2781,7 +3146,10 @@ std::pair<bool, QString>  DomainServer::isAuthenticatedRequest(HTTPConnection* c
                 QUuid stateUUID = QUuid::createUuid();
 
                 // add it to the set so we can handle the callback from the OAuth provider
-                _webAuthenticationStateSet.insert(stateUUID);
+                {
+                    std::lock_guard<std::mutex> lock { _webSessionsMutex };
+                    _webAuthenticationStateSet.insert(stateUUID);
+                }
 
                 QUrl authURL = oauthAuthorizationURL(stateUUID);
 
@@ -2883,7 +3251,10 @@ Headers DomainServer::setupCookieHeadersFromProfileReply(QNetworkReply* profileR
 
     // add the profile to our in-memory data structure so we know who the user is when they send us their cookie
     DomainServerWebSessionData sessionData(userObject);
-    _cookieSessionHash.insert(cookieUUID, sessionData);
+    {
+        std::lock_guard<std::mutex> lock { _webSessionsMutex };
+        _cookieSessionHash.insert(cookieUUID, sessionData);
+    }
 
     // setup expiry for cookie to 1 month from today
     QDateTime cookieExpiry = QDateTime::currentDateTimeUtc().addMonths(1);
@@ -2915,6 +3286,8 @@ void DomainServer::refreshStaticAssignmentAndAddToQueue(SharedAssignmentPointer&
     // add the static assignment back under the right UUID, and to the queue
     _allAssignments.insert(assignment->getUUID(), assignment);
     _unfulfilledAssignments.enqueue(assignment);
+
+    deployAssignmentToStandby(assignment);
 }
 
 static const QString BROADCASTING_SETTINGS_KEY = "broadcasting";
@@ -3130,7 +3503,14 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
         }
     }
 
+    _domainListChanges.recordRemoved(*node);
+
     broadcastNodeDisconnect(node);
+
+    if (node->getType() == NodeType::AudioMixer && nodeData
+        && nodeData->getAudioShard() != DomainServerNodeData::NO_AUDIO_SHARD) {
+        sendAudioShardPeers();
+    }
 }
 
 SharedAssignmentPointer DomainServer::dequeueMatchingAssignment(const QUuid& assignmentUUID, NodeType_t nodeType) {
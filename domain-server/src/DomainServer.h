@@ -29,6 +29,7 @@
 
 #include "AssetsBackupHandler.h"
 #include "DomainGatekeeper.h"
+#include "DomainListChangeLog.h"
 #include "DomainMetadata.h"
 #include "DomainServerSettingsManager.h"
 #include "DomainServerWebSessionData.h"
@@ -72,6 +73,7 @@ public:
     static int const EXIT_CODE_REBOOT;
 
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+    bool handleHTTPRequestOnConnectionThread(HTTPConnection* connection, const QUrl& url) override;
     bool handleHTTPSRequest(HTTPSConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 
     static const QString REPLACEMENT_FILE_EXTENSION;
@@ -92,6 +94,7 @@ public slots:
 
 private slots:
     void processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> packet);
+    void processAssignmentClientFailedPacket(QSharedPointer<ReceivedMessage> message);
     void processListRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
     void processPathQueryPacket(QSharedPointer<ReceivedMessage> packet);
@@ -99,6 +102,7 @@ private slots:
     void processICEServerHeartbeatDenialPacket(QSharedPointer<ReceivedMessage> message);
     void processICEServerHeartbeatACK(QSharedPointer<ReceivedMessage> message);
     void processAvatarZonePresencePacket(QSharedPointer<ReceivedMessage> packet);
+    void processAudioShardHandoffPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 
     void handleDomainContentReplacementFromURLRequest(QSharedPointer<ReceivedMessage> message);
     void handleOctreeFileReplacementRequest(QSharedPointer<ReceivedMessage> message);
@@ -181,12 +185,16 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const HifiSockAddr& senderSockAddr,
+                              bool newConnection,
+                              DomainListChangeLog::Revision knownRevision = LimitedNodeList::NULL_DOMAIN_LIST_REVISION);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
     QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
     void broadcastNewNode(const SharedNodePointer& node);
+    int getNumAudioShards();
+    void sendAudioShardPeers();
 
     void parseAssignmentConfigs(QSet<Assignment::Type>& excludedTypes);
     void addStaticAssignmentToAssignmentHash(Assignment* newAssignment);
@@ -196,6 +204,10 @@ private:
 
     SharedAssignmentPointer dequeueMatchingAssignment(const QUuid& checkInUUID, NodeType_t nodeType);
     SharedAssignmentPointer deployableAssignmentForRequest(const Assignment& requestAssignment);
+    void deployAssignment(const SharedAssignmentPointer& assignment, const Assignment& requestAssignment,
+                          const HifiSockAddr& sockAddr);
+    void deployAssignmentToStandby(const SharedAssignmentPointer& assignment);
+    bool isAllowedAssignmentClientAddress(const QHostAddress& address) const;
     void refreshStaticAssignmentAndAddToQueue(SharedAssignmentPointer& assignment);
     void addStaticAssignmentsToQueue();
 
@@ -220,7 +232,8 @@ private:
 
     HTTPSConnection* connectionFromReplyWithState(QNetworkReply* reply);
 
-    bool processPendingContent(HTTPConnection* connection, QString itemName, QString filename, QByteArray dataChunk);
+    bool processPendingContent(HTTPConnection* connection, QString itemName, QString filename, QByteArray dataChunk,
+                               QString username);
 
     bool forwardMetaverseAPIRequest(HTTPConnection* connection,
                                     const QString& metaversePath,
@@ -234,12 +247,23 @@ private:
     std::vector<QString> _replicatedUsernames;
 
     DomainGatekeeper _gatekeeper;
+    DomainListChangeLog _domainListChanges;
+    quint32 _domainListSequenceNumber { 0 };
 
     HTTPManager _httpManager;
     std::unique_ptr<HTTPSManager> _httpsManager;
 
     QHash<QUuid, SharedAssignmentPointer> _allAssignments;
     QQueue<SharedAssignmentPointer> _unfulfilledAssignments;
+
+    // idle assignment-clients that recently asked for an assignment we could not give them,
+    // used to hand a failed assignment over without waiting for their next request
+    struct StandbyAssignmentClient {
+        Assignment request;
+        HifiSockAddr sockAddr;
+        quint64 lastRequestUsecs;
+    };
+    std::vector<StandbyAssignmentClient> _standbyAssignmentClients;
     TransactionHash _pendingAssignmentCredits;
 
     bool _isUsingDTLS { false };
@@ -252,6 +276,8 @@ private:
 
     std::unordered_map<QUuid, QByteArray> _ephemeralACScripts;
 
+    // web sessions are checked on the HTTP worker threads too
+    std::mutex _webSessionsMutex;
     QSet<QUuid> _webAuthenticationStateSet;
     QHash<QUuid, DomainServerWebSessionData> _cookieSessionHash;
 
@@ -296,6 +322,7 @@ private:
 
     QHash<QUuid, QPointer<HTTPSConnection>> _pendingOAuthConnections;
 
+    std::mutex _pendingContentMutex;
     std::unordered_map<int, QByteArray> _pendingUploadedContents;
     std::unordered_map<int, std::unique_ptr<QTemporaryFile>> _pendingContentFiles;
 
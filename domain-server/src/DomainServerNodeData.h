@@ -33,6 +33,9 @@ public:
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
 
+    void setDeployedAssignmentUUID(const QUuid& deployedAssignmentUUID) { _deployedAssignmentUUID = deployedAssignmentUUID; }
+    const QUuid& getDeployedAssignmentUUID() const { return _deployedAssignmentUUID; }
+
     void setWalletUUID(const QUuid& walletUUID) { _walletUUID = walletUUID; }
     const QUuid& getWalletUUID() const { return _walletUUID; }
 
@@ -75,6 +78,12 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // for an audio-mixer, the shard of the domain it mixes (NO_AUDIO_SHARD if the domain is not sharded)
+    // and for an agent, the shard of the mixer it is homed on
+    static const int NO_AUDIO_SHARD = -1;
+    int getAudioShard() const { return _audioShard; }
+    void setAudioShard(int audioShard) { _audioShard = audioShard; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -82,6 +91,7 @@ private:
     
     QHash<QUuid, QUuid> _sessionSecretHash;
     QUuid _assignmentUUID;
+    QUuid _deployedAssignmentUUID;
     QUuid _walletUUID;
     QString _username;
     QElapsedTimer _paymentIntervalTimer;
@@ -102,6 +112,8 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    int _audioShard { NO_AUDIO_SHARD };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -44,11 +44,15 @@ void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip)
             qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
             return;
         }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
-            qCritical() << "Failed to write entities file to backup";
-            zipFile.close();
-            return;
+        // Stream the entities file into the archive rather than reading it whole.
+        static const qint64 ENTITIES_CHUNK_SIZE = 64 * 1024;
+        QByteArray entityData;
+        while (!(entityData = entitiesFile.read(ENTITIES_CHUNK_SIZE)).isEmpty()) {
+            if (zipFile.write(entityData) != entityData.size()) {
+                qCritical() << "Failed to write entities file to backup";
+                zipFile.close();
+                return;
+            }
         }
         zipFile.close();
         if (zipFile.getZipError() != UNZ_OK) {
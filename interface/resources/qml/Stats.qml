@@ -131,6 +131,18 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatars Posed in Parallel: " + root.parallelPosedAvatarCount + ", Skeletons: " + root.sharedSkeletonCount
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Blends Run/Shared/Skipped: " + root.blendCount + "/" + root.sharedBlendCount + "/" + root.skippedBlendCount
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Blend Time: " + root.blendTime.toFixed(1) + " ms"
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
@@ -371,6 +383,18 @@ Item {
                         visible: root.expanded;
                         text: "  Pressure State: " + root.gpuTextureMemoryPressureState;
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "  Streaming On Screen / Blurry: " + root.textureStreamingVisible + " / " + root.textureStreamingBlurry;
+                    }
+                    StatText {
+                        visible: root.expanded;
+                        text: "  Streaming Wanted / Budget / Evicted: ";
+                    }
+                    StatText {
+                        visible: root.expanded;
+                        text: "       " + root.textureStreamingWantedMemory + " / " + root.textureStreamingBudget + " / " + root.textureStreamingEvictedMemory + " MB";
+                    }
                     StatText {
                         visible: root.expanded;
                         property bool showIdeal: (root.gpuTextureResourceIdealMemory != root.gpuTextureResourceMemory);
@@ -91,6 +91,7 @@
 #include <FramebufferCache.h>
 #include <gpu/Batch.h>
 #include <gpu/Context.h>
+#include <image/TextureProcessing.h>
 #include <InfoView.h>
 #include <input-plugins/InputPlugin.h>
 #include <controllers/UserInputMapper.h>
@@ -335,6 +336,7 @@ static const float INITIAL_QUERY_RADIUS = 10.0f;  // priority radius for entitie
 static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
 
 Setting::Handle<int> maxOctreePacketsPerSecond{"maxOctreePPS", DEFAULT_MAX_OCTREE_PPS};
+Setting::Handle<int> maxTextureMipDownloads{ "maxTextureMipDownloads", TextureCache::DEFAULT_MIP_REQUEST_BUDGET };
 
 Setting::Handle<bool> loginDialogPoppedUp{"loginDialogPoppedUp", false};
 
@@ -1498,6 +1500,14 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         concurrentDownloads = MAX_CONCURRENT_RESOURCE_DOWNLOADS;
     }
     ResourceCache::setRequestLimit(concurrentDownloads);
+    DependencyManager::get<TextureCache>()->setMipRequestBudget(maxTextureMipDownloads.get());
+
+    // domains with many dynamic entities can step the physics world on more than one thread
+    QString physicsThreadsStr = getCmdOption(argc, constArgv, "--physicsThreads");
+    int physicsThreads = physicsThreadsStr.toInt(&success);
+    if (success && physicsThreads > 1) {
+        _physicsEngine->setNumThreads(physicsThreads);
+    }
 
     // perhaps override the avatar url.  Since we will test later for validity
     // we don't need to do so here.
@@ -6563,6 +6573,16 @@ void Application::update(float deltaTime) {
 
     // AvatarManager update
     {
+        {
+            // the avatars' blends are scheduled by how large they were in the last frame
+            glm::vec3 viewPosition;
+            {
+                QMutexLocker viewLocker(&_viewMutex);
+                viewPosition = _viewFrustum.getPosition();
+            }
+            DependencyManager::get<ModelBlender>()->beginFrame(viewPosition);
+        }
+
         {
             PROFILE_RANGE(simulation, "OtherAvatars");
             PerformanceTimer perfTimer("otherAvatars");
@@ -9314,6 +9334,9 @@ void Application::updateThreadPoolCount() const {
     qCDebug(interfaceapp) << "Reserved threads " << reservedThreads;
     qCDebug(interfaceapp) << "Setting thread pool size to " << threadPoolSize;
     QThreadPool::globalInstance()->setMaxThreadCount(threadPoolSize);
+
+    // leave the same threads to rendering and the UI while textures are compressed
+    image::setTextureCompressionConcurrency(threadPoolSize);
 }
 
 void Application::updateSystemTabletMode() {
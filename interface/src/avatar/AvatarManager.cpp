@@ -15,6 +15,9 @@
 
 #include <QScriptEngine>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "AvatarLogging.h"
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -55,6 +58,37 @@
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
+// Below this many avatars to pose the worker threads cost more than they save
+const size_t MIN_AVATARS_TO_POSE_IN_PARALLEL = 4;
+// How many avatars of the sorted queue are posed at once, ahead of their update. Checking the time budget between batches
+// keeps the avatars that won't be updated this frame from being posed.
+const size_t AVATAR_POSE_BATCH_SIZE = 32;
+
+template <typename Iterator>
+static int poseAvatarsInParallel(Iterator begin, Iterator end) {
+    // each only touches its own rig
+    std::vector<OtherAvatar*> avatarsToPose;
+    for (auto it = begin; it != end; ++it) {
+        if (it->getPriority() > OUT_OF_VIEW_THRESHOLD) {
+            auto avatar = std::static_pointer_cast<OtherAvatar>(it->getAvatar());
+            if (avatar->needsJointPosesUpdate()) {
+                avatarsToPose.push_back(avatar.get());
+            }
+        }
+    }
+    if (avatarsToPose.size() < MIN_AVATARS_TO_POSE_IN_PARALLEL) {
+        return 0;
+    }
+
+    PROFILE_RANGE(simulation, "poseAvatars");
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, avatarsToPose.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            avatarsToPose[i]->updateJointPoses();
+        }
+    });
+    return (int)avatarsToPose.size();
+}
+
 AvatarManager::AvatarManager(QObject* parent) :
     _myAvatar(new MyAvatar(qApp->thread()), [](MyAvatar* ptr) { ptr->deleteLater(); })
 {
@@ -292,6 +326,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     int numHerosUpdated = 0;
     int numAvatarsUpdated = 0;
     int numAvatarsNotUpdated = 0;
+    int numAvatarsPosedInParallel = 0;
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
@@ -303,9 +338,19 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
         auto passExpiry = updatePriorityExpiries[p];
 
+        auto poseBatchEnd = sortedAvatarVector.begin();
         for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
             const SortableAvatar& sortData = *it;
             const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+
+            // the skeletons of the next avatars in view are posed from their joint data ahead of the rest of their update,
+            // as long as there is time left to update them
+            if (it == poseBatchEnd) {
+                poseBatchEnd = it + std::min((size_t)(sortedAvatarVector.end() - it), AVATAR_POSE_BATCH_SIZE);
+                if (usecTimestampNow() < passExpiry) {
+                    numAvatarsPosedInParallel += poseAvatarsInParallel(it, poseBatchEnd);
+                }
+            }
             if (!avatar->_isClientAvatar) {
                 avatar->setIsClientAvatar(true);
             }
@@ -381,6 +426,11 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             }
         }
 
+        // poses computed for the avatars that ran out of time are stale by the next frame
+        for (auto it = sortedAvatarVector.begin(); it != poseBatchEnd; ++it) {
+            std::static_pointer_cast<OtherAvatar>(it->getAvatar())->_hasUpdatedJointPoses = false;
+        }
+
         if (p == kHero) {
             numHerosUpdated = numAvatarsUpdated;
         }
@@ -395,6 +445,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
     _numHeroAvatarsUpdated = numHerosUpdated;
+    _numAvatarsPosedInParallel = numAvatarsPosedInParallel;
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
@@ -117,6 +117,7 @@ public:
     int getNumAvatarsNotUpdated() const { return _numAvatarsNotUpdated; }
     int getNumHeroAvatars() const { return _numHeroAvatars; }
     int getNumHeroAvatarsUpdated() const { return _numHeroAvatarsUpdated; }
+    int getNumAvatarsPosedInParallel() const { return _numAvatarsPosedInParallel; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
 
     void updateMyAvatar(float deltaTime);
@@ -304,6 +305,7 @@ private:
     int _numAvatarsNotUpdated { 0 };
     int _numHeroAvatars{ 0 };
     int _numHeroAvatarsUpdated{ 0 };
+    int _numAvatarsPosedInParallel { 0 };
     float _avatarSimulationTime { 0.0f };
     bool _shouldRender { true };
     bool _myAvatarDataPacketsPaused { false };
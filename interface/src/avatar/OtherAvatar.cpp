@@ -243,6 +243,14 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
     }
 }
 
+void OtherAvatar::updateJointPoses() {
+    PROFILE_RANGE(simulation, "updateJointPoses");
+    _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computeExternalPoses(rootTransform);
+    _hasUpdatedJointPoses = true;
+}
+
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
@@ -261,10 +269,10 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
         PROFILE_RANGE(simulation, "updateJoints");
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            if (needsJointPosesUpdate()) {
+                if (!_hasUpdatedJointPoses) {
+                    updateJointPoses();
+                }
                 _jointDataSimulationRate.increment();
 
                 head->simulate(deltaTime);
@@ -289,6 +297,7 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
             _skeletonModel->simulate(deltaTime, false);
         }
         _skeletonModelSimulationRate.increment();
+        _hasUpdatedJointPoses = false;
     }
 
     // update animation for display name fade in/out
@@ -63,6 +63,11 @@ public:
 
     void setCollisionWithOtherAvatarsFlags() override;
 
+    // The pose of the skeleton from the last joint data received, computed by simulate() unless it already was this frame.
+    // Only touches the rig of this avatar, so the AvatarManager computes it for many avatars at once on worker threads.
+    bool needsJointPosesUpdate() const { return _hasNewJointData || _transit.isActive(); }
+    void updateJointPoses();
+
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
     friend AvatarManager;
@@ -91,6 +96,7 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _hasUpdatedJointPoses { false };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
@@ -18,17 +18,20 @@
 #include <glm/gtx/vector_angle.hpp>
 
 #include <render/Args.h>
+#include <AnimSkeleton.h>
 #include <avatar/AvatarManager.h>
 #include <Application.h>
 #include <AudioClient.h>
 #include <GeometryCache.h>
 #include <LODManager.h>
+#include <Model.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
 #include <PickManager.h>
 
 #include <gl/Context.h>
+#include <gpu/TextureStreaming.h>
 
 #include "Menu.h"
 #include "Util.h"
@@ -130,6 +133,8 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(parallelPosedAvatarCount, avatarManager->getNumAvatarsPosedInParallel());
+    STAT_UPDATE(sharedSkeletonCount, (int)AnimSkeleton::getNumSharedSkeletons());
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     RefreshRateManager& refreshRateManager = qApp->getRefreshRateManager();
@@ -389,6 +394,11 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    auto blendStats = DependencyManager::get<ModelBlender>()->getStats();
+    STAT_UPDATE(blendCount, blendStats.blends);
+    STAT_UPDATE(sharedBlendCount, blendStats.sharedBlends);
+    STAT_UPDATE(skippedBlendCount, blendStats.skippedBlends);
+    STAT_UPDATE(blendTime, blendStats.blendTime);
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
@@ -409,6 +419,12 @@ void Stats::updateStats(bool force) {
 #if !defined(Q_OS_ANDROID)
         STAT_UPDATE(gpuTextureMemoryPressureState, getTextureMemoryPressureModeString());
 #endif
+        auto textureStreamingStats = gpu::TextureStreaming::getStats();
+        STAT_UPDATE(textureStreamingVisible, (int)textureStreamingStats.visibleTextures);
+        STAT_UPDATE(textureStreamingBlurry, (int)textureStreamingStats.blurryTextures);
+        STAT_UPDATE(textureStreamingWantedMemory, (int)BYTES_TO_MB(textureStreamingStats.wantedMemory));
+        STAT_UPDATE(textureStreamingBudget, (int)BYTES_TO_MB(textureStreamingStats.budget));
+        STAT_UPDATE(textureStreamingEvictedMemory, (int)BYTES_TO_MB(textureStreamingStats.evictedMemory));
         STAT_UPDATE(gpuFreeMemory, (int)BYTES_TO_MB(gpu::Context::getFreeGPUMemSize()));
         STAT_UPDATE(rectifiedTextureCount, (int)RECTIFIED_TEXTURE_COUNT.load());
         STAT_UPDATE(decimatedTextureCount, (int)DECIMATED_TEXTURE_COUNT.load());
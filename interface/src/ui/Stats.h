@@ -96,6 +96,12 @@ private: \
  * @property {number} notUpdatedAvatarCount - The number of avatars in the domain, other than the client's, that weren't able 
  *     to be updated in the most recent game loop because there wasn't enough time to.
  *     <em>Read-only.</em>
+ * @property {number} parallelPosedAvatarCount - The number of avatars in the domain, other than the client's, whose skeletons 
+ *     were posed on worker threads in the most recent game loop.
+ *     <em>Read-only.</em>
+ * @property {number} sharedSkeletonCount - The number of avatar skeletons in use, each shared by the avatars that wear the 
+ *     same model.
+ *     <em>Read-only.</em>
  * @property {number} packetInCount - The number of packets being received from the domain server, in packets per second.
  *     <em>Read-only.</em>
  * @property {number} packetOutCount - The number of packets being sent to the domain server, in packets per second.
@@ -313,6 +319,19 @@ private: \
  *         available.</li>
  *     </ul>
  *     <em>Read-only.</em>
+ * @property {number} textureStreamingVisible - The number of streamed textures drawn on screen lately.
+ *     <em>Read-only.</em>
+ * @property {number} textureStreamingBlurry - The number of streamed textures drawn on screen lately whose finest mip on the 
+ *     GPU spans more than two pixels per texel.
+ *     <em>Read-only.</em>
+ * @property {number} textureStreamingWantedMemory - The memory size of the mips of the textures on screen that add detail at 
+ *     the size they are drawn, in MB.
+ *     <em>Read-only.</em>
+ * @property {number} textureStreamingBudget - The GPU memory that streamed textures are allowed to use, in MB.
+ *     <em>Read-only.</em>
+ * @property {number} textureStreamingEvictedMemory - The memory size of all the mips evicted to stay within the budget so 
+ *     far, in MB.
+ *     <em>Read-only.</em>
  * @property {number} gpuFreeMemory - The amount of GPU memory available after all allocations, in MB. 
  *     <em>Read-only.</em>
  *     <p><strong>Note:</strong> This is not a reliable number because OpenGL doesn't have an official method of getting this 
@@ -333,6 +352,16 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} avatarSimulationTime - The time being spent simulating avatars each frame, in ms.
  *     <em>Read-only.</em>
+ * @property {number} blendCount - The number of avatar blendshape blends that ran in the last frame.
+ *     <em>Read-only.</em>
+ * @property {number} sharedBlendCount - The number of avatar blendshape blends that were taken from another avatar with the
+ *     same model in the last frame.
+ *     <em>Read-only.</em>
+ * @property {number} skippedBlendCount - The number of avatar blendshape blends that were skipped in the last frame, because
+ *     they wouldn't have shown or the avatars are far away.
+ *     <em>Read-only.</em>
+ * @property {number} blendTime - The time spent blending avatar blendshapes in the last frame, in ms.
+ *     <em>Read-only.</em>
  *
  * @property {number} stylusPicksCount - The number of stylus picks currently in effect.
  *     <em>Read-only.</em>
@@ -484,6 +513,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(int, parallelPosedAvatarCount, 0)
+    STATS_PROPERTY(int, sharedSkeletonCount, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -568,6 +599,11 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, gpuTextureResourcePopulatedMemory, 0)
     STATS_PROPERTY(int, gpuTextureExternalMemory, 0)
     STATS_PROPERTY(QString, gpuTextureMemoryPressureState, QString())
+    STATS_PROPERTY(int, textureStreamingVisible, 0)
+    STATS_PROPERTY(int, textureStreamingBlurry, 0)
+    STATS_PROPERTY(int, textureStreamingWantedMemory, 0)
+    STATS_PROPERTY(int, textureStreamingBudget, 0)
+    STATS_PROPERTY(int, textureStreamingEvictedMemory, 0)
     STATS_PROPERTY(int, gpuFreeMemory, 0)
     STATS_PROPERTY(QVector2D, gpuFrameSize, QVector2D(0,0))
     STATS_PROPERTY(float, gpuFrameTime, 0)
@@ -575,6 +611,10 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(int, blendCount, 0)
+    STATS_PROPERTY(int, sharedBlendCount, 0)
+    STATS_PROPERTY(int, skippedBlendCount, 0)
+    STATS_PROPERTY(float, blendTime, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -810,6 +850,20 @@ signals:
      */
     void notUpdatedAvatarCountChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>parallelPosedAvatarCount</code> property changes.
+     * @function Stats.parallelPosedAvatarCountChanged
+     * @returns {Signal}
+     */
+    void parallelPosedAvatarCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>sharedSkeletonCount</code> property changes.
+     * @function Stats.sharedSkeletonCountChanged
+     * @returns {Signal}
+     */
+    void sharedSkeletonCountChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>packetInCount</code> property changes.
      * @function Stats.packetInCountChanged
@@ -1379,6 +1433,41 @@ signals:
      */
     void gpuTextureMemoryPressureStateChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>textureStreamingVisible</code> property changes.
+     * @function Stats.textureStreamingVisibleChanged
+     * @returns {Signal}
+     */
+    void textureStreamingVisibleChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>textureStreamingBlurry</code> property changes.
+     * @function Stats.textureStreamingBlurryChanged
+     * @returns {Signal}
+     */
+    void textureStreamingBlurryChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>textureStreamingWantedMemory</code> property changes.
+     * @function Stats.textureStreamingWantedMemoryChanged
+     * @returns {Signal}
+     */
+    void textureStreamingWantedMemoryChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>textureStreamingBudget</code> property changes.
+     * @function Stats.textureStreamingBudgetChanged
+     * @returns {Signal}
+     */
+    void textureStreamingBudgetChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>textureStreamingEvictedMemory</code> property changes.
+     * @function Stats.textureStreamingEvictedMemoryChanged
+     * @returns {Signal}
+     */
+    void textureStreamingEvictedMemoryChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>gpuFreeMemory</code> property changes.
      * @function Stats.gpuFreeMemoryChanged
@@ -1428,6 +1517,34 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>blendCount</code> property changes.
+     * @function Stats.blendCountChanged
+     * @returns {Signal}
+     */
+    void blendCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>sharedBlendCount</code> property changes.
+     * @function Stats.sharedBlendCountChanged
+     * @returns {Signal}
+     */
+    void sharedBlendCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>skippedBlendCount</code> property changes.
+     * @function Stats.skippedBlendCountChanged
+     * @returns {Signal}
+     */
+    void skippedBlendCountChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>blendTime</code> property changes.
+     * @function Stats.blendTimeChanged
+     * @returns {Signal}
+     */
+    void blendTimeChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>stylusPicksCount</code> property changes.
      * @function Stats.stylusPicksCountChanged
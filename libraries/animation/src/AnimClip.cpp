@@ -261,52 +261,35 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame, dt, _loopFlag, _id, triggersOut);
 
     // poll network anim to see if it's finished loading yet.
-    if (_blendType == AnimBlendType_Normal) {
-        if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            _mirrorAnim.clear();
-
-            _poses.resize(_skeleton->getNumJoints());
-        }
-    } else {
+    bool isLoaded = _networkAnim && _networkAnim->isLoaded() && _skeleton;
+    if (_blendType != AnimBlendType_Normal) {
         // an additive blend type
-        if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            // TODO: handle mirrored relative animations.
-            _mirrorAnim.clear();
+        isLoaded = isLoaded && _baseNetworkAnim && _baseNetworkAnim->isLoaded();
+    }
+    if (isLoaded) {
+        // loading is complete, find the clip retargeted to our skeleton or copy & retarget the animation.
+        AnimationClip::Key key { _url, _baseURL, _baseFrame, (int)_blendType, false };
+        _clip = DependencyManager::get<AnimationCache>()->getClip(key, _skeleton, [&] {
+            return std::make_shared<AnimationClip>(retargetAnim());
+        });
 
-            _poses.resize(_skeleton->getNumJoints());
+        // we no longer need the actual animation resource anymore.
+        _networkAnim.reset();
 
-            // copy & retarget baseAnim!
-            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
+        // mirrorClip will be found on demand, if needed.
+        // TODO: handle mirrored relative animations.
+        _mirrorClip.reset();
 
-            if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
-            } else {
-                // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
-            }
-        }
+        _poses.resize(_skeleton->getNumJoints());
     }
 
-    if (_anim.size()) {
+    if (_clip && _clip->getNumFrames() > 0) {
 
-        // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
-            buildMirrorAnim();
+        // lazy lookup of the mirrored clip.
+        if (_mirrorFlag && !_mirrorClip) {
+            findMirrorClip();
         }
+        const AnimationClip& clip = _mirrorFlag ? *_mirrorClip : *_clip;
 
         int prevIndex = (int)glm::floor(_frame);
         int nextIndex;
@@ -318,15 +301,22 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = clip.getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
-        float alpha = glm::fract(_frame);
-
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        if (prevIndex == nextIndex) {
+            clip.sample(prevIndex, _poses);
+        } else {
+            // the frames are only decompressed for as long as it takes to blend them
+            thread_local AnimPoseVec prevFrame;
+            thread_local AnimPoseVec nextFrame;
+            clip.sample(prevIndex, prevFrame);
+            clip.sample(nextIndex, nextFrame);
+            float alpha = glm::fract(_frame);
+
+            ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        }
     }
 
     processOutputJoints(triggersOut);
@@ -341,15 +331,34 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
-void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+std::vector<AnimPoseVec> AnimClip::retargetAnim() const {
+    auto anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+
+    if (_blendType != AnimBlendType_Normal) {
+        // copy & retarget baseAnim!
+        auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+        if (_blendType == AnimBlendType_AddAbsolute) {
+            bakeAbsoluteDeltaAnim(anim, baseAnim[(int)_baseFrame], _skeleton);
+        } else {
+            // AnimBlendType_AddRelative
+            bakeRelativeDeltaAnim(anim, baseAnim[(int)_baseFrame]);
+        }
     }
+    return anim;
+}
+
+void AnimClip::findMirrorClip() {
+    assert(_skeleton && _clip);
+
+    AnimationClip::Key key { _url, _baseURL, _baseFrame, (int)_blendType, true };
+    _mirrorClip = DependencyManager::get<AnimationCache>()->getClip(key, _skeleton, [&] {
+        std::vector<AnimPoseVec> mirrorAnim = _clip->decompress();
+        for (auto& relPoses : mirrorAnim) {
+            _skeleton->mirrorRelativePoses(relPoses);
+        }
+        return std::make_shared<AnimationClip>(mirrorAnim);
+    });
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
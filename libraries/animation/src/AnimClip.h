@@ -61,7 +61,8 @@ protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
-    void buildMirrorAnim();
+    std::vector<AnimPoseVec> retargetAnim() const;
+    void findMirrorClip();
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
@@ -71,9 +72,9 @@ protected:
 
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // shared with the other nodes that play the same animation on the same skeleton, see AnimationCache::getClip()
+    AnimationClip::Pointer _clip;
+    AnimationClip::Pointer _mirrorClip;
 
     QString _url;
     float _startFrame;
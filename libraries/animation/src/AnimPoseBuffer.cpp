@@ -0,0 +1,252 @@
+//
+//  AnimPoseBuffer.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include <GLMHelpers.h>
+
+static const float IDENTITY_POSE[AnimPoseBuffer::NUM_COMPONENTS] = {
+    1.0f, 1.0f, 1.0f,
+    0.0f, 0.0f, 0.0f, 1.0f,
+    0.0f, 0.0f, 0.0f
+};
+
+void AnimPoseBuffer::Hierarchy::build(const std::vector<int>& parentIndices) {
+    int numJoints = (int)parentIndices.size();
+
+    std::vector<int> depths(numJoints, -1);
+    int maxDepth = -1;
+    for (int i = 0; i < numJoints; i++) {
+        // count the ancestors up to the first one with a known depth, a chain that loops ends after numJoints of them
+        int depth = 0;
+        for (int index = parentIndices[i]; index >= 0 && index < numJoints && depth < numJoints; index = parentIndices[index]) {
+            if (depths[index] >= 0) {
+                depth += depths[index] + 1;
+                break;
+            }
+            depth++;
+        }
+        depths[i] = depth;
+        maxDepth = std::max(maxDepth, depth);
+    }
+
+    _jointIndices.clear();
+    _depthOffsets.clear();
+    std::vector<int> slots(numJoints, -1);
+    for (int depth = 0; depth <= maxDepth; depth++) {
+        _depthOffsets.push_back((int)_jointIndices.size());
+        for (int i = 0; i < numJoints; i++) {
+            if (depths[i] == depth) {
+                slots[i] = (int)_jointIndices.size();
+                _jointIndices.push_back(i);
+            }
+        }
+        while (_jointIndices.size() % 4 != 0) {
+            _jointIndices.push_back(-1);
+        }
+    }
+    _depthOffsets.push_back((int)_jointIndices.size());
+
+    _parentSlots.resize(_jointIndices.size());
+    for (size_t slot = 0; slot < _jointIndices.size(); slot++) {
+        int jointIndex = _jointIndices[slot];
+        int parentIndex = jointIndex >= 0 ? parentIndices[jointIndex] : -1;
+        bool hasParent = parentIndex >= 0 && parentIndex < numJoints && depths[parentIndex] < depths[jointIndex];
+        _parentSlots[slot] = hasParent ? slots[parentIndex] : getRootSlot();
+    }
+}
+
+void AnimPoseBuffer::resize(size_t numSlots) {
+    // room for the padding and the root slot of a hierarchy
+    size_t stride = (numSlots + 4) & ~(size_t)3;
+    if (stride != _stride) {
+        _stride = stride;
+        _data.resize(NUM_COMPONENTS * _stride);
+    }
+    for (int component = 0; component < NUM_COMPONENTS; component++) {
+        float* values = get((Component)component);
+        std::fill(values + numSlots, values + _stride, IDENTITY_POSE[component]);
+    }
+    _size = numSlots;
+}
+
+void AnimPoseBuffer::setSlot(size_t slot, const AnimPose& pose) {
+    float* data = _data.data() + slot;
+    data[SCALE_X * _stride] = pose.scale().x;
+    data[SCALE_Y * _stride] = pose.scale().y;
+    data[SCALE_Z * _stride] = pose.scale().z;
+    data[ROT_X * _stride] = pose.rot().x;
+    data[ROT_Y * _stride] = pose.rot().y;
+    data[ROT_Z * _stride] = pose.rot().z;
+    data[ROT_W * _stride] = pose.rot().w;
+    data[TRANS_X * _stride] = pose.trans().x;
+    data[TRANS_Y * _stride] = pose.trans().y;
+    data[TRANS_Z * _stride] = pose.trans().z;
+}
+
+AnimPose AnimPoseBuffer::getSlot(size_t slot) const {
+    const float* data = _data.data() + slot;
+    return AnimPose(glm::vec3(data[SCALE_X * _stride], data[SCALE_Y * _stride], data[SCALE_Z * _stride]),
+                    glm::quat(data[ROT_W * _stride], data[ROT_X * _stride], data[ROT_Y * _stride], data[ROT_Z * _stride]),
+                    glm::vec3(data[TRANS_X * _stride], data[TRANS_Y * _stride], data[TRANS_Z * _stride]));
+}
+
+bool AnimPoseBuffer::isUniformScale(const glm::vec3& scale) {
+    return scale.x > 0.0f && !isNonUniformScale(scale);
+}
+
+void AnimPoseBuffer::load(const AnimPoseVec& poses, const Hierarchy& hierarchy) {
+    resize(hierarchy.getNumSlots());
+    _hasUniformScales = true;
+    for (size_t slot = 0; slot < _size; slot++) {
+        int jointIndex = hierarchy._jointIndices[slot];
+        if (jointIndex >= 0 && jointIndex < (int)poses.size()) {
+            setSlot(slot, poses[jointIndex]);
+            _hasUniformScales = _hasUniformScales && isUniformScale(poses[jointIndex].scale());
+        } else {
+            setSlot(slot, AnimPose::identity);
+        }
+    }
+}
+
+void AnimPoseBuffer::store(AnimPoseVec& poses, const Hierarchy& hierarchy) const {
+    for (size_t slot = 0; slot < _size; slot++) {
+        int jointIndex = hierarchy._jointIndices[slot];
+        if (jointIndex >= 0 && jointIndex < (int)poses.size()) {
+            poses[jointIndex] = getSlot(slot);
+        }
+    }
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static inline __m128 gather4(const float* values, const int* slots) {
+    return _mm_set_ps(values[slots[3]], values[slots[2]], values[slots[1]], values[slots[0]]);
+}
+
+static void convertRelativeToAbsolute_SSE(float* const pose[], const int* parentSlots, int begin, int end) {
+    for (int i = begin; i < end; i += 4) {
+        const int* parents = parentSlots + i;
+        __m128 psx = gather4(pose[AnimPoseBuffer::SCALE_X], parents);
+        __m128 psy = gather4(pose[AnimPoseBuffer::SCALE_Y], parents);
+        __m128 psz = gather4(pose[AnimPoseBuffer::SCALE_Z], parents);
+        __m128 prx = gather4(pose[AnimPoseBuffer::ROT_X], parents);
+        __m128 pry = gather4(pose[AnimPoseBuffer::ROT_Y], parents);
+        __m128 prz = gather4(pose[AnimPoseBuffer::ROT_Z], parents);
+        __m128 prw = gather4(pose[AnimPoseBuffer::ROT_W], parents);
+        __m128 ptx = gather4(pose[AnimPoseBuffer::TRANS_X], parents);
+        __m128 pty = gather4(pose[AnimPoseBuffer::TRANS_Y], parents);
+        __m128 ptz = gather4(pose[AnimPoseBuffer::TRANS_Z], parents);
+
+        __m128 sx = _mm_loadu_ps(pose[AnimPoseBuffer::SCALE_X] + i);
+        __m128 sy = _mm_loadu_ps(pose[AnimPoseBuffer::SCALE_Y] + i);
+        __m128 sz = _mm_loadu_ps(pose[AnimPoseBuffer::SCALE_Z] + i);
+        __m128 rx = _mm_loadu_ps(pose[AnimPoseBuffer::ROT_X] + i);
+        __m128 ry = _mm_loadu_ps(pose[AnimPoseBuffer::ROT_Y] + i);
+        __m128 rz = _mm_loadu_ps(pose[AnimPoseBuffer::ROT_Z] + i);
+        __m128 rw = _mm_loadu_ps(pose[AnimPoseBuffer::ROT_W] + i);
+        __m128 tx = _mm_loadu_ps(pose[AnimPoseBuffer::TRANS_X] + i);
+        __m128 ty = _mm_loadu_ps(pose[AnimPoseBuffer::TRANS_Y] + i);
+        __m128 tz = _mm_loadu_ps(pose[AnimPoseBuffer::TRANS_Z] + i);
+
+        // scale = parent.scale * scale
+        _mm_storeu_ps(pose[AnimPoseBuffer::SCALE_X] + i, _mm_mul_ps(psx, sx));
+        _mm_storeu_ps(pose[AnimPoseBuffer::SCALE_Y] + i, _mm_mul_ps(psy, sy));
+        _mm_storeu_ps(pose[AnimPoseBuffer::SCALE_Z] + i, _mm_mul_ps(psz, sz));
+
+        // rot = parent.rot * rot
+        __m128 qw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(prw, rw), _mm_mul_ps(prx, rx)), _mm_add_ps(_mm_mul_ps(pry, ry), _mm_mul_ps(prz, rz)));
+        __m128 qx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, rx), _mm_mul_ps(prx, rw)), _mm_sub_ps(_mm_mul_ps(pry, rz), _mm_mul_ps(prz, ry)));
+        __m128 qy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, ry), _mm_mul_ps(pry, rw)), _mm_sub_ps(_mm_mul_ps(prz, rx), _mm_mul_ps(prx, rz)));
+        __m128 qz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(prw, rz), _mm_mul_ps(prz, rw)), _mm_sub_ps(_mm_mul_ps(prx, ry), _mm_mul_ps(pry, rx)));
+        _mm_storeu_ps(pose[AnimPoseBuffer::ROT_X] + i, qx);
+        _mm_storeu_ps(pose[AnimPoseBuffer::ROT_Y] + i, qy);
+        _mm_storeu_ps(pose[AnimPoseBuffer::ROT_Z] + i, qz);
+        _mm_storeu_ps(pose[AnimPoseBuffer::ROT_W] + i, qw);
+
+        // trans = parent.trans + parent.rot * (parent.scale * trans), rotated the way glm rotates vectors
+        __m128 vx = _mm_mul_ps(psx, tx);
+        __m128 vy = _mm_mul_ps(psy, ty);
+        __m128 vz = _mm_mul_ps(psz, tz);
+        __m128 uvx = _mm_sub_ps(_mm_mul_ps(pry, vz), _mm_mul_ps(prz, vy));
+        __m128 uvy = _mm_sub_ps(_mm_mul_ps(prz, vx), _mm_mul_ps(prx, vz));
+        __m128 uvz = _mm_sub_ps(_mm_mul_ps(prx, vy), _mm_mul_ps(pry, vx));
+        __m128 uuvx = _mm_sub_ps(_mm_mul_ps(pry, uvz), _mm_mul_ps(prz, uvy));
+        __m128 uuvy = _mm_sub_ps(_mm_mul_ps(prz, uvx), _mm_mul_ps(prx, uvz));
+        __m128 uuvz = _mm_sub_ps(_mm_mul_ps(prx, uvy), _mm_mul_ps(pry, uvx));
+        __m128 two = _mm_set1_ps(2.0f);
+        vx = _mm_add_ps(vx, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvx, prw), uuvx), two));
+        vy = _mm_add_ps(vy, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvy, prw), uuvy), two));
+        vz = _mm_add_ps(vz, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvz, prw), uuvz), two));
+        _mm_storeu_ps(pose[AnimPoseBuffer::TRANS_X] + i, _mm_add_ps(ptx, vx));
+        _mm_storeu_ps(pose[AnimPoseBuffer::TRANS_Y] + i, _mm_add_ps(pty, vy));
+        _mm_storeu_ps(pose[AnimPoseBuffer::TRANS_Z] + i, _mm_add_ps(ptz, vz));
+    }
+}
+
+#else
+
+static void convertRelativeToAbsolute_ref(float* const pose[], const int* parentSlots, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        int p = parentSlots[i];
+        glm::vec3 parentScale(pose[AnimPoseBuffer::SCALE_X][p], pose[AnimPoseBuffer::SCALE_Y][p], pose[AnimPoseBuffer::SCALE_Z][p]);
+        glm::quat parentRot(pose[AnimPoseBuffer::ROT_W][p], pose[AnimPoseBuffer::ROT_X][p], pose[AnimPoseBuffer::ROT_Y][p], pose[AnimPoseBuffer::ROT_Z][p]);
+        glm::vec3 parentTrans(pose[AnimPoseBuffer::TRANS_X][p], pose[AnimPoseBuffer::TRANS_Y][p], pose[AnimPoseBuffer::TRANS_Z][p]);
+
+        glm::vec3 scale(pose[AnimPoseBuffer::SCALE_X][i], pose[AnimPoseBuffer::SCALE_Y][i], pose[AnimPoseBuffer::SCALE_Z][i]);
+        glm::quat rot(pose[AnimPoseBuffer::ROT_W][i], pose[AnimPoseBuffer::ROT_X][i], pose[AnimPoseBuffer::ROT_Y][i], pose[AnimPoseBuffer::ROT_Z][i]);
+        glm::vec3 trans(pose[AnimPoseBuffer::TRANS_X][i], pose[AnimPoseBuffer::TRANS_Y][i], pose[AnimPoseBuffer::TRANS_Z][i]);
+
+        scale = parentScale * scale;
+        rot = parentRot * rot;
+        trans = parentTrans + parentRot * (parentScale * trans);
+
+        pose[AnimPoseBuffer::SCALE_X][i] = scale.x;
+        pose[AnimPoseBuffer::SCALE_Y][i] = scale.y;
+        pose[AnimPoseBuffer::SCALE_Z][i] = scale.z;
+        pose[AnimPoseBuffer::ROT_X][i] = rot.x;
+        pose[AnimPoseBuffer::ROT_Y][i] = rot.y;
+        pose[AnimPoseBuffer::ROT_Z][i] = rot.z;
+        pose[AnimPoseBuffer::ROT_W][i] = rot.w;
+        pose[AnimPoseBuffer::TRANS_X][i] = trans.x;
+        pose[AnimPoseBuffer::TRANS_Y][i] = trans.y;
+        pose[AnimPoseBuffer::TRANS_Z][i] = trans.z;
+    }
+}
+
+#endif
+
+void AnimPoseBuffer::convertRelativeToAbsolute(const Hierarchy& hierarchy, const AnimPose& rootParent) {
+    assert(_size == hierarchy.getNumSlots());
+    setSlot(hierarchy.getRootSlot(), rootParent);
+
+    float* pose[NUM_COMPONENTS];
+    for (int component = 0; component < NUM_COMPONENTS; component++) {
+        pose[component] = get((Component)component);
+    }
+    const int* parentSlots = hierarchy._parentSlots.data();
+    for (size_t depth = 0; depth + 1 < hierarchy._depthOffsets.size(); depth++) {
+        int begin = hierarchy._depthOffsets[depth];
+        int end = hierarchy._depthOffsets[depth + 1];
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        convertRelativeToAbsolute_SSE(pose, parentSlots, begin, end);
+#else
+        convertRelativeToAbsolute_ref(pose, parentSlots, begin, end);
+#endif
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  AnimPoseBuffer.h
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer_h
+#define hifi_AnimPoseBuffer_h
+
+#include <vector>
+
+#include "AnimPose.h"
+
+// The poses of a skeleton as a structure of arrays, one array per component of the scales, rotations and translations.
+// The arrays are padded with identity poses to a multiple of 4, so convertRelativeToAbsolute() runs on 4 joints at a time.
+class AnimPoseBuffer {
+public:
+    enum Component {
+        SCALE_X = 0,
+        SCALE_Y,
+        SCALE_Z,
+        ROT_X,
+        ROT_Y,
+        ROT_Z,
+        ROT_W,
+        TRANS_X,
+        TRANS_Y,
+        TRANS_Z,
+        NUM_COMPONENTS
+    };
+
+    // The joints of a skeleton laid out by depth in the hierarchy, roots first, so that each depth only depends on
+    // the one before it. Each depth starts on a multiple of 4, the slots in between are padding.
+    class Hierarchy {
+    public:
+        void build(const std::vector<int>& parentIndices);
+
+        size_t getNumSlots() const { return _jointIndices.size(); }
+        // The slot the parent of the roots is put in by convertRelativeToAbsolute(), after all the others
+        int getRootSlot() const { return (int)_jointIndices.size(); }
+
+        std::vector<int> _jointIndices; // the joint in each slot, -1 for padding
+        std::vector<int> _parentSlots; // the slot of the parent of each slot, the root slot for roots and padding
+        std::vector<int> _depthOffsets; // the first slot of each depth, and the end of the last one
+    };
+
+    void resize(size_t numSlots);
+    size_t size() const { return _size; }
+
+    float* get(Component component) { return _data.data() + component * _stride; }
+    const float* get(Component component) const { return _data.data() + component * _stride; }
+
+    // Poses of a skeleton in the slots of its hierarchy
+    void load(const AnimPoseVec& poses, const Hierarchy& hierarchy);
+    void store(AnimPoseVec& poses, const Hierarchy& hierarchy) const;
+
+    // True when the scales last loaded are all uniform and positive, which convertRelativeToAbsolute() needs
+    bool hasUniformScales() const { return _hasUniformScales; }
+    static bool isUniformScale(const glm::vec3& scale);
+
+    // The relative poses loaded with the hierarchy become absolute ones, the roots relative to rootParent.
+    // Each depth is composed 4 joints at a time in TRS form, instead of through matrices like AnimPose does, which
+    // gives the same poses as long as the scales are uniform.
+    void convertRelativeToAbsolute(const Hierarchy& hierarchy, const AnimPose& rootParent);
+
+private:
+    void setSlot(size_t slot, const AnimPose& pose);
+    AnimPose getSlot(size_t slot) const;
+
+    std::vector<float> _data;
+    size_t _size { 0 };
+    size_t _stride { 0 };
+    bool _hasUniformScales { true };
+};
+
+#endif // hifi_AnimPoseBuffer_h
@@ -10,15 +10,60 @@
 
 #include "AnimSkeleton.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #include <glm/gtx/transform.hpp>
 
 #include <GLMHelpers.h>
 
 #include "AnimationLogging.h"
 
+// keyed by the model the skeletons were built from, which lives as long as the avatars that wear it
+static std::mutex sharedSkeletonsMutex;
+static std::unordered_map<const HFMModel*, std::weak_ptr<AnimSkeleton>> sharedSkeletons;
+
+AnimSkeleton::Pointer AnimSkeleton::getSharedSkeleton(const HFMModel& hfmModel) {
+    std::lock_guard<std::mutex> lock(sharedSkeletonsMutex);
+    auto itr = sharedSkeletons.find(&hfmModel);
+    if (itr != sharedSkeletons.end()) {
+        auto skeleton = itr->second.lock();
+        // a model loaded where a freed one was doesn't get the skeleton of the other
+        if (skeleton && skeleton->_modelURL == hfmModel.originalURL && skeleton->_jointsSize == (int)hfmModel.joints.size() &&
+            skeleton->_geometryOffset == hfmModel.offset) {
+            return skeleton;
+        }
+    }
+
+    // drop the skeletons no avatar wears anymore
+    for (auto expiredItr = sharedSkeletons.begin(); expiredItr != sharedSkeletons.end();) {
+        if (expiredItr->second.expired()) {
+            expiredItr = sharedSkeletons.erase(expiredItr);
+        } else {
+            ++expiredItr;
+        }
+    }
+
+    auto skeleton = std::make_shared<AnimSkeleton>(hfmModel);
+    sharedSkeletons[&hfmModel] = skeleton;
+    return skeleton;
+}
+
+size_t AnimSkeleton::getNumSharedSkeletons() {
+    std::lock_guard<std::mutex> lock(sharedSkeletonsMutex);
+    size_t count = 0;
+    for (const auto& entry : sharedSkeletons) {
+        if (!entry.second.expired()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
 AnimSkeleton::AnimSkeleton(const HFMModel& hfmModel) {
 
     _geometryOffset = hfmModel.offset;
+    _modelURL = hfmModel.originalURL;
 
     buildSkeletonFromJoints(hfmModel.joints, hfmModel.jointRotationOffsets);
 
@@ -125,6 +170,9 @@ AnimPose AnimSkeleton::getAbsolutePose(int jointIndex, const AnimPoseVec& relati
 
 void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     // poses start off relative and leave in absolute frame
+    if ((int)poses.size() == _jointsSize && buildAbsolutePoses(poses, AnimPose::identity, poses)) {
+        return;
+    }
     int lastIndex = std::min((int)poses.size(), _jointsSize);
     for (int i = 0; i < lastIndex; ++i) {
         int parentIndex = _parentIndices[i];
@@ -134,6 +182,21 @@ void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     }
 }
 
+bool AnimSkeleton::buildAbsolutePoses(const AnimPoseVec& relativePoses, const AnimPose& rootParent, AnimPoseVec& absolutePosesOut) const {
+    if ((int)relativePoses.size() != _jointsSize || !AnimPoseBuffer::isUniformScale(rootParent.scale())) {
+        return false;
+    }
+    thread_local AnimPoseBuffer buffer;
+    buffer.load(relativePoses, _poseBufferHierarchy);
+    if (!buffer.hasUniformScales()) {
+        return false;
+    }
+    buffer.convertRelativeToAbsolute(_poseBufferHierarchy, rootParent);
+    absolutePosesOut.resize(relativePoses.size());
+    buffer.store(absolutePosesOut, _poseBufferHierarchy);
+    return true;
+}
+
 void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseVec& poses) const {
     // poses start off absolute and leave in relative frame
     int lastIndex = std::min((int)poses.size(), _jointsSize);
@@ -167,26 +230,28 @@ void AnimSkeleton::convertAbsoluteRotationsToRelative(std::vector<glm::quat>& ro
     }
 }
 
-void AnimSkeleton::saveNonMirroredPoses(const AnimPoseVec& poses) const {
-    _nonMirroredPoses.clear();
+void AnimSkeleton::saveNonMirroredPoses(const AnimPoseVec& poses, AnimPoseVec& nonMirroredPosesOut) const {
+    nonMirroredPosesOut.clear();
+    nonMirroredPosesOut.reserve(_nonMirroredIndices.size());
     for (int i = 0; i < (int)_nonMirroredIndices.size(); ++i) {
-        _nonMirroredPoses.push_back(poses[_nonMirroredIndices[i]]);
+        nonMirroredPosesOut.push_back(poses[_nonMirroredIndices[i]]);
     }
 }
 
-void AnimSkeleton::restoreNonMirroredPoses(AnimPoseVec& poses) const {
+void AnimSkeleton::restoreNonMirroredPoses(const AnimPoseVec& nonMirroredPoses, AnimPoseVec& poses) const {
     for (int i = 0; i < (int)_nonMirroredIndices.size(); ++i) {
         int index = _nonMirroredIndices[i];
-        poses[index] = _nonMirroredPoses[i];
+        poses[index] = nonMirroredPoses[i];
     }
 }
 
 void AnimSkeleton::mirrorRelativePoses(AnimPoseVec& poses) const {
-    saveNonMirroredPoses(poses);
+    AnimPoseVec nonMirroredPoses;
+    saveNonMirroredPoses(poses, nonMirroredPoses);
     convertRelativePosesToAbsolute(poses);
     mirrorAbsolutePoses(poses);
     convertAbsolutePosesToRelative(poses);
-    restoreNonMirroredPoses(poses);
+    restoreNonMirroredPoses(nonMirroredPoses, poses);
 }
 
 void AnimSkeleton::mirrorAbsolutePoses(AnimPoseVec& poses) const {
@@ -208,6 +273,7 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
     }
 
     _jointsSize = (int)joints.size();
+    _poseBufferHierarchy.build(_parentIndices);
     // build a cache of bind poses
 
     // build a chache of default poses
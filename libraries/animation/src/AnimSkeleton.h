@@ -17,6 +17,7 @@
 
 #include <FBXSerializer.h>
 #include "AnimPose.h"
+#include "AnimPoseBuffer.h"
 
 class AnimSkeleton {
 public:
@@ -26,6 +27,11 @@ public:
     explicit AnimSkeleton(const HFMModel& hfmModel);
     explicit AnimSkeleton(const std::vector<HFMJoint>& joints, const QMap<int, glm::quat> jointOffsets);
 
+    // The skeleton of the model, built once and shared by the rigs of all the avatars that wear it for as long as one
+    // of them does. It doesn't change once built, so the rigs can use it from any thread.
+    static Pointer getSharedSkeleton(const HFMModel& hfmModel);
+    static size_t getNumSharedSkeletons();
+
     int nameToJointIndex(const QString& jointName) const;
     const QString& getJointName(int jointIndex) const;
     int getNumJoints() const;
@@ -53,13 +59,17 @@ public:
     AnimPose getAbsolutePose(int jointIndex, const AnimPoseVec& relativePoses) const;
 
     void convertRelativePosesToAbsolute(AnimPoseVec& poses) const;
+    // All the relative poses of the skeleton made absolute, the roots relative to rootParent, 4 joints at a time.
+    // Answers false without touching absolutePosesOut when a scale isn't uniform, AnimPose products are needed then.
+    bool buildAbsolutePoses(const AnimPoseVec& relativePoses, const AnimPose& rootParent, AnimPoseVec& absolutePosesOut) const;
     void convertAbsolutePosesToRelative(AnimPoseVec& poses) const;
 
     void convertRelativeRotationsToAbsolute(std::vector<glm::quat>& rotations) const;
     void convertAbsoluteRotationsToRelative(std::vector<glm::quat>& rotations) const;
 
-    void saveNonMirroredPoses(const AnimPoseVec& poses) const;
-    void restoreNonMirroredPoses(AnimPoseVec& poses) const;
+    // The caller keeps the saved poses, a shared skeleton is used by the rigs of many avatars at once
+    void saveNonMirroredPoses(const AnimPoseVec& poses, AnimPoseVec& nonMirroredPosesOut) const;
+    void restoreNonMirroredPoses(const AnimPoseVec& nonMirroredPoses, AnimPoseVec& poses) const;
 
     void mirrorRelativePoses(AnimPoseVec& poses) const;
     void mirrorAbsolutePoses(AnimPoseVec& poses) const;
@@ -75,17 +85,18 @@ protected:
 
     std::vector<HFMJoint> _joints;
     std::vector<int> _parentIndices;
+    AnimPoseBuffer::Hierarchy _poseBufferHierarchy;
     int _jointsSize { 0 };
     AnimPoseVec _relativeDefaultPoses;
     AnimPoseVec _absoluteDefaultPoses;
     AnimPoseVec _relativePreRotationPoses;
     AnimPoseVec _relativePostRotationPoses;
-    mutable AnimPoseVec _nonMirroredPoses;
     std::vector<int> _nonMirroredIndices;
     std::vector<int> _mirrorMap;
     QHash<QString, int> _jointIndicesByName;
     std::vector<std::vector<HFMCluster>> _clusterBindMatrixOriginalValues;
     glm::mat4 _geometryOffset;
+    QString _modelURL;
 
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
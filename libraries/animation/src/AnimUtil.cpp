@@ -14,7 +14,6 @@
 #include <DebugDraw.h>
 
 // TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
@@ -36,6 +36,73 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+AnimationClip::Pointer AnimationCache::getClip(const AnimationClip::Key& key, const std::shared_ptr<const AnimSkeleton>& skeleton,
+                                               const std::function<AnimationClip::Pointer()>& build) {
+    {
+        std::lock_guard<std::mutex> lock(_clipsMutex);
+        auto clip = findClip(key, skeleton);
+        if (clip) {
+            return clip;
+        }
+    }
+
+    // building takes a while, so the other nodes aren't kept waiting for it
+    auto clip = build();
+    if (!clip) {
+        return clip;
+    }
+
+    std::lock_guard<std::mutex> lock(_clipsMutex);
+    // another node may have built the same clip in the meantime, in which case its clip is the one shared
+    auto sharedClip = findClip(key, skeleton);
+    if (sharedClip) {
+        return sharedClip;
+    }
+    _clips.insert(key.url, { key, skeleton, clip });
+    return clip;
+}
+
+AnimationClip::Pointer AnimationCache::findClip(const AnimationClip::Key& key, const std::shared_ptr<const AnimSkeleton>& skeleton) {
+    // the skeleton is compared through a weak pointer, so that a new skeleton made where an old one was doesn't match
+    for (auto it = _clips.find(key.url); it != _clips.end() && it.key() == key.url;) {
+        if (it->clip.expired()) {
+            it = _clips.erase(it);
+            continue;
+        }
+        if (it->key == key && it->skeleton.lock() == skeleton) {
+            auto clip = it->clip.lock();
+            if (clip) {
+                return clip;
+            }
+        }
+        ++it;
+    }
+    return AnimationClip::Pointer();
+}
+
+size_t AnimationCache::getNumClips() const {
+    std::lock_guard<std::mutex> lock(_clipsMutex);
+    size_t numClips = 0;
+    for (const auto& entry : _clips) {
+        if (!entry.clip.expired()) {
+            ++numClips;
+        }
+    }
+    return numClips;
+}
+
+size_t AnimationCache::getClipsMemorySize() const {
+    std::lock_guard<std::mutex> lock(_clipsMutex);
+    size_t size = 0;
+    for (const auto& entry : _clips) {
+        auto clip = entry.clip.lock();
+        if (clip) {
+            size += clip->getMemorySize();
+        }
+    }
+    return size;
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url) {
     return QSharedPointer<Resource>(new Animation(url), &Resource::deleter);
 }
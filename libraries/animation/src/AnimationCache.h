@@ -12,6 +12,11 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QMultiHash>
 #include <QtCore/QRunnable>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
@@ -20,7 +25,10 @@
 #include <hfm/HFM.h>
 #include <ResourceCache.h>
 
+#include "AnimationClip.h"
+
 class Animation;
+class AnimSkeleton;
 
 using AnimationPointer = QSharedPointer<Animation>;
 
@@ -33,6 +41,14 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    // The clips AnimClip nodes play are retargeted to the skeleton and compressed once, then shared by all the nodes that
+    // play the same key on the same skeleton for as long as one of them does. build makes the clip when none of them do,
+    // and can be called by more than one node at once, in which case only one of the clips they build is kept.
+    AnimationClip::Pointer getClip(const AnimationClip::Key& key, const std::shared_ptr<const AnimSkeleton>& skeleton,
+                                   const std::function<AnimationClip::Pointer()>& build);
+    size_t getNumClips() const;
+    size_t getClipsMemorySize() const;
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
@@ -41,6 +57,17 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    struct ClipEntry {
+        AnimationClip::Key key;
+        std::weak_ptr<const AnimSkeleton> skeleton;
+        std::weak_ptr<const AnimationClip> clip;
+    };
+
+    // with _clipsMutex held
+    AnimationClip::Pointer findClip(const AnimationClip::Key& key, const std::shared_ptr<const AnimSkeleton>& skeleton);
+
+    mutable std::mutex _clipsMutex;
+    QMultiHash<QString, ClipEntry> _clips; // by url
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
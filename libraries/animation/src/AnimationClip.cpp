@@ -0,0 +1,217 @@
+//
+//  AnimationClip.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimationClip.h"
+
+#include <algorithm>
+
+#include <GLMHelpers.h>
+
+#include "AnimationLogging.h"
+#include "AnimUtil.h"
+
+const float AnimationClip::ROTATION_TOLERANCE { 0.001f };
+const float AnimationClip::VECTOR_TOLERANCE { 0.0005f };
+
+static const size_t BYTES_PER_ROTATION = 6;
+static const size_t COMPONENTS_PER_VECTOR = 3;
+static const float MAX_QUANTIZED_COMPONENT = 65535.0f;
+
+// The frames to keep so that all the others are within tolerance of the values interpolated between the kept frames
+// around them. The first and last frames are kept, unless all the values are within tolerance of the first.
+template <typename T, typename ErrorOp, typename LerpOp>
+static std::vector<uint16_t> findKeyFrames(const std::vector<T>& values, float tolerance, ErrorOp error, LerpOp lerp) {
+    std::vector<uint16_t> keyFrames { 0 };
+    int numFrames = (int)values.size();
+
+    bool isConstant = true;
+    for (int i = 1; isConstant && i < numFrames; ++i) {
+        isConstant = error(values[0], values[i]) <= tolerance;
+    }
+    if (isConstant) {
+        return keyFrames;
+    }
+
+    int start = 0;
+    for (int end = start + 2; end < numFrames; ++end) {
+        bool fits = end - start <= AnimationClip::MAX_KEY_INTERVAL;
+        for (int i = start + 1; fits && i < end; ++i) {
+            float alpha = (float)(i - start) / (float)(end - start);
+            fits = error(lerp(values[start], values[end], alpha), values[i]) <= tolerance;
+        }
+        if (!fits) {
+            // the frame before is as far as the interval could go
+            start = end - 1;
+            keyFrames.push_back((uint16_t)start);
+        }
+    }
+    keyFrames.push_back((uint16_t)(numFrames - 1));
+    keyFrames.shrink_to_fit();
+    return keyFrames;
+}
+
+// The last key at or before frame, and how far frame is from it towards the next one
+static size_t findKey(const std::vector<uint16_t>& keyFrames, int frame, float& alpha) {
+    auto next = std::upper_bound(keyFrames.begin(), keyFrames.end(), (uint16_t)frame);
+    size_t key = (size_t)(next - keyFrames.begin()) - 1;
+    if (next == keyFrames.end()) {
+        alpha = 0.0f;
+    } else {
+        alpha = (float)(frame - keyFrames[key]) / (float)(*next - keyFrames[key]);
+    }
+    return key;
+}
+
+void AnimationClip::RotationTrack::build(const std::vector<glm::quat>& rotations) {
+    auto error = [](const glm::quat& a, const glm::quat& b) {
+        // the angle of the rotation from one to the other, from the sine of its half
+        glm::quat delta = glm::inverse(a) * b;
+        return 2.0f * asinf(std::min(glm::length(glm::vec3(delta.x, delta.y, delta.z)), 1.0f));
+    };
+    _keyFrames = findKeyFrames(rotations, ROTATION_TOLERANCE, error, safeLerp);
+
+    _keys.resize(_keyFrames.size() * BYTES_PER_ROTATION);
+    for (size_t i = 0; i < _keyFrames.size(); ++i) {
+        packOrientationQuatToSixBytes(&_keys[i * BYTES_PER_ROTATION], glm::normalize(rotations[_keyFrames[i]]));
+    }
+}
+
+glm::quat AnimationClip::RotationTrack::getKey(size_t key) const {
+    glm::quat rotation;
+    unpackOrientationQuatFromSixBytes(&_keys[key * BYTES_PER_ROTATION], rotation);
+    return rotation;
+}
+
+glm::quat AnimationClip::RotationTrack::sample(int frame) const {
+    float alpha;
+    size_t key = findKey(_keyFrames, frame, alpha);
+    if (alpha == 0.0f) {
+        return getKey(key);
+    }
+    return safeLerp(getKey(key), getKey(key + 1), alpha);
+}
+
+void AnimationClip::VectorTrack::build(const std::vector<glm::vec3>& vectors) {
+    _min = vectors[0];
+    glm::vec3 max = vectors[0];
+    float largestComponent = 0.0f;
+    for (const auto& vector : vectors) {
+        _min = glm::min(_min, vector);
+        max = glm::max(max, vector);
+        glm::vec3 absVector = glm::abs(vector);
+        largestComponent = std::max(largestComponent, std::max(absVector.x, std::max(absVector.y, absVector.z)));
+    }
+    _extent = max - _min;
+
+    auto error = [](const glm::vec3& a, const glm::vec3& b) {
+        glm::vec3 difference = glm::abs(a - b);
+        return std::max(difference.x, std::max(difference.y, difference.z));
+    };
+    auto lerp = [](const glm::vec3& a, const glm::vec3& b, float alpha) {
+        return glm::mix(a, b, alpha);
+    };
+    _keyFrames = findKeyFrames(vectors, VECTOR_TOLERANCE * largestComponent, error, lerp);
+
+    _keys.resize(_keyFrames.size() * COMPONENTS_PER_VECTOR);
+    for (size_t i = 0; i < _keyFrames.size(); ++i) {
+        const glm::vec3& vector = vectors[_keyFrames[i]];
+        for (int j = 0; j < (int)COMPONENTS_PER_VECTOR; ++j) {
+            float value = _extent[j] > 0.0f ? (vector[j] - _min[j]) / _extent[j] : 0.0f;
+            _keys[i * COMPONENTS_PER_VECTOR + j] = (uint16_t)(glm::clamp(value, 0.0f, 1.0f) * MAX_QUANTIZED_COMPONENT + 0.5f);
+        }
+    }
+}
+
+glm::vec3 AnimationClip::VectorTrack::getKey(size_t key) const {
+    const uint16_t* components = &_keys[key * COMPONENTS_PER_VECTOR];
+    glm::vec3 value((float)components[0], (float)components[1], (float)components[2]);
+    return _min + _extent * (value / MAX_QUANTIZED_COMPONENT);
+}
+
+glm::vec3 AnimationClip::VectorTrack::sample(int frame) const {
+    float alpha;
+    size_t key = findKey(_keyFrames, frame, alpha);
+    if (alpha == 0.0f) {
+        return getKey(key);
+    }
+    return glm::mix(getKey(key), getKey(key + 1), alpha);
+}
+
+AnimationClip::AnimationClip(const std::vector<AnimPoseVec>& frames) {
+    if (frames.size() > (size_t)MAX_NUM_FRAMES) {
+        qCWarning(animation) << "AnimationClip, only the first" << (int)MAX_NUM_FRAMES << "of" << (int)frames.size()
+            << "frames are kept";
+    }
+    _numFrames = (int)std::min(frames.size(), (size_t)MAX_NUM_FRAMES);
+    if (_numFrames == 0) {
+        return;
+    }
+
+    std::vector<glm::quat> rotations(_numFrames);
+    std::vector<glm::vec3> translations(_numFrames);
+    std::vector<glm::vec3> scales(_numFrames);
+
+    _joints.resize(frames[0].size());
+    for (size_t i = 0; i < _joints.size(); ++i) {
+        for (int frame = 0; frame < _numFrames; ++frame) {
+            const AnimPose& pose = frames[frame][i];
+            rotations[frame] = pose.rot();
+            translations[frame] = pose.trans();
+            scales[frame] = pose.scale();
+        }
+        _joints[i].rotation.build(rotations);
+        _joints[i].translation.build(translations);
+        _joints[i].scale.build(scales);
+    }
+}
+
+void AnimationClip::sample(int frame, AnimPoseVec& poses) const {
+    frame = std::min(std::max(0, frame), _numFrames - 1);
+    poses.resize(_joints.size());
+    for (size_t i = 0; i < _joints.size(); ++i) {
+        const Joint& joint = _joints[i];
+        poses[i] = AnimPose(joint.scale.sample(frame), joint.rotation.sample(frame), joint.translation.sample(frame));
+    }
+}
+
+std::vector<AnimPoseVec> AnimationClip::decompress() const {
+    std::vector<AnimPoseVec> frames(_numFrames);
+    for (int frame = 0; frame < _numFrames; ++frame) {
+        sample(frame, frames[frame]);
+    }
+    return frames;
+}
+
+size_t AnimationClip::getNumKeys() const {
+    size_t numKeys = 0;
+    for (const auto& joint : _joints) {
+        numKeys += joint.rotation._keyFrames.size() + joint.translation._keyFrames.size() + joint.scale._keyFrames.size();
+    }
+    return numKeys;
+}
+
+size_t AnimationClip::getMemorySize() const {
+    size_t size = sizeof(AnimationClip) + _joints.capacity() * sizeof(Joint);
+    for (const auto& joint : _joints) {
+        size_t numKeyFrames = joint.rotation._keyFrames.capacity() + joint.translation._keyFrames.capacity() +
+            joint.scale._keyFrames.capacity();
+        size += numKeyFrames * sizeof(uint16_t) + joint.rotation._keys.capacity() +
+            (joint.translation._keys.capacity() + joint.scale._keys.capacity()) * sizeof(uint16_t);
+    }
+    return size;
+}
+
+size_t AnimationClip::getMemorySize(const std::vector<AnimPoseVec>& frames) {
+    size_t size = sizeof(frames) + frames.capacity() * sizeof(AnimPoseVec);
+    for (const auto& poses : frames) {
+        size += poses.capacity() * sizeof(AnimPose);
+    }
+    return size;
+}
@@ -0,0 +1,103 @@
+//
+//  AnimationClip.h
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimationClip_h
+#define hifi_AnimationClip_h
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "AnimPose.h"
+
+// The frames of an animation retargeted to a skeleton, compressed to be kept around and shared by all the AnimClip nodes
+// that play it on that skeleton.
+//
+// Each joint has a track for its rotation, translation and scale. A track only keeps the frames the others can't be rebuilt
+// from, within a tolerance, by interpolating between the kept frames around them, so a joint that doesn't move keeps one.
+// The rotations of the kept frames are packed into 6 bytes, the translations and scales into 16 bits per component over
+// the range the track covers.
+class AnimationClip {
+public:
+    using Pointer = std::shared_ptr<const AnimationClip>;
+
+    // What the frames of a clip were made from, along with the skeleton they were retargeted to
+    struct Key {
+        QString url;
+        QString baseURL;
+        float baseFrame { 0.0f };
+        int blendType { 0 };
+        bool mirror { false };
+
+        bool operator==(const Key& other) const {
+            return url == other.url && baseURL == other.baseURL && baseFrame == other.baseFrame &&
+                blendType == other.blendType && mirror == other.mirror;
+        }
+    };
+
+    // The most a rebuilt frame is off, in radians for the rotations, and as a fraction of the largest value of the track for
+    // the translations and scales
+    static const float ROTATION_TOLERANCE;
+    static const float VECTOR_TOLERANCE;
+    // The most frames a track goes without a key, which bounds the time taken to find them
+    static const int MAX_KEY_INTERVAL { 32 };
+    static const int MAX_NUM_FRAMES { 65536 };
+
+    // frames[frame][joint], with the same number of joints in every frame
+    explicit AnimationClip(const std::vector<AnimPoseVec>& frames);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_joints.size(); }
+
+    // The poses of all the joints at a frame, which is clamped to the clip
+    void sample(int frame, AnimPoseVec& poses) const;
+    std::vector<AnimPoseVec> decompress() const;
+
+    size_t getNumKeys() const;
+    size_t getMemorySize() const;
+    // What the frames take uncompressed
+    static size_t getMemorySize(const std::vector<AnimPoseVec>& frames);
+
+private:
+    class RotationTrack {
+    public:
+        void build(const std::vector<glm::quat>& rotations);
+        glm::quat sample(int frame) const;
+        glm::quat getKey(size_t key) const;
+
+        std::vector<uint16_t> _keyFrames;
+        std::vector<uint8_t> _keys; // 6 bytes per key
+    };
+
+    class VectorTrack {
+    public:
+        void build(const std::vector<glm::vec3>& vectors);
+        glm::vec3 sample(int frame) const;
+        glm::vec3 getKey(size_t key) const;
+
+        std::vector<uint16_t> _keyFrames;
+        std::vector<uint16_t> _keys; // 3 components per key
+        glm::vec3 _min;
+        glm::vec3 _extent;
+    };
+
+    struct Joint {
+        RotationTrack rotation;
+        VectorTrack translation;
+        VectorTrack scale;
+    };
+
+    int _numFrames { 0 };
+    std::vector<Joint> _joints;
+};
+
+#endif // hifi_AnimationClip_h
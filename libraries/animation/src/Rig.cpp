@@ -625,7 +625,7 @@ void Rig::initJointStates(const HFMModel& hfmModel, const glm::mat4& modelOffset
     _rigToGeometryTransform = glm::inverse(_geometryToRigTransform);
     setModelOffset(modelOffset);
 
-    _animSkeleton = std::make_shared<AnimSkeleton>(hfmModel);
+    _animSkeleton = AnimSkeleton::getSharedSkeleton(hfmModel);
 
     _internalPoseSet._relativePoses.clear();
     _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
@@ -669,7 +669,7 @@ void Rig::reset(const HFMModel& hfmModel) {
     _geometryOffset = AnimPose(hfmModel.offset);
     _invGeometryOffset = _geometryOffset.inverse();
 
-    _animSkeleton = std::make_shared<AnimSkeleton>(hfmModel);
+    _animSkeleton = AnimSkeleton::getSharedSkeleton(hfmModel);
 
     _internalPoseSet._relativePoses.clear();
     _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
@@ -2431,9 +2431,9 @@ void Rig::initAnimGraph(const QUrl& url) {
         connect(_animLoader.get(), &AnimNodeLoader::success, [this, weakSkeletonPtr, url](AnimNode::Pointer nodeIn) {
             _animNode = nodeIn;
 
-            // abort load if the previous skeleton was deleted.
+            // abort load if the previous skeleton was deleted, or replaced since other avatars can keep it alive.
             auto sharedSkeletonPtr = weakSkeletonPtr.lock();
-            if (!sharedSkeletonPtr) {
+            if (!sharedSkeletonPtr || sharedSkeletonPtr != _animSkeleton) {
                 emit onLoadFailed();
                 return;
             }
@@ -2475,9 +2475,9 @@ void Rig::initAnimGraph(const QUrl& url) {
 
         connect(_networkLoader.get(), &AnimNodeLoader::success, [this, weakSkeletonPtr, networkUrl](AnimNode::Pointer nodeIn) {
             _networkNode = nodeIn;
-            // abort load if the previous skeleton was deleted.
+            // abort load if the previous skeleton was deleted, or replaced since other avatars can keep it alive.
             auto sharedSkeletonPtr = weakSkeletonPtr.lock();
-            if (!sharedSkeletonPtr) {
+            if (!sharedSkeletonPtr || sharedSkeletonPtr != _animSkeleton) {
                 return;
             }
             _networkNode->setSkeleton(sharedSkeletonPtr);
@@ -2547,6 +2547,9 @@ void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& a
 
     absolutePosesOut.resize(relativePoses.size());
     AnimPose geometryToRigTransform(_geometryToRigTransform);
+    if (_animSkeleton->buildAbsolutePoses(relativePoses, geometryToRigTransform, absolutePosesOut)) {
+        return;
+    }
     for (int i = 0; i < (int)relativePoses.size(); i++) {
         int parentIndex = _animSkeleton->getParentIndex(i);
         if (parentIndex == -1) {
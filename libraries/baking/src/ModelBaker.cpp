@@ -226,11 +226,16 @@ void ModelBaker::bakeSourceCopy() {
         hifi::VariantHash serializerMapping = _mapping;
         serializerMapping["combineParts"] = true; // set true so that OBJSerializer reads material info from material library
         serializerMapping["deduplicateIndices"] = true; // Draco compression also deduplicates, but we might as well shave it off to save on some earlier processing (currently FBXSerializer only)
-        hfm::Model::Pointer loadedModel = serializer->read(modelData, serializerMapping, _modelURL);
 
         // Temporarily support copying the pre-parsed node from FBXSerializer, for better performance in FBXBaker
         // TODO: Pure HFM baking
         std::shared_ptr<FBXSerializer> fbxSerializer = std::dynamic_pointer_cast<FBXSerializer>(serializer);
+        if (fbxSerializer) {
+            // the tree is written back out, with the geometry arrays of the blendshapes
+            fbxSerializer->_decodeGeometryArrays = false;
+        }
+        hfm::Model::Pointer loadedModel = serializer->read(modelData, serializerMapping, _modelURL);
+
         if (fbxSerializer) {
             qCDebug(model_baking) << "Parsing" << _modelURL;
             _rootNode = fbxSerializer->_rootNode;
@@ -18,6 +18,7 @@
 
 #include <image/TextureProcessing.h>
 #include <ktx/KTX.h>
+#include <ktx/Universal.h>
 #include <NetworkAccessManager.h>
 #include <SharedUtil.h>
 #include <TextureMeta.h>
@@ -28,9 +29,18 @@
 
 const QString BAKED_TEXTURE_KTX_EXT = ".ktx";
 const QString BAKED_TEXTURE_BCN_SUFFIX = "_bcn.ktx";
+const QString BAKED_TEXTURE_UNIVERSAL_EXT = ".uktx";
 const QString BAKED_META_TEXTURE_SUFFIX = ".texmeta.json";
 
+// The names of the cached results of a bake, compressed KTXs are named after their GL format instead
+static const QString CACHED_UNIVERSAL_ENTRY = "universal";
+static const QString CACHED_UNCOMPRESSED_ENTRY = "uncompressed";
+
+const int TextureBaker::VERSION { 1 };
+
 bool TextureBaker::_compressionEnabled = true;
+bool TextureBaker::_universalCompressionEnabled = false;
+cache::BakedAssetCachePointer TextureBaker::_bakedAssetCache;
 
 TextureBaker::TextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
                            const QDir& outputDirectory, const QString& baseFilename,
@@ -136,6 +146,20 @@ void TextureBaker::processTexture() {
     auto hashData = hasher.result();
     std::string hash = hashData.toHex().toStdString();
 
+    // what is baked depends on the options as much as on the texture itself
+    auto bakedAssetCache = _bakedAssetCache;
+    cache::Key cacheKey;
+    cache::BakedAssetCache::Entries cacheEntries;
+    bool isCached = false;
+    if (bakedAssetCache) {
+        QByteArray options;
+        options.append((const char*)&_textureType, sizeof(_textureType));
+        options.append(_compressionEnabled ? '1' : '0');
+        options.append(_universalCompressionEnabled ? '1' : '0');
+        cacheKey = cache::BakedAssetCache::makeKey("texture", VERSION, _originalTexture, options);
+        isCached = bakedAssetCache->load(cacheKey, cacheEntries);
+    }
+
     TextureMeta meta;
 
     QString originalCopyFilePath = _originalCopyFilePath.toString();
@@ -153,11 +177,83 @@ void TextureBaker::processTexture() {
         meta.original = _originalCopyFilePath.fileName();
     }
 
+    if (isCached) {
+        if (!restoreBakedTextures(cacheEntries, meta)) {
+            return;
+        }
+        qCDebug(model_baking) << "Found baked texture in the cache" << _textureURL;
+    } else {
+        cacheEntries.clear();
+        if (!bakeTextures(originalCopyFilePath, hash, meta, bakedAssetCache ? &cacheEntries : nullptr)) {
+            return;
+        }
+        if (bakedAssetCache) {
+            bakedAssetCache->store(cacheKey, cacheEntries);
+        }
+    }
+
+    {
+        auto data = meta.serialize();
+        _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
+        QFile file { _metaTextureFileName };
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
+            handleError("Could not write meta texture for " + _textureURL.toString());
+            return;
+        } else {
+            _outputFiles.push_back(_metaTextureFileName);
+        }
+    }
+
+    qCDebug(model_baking) << "Baked texture" << _textureURL;
+    setIsFinished(true);
+}
+
+bool TextureBaker::bakeTextures(const QString& originalCopyFilePath, const std::string& hash, TextureMeta& meta,
+                                cache::BakedAssetCache::Entries* cacheEntries) {
     // Load the copy of the original file from the baked output directory. New images will be created using the original as the source data.
     auto buffer = std::static_pointer_cast<QIODevice>(std::make_shared<QFile>(originalCopyFilePath));
     if (!buffer->open(QIODevice::ReadOnly)) {
         handleError("Could not open original file at " + originalCopyFilePath);
-        return;
+        return false;
+    }
+
+    // Universal KTX, transcoded by clients whose GPU supports none of the compressed KTXs below
+    if (_compressionEnabled && _universalCompressionEnabled) {
+        auto processedTexture = image::processImage(buffer, _textureURL.toString().toStdString(), image::ColorChannel::NONE,
+                                                    ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, false,
+                                                    gpu::BackendTarget::GL45, _abortProcessing);
+        buffer->reset();
+        if (!processedTexture) {
+            handleError("Could not process texture " + _textureURL.toString());
+            return false;
+        }
+        processedTexture->setSourceHash(hash);
+
+        if (shouldStop()) {
+            return false;
+        }
+
+        auto memKTX = gpu::Texture::serialize(*processedTexture);
+        if (!memKTX) {
+            handleError("Could not serialize " + _textureURL.toString() + " to KTX");
+            return false;
+        }
+
+        // Only 8 bits per channel color, grayscale and normal maps can be made universal
+        auto universalStorage = ktx::UniversalKTX::encode(*memKTX);
+        if (universalStorage) {
+            const char* data = reinterpret_cast<const char*>(universalStorage->data());
+            const size_t length = universalStorage->size();
+
+            auto fileName = _baseFilename + BAKED_TEXTURE_UNIVERSAL_EXT;
+            if (!writeBakedTexture(fileName, data, length)) {
+                return false;
+            }
+            meta.universal = fileName;
+            if (cacheEntries) {
+                cacheEntries->emplace_back(CACHED_UNIVERSAL_ENTRY, QByteArray(data, (int)length));
+            }
+        }
     }
 
     // Compressed KTX
@@ -172,38 +268,37 @@ void TextureBaker::processTexture() {
                                                         target, _abortProcessing);
             if (!processedTexture) {
                 handleError("Could not process texture " + _textureURL.toString());
-                return;
+                return false;
             }
             processedTexture->setSourceHash(hash);
 
             if (shouldStop()) {
-                return;
+                return false;
             }
 
             auto memKTX = gpu::Texture::serialize(*processedTexture);
             if (!memKTX) {
                 handleError("Could not serialize " + _textureURL.toString() + " to KTX");
-                return;
+                return false;
             }
 
             const char* name = khronos::gl::texture::toString(memKTX->_header.getGLInternaFormat());
             if (name == nullptr) {
                 handleError("Could not determine internal format for compressed KTX: " + _textureURL.toString());
-                return;
+                return false;
             }
 
             const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
             const size_t length = memKTX->_storage->size();
 
             auto fileName = _baseFilename + "_" + name + ".ktx";
-            auto filePath = _outputDirectory.absoluteFilePath(fileName);
-            QFile bakedTextureFile { filePath };
-            if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
-                handleError("Could not write baked texture for " + _textureURL.toString());
-                return;
+            if (!writeBakedTexture(fileName, data, length)) {
+                return false;
             }
-            _outputFiles.push_back(filePath);
             meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = fileName;
+            if (cacheEntries) {
+                cacheEntries->emplace_back(name, QByteArray(data, (int)length));
+            }
         }
     }
 
@@ -214,50 +309,79 @@ void TextureBaker::processTexture() {
                                                     ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, false, gpu::BackendTarget::GL45, _abortProcessing);
         if (!processedTexture) {
             handleError("Could not process texture " + _textureURL.toString());
-            return;
+            return false;
         }
         processedTexture->setSourceHash(hash);
 
         if (shouldStop()) {
-            return;
+            return false;
         }
 
         auto memKTX = gpu::Texture::serialize(*processedTexture);
         if (!memKTX) {
             handleError("Could not serialize " + _textureURL.toString() + " to KTX");
-            return;
+            return false;
         }
 
         const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
         const size_t length = memKTX->_storage->size();
 
         auto fileName = _baseFilename + ".ktx";
-        auto filePath = _outputDirectory.absoluteFilePath(fileName);
-        QFile bakedTextureFile { filePath };
-        if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
-            handleError("Could not write baked texture for " + _textureURL.toString());
-            return;
+        if (!writeBakedTexture(fileName, data, length)) {
+            return false;
         }
-        _outputFiles.push_back(filePath);
         meta.uncompressed = fileName;
+        if (cacheEntries) {
+            cacheEntries->emplace_back(CACHED_UNCOMPRESSED_ENTRY, QByteArray(data, (int)length));
+        }
     } else {
         buffer.reset();
     }
 
-    {
-        auto data = meta.serialize();
-        _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
-        QFile file { _metaTextureFileName };
-        if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
-            handleError("Could not write meta texture for " + _textureURL.toString());
-            return;
+    return true;
+}
+
+bool TextureBaker::restoreBakedTextures(const cache::BakedAssetCache::Entries& entries, TextureMeta& meta) {
+    for (const auto& entry : entries) {
+        const QString& name = entry.first;
+        const QByteArray& data = entry.second;
+        if (name == CACHED_UNIVERSAL_ENTRY) {
+            auto fileName = _baseFilename + BAKED_TEXTURE_UNIVERSAL_EXT;
+            if (!writeBakedTexture(fileName, data.constData(), data.size())) {
+                return false;
+            }
+            meta.universal = fileName;
+        } else if (name == CACHED_UNCOMPRESSED_ENTRY) {
+            auto fileName = _baseFilename + ".ktx";
+            if (!writeBakedTexture(fileName, data.constData(), data.size())) {
+                return false;
+            }
+            meta.uncompressed = fileName;
         } else {
-            _outputFiles.push_back(_metaTextureFileName);
+            khronos::gl::texture::InternalFormat format;
+            if (!khronos::gl::texture::fromString(name.toUtf8().constData(), &format)) {
+                handleError("Unknown baked texture format " + name + " in the cache for " + _textureURL.toString());
+                return false;
+            }
+            auto fileName = _baseFilename + "_" + name + ".ktx";
+            if (!writeBakedTexture(fileName, data.constData(), data.size())) {
+                return false;
+            }
+            meta.availableTextureTypes[format] = fileName;
         }
     }
+    return true;
+}
 
-    qCDebug(model_baking) << "Baked texture" << _textureURL;
-    setIsFinished(true);
+bool TextureBaker::writeBakedTexture(const QString& fileName, const char* data, size_t length) {
+    auto filePath = _outputDirectory.absoluteFilePath(fileName);
+    QFile bakedTextureFile { filePath };
+    if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
+        handleError("Could not write baked texture for " + _textureURL.toString());
+        return false;
+    }
+    _outputFiles.push_back(filePath);
+    return true;
 }
 
 void TextureBaker::setWasAborted(bool wasAborted) {
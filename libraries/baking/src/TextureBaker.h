@@ -19,18 +19,25 @@
 #include <QImageReader>
 
 #include <image/TextureProcessing.h>
+#include <shared/BakedAssetCache.h>
 
 #include "Baker.h"
 
 #include <graphics/Material.h>
 
+struct TextureMeta;
+
 extern const QString BAKED_TEXTURE_KTX_EXT;
+extern const QString BAKED_TEXTURE_UNIVERSAL_EXT;
 extern const QString BAKED_META_TEXTURE_SUFFIX;
 
 class TextureBaker : public Baker {
     Q_OBJECT
 
 public:
+    // Bump when a change to the baking would make textures baked before it differ
+    static const int VERSION;
+
     TextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
                  const QDir& outputDirectory, const QString& baseFilename = QString(),
                  const QByteArray& textureContent = QByteArray());
@@ -46,6 +53,10 @@ public:
     virtual void setWasAborted(bool wasAborted) override;
 
     static void setCompressionEnabled(bool enabled) { _compressionEnabled = enabled; }
+    // Bake a single universal KTX instead of one KTX per GPU block format
+    static void setUniversalCompressionEnabled(bool enabled) { _universalCompressionEnabled = enabled; }
+    // Textures baked before, under any URL, are copied from this cache instead of being baked again
+    static void setBakedAssetCache(const cache::BakedAssetCachePointer& bakedAssetCache) { _bakedAssetCache = bakedAssetCache; }
 
     void setMapChannel(graphics::Material::MapChannel mapChannel) { _mapChannel = mapChannel; }
     graphics::Material::MapChannel getMapChannel() const { return _mapChannel; }
@@ -64,6 +75,10 @@ private slots:
 private:
     void loadTexture();
     void handleTextureNetworkReply();
+    bool bakeTextures(const QString& originalCopyFilePath, const std::string& hash, TextureMeta& meta,
+                      cache::BakedAssetCache::Entries* cacheEntries);
+    bool restoreBakedTextures(const cache::BakedAssetCache::Entries& entries, TextureMeta& meta);
+    bool writeBakedTexture(const QString& fileName, const char* data, size_t length);
 
     QUrl _textureURL;
     QByteArray _originalTexture;
@@ -79,6 +94,8 @@ private:
     std::atomic<bool> _abortProcessing { false };
 
     static bool _compressionEnabled;
+    static bool _universalCompressionEnabled;
+    static cache::BakedAssetCachePointer _bakedAssetCache;
 };
 
 #endif // hifi_TextureBaker_h
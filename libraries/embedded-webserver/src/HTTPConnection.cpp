@@ -16,6 +16,7 @@
 #include <QBuffer>
 #include <QCryptographicHash>
 #include <QTcpSocket>
+#include <QThread>
 #include <QUrlQuery>
 
 #include "EmbeddedWebserverLogging.h"
@@ -32,6 +33,8 @@ const char* HTTPConnection::StatusCode404 = "404 Not Found";
 const char* HTTPConnection::StatusCode500 = "500 Internal server error";
 const char* HTTPConnection::DefaultContentType = "text/plain; charset=ISO-8859-1";
 
+const int KEEP_ALIVE_TIMEOUT_MSECS = 30 * 1000;
+
 
 class MemoryStorage : public HTTPConnection::Storage {
 public:
@@ -114,8 +117,9 @@ void FileStorage::write(const QByteArray& data) {
 }
 
 
+// connections live next to their socket, which is owned either by the manager or by one of its worker threads
 HTTPConnection::HTTPConnection(QTcpSocket* socket, HTTPManager* parentManager) :
-    QObject(parentManager),
+    QObject(socket->parent()),
     _parentManager(parentManager),
     _socket(socket),
     _address(socket->peerAddress())
@@ -123,10 +127,15 @@ HTTPConnection::HTTPConnection(QTcpSocket* socket, HTTPManager* parentManager) :
     // take over ownership of the socket
     _socket->setParent(this);
 
+    _keepAliveTimer = new QTimer(this);
+    _keepAliveTimer->setSingleShot(true);
+    _keepAliveTimer->setInterval(KEEP_ALIVE_TIMEOUT_MSECS);
+    connect(_keepAliveTimer, &QTimer::timeout, _socket, &QTcpSocket::disconnectFromHost);
+
     // connect initial slots
     connect(socket, SIGNAL(readyRead()), SLOT(readRequest()));
-    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(deleteLater()));
-    connect(socket, SIGNAL(disconnected()), SLOT(deleteLater()));
+    connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), SLOT(handleSocketClosed()));
+    connect(socket, SIGNAL(disconnected()), SLOT(handleSocketClosed()));
 }
 
 HTTPConnection::~HTTPConnection() {
@@ -218,24 +227,51 @@ QList<FormData> HTTPConnection::parseFormData() const {
 }
 
 void HTTPConnection::respond(const char* code, const QByteArray& content, const char* contentType, const Headers& headers) {
+    if (QThread::currentThread() != thread()) {
+        // the socket can only be written from our thread - copy the strings since they often come from temporaries
+        QByteArray codeBytes { code };
+        QByteArray contentTypeBytes { contentType };
+        QMetaObject::invokeMethod(this, [this, codeBytes, content, contentTypeBytes, headers] {
+            respond(codeBytes.constData(), content, contentTypeBytes.constData(), headers);
+        });
+        return;
+    }
+
+    // make sure we receive no further read notifications
+    disconnect(_socket, &QTcpSocket::readyRead, this, nullptr);
+
     respondWithStatusAndHeaders(code, contentType, headers, content.size());
 
     _socket->write(content);
 
-    _socket->disconnectFromHost();
+    finishResponse();
+}
+
+void HTTPConnection::respond(const char* code, std::unique_ptr<QIODevice> device, const char* contentType, const Headers& headers) {
+    if (QThread::currentThread() != thread()) {
+        QByteArray codeBytes { code };
+        QByteArray contentTypeBytes { contentType };
+
+        // the device is read from our thread from now on
+        device->moveToThread(thread());
+        auto sharedDevice = std::make_shared<std::unique_ptr<QIODevice>>(std::move(device));
+
+        QMetaObject::invokeMethod(this, [this, codeBytes, sharedDevice, contentTypeBytes, headers] {
+            respond(codeBytes.constData(), std::move(*sharedDevice), contentTypeBytes.constData(), headers);
+        });
+        return;
+    }
 
     // make sure we receive no further read notifications
     disconnect(_socket, &QTcpSocket::readyRead, this, nullptr);
-}
 
-void HTTPConnection::respond(const char* code, std::unique_ptr<QIODevice> device, const char* contentType, const Headers& headers) {
     _responseDevice = std::move(device);
 
     if (_responseDevice->isSequential()) {
         qWarning() << "Error responding to HTTPConnection: sequential IO devices not supported";
+        _keepAlive = false;
         respondWithStatusAndHeaders(StatusCode500, contentType, headers, 0);
-        _socket->disconnect(SIGNAL(readyRead()), this);
-        _socket->disconnectFromHost();
+        finishResponse();
         return;
     }
 
@@ -243,23 +279,58 @@ void HTTPConnection::respond(const char* code, std::unique_ptr<QIODevice> device
     respondWithStatusAndHeaders(code, contentType, headers, totalToBeWritten);
 
     if (_responseDevice->atEnd()) {
-        _socket->disconnectFromHost();
+        finishResponse();
     } else {
         connect(_socket, &QTcpSocket::bytesWritten, this, [this, totalToBeWritten](size_t bytes) mutable {
             constexpr size_t HTTP_RESPONSE_CHUNK_SIZE = 1024 * 10;
             if (!_responseDevice->atEnd()) {
                 totalToBeWritten -= _socket->write(_responseDevice->read(HTTP_RESPONSE_CHUNK_SIZE));
                 if (_responseDevice->atEnd()) {
-                    _socket->disconnectFromHost();
                     disconnect(_socket, &QTcpSocket::bytesWritten, this, nullptr);
+                    finishResponse();
                 }
             }
         });
 
     }
+}
 
-    // make sure we receive no further read notifications
-    disconnect(_socket, &QTcpSocket::readyRead, this, nullptr);
+void HTTPConnection::finishResponse() {
+    _isHandlingRequest = false;
+
+    if (_isSocketClosed) {
+        // the client went away while the request was being handled
+        deleteLater();
+        return;
+    }
+
+    if (!_keepAlive) {
+        _socket->disconnectFromHost();
+        return;
+    }
+
+    // get ready for the next request on this connection, once whatever is left of this response has gone out
+    _responseDevice.reset();
+    _requestContent.reset();
+    _requestUrl.clear();
+    _requestHeaders.clear();
+    _lastRequestHeader.clear();
+
+    _keepAliveTimer->start();
+
+    connect(_socket, SIGNAL(readyRead()), SLOT(readRequest()));
+
+    // the client may have sent its next request already - read it once the current handler has returned
+    QMetaObject::invokeMethod(this, "readRequest", Qt::QueuedConnection);
+}
+
+void HTTPConnection::handleSocketClosed() {
+    if (_isHandlingRequest) {
+        // a request handler on another thread may still be using this connection, wait for it to respond
+        _isSocketClosed = true;
+    } else {
+        deleteLater();
+    }
 }
 
 void HTTPConnection::respondWithStatusAndHeaders(const char* code, const char* contentType, const Headers& headers, qint64 contentLength) {
@@ -276,16 +347,27 @@ void HTTPConnection::respondWithStatusAndHeaders(const char* code, const char* c
         _socket->write("\r\n");
     }
 
-    if (contentLength > 0) {
-        _socket->write("Content-Length: ");
-        _socket->write(QByteArray::number(contentLength));
-        _socket->write("\r\n");
+    // a kept-alive connection needs the length of every response, so the client can find the start of the next one
+    _socket->write("Content-Length: ");
+    _socket->write(QByteArray::number(contentLength));
+    _socket->write("\r\n");
 
+    if (contentLength > 0) {
         _socket->write("Content-Type: ");
         _socket->write(contentType);
         _socket->write("\r\n");
     }
-    _socket->write("Connection: close\r\n\r\n");
+
+    if (_keepAlive) {
+        _socket->write("Connection: keep-alive\r\n\r\n");
+    } else {
+        _socket->write("Connection: close\r\n\r\n");
+    }
+}
+
+void HTTPConnection::dispatchRequest(const QUrl& url) {
+    _isHandlingRequest = true;
+    _parentManager->dispatchHTTPRequest(this, url);
 }
 
 void HTTPConnection::readRequest() {
@@ -296,6 +378,9 @@ void HTTPConnection::readRequest() {
         qDebug() << "Request URL was already set";
         return;
     }
+
+    _keepAliveTimer->stop();
+
     // parse out the method and resource
     QByteArray line = _socket->readLine().trimmed();
     if (line.startsWith("HEAD")) {
@@ -315,12 +400,16 @@ void HTTPConnection::readRequest() {
 
     } else {
         qWarning() << "Unrecognized HTTP operation." << _address << line;
+        _keepAlive = false;
         respond("400 Bad Request", "Unrecognized operation.");
         return;
     }
     int idx = line.indexOf(' ') + 1;
     _requestUrl.setUrl(line.mid(idx, line.lastIndexOf(' ') - idx));
 
+    // HTTP/1.1 connections are persistent unless the client says otherwise in its headers
+    _keepAlive = line.endsWith("HTTP/1.1");
+
     // switch to reading the header
     _socket->disconnect(this, SLOT(readRequest()));
     connect(_socket, SIGNAL(readyRead()), SLOT(readHeaders()));
@@ -336,19 +425,32 @@ void HTTPConnection::readHeaders() {
         if (trimmed.isEmpty()) {
             _socket->disconnect(this, SLOT(readHeaders()));
 
+            QByteArray connectionHeader = requestHeader("Connection").toLower();
+            if (connectionHeader.contains("close")) {
+                _keepAlive = false;
+            } else if (connectionHeader.contains("keep-alive")) {
+                _keepAlive = true;
+            }
+
             QByteArray clength = requestHeader("Content-Length");
             if (clength.isEmpty()) {
-                _parentManager->handleHTTPRequest(this, _requestUrl);
+                dispatchRequest(_requestUrl);
 
             } else {
                 bool success = false;
                 auto length = clength.toInt(&success);
                 if (!success) {
                     qWarning() << "Invalid header." << _address << trimmed;
+                    _keepAlive = false;
                     respond("400 Bad Request", "The header was malformed.");
                     return;
                 }
 
+                // clients waiting for permission to send a large body get it right away
+                if (requestHeader("Expect").toLower() == "100-continue") {
+                    _socket->write("HTTP/1.1 100 Continue\r\n\r\n");
+                }
+
                 // Storing big requests in memory gets expensive, especially on servers
                 // with limited memory. So we store big requests in a temporary file on disk
                 // and map it to faster read/write access.
@@ -374,6 +476,7 @@ void HTTPConnection::readHeaders() {
         int idx = trimmed.indexOf(':');
         if (idx == -1) {
             qWarning() << "Invalid header." << _address << trimmed;
+            _keepAlive = false;
             respond("400 Bad Request", "The header was malformed.");
             return;
         }
@@ -394,6 +497,6 @@ void HTTPConnection::readContent() {
     if (_requestContent->bytesLeftToWrite() == 0) {
         _socket->disconnect(this, SLOT(readContent()));
 
-        _parentManager->handleHTTPRequest(this, _requestUrl.path());
+        dispatchRequest(_requestUrl.path());
     }
 }
@@ -24,6 +24,7 @@
 #include <QObject>
 #include <QPair>
 #include <QTemporaryFile>
+#include <QTimer>
 #include <QUrl>
 
 #include <memory>
@@ -97,7 +98,8 @@ public:
     /// Duplicate keys are not supported.
     QHash<QString, QString> parseUrlEncodedForm();
 
-    /// Sends a response and closes the connection.
+    /// Sends a response, then either closes the connection or waits for the next request if the client asked to keep it alive.
+    /// This can be called from any thread, but the connection must not be used by the caller once it has responded.
     void respond(const char* code, const QByteArray& content = QByteArray(),
         const char* contentType = DefaultContentType,
         const Headers& headers = Headers());
@@ -116,9 +118,18 @@ protected slots:
     /// Reads the content.
     void readContent();
 
+    /// Handles the socket going away, which is deferred while a request handler may still be using this connection.
+    void handleSocketClosed();
+
 protected:
     void respondWithStatusAndHeaders(const char* code, const char* contentType, const Headers& headers, qint64 size);
 
+    /// Hands the complete request to the manager.
+    void dispatchRequest(const QUrl& url);
+
+    /// Closes the connection, or resets it for the next request on a kept-alive connection.
+    void finishResponse();
+
     /// The parent HTTP manager
     HTTPManager* _parentManager;
 
@@ -145,6 +156,18 @@ protected:
 
     /// Response content
     std::unique_ptr<QIODevice> _responseDevice;
+
+    /// Whether the client wants to send further requests on this connection.
+    bool _keepAlive { false };
+
+    /// Whether a request handler has this request and has not yet responded.
+    bool _isHandlingRequest { false };
+
+    /// Whether the socket closed while a request handler had this request.
+    bool _isSocketClosed { false };
+
+    /// Closes kept-alive connections that stay idle.
+    QTimer* _keepAliveTimer { nullptr };
 };
 
 #endif // hifi_HTTPConnection_h
@@ -37,7 +37,47 @@ HTTPManager::HTTPManager(const QHostAddress& listenAddress, quint16 port, const
     _isListeningTimer->start(SOCKET_CHECK_INTERVAL_IN_MS);
 }
 
+HTTPManager::~HTTPManager() {
+    for (auto& worker : _workers) {
+        worker.first->quit();
+        worker.first->wait();
+    }
+}
+
+void HTTPManager::startWorkerThreads(int numThreads) {
+    for (int i = 0; i < numThreads; ++i) {
+        QThread* thread = new QThread(this);
+        thread->setObjectName(QString("HTTP Worker %1").arg(_workers.size()));
+
+        QObject* context = new QObject();
+        context->moveToThread(thread);
+
+        // the context and every connection it owns go away with the thread
+        connect(thread, &QThread::finished, context, &QObject::deleteLater);
+
+        thread->start();
+        _workers.push_back({ thread, context });
+    }
+}
+
 void HTTPManager::incomingConnection(qintptr socketDescriptor) {
+    if (!_workers.empty()) {
+        // sockets have to be created on the thread they are used from, so let the next worker take this one
+        QObject* context = _workers[_nextWorker++ % _workers.size()].second;
+
+        QMetaObject::invokeMethod(context, [this, context, socketDescriptor] {
+            QTcpSocket* socket = new QTcpSocket(context);
+
+            if (socket->setSocketDescriptor(socketDescriptor)) {
+                new HTTPConnection(socket, this);
+            } else {
+                delete socket;
+            }
+        });
+
+        return;
+    }
+
     QTcpSocket* socket = new QTcpSocket(this);
     
     if (socket->setSocketDescriptor(socketDescriptor)) {
@@ -47,6 +87,35 @@ void HTTPManager::incomingConnection(qintptr socketDescriptor) {
     }
 }
 
+void HTTPManager::dispatchHTTPRequest(HTTPConnection* connection, const QUrl& url) {
+    if (url.path().contains(QChar(0x00))) {
+        // the request is going to be rejected without reaching the request handler
+        handleHTTPRequest(connection, url);
+        return;
+    }
+
+    if (requestHandledOnConnectionThread(connection, url)) {
+        // the request handler took this one without having to wait on its own thread
+        return;
+    }
+
+    if (QThread::currentThread() == thread()) {
+        // we own this connection
+        handleHTTPRequest(connection, url);
+        return;
+    }
+
+    // the connection stays alive until it has responded, so it is safe to hand to the request handler on our thread
+    QMetaObject::invokeMethod(this, [this, connection, url] {
+        if (!requestHandledByRequestHandler(connection, url)) {
+            // the document root is served back on the worker, off this thread
+            QMetaObject::invokeMethod(connection, [this, connection, url] {
+                handleHTTPRequest(connection, url, true);
+            });
+        }
+    });
+}
+
 bool HTTPManager::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
     // Reject paths with embedded NULs
     if (url.path().contains(QChar(0x00))) {
@@ -188,6 +257,10 @@ bool HTTPManager::handleHTTPRequest(HTTPConnection* connection, const QUrl& url,
     return true;
 }
 
+bool HTTPManager::requestHandledOnConnectionThread(HTTPConnection* connection, const QUrl& url) {
+    return _requestHandler && _requestHandler->handleHTTPRequestOnConnectionThread(connection, url);
+}
+
 bool HTTPManager::requestHandledByRequestHandler(HTTPConnection* connection, const QUrl& url) {
     return _requestHandler && _requestHandler->handleHTTPRequest(connection, url);
 }
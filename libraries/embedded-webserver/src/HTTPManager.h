@@ -17,8 +17,11 @@
 #define hifi_HTTPManager_h
 
 #include <QtNetwork/QTcpServer>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include <vector>
+
 class HTTPConnection;
 class HTTPSConnection;
 
@@ -26,6 +29,10 @@ class HTTPRequestHandler {
 public:
     /// Handles an HTTP request.
     virtual bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) = 0;
+
+    /// Handles an HTTP request on the thread of its connection, before it would be handed to handleHTTPRequest.
+    /// Only requests that can be served without touching state owned by the handler's thread should be taken here.
+    virtual bool handleHTTPRequestOnConnectionThread(HTTPConnection* connection, const QUrl& url) { return false; }
 };
 
 /// Handles HTTP connections
@@ -34,9 +41,18 @@ class HTTPManager : public QTcpServer, public HTTPRequestHandler {
 public:
     /// Initializes the manager.
     HTTPManager(const QHostAddress& listenAddress, quint16 port, const QString& documentRoot, HTTPRequestHandler* requestHandler = nullptr);
+    virtual ~HTTPManager();
     
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 
+    /// Spreads new connections over a pool of worker threads that read requests, stream responses and serve the
+    /// document root, so that slow clients never hold up this thread. The request handler is still called on this thread,
+    /// for all but the requests it takes in handleHTTPRequestOnConnectionThread.
+    void startWorkerThreads(int numThreads);
+
+    /// Hands a fully read request to the request handler, called from the thread of the connection.
+    void dispatchHTTPRequest(HTTPConnection* connection, const QUrl& url);
+
 private slots:
     void isTcpServerListening();
     void queuedExit(QString errorMessage);
@@ -47,6 +63,7 @@ private:
 protected:
     /// Accepts all pending connections
     virtual void incomingConnection(qintptr socketDescriptor) override;
+    virtual bool requestHandledOnConnectionThread(HTTPConnection* connection, const QUrl& url);
     virtual bool requestHandledByRequestHandler(HTTPConnection* connection, const QUrl& url);
     
     QHostAddress _listenAddress;
@@ -54,6 +71,10 @@ protected:
     HTTPRequestHandler* _requestHandler;
     QTimer* _isListeningTimer;
     const quint16 _port;
+
+    // each worker thread has a context object that owns the sockets and connections handled on it
+    std::vector<std::pair<QThread*, QObject*>> _workers;
+    size_t _nextWorker { 0 };
 };
 
 #endif // hifi_HTTPManager_h
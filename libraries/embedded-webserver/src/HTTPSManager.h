@@ -41,6 +41,7 @@ public:
     
 protected:
     void incomingConnection(qintptr socketDescriptor) override;
+    bool requestHandledOnConnectionThread(HTTPConnection* connection, const QUrl& url) override { return false; }
     bool requestHandledByRequestHandler(HTTPConnection* connection, const QUrl& url) override;
 private:
     QSslCertificate _certificate;
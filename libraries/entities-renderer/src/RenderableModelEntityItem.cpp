@@ -350,7 +350,8 @@ bool RenderableModelEntityItem::isReadyToComputeShape() const {
         // the model is still being downloaded.
         return false;
     } else if (type >= SHAPE_TYPE_SIMPLE_HULL && type <= SHAPE_TYPE_STATIC_MESH) {
-        return isModelLoaded();
+        // the shape is made from the meshes, so not from those of a coarse stand-in
+        return isModelLoaded() && !model->isRefining();
     }
     return true;
 }
@@ -12,6 +12,9 @@
 #ifndef hifi_FBX_h_
 #define hifi_FBX_h_
 
+#include <memory>
+#include <vector>
+
 #include <QMetaType>
 #include <QVariant>
 #include <QVector>
@@ -36,6 +39,27 @@ static const int FBX_DRACO_MESH_VERSION = 2;
 class FBXNode;
 using FBXNodeList = QList<FBXNode>;
 
+/// The arrays of a Geometry node, decoded by the binary parser straight into the buffers the mesh or blendshape is built
+/// from. The nodes that held them are left out of the tree.
+class FBXGeometryArrays {
+public:
+    template <class T>
+    class Layer {
+    public:
+        QVector<T> values;
+        QVector<int> indices;
+    };
+
+    QVector<glm::vec3> vertices;
+    QVector<int> polygonIndices;
+    // Of a blendshape, whose normals aren't in a layer
+    QVector<int> indexes;
+    QVector<glm::vec3> normals;
+    // In the order of their LayerElementNormal and LayerElementUV nodes
+    std::vector<Layer<glm::vec3>> normalLayers;
+    std::vector<Layer<glm::vec2>> uvLayers;
+};
+using FBXGeometryArraysPointer = std::shared_ptr<FBXGeometryArrays>;
 
 /// A node within an FBX document.
 class FBXNode {
@@ -43,6 +67,8 @@ public:
     hifi::ByteArray name;
     QVariantList properties;
     FBXNodeList children;
+    // Only set on the Geometry nodes of a tree parsed with its geometry arrays decoded
+    FBXGeometryArraysPointer geometryArrays;
 };
 
 #endif // hifi_FBX_h_
@@ -18,6 +18,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
 
 #include <hfm/ModelFormatLogging.h>
 #include <hfm/HFMModelMath.h>
@@ -245,6 +246,11 @@ void appendModelIDs(const QString& parentID, const QMultiMap<QString, QString>&
 
 HFMBlendshape extractBlendshape(const FBXNode& object) {
     HFMBlendshape blendshape;
+    if (object.geometryArrays) {
+        blendshape.indices = object.geometryArrays->indexes;
+        blendshape.vertices = object.geometryArrays->vertices;
+        blendshape.normals = object.geometryArrays->normals;
+    }
     foreach (const FBXNode& data, object.children) {
         if (data.name == "Indexes") {
             blendshape.indices = FBXSerializer::getIntVector(data);
@@ -526,10 +532,18 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
             }
         } else if (child.name == "Objects") {
+            // Meshes, Draco compressed ones in baked models especially, take most of the time to extract,
+            // so they are only numbered here and extracted all together once the other objects are read
+            struct PendingMesh {
+                QString id;
+                const FBXNode* object;
+                unsigned int meshIndex;
+            };
+            std::vector<PendingMesh> pendingMeshes;
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        pendingMeshes.push_back({ getID(object.properties), &object, meshIndex++ });
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape blendshape = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(blendshape);
@@ -1116,6 +1130,15 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
 #endif
             }
+
+            std::vector<ExtractedMesh> extractedMeshes(pendingMeshes.size());
+            tbb::parallel_for((size_t)0, pendingMeshes.size(), [&](size_t i) {
+                unsigned int pendingMeshIndex = pendingMeshes[i].meshIndex;
+                extractedMeshes[i] = extractMesh(*pendingMeshes[i].object, pendingMeshIndex, deduplicateIndices);
+            });
+            for (size_t i = 0; i < pendingMeshes.size(); ++i) {
+                meshes.insert(pendingMeshes[i].id, std::move(extractedMeshes[i]));
+            }
         } else if (child.name == "Connections") {
             static const QVariant OO = hifi::ByteArray("OO");
             static const QVariant OP = hifi::ByteArray("OP");
@@ -1678,7 +1701,7 @@ HFMModel::Pointer FBXSerializer::read(const hifi::ByteArray& data, const hifi::V
     QBuffer buffer(const_cast<hifi::ByteArray*>(&data));
     buffer.open(QIODevice::ReadOnly);
 
-    _rootNode = parseFBX(&buffer);
+    _rootNode = parseFBX(&buffer, _decodeGeometryArrays);
 
     // FBXSerializer's mapping parameter supports the bool "deduplicateIndices," which is passed into FBXSerializer::extractMesh as "deduplicate"
 
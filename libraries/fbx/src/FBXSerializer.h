@@ -123,7 +123,9 @@ public:
     HFMModel::Pointer read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url = hifi::URL()) override;
 
     FBXNode _rootNode;
-    static FBXNode parseFBX(QIODevice* device);
+    // Off to keep the geometry arrays in the properties of their nodes, for a tree that is written back out
+    bool _decodeGeometryArrays { true };
+    static FBXNode parseFBX(QIODevice* device, bool decodeGeometryArrays = false);
 
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
@@ -203,6 +203,15 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
 
     bool isDracoMesh = false;
 
+    // A binary FBX is parsed with the arrays of its geometry decoded, and without the nodes that held them
+    const FBXGeometryArrays* arrays = object.geometryArrays.get();
+    size_t normalLayer = 0;
+    size_t uvLayer = 0;
+    if (arrays) {
+        data.vertices = arrays->vertices;
+        data.polygonIndices = arrays->polygonIndices;
+    }
+
     foreach (const FBXNode& child, object.children) {
         if (child.name == "Vertices") {
             data.vertices = createVec3Vector(getDoubleVector(child));
@@ -227,6 +236,11 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                     indexToDirect = true;
                 }
             }
+            if (arrays && normalLayer < arrays->normalLayers.size()) {
+                const auto& layer = arrays->normalLayers[normalLayer++];
+                data.normals = layer.values;
+                data.normalIndices = layer.indices;
+            }
             if (indexToDirect && data.normalIndices.isEmpty()) {
                 // hack to work around wacky Makehuman exports
                 data.normalsByVertex = true;
@@ -266,6 +280,10 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
 #endif
          
         } else if (child.name == "LayerElementUV") {
+            const FBXGeometryArrays::Layer<glm::vec2>* uvArrays = nullptr;
+            if (arrays && uvLayer < arrays->uvLayers.size()) {
+                uvArrays = &arrays->uvLayers[uvLayer++];
+            }
             if (child.properties.at(0).toInt() == 0) {
                 AttributeData attrib;
                 attrib.index = child.properties.at(0).toInt();
@@ -292,6 +310,12 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                     }
 #endif
                 }
+                if (uvArrays) {
+                    data.texCoords = uvArrays->values;
+                    attrib.texCoords = uvArrays->values;
+                    data.texCoordIndices = uvArrays->indices;
+                    attrib.texCoordIndices = uvArrays->indices;
+                }
                 data.extracted.texcoordSetMap.insert(attrib.name, data.attributes.size());
                 data.attributes.push_back(attrib);
             } else {
@@ -318,6 +342,10 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                     }
 #endif
                 }
+                if (uvArrays) {
+                    attrib.texCoords = uvArrays->values;
+                    attrib.texCoordIndices = uvArrays->indices;
+                }
 
                 QHash<QString, size_t>::iterator it = data.extracted.texcoordSetMap.find(attrib.name);
                 if (it == data.extracted.texcoordSetMap.end()) {
@@ -11,9 +11,11 @@
 
 #include "FBXSerializer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <QtCore/QBuffer>
-#include <QtCore/QDataStream>
 #include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
@@ -21,213 +23,729 @@
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
+#include <zlib.h>
+
 #include <shared/NsightHelpers.h>
+#include <TBBHelpers.h>
 #include <hfm/ModelFormatLogging.h>
 
-template<class T>
-int streamSize() {
-    return sizeof(T);
-}
+// Parses a binary FBX straight out of the bytes of the file.
+// The arrays, which make up most of a large FBX, are allocated once at their final size.
+// A first pass over the node headers finds the compressed ones, which are all inflated in parallel before the second pass
+// builds the tree out of them.
+// With the geometry arrays decoded, the vertices, normals and texture coordinates of the Geometry nodes, and their indices,
+// go straight into the FBXGeometryArrays of the node, in the types the meshes are built from, and never into the tree.
+class BinaryFBXParser {
+public:
+    BinaryFBXParser(const char* data, size_t size, bool decodeGeometryArrays) :
+        _begin(data), _cursor(data), _end(data + size), _decodeGeometryArrays(decodeGeometryArrays) {}
+
+    FBXNode parse();
+
+private:
+    // Where a node is within a Geometry node, which decides what its arrays are decoded to
+    enum class GeometryScope {
+        NONE,
+        GEOMETRY,
+        NORMAL_LAYER,
+        UV_LAYER,
+        OTHER
+    };
+    enum class GeometryArray {
+        NONE,
+        VERTICES,
+        POLYGON_INDICES,
+        INDEXES,
+        NORMALS,
+        LAYER_NORMALS,
+        LAYER_NORMAL_INDICES,
+        LAYER_UVS,
+        LAYER_UV_INDICES
+    };
+
+    // A node name, compared without copying it out of the file
+    struct Name {
+        const char* data;
+        size_t length;
+
+        bool operator==(const char* other) const { return strlen(other) == length && memcmp(data, other, length) == 0; }
+    };
+
+    struct CompressedArray {
+        char type;
+        GeometryArray target;
+        const char* source;
+        size_t sourceSize;
+        quint32 arrayLength;
+    };
+
+    // A compressed array once inflated, for the tree or for the geometry arrays depending on its target
+    struct InflatedArray {
+        QVariant values;
+        QVector<glm::vec3> vec3s;
+        QVector<glm::vec2> vec2s;
+        QVector<int> ints;
+    };
+
+    // FBX is little endian, which the arrays are copied as
+    static void toHostByteOrder(char* data, size_t size, size_t elementSize) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        for (char* element = data; element < data + size; element += elementSize) {
+            std::reverse(element, element + elementSize);
+        }
+#endif
+    }
+
+    template <class T>
+    static T load(const char* source) {
+        T value;
+        memcpy(&value, source, sizeof(T));
+        toHostByteOrder(reinterpret_cast<char*>(&value), sizeof(T), sizeof(T));
+        return value;
+    }
+
+    // Bool arrays are copied a byte per value, but only 0 and 1 are valid bools
+    template <class T>
+    static void normalize(QVector<T>&) {}
+    static void normalize(QVector<bool>& values) {
+        auto bytes = reinterpret_cast<quint8*>(values.data());
+        for (int i = 0; i < values.size(); ++i) {
+            bytes[i] = bytes[i] != 0 ? 1 : 0;
+        }
+    }
+
+    // Vertices and normals are used as they are, texture coordinates are flipped like FBXSerializer::createVec2Vector does
+    template <class T>
+    static void decodeVector(const char* source, glm::vec3& vector) {
+        vector = glm::vec3(load<T>(source), load<T>(source + sizeof(T)), load<T>(source + 2 * sizeof(T)));
+    }
+    template <class T>
+    static void decodeVector(const char* source, glm::vec2& vector) {
+        vector = glm::vec2(load<T>(source), -load<T>(source + sizeof(T)));
+    }
+
+    static void take(InflatedArray& inflated, QVector<glm::vec3>& values) { values = std::move(inflated.vec3s); }
+    static void take(InflatedArray& inflated, QVector<glm::vec2>& values) { values = std::move(inflated.vec2s); }
+    static void take(InflatedArray& inflated, QVector<int>& values) { values = std::move(inflated.ints); }
+
+    size_t getPosition() const { return _cursor - _begin; }
+
+    void require(size_t size) const {
+        if (size > (size_t)(_end - _cursor)) {
+            throw QString("FBX file most likely corrupt: unexpected end of file");
+        }
+    }
+
+    template <class T>
+    T read() {
+        require(sizeof(T));
+        T value = load<T>(_cursor);
+        _cursor += sizeof(T);
+        return value;
+    }
+
+    const char* skip(size_t size) {
+        require(size);
+        const char* data = _cursor;
+        _cursor += size;
+        return data;
+    }
+
+    struct ArrayHeader {
+        quint32 arrayLength;
+        quint32 encoding;
+        quint32 compressedLength;
+    };
+    template <class T> ArrayHeader readArrayHeader();
+    InflatedArray& takeInflatedArray();
+    template <class T> void readArray(QVector<T>& values);
+    template <class T> QVariant readArray();
+    template <class T, class V> void readVectors(QVector<V>& vectors);
+    template <class V> void readVectors(char type, QVector<V>& vectors);
+    template <class T> static bool inflateArray(const CompressedArray& array, QVector<T>& values);
+    template <class T> static QVariant inflateArray(const CompressedArray& array);
+    template <class T, class V> static bool inflateVectors(const CompressedArray& array, QVector<V>& vectors);
+    template <class V> static bool inflateVectors(const CompressedArray& array, QVector<V>& vectors);
+    QVariant readProperty();
+    bool readGeometryArray(GeometryArray array, FBXGeometryArrays& arrays);
+    FBXNode readNode(GeometryScope scope, FBXGeometryArrays* geometryArrays);
+
+    GeometryScope getChildScope(GeometryScope scope, const Name& name) const;
+    static GeometryArray getGeometryArray(GeometryScope scope, const Name& name);
+    static GeometryArray getTarget(GeometryArray array, char type);
+
+    quint64 readNodeHeader(quint64& propertyCount, quint8& nameLength);
+    template <class T> void scanArray(char type, GeometryArray target);
+    void scanProperty(GeometryArray array);
+    bool scanNode(GeometryScope scope);
+    void inflateArrays();
+
+    const char* _begin;
+    const char* _cursor;
+    const char* _end;
+    const bool _decodeGeometryArrays;
+    bool _has64BitPositions { false };
+    std::vector<CompressedArray> _compressedArrays;
+    std::vector<InflatedArray> _inflatedArrays;
+    size_t _nextInflatedArray { 0 };
+};
 
-template<bool>
-int streamSize() {
-    return 1;
+template <>
+bool BinaryFBXParser::read<bool>() {
+    return read<quint8>() != 0;
 }
 
-template<class T>
-QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
+// Inflates a compressed array a chunk at a time, and hands the whole units of unitSize bytes of each chunk to decode, so
+// the inflated array is never held at once. Fails unless it inflates to exactly byteLength bytes.
+template <class Decode>
+static bool inflateInChunks(const char* source, size_t sourceSize, size_t byteLength, size_t unitSize, Decode decode) {
+    static const size_t CHUNK_SIZE = 64 * 1024;
+    std::vector<char> chunk(std::max<size_t>(CHUNK_SIZE / unitSize, 1) * unitSize);
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit(&stream) != Z_OK) {
+        return false;
+    }
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(source));
+    stream.avail_in = (uInt)sourceSize;
+
+    size_t inflatedSize = 0;
+    size_t pendingSize = 0;
+    int result = Z_OK;
+    while (result == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef*>(chunk.data() + pendingSize);
+        stream.avail_out = (uInt)(chunk.size() - pendingSize);
+        result = inflate(&stream, Z_NO_FLUSH);
+        const size_t chunkSize = chunk.size() - stream.avail_out;
+        inflatedSize += chunkSize - pendingSize;
+        if ((result != Z_OK && result != Z_STREAM_END) || inflatedSize > byteLength) {
+            break;
+        }
+        // the bytes of a unit split between two chunks wait for the next one
+        const size_t decodedSize = (chunkSize / unitSize) * unitSize;
+        decode(chunk.data(), decodedSize);
+        pendingSize = chunkSize - decodedSize;
+        memmove(chunk.data(), chunk.data() + decodedSize, pendingSize);
+    }
+    inflateEnd(&stream);
+    return result == Z_STREAM_END && inflatedSize == byteLength;
+}
 
-    in >> arrayLength;
-    if (arrayLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
+template <class T>
+BinaryFBXParser::ArrayHeader BinaryFBXParser::readArrayHeader() {
+    ArrayHeader header;
+    header.arrayLength = read<quint32>();
+    if (header.arrayLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: binary data exceeds data limits");
     }
-    in >> encoding;
-    in >> compressedLength;
-    if (compressedLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
+    header.encoding = read<quint32>();
+    header.compressedLength = read<quint32>();
+    if (header.compressedLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: compressed binary data exceeds data limits");
     }
-    position += sizeof(quint32) * 3;
+    return header;
+}
+
+BinaryFBXParser::InflatedArray& BinaryFBXParser::takeInflatedArray() {
+    // inflated by the first pass, in the order they appear in the file
+    if (_nextInflatedArray >= _inflatedArrays.size()) {
+        throw QString("corrupt fbx file");
+    }
+    return _inflatedArrays[_nextInflatedArray++];
+}
+
+template <class T>
+void BinaryFBXParser::readArray(QVector<T>& values) {
+    const ArrayHeader header = readArrayHeader<T>();
+    if (header.encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        skip(header.compressedLength);
+        take(takeInflatedArray(), values);
+        return;
+    }
+
+    values.resize(header.arrayLength);
+    const size_t byteLength = sizeof(T) * header.arrayLength;
+    const char* source = skip(byteLength);
+    if (byteLength > 0) {
+        memcpy(values.data(), source, byteLength);
+        toHostByteOrder(reinterpret_cast<char*>(values.data()), byteLength, sizeof(T));
+        normalize(values);
+    }
+}
+
+template <class T>
+QVariant BinaryFBXParser::readArray() {
+    const ArrayHeader header = readArrayHeader<T>();
+    if (header.encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        skip(header.compressedLength);
+        return std::move(takeInflatedArray().values);
+    }
 
     QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        hifi::ByteArray arrayData;
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
+    values.resize(header.arrayLength);
+    const size_t byteLength = sizeof(T) * header.arrayLength;
+    const char* source = skip(byteLength);
+    if (byteLength > 0) {
+        memcpy(values.data(), source, byteLength);
+        toHostByteOrder(reinterpret_cast<char*>(values.data()), byteLength, sizeof(T));
+        normalize(values);
+    }
+    return QVariant::fromValue(values);
+}
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
-        }
+template <class T, class V>
+void BinaryFBXParser::readVectors(QVector<V>& vectors) {
+    const ArrayHeader header = readArrayHeader<T>();
+    if (header.encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        skip(header.compressedLength);
+        take(takeInflatedArray(), vectors);
+        return;
+    }
+
+    // like the createVec*Vector functions, the values left over after the last whole vector are dropped
+    const size_t vectorSize = V::length() * sizeof(T);
+    const char* source = skip(sizeof(T) * header.arrayLength);
+    vectors.resize((int)(header.arrayLength / V::length()));
+    for (V* vector = vectors.data(), *end = vector + vectors.size(); vector != end; ++vector, source += vectorSize) {
+        decodeVector<T>(source, *vector);
+    }
+}
+
+template <class V>
+void BinaryFBXParser::readVectors(char type, QVector<V>& vectors) {
+    if (type == 'd') {
+        readVectors<double>(vectors);
     } else {
-        values.reserve(arrayLength);
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            hifi::ByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+        readVectors<float>(vectors);
+    }
+}
+
+template <class T>
+bool BinaryFBXParser::inflateArray(const CompressedArray& array, QVector<T>& values) {
+    values.resize(array.arrayLength);
+    const size_t byteLength = sizeof(T) * array.arrayLength;
+    if (byteLength > 0) {
+        uLongf inflatedSize = (uLongf)byteLength;
+        int result = uncompress(reinterpret_cast<Bytef*>(values.data()), &inflatedSize,
+                                reinterpret_cast<const Bytef*>(array.source), (uLong)array.sourceSize);
+        if (result != Z_OK || inflatedSize != byteLength) {
+            return false;
         }
+        toHostByteOrder(reinterpret_cast<char*>(values.data()), byteLength, sizeof(T));
+        normalize(values);
+    }
+    return true;
+}
+
+template <class T>
+QVariant BinaryFBXParser::inflateArray(const CompressedArray& array) {
+    QVector<T> values;
+    if (!inflateArray(array, values)) {
+        return QVariant();
     }
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
-    switch (ch) {
-        case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
-        }
-        case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
-        }
-        case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
-        }
-        case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
-        }
-        case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
-        }
-        case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
-        }
-        case 'f': {
-            return readBinaryArray<float>(in, position);
-        }
-        case 'd': {
-            return readBinaryArray<double>(in, position);
-        }
-        case 'l': {
-            return readBinaryArray<qint64>(in, position);
-        }
-        case 'i': {
-            return readBinaryArray<qint32>(in, position);
-        }
-        case 'b': {
-            return readBinaryArray<bool>(in, position);
+template <class T, class V>
+bool BinaryFBXParser::inflateVectors(const CompressedArray& array, QVector<V>& vectors) {
+    const size_t vectorSize = V::length() * sizeof(T);
+    vectors.resize((int)(array.arrayLength / V::length()));
+    V* vector = vectors.data();
+    V* end = vector + vectors.size();
+    return inflateInChunks(array.source, array.sourceSize, sizeof(T) * array.arrayLength, vectorSize,
+                           [&](const char* data, size_t size) {
+        for (const char* source = data; source < data + size && vector != end; source += vectorSize) {
+            decodeVector<T>(source, *vector++);
         }
+    });
+}
+
+template <class V>
+bool BinaryFBXParser::inflateVectors(const CompressedArray& array, QVector<V>& vectors) {
+    if (array.type == 'd') {
+        return inflateVectors<double>(array, vectors);
+    }
+    return inflateVectors<float>(array, vectors);
+}
+
+QVariant BinaryFBXParser::readProperty() {
+    char ch = read<char>();
+    switch (ch) {
+        case 'Y':
+            return QVariant::fromValue(read<qint16>());
+        case 'C':
+            return QVariant::fromValue(read<quint8>() != 0);
+        case 'I':
+            return QVariant::fromValue(read<qint32>());
+        case 'F':
+            return QVariant::fromValue(read<float>());
+        case 'D':
+            return QVariant::fromValue(read<double>());
+        case 'L':
+            return QVariant::fromValue(read<qint64>());
+        case 'f':
+            return readArray<float>();
+        case 'd':
+            return readArray<double>();
+        case 'l':
+            return readArray<qint64>();
+        case 'i':
+            return readArray<qint32>();
+        case 'b':
+            return readArray<bool>();
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = read<quint32>();
+            const char* data = skip(length);
+            return QVariant::fromValue(hifi::ByteArray(data, length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
-    qint64 endOffset;
-    quint64 propertyCount;
-    quint64 propertyListLength;
-    quint8 nameLength;
+// Answers false, having read nothing, when the next property isn't one of the geometry arrays
+bool BinaryFBXParser::readGeometryArray(GeometryArray array, FBXGeometryArrays& arrays) {
+    require(sizeof(char));
+    const char type = *_cursor;
+    const GeometryArray target = getTarget(array, type);
+    if (target == GeometryArray::NONE) {
+        return false;
+    }
+    skip(sizeof(char));
+
+    // the layers are added as their nodes are read, so the arrays of a layer go to the last one
+    switch (target) {
+        case GeometryArray::VERTICES:
+            readVectors(type, arrays.vertices);
+            break;
+        case GeometryArray::NORMALS:
+            readVectors(type, arrays.normals);
+            break;
+        case GeometryArray::LAYER_NORMALS:
+            readVectors(type, arrays.normalLayers.back().values);
+            break;
+        case GeometryArray::LAYER_UVS:
+            readVectors(type, arrays.uvLayers.back().values);
+            break;
+        case GeometryArray::POLYGON_INDICES:
+            readArray(arrays.polygonIndices);
+            break;
+        case GeometryArray::INDEXES:
+            readArray(arrays.indexes);
+            break;
+        case GeometryArray::LAYER_NORMAL_INDICES:
+            readArray(arrays.normalLayers.back().indices);
+            break;
+        case GeometryArray::LAYER_UV_INDICES:
+            readArray(arrays.uvLayers.back().indices);
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+BinaryFBXParser::GeometryScope BinaryFBXParser::getChildScope(GeometryScope scope, const Name& name) const {
+    switch (scope) {
+        case GeometryScope::NONE:
+            return (_decodeGeometryArrays && name == "Geometry") ? GeometryScope::GEOMETRY : GeometryScope::NONE;
+        case GeometryScope::GEOMETRY:
+            if (name == "LayerElementNormal") {
+                return GeometryScope::NORMAL_LAYER;
+            } else if (name == "LayerElementUV") {
+                return GeometryScope::UV_LAYER;
+            }
+            return GeometryScope::OTHER;
+        default:
+            return GeometryScope::OTHER;
+    }
+}
+
+BinaryFBXParser::GeometryArray BinaryFBXParser::getGeometryArray(GeometryScope scope, const Name& name) {
+    switch (scope) {
+        case GeometryScope::GEOMETRY:
+            if (name == "Vertices") {
+                return GeometryArray::VERTICES;
+            } else if (name == "PolygonVertexIndex") {
+                return GeometryArray::POLYGON_INDICES;
+            } else if (name == "Indexes") {
+                return GeometryArray::INDEXES;
+            } else if (name == "Normals") {
+                return GeometryArray::NORMALS;
+            }
+            return GeometryArray::NONE;
+        case GeometryScope::NORMAL_LAYER:
+            if (name == "Normals") {
+                return GeometryArray::LAYER_NORMALS;
+            } else if (name == "NormalsIndex") {
+                return GeometryArray::LAYER_NORMAL_INDICES;
+            }
+            return GeometryArray::NONE;
+        case GeometryScope::UV_LAYER:
+            if (name == "UV") {
+                return GeometryArray::LAYER_UVS;
+            } else if (name == "UVIndex") {
+                return GeometryArray::LAYER_UV_INDICES;
+            }
+            return GeometryArray::NONE;
+        default:
+            return GeometryArray::NONE;
+    }
+}
+
+// The arrays of any other type stay in the tree
+BinaryFBXParser::GeometryArray BinaryFBXParser::getTarget(GeometryArray array, char type) {
+    switch (array) {
+        case GeometryArray::VERTICES:
+        case GeometryArray::NORMALS:
+        case GeometryArray::LAYER_NORMALS:
+        case GeometryArray::LAYER_UVS:
+            return (type == 'd' || type == 'f') ? array : GeometryArray::NONE;
+        case GeometryArray::POLYGON_INDICES:
+        case GeometryArray::INDEXES:
+        case GeometryArray::LAYER_NORMAL_INDICES:
+        case GeometryArray::LAYER_UV_INDICES:
+            return type == 'i' ? array : GeometryArray::NONE;
+        default:
+            return GeometryArray::NONE;
+    }
+}
+
+quint64 BinaryFBXParser::readNodeHeader(quint64& propertyCount, quint8& nameLength) {
+    quint64 endOffset;
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
-    // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit 
-    // values and then assign to our actual 64bit values.
-    if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+    if (_has64BitPositions) {
+        endOffset = read<quint64>();
+        propertyCount = read<quint64>();
+        read<quint64>(); // property list length
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = read<quint32>();
+        propertyCount = read<quint32>();
+        read<quint32>(); // property list length
+    }
+    nameLength = read<quint8>();
 
-    FBXNode node;
-    const int MIN_VALID_OFFSET = 40;
+    const quint64 MIN_VALID_OFFSET = 40;
     if (endOffset < MIN_VALID_OFFSET || nameLength == 0) {
+        // a null node
+        return 0;
+    }
+    if (endOffset > (quint64)(_end - _begin)) {
+        throw QString("FBX file most likely corrupt: node extends past the end of the file");
+    }
+    return endOffset;
+}
+
+FBXNode BinaryFBXParser::readNode(GeometryScope scope, FBXGeometryArrays* geometryArrays) {
+    quint64 propertyCount;
+    quint8 nameLength;
+    const quint64 endOffset = readNodeHeader(propertyCount, nameLength);
+
+    FBXNode node;
+    if (endOffset == 0) {
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    const Name name { skip(nameLength), nameLength };
+    node.name = hifi::ByteArray(name.data, nameLength);
+
+    const GeometryArray array = getGeometryArray(scope, name);
+    bool hasGeometryArray = false;
+    for (quint64 i = 0; i < propertyCount; i++) {
+        if (array != GeometryArray::NONE && readGeometryArray(array, *geometryArrays)) {
+            hasGeometryArray = true;
+        } else {
+            if (node.properties.isEmpty()) {
+                node.properties.reserve((int)std::min<quint64>(propertyCount, (quint64)(_end - _cursor)));
+            }
+            node.properties.append(readProperty());
+        }
+    }
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    const GeometryScope childScope = getChildScope(scope, name);
+    if (childScope == GeometryScope::GEOMETRY) {
+        node.geometryArrays = std::make_shared<FBXGeometryArrays>();
+        geometryArrays = node.geometryArrays.get();
+    } else if (childScope == GeometryScope::NORMAL_LAYER) {
+        geometryArrays->normalLayers.emplace_back();
+    } else if (childScope == GeometryScope::UV_LAYER) {
+        geometryArrays->uvLayers.emplace_back();
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > getPosition()) {
+        FBXNode child = readNode(childScope, geometryArrays);
         if (!child.name.isNull()) {
             node.children.append(child);
         }
     }
 
+    if (hasGeometryArray && node.properties.isEmpty() && node.children.isEmpty()) {
+        // all there was to the node is in the geometry arrays now
+        return FBXNode();
+    }
     return node;
 }
 
+template <class T>
+void BinaryFBXParser::scanArray(char type, GeometryArray target) {
+    const ArrayHeader header = readArrayHeader<T>();
+    if (header.encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        const char* source = skip(header.compressedLength);
+        _compressedArrays.push_back({ type, target, source, header.compressedLength, header.arrayLength });
+    } else {
+        skip(sizeof(T) * header.arrayLength);
+    }
+}
+
+void BinaryFBXParser::scanProperty(GeometryArray array) {
+    char ch = read<char>();
+    switch (ch) {
+        case 'Y':
+            skip(sizeof(qint16));
+            break;
+        case 'C':
+            skip(sizeof(quint8));
+            break;
+        case 'I':
+        case 'F':
+            skip(sizeof(qint32));
+            break;
+        case 'D':
+        case 'L':
+            skip(sizeof(qint64));
+            break;
+        case 'f':
+            scanArray<float>(ch, getTarget(array, ch));
+            break;
+        case 'd':
+            scanArray<double>(ch, getTarget(array, ch));
+            break;
+        case 'l':
+            scanArray<qint64>(ch, getTarget(array, ch));
+            break;
+        case 'i':
+            scanArray<qint32>(ch, getTarget(array, ch));
+            break;
+        case 'b':
+            scanArray<bool>(ch, getTarget(array, ch));
+            break;
+        case 'S':
+        case 'R':
+            skip(read<quint32>());
+            break;
+        default:
+            throw QString("Unknown property type: ") + ch;
+    }
+}
+
+bool BinaryFBXParser::scanNode(GeometryScope scope) {
+    quint64 propertyCount;
+    quint8 nameLength;
+    const quint64 endOffset = readNodeHeader(propertyCount, nameLength);
+    if (endOffset == 0) {
+        return false;
+    }
+    const Name name { skip(nameLength), nameLength };
+    const GeometryArray array = getGeometryArray(scope, name);
+    for (quint64 i = 0; i < propertyCount; i++) {
+        scanProperty(array);
+    }
+    const GeometryScope childScope = getChildScope(scope, name);
+    while (endOffset > getPosition()) {
+        scanNode(childScope);
+    }
+    return true;
+}
+
+void BinaryFBXParser::inflateArrays() {
+    _inflatedArrays.resize(_compressedArrays.size());
+    std::atomic<bool> corrupt { false };
+    tbb::parallel_for((size_t)0, _compressedArrays.size(), [&](size_t i) {
+        const auto& array = _compressedArrays[i];
+        auto& inflated = _inflatedArrays[i];
+        bool inflatedArray = true;
+        switch (array.target) {
+            case GeometryArray::VERTICES:
+            case GeometryArray::NORMALS:
+            case GeometryArray::LAYER_NORMALS:
+                inflatedArray = inflateVectors(array, inflated.vec3s);
+                break;
+            case GeometryArray::LAYER_UVS:
+                inflatedArray = inflateVectors(array, inflated.vec2s);
+                break;
+            case GeometryArray::POLYGON_INDICES:
+            case GeometryArray::INDEXES:
+            case GeometryArray::LAYER_NORMAL_INDICES:
+            case GeometryArray::LAYER_UV_INDICES:
+                inflatedArray = inflateArray(array, inflated.ints);
+                break;
+            default:
+                switch (array.type) {
+                    case 'f':
+                        inflated.values = inflateArray<float>(array);
+                        break;
+                    case 'd':
+                        inflated.values = inflateArray<double>(array);
+                        break;
+                    case 'l':
+                        inflated.values = inflateArray<qint64>(array);
+                        break;
+                    case 'i':
+                        inflated.values = inflateArray<qint32>(array);
+                        break;
+                    default:
+                        inflated.values = inflateArray<bool>(array);
+                        break;
+                }
+                inflatedArray = inflated.values.isValid();
+                break;
+        }
+        if (!inflatedArray) {
+            corrupt = true;
+        }
+    });
+    _compressedArrays.clear();
+    if (corrupt) {
+        throw QString("corrupt fbx file");
+    }
+}
+
+FBXNode BinaryFBXParser::parse() {
+    // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
+    // of the FBX binary format
+
+    // The first 27 bytes contain the header.
+    //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
+    //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
+    //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
+    skip(FBX_HEADER_BYTES_BEFORE_VERSION);
+    quint32 fileVersion = read<quint32>();
+    _has64BitPositions = (fileVersion >= FBX_VERSION_2016);
+    const char* nodesBegin = _cursor;
+
+    // find and inflate the compressed arrays, so the tree only ever holds vectors it owns
+    while (_cursor < _end && scanNode(GeometryScope::NONE)) {
+    }
+    inflateArrays();
+    _cursor = nodesBegin;
+
+    // parse the top-level node
+    FBXNode top;
+    while (_cursor < _end) {
+        FBXNode next = readNode(GeometryScope::NONE, nullptr);
+        if (next.name.isNull()) {
+            break;
+        }
+        top.children.append(next);
+    }
+
+    _inflatedArrays.clear();
+    return top;
+}
+
 class Tokenizer {
 public:
 
@@ -351,7 +869,7 @@ FBXNode parseTextFBXNode(Tokenizer& tokenizer) {
     return node;
 }
 
-FBXNode FBXSerializer::parseFBX(QIODevice* device) {
+FBXNode FBXSerializer::parseFBX(QIODevice* device, bool decodeGeometryArrays) {
     PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, device);
     // verify the prolog
     if (device->peek(FBX_BINARY_PROLOG.size()) != FBX_BINARY_PROLOG) {
@@ -369,37 +887,15 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
         }
         return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-
-    // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
-    // of the FBX binary format
 
-    // The first 27 bytes contain the header.
-    //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
-    //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
-    //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
-    in.skipRawData(FBX_HEADER_BYTES_BEFORE_VERSION);
-    int position = FBX_HEADER_BYTES_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
-    bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
-
-    // parse the top-level node
-    FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
-        if (next.name.isNull()) {
-            return top;
-
-        } else {
-            top.children.append(next);
-        }
+    // the binary parser works on the bytes of the file, which a buffer already holds
+    auto buffer = qobject_cast<QBuffer*>(device);
+    if (buffer) {
+        const auto& data = buffer->data();
+        return BinaryFBXParser(data.constData(), data.size(), decodeGeometryArrays).parse();
     }
-
-    return top;
+    hifi::ByteArray data = device->readAll();
+    return BinaryFBXParser(data.constData(), data.size(), decodeGeometryArrays).parse();
 }
 
 
@@ -408,29 +904,22 @@ glm::vec3 FBXSerializer::getVec3(const QVariantList& properties, int index) {
         properties.at(index + 2).value<double>());
 }
 
+// The vectors are sized up front and filled in place, since the arrays of a large mesh hold millions of values
+
 QVector<glm::vec4> FBXSerializer::createVec4Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec4> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        float w = *it++;
-        values.append(glm::vec4(x, y, z, w));
+    QVector<glm::vec4> values(doubleVector.size() / 4);
+    const double* it = doubleVector.constData();
+    for (glm::vec4* value = values.data(), *end = value + values.size(); value != end; ++value, it += 4) {
+        *value = glm::vec4(it[0], it[1], it[2], it[3]);
     }
     return values;
 }
 
 
 QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& doubleVector, glm::vec4& average) {
-    QVector<glm::vec4> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        float w = *it++;
-        auto val = glm::vec4(x, y, z, w);
-        values.append(val);
-        average += val;
+    QVector<glm::vec4> values = createVec4Vector(doubleVector);
+    for (const auto& value : values) {
+        average += value;
     }
     if (!values.isEmpty()) {
         average *= (1.0f / float(values.size()));
@@ -439,22 +928,19 @@ QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& do
 }
 
 QVector<glm::vec3> FBXSerializer::createVec3Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec3> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
-        float x = *it++;
-        float y = *it++;
-        float z = *it++;
-        values.append(glm::vec3(x, y, z));
+    QVector<glm::vec3> values(doubleVector.size() / 3);
+    const double* it = doubleVector.constData();
+    for (glm::vec3* value = values.data(), *end = value + values.size(); value != end; ++value, it += 3) {
+        *value = glm::vec3(it[0], it[1], it[2]);
     }
     return values;
 }
 
 QVector<glm::vec2> FBXSerializer::createVec2Vector(const QVector<double>& doubleVector) {
-    QVector<glm::vec2> values;
-    for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
-        float s = *it++;
-        float t = *it++;
-        values.append(glm::vec2(s, -t));
+    QVector<glm::vec2> values(doubleVector.size() / 2);
+    const double* it = doubleVector.constData();
+    for (glm::vec2* value = values.data(), *end = value + values.size(); value != end; ++value, it += 2) {
+        *value = glm::vec2(it[0], -it[1]);
     }
     return values;
 }
@@ -12,6 +12,7 @@
 #include "GLTFSerializer.h"
 
 #include <QtCore/QBuffer>
+#include <QtCore/QtEndian>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
 #include <QtCore/qjsondocument.h>
@@ -25,6 +26,7 @@
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkRequest>
 
+#include <type_traits>
 #include <unordered_set>
 #include <map>
 #include <qfile.h>
@@ -38,6 +40,7 @@
 #include <PathUtils.h>
 #include <image/ColorChannel.h>
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
 
 #include "FBXSerializer.h"
 
@@ -191,26 +194,33 @@ bool GLTFSerializer::getObjectArrayVal(const QJsonObject& object,
 }
 
 hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
-    int byte = 4;
-    int jsonStart = data.indexOf("JSON", Qt::CaseSensitive);
-    int binStart = data.indexOf("BIN", Qt::CaseSensitive);
-    int jsonLength, binLength;
-    hifi::ByteArray jsonLengthChunk, binLengthChunk;
-
-    jsonLengthChunk = data.mid(jsonStart - byte, byte);
-    QDataStream tempJsonLen(jsonLengthChunk);
-    tempJsonLen.setByteOrder(QDataStream::LittleEndian);
-    tempJsonLen >> jsonLength;
-    hifi::ByteArray jsonChunk = data.mid(jsonStart + byte, jsonLength);
-
-    if (binStart != -1) {
-        binLengthChunk = data.mid(binStart - byte, byte);
-
-        QDataStream tempBinLen(binLengthChunk);
-        tempBinLen.setByteOrder(QDataStream::LittleEndian);
-        tempBinLen >> binLength;
+    // A .glb is a 12 byte header followed by chunks, each made of a 4 byte length, a 4 byte type and its data
+    const int GLB_HEADER_SIZE = 12;
+    const int GLB_CHUNK_HEADER_SIZE = 8;
+    const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+
+    // The chunks are used where they are in the data rather than copied out of it
+    _glbData = data;
+    _glbBinary = hifi::ByteArray();
+    hifi::ByteArray jsonChunk;
+    int position = GLB_HEADER_SIZE;
+    while (position + GLB_CHUNK_HEADER_SIZE <= _glbData.size()) {
+        quint32 chunkLength = qFromLittleEndian<quint32>(_glbData.constData() + position);
+        quint32 chunkType = qFromLittleEndian<quint32>(_glbData.constData() + position + sizeof(quint32));
+        position += GLB_CHUNK_HEADER_SIZE;
+        if (chunkLength > (quint32)(_glbData.size() - position)) {
+            qWarning(modelformat) << "Truncated glb chunk in model" << _url;
+            break;
+        }
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        auto chunk = hifi::ByteArray::fromRawData(_glbData.constData() + position, (int)chunkLength);
+        if (chunkType == GLB_CHUNK_TYPE_JSON && jsonChunk.isNull()) {
+            jsonChunk = chunk;
+        } else if (chunkType == GLB_CHUNK_TYPE_BIN && _glbBinary.isNull()) {
+            _glbBinary = chunk;
+        }
+        position += chunkLength;
     }
     return jsonChunk;
 }
@@ -425,6 +435,7 @@ bool GLTFSerializer::addBufferView(const QJsonObject& object) {
     getIntVal(object, "buffer", bufferview.buffer, bufferview.defined);
     getIntVal(object, "byteLength", bufferview.byteLength, bufferview.defined);
     getIntVal(object, "byteOffset", bufferview.byteOffset, bufferview.defined);
+    getIntVal(object, "byteStride", bufferview.byteStride, bufferview.defined);
     getIntVal(object, "target", bufferview.target, bufferview.defined);
 
     _file.bufferviews.push_back(bufferview);
@@ -985,6 +996,75 @@ void GLTFFile::normalizeNodeTransforms() {
     }
 }
 
+template <typename V>
+static void appendPacked(QVector<V>& destination, const QVector<float>& source, int stride) {
+    static_assert(sizeof(V) == sizeof(float) * V::length(), "glm vectors should be tightly packed");
+    assert(V::length() == stride);
+    int count = source.size() / stride;
+    int start = destination.size();
+    destination.resize(start + count);
+    memcpy(destination.data() + start, source.constData(), (size_t)count * sizeof(V));
+}
+
+void GLTFSerializer::readPrimitiveArrays(const GLTFMeshPrimitive& primitive, GLTFPrimitiveArrays& arrays) const {
+    if (primitive.indices < 0 || primitive.indices >= _file.accessors.size()) {
+        return;
+    }
+    arrays.hasIndices = addArrayFromAccessor(_file.accessors.at(primitive.indices), arrays.indices);
+    if (!arrays.hasIndices) {
+        return;
+    }
+
+    for (auto it = primitive.attributes.values.cbegin(); it != primitive.attributes.values.cend(); ++it) {
+        int accessorIdx = it.value();
+        if (accessorIdx < 0 || accessorIdx >= _file.accessors.size()) {
+            continue;
+        }
+        const GLTFAccessor& accessor = _file.accessors.at(accessorIdx);
+        const auto vertexAttribute = GLTFVertexAttribute::fromString(it.key());
+        switch (vertexAttribute) {
+            case GLTFVertexAttribute::POSITION:
+                addArrayFromAttribute(vertexAttribute, accessor, arrays.vertices);
+                break;
+
+            case GLTFVertexAttribute::NORMAL:
+                addArrayFromAttribute(vertexAttribute, accessor, arrays.normals);
+                break;
+
+            case GLTFVertexAttribute::TANGENT:
+                addArrayFromAttribute(vertexAttribute, accessor, arrays.tangents);
+                arrays.tangentStride = GLTFAccessorType::count((GLTFAccessorType::Value)accessor.type);
+                break;
+
+            case GLTFVertexAttribute::TEXCOORD_0:
+                addArrayFromAttribute(vertexAttribute, accessor, arrays.texcoords);
+                break;
+
+            case GLTFVertexAttribute::TEXCOORD_1:
+                addArrayFromAttribute(vertexAttribute, accessor, arrays.texcoords2);
+                break;
+
+            case GLTFVertexAttribute::COLOR_0:
+                addArrayFromAttribute(vertexAttribute, accessor, arrays.colors);
+                arrays.colorStride = GLTFAccessorType::count((GLTFAccessorType::Value)accessor.type);
+                break;
+
+            case GLTFVertexAttribute::JOINTS_0:
+                addArrayFromAttribute(vertexAttribute, accessor, arrays.joints);
+                arrays.jointStride = GLTFAccessorType::count((GLTFAccessorType::Value)accessor.type);
+                break;
+
+            case GLTFVertexAttribute::WEIGHTS_0:
+                addArrayFromAttribute(vertexAttribute, accessor, arrays.weights);
+                arrays.weightStride = GLTFAccessorType::count((GLTFAccessorType::Value)accessor.type);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
 bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& url) {
     int numNodes = _file.nodes.size();
     
@@ -1122,6 +1202,25 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
 
 
     int gltfMeshCount = _file.meshes.size();
+
+    // Reading the accessors of a primitive only depends on the file, so all of them are decoded up front and in parallel
+    std::vector<std::vector<GLTFPrimitiveArrays>> arraysPerPrimPerGLTFMesh((size_t)gltfMeshCount);
+    std::vector<std::pair<int, int>> gltfMeshPrims;
+    for (int gltfMeshIndex = 0; gltfMeshIndex < gltfMeshCount; ++gltfMeshIndex) {
+        int primCount = (int)_file.meshes[gltfMeshIndex].primitives.size();
+        arraysPerPrimPerGLTFMesh[gltfMeshIndex].resize((size_t)primCount);
+        for (int primIndex = 0; primIndex < primCount; ++primIndex) {
+            gltfMeshPrims.emplace_back(gltfMeshIndex, primIndex);
+        }
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, gltfMeshPrims.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            int gltfMeshIndex = gltfMeshPrims[i].first;
+            int primIndex = gltfMeshPrims[i].second;
+            readPrimitiveArrays(_file.meshes[gltfMeshIndex].primitives[primIndex], arraysPerPrimPerGLTFMesh[gltfMeshIndex][primIndex]);
+        }
+    });
+
     hfmModel.meshExtents.reset();
     std::vector<std::vector<hfm::Shape>> templateShapePerPrimPerGLTFMesh;
     for (int gltfMeshIndex = 0; gltfMeshIndex < gltfMeshCount; ++gltfMeshIndex) {
@@ -1183,92 +1282,37 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
             templateShape.meshPart = (uint32_t)(mesh.parts.size() - 1);
             templateShape.material = primitive.material;
 
-            int indicesAccessorIdx = primitive.indices;
-
-            GLTFAccessor& indicesAccessor = _file.accessors[indicesAccessorIdx];
+            const GLTFPrimitiveArrays& arrays = arraysPerPrimPerGLTFMesh[gltfMeshIndex][primIndex];
+            if (!arrays.hasIndices) {
+                qWarning(modelformat) << "There was a problem reading glTF INDICES data for model " << _url;
+                continue;
+            }
 
             // Buffers
             constexpr int VERTEX_STRIDE = 3;
             constexpr int NORMAL_STRIDE = 3;
             constexpr int TEX_COORD_STRIDE = 2;
 
-            QVector<int> indices;
-            QVector<float> vertices;
-            QVector<float> normals;
-            QVector<float> tangents;
-            QVector<float> texcoords;
-            QVector<float> texcoords2;
-            QVector<float> colors;
-            QVector<uint16_t> joints;
-            QVector<float> weights;
-
-            static int tangentStride = 4;
-            static int colorStride = 3;
-            static int jointStride = 4;
-            static int weightStride = 4;
-
-            bool success = addArrayFromAccessor(indicesAccessor, indices);
-
-            if (!success) {
-                qWarning(modelformat) << "There was a problem reading glTF INDICES data for model " << _url;
-                continue;
-            }
+            const QVector<int>& indices = arrays.indices;
+            const QVector<float>& vertices = arrays.vertices;
+            const QVector<float>& normals = arrays.normals;
+            const QVector<float>& tangents = arrays.tangents;
+            const QVector<float>& texcoords = arrays.texcoords;
+            const QVector<float>& texcoords2 = arrays.texcoords2;
+            const QVector<float>& colors = arrays.colors;
+            const QVector<uint16_t>& joints = arrays.joints;
+            const QVector<float>& weights = arrays.weights;
+
+            const int tangentStride = arrays.tangentStride;
+            const int colorStride = arrays.colorStride;
+            const int jointStride = arrays.jointStride;
+            const int weightStride = arrays.weightStride;
 
             // Increment the triangle indices by the current mesh vertex count so each mesh part can all reference the same buffers within the mesh
             int prevMeshVerticesCount = mesh.vertices.count();
             QVector<uint16_t> clusterJoints;
             QVector<float> clusterWeights;
 
-            for(auto &key : keys) {
-                int accessorIdx = primitive.attributes.values[key];
-                GLTFAccessor& accessor = _file.accessors[accessorIdx];
-                const auto vertexAttribute = GLTFVertexAttribute::fromString(key);
-                switch (vertexAttribute) {
-                    case GLTFVertexAttribute::POSITION:
-                        success = addArrayFromAttribute(vertexAttribute, accessor, vertices);
-                        break;
-
-                    case GLTFVertexAttribute::NORMAL:
-                        success = addArrayFromAttribute(vertexAttribute, accessor, normals);
-                        break;
-
-                    case GLTFVertexAttribute::TANGENT:
-                        success = addArrayFromAttribute(vertexAttribute, accessor, tangents);
-                        tangentStride = GLTFAccessorType::count((GLTFAccessorType::Value)accessor.type);
-                        break;
-
-                    case GLTFVertexAttribute::TEXCOORD_0:
-                        success = addArrayFromAttribute(vertexAttribute, accessor, texcoords);
-                        break;
-
-                    case GLTFVertexAttribute::TEXCOORD_1:
-                        success = addArrayFromAttribute(vertexAttribute, accessor, texcoords2);
-                        break;
-
-                    case GLTFVertexAttribute::COLOR_0:
-                        success = addArrayFromAttribute(vertexAttribute, accessor, colors);
-                        colorStride = GLTFAccessorType::count((GLTFAccessorType::Value)accessor.type);
-                        break;
-
-                    case GLTFVertexAttribute::JOINTS_0:
-                        success = addArrayFromAttribute(vertexAttribute, accessor, joints);
-                        jointStride = GLTFAccessorType::count((GLTFAccessorType::Value)accessor.type);
-                        break;
-
-                    case GLTFVertexAttribute::WEIGHTS_0:
-                        success = addArrayFromAttribute(vertexAttribute, accessor, weights);
-                        weightStride = GLTFAccessorType::count((GLTFAccessorType::Value)accessor.type);
-                        break;
-
-                    default:
-                        success = false;
-                        break;
-                }
-                if (!success) {
-                    continue;
-                }
-            }
-
             // Validation stage
             if (indices.count() == 0) {
                 qWarning(modelformat) << "Missing indices for model " << _url;
@@ -1281,10 +1325,10 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
 
             int partVerticesCount = vertices.size() / 3;
 
-            QVector<int> validatedIndices;
+            QVector<int> validatedIndices(indices.count());
             for (int n = 0; n < indices.count(); ++n) {
                 if (indices[n] < partVerticesCount) {
-                    validatedIndices.push_back(indices[n] + prevMeshVerticesCount);
+                    validatedIndices[n] = indices[n] + prevMeshVerticesCount;
                 } else {
                     validatedIndices = QVector<int>();
                     break;
@@ -1298,15 +1342,9 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
 
             part.triangleIndices.append(validatedIndices);
 
-            mesh.vertices.reserve(mesh.vertices.size() + partVerticesCount);
-            for (int n = 0; n < vertices.size(); n = n + VERTEX_STRIDE) {
-                mesh.vertices.push_back(glm::vec3(vertices[n], vertices[n + 1], vertices[n + 2]));
-            }
-
-            mesh.normals.reserve(mesh.normals.size() + partVerticesCount);
-            for (int n = 0; n < normals.size(); n = n + NORMAL_STRIDE) {
-                mesh.normals.push_back(glm::vec3(normals[n], normals[n + 1], normals[n + 2]));
-            }
+            // glm vectors are tightly packed floats, so the arrays are copied as they are
+            appendPacked(mesh.vertices, vertices, VERTEX_STRIDE);
+            appendPacked(mesh.normals, normals, NORMAL_STRIDE);
 
             if (tangents.size() == partVerticesCount * tangentStride) {
                 mesh.tangents.reserve(mesh.tangents.size() + partVerticesCount);
@@ -1317,19 +1355,13 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
             }
 
             if (texcoords.size() == partVerticesCount * TEX_COORD_STRIDE) {
-                mesh.texCoords.reserve(mesh.texCoords.size() + partVerticesCount);
-                for (int n = 0; n < texcoords.size(); n = n + 2) {
-                    mesh.texCoords.push_back(glm::vec2(texcoords[n], texcoords[n + 1]));
-                }
+                appendPacked(mesh.texCoords, texcoords, TEX_COORD_STRIDE);
             } else if (primitiveAttributes.contains("TEXCOORD_0")) {
                 mesh.texCoords.resize(mesh.texCoords.size() + partVerticesCount);
             }
 
             if (texcoords2.size() == partVerticesCount * TEX_COORD_STRIDE) {
-                mesh.texCoords1.reserve(mesh.texCoords1.size() + partVerticesCount);
-                for (int n = 0; n < texcoords2.size(); n = n + 2) {
-                    mesh.texCoords1.push_back(glm::vec2(texcoords2[n], texcoords2[n + 1]));
-                }
+                appendPacked(mesh.texCoords1, texcoords2, TEX_COORD_STRIDE);
             } else if (primitiveAttributes.contains("TEXCOORD_1")) {
                 mesh.texCoords1.resize(mesh.texCoords1.size() + partVerticesCount);
             }
@@ -1774,13 +1806,8 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& hfmMat, const GLTFMaterial& mat
 }
 
 template <typename T, typename L>
-bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count, QVector<L>& outarray, int accessorType) {
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
+bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count, QVector<L>& outarray,
+                               int accessorType) const {
     int bufferCount = 0;
     switch (accessorType) {
         case GLTFAccessorType::SCALAR:
@@ -1806,48 +1833,61 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
             break;
         default:
             qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-            blobstream.setDevice(nullptr);
             return false;
     }
-    for (int i = 0; i < count; ++i) {
-        for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
+    if (count <= 0) {
+        return true;
+    }
+
+    // Interleaved vertex data has a stride larger than its elements
+    const int elementSize = bufferCount * (int)sizeof(T);
+    const int stride = byteStride > 0 ? byteStride : elementSize;
+    if (byteOffset < 0 || stride < elementSize || (qint64)byteOffset + (qint64)stride * (count - 1) + elementSize > bin.size()) {
+        return false;
+    }
+
+    const char* source = bin.constData() + byteOffset;
+    const int start = outarray.size();
+    outarray.resize(start + count * bufferCount);
+    L* destination = outarray.data() + start;
+    if (std::is_same<T, L>::value && stride == elementSize) {
+        // The data is already laid out the way it is read, so it is copied in one go (glTF is little endian, as are we)
+        memcpy(destination, source, (size_t)count * elementSize);
+    } else {
+        for (int i = 0; i < count; ++i, source += stride) {
+            for (int j = 0; j < bufferCount; ++j) {
                 T value;
-                blobstream >> value;
-                outarray.push_back(value);
-            } else {
-                blobstream.setDevice(nullptr);
-                return false;
+                memcpy(&value, source + j * sizeof(T), sizeof(T));
+                *destination++ = (L)value;
             }
         }
     }
-
-    blobstream.setDevice(nullptr);
     return true;
 }
 template <typename T>
 bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin,
                                     int byteOffset,
+                                    int byteStride,
                                     int count,
                                     QVector<T>& outarray,
                                     int accessorType,
-                                    int componentType) {
+                                    int componentType) const {
     switch (componentType) {
         case GLTFAccessorComponentType::BYTE: {}
         case GLTFAccessorComponentType::UNSIGNED_BYTE: {
-            return readArray<uchar>(bin, byteOffset, count, outarray, accessorType);
+            return readArray<uchar>(bin, byteOffset, byteStride, count, outarray, accessorType);
         }
         case GLTFAccessorComponentType::SHORT: {
-            return readArray<short>(bin, byteOffset, count, outarray, accessorType);
+            return readArray<short>(bin, byteOffset, byteStride, count, outarray, accessorType);
         }
         case GLTFAccessorComponentType::UNSIGNED_INT: {
-            return readArray<uint>(bin, byteOffset, count, outarray, accessorType);
+            return readArray<uint>(bin, byteOffset, byteStride, count, outarray, accessorType);
         }
         case GLTFAccessorComponentType::UNSIGNED_SHORT: {
-            return readArray<ushort>(bin, byteOffset, count, outarray, accessorType);
+            return readArray<ushort>(bin, byteOffset, byteStride, count, outarray, accessorType);
         }
         case GLTFAccessorComponentType::FLOAT: {
-            return readArray<float>(bin, byteOffset, count, outarray, accessorType);
+            return readArray<float>(bin, byteOffset, byteStride, count, outarray, accessorType);
         }
     }
     return false;
@@ -1855,7 +1895,8 @@ bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin,
 
 
 template <typename T>
-bool GLTFSerializer::addArrayFromAttribute(GLTFVertexAttribute::Value vertexAttribute, GLTFAccessor& accessor, QVector<T>& outarray) {
+bool GLTFSerializer::addArrayFromAttribute(GLTFVertexAttribute::Value vertexAttribute, const GLTFAccessor& accessor,
+                                           QVector<T>& outarray) const {
     switch (vertexAttribute) {
     case GLTFVertexAttribute::POSITION:
         if (accessor.type != GLTFAccessorType::VEC3) {
@@ -1962,46 +2003,43 @@ bool GLTFSerializer::addArrayFromAttribute(GLTFVertexAttribute::Value vertexAttr
 }
 
 template <typename T>
-bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& outarray) {
+bool GLTFSerializer::addArrayFromAccessor(const GLTFAccessor& accessor, QVector<T>& outarray) const {
     bool success = true;
 
-    if (accessor.defined["bufferView"]) {
-        GLTFBufferView& bufferview = _file.bufferviews[accessor.bufferView];
-        GLTFBuffer& buffer = _file.buffers[bufferview.buffer];
+    if (accessor.defined.value("bufferView")) {
+        const GLTFBufferView& bufferview = _file.bufferviews.at(accessor.bufferView);
+        const GLTFBuffer& buffer = _file.buffers.at(bufferview.buffer);
 
-        int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
+        int accBoffset = accessor.defined.value("byteOffset") ? accessor.byteOffset : 0;
 
-        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, accessor.count, outarray, accessor.type,
-                                 accessor.componentType);
+        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, bufferview.byteStride, accessor.count, outarray,
+                                 accessor.type, accessor.componentType);
     } else {
-        for (int i = 0; i < accessor.count; ++i) {
-            T value;
-            memset(&value, 0, sizeof(T));  // Make sure the dummy array is initalised to zero.
-            outarray.push_back(value);
-        }
+        // Make sure the dummy array is initalised to zero.
+        outarray.resize(outarray.size() + accessor.count);
     }
 
     if (success) {
-        if (accessor.defined["sparse"]) {
+        if (accessor.defined.value("sparse")) {
             QVector<int> out_sparse_indices_array;
 
-            GLTFBufferView& sparseIndicesBufferview = _file.bufferviews[accessor.sparse.indices.bufferView];
-            GLTFBuffer& sparseIndicesBuffer = _file.buffers[sparseIndicesBufferview.buffer];
+            const GLTFBufferView& sparseIndicesBufferview = _file.bufferviews.at(accessor.sparse.indices.bufferView);
+            const GLTFBuffer& sparseIndicesBuffer = _file.buffers.at(sparseIndicesBufferview.buffer);
 
-            int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
+            int accSIBoffset = accessor.sparse.indices.defined.value("byteOffset") ? accessor.sparse.indices.byteOffset : 0;
 
-            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset,
+            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset, 0,
                                      accessor.sparse.count, out_sparse_indices_array, GLTFAccessorType::SCALAR,
                                      accessor.sparse.indices.componentType);
             if (success) {
                 QVector<T> out_sparse_values_array;
 
-                GLTFBufferView& sparseValuesBufferview = _file.bufferviews[accessor.sparse.values.bufferView];
-                GLTFBuffer& sparseValuesBuffer = _file.buffers[sparseValuesBufferview.buffer];
+                const GLTFBufferView& sparseValuesBufferview = _file.bufferviews.at(accessor.sparse.values.bufferView);
+                const GLTFBuffer& sparseValuesBuffer = _file.buffers.at(sparseValuesBufferview.buffer);
 
-                int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
+                int accSVBoffset = accessor.sparse.values.defined.value("byteOffset") ? accessor.sparse.values.byteOffset : 0;
 
-                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset,
+                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset, 0,
                                          accessor.sparse.count, out_sparse_values_array, accessor.type, accessor.componentType);
 
                 if (success) {
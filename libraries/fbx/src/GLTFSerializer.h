@@ -208,6 +208,7 @@ struct GLTFBufferView {
     int buffer; //required
     int byteLength; //required
     int byteOffset { 0 };
+    int byteStride { 0 }; // 0 when the elements are tightly packed
     int target;
     QMap<QString, bool> defined;
     void dump() {
@@ -220,6 +221,9 @@ struct GLTFBufferView {
         if (defined["byteOffset"]) {
             qCDebug(modelformat) << "byteOffset: " << byteOffset;
         }
+        if (defined["byteStride"]) {
+            qCDebug(modelformat) << "byteStride: " << byteStride;
+        }
         if (defined["target"]) {
             qCDebug(modelformat) << "target: " << target;
         }
@@ -810,6 +814,24 @@ private:
     void reorderNodes(const std::unordered_map<int, int>& reorderMap);
 };
 
+// The vertex data of a mesh primitive, read from its accessors
+struct GLTFPrimitiveArrays {
+    bool hasIndices { false };
+    QVector<int> indices;
+    QVector<float> vertices;
+    QVector<float> normals;
+    QVector<float> tangents;
+    QVector<float> texcoords;
+    QVector<float> texcoords2;
+    QVector<float> colors;
+    QVector<uint16_t> joints;
+    QVector<float> weights;
+    int tangentStride { 4 };
+    int colorStride { 3 };
+    int jointStride { 4 };
+    int weightStride { 4 };
+};
+
 class GLTFSerializer : public QObject, public HFMSerializer {
     Q_OBJECT
 public:
@@ -820,6 +842,7 @@ public:
 private:
     GLTFFile _file;
     hifi::URL _url;
+    hifi::ByteArray _glbData; // Keeps the data of a .glb alive, since _glbBinary points into it
     hifi::ByteArray _glbBinary;
 
     const glm::mat4& getModelTransform(const GLTFNode& node);
@@ -881,18 +904,21 @@ private:
     bool readBinary(const QString& url, hifi::ByteArray& outdata);
 
     template<typename T, typename L>
-    bool readArray(const hifi::ByteArray& bin, int byteOffset, int count,
-                   QVector<L>& outarray, int accessorType);
+    bool readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
+                   QVector<L>& outarray, int accessorType) const;
 
     template<typename T>
-    bool addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
-                        QVector<T>& outarray, int accessorType, int componentType);
+    bool addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
+                        QVector<T>& outarray, int accessorType, int componentType) const;
 
+    // These only read the parsed file, so the accessors of different primitives can be read concurrently
     template <typename T>
-    bool addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& outarray);
+    bool addArrayFromAccessor(const GLTFAccessor& accessor, QVector<T>& outarray) const;
 
     template <typename T>
-    bool addArrayFromAttribute(GLTFVertexAttribute::Value vertexAttribute, GLTFAccessor& accessor, QVector<T>& outarray);
+    bool addArrayFromAttribute(GLTFVertexAttribute::Value vertexAttribute, const GLTFAccessor& accessor, QVector<T>& outarray) const;
+
+    void readPrimitiveArrays(const GLTFMeshPrimitive& primitive, GLTFPrimitiveArrays& arrays) const;
 
     void retriangulate(const QVector<int>& in_indices, const QVector<glm::vec3>& in_vertices, 
                        const QVector<glm::vec3>& in_normals, QVector<int>& out_indices, 
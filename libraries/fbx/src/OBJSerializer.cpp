@@ -15,7 +15,9 @@
 #include "OBJSerializer.h"
 
 #include <ctype.h>  // .obj files are not locale-specific. The C/ASCII charset applies.
-#include <sstream> 
+#include <algorithm>
+#include <cstring>
+#include <sstream>
 
 #include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
@@ -26,6 +28,7 @@
 #include <shared/NsightHelpers.h>
 #include <NetworkAccessManager.h>
 #include <ResourceManager.h>
+#include <TBBHelpers.h>
 
 #include "FBXSerializer.h"
 #include <hfm/ModelFormatLogging.h>
@@ -41,6 +44,8 @@ const float ILLUMINATION_MODEL_APPLY_SHININESS = 0.5f;
 const float ILLUMINATION_MODEL_APPLY_ROUGHNESS = 1.0f;
 const float ILLUMINATION_MODEL_APPLY_NON_METALLIC = 0.0f;
 
+bool OBJSerializer::_parallelTokenizingEnabled { true };
+
 namespace {
 template<class T>
 T& checked_at(QVector<T>& vector, int i) {
@@ -49,17 +54,360 @@ T& checked_at(QVector<T>& vector, int i) {
     }
     return vector[i];
 }
+
+// Tokenizing ahead reads the file in chunks that end on a line, a window of them at a time
+const size_t TOKENIZER_CHUNK_SIZE = 256 * 1024;
+const int TOKENIZER_CHUNKS_PER_THREAD = 2;
+
+// What QChar::isSpace() answers for the Latin-1 characters the tokenizer reads the file as
+inline bool isOBJSpace(uchar ch) {
+    return ch == ' ' || (ch >= '\t' && ch <= '\r') || ch == 0x85 || ch == 0xa0;
+}
+
+inline bool isDigit(char ch) {
+    return (uchar)(ch - '0') < 10;
+}
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+// Checks and converts eight ASCII digits at once, within a 64 bit register
+inline bool isEightDigits(uint64_t chars) {
+    return !(((chars + 0x4646464646464646ULL) | (chars - 0x3030303030303030ULL)) & 0x8080808080808080ULL);
+}
+
+inline uint32_t parseEightDigits(uint64_t chars) {
+    const uint64_t MASK = 0x000000FF000000FFULL;
+    const uint64_t MUL1 = 0x000F424000000064ULL; // 100 + (1000000 << 32)
+    const uint64_t MUL2 = 0x0000271000000001ULL; // 1 + (10000 << 32)
+    chars -= 0x3030303030303030ULL;
+    chars = (chars * 10) + (chars >> 8);
+    return (uint32_t)((((chars & MASK) * MUL1) + (((chars >> 16) & MASK) * MUL2)) >> 32);
+}
+#endif
+
+const char* parseDigits(const char* p, const char* end, uint64_t& mantissa, int& digits) {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    while (end - p >= 8) {
+        uint64_t chars;
+        memcpy(&chars, p, sizeof(chars));
+        if (!isEightDigits(chars)) {
+            break;
+        }
+        mantissa = mantissa * 100000000 + parseEightDigits(chars);
+        digits += 8;
+        p += 8;
+    }
+#endif
+    for (; p < end && isDigit(*p); ++p) {
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        ++digits;
+    }
+    return p;
+}
+
+const double EXACT_POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+const int MAX_EXACT_POWER_OF_TEN = 22;
+const int MAX_MANTISSA_DIGITS = 19;
+const uint64_t MAX_EXACT_MANTISSA = 1ULL << 53;
+
+// Reads a plain decimal number, [-]digits[.digits][(e|E)[+|-]digits], to the same float as std::stof() does.
+// Only answers true where that can be done exactly and quickly: when the mantissa and power of ten are both exact
+// in a double the quotient or product is correctly rounded (Clinger's fast path), and rounding it on to a float
+// gives the same float unless the double lands exactly half way between two floats.
+bool parseFloat(const char* p, const char* end, float& result) {
+    bool isNegative = (p < end && *p == '-');
+    if (isNegative) {
+        ++p;
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;
+    const char* integerBegin = p;
+    p = parseDigits(p, end, mantissa, digits);
+    if (p == integerBegin) {
+        return false;
+    }
+    int exponent = 0;
+    if (p < end && *p == '.') {
+        const char* fractionBegin = ++p;
+        p = parseDigits(p, end, mantissa, digits);
+        if (p == fractionBegin) {
+            return false;
+        }
+        exponent = -(int)(p - fractionBegin);
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool isExponentNegative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            isExponentNegative = (*p == '-');
+            ++p;
+        }
+        const int MAX_EXPONENT_DIGITS = 4;
+        const char* exponentBegin = p;
+        int explicitExponent = 0;
+        for (; p < end && isDigit(*p); ++p) {
+            if (p - exponentBegin == MAX_EXPONENT_DIGITS) {
+                return false;
+            }
+            explicitExponent = explicitExponent * 10 + (*p - '0');
+        }
+        if (p == exponentBegin) {
+            return false;
+        }
+        exponent += isExponentNegative ? -explicitExponent : explicitExponent;
+    }
+    if (p != end || digits > MAX_MANTISSA_DIGITS || mantissa > MAX_EXACT_MANTISSA ||
+        exponent < -MAX_EXACT_POWER_OF_TEN || exponent > MAX_EXACT_POWER_OF_TEN) {
+        return false;
+    }
+
+    double value = (double)mantissa;
+    value = (exponent < 0) ? value / EXACT_POWERS_OF_TEN[-exponent] : value * EXACT_POWERS_OF_TEN[exponent];
+
+    // A double has 29 more mantissa bits than a float, the values in range here are all normal floats
+    const uint64_t DOUBLE_BITS_BELOW_FLOAT = (1ULL << 29) - 1;
+    const uint64_t HALF_WAY_BETWEEN_FLOATS = 1ULL << 28;
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if ((bits & DOUBLE_BITS_BELOW_FLOAT) == HALF_WAY_BETWEEN_FLOATS) {
+        return false;
+    }
+    result = isNegative ? -(float)value : (float)value;
+    return true;
+}
+
+// Reads a face vertex, "v", "v/vt", "v/vt/vn" or "v//vn", where each index is up to 9 digits with an optional minus sign
+bool parseFaceVertex(const char* p, const char* end, OBJTokenizer::FaceVertex& faceVertex) {
+    const int MAX_INDEX_DIGITS = 9;
+    const int MAX_PARTS = 3;
+    faceVertex.partCount = 0;
+    while (true) {
+        if (faceVertex.partCount == MAX_PARTS) {
+            return false;
+        }
+        int part = faceVertex.partCount++;
+        bool isNegative = (p < end && *p == '-');
+        if (isNegative) {
+            ++p;
+        }
+        const char* digitsBegin = p;
+        int index = 0;
+        for (; p < end && isDigit(*p); ++p) {
+            if (p - digitsBegin == MAX_INDEX_DIGITS) {
+                return false;
+            }
+            index = index * 10 + (*p - '0');
+        }
+        if (p == digitsBegin) {
+            if (isNegative || part == 0) {
+                return false;
+            }
+            faceVertex.hasIndex[part] = false;
+            faceVertex.indices[part] = 0;
+        } else {
+            faceVertex.hasIndex[part] = true;
+            faceVertex.indices[part] = isNegative ? -index : index;
+        }
+        if (p == end) {
+            break;
+        }
+        if (*p != '/') {
+            return false;
+        }
+        ++p;
+    }
+    for (int part = faceVertex.partCount; part < MAX_PARTS; ++part) {
+        faceVertex.hasIndex[part] = false;
+        faceVertex.indices[part] = 0;
+    }
+    return true;
+}
+
+// Splits a chunk into tokens the way OBJTokenizer::nextToken() reads them from a device, and parses the numbers in them
+void tokenizeChunk(const char* data, OBJTokenizer::Chunk& chunk) {
+    chunk.tokens.clear();
+    chunk.faceVertices.clear();
+
+    const char* p = data + chunk.begin;
+    const char* end = data + chunk.end;
+    bool isLineStart = true;
+    bool isFaceLine = false;
+    while (p < end) {
+        uchar ch = (uchar)*p;
+        if (ch == '\n') {
+            isLineStart = true;
+            isFaceLine = false;
+            ++p;
+            continue;
+        }
+        if (isOBJSpace(ch)) {
+            ++p;
+            continue;
+        }
+
+        OBJTokenizer::Token token;
+        token.isFirstOnLine = isLineStart;
+        token.kind = OBJTokenizer::DatumKind::UNKNOWN;
+        token.faceVertex = 0;
+        if (ch == '#') {
+            // The comment runs to the end of the line, newline included, as QIODevice::readLine() reads it
+            const char* commentBegin = p + 1;
+            const char* newline = (const char*)memchr(commentBegin, '\n', end - commentBegin);
+            p = newline ? newline + 1 : end;
+            token.isComment = true;
+            token.offset = (uint32_t)(commentBegin - data);
+            token.length = (uint32_t)(p - commentBegin);
+            chunk.tokens.push_back(token);
+            isLineStart = true;
+            isFaceLine = false;
+            continue;
+        }
+
+        const char* datumBegin = p;
+        while (p < end && !isOBJSpace((uchar)*p)) {
+            ++p;
+        }
+        token.isComment = false;
+        token.offset = (uint32_t)(datumBegin - data);
+        token.length = (uint32_t)(p - datumBegin);
+
+        OBJTokenizer::FaceVertex faceVertex;
+        if (isLineStart) {
+            isFaceLine = (token.length == 1 && ch == 'f');
+        }
+        if (isFaceLine && !isLineStart && parseFaceVertex(datumBegin, p, faceVertex)) {
+            token.kind = OBJTokenizer::DatumKind::FACE_VERTEX;
+            token.faceVertex = (uint32_t)chunk.faceVertices.size();
+            chunk.faceVertices.push_back(faceVertex);
+        } else if (parseFloat(datumBegin, p, token.value)) {
+            token.kind = OBJTokenizer::DatumKind::FLOAT;
+        } else if (isalpha(ch) && ch != 'i' && ch != 'I' && ch != 'n' && ch != 'N') {
+            // Keywords can't be numbers, unlike the likes of "inf" and "nan"
+            token.kind = OBJTokenizer::DatumKind::NOT_FLOAT;
+        }
+        chunk.tokens.push_back(token);
+        isLineStart = false;
+    }
+}
 }
 
 OBJTokenizer::OBJTokenizer(QIODevice* device) : _device(device), _pushedBackToken(-1) {
 }
 
+OBJTokenizer::OBJTokenizer(const hifi::ByteArray& data) :
+    _pushedBackToken(-1),
+    _data(data.constData()),
+    _size((size_t)data.size()) {
+}
+
+bool OBJTokenizer::canTokenizeAhead(const hifi::ByteArray& data) {
+    // Quoted datums run across lines, so lines can't be tokenized on their own
+    return !data.contains('\"');
+}
+
+void OBJTokenizer::tokenizeWindow() {
+    const size_t maxChunks = (size_t)(TOKENIZER_CHUNKS_PER_THREAD * tbb::this_task_arena::max_concurrency());
+    size_t begin = _windowEnd;
+    size_t numChunks = 0;
+    while (numChunks < maxChunks && begin < _size) {
+        size_t end = std::min(begin + TOKENIZER_CHUNK_SIZE, _size);
+        if (end < _size) {
+            const char* newline = (const char*)memchr(_data + end, '\n', _size - end);
+            end = newline ? (size_t)(newline - _data) + 1 : _size;
+        }
+        if (numChunks == _window.size()) {
+            _window.emplace_back();
+        }
+        _window[numChunks].begin = begin;
+        _window[numChunks].end = end;
+        ++numChunks;
+        begin = end;
+    }
+    _window.resize(numChunks);
+    _windowEnd = begin;
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            tokenizeChunk(_data, _window[i]);
+        }
+    });
+    _chunkIndex = 0;
+    _tokenIndex = 0;
+}
+
+const OBJTokenizer::Token* OBJTokenizer::peekAheadToken() {
+    while (_chunkIndex >= _window.size() || _tokenIndex >= _window[_chunkIndex].tokens.size()) {
+        if (_chunkIndex < _window.size()) {
+            ++_chunkIndex;
+            _tokenIndex = 0;
+        } else if (_windowEnd < _size) {
+            tokenizeWindow();
+        } else {
+            return nullptr;
+        }
+    }
+    return &_window[_chunkIndex].tokens[_tokenIndex];
+}
+
+const OBJTokenizer::Token* OBJTokenizer::nextAheadToken() {
+    const Token* token = peekAheadToken();
+    if (token) {
+        ++_tokenIndex;
+    }
+    return token;
+}
+
+const hifi::ByteArray& OBJTokenizer::getDatum() const {
+    if (!_isDatumCurrent) {
+        // Keywords repeat from line to line, so most of the time the datum is already there
+        const char* datum = _data + _token.offset;
+        if (_datum.size() != (int)_token.length || memcmp(_datum.constData(), datum, _token.length) != 0) {
+            _datum = hifi::ByteArray(datum, (int)_token.length);
+        }
+        _isDatumCurrent = true;
+    }
+    return _datum;
+}
+
+const QString OBJTokenizer::getComment() const {
+    if (_device) {
+        return _comment;
+    }
+    return QString(hifi::ByteArray(_data + _commentToken.offset, (int)_commentToken.length));
+}
+
+bool OBJTokenizer::getFaceVertex(FaceVertex& faceVertex) const {
+    if (_token.kind != DatumKind::FACE_VERTEX) {
+        return false;
+    }
+    faceVertex = _faceVertex;
+    return true;
+}
+
+void OBJTokenizer::skipLine() {
+    if (_device) {
+        _device->readLine();
+        return;
+    }
+    // The rest of the line is the tokens up to the next one that starts a line
+    const Token* token;
+    while ((token = peekAheadToken()) && !token->isFirstOnLine) {
+        ++_tokenIndex;
+    }
+}
+
 const hifi::ByteArray OBJTokenizer::getLineAsDatum() {
     return _device->readLine().trimmed();
 }
 
 float OBJTokenizer::getFloat() {
-    return std::stof((nextToken() != OBJTokenizer::DATUM_TOKEN) ? nullptr : getDatum().data());
+    bool isDatum = (nextToken() == OBJTokenizer::DATUM_TOKEN);
+    if (isDatum && _token.kind == DatumKind::FLOAT) {
+        return _token.value;
+    }
+    return std::stof(isDatum ? getDatum().data() : nullptr);
 }
 
 int OBJTokenizer::nextToken(bool allowSpaceChar /*= false*/) {
@@ -69,6 +417,39 @@ int OBJTokenizer::nextToken(bool allowSpaceChar /*= false*/) {
         return token;
     }
 
+    if (!_device) {
+        const Token* token = nextAheadToken();
+        if (!token) {
+            return NO_TOKEN;
+        }
+        if (token->isComment) {
+            _commentToken = *token;
+            _token = Token {};
+            _isDatumCurrent = false;
+            return COMMENT_TOKEN;
+        }
+
+        _token = *token;
+        if (_token.kind == DatumKind::FACE_VERTEX) {
+            _faceVertex = _window[_chunkIndex].faceVertices[_token.faceVertex];
+        }
+        if (allowSpaceChar) {
+            // Read on through spaces, but not other white space, and take in the tokens that were split on them
+            size_t end = _token.offset + _token.length;
+            while (end < _size && (!isOBJSpace((uchar)_data[end]) || _data[end] == ' ')) {
+                ++end;
+            }
+            _token.length = (uint32_t)(end - _token.offset);
+            _token.kind = DatumKind::UNKNOWN;
+            const Token* next;
+            while ((next = peekAheadToken()) && next->offset < end) {
+                ++_tokenIndex;
+            }
+        }
+        _isDatumCurrent = false;
+        return DATUM_TOKEN;
+    }
+
     char ch;
     while (_device->getChar(&ch)) {
         if (QChar(ch).isSpace()) {
@@ -117,10 +498,14 @@ bool OBJTokenizer::isNextTokenFloat() {
     if (nextToken() != OBJTokenizer::DATUM_TOKEN) {
         return false;
     }
-    hifi::ByteArray token = getDatum();
     pushBackToken(OBJTokenizer::DATUM_TOKEN);
+    if (_token.kind == DatumKind::FLOAT) {
+        return true;
+    } else if (_token.kind == DatumKind::NOT_FLOAT) {
+        return false;
+    }
     bool ok;
-    token.toFloat(&ok);
+    getDatum().toFloat(&ok);
     return ok;
 }
 
@@ -204,32 +589,73 @@ bool OBJFace::add(const hifi::ByteArray& vertexIndex, const hifi::ByteArray& tex
     return true;
 }
 
-QVector<OBJFace> OBJFace::triangulate() {
-    QVector<OBJFace> newFaces;
-    const int nVerticesInATriangle = 3;
-    if (vertexIndices.count() == nVerticesInATriangle) {
-        newFaces.append(*this);
-    } else {
-        for (int i = 1; i < vertexIndices.count() - 1; i++) {
-            OBJFace newFace;
-            newFace.addFrom(this, 0);
-            newFace.addFrom(this, i);
-            newFace.addFrom(this, i + 1);
-            newFace.groupName = groupName;
-            newFace.materialName = materialName;
-            newFaces.append(newFace);
+void OBJFace::add(const OBJTokenizer::FaceVertex& faceVertex, int vertexCount, int textureUVCount, int normalCount) {
+    // Negative indices count back from the last one read, as the string version does
+    const int counts[] = { vertexCount, textureUVCount, normalCount };
+    int indices[3];
+    for (int i = 0; i < faceVertex.partCount; ++i) {
+        indices[i] = faceVertex.indices[i];
+        if (faceVertex.hasIndex[i] && indices[i] < 0) {
+            indices[i] = counts[i] + indices[i] + 1;
+        }
+    }
+    vertexIndices.append(indices[0] - 1);
+    if (faceVertex.partCount > 1 && faceVertex.hasIndex[1]) {
+        int index = indices[1];
+        if (index < 0) { // Count backwards from the last one added.
+            index = vertexCount + 1 + index;
         }
+        textureUVIndices.append(index - 1);
+    }
+    if (faceVertex.partCount > 2 && faceVertex.hasIndex[2]) {
+        normalIndices.append(indices[2] - 1);
     }
-    return newFaces;
 }
 
-void OBJFace::addFrom(const OBJFace* face, int index) { // add using data from f at index i
-    vertexIndices.append(face->vertexIndices[index]);
-    if (face->textureUVIndices.count() > 0) { // Any at all. Runtime error if not consistent.
-        textureUVIndices.append(face->textureUVIndices[index]);
+void OBJFace::clear() {
+    vertexIndices.clear();
+    textureUVIndices.clear();
+    normalIndices.clear();
+    groupName.clear();
+    materialName.clear();
+}
+
+void OBJFace::triangulate(OBJFaceGroup& group) const {
+    const int nVerticesInATriangle = 3;
+    const int count = vertexIndices.count();
+    if (count < nVerticesInATriangle) {
+        return;
+    }
+    if (group.materialNames.isEmpty() || group.materialNames.back() != materialName) {
+        group.materialNames.push_back(materialName);
     }
-    if (face->normalIndices.count() > 0) {
-        normalIndices.append(face->normalIndices[index]);
+    const int material = group.materialNames.size() - 1;
+    const bool hasTextureUVs = textureUVIndices.count() > 0; // Any at all. Runtime error if not consistent.
+    const bool hasNormals = normalIndices.count() > 0;
+
+    auto indexAt = [](const QVector<int>& indices, int i) {
+        return (i < indices.count()) ? indices[i] : -1;
+    };
+    auto addTriangle = [&](int a, int b, int c) {
+        const int corners[] = { a, b, c };
+        OBJFaceGroup::Triangle triangle;
+        for (int i = 0; i < nVerticesInATriangle; ++i) {
+            triangle.vertexIndices[i] = vertexIndices[corners[i]];
+            triangle.textureUVIndices[i] = hasTextureUVs ? indexAt(textureUVIndices, corners[i]) : -1;
+            triangle.normalIndices[i] = hasNormals ? indexAt(normalIndices, corners[i]) : -1;
+        }
+        triangle.hasTextureUVs = hasTextureUVs;
+        triangle.hasNormals = hasNormals;
+        triangle.material = material;
+        group.triangles.push_back(triangle);
+    };
+
+    if (count == nVerticesInATriangle) {
+        addTriangle(0, 1, 2);
+    } else {
+        for (int i = 1; i < count - 1; i++) {
+            addTriangle(0, i, i + 1);
+        }
     }
 }
 
@@ -486,6 +912,7 @@ QNetworkReply* request(hifi::URL& url, bool isTest) {
 bool OBJSerializer::parseOBJGroup(OBJTokenizer& tokenizer, const hifi::VariantHash& mapping, HFMModel& hfmModel,
                               float& scaleGuess, bool combineParts) {
     FaceGroup faces;
+    OBJFace face;
     HFMMesh& mesh = hfmModel.meshes[0];
     mesh.parts.push_back(HFMMeshPart());
     bool sawG = false;
@@ -577,7 +1004,7 @@ bool OBJSerializer::parseOBJGroup(OBJTokenizer& tokenizer, const hifi::VariantHa
         } else if (token == "vt") {
             textureUVs.append(tokenizer.getVec2());
         } else if (token == "f") {
-            OBJFace face;
+            face.clear();
             while (true) {
                 if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
                     if (face.vertexIndices.count() == 0) {
@@ -586,6 +1013,14 @@ bool OBJSerializer::parseOBJGroup(OBJTokenizer& tokenizer, const hifi::VariantHa
                     }
                     break;
                 }
+                OBJTokenizer::FaceVertex faceVertex;
+                if (tokenizer.getFaceVertex(faceVertex)) {
+                    // Already parsed, as below but without splitting strings
+                    face.add(faceVertex, vertices.size(), textureUVs.size(), normals.size());
+                    face.groupName = currentGroup;
+                    face.materialName = currentMaterialName;
+                    continue;
+                }
                 // faces can be:
                 //   vertex-index
                 //   vertex-index/texture-index
@@ -625,9 +1060,7 @@ bool OBJSerializer::parseOBJGroup(OBJTokenizer& tokenizer, const hifi::VariantHa
                 face.materialName = currentMaterialName;
             }
             originalFaceCountForDebugging++;
-            foreach(OBJFace face, face.triangulate()) {
-                faces.append(face);
-            }
+            face.triangulate(faces);
         } else {
             // something we don't (yet) care about
             // qCDebug(modelformat) << "OBJ parser is skipping a line with" << token;
@@ -638,11 +1071,199 @@ done:
     if (faces.count() == 0) { // empty mesh
         mesh.parts.pop_back();
     } else {
-        faceGroups.append(faces); // We're done with this group. Add the faces.
+        faces.groupName = currentGroup;
+        faceGroups.append(std::move(faces)); // We're done with this group. Add the faces.
     }
     return result;
 }
 
+void OBJSerializer::buildMesh(HFMMesh& mesh, const QMap<QString, int>& materialMeshIdMap, float scaleGuess) {
+    // Now that each mesh has been created with its own unique material mappings, fill them with data (vertex data is duplicated, face data is not).
+    // Every triangle gets three vertices of its own, so where they go only depends on how many triangles come before it.
+    const QVector<FaceGroup>& groups = faceGroups;
+    const int numGroups = groups.size();
+    std::vector<size_t> firstTriangleOfGroup((size_t)numGroups + 1, 0);
+    std::vector<std::vector<int>> partPerMaterialOfGroup((size_t)numGroups);
+    for (int group = 0; group < numGroups; ++group) {
+        firstTriangleOfGroup[group + 1] = firstTriangleOfGroup[group] + groups[group].triangles.size();
+        for (const QString& materialName : groups[group].materialNames) {
+            partPerMaterialOfGroup[group].push_back(materialMeshIdMap.value(materialName));
+        }
+    }
+    const size_t numTriangles = firstTriangleOfGroup.back();
+
+    // Calls function with each of the triangles from begin to end, in order
+    auto forEachTriangle = [&](size_t begin, size_t end, auto function) {
+        int group = (int)(std::upper_bound(firstTriangleOfGroup.cbegin(), firstTriangleOfGroup.cend(), begin) -
+                          firstTriangleOfGroup.cbegin()) - 1;
+        for (size_t triangleIndex = begin; triangleIndex < end; ++triangleIndex) {
+            while (triangleIndex >= firstTriangleOfGroup[group + 1]) {
+                ++group;
+            }
+            function(triangleIndex, group, groups[group].triangles[triangleIndex - firstTriangleOfGroup[group]]);
+        }
+    };
+
+    const QVector<glm::vec3>& sourceVertices = vertices;
+    const QVector<glm::vec3>& sourceVertexColors = vertexColors;
+    const QVector<glm::vec3>& sourceNormals = normals;
+    const QVector<glm::vec2>& sourceTextureUVs = textureUVs;
+    const bool hasVertexColors = (vertexColors.size() > 0);
+
+    auto isInRange = [](int index, int size) {
+        return index >= 0 && index < size;
+    };
+    auto isComplete = [&](const OBJFaceGroup::Triangle& triangle) {
+        for (int i = 0; i < 3; ++i) {
+            if (!isInRange(triangle.vertexIndices[i], sourceVertices.size()) ||
+                (hasVertexColors && !isInRange(triangle.vertexIndices[i], sourceVertexColors.size())) ||
+                (triangle.hasNormals && !isInRange(triangle.normalIndices[i], sourceNormals.size())) ||
+                (triangle.hasTextureUVs && !isInRange(triangle.textureUVIndices[i], sourceTextureUVs.size()))) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // The triangles before the first one with an index out of range are filled in together
+    const size_t numComplete = tbb::parallel_reduce(tbb::blocked_range<size_t>(0, numTriangles), numTriangles,
+        [&](const tbb::blocked_range<size_t>& range, size_t firstIncomplete) {
+            forEachTriangle(range.begin(), std::min(range.end(), firstIncomplete),
+                            [&](size_t triangleIndex, int group, const OBJFaceGroup::Triangle& triangle) {
+                if (triangleIndex < firstIncomplete && !isComplete(triangle)) {
+                    firstIncomplete = triangleIndex;
+                }
+            });
+            return firstIncomplete;
+        },
+        [](size_t a, size_t b) {
+            return std::min(a, b);
+        });
+
+    const int firstVertex = mesh.vertices.count();
+    const int numVertices = 3 * (int)numComplete;
+    std::vector<int> trianglesPerPart(mesh.parts.size(), 0);
+    forEachTriangle(0, numComplete, [&](size_t triangleIndex, int group, const OBJFaceGroup::Triangle& triangle) {
+        ++trianglesPerPart[partPerMaterialOfGroup[group][triangle.material]];
+    });
+    for (int part = 0; part < (int)mesh.parts.size(); ++part) {
+        mesh.parts[part].triangleIndices.reserve(mesh.parts[part].triangleIndices.size() + 3 * trianglesPerPart[part]);
+    }
+    forEachTriangle(0, numComplete, [&](size_t triangleIndex, int group, const OBJFaceGroup::Triangle& triangle) {
+        HFMMeshPart& meshPart = mesh.parts[partPerMaterialOfGroup[group][triangle.material]];
+        const int vertexIndex = firstVertex + 3 * (int)triangleIndex; // not face.vertexIndices into vertices
+        meshPart.triangleIndices.append(vertexIndex);
+        meshPart.triangleIndices.append(vertexIndex + 1);
+        meshPart.triangleIndices.append(vertexIndex + 2);
+    });
+
+    mesh.vertices.resize(firstVertex + numVertices);
+    if (hasVertexColors) {
+        mesh.colors.resize(firstVertex + numVertices);
+    }
+    mesh.normals.resize(firstVertex + numVertices);
+    mesh.texCoords.resize(firstVertex + numVertices);
+    glm::vec3* meshVertices = mesh.vertices.data() + firstVertex;
+    glm::vec3* meshColors = hasVertexColors ? mesh.colors.data() + firstVertex : nullptr;
+    glm::vec3* meshNormals = mesh.normals.data() + firstVertex;
+    glm::vec2* meshTexCoords = mesh.texCoords.data() + firstVertex;
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numComplete), [&](const tbb::blocked_range<size_t>& range) {
+        forEachTriangle(range.begin(), range.end(), [&](size_t triangleIndex, int group, const OBJFaceGroup::Triangle& triangle) {
+            const size_t first = 3 * triangleIndex;
+            glm::vec3 v[3];
+            for (int i = 0; i < 3; ++i) {
+                v[i] = sourceVertices[triangle.vertexIndices[i]];
+                // Scale the vertices if the OBJ file scale is specified as non-one.
+                if (scaleGuess != 1.0f) {
+                    v[i] *= scaleGuess;
+                }
+                meshVertices[first + i] = v[i];
+                if (hasVertexColors) {
+                    meshColors[first + i] = sourceVertexColors[triangle.vertexIndices[i]];
+                }
+            }
+
+            if (triangle.hasNormals) {
+                for (int i = 0; i < 3; ++i) {
+                    meshNormals[first + i] = sourceNormals[triangle.normalIndices[i]];
+                }
+            } else {
+                // generate normals from triangle plane if not provided
+                glm::vec3 normal = glm::cross(v[1] - v[0], v[2] - v[0]);
+                for (int i = 0; i < 3; ++i) {
+                    meshNormals[first + i] = normal;
+                }
+            }
+
+            const glm::vec2 corner(0.0f, 1.0f);
+            for (int i = 0; i < 3; ++i) {
+                meshTexCoords[first + i] = triangle.hasTextureUVs ? sourceTextureUVs[triangle.textureUVIndices[i]] : corner;
+            }
+        });
+    });
+
+    if (numComplete == numTriangles) {
+        return;
+    }
+
+    // Add what there is of the first triangle with an index out of range, and throw at the same index as ever
+    forEachTriangle(numComplete, numComplete + 1, [&](size_t triangleIndex, int group, const OBJFaceGroup::Triangle& triangle) {
+        HFMMeshPart& meshPart = mesh.parts[partPerMaterialOfGroup[group][triangle.material]];
+
+        glm::vec3 v0 = checked_at(vertices, triangle.vertexIndices[0]);
+        glm::vec3 v1 = checked_at(vertices, triangle.vertexIndices[1]);
+        glm::vec3 v2 = checked_at(vertices, triangle.vertexIndices[2]);
+
+        glm::vec3 vc0, vc1, vc2;
+        if (hasVertexColors) {
+            // If there are any vertex colors, it's safe to assume all meshes had them exported.
+            vc0 = checked_at(vertexColors, triangle.vertexIndices[0]);
+            vc1 = checked_at(vertexColors, triangle.vertexIndices[1]);
+            vc2 = checked_at(vertexColors, triangle.vertexIndices[2]);
+        }
+
+        if (scaleGuess != 1.0f) {
+            v0 *= scaleGuess;
+            v1 *= scaleGuess;
+            v2 *= scaleGuess;
+        }
+
+        meshPart.triangleIndices.append(mesh.vertices.count());
+        mesh.vertices << v0;
+        meshPart.triangleIndices.append(mesh.vertices.count());
+        mesh.vertices << v1;
+        meshPart.triangleIndices.append(mesh.vertices.count());
+        mesh.vertices << v2;
+
+        if (hasVertexColors) {
+            mesh.colors << vc0;
+            mesh.colors << vc1;
+            mesh.colors << vc2;
+        }
+
+        glm::vec3 n0, n1, n2;
+        if (triangle.hasNormals) {
+            n0 = checked_at(normals, triangle.normalIndices[0]);
+            n1 = checked_at(normals, triangle.normalIndices[1]);
+            n2 = checked_at(normals, triangle.normalIndices[2]);
+        } else {
+            n0 = n1 = n2 = glm::cross(v1 - v0, v2 - v0);
+        }
+
+        mesh.normals.append(n0);
+        mesh.normals.append(n1);
+        mesh.normals.append(n2);
+
+        if (triangle.hasTextureUVs) {
+            glm::vec2 uv0 = checked_at(textureUVs, triangle.textureUVIndices[0]);
+            glm::vec2 uv1 = checked_at(textureUVs, triangle.textureUVIndices[1]);
+            glm::vec2 uv2 = checked_at(textureUVs, triangle.textureUVIndices[2]);
+            mesh.texCoords << uv0 << uv1 << uv2;
+        }
+    });
+}
+
 MediaType OBJSerializer::getMediaType() const {
     MediaType mediaType("obj");
     mediaType.extensions.push_back("obj");
@@ -656,11 +1277,16 @@ std::unique_ptr<hfm::Serializer::Factory> OBJSerializer::getFactory() const {
 HFMModel::Pointer OBJSerializer::read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url) {
     PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xffff0000, nullptr);
     QBuffer buffer { const_cast<hifi::ByteArray*>(&data) };
-    buffer.open(QIODevice::ReadOnly);
+    std::unique_ptr<OBJTokenizer> tokenizer;
+    if (_parallelTokenizingEnabled && OBJTokenizer::canTokenizeAhead(data)) {
+        tokenizer = std::make_unique<OBJTokenizer>(data);
+    } else {
+        buffer.open(QIODevice::ReadOnly);
+        tokenizer = std::make_unique<OBJTokenizer>(&buffer);
+    }
 
     auto hfmModelPtr = std::make_shared<HFMModel>();
     HFMModel& hfmModel { *hfmModelPtr };
-    OBJTokenizer tokenizer { &buffer };
     float scaleGuess = 1.0f;
 
     bool needsMaterialLibrary = false;
@@ -673,7 +1299,7 @@ HFMModel::Pointer OBJSerializer::read(const hifi::ByteArray& data, const hifi::V
     try {
         // call parseOBJGroup as long as it's returning true.  Each successful call will
         // add a new meshPart to the model's single mesh.
-        while (parseOBJGroup(tokenizer, mapping, hfmModel, scaleGuess, combineParts)) {}
+        while (parseOBJGroup(*tokenizer, mapping, hfmModel, scaleGuess, combineParts)) {}
 
         uint32_t meshIndex = 0;
         HFMMesh& mesh = hfmModel.meshes[meshIndex];
@@ -695,14 +1321,13 @@ HFMModel::Pointer OBJSerializer::read(const hifi::ByteArray& data, const hifi::V
         std::vector<HFMMeshPart> hfmMeshParts;
         for (uint32_t meshPartIndex = 0; meshPartIndex < (uint32_t)mesh.parts.size(); ++meshPartIndex) {
             HFMMeshPart& meshPart = mesh.parts[meshPartIndex];
-            FaceGroup faceGroup = faceGroups[meshPartIndex];
+            const FaceGroup& faceGroup = faceGroups[meshPartIndex];
             bool specifiesUV = false;
-            foreach(OBJFace face, faceGroup) {
-                // Go through all of the OBJ faces and determine the number of different materials necessary (each different material will be a unique mesh).
-                // NOTE (trent/mittens 3/30/17): this seems hardcore wasteful and is slowed down a bit by iterating through the face group twice, but it's the best way I've thought of to hack multi-material support in an OBJ into this pipeline.
-                if (!materialMeshIdMap.contains(face.materialName)) {
+            for (const QString& faceMaterialName : faceGroup.materialNames) {
+                // Go through the materials of the OBJ faces, in order, and determine the number of different materials necessary (each different material will be a unique mesh).
+                if (!materialMeshIdMap.contains(faceMaterialName)) {
                     // Create a new HFMMesh for this material mapping.
-                    materialMeshIdMap.insert(face.materialName, materialMeshIdMap.count());
+                    materialMeshIdMap.insert(faceMaterialName, materialMeshIdMap.count());
 
                     uint32_t partIndex = (int)hfmMeshParts.size();
                     hfmMeshParts.push_back(HFMMeshPart());
@@ -713,7 +1338,7 @@ HFMModel::Pointer OBJSerializer::read(const hifi::ByteArray& data, const hifi::V
                     
                     // Do some of the material logic (which previously lived below) now.
                     // All the faces in the same group will have the same name and material.
-                    QString groupMaterialName = face.materialName;
+                    QString groupMaterialName = faceMaterialName;
                     if (groupMaterialName.isEmpty() && specifiesUV) {
 #ifdef WANT_DEBUG
                         qCDebug(modelformat) << "OBJSerializer WARNING: " << url
@@ -746,77 +1371,10 @@ HFMModel::Pointer OBJSerializer::read(const hifi::ByteArray& data, const hifi::V
         }
 
         // clean up old mesh parts.
-        auto unmodifiedMeshPartCount = (uint32_t)mesh.parts.size();
         mesh.parts.clear();
         mesh.parts = hfmMeshParts;
 
-        for (uint32_t meshPartIndex = 0; meshPartIndex < unmodifiedMeshPartCount; meshPartIndex++) {
-            FaceGroup faceGroup = faceGroups[meshPartIndex];
-
-            // Now that each mesh has been created with its own unique material mappings, fill them with data (vertex data is duplicated, face data is not).
-            foreach(OBJFace face, faceGroup) {
-                HFMMeshPart& meshPart = mesh.parts[materialMeshIdMap[face.materialName]];
-
-                glm::vec3 v0 = checked_at(vertices, face.vertexIndices[0]);
-                glm::vec3 v1 = checked_at(vertices, face.vertexIndices[1]);
-                glm::vec3 v2 = checked_at(vertices, face.vertexIndices[2]);
-
-                glm::vec3 vc0, vc1, vc2;
-                bool hasVertexColors = (vertexColors.size() > 0);
-                if (hasVertexColors) {
-                    // If there are any vertex colors, it's safe to assume all meshes had them exported.
-                    vc0 = checked_at(vertexColors, face.vertexIndices[0]);
-                    vc1 = checked_at(vertexColors, face.vertexIndices[1]);
-                    vc2 = checked_at(vertexColors, face.vertexIndices[2]);
-                }
-
-                // Scale the vertices if the OBJ file scale is specified as non-one.
-                if (scaleGuess != 1.0f) {
-                    v0 *= scaleGuess;
-                    v1 *= scaleGuess;
-                    v2 *= scaleGuess;
-                }
-
-                // Add the vertices.
-                meshPart.triangleIndices.append(mesh.vertices.count()); // not face.vertexIndices into vertices
-                mesh.vertices << v0;
-                meshPart.triangleIndices.append(mesh.vertices.count());
-                mesh.vertices << v1;
-                meshPart.triangleIndices.append(mesh.vertices.count());
-                mesh.vertices << v2;
-
-                if (hasVertexColors) {
-                    // Add vertex colors.
-                    mesh.colors << vc0;
-                    mesh.colors << vc1;
-                    mesh.colors << vc2;
-                }
-
-                glm::vec3 n0, n1, n2;
-                if (face.normalIndices.count()) {
-                    n0 = checked_at(normals, face.normalIndices[0]);
-                    n1 = checked_at(normals, face.normalIndices[1]);
-                    n2 = checked_at(normals, face.normalIndices[2]);
-                } else { 
-                    // generate normals from triangle plane if not provided
-                    n0 = n1 = n2 = glm::cross(v1 - v0, v2 - v0);
-                }
-
-                mesh.normals.append(n0);
-                mesh.normals.append(n1);
-                mesh.normals.append(n2);
-
-                if (face.textureUVIndices.count()) {
-                    mesh.texCoords <<
-                        checked_at(textureUVs, face.textureUVIndices[0]) <<
-                        checked_at(textureUVs, face.textureUVIndices[1]) <<
-                        checked_at(textureUVs, face.textureUVIndices[2]);
-                } else {
-                    glm::vec2 corner(0.0f, 1.0f);
-                    mesh.texCoords << corner << corner << corner;
-                }
-            }
-        }
+        buildMesh(mesh, materialMeshIdMap, scaleGuess);
     } catch(const std::exception& e) {
         qCDebug(modelformat) << "OBJSerializer fail: " << e.what();
     }
@@ -12,36 +12,112 @@
 #ifndef hifi_OBJSerializer_h
 #define hifi_OBJSerializer_h
 
+#include <vector>
+
 #include <QtNetwork/QNetworkReply>
 #include <hfm/HFMSerializer.h>
 
 class OBJTokenizer {
 public:
     OBJTokenizer(QIODevice* device);
+    // Tokenizes all of data ahead of the parser, a window of line aligned chunks at a time and in parallel.
+    // data has to outlive the tokenizer.
+    OBJTokenizer(const hifi::ByteArray& data);
     enum SpecialToken {
         NO_TOKEN = -1,
         NO_PUSHBACKED_TOKEN = -1,
         DATUM_TOKEN = 0x100,
         COMMENT_TOKEN = 0x101
     };
+    // A face vertex, "v", "v/vt", "v/vt/vn" or "v//vn", as it appears in the file
+    struct FaceVertex {
+        int indices[3];
+        int partCount; // How many '/' separated parts there are
+        bool hasIndex[3]; // False for the parts that are empty
+    };
+    // Whether a datum can be read without looking at the file again
+    enum class DatumKind : uint8_t {
+        UNKNOWN = 0,
+        FLOAT,
+        NOT_FLOAT,
+        FACE_VERTEX
+    };
+
+    // True when all of the data can be tokenized ahead, which is as long as there are no quoted datums in it
+    static bool canTokenizeAhead(const hifi::ByteArray& data);
+
     int nextToken(bool allowSpaceChar = false);
-    const hifi::ByteArray& getDatum() const { return _datum; }
+    const hifi::ByteArray& getDatum() const;
     bool isNextTokenFloat();
     const hifi::ByteArray getLineAsDatum(); // some "filenames" have spaces in them
-    void skipLine() { _device->readLine(); }
+    void skipLine();
     void pushBackToken(int token) { _pushedBackToken = token; }
     void ungetChar(char ch) { _device->ungetChar(ch); }
-    const QString getComment() const { return _comment; }
+    const QString getComment() const;
+    // Fills faceVertex and answers true if the datum was parsed ahead as a face vertex
+    bool getFaceVertex(FaceVertex& faceVertex) const;
     glm::vec3 getVec3();
     bool getVertex(glm::vec3& vertex, glm::vec3& vertexColor);
     glm::vec2 getVec2();
     float getFloat();
 
+    struct Token {
+        uint32_t offset; // Into the data
+        uint32_t length;
+        bool isComment;
+        bool isFirstOnLine;
+        DatumKind kind;
+        union {
+            float value; // FLOAT datums
+            uint32_t faceVertex; // FACE_VERTEX datums, into the face vertices of the chunk
+        };
+    };
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        std::vector<Token> tokens;
+        std::vector<FaceVertex> faceVertices;
+    };
+
 private:
-    QIODevice* _device;
-    hifi::ByteArray _datum;
+    const Token* peekAheadToken();
+    const Token* nextAheadToken();
+    void tokenizeWindow();
+
+    QIODevice* _device { nullptr };
+    mutable hifi::ByteArray _datum;
     int _pushedBackToken;
     QString _comment;
+
+    // Tokenizing ahead
+    const char* _data { nullptr };
+    size_t _size { 0 };
+    size_t _windowEnd { 0 };
+    std::vector<Chunk> _window;
+    size_t _chunkIndex { 0 };
+    size_t _tokenIndex { 0 };
+    Token _token {}; // The last datum, copied since the window moves on under it
+    FaceVertex _faceVertex {};
+    Token _commentToken {};
+    mutable bool _isDatumCurrent { true };
+};
+
+// The triangles of the faces of one group, packed together since scanned models have millions of them
+class OBJFaceGroup {
+public:
+    struct Triangle {
+        int vertexIndices[3];
+        int textureUVIndices[3];
+        int normalIndices[3];
+        bool hasTextureUVs;
+        bool hasNormals;
+        int material; // Into materialNames
+    };
+    std::vector<Triangle> triangles;
+    QVector<QString> materialNames; // In the order the triangles first use them, repeated when they switch back
+    QString groupName;
+
+    int count() const { return (int)triangles.size(); }
 };
 
 class OBJFace { // A single face, with three or more planar vertices. But see triangulate().
@@ -54,11 +130,12 @@ public:
     // Add one more set of vertex data. Answers true if successful
     bool add(const hifi::ByteArray& vertexIndex, const hifi::ByteArray& textureIndex, const hifi::ByteArray& normalIndex,
              const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& vertexColors);
-    // Return a set of one or more OBJFaces from this one, in which each is just a triangle.
+    // The same for a face vertex that was parsed ahead, given how many vertices, texture coordinates and normals came before it
+    void add(const OBJTokenizer::FaceVertex& faceVertex, int vertexCount, int textureUVCount, int normalCount);
+    void clear();
+    // Add the triangles of this face to a group, in which each is just a triangle.
     // Even though HFMMeshPart can handle quads, it would be messy to try to keep track of mixed-size faces, so we treat everything as triangles.
-    QVector<OBJFace> triangulate();
-private:
-    void addFrom(const OBJFace* face, int index);
+    void triangulate(OBJFaceGroup& group) const;
 };
 
 class OBJMaterialTextureOptions {
@@ -94,7 +171,7 @@ public:
     MediaType getMediaType() const override;
     std::unique_ptr<hfm::Serializer::Factory> getFactory() const override;
     
-    typedef QVector<OBJFace> FaceGroup;
+    typedef OBJFaceGroup FaceGroup;
     QVector<glm::vec3> vertices;
     QVector<glm::vec3> vertexColors;
     QVector<glm::vec2> textureUVs;
@@ -105,6 +182,9 @@ public:
     
     HFMModel::Pointer read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url = hifi::URL()) override;
 
+    // When enabled (the default) OBJ files are tokenized ahead of the parser on all cores
+    static void setParallelTokenizingEnabled(bool enabled) { _parallelTokenizingEnabled = enabled; }
+
 private:
     hifi::URL _url;
 
@@ -115,7 +195,11 @@ private:
     void parseTextureLine(const hifi::ByteArray& textureLine, hifi::ByteArray& filename, OBJMaterialTextureOptions& textureOptions);
     bool isValidTexture(const hifi::ByteArray &filename); // true if the file exists. TODO?: check content-type header and that it is a supported format.
 
+    void buildMesh(HFMMesh& mesh, const QMap<QString, int>& materialMeshIdMap, float scaleGuess);
+
     int _partCounter { 0 };
+
+    static bool _parallelTokenizingEnabled;
 };
 
 // What are these utilities doing here? One is used by fbx loading code in VHACD Utils, and the other a general debugging utility.
@@ -255,6 +255,10 @@ TransferJob::TransferJob(const Texture& texture,
         auto mipStorage = texture->accessStoredMipFace(sourceMip, face);
         if (mipStorage) {
             _mipData = mipStorage->createView(_transferSize, _transferOffset);
+            // KTX backed mips are views into the mapped file, page them in here rather than in the transfer
+            if (_mipData) {
+                _mipData->prefault();
+            }
         } else {
             qCWarning(gpugllogging) << "Buffering failed because mip could not be retrieved from texture "
                 << texture->source().c_str();
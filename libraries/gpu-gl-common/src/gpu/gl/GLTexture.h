@@ -101,6 +101,7 @@ public:
     virtual void populateTransferQueue(TransferQueue& pendingTransfers) = 0;
 
     void sanityCheck() const;
+    uint16 allocatedMip() const { return _allocatedMip; }
     uint16 populatedMip() const { return _populatedMip; }
     bool canPromote() const { return _allocatedMip > _minAllocatedMip; }
     bool canDemote() const { return _allocatedMip < _maxAllocatedMip; }
@@ -10,6 +10,7 @@
 
 #include <QtCore/QThread>
 #include <NumericalConstants.h>
+#include <gpu/TextureStreaming.h>
 
 #include "GLBackend.h"
 
@@ -164,6 +165,8 @@ void GLTextureTransferEngineDefault::shutdown() {
 
 void GLTextureTransferEngineDefault::manageMemory() {
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__);
+    // screen sizes reported from now on are for the next frame
+    TextureStreaming::beginFrame();
     // reset the count used to limit the number of textures created per frame
     resetFrameTextureCreated();
     // Determine the current memory management state.  It will be either idle (no work to do),
@@ -196,6 +199,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
     bool canDemote = false;
     bool canPromote = false;
     bool hasTransfers = false;
+    TextureStreaming::Stats streamingStats;
+    streamingStats.budget = allowedMemoryAllocation;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vartexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
@@ -203,6 +208,14 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
 
         // Track how much the texture thinks it should be using
         idealMemoryAllocation += texture->evalTotalSize();
+        // and how much of it is worth having given how large it is on screen
+        if (TextureStreaming::getScreenSize(*texture) > 0.0f) {
+            ++streamingStats.visibleTextures;
+            streamingStats.wantedMemory += texture->evalTotalSize(TextureStreaming::evalDesiredMip(*texture));
+            if (TextureStreaming::evalMipValue(*texture, vartexture->populatedMip()) > TextureStreaming::BLURRY_VALUE) {
+                ++streamingStats.blurryTextures;
+            }
+        }
         // Track how much we're actually using
         totalVariableMemoryAllocation += gltexture->size();
         if (vartexture->canDemote()) {
@@ -217,6 +230,7 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
     }
 
     Backend::textureResourceIdealGPUMemSize.set(idealMemoryAllocation);
+    TextureStreaming::setFrameStats(streamingStats);
     size_t unallocated = idealMemoryAllocation - totalVariableMemoryAllocation;
     float pressure = (float)totalVariableMemoryAllocation / (float)allowedMemoryAllocation;
 
@@ -255,8 +269,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
             if (MemoryPressureState::Undersubscribed == _memoryPressureState && vargltexture->canPromote()) {
-                // Promote smallest first
-                _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+                // Promote the blurriest on screen first
+                _promoteQueue.push({ texture, TextureStreaming::evalMipValue(*texture, vargltexture->allocatedMip()) });
             } else if (MemoryPressureState::Transfer == _memoryPressureState && vargltexture->hasPendingTransfers()) {
                 populateTransferQueue(texture);
             }
@@ -327,6 +341,14 @@ void GLTextureTransferEngineDefault::populateActiveBufferQueue() {
     ActiveTransferQueue newBufferJobs;
     size_t newTransferSize{ 0 };
 
+    // Buffer for the textures that are the blurriest on screen first
+    struct PendingTransfer {
+        float value;
+        TexturePointer texture;
+        TransferMap::iterator itr;
+    };
+    std::vector<PendingTransfer> pendingTransfers;
+    pendingTransfers.reserve(_pendingTransfersMap.size());
     for (auto itr = _pendingTransfersMap.begin(); itr != _pendingTransfersMap.end();) {
         const auto& weakTexture = itr->first;
         const auto texture = weakTexture.lock();
@@ -337,19 +359,23 @@ void GLTextureTransferEngineDefault::populateActiveBufferQueue() {
             continue;
         }
 
-        GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
-        GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-
-        auto& textureTransferQueue = itr->second;
         // Can't find any pending transfers, so move on
-        if (textureTransferQueue.empty()) {
-            if (vargltexture->hasPendingTransfers()) {
-                // qWarning(gpugllogging) << "Texture " << gltexture->_id << "(" << texture->source().c_str() << ") has no transfer jobs, but has pending transfers" ;
-            }
+        if (itr->second.empty()) {
             itr = _pendingTransfersMap.erase(itr);
             continue;
         }
 
+        GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
+        GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
+        pendingTransfers.push_back({ TextureStreaming::evalMipValue(*texture, vargltexture->populatedMip()), texture, itr });
+        ++itr;
+    }
+    std::stable_sort(pendingTransfers.begin(), pendingTransfers.end(), [](const PendingTransfer& a, const PendingTransfer& b) {
+        return a.value > b.value;
+    });
+
+    for (const auto& pendingTransfer : pendingTransfers) {
+        auto& textureTransferQueue = pendingTransfer.itr->second;
         const auto& transferJob = textureTransferQueue.front();
         const auto& transferSize = transferJob->size();
         // If there's not enough space for the buffering, then break out of the loop
@@ -361,9 +387,8 @@ void GLTextureTransferEngineDefault::populateActiveBufferQueue() {
         Q_ASSERT(newTransferSize <= MAX_BUFFER_SIZE);
         newTransferSize += transferSize;
         Q_ASSERT(newTransferSize <= MAX_BUFFER_SIZE);
-        newBufferJobs.emplace_back(texture, transferJob);
+        newBufferJobs.emplace_back(pendingTransfer.texture, transferJob);
         textureTransferQueue.pop();
-        ++itr;
     }
 
     {
@@ -445,8 +470,8 @@ void GLTextureTransferEngineDefault::processPromotes() {
         vartexture->promote();
         auto allocationDelta = gltexture->size() - originalSize;
         if (vartexture->canPromote()) {
-            // Promote smallest first
-            _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+            // Promote the blurriest on screen first
+            _promoteQueue.push({ texture, TextureStreaming::evalMipValue(*texture, vartexture->allocatedMip()) });
         }
         allocatedBytes += allocationDelta;
         if (++allocations >= MAX_ALLOCATIONS_PER_FRAME) {
@@ -465,13 +490,13 @@ void GLTextureTransferEngineDefault::processPromotes() {
 }
 
 void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const std::vector<TexturePointer>& strongTextures) {
-    // Demote largest first
+    // Demote what isn't on screen first, largest first, then what would be the least blurry without its finest mip
     ImmediateWorkQueue demoteQueue;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         if (vargltexture->canDemote()) {
-            demoteQueue.push({ texture, (float)gltexture->size() });
+            demoteQueue.push({ texture, TextureStreaming::evalEvictionPriority(*texture, vargltexture->allocatedMip(), gltexture->size()) });
         }
     }
 
@@ -489,6 +514,7 @@ void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const
         }
         demoteQueue.pop();
     }
+    TextureStreaming::addEvictedMemory(relieved);
 }
 
 // FIXME hack for stats display
@@ -92,9 +92,35 @@ void Context::appendFrameBatch(const BatchPointer& batch) {
     _currentFrame->batches.push_back(batch);
 }
 
+bool Context::appendPendingFrameBatch(const BatchPointer& batch) {
+    if (!_frameActive) {
+        qWarning() << "Batch executed outside of frame boundaries";
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_pendingBatchesMutex);
+        ++_numPendingBatches;
+    }
+    _currentFrame->batches.push_back(batch);
+    return true;
+}
+
+void Context::finishPendingFrameBatch() {
+    std::lock_guard<std::mutex> lock(_pendingBatchesMutex);
+    assert(_numPendingBatches > 0);
+    if (--_numPendingBatches == 0) {
+        _pendingBatchesFinished.notify_all();
+    }
+}
+
 FramePointer Context::endFrame() {
     PROFILE_RANGE(render_gpu, __FUNCTION__);
     assert(_frameActive);
+    {
+        // The buffer updates of the batches are gathered once they are all recorded
+        std::unique_lock<std::mutex> lock(_pendingBatchesMutex);
+        _pendingBatchesFinished.wait(lock, [this] { return _numPendingBatches == 0; });
+    }
     auto result = _currentFrame;
     _currentFrame.reset();
     _frameActive = false;
@@ -12,6 +12,7 @@
 #define hifi_gpu_Context_h
 
 #include <assert.h>
+#include <condition_variable>
 #include <mutex>
 #include <queue>
 
@@ -164,6 +165,12 @@ public:
     void appendFrameBatch(const BatchPointer& batch);
     FramePointer endFrame();
 
+    // Takes the place of a batch in the frame before it is recorded, so that it can be recorded on another thread and
+    // still be executed in the order it was appended. Each batch appended this way MUST be finished once recorded, from
+    // whichever thread recorded it, and endFrame waits for them all. Returns false outside of frame boundaries.
+    bool appendPendingFrameBatch(const BatchPointer& batch);
+    void finishPendingFrameBatch();
+
     static BatchPointer acquireBatch(const char* name = nullptr);
     static void releaseBatch(Batch* batch);
 
@@ -277,6 +284,9 @@ protected:
     bool _frameActive{ false };
     FramePointer _currentFrame;
     RangeTimerPointer _frameRangeTimer;
+    std::mutex _pendingBatchesMutex;
+    std::condition_variable _pendingBatchesFinished;
+    int _numPendingBatches { 0 };
     StereoState _stereo;
 
     std::mutex _programsToSyncMutex;
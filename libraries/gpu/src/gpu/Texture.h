@@ -359,6 +359,11 @@ public:
         static void releaseOpenKtxFiles();
 
     protected:
+        // For a KTX file that was already parsed, so that loading it maps and parses it only once
+        KtxStorage(const std::string& filename, const ktx::KTX& ktxFile);
+        KtxStorage(const cache::FilePointer& file, const ktx::KTX& ktxFile);
+        void initDescriptor(const ktx::KTX& ktxFile);
+
         std::shared_ptr<storage::FileStorage> maybeOpenFile() const;
 
         mutable std::shared_ptr<std::mutex> _cacheFileMutex { std::make_shared<std::mutex>() };
@@ -632,6 +637,10 @@ protected:
     bool _autoGenerateMips = false;
     bool _isIrradianceValid = false;
     bool _defined = false;
+
+    // How large the texture was last drawn on screen, and in which frame, kept up by TextureStreaming.
+    // One atomic, the frame in the high bits and the bits of the float size in the low ones, so they change together.
+    mutable std::atomic<uint64_t> _screenSizeReport { 0 };
    
     static TexturePointer create(TextureUsageType usageType, Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices, uint16 numMips, const Sampler& sampler);
 
@@ -639,6 +648,7 @@ protected:
 
     friend class Serializer;
     friend class Deserializer;
+    friend class TextureStreaming;
 };
 
 typedef std::shared_ptr<Texture> TexturePointer;
@@ -0,0 +1,143 @@
+//
+//  TextureStreaming.cpp
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "TextureStreaming.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Texture.h"
+#include "TextureTable.h"
+
+using namespace gpu;
+
+const float TextureStreaming::BLURRY_VALUE { 2.0f };
+
+std::atomic<uint32_t> TextureStreaming::_frame { 0 };
+std::atomic<uint32_t> TextureStreaming::_visibleTextures { 0 };
+std::atomic<uint32_t> TextureStreaming::_blurryTextures { 0 };
+std::atomic<Size> TextureStreaming::_wantedMemory { 0 };
+std::atomic<Size> TextureStreaming::_evictedMemory { 0 };
+std::atomic<Size> TextureStreaming::_budget { 0 };
+
+void TextureStreaming::beginFrame() {
+    ++_frame;
+}
+
+static uint64_t packScreenSizeReport(uint32_t frame, float pixels) {
+    uint32_t pixelBits;
+    memcpy(&pixelBits, &pixels, sizeof(pixelBits));
+    return ((uint64_t)frame << 32) | pixelBits;
+}
+
+static uint32_t getReportFrame(uint64_t report) {
+    return (uint32_t)(report >> 32);
+}
+
+static float getReportPixels(uint64_t report) {
+    uint32_t pixelBits = (uint32_t)report;
+    float pixels;
+    memcpy(&pixels, &pixelBits, sizeof(pixels));
+    return pixels;
+}
+
+// What was drawn in the frames before doesn't count anymore, within a frame the largest size is kept.
+// A report from a thread that hasn't seen the frame begin yet doesn't replace one from the new frame.
+static bool replacesReport(uint64_t previous, uint32_t frame, float pixels) {
+    const uint32_t previousFrame = getReportFrame(previous);
+    if (previousFrame == frame) {
+        return pixels > getReportPixels(previous);
+    }
+    return (int32_t)(frame - previousFrame) > 0;
+}
+
+void TextureStreaming::reportScreenSize(const Texture& texture, float pixels) {
+    const auto frame = _frame.load();
+    const auto report = packScreenSizeReport(frame, pixels);
+    auto previous = texture._screenSizeReport.load();
+    while (replacesReport(previous, frame, pixels) && !texture._screenSizeReport.compare_exchange_weak(previous, report)) {
+    }
+}
+
+void TextureStreaming::reportScreenSize(const TextureTable& table, float pixels) {
+    for (const auto& texture : table.getTextures()) {
+        if (texture) {
+            reportScreenSize(*texture, pixels);
+        }
+    }
+}
+
+float TextureStreaming::getScreenSize(const Texture& texture) {
+    const auto report = texture._screenSizeReport.load();
+    auto age = _frame.load() - getReportFrame(report);
+    if (age > SCREEN_SIZE_FRAMES) {
+        return 0.0f;
+    }
+    return getReportPixels(report);
+}
+
+bool TextureStreaming::isScreenSizeReported(const Texture& texture) {
+    return getReportFrame(texture._screenSizeReport.load()) != 0;
+}
+
+float TextureStreaming::evalMipValue(const Texture& texture, uint16 mip) {
+    float screenSize = getScreenSize(texture);
+    if (screenSize <= 0.0f) {
+        return 0.0f;
+    }
+    float mipSize = (float)std::max(texture.evalMipWidth(mip), texture.evalMipHeight(mip));
+    return screenSize / mipSize;
+}
+
+uint16 TextureStreaming::evalDesiredMip(const Texture& texture) {
+    float screenSize = getScreenSize(texture);
+    if (screenSize <= 0.0f) {
+        return texture.getMaxMip();
+    }
+    // the coarsest mip with at least one texel per pixel
+    float size = (float)std::max(texture.getWidth(), texture.getHeight());
+    float mip = std::floor(std::log2(std::max(size / screenSize, 1.0f)));
+    return (uint16)std::min(mip, (float)texture.getMaxMip());
+}
+
+uint16 TextureStreaming::evalDownloadMip(const Texture& texture) {
+    // skyboxes, particles, overlays and such aren't reported, they get all their mips as before
+    if (!isScreenSizeReported(texture)) {
+        return 0;
+    }
+    return evalDesiredMip(texture);
+}
+
+float TextureStreaming::evalEvictionPriority(const Texture& texture, uint16 finestMip, Size size) {
+    if (getScreenSize(texture) <= 0.0f) {
+        return (float)size;
+    }
+    return -evalMipValue(texture, finestMip + 1);
+}
+
+void TextureStreaming::setFrameStats(const Stats& stats) {
+    _visibleTextures = stats.visibleTextures;
+    _blurryTextures = stats.blurryTextures;
+    _wantedMemory = stats.wantedMemory;
+    _budget = stats.budget;
+}
+
+void TextureStreaming::addEvictedMemory(Size size) {
+    _evictedMemory += size;
+}
+
+TextureStreaming::Stats TextureStreaming::getStats() {
+    Stats stats;
+    stats.visibleTextures = _visibleTextures;
+    stats.blurryTextures = _blurryTextures;
+    stats.wantedMemory = _wantedMemory;
+    stats.evictedMemory = _evictedMemory;
+    stats.budget = _budget;
+    return stats;
+}
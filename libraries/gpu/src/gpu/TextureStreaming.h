@@ -0,0 +1,85 @@
+//
+//  TextureStreaming.h
+//  libraries/gpu/src/gpu
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_TextureStreaming_h
+#define hifi_gpu_TextureStreaming_h
+
+#include <atomic>
+
+#include "Forward.h"
+
+namespace gpu {
+
+class TextureTable;
+
+// Ranks the mips of the streamed textures against one another, from how large each texture has been drawn on screen lately.
+// The render pipeline reports the screen size of what it draws with a texture, then the backend asks how much a mip is
+// worth when it orders its uploads and picks what to evict, and the texture cache does the same for the mips it downloads.
+//
+// The value of a texture is how blurry it is on screen: how many screen pixels each texel of its finest mip spans.
+// A texture drawn 1024 pixels across with its 256 texels mip is worth 4, and nothing once it has its 1024 texels mip.
+// Textures that haven't been drawn for a while are worth 0, whatever mips they have.
+class TextureStreaming {
+public:
+    // How many frames the screen size a texture was drawn at is remembered for
+    static const uint32_t SCREEN_SIZE_FRAMES { 90 };
+    // Textures whose finest mip spans more screen pixels than this per texel are counted as blurry
+    static const float BLURRY_VALUE;
+
+    struct Stats {
+        uint32_t visibleTextures { 0 };
+        uint32_t blurryTextures { 0 };
+        // The memory the visible textures would take with all the mips that are worth anything
+        Size wantedMemory { 0 };
+        Size evictedMemory { 0 };
+        Size budget { 0 };
+    };
+
+    // Called once per frame by the backend before it manages the texture memory
+    static void beginFrame();
+    static uint32_t getFrame() { return _frame; }
+
+    // The texture, or all those of the table, are drawn about pixels across on screen this frame.
+    // Safe to call from any thread, the largest size reported within a frame is kept.
+    static void reportScreenSize(const Texture& texture, float pixels);
+    static void reportScreenSize(const TextureTable& table, float pixels);
+
+    // How many pixels across the texture has been drawn lately, 0 if it hasn't been drawn
+    static float getScreenSize(const Texture& texture);
+    // Whether the screen size of the texture has ever been reported, only what the render pipeline draws in the main view is
+    static bool isScreenSizeReported(const Texture& texture);
+
+    // What the texture is worth with mip as its finest
+    static float evalMipValue(const Texture& texture, uint16 mip);
+    // The finest mip that adds anything on screen, the coarsest one if the texture hasn't been drawn lately
+    static uint16 evalDesiredMip(const Texture& texture);
+    // The finest mip worth downloading: the desired mip, or the finest there is for textures whose size is never reported
+    static uint16 evalDownloadMip(const Texture& texture);
+
+    // The order to evict the finest mip of textures in when over budget, highest first: the textures that haven't been drawn
+    // lately by size, largest first, then the others by what they would be worth without the mip, least first
+    static float evalEvictionPriority(const Texture& texture, uint16 finestMip, Size size);
+
+    // Filled in by the backend once per frame, as it goes through all the textures it manages
+    static void setFrameStats(const Stats& stats);
+    static void addEvictedMemory(Size size);
+    static Stats getStats();
+
+private:
+    static std::atomic<uint32_t> _frame;
+    static std::atomic<uint32_t> _visibleTextures;
+    static std::atomic<uint32_t> _blurryTextures;
+    static std::atomic<Size> _wantedMemory;
+    static std::atomic<Size> _evictedMemory;
+    static std::atomic<Size> _budget;
+};
+
+}
+
+#endif
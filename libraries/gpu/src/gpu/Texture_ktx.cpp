@@ -161,14 +161,36 @@ const std::string IrradianceKTXPayload::KEY{ "hifi.irradianceSH" };
 
 KtxStorage::KtxStorage(const storage::StoragePointer& storage) : _storage(storage) {
     auto ktxPointer = ktx::KTX::create(storage);
-    _ktxDescriptor.reset(new ktx::KTXDescriptor(ktxPointer->toDescriptor()));
+    initDescriptor(*ktxPointer);
+}
+
+KtxStorage::KtxStorage(const cache::FilePointer& cacheEntry) : KtxStorage(cacheEntry->getFilepath()) {
+    _cacheEntry = cacheEntry;
+}
+
+KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
+    // We are doing a lot of work here just to get descriptor data
+    auto ktxPointer = ktx::KTX::createMapped(_filename);
+    initDescriptor(*ktxPointer);
+}
+
+KtxStorage::KtxStorage(const cache::FilePointer& cacheEntry, const ktx::KTX& ktxFile) : KtxStorage(cacheEntry->getFilepath(), ktxFile) {
+    _cacheEntry = cacheEntry;
+}
+
+KtxStorage::KtxStorage(const std::string& filename, const ktx::KTX& ktxFile) : _filename(filename) {
+    initDescriptor(ktxFile);
+}
+
+void KtxStorage::initDescriptor(const ktx::KTX& ktxFile) {
+    _ktxDescriptor.reset(new ktx::KTXDescriptor(ktxFile.toDescriptor()));
     if (_ktxDescriptor->images.size() < _ktxDescriptor->header.numberOfMipmapLevels) {
         qWarning() << "Bad images found in ktx";
     }
 
     _offsetToMinMipKV = _ktxDescriptor->getValueOffsetForKey(ktx::HIFI_MIN_POPULATED_MIP_KEY);
     if (_offsetToMinMipKV) {
-        auto data = storage->data() + ktx::KTX_HEADER_SIZE + _offsetToMinMipKV;
+        auto data = ktxFile.getStorage()->data() + ktx::KTX_HEADER_SIZE + _offsetToMinMipKV;
         _minMipLevelAvailable = *data;
     } else {
         // Assume all mip levels are available
@@ -183,39 +205,6 @@ KtxStorage::KtxStorage(const storage::StoragePointer& storage) : _storage(storag
     }
 }
 
-KtxStorage::KtxStorage(const cache::FilePointer& cacheEntry) : KtxStorage(cacheEntry->getFilepath()) {
-    _cacheEntry = cacheEntry;
-}
-
-KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
-    {
-        // We are doing a lot of work here just to get descriptor data
-        ktx::StoragePointer storage{ new storage::FileStorage(_filename.c_str()) };
-        auto ktxPointer = ktx::KTX::create(storage);
-        _ktxDescriptor.reset(new ktx::KTXDescriptor(ktxPointer->toDescriptor()));
-        if (_ktxDescriptor->images.size() < _ktxDescriptor->header.numberOfMipmapLevels) {
-            qWarning() << "Bad images found in ktx";
-        }
-
-        _offsetToMinMipKV = _ktxDescriptor->getValueOffsetForKey(ktx::HIFI_MIN_POPULATED_MIP_KEY);
-        if (_offsetToMinMipKV) {
-            auto data = storage->data() + ktx::KTX_HEADER_SIZE + _offsetToMinMipKV;
-            _minMipLevelAvailable = *data;
-        } else {
-            // Assume all mip levels are available
-            _minMipLevelAvailable = 0;
-        }
-    }
-
-
-    // now that we know the ktx, let's get the header info to configure this Texture::Storage:
-    Format mipFormat = Format::COLOR_BGRA_32;
-    Format texelFormat = Format::COLOR_SRGBA_32;
-    if (Texture::evalTextureFormat(_ktxDescriptor->header, mipFormat, texelFormat)) {
-        _format = mipFormat;
-    }
-}
-
 // maybeOpenFile should be called with _cacheFileMutex already held to avoid modifying the file from multiple threads
 std::shared_ptr<storage::FileStorage> KtxStorage::maybeOpenFile() const {
     // Try to get the shared_ptr
@@ -270,7 +259,9 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
     }
-    return storageView->toMemoryStorage();
+    // The view keeps the file mapped for as long as it is held, so the mip is never copied out of the file.
+    // Only the levels below _minMipLevelAvailable are ever written by assignMipData, never a level handed out here.
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -346,11 +337,6 @@ bool validKtx(const storage::StoragePointer& storage) {
     return true;
 }
 
-bool validKtx(const std::string& filename) {
-    ktx::StoragePointer storage{ new storage::FileStorage(filename.c_str()) };
-    return validKtx(storage);
-}
-
 void Texture::setKtxBacking(const storage::StoragePointer& storage) {
     // Check the KTX file for validity before using it as backing storage
     if (!validKtx(storage)) {
@@ -362,22 +348,24 @@ void Texture::setKtxBacking(const storage::StoragePointer& storage) {
 }
 
 void Texture::setKtxBacking(const std::string& filename) {
-    // Check the KTX file for validity before using it as backing storage
-    if (!validKtx(filename)) {
+    // Check the KTX file for validity before using it as backing storage, parsing it only once
+    auto ktxPointer = ktx::KTX::createMapped(filename);
+    if (!ktxPointer) {
         return;
     }
 
-    auto newBacking = std::unique_ptr<Storage>(new KtxStorage(filename));
+    auto newBacking = std::unique_ptr<Storage>(new KtxStorage(filename, *ktxPointer));
     setStorage(newBacking);
 }
 
 void Texture::setKtxBacking(const cache::FilePointer& cacheEntry) {
-    // Check the KTX file for validity before using it as backing storage
-    if (!validKtx(cacheEntry->getFilepath())) {
+    // Check the KTX file for validity before using it as backing storage, parsing it only once
+    auto ktxPointer = ktx::KTX::createMapped(cacheEntry->getFilepath());
+    if (!ktxPointer) {
         return;
     }
 
-    auto newBacking = std::unique_ptr<Storage>(new KtxStorage(cacheEntry));
+    auto newBacking = std::unique_ptr<Storage>(new KtxStorage(cacheEntry, *ktxPointer));
     setStorage(newBacking);
 }
 
@@ -573,14 +561,15 @@ TexturePointer Texture::build(const ktx::KTXDescriptor& descriptor) {
 }
 
 TexturePointer Texture::unserialize(const cache::FilePointer& cacheEntry, const std::string& source) {
-    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(cacheEntry->getFilepath().c_str()));
+    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::createMapped(cacheEntry->getFilepath());
     if (!ktxPointer) {
         return nullptr;
     }
 
     auto texture = build(ktxPointer->toDescriptor());
     if (texture) {
-        texture->setKtxBacking(cacheEntry);
+        auto newBacking = std::unique_ptr<Storage>(new KtxStorage(cacheEntry, *ktxPointer));
+        texture->setStorage(newBacking);
         if (texture->source().empty()) {
             texture->setSource(source);
         }
@@ -590,14 +579,15 @@ TexturePointer Texture::unserialize(const cache::FilePointer& cacheEntry, const
 }
 
 TexturePointer Texture::unserialize(const std::string& ktxfile) {
-    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(ktxfile.c_str()));
+    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::createMapped(ktxfile);
     if (!ktxPointer) {
         return nullptr;
     }
 
     auto texture = build(ktxPointer->toDescriptor());
     if (texture) {
-        texture->setKtxBacking(ktxfile);
+        auto newBacking = std::unique_ptr<Storage>(new KtxStorage(ktxfile, *ktxPointer));
+        texture->setStorage(newBacking);
         texture->setSource(ktxfile);
     }
 
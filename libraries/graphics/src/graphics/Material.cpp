@@ -263,6 +263,29 @@ MultiMaterial::MultiMaterial() {
     _schemaBuffer = gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(Schema), (const gpu::Byte*) &schema, sizeof(Schema)));
 }
 
+MultiMaterial::MultiMaterial(const MultiMaterial& other) : MaterialLayerQueue(other) {
+    *this = other;
+}
+
+MultiMaterial& MultiMaterial::operator=(const MultiMaterial& other) {
+    if (this == &other) {
+        return *this;
+    }
+    // Each copy gets a lock of its own
+    std::lock_guard<std::mutex> lock(other._updateMutex);
+    MaterialLayerQueue::operator=(other);
+    _schemaBuffer = other._schemaBuffer;
+    _cullFaceMode = other._cullFaceMode;
+    _textureTable = other._textureTable;
+    _needsUpdate = other._needsUpdate.load();
+    _texturesLoading = other._texturesLoading.load();
+    _initialized = other._initialized.load();
+    _textureSize = other._textureSize;
+    _textureCount = other._textureCount;
+    _hasCalculatedTextureInfo = other._hasCalculatedTextureInfo;
+    return *this;
+}
+
 void MultiMaterial::calculateMaterialInfo() const {
     if (!_hasCalculatedTextureInfo) {
         bool allTextures = true; // assume we got this...
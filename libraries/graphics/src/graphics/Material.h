@@ -11,6 +11,7 @@
 #ifndef hifi_model_Material_h
 #define hifi_model_Material_h
 
+#include <atomic>
 #include <mutex>
 #include <bitset>
 #include <map>
@@ -480,6 +481,8 @@ typedef std::priority_queue<MaterialLayer, std::vector<MaterialLayer>, MaterialL
 class MultiMaterial : public MaterialLayerQueue {
 public:
     MultiMaterial();
+    MultiMaterial(const MultiMaterial& other);
+    MultiMaterial& operator=(const MultiMaterial& other);
 
     void push(const MaterialLayer& value) {
         MaterialLayerQueue::push(value);
@@ -548,6 +551,8 @@ public:
     void setInitialized() { _initialized = true; }
 
     bool shouldUpdate() const { return !_initialized || _needsUpdate || _texturesLoading; }
+    // Held while the schema and textures are updated, the same material can be drawn by batches recorded on several threads
+    std::mutex& getUpdateMutex() const { return _updateMutex; }
 
     int getTextureCount() const { calculateMaterialInfo(); return _textureCount; }
     size_t getTextureSize()  const { calculateMaterialInfo(); return _textureSize; }
@@ -557,9 +562,10 @@ private:
     gpu::BufferView _schemaBuffer;
     graphics::MaterialKey::CullFaceMode _cullFaceMode { graphics::Material::DEFAULT_CULL_FACE_MODE };
     gpu::TextureTablePointer _textureTable { std::make_shared<gpu::TextureTable>() };
-    bool _needsUpdate { false };
-    bool _texturesLoading { false };
-    bool _initialized { false };
+    std::atomic<bool> _needsUpdate { false };
+    std::atomic<bool> _texturesLoading { false };
+    std::atomic<bool> _initialized { false };
+    mutable std::mutex _updateMutex;
 
     mutable size_t _textureSize { 0 };
     mutable int _textureCount { 0 };
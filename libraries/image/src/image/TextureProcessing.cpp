@@ -11,6 +11,8 @@
 
 #include "TextureProcessing.h"
 
+#include <mutex>
+
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
@@ -23,6 +25,9 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
+
+#include <tbb/task_arena.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -46,6 +51,13 @@ bool DEV_DECIMATE_TEXTURES = false;
 std::atomic<size_t> DECIMATED_TEXTURE_COUNT{ 0 };
 std::atomic<size_t> RECTIFIED_TEXTURE_COUNT{ 0 };
 
+// All texture compression runs in this arena, so the number of threads compressing textures stays bounded
+// however many textures are being processed at once
+static std::shared_ptr<tbb::task_arena> TEXTURE_COMPRESSION_ARENA { std::make_shared<tbb::task_arena>() };
+
+// The faces and mips of a texture are compressed in parallel, but its storage can only take one of them at a time
+static std::mutex TEXTURE_ASSIGNMENT_MUTEX;
+
 // we use a ref here to work around static order initialization
 // possibly causing the element not to be constructed yet
 static const auto& GPU_CUBEMAP_DEFAULT_FORMAT = gpu::Element::COLOR_SRGBA_32;
@@ -53,6 +65,18 @@ static const auto& GPU_CUBEMAP_HDR_FORMAT = gpu::Element::COLOR_R11G11B10;
 
 namespace image {
 
+void setTextureCompressionConcurrency(int maxThreads) {
+    // textures already being compressed finish in the arena they started in
+    auto arena = std::make_shared<tbb::task_arena>(maxThreads > 0 ? maxThreads : (int)tbb::task_arena::automatic);
+    std::atomic_store(&TEXTURE_COMPRESSION_ARENA, arena);
+}
+
+template <typename F>
+void runTextureCompression(F&& function) {
+    auto arena = std::atomic_load(&TEXTURE_COMPRESSION_ARENA);
+    arena->execute(std::forward<F>(function));
+}
+
 uint rectifyDimension(const uint& dimension) {
     if (dimension == 0) {
         return 0;
@@ -440,13 +464,16 @@ struct OutputHandler : public nvtt::OutputHandler {
     }
 
     virtual void endImage() override {
+        storage::StoragePointer storage = std::make_shared<storage::MemoryStorage>(_size, static_cast<const gpu::Byte*>(_data));
+        free(_data);
+        _data = nullptr;
+
+        std::lock_guard<std::mutex> lock(TEXTURE_ASSIGNMENT_MUTEX);
         if (_face >= 0) {
-            _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
+            _texture->assignStoredMipFace(_miplevel, _face, storage);
         } else {
-            _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
+            _texture->assignStoredMip(_miplevel, storage);
         }
-        free(_data);
-        _data = nullptr;
     }
 
     gpu::Byte* _data{ nullptr };
@@ -501,23 +528,63 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
 };
 
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        // nvtt splits the blocks of an image into count independent tasks
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
+
+using OutputHandlerFactory = std::function<std::unique_ptr<nvtt::OutputHandler>()>;
+
+// Compresses the surface and, when buildMips is set, the mip chain built down from it.
+// The mips are built first, then compressed in parallel, each with its own handler from makeOutputHandler.
+void compressSurfaceWithMips(const nvtt::Surface& surface, int face, int baseMipLevel, bool buildMips,
+                             const nvtt::CompressionOptions& compressionOptions, const OutputHandlerFactory& makeOutputHandler,
+                             const std::atomic<bool>& abortProcessing) {
+    // nvtt surfaces share their pixels until modified without thread safe reference counting, so every mip
+    // is built here, on one thread, into a surface of its own before any of them is handed to another thread
+    std::vector<nvtt::Surface> mipSurfaces { surface };
+    if (buildMips) {
+        PROFILE_RANGE(resource_parse, "buildMips");
+        while (mipSurfaces.back().canMakeNextMipmap() && !abortProcessing.load()) {
+            nvtt::Surface nextMip = mipSurfaces.back();
+            nextMip.buildNextMipmap(nvtt::MipmapFilter_Box);
+            mipSurfaces.push_back(nextMip);
+        }
+    }
+
+    runTextureCompression([&] {
+        tbb::parallel_for(0, (int)mipSurfaces.size(), [&](int mip) {
+            if (abortProcessing.load()) {
+                return;
+            }
+
+            auto outputHandler = makeOutputHandler();
+            nvtt::OutputOptions outputOptions;
+            outputOptions.setOutputHeader(false);
+            outputOptions.setOutputHandler(outputHandler.get());
+            MyErrorHandler errorHandler;
+            outputOptions.setErrorHandler(&errorHandler);
+
+            ParallelTaskDispatcher dispatcher(abortProcessing);
+            nvtt::Compressor compressor;
+            compressor.setTaskDispatcher(&dispatcher);
+
+            compressor.compress(mipSurfaces[mip], face, baseMipLevel + mip, compressionOptions, outputOptions);
+        });
+    });
+}
 #endif
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
@@ -604,35 +671,21 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     const int width = localCopy.getWidth();
     const int height = localCopy.getHeight();
 
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHeader(false);
-
     nvtt::CompressionOptions compressionOptions;
-    std::unique_ptr<nvtt::OutputHandler> outputHandler{ getNVTTCompressionOutputHandler(texture, face, compressionOptions) };
-
-    MyErrorHandler errorHandler;
-    outputOptions.setErrorHandler(&errorHandler);
-    nvtt::Context context;
-    int mipLevel = baseMipLevel;
-
-    outputOptions.setOutputHandler(outputHandler.get());
+    // set up the compression options, the handler itself is only needed to know the format is supported
+    if (!std::unique_ptr<nvtt::OutputHandler>(getNVTTCompressionOutputHandler(texture, face, compressionOptions))) {
+        return;
+    }
 
     nvtt::Surface surface;
     surface.setImage(nvtt::InputFormat_RGBA_32F, width, height, 1, localCopy.getBits());
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
-    context.setTaskDispatcher(&dispatcher);
-
-    context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-    if (buildMips) {
-        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-            context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        }
-    }
+    compressSurfaceWithMips(surface, face, baseMipLevel, buildMips, compressionOptions, [texture, face] {
+        nvtt::CompressionOptions mipCompressionOptions;
+        return std::unique_ptr<nvtt::OutputHandler>(getNVTTCompressionOutputHandler(texture, face, mipCompressionOptions));
+    }, abortProcessing);
 }
 
 void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
@@ -752,23 +805,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             return;
         }
 
-        nvtt::OutputOptions outputOptions;
-        outputOptions.setOutputHeader(false);
-        OutputHandler outputHandler(texture, face);
-        outputOptions.setOutputHandler(&outputHandler);
-        MyErrorHandler errorHandler;
-        outputOptions.setErrorHandler(&errorHandler);
-
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
-
-        context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        if (buildMips) {
-            while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-                context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-            }
-        }
+        compressSurfaceWithMips(surface, face, mipLevel, buildMips, compressionOptions, [texture, face] {
+            return std::unique_ptr<nvtt::OutputHandler>(new OutputHandler(texture, face));
+        }, abortProcessing);
     } else {
         int numMips = 1;
     
@@ -822,6 +861,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             mipMaps, &encodingTime
         );
 
+        std::lock_guard<std::mutex> lock(TEXTURE_ASSIGNMENT_MUTEX);
         for (int i = 0; i < numMips; i++) {
             if (mipMaps[i].paucEncodingBits.get()) {
                 if (face >= 0) {
@@ -1491,11 +1531,15 @@ void convolveForGGX(const std::vector<Image>& faces, gpu::Texture* texture, Back
         output.applyGamma(1.0f/2.2f);
     }
 
-    for (int face = 0; face < 6; face++) {
-        for (gpu::uint16 mipLevel = 0; mipLevel < output.getMipCount(); mipLevel++) {
+    const int NUM_FACES = 6;
+    const int mipCount = output.getMipCount();
+    runTextureCompression([&] {
+        tbb::parallel_for(0, NUM_FACES * mipCount, [&](int faceMip) {
+            int face = faceMip / mipCount;
+            gpu::uint16 mipLevel = faceMip % mipCount;
             convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
-        }
-    }
+        });
+    });
 }
 
 gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcImage, const std::string& srcImageName,
@@ -1600,11 +1644,12 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
             // Performs and convolution AND mip map generation
             convolveForGGX(faces, theTexture.get(), target, abortProcessing);
         } else {
-            // Create mip maps and compress to final format in one go
-            for (uint8 face = 0; face < faces.size(); ++face) {
-                // Force building the mip maps right now on CPU if we are convolving for GGX later on
-                convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
-            }
+            // Create mip maps and compress to final format in one go, for every face at once
+            runTextureCompression([&] {
+                tbb::parallel_for(0, (int)faces.size(), [&](int face) {
+                    convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
+                });
+            });
         }
     }
 
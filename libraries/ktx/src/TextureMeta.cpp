@@ -37,6 +37,9 @@ bool TextureMeta::deserialize(const QByteArray& data, TextureMeta* meta) {
     if (root.contains("uncompressed")) {
         meta->uncompressed = root["uncompressed"].toString();
     }
+    if (root.contains("universal")) {
+        meta->universal = root["universal"].toString();
+    }
     if (root.contains("compressed")) {
         auto compressed = root["compressed"].toObject();
         for (auto it = compressed.constBegin(); it != compressed.constEnd(); it++) {
@@ -65,6 +68,9 @@ QByteArray TextureMeta::serialize() {
     }
     root["original"] = original.toString();
     root["uncompressed"] = uncompressed.toString();
+    if (!universal.isEmpty()) {
+        root["universal"] = universal.toString();
+    }
     root["compressed"] = compressed;
     root["version"] = KTX_VERSION;
     doc.setObject(root);
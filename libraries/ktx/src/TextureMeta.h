@@ -37,6 +37,8 @@ struct TextureMeta {
 
     QUrl original;
     QUrl uncompressed;
+    // A universal KTX, transcoded at load time to whichever compressed format the GPU supports
+    QUrl universal;
     std::unordered_map<khronos::gl::texture::InternalFormat, QUrl> availableTextureTypes;
     uint16_t version { 0 };
 };
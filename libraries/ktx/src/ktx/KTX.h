@@ -360,6 +360,8 @@ namespace ktx {
 
         // Parse a block of memory and create a KTX object from it
         static std::unique_ptr<KTX> create(const StoragePointer& src);
+        // Map a KTX file read only and parse it in place, the images are views into the mapping and are not copied
+        static std::unique_ptr<KTX> createMapped(const std::string& filename);
 
         static bool checkHeaderFromStorage(size_t srcSize, const Byte* srcBytes);
         static KeyValues parseKeyValues(size_t srcSize, const Byte* srcBytes);
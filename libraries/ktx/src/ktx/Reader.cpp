@@ -210,4 +210,10 @@ namespace ktx {
 
         return result;
     }
+
+    std::unique_ptr<KTX> KTX::createMapped(const std::string& filename) {
+        StoragePointer src = std::make_shared<storage::FileStorage>(QString::fromStdString(filename),
+                                                                    storage::FileStorage::Access::ReadOnly);
+        return create(src);
+    }
 }
@@ -0,0 +1,892 @@
+//
+//  Universal.cpp
+//  ktx/src/ktx
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Universal.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDebug>
+
+using namespace ktx;
+
+const UniversalHeader::Identifier UniversalHeader::IDENTIFIER {{
+    0xAB, 0x48, 0x46, 0x55, 0x20, 0x31, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+}};
+
+static const uint32_t BLOCK_DIMENSION { 4 };
+static const size_t ETC1S_BLOCK_SIZE { 8 };
+static const uint32_t MAX_UNIVERSAL_LEVELS { 16 };
+
+namespace {
+
+    // ETC1 intensity tables, a selector picks +small, +large, -small or -large
+    const int ETC1_MODIFIERS[8][2] = {
+        { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+    };
+
+    // EAC alpha modifier tables
+    const int EAC_MODIFIERS[16][8] = {
+        { -3, -6, -9, -15, 2, 5, 8, 14 },
+        { -3, -7, -10, -13, 2, 6, 9, 12 },
+        { -2, -5, -8, -13, 1, 4, 7, 12 },
+        { -2, -4, -6, -13, 1, 3, 5, 12 },
+        { -3, -6, -8, -12, 2, 5, 7, 11 },
+        { -3, -7, -9, -11, 2, 6, 8, 10 },
+        { -4, -7, -8, -11, 3, 6, 7, 10 },
+        { -3, -5, -8, -11, 2, 4, 7, 10 },
+        { -2, -6, -8, -10, 1, 5, 7, 9 },
+        { -2, -5, -8, -10, 1, 4, 7, 9 },
+        { -2, -4, -8, -10, 1, 3, 7, 9 },
+        { -2, -5, -7, -10, 1, 4, 6, 9 },
+        { -3, -4, -7, -10, 2, 3, 6, 9 },
+        { -1, -2, -3, -10, 0, 1, 2, 9 },
+        { -4, -6, -8, -9, 3, 5, 7, 8 },
+        { -3, -5, -7, -9, 2, 4, 6, 8 }
+    };
+
+    inline int clampByte(int value) {
+        return std::min(std::max(value, 0), 255);
+    }
+
+    inline int etc1Modifier(int table, int selector) {
+        int value = ETC1_MODIFIERS[table][selector & 1];
+        return (selector & 2) ? -value : value;
+    }
+
+    inline int expand5(int value) {
+        return (value << 3) | (value >> 2);
+    }
+
+    inline int quantize5(int value) {
+        return (clampByte(value) * 31 + 127) / 255;
+    }
+
+    // An ETC1 block in differential mode with no difference between its halves and the same table for both
+    struct Etc1sBlock {
+        int base[3]; // 5 bits per channel
+        int table;
+        uint8_t selectors[16]; // row major
+    };
+
+    void packEtc1sBlock(const Etc1sBlock& block, Byte* dest) {
+        dest[0] = (Byte)(block.base[0] << 3);
+        dest[1] = (Byte)(block.base[1] << 3);
+        dest[2] = (Byte)(block.base[2] << 3);
+        // both tables, differential bit set, flip bit clear
+        dest[3] = (Byte)((block.table << 5) | (block.table << 2) | 0x2);
+
+        // ETC orders the pixels by columns
+        uint32_t msb = 0;
+        uint32_t lsb = 0;
+        for (uint32_t y = 0; y < BLOCK_DIMENSION; ++y) {
+            for (uint32_t x = 0; x < BLOCK_DIMENSION; ++x) {
+                uint32_t selector = block.selectors[y * BLOCK_DIMENSION + x];
+                uint32_t bit = x * BLOCK_DIMENSION + y;
+                msb |= ((selector >> 1) & 1) << bit;
+                lsb |= (selector & 1) << bit;
+            }
+        }
+        dest[4] = (Byte)(msb >> 8);
+        dest[5] = (Byte)msb;
+        dest[6] = (Byte)(lsb >> 8);
+        dest[7] = (Byte)lsb;
+    }
+
+    void unpackEtc1sBlock(const Byte* src, Etc1sBlock& block) {
+        block.base[0] = src[0] >> 3;
+        block.base[1] = src[1] >> 3;
+        block.base[2] = src[2] >> 3;
+        block.table = src[3] >> 5;
+
+        uint32_t msb = ((uint32_t)src[4] << 8) | src[5];
+        uint32_t lsb = ((uint32_t)src[6] << 8) | src[7];
+        for (uint32_t y = 0; y < BLOCK_DIMENSION; ++y) {
+            for (uint32_t x = 0; x < BLOCK_DIMENSION; ++x) {
+                uint32_t bit = x * BLOCK_DIMENSION + y;
+                block.selectors[y * BLOCK_DIMENSION + x] = (uint8_t)((((msb >> bit) & 1) << 1) | ((lsb >> bit) & 1));
+            }
+        }
+    }
+
+    void evalEtc1sPalette(const Etc1sBlock& block, int palette[4][3]) {
+        for (int selector = 0; selector < 4; ++selector) {
+            int modifier = etc1Modifier(block.table, selector);
+            for (int channel = 0; channel < 3; ++channel) {
+                palette[selector][channel] = clampByte(expand5(block.base[channel]) + modifier);
+            }
+        }
+    }
+
+    // Try every table, each with the base at the mean of the block and then at the mean of the pixels minus the
+    // modifiers picked for them, and keep the closest
+    void encodeEtc1sBlock(const int pixels[16][3], int numChannels, Etc1sBlock& result) {
+        int mean[3] { 0, 0, 0 };
+        for (int pixel = 0; pixel < 16; ++pixel) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                mean[channel] += pixels[pixel][channel];
+            }
+        }
+        for (int channel = 0; channel < numChannels; ++channel) {
+            mean[channel] = (mean[channel] + 8) / 16;
+        }
+
+        int bestError = INT_MAX;
+        for (int table = 0; table < 8 && bestError > 0; ++table) {
+            Etc1sBlock candidate;
+            candidate.table = table;
+            for (int channel = 0; channel < 3; ++channel) {
+                candidate.base[channel] = quantize5(mean[std::min(channel, numChannels - 1)]);
+            }
+
+            for (int pass = 0; pass < 2; ++pass) {
+                int palette[4][3];
+                evalEtc1sPalette(candidate, palette);
+
+                int error = 0;
+                for (int pixel = 0; pixel < 16; ++pixel) {
+                    int bestPixelError = INT_MAX;
+                    for (int selector = 0; selector < 4; ++selector) {
+                        int pixelError = 0;
+                        for (int channel = 0; channel < numChannels; ++channel) {
+                            int delta = pixels[pixel][channel] - palette[selector][channel];
+                            pixelError += delta * delta;
+                        }
+                        if (pixelError < bestPixelError) {
+                            bestPixelError = pixelError;
+                            candidate.selectors[pixel] = (uint8_t)selector;
+                        }
+                    }
+                    error += bestPixelError;
+                }
+
+                if (error < bestError) {
+                    bestError = error;
+                    result = candidate;
+                }
+
+                for (int channel = 0; channel < numChannels; ++channel) {
+                    int sum = 0;
+                    for (int pixel = 0; pixel < 16; ++pixel) {
+                        sum += pixels[pixel][channel] - etc1Modifier(table, candidate.selectors[pixel]);
+                    }
+                    candidate.base[channel] = quantize5((sum + 8) / 16);
+                }
+                for (int channel = numChannels; channel < 3; ++channel) {
+                    candidate.base[channel] = candidate.base[0];
+                }
+            }
+        }
+    }
+
+    inline uint16_t pack565(const int color[3]) {
+        int r = (color[0] * 31 + 127) / 255;
+        int g = (color[1] * 63 + 127) / 255;
+        int b = (color[2] * 31 + 127) / 255;
+        return (uint16_t)((r << 11) | (g << 5) | b);
+    }
+
+    inline void unpack565(uint16_t packed, int color[3]) {
+        int r = (packed >> 11) & 0x1F;
+        int g = (packed >> 5) & 0x3F;
+        int b = packed & 0x1F;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    // The +large and -large colors of an ETC1S block are the ends of the line its 4 colors are on,
+    // so they become the BC1 endpoints and each selector maps to the closest of the 4 BC1 colors
+    void transcodeEtc1sToBC1(const Etc1sBlock& block, Byte* dest) {
+        int palette[4][3];
+        evalEtc1sPalette(block, palette);
+
+        uint16_t color0 = pack565(palette[1]);
+        uint16_t color1 = pack565(palette[3]);
+        if (color0 < color1) {
+            std::swap(color0, color1);
+        }
+
+        uint8_t selectorMap[4] { 0, 0, 0, 0 };
+        if (color0 != color1) {
+            int bcPalette[4][3];
+            unpack565(color0, bcPalette[0]);
+            unpack565(color1, bcPalette[1]);
+            for (int channel = 0; channel < 3; ++channel) {
+                bcPalette[2][channel] = (2 * bcPalette[0][channel] + bcPalette[1][channel]) / 3;
+                bcPalette[3][channel] = (bcPalette[0][channel] + 2 * bcPalette[1][channel]) / 3;
+            }
+            for (int selector = 0; selector < 4; ++selector) {
+                int bestError = INT_MAX;
+                for (int index = 0; index < 4; ++index) {
+                    int error = 0;
+                    for (int channel = 0; channel < 3; ++channel) {
+                        int delta = palette[selector][channel] - bcPalette[index][channel];
+                        error += delta * delta;
+                    }
+                    if (error < bestError) {
+                        bestError = error;
+                        selectorMap[selector] = (uint8_t)index;
+                    }
+                }
+            }
+        }
+
+        uint32_t indices = 0;
+        for (int pixel = 0; pixel < 16; ++pixel) {
+            indices |= (uint32_t)selectorMap[block.selectors[pixel]] << (2 * pixel);
+        }
+        dest[0] = (Byte)color0;
+        dest[1] = (Byte)(color0 >> 8);
+        dest[2] = (Byte)color1;
+        dest[3] = (Byte)(color1 >> 8);
+        dest[4] = (Byte)indices;
+        dest[5] = (Byte)(indices >> 8);
+        dest[6] = (Byte)(indices >> 16);
+        dest[7] = (Byte)(indices >> 24);
+    }
+
+    // An alpha ETC1S block only has 32 bases times 8 tables, so its BC4 and EAC equivalents are looked up
+    struct AlphaBlockMapping {
+        uint8_t header[2];
+        uint8_t selectorMap[4];
+    };
+
+    struct AlphaTables {
+        static const int COUNT { 32 * 8 };
+        AlphaBlockMapping bc4[COUNT];
+        AlphaBlockMapping eac[COUNT];
+
+        AlphaTables() {
+            for (int base = 0; base < 32; ++base) {
+                for (int table = 0; table < 8; ++table) {
+                    int values[4];
+                    for (int selector = 0; selector < 4; ++selector) {
+                        values[selector] = clampByte(expand5(base) + etc1Modifier(table, selector));
+                    }
+                    buildBC4(values, bc4[base * 8 + table]);
+                    buildEAC(values, eac[base * 8 + table]);
+                }
+            }
+        }
+
+        static void buildBC4(const int values[4], AlphaBlockMapping& mapping) {
+            int alpha0 = *std::max_element(values, values + 4);
+            int alpha1 = *std::min_element(values, values + 4);
+            mapping.header[0] = (uint8_t)alpha0;
+            mapping.header[1] = (uint8_t)alpha1;
+
+            int palette[8] { alpha0, alpha1 };
+            for (int index = 2; index < 8; ++index) {
+                palette[index] = ((8 - index) * alpha0 + (index - 1) * alpha1) / 7;
+            }
+            for (int selector = 0; selector < 4; ++selector) {
+                int bestIndex = 0;
+                for (int index = 1; index < 8; ++index) {
+                    if (std::abs(values[selector] - palette[index]) < std::abs(values[selector] - palette[bestIndex])) {
+                        bestIndex = index;
+                    }
+                }
+                mapping.selectorMap[selector] = (uint8_t)(alpha0 == alpha1 ? 0 : bestIndex);
+            }
+        }
+
+        static void buildEAC(const int values[4], AlphaBlockMapping& mapping) {
+            int low = *std::min_element(values, values + 4);
+            int high = *std::max_element(values, values + 4);
+            int bestError = INT_MAX;
+            for (int table = 0; table < 16 && bestError > 0; ++table) {
+                const int* modifiers = EAC_MODIFIERS[table];
+                int modifierLow = *std::min_element(modifiers, modifiers + 8);
+                int modifierHigh = *std::max_element(modifiers, modifiers + 8);
+                for (int multiplier = 1; multiplier < 16; ++multiplier) {
+                    int centeredBase = (low + high) / 2 - ((modifierLow + modifierHigh) * multiplier) / 2;
+                    for (int base = centeredBase - 1; base <= centeredBase + 1; ++base) {
+                        int clampedBase = clampByte(base);
+                        int error = 0;
+                        uint8_t selectorMap[4];
+                        for (int selector = 0; selector < 4; ++selector) {
+                            int bestValueError = INT_MAX;
+                            for (int index = 0; index < 8; ++index) {
+                                int delta = values[selector] - clampByte(clampedBase + modifiers[index] * multiplier);
+                                if (delta * delta < bestValueError) {
+                                    bestValueError = delta * delta;
+                                    selectorMap[selector] = (uint8_t)index;
+                                }
+                            }
+                            error += bestValueError;
+                        }
+                        if (error < bestError) {
+                            bestError = error;
+                            mapping.header[0] = (uint8_t)clampedBase;
+                            mapping.header[1] = (uint8_t)((multiplier << 4) | table);
+                            std::copy(selectorMap, selectorMap + 4, mapping.selectorMap);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    const AlphaTables& getAlphaTables() {
+        static const AlphaTables tables;
+        return tables;
+    }
+
+    const AlphaBlockMapping OPAQUE_BC4 { { 255, 255 }, { 0, 0, 0, 0 } };
+    // Table 13 has a zero modifier at index 4
+    const AlphaBlockMapping OPAQUE_EAC { { 255, (1 << 4) | 13 }, { 4, 4, 4, 4 } };
+
+    void writeBC4Block(const AlphaBlockMapping& mapping, const uint8_t* selectors, Byte* dest) {
+        dest[0] = mapping.header[0];
+        dest[1] = mapping.header[1];
+        uint64_t indices = 0;
+        for (int pixel = 0; pixel < 16; ++pixel) {
+            indices |= (uint64_t)mapping.selectorMap[selectors[pixel]] << (3 * pixel);
+        }
+        for (int i = 0; i < 6; ++i) {
+            dest[2 + i] = (Byte)(indices >> (8 * i));
+        }
+    }
+
+    void writeEACBlock(const AlphaBlockMapping& mapping, const uint8_t* selectors, Byte* dest) {
+        dest[0] = mapping.header[0];
+        dest[1] = mapping.header[1];
+        uint64_t indices = 0;
+        for (uint32_t y = 0; y < BLOCK_DIMENSION; ++y) {
+            for (uint32_t x = 0; x < BLOCK_DIMENSION; ++x) {
+                uint32_t pixel = x * BLOCK_DIMENSION + y;
+                indices |= (uint64_t)mapping.selectorMap[selectors[y * BLOCK_DIMENSION + x]] << (45 - 3 * pixel);
+            }
+        }
+        for (int i = 0; i < 6; ++i) {
+            dest[2 + i] = (Byte)(indices >> (40 - 8 * i));
+        }
+    }
+
+    const uint8_t OPAQUE_SELECTORS[16] { 0 };
+
+    void encodeFace(const Byte* pixels, uint32_t width, uint32_t height, uint32_t numChannels, bool isBGRA, bool hasAlpha,
+                    Byte* dest) {
+        const uint32_t blocksWide = (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+        const uint32_t blocksHigh = (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+        const size_t rowSize = evalPaddedSize(width * numChannels);
+        const int red = isBGRA ? 2 : 0;
+        const int blue = isBGRA ? 0 : 2;
+
+        Byte* colorDest = dest;
+        Byte* alphaDest = dest + blocksWide * blocksHigh * ETC1S_BLOCK_SIZE;
+        for (uint32_t blockY = 0; blockY < blocksHigh; ++blockY) {
+            for (uint32_t blockX = 0; blockX < blocksWide; ++blockX) {
+                int colors[16][3];
+                int alphas[16][3];
+                for (uint32_t y = 0; y < BLOCK_DIMENSION; ++y) {
+                    // Partial blocks repeat the last row and column
+                    uint32_t pixelY = std::min(blockY * BLOCK_DIMENSION + y, height - 1);
+                    for (uint32_t x = 0; x < BLOCK_DIMENSION; ++x) {
+                        uint32_t pixelX = std::min(blockX * BLOCK_DIMENSION + x, width - 1);
+                        const Byte* pixel = pixels + pixelY * rowSize + pixelX * numChannels;
+                        int* color = colors[y * BLOCK_DIMENSION + x];
+                        if (numChannels == 1) {
+                            // grey, so the block's base is the same in all channels
+                            color[0] = color[1] = color[2] = pixel[0];
+                        } else if (numChannels == 2) {
+                            color[0] = pixel[0];
+                            color[1] = pixel[1];
+                            color[2] = 0;
+                        } else {
+                            color[0] = pixel[red];
+                            color[1] = pixel[1];
+                            color[2] = pixel[blue];
+                            alphas[y * BLOCK_DIMENSION + x][0] = pixel[3];
+                        }
+                    }
+                }
+
+                Etc1sBlock block;
+                encodeEtc1sBlock(colors, std::min(numChannels, 3U), block);
+                packEtc1sBlock(block, colorDest);
+                colorDest += ETC1S_BLOCK_SIZE;
+
+                if (hasAlpha) {
+                    encodeEtc1sBlock(alphas, 1, block);
+                    packEtc1sBlock(block, alphaDest);
+                    alphaDest += ETC1S_BLOCK_SIZE;
+                }
+            }
+        }
+    }
+
+    size_t evalTargetFaceSize(UniversalKTX::Target target, uint32_t width, uint32_t height, uint32_t numChannels,
+                              size_t blockCount) {
+        switch (target) {
+            case UniversalKTX::Target::BC1:
+            case UniversalKTX::Target::BC4:
+            case UniversalKTX::Target::ETC2_RGB:
+            case UniversalKTX::Target::EAC_R11:
+                return blockCount * 8;
+            case UniversalKTX::Target::BC3:
+            case UniversalKTX::Target::BC5:
+            case UniversalKTX::Target::ETC2_RGBA:
+            case UniversalKTX::Target::EAC_RG11:
+                return blockCount * 16;
+            case UniversalKTX::Target::UNCOMPRESSED:
+                return evalPaddedSize(width * numChannels) * height;
+            default:
+                return 0;
+        }
+    }
+
+    void transcodeFace(UniversalKTX::Target target, const Byte* src, uint32_t width, uint32_t height, uint32_t numChannels,
+                       bool hasAlpha, Byte* dest) {
+        const uint32_t blocksWide = (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+        const uint32_t blocksHigh = (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+        const size_t blockCount = blocksWide * blocksHigh;
+        const size_t rowSize = evalPaddedSize(width * numChannels);
+        const Byte* colorSrc = src;
+        const Byte* alphaSrc = hasAlpha ? src + blockCount * ETC1S_BLOCK_SIZE : nullptr;
+        const auto& alphaTables = getAlphaTables();
+
+        for (uint32_t blockY = 0; blockY < blocksHigh; ++blockY) {
+            for (uint32_t blockX = 0; blockX < blocksWide; ++blockX) {
+                size_t blockIndex = blockY * blocksWide + blockX;
+                const Byte* colorBlock = colorSrc + blockIndex * ETC1S_BLOCK_SIZE;
+
+                Etc1sBlock alpha;
+                const uint8_t* alphaSelectors = OPAQUE_SELECTORS;
+                int alphaMappingIndex = -1;
+                if (alphaSrc && target != UniversalKTX::Target::BC1 && target != UniversalKTX::Target::ETC2_RGB) {
+                    unpackEtc1sBlock(alphaSrc + blockIndex * ETC1S_BLOCK_SIZE, alpha);
+                    alphaSelectors = alpha.selectors;
+                    alphaMappingIndex = alpha.base[0] * 8 + alpha.table;
+                }
+
+                switch (target) {
+                    case UniversalKTX::Target::ETC2_RGB: {
+                        std::copy(colorBlock, colorBlock + ETC1S_BLOCK_SIZE, dest + blockIndex * 8);
+                        break;
+                    }
+                    case UniversalKTX::Target::ETC2_RGBA: {
+                        Byte* blockDest = dest + blockIndex * 16;
+                        const auto& mapping = alphaMappingIndex < 0 ? OPAQUE_EAC : alphaTables.eac[alphaMappingIndex];
+                        writeEACBlock(mapping, alphaSelectors, blockDest);
+                        std::copy(colorBlock, colorBlock + ETC1S_BLOCK_SIZE, blockDest + 8);
+                        break;
+                    }
+                    case UniversalKTX::Target::BC1: {
+                        Etc1sBlock color;
+                        unpackEtc1sBlock(colorBlock, color);
+                        transcodeEtc1sToBC1(color, dest + blockIndex * 8);
+                        break;
+                    }
+                    case UniversalKTX::Target::BC3: {
+                        Byte* blockDest = dest + blockIndex * 16;
+                        const auto& mapping = alphaMappingIndex < 0 ? OPAQUE_BC4 : alphaTables.bc4[alphaMappingIndex];
+                        writeBC4Block(mapping, alphaSelectors, blockDest);
+                        Etc1sBlock color;
+                        unpackEtc1sBlock(colorBlock, color);
+                        transcodeEtc1sToBC1(color, blockDest + 8);
+                        break;
+                    }
+                    case UniversalKTX::Target::BC4:
+                    case UniversalKTX::Target::EAC_R11:
+                    case UniversalKTX::Target::BC5:
+                    case UniversalKTX::Target::EAC_RG11: {
+                        // Each channel of an ETC1S block has the same table, so it maps to a single channel block
+                        // like alpha does
+                        Etc1sBlock color;
+                        unpackEtc1sBlock(colorBlock, color);
+                        const bool isBC = target == UniversalKTX::Target::BC4 || target == UniversalKTX::Target::BC5;
+                        const bool isRG = target == UniversalKTX::Target::BC5 || target == UniversalKTX::Target::EAC_RG11;
+                        Byte* blockDest = dest + blockIndex * (isRG ? 16 : 8);
+                        for (int channel = 0; channel < (isRG ? 2 : 1); ++channel) {
+                            int mappingIndex = color.base[channel] * 8 + color.table;
+                            if (isBC) {
+                                writeBC4Block(alphaTables.bc4[mappingIndex], color.selectors, blockDest + channel * 8);
+                            } else {
+                                writeEACBlock(alphaTables.eac[mappingIndex], color.selectors, blockDest + channel * 8);
+                            }
+                        }
+                        break;
+                    }
+                    case UniversalKTX::Target::UNCOMPRESSED: {
+                        Etc1sBlock color;
+                        unpackEtc1sBlock(colorBlock, color);
+                        int palette[4][3];
+                        evalEtc1sPalette(color, palette);
+                        int alphaPalette[4][3];
+                        if (alphaMappingIndex >= 0) {
+                            evalEtc1sPalette(alpha, alphaPalette);
+                        }
+                        for (uint32_t y = 0; y < BLOCK_DIMENSION; ++y) {
+                            uint32_t pixelY = blockY * BLOCK_DIMENSION + y;
+                            for (uint32_t x = 0; x < BLOCK_DIMENSION; ++x) {
+                                uint32_t pixelX = blockX * BLOCK_DIMENSION + x;
+                                if (pixelX >= width || pixelY >= height) {
+                                    continue;
+                                }
+                                uint32_t pixel = y * BLOCK_DIMENSION + x;
+                                Byte* texel = dest + (size_t)pixelY * rowSize + (size_t)pixelX * numChannels;
+                                const int* rgb = palette[color.selectors[pixel]];
+                                for (uint32_t channel = 0; channel < std::min(numChannels, 3U); ++channel) {
+                                    texel[channel] = (Byte)rgb[channel];
+                                }
+                                if (numChannels == 4) {
+                                    texel[3] = (Byte)(alphaMappingIndex >= 0 ? alphaPalette[alphaSelectors[pixel]][0] : 255);
+                                }
+                            }
+                        }
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+}
+
+UniversalHeader::UniversalHeader() {
+    memcpy(identifier, IDENTIFIER.data(), IDENTIFIER_LENGTH);
+}
+
+size_t UniversalHeader::evalBlockCount(uint32_t level) const {
+    size_t blocksWide = (evalMipWidth(level) + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    size_t blocksHigh = (evalMipHeight(level) + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    return blocksWide * blocksHigh;
+}
+
+size_t UniversalHeader::evalFaceSize(uint32_t level) const {
+    return evalBlockCount(level) * ETC1S_BLOCK_SIZE * (hasAlpha() ? 2 : 1);
+}
+
+const char* UniversalKTX::toString(Target target) {
+    switch (target) {
+        case Target::BC1: return "BC1";
+        case Target::BC3: return "BC3";
+        case Target::BC4: return "BC4";
+        case Target::BC5: return "BC5";
+        case Target::ETC2_RGB: return "ETC2_RGB";
+        case Target::ETC2_RGBA: return "ETC2_RGBA";
+        case Target::EAC_R11: return "EAC_R11";
+        case Target::EAC_RG11: return "EAC_RG11";
+        case Target::UNCOMPRESSED: return "UNCOMPRESSED";
+        default: return "Invalid";
+    }
+}
+
+bool UniversalKTX::isUniversal(size_t srcSize, const Byte* srcBytes) {
+    return srcSize >= sizeof(UniversalHeader) &&
+        0 == memcmp(srcBytes, UniversalHeader::IDENTIFIER.data(), UniversalHeader::IDENTIFIER_LENGTH);
+}
+
+StoragePointer UniversalKTX::encode(const KTX& source, bool supercompress) {
+    const auto& sourceHeader = source.getHeader();
+    const auto format = sourceHeader.getGLFormat();
+    const auto internalFormat = sourceHeader.getGLInternaFormat();
+    const bool isBGRA = format == GLFormat::BGRA;
+    if (sourceHeader.getGLType() != GLType::UNSIGNED_BYTE) {
+        return nullptr;
+    }
+    uint32_t numChannels;
+    if ((format == GLFormat::RGBA || isBGRA) &&
+        (internalFormat == GLInternalFormat::RGBA8 || internalFormat == GLInternalFormat::SRGB8_ALPHA8)) {
+        numChannels = 4;
+    } else if (format == GLFormat::RG && internalFormat == GLInternalFormat::RG8) {
+        numChannels = 2;
+    } else if (format == GLFormat::RED && internalFormat == GLInternalFormat::R8) {
+        numChannels = 1;
+    } else {
+        return nullptr;
+    }
+    if (sourceHeader.pixelDepth > 0 || sourceHeader.isArray() ||
+        sourceHeader.getNumberOfLevels() > MAX_UNIVERSAL_LEVELS || source._images.size() != sourceHeader.getNumberOfLevels()) {
+        return nullptr;
+    }
+
+    UniversalHeader header;
+    if (!supercompress) {
+        header.supercompressionScheme = UniversalHeader::SUPERCOMPRESSION_NONE;
+    }
+    header.pixelWidth = sourceHeader.getPixelWidth();
+    header.pixelHeight = sourceHeader.getPixelHeight();
+    header.numberOfFaces = sourceHeader.numberOfFaces;
+    header.numberOfMipmapLevels = sourceHeader.getNumberOfLevels();
+    if (internalFormat == GLInternalFormat::SRGB8_ALPHA8) {
+        header.flags |= UniversalHeader::FLAG_SRGB;
+    }
+    if (numChannels == 1) {
+        header.flags |= UniversalHeader::FLAG_RED;
+    } else if (numChannels == 2) {
+        header.flags |= UniversalHeader::FLAG_RG;
+    }
+
+    // Only keep an alpha plane if the first level isn't opaque
+    if (numChannels == 4) {
+        const auto& image = source._images[0];
+        for (const auto& faceBytes : image._faceBytes) {
+            for (uint32_t i = 3; i < image._faceSize && !header.hasAlpha(); i += 4) {
+                if (faceBytes[i] != 255) {
+                    header.flags |= UniversalHeader::FLAG_HAS_ALPHA;
+                }
+            }
+        }
+    }
+
+    std::vector<QByteArray> levelData;
+    std::vector<UniversalLevel> levels(header.numberOfMipmapLevels);
+    for (uint32_t level = 0; level < header.numberOfMipmapLevels; ++level) {
+        const auto& image = source._images[level];
+        const uint32_t width = header.evalMipWidth(level);
+        const uint32_t height = header.evalMipHeight(level);
+        if (image._faceBytes.size() != header.numberOfFaces || image._faceSize < evalPaddedSize(width * numChannels) * height) {
+            return nullptr;
+        }
+
+        const size_t faceSize = header.evalFaceSize(level);
+        QByteArray blocks((int)(faceSize * header.numberOfFaces), 0);
+        for (uint32_t face = 0; face < header.numberOfFaces; ++face) {
+            encodeFace(image._faceBytes[face], width, height, numChannels, isBGRA, header.hasAlpha(),
+                       reinterpret_cast<Byte*>(blocks.data()) + face * faceSize);
+        }
+
+        levels[level].uncompressedByteLength = blocks.size();
+        if (supercompress) {
+            // qCompress prefixes the zlib stream with the uncompressed size, which the level index already holds
+            levelData.push_back(qCompress(blocks).mid(sizeof(quint32)));
+        } else {
+            levelData.push_back(blocks);
+        }
+        levels[level].byteLength = levelData.back().size();
+    }
+
+    const auto& keyValues = source._keyValues;
+    header.bytesOfKeyValueData = KeyValue::serializedKeyValuesByteSize(keyValues);
+
+    size_t offset = sizeof(UniversalHeader) + levels.size() * sizeof(UniversalLevel) + header.bytesOfKeyValueData;
+    for (auto& level : levels) {
+        level.byteOffset = offset;
+        offset += level.byteLength;
+    }
+
+    auto storage = std::make_shared<storage::MemoryStorage>(offset);
+    Byte* dest = storage->data();
+    memcpy(dest, &header, sizeof(UniversalHeader));
+    dest += sizeof(UniversalHeader);
+    memcpy(dest, levels.data(), levels.size() * sizeof(UniversalLevel));
+    dest += levels.size() * sizeof(UniversalLevel);
+    if (header.bytesOfKeyValueData > 0) {
+        KTX::writeKeyValues(dest, header.bytesOfKeyValueData, keyValues);
+        dest += header.bytesOfKeyValueData;
+    }
+    for (const auto& data : levelData) {
+        memcpy(dest, data.constData(), data.size());
+        dest += data.size();
+    }
+    return storage;
+}
+
+std::unique_ptr<UniversalKTX> UniversalKTX::create(const StoragePointer& src) {
+    if (!src || !(*src) || !isUniversal(src->size(), src->data())) {
+        return nullptr;
+    }
+
+    std::unique_ptr<UniversalKTX> result(new UniversalKTX());
+    result->_storage = src;
+    auto& header = result->_header;
+    memcpy(&header, src->data(), sizeof(UniversalHeader));
+    if (header.endianness != Header::ENDIAN_TEST || header.blockFormat != UniversalHeader::BLOCK_FORMAT_ETC1S ||
+        (header.supercompressionScheme != UniversalHeader::SUPERCOMPRESSION_NONE &&
+         header.supercompressionScheme != UniversalHeader::SUPERCOMPRESSION_ZLIB)) {
+        qWarning() << "Unsupported universal KTX";
+        return nullptr;
+    }
+    if (header.numberOfMipmapLevels == 0 || header.numberOfMipmapLevels > MAX_UNIVERSAL_LEVELS ||
+        (header.numberOfFaces != 1 && header.numberOfFaces != NUM_CUBEMAPFACES)) {
+        qWarning() << "Invalid universal KTX header";
+        return nullptr;
+    }
+
+    const size_t levelIndexSize = header.numberOfMipmapLevels * sizeof(UniversalLevel);
+    if (src->size() < sizeof(UniversalHeader) + levelIndexSize + header.bytesOfKeyValueData) {
+        qWarning() << "Universal KTX is too short for its index";
+        return nullptr;
+    }
+    result->_levels.resize(header.numberOfMipmapLevels);
+    memcpy(result->_levels.data(), src->data() + sizeof(UniversalHeader), levelIndexSize);
+    for (uint32_t level = 0; level < header.numberOfMipmapLevels; ++level) {
+        const auto& levelIndex = result->_levels[level];
+        // Both come from the file, so their sum could wrap around
+        if (levelIndex.byteOffset > src->size() || levelIndex.byteLength > src->size() - levelIndex.byteOffset ||
+            levelIndex.uncompressedByteLength != header.evalFaceSize(level) * header.numberOfFaces ||
+            (header.supercompressionScheme == UniversalHeader::SUPERCOMPRESSION_NONE &&
+             levelIndex.byteLength != levelIndex.uncompressedByteLength)) {
+            qWarning() << "Invalid universal KTX level" << level;
+            return nullptr;
+        }
+    }
+
+    result->_keyValues = KTX::parseKeyValues(header.bytesOfKeyValueData, src->data() + sizeof(UniversalHeader) + levelIndexSize);
+    return result;
+}
+
+std::vector<Byte> UniversalKTX::getLevelBlocks(uint32_t level) const {
+    std::vector<Byte> result;
+    if (level >= _levels.size()) {
+        return result;
+    }
+    const auto& levelIndex = _levels[level];
+    const Byte* levelBytes = _storage->data() + levelIndex.byteOffset;
+
+    if (_header.supercompressionScheme == UniversalHeader::SUPERCOMPRESSION_NONE) {
+        result.assign(levelBytes, levelBytes + levelIndex.byteLength);
+        return result;
+    }
+
+    // Put back the size prefix qUncompress expects in front of the zlib stream
+    QByteArray compressed;
+    compressed.reserve((int)(sizeof(quint32) + levelIndex.byteLength));
+    quint32 uncompressedLength = (quint32)levelIndex.uncompressedByteLength;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        compressed.append((char)((uncompressedLength >> shift) & 0xFF));
+    }
+    compressed.append(reinterpret_cast<const char*>(levelBytes), (int)levelIndex.byteLength);
+    QByteArray blocks = qUncompress(compressed);
+    if ((size_t)blocks.size() != levelIndex.uncompressedByteLength) {
+        qWarning() << "Failed to uncompress universal KTX level" << level;
+        return result;
+    }
+    result.assign(blocks.constData(), blocks.constData() + blocks.size());
+    return result;
+}
+
+bool UniversalKTX::evalTargetFormat(Target target, Header& header) const {
+    const bool srgb = _header.isSRGB();
+    const uint32_t numChannels = _header.getNumChannels();
+
+    // Linear maps only go to the single and two channel block formats, like their regular compressed KTXs
+    if (numChannels == 1) {
+        switch (target) {
+            case Target::BC4:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RED_RGTC1, GLBaseInternalFormat::RED);
+                return true;
+            case Target::EAC_R11:
+                header.setCompressed(GLInternalFormat::COMPRESSED_R11_EAC, GLBaseInternalFormat::RED);
+                return true;
+            case Target::UNCOMPRESSED:
+                header.setUncompressed(GLType::UNSIGNED_BYTE, 1, GLFormat::RED, GLInternalFormat::R8, GLBaseInternalFormat::RED);
+                return true;
+            default:
+                return false;
+        }
+    }
+    if (numChannels == 2) {
+        switch (target) {
+            case Target::BC5:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RG_RGTC2, GLBaseInternalFormat::RG);
+                return true;
+            case Target::EAC_RG11:
+                header.setCompressed(GLInternalFormat::COMPRESSED_RG11_EAC, GLBaseInternalFormat::RG);
+                return true;
+            case Target::UNCOMPRESSED:
+                header.setUncompressed(GLType::UNSIGNED_BYTE, 1, GLFormat::RG, GLInternalFormat::RG8, GLBaseInternalFormat::RG);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    switch (target) {
+        // The gpu library only knows the sRGB flavors of BC1 and BC3, the bakers only make color maps in sRGB
+        case Target::BC1:
+            if (!srgb) {
+                return false;
+            }
+            header.setCompressed(GLInternalFormat::COMPRESSED_SRGB_S3TC_DXT1_EXT, GLBaseInternalFormat::RGB);
+            return true;
+        case Target::BC3:
+            if (!srgb) {
+                return false;
+            }
+            header.setCompressed(GLInternalFormat::COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, GLBaseInternalFormat::RGBA);
+            return true;
+        case Target::ETC2_RGB:
+            header.setCompressed(srgb ? GLInternalFormat::COMPRESSED_SRGB8_ETC2 : GLInternalFormat::COMPRESSED_RGB8_ETC2,
+                                 GLBaseInternalFormat::RGB);
+            return true;
+        case Target::ETC2_RGBA:
+            header.setCompressed(srgb ? GLInternalFormat::COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : GLInternalFormat::COMPRESSED_RGBA8_ETC2_EAC,
+                                 GLBaseInternalFormat::RGBA);
+            return true;
+        case Target::UNCOMPRESSED:
+            header.setUncompressed(GLType::UNSIGNED_BYTE, 1, GLFormat::RGBA,
+                                   srgb ? GLInternalFormat::SRGB8_ALPHA8 : GLInternalFormat::RGBA8, GLBaseInternalFormat::RGBA);
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::unique_ptr<KTX> UniversalKTX::transcode(Target target, size_t maxNumPixels) const {
+    Header header;
+    if (!evalTargetFormat(target, header)) {
+        return nullptr;
+    }
+
+    // Skip the levels that are too large, like the image reader does when it scales down an original
+    uint32_t firstLevel = 0;
+    while (firstLevel + 1 < _header.numberOfMipmapLevels &&
+           (size_t)_header.evalMipWidth(firstLevel) * _header.evalMipHeight(firstLevel) > maxNumPixels) {
+        ++firstLevel;
+    }
+
+    const uint32_t numChannels = _header.getNumChannels();
+    if (_header.numberOfFaces == NUM_CUBEMAPFACES) {
+        header.setCube(_header.evalMipWidth(firstLevel), _header.evalMipHeight(firstLevel));
+    } else {
+        header.set2D(_header.evalMipWidth(firstLevel), _header.evalMipHeight(firstLevel));
+    }
+    header.numberOfMipmapLevels = _header.numberOfMipmapLevels - firstLevel;
+
+    std::vector<std::vector<Byte>> levelData(_header.numberOfMipmapLevels);
+    Images images;
+    uint32_t imageOffset = 0;
+    for (uint32_t level = firstLevel; level < _header.numberOfMipmapLevels; ++level) {
+        auto blocks = getLevelBlocks(level);
+        const size_t sourceFaceSize = _header.evalFaceSize(level);
+        if (blocks.empty() || blocks.size() < sourceFaceSize * _header.numberOfFaces) {
+            return nullptr;
+        }
+
+        const uint32_t width = _header.evalMipWidth(level);
+        const uint32_t height = _header.evalMipHeight(level);
+        const size_t faceSize = evalTargetFaceSize(target, width, height, numChannels, _header.evalBlockCount(level));
+
+        auto& data = levelData[level];
+        data.resize(faceSize * _header.numberOfFaces);
+        Image::FaceBytes faceBytes(_header.numberOfFaces);
+        for (uint32_t face = 0; face < _header.numberOfFaces; ++face) {
+            faceBytes[face] = data.data() + face * faceSize;
+            transcodeFace(target, blocks.data() + face * sourceFaceSize, width, height, numChannels, _header.hasAlpha(),
+                          data.data() + face * faceSize);
+        }
+
+        if (_header.numberOfFaces == 1) {
+            images.emplace_back(Image(imageOffset, (uint32_t)faceSize, 0, faceBytes[0]));
+        } else {
+            images.emplace_back(Image(imageOffset, (uint32_t)faceSize, 0, faceBytes));
+        }
+        imageOffset += (uint32_t)(faceSize * _header.numberOfFaces) + IMAGE_SIZE_WIDTH;
+    }
+
+    return KTX::create(header, images, _keyValues);
+}
@@ -0,0 +1,133 @@
+//
+//  Universal.h
+//  ktx/src/ktx
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_ktx_Universal_h
+#define hifi_ktx_Universal_h
+
+#include <limits>
+
+#include "KTX.h"
+
+namespace ktx {
+
+    // A universal texture is baked once and transcoded at load time to the block format the GPU supports.
+    // The blocks are ETC1S: ETC1 blocks whose two halves share one base color and one intensity table, which makes
+    // them valid ETC1 / ETC2 blocks as they are, and cheap to turn into BC1 blocks since their 4 colors are on a line.
+    // Alpha, when there is any, is a second plane of ETC1S blocks holding the alpha as grey.
+    // Linear single and two channel maps, like roughness or normals, keep their channels in the red and green of the
+    // color blocks, and transcode to BC4 / BC5 or EAC.
+    //
+    // The container follows the layout of KTX2: a header, a level index, the key values and then the levels,
+    // each of which can be supercompressed on its own with zlib.
+    struct UniversalHeader {
+        static const size_t IDENTIFIER_LENGTH { 12 };
+        using Identifier = std::array<uint8_t, IDENTIFIER_LENGTH>;
+        static const Identifier IDENTIFIER;
+
+        static const uint32_t BLOCK_FORMAT_ETC1S { 1 };
+
+        static const uint32_t SUPERCOMPRESSION_NONE { 0 };
+        static const uint32_t SUPERCOMPRESSION_ZLIB { 3 }; // Same value as in KTX2
+
+        static const uint32_t FLAG_HAS_ALPHA { 1 << 0 };
+        static const uint32_t FLAG_SRGB { 1 << 1 };
+        static const uint32_t FLAG_RED { 1 << 2 };
+        static const uint32_t FLAG_RG { 1 << 3 };
+
+        UniversalHeader();
+
+        Byte identifier[IDENTIFIER_LENGTH];
+        uint32_t endianness { Header::ENDIAN_TEST };
+        uint32_t blockFormat { BLOCK_FORMAT_ETC1S };
+        uint32_t supercompressionScheme { SUPERCOMPRESSION_ZLIB };
+        uint32_t flags { 0 };
+        uint32_t pixelWidth { 1 };
+        uint32_t pixelHeight { 1 };
+        uint32_t numberOfFaces { 1 };
+        uint32_t numberOfMipmapLevels { 1 };
+        uint32_t bytesOfKeyValueData { 0 };
+        uint32_t reserved { 0 };
+
+        bool hasAlpha() const { return (flags & FLAG_HAS_ALPHA) != 0; }
+        bool isSRGB() const { return (flags & FLAG_SRGB) != 0; }
+        // 1 for red maps, 2 for red and green maps and 4 for color maps, with or without alpha
+        uint32_t getNumChannels() const { return (flags & FLAG_RED) ? 1 : ((flags & FLAG_RG) ? 2 : 4); }
+
+        uint32_t evalMipWidth(uint32_t level) const { return std::max(pixelWidth >> level, 1U); }
+        uint32_t evalMipHeight(uint32_t level) const { return std::max(pixelHeight >> level, 1U); }
+        size_t evalBlockCount(uint32_t level) const;
+        // Size of the blocks of one face, color and alpha planes, before supercompression
+        size_t evalFaceSize(uint32_t level) const;
+    };
+    static const size_t UNIVERSAL_HEADER_SIZE { 52 };
+    static_assert(sizeof(UniversalHeader) == UNIVERSAL_HEADER_SIZE, "Universal KTX header size should not change");
+
+    struct UniversalLevel {
+        uint64_t byteOffset { 0 }; // From the start of the file
+        uint64_t byteLength { 0 };
+        uint64_t uncompressedByteLength { 0 };
+    };
+    static_assert(sizeof(UniversalLevel) == 24, "Universal KTX level index entry size should not change");
+
+    class UniversalKTX {
+    public:
+        // The block formats a universal texture can be transcoded to
+        enum class Target {
+            BC1 = 0,
+            BC3,
+            BC4,
+            BC5,
+            ETC2_RGB,
+            ETC2_RGBA,
+            EAC_R11,
+            EAC_RG11,
+            UNCOMPRESSED, // 8 bits per channel, with the channels of the texture
+
+            NUM_TARGETS,
+        };
+        static const char* toString(Target target);
+
+        static bool isUniversal(size_t srcSize, const Byte* srcBytes);
+
+        // Encode an uncompressed RGBA, BGRA, RG or R 8 bits per channel KTX, returns nullptr for any other kind of KTX
+        static StoragePointer encode(const KTX& source, bool supercompress = true);
+
+        static std::unique_ptr<UniversalKTX> create(const StoragePointer& src);
+
+        const UniversalHeader& getHeader() const { return _header; }
+        const KeyValues& getKeyValues() const { return _keyValues; }
+        const std::vector<UniversalLevel>& getLevels() const { return _levels; }
+        const StoragePointer& getStorage() const { return _storage; }
+        bool hasAlpha() const { return _header.hasAlpha(); }
+        uint32_t getNumChannels() const { return _header.getNumChannels(); }
+
+        // The GL format a target transcodes to, false if the target can't hold this texture
+        bool evalTargetFormat(Target target, Header& header) const;
+
+        // Transcode the levels to a regular KTX with the same key values, or nullptr if the target can't hold it.
+        // Levels with more than maxNumPixels are skipped, down to the last one.
+        std::unique_ptr<KTX> transcode(Target target, size_t maxNumPixels = std::numeric_limits<size_t>::max()) const;
+
+        // The blocks of a level, with any supercompression undone
+        std::vector<Byte> getLevelBlocks(uint32_t level) const;
+
+    private:
+        UniversalKTX() {}
+
+        StoragePointer _storage;
+        UniversalHeader _header;
+        std::vector<UniversalLevel> _levels;
+        KeyValues _keyValues;
+    };
+
+}
+
+#endif // hifi_ktx_Universal_h
@@ -11,6 +11,7 @@
 
 #include "TextureCache.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include <QtConcurrent/QtConcurrentRun>
@@ -19,6 +20,7 @@
 #include <QImageReader>
 #include <QRunnable>
 #include <QThreadPool>
+#include <QTimer>
 #include <QNetworkReply>
 #include <QPainter>
 #include <QUrlQuery>
@@ -33,8 +35,10 @@
 
 #include <gl/GLHelpers.h>
 #include <gpu/Batch.h>
+#include <gpu/TextureStreaming.h>
 
 #include <image/TextureProcessing.h>
+#include <ktx/Universal.h>
 
 #include <NumericalConstants.h>
 #include <shared/NsightHelpers.h>
@@ -96,6 +100,9 @@ static const QUrl HMD_PREVIEW_FRAME_URL("resource://hmdPreviewFrame");
 
 static const float SKYBOX_LOAD_PRIORITY { 10.0f }; // Make sure skybox loads first
 static const float HIGH_MIPS_LOAD_PRIORITY { 9.0f }; // Make sure high mips loads after skybox but before models
+static const float MAX_SCREEN_BLUR_MIP_PRIORITY { 3.0f }; // How many mip levels ahead the blurriest textures on screen can jump
+static const float MAX_MIP_LOAD_PRIORITY { -1.0f }; // Make sure mips load after models
+static const int MIP_REQUESTS_INTERVAL_MSECS { 250 }; // How often the textures waiting for mips are checked
 
 TextureCache::TextureCache() {
     _ktxCache->initialize();
@@ -104,6 +111,11 @@ TextureCache::TextureCache() {
 #endif
     setUnusedResourceCacheSize(0);
     setObjectName("TextureCache");
+
+    // The textures waiting to be drawn larger have nothing else to wake them up
+    auto mipRequestsTimer = new QTimer(this);
+    connect(mipRequestsTimer, &QTimer::timeout, this, &TextureCache::startMipRequests);
+    mipRequestsTimer->start(MIP_REQUESTS_INTERVAL_MSECS);
 }
 
 TextureCache::~TextureCache() {
@@ -491,6 +503,7 @@ public:
 
 private:
     static void listSupportedImageFormats();
+    ktx::KTXUniquePointer transcodeUniversalTexture(const storage::StoragePointer& storage);
 
     QWeakPointer<Resource> _resource;
     QUrl _url;
@@ -501,6 +514,7 @@ private:
 };
 
 NetworkTexture::~NetworkTexture() {
+    releaseMipRequest();
     if (_ktxHeaderRequest || _ktxMipRequest) {
         if (_ktxHeaderRequest) {
             _ktxHeaderRequest->disconnect(this);
@@ -686,14 +700,126 @@ void NetworkTexture::startRequestForNextMipLevel() {
     }
 
     _lowestKnownPopulatedMip = texture->minAvailableMipLevel();
-    if (_lowestRequestedMipLevel < _lowestKnownPopulatedMip) {
-        _ktxResourceState = PENDING_MIP_REQUEST;
+    if (_lowestRequestedMipLevel >= _lowestKnownPopulatedMip) {
+        return;
+    }
 
-        init(false);
-        float priority = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)_lowestKnownPopulatedMip;
-        setLoadPriority(this, priority);
-        _url.setFragment(QString::number(_lowestKnownPopulatedMip - 1));
-        TextureCache::attemptRequest(self);
+    // Only down to the mip the texture is drawn at, the texture cache asks again once it is drawn larger
+    auto textureCache = DependencyManager::get<TextureCache>();
+    if (!wantsNextMip(*texture)) {
+        textureCache->waitForMipRequest(self);
+        return;
+    }
+    if (!textureCache->reserveMipRequest(self)) {
+        return;
+    }
+    _holdsMipRequest = true;
+    _ktxResourceState = PENDING_MIP_REQUEST;
+
+    init(false);
+    setLoadPriority(this, evalMipRequestPriority(*texture));
+    _url.setFragment(QString::number(_lowestKnownPopulatedMip - 1));
+    TextureCache::attemptRequest(self);
+}
+
+bool NetworkTexture::wantsNextMip(const gpu::Texture& texture) const {
+    uint16_t lowestMip = std::max(_lowestRequestedMipLevel, gpu::TextureStreaming::evalDownloadMip(texture));
+    return lowestMip < texture.minAvailableMipLevel();
+}
+
+float NetworkTexture::evalMipRequestPriority(const gpu::Texture& texture) const {
+    // Coarser mips first, but the textures that are the blurriest on screen can skip ahead of the others
+    uint16_t mip = texture.minAvailableMipLevel();
+    float screenBlur = gpu::TextureStreaming::evalMipValue(texture, mip);
+    float priority = -(float)texture.getNumMips() + (float)mip + MAX_SCREEN_BLUR_MIP_PRIORITY * screenBlur / (1.0f + screenBlur);
+    return std::min(priority, MAX_MIP_LOAD_PRIORITY);
+}
+
+void NetworkTexture::releaseMipRequest() {
+    if (_holdsMipRequest) {
+        _holdsMipRequest = false;
+        auto textureCache = DependencyManager::get<TextureCache>();
+        if (textureCache) {
+            textureCache->releaseMipRequest();
+        }
+    }
+}
+
+void TextureCache::setMipRequestBudget(int budget) {
+    {
+        std::lock_guard<std::mutex> lock(_mipRequestsMutex);
+        _mipRequestBudget = std::max(budget, 1);
+    }
+    QMetaObject::invokeMethod(this, "startMipRequests", Qt::QueuedConnection);
+}
+
+int TextureCache::getMipRequestBudget() const {
+    std::lock_guard<std::mutex> lock(_mipRequestsMutex);
+    return _mipRequestBudget;
+}
+
+bool TextureCache::reserveMipRequest(const QWeakPointer<Resource>& texture) {
+    std::lock_guard<std::mutex> lock(_mipRequestsMutex);
+    if (_mipRequestsInFlight < _mipRequestBudget) {
+        ++_mipRequestsInFlight;
+        return true;
+    }
+    if (!_texturesWaitingForMips.contains(texture)) {
+        _texturesWaitingForMips.append(texture);
+    }
+    return false;
+}
+
+void TextureCache::releaseMipRequest() {
+    {
+        std::lock_guard<std::mutex> lock(_mipRequestsMutex);
+        --_mipRequestsInFlight;
+    }
+    QMetaObject::invokeMethod(this, "startMipRequests", Qt::QueuedConnection);
+}
+
+void TextureCache::waitForMipRequest(const QWeakPointer<Resource>& texture) {
+    std::lock_guard<std::mutex> lock(_mipRequestsMutex);
+    if (!_texturesWaitingForMips.contains(texture)) {
+        _texturesWaitingForMips.append(texture);
+    }
+}
+
+void TextureCache::startMipRequests() {
+    // The priorities are evaluated now, the textures were drawn at other sizes when they started waiting
+    std::vector<std::pair<float, QSharedPointer<NetworkTexture>>> candidates;
+    int availableRequests;
+    {
+        std::lock_guard<std::mutex> lock(_mipRequestsMutex);
+        availableRequests = _mipRequestBudget - _mipRequestsInFlight;
+        for (int i = 0; i < _texturesWaitingForMips.size();) {
+            auto texture = _texturesWaitingForMips[i].lock().staticCast<NetworkTexture>();
+            if (!texture || texture->_ktxResourceState != NetworkTexture::WAITING_FOR_MIP_REQUEST) {
+                _texturesWaitingForMips.removeAt(i);
+                continue;
+            }
+            auto gpuTexture = texture->getGPUTexture();
+            if (gpuTexture && texture->wantsNextMip(*gpuTexture)) {
+                candidates.emplace_back(texture->evalMipRequestPriority(*gpuTexture), texture);
+            }
+            ++i;
+        }
+    }
+    if (availableRequests <= 0 || candidates.empty()) {
+        return;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const std::pair<float, QSharedPointer<NetworkTexture>>& a,
+                                                       const std::pair<float, QSharedPointer<NetworkTexture>>& b) {
+        return a.first > b.first;
+    });
+    for (size_t i = 0; i < candidates.size() && (int)i < availableRequests; ++i) {
+        auto& texture = candidates[i].second;
+        {
+            std::lock_guard<std::mutex> lock(_mipRequestsMutex);
+            _texturesWaitingForMips.removeOne(texture->_self);
+        }
+        QMetaObject::invokeMethod(texture.data(), "startRequestForNextMipLevel");
     }
 }
 
@@ -817,6 +943,7 @@ void NetworkTexture::ktxMipRequestFinished() {
             Q_ASSERT(_ktxMipLevelRangeInFlight.second - _ktxMipLevelRangeInFlight.first == 0);
 
             _ktxResourceState = WAITING_FOR_MIP_REQUEST;
+            releaseMipRequest();
 
             auto self = _self;
             auto url = _url;
@@ -861,6 +988,7 @@ void NetworkTexture::ktxMipRequestFinished() {
             });
         } else {
             qWarning(networking) << "Mip request finished in an unexpected state: " << _ktxResourceState;
+            releaseMipRequest();
             finishedLoading(false);
         }
     } else {
@@ -868,6 +996,7 @@ void NetworkTexture::ktxMipRequestFinished() {
             _ktxResourceState = PENDING_MIP_REQUEST;
         } else {
             _ktxResourceState = FAILED_TO_LOAD;
+            releaseMipRequest();
         }
     }
 
@@ -1089,6 +1218,19 @@ void NetworkTexture::loadMetaContent(const QByteArray& content) {
         }
     }
 
+    if (!meta.universal.isEmpty()) {
+        // Universal textures go through the ImageReader like originals, which transcodes them
+        _currentlyLoadingResourceType = ResourceType::ORIGINAL;
+        _activeUrl = _activeUrl.resolved(meta.universal);
+
+        auto self = _self.lock();
+        if (!self) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, "attemptRequest", Qt::QueuedConnection);
+        return;
+    }
+
 #ifndef Q_OS_ANDROID
     if (!meta.uncompressed.isEmpty()) {
         _currentlyLoadingResourceType = ResourceType::KTX;
@@ -1148,6 +1290,7 @@ void NetworkTexture::refresh() {
         TextureCache::requestCompleted(_self);
     }
 
+    releaseMipRequest();
     _ktxResourceState = PENDING_INITIAL_LOAD;
     Resource::refresh();
 }
@@ -1206,6 +1349,61 @@ void ImageReader::run() {
     read();
 }
 
+ktx::KTXUniquePointer ImageReader::transcodeUniversalTexture(const storage::StoragePointer& storage) {
+    auto universal = ktx::UniversalKTX::create(storage);
+    if (!universal) {
+        qCWarning(materialnetworking) << "Invalid universal texture" << _url;
+        return nullptr;
+    }
+
+    // Pick the block format the GPU supports, decoding to plain pixels if it supports neither
+    using Target = ktx::UniversalKTX::Target;
+    bool hasAlpha = universal->hasAlpha();
+    std::vector<Target> targets;
+    auto textureCache = DependencyManager::get<TextureCache>();
+    auto gpuContext = textureCache ? textureCache->getGPUContext() : nullptr;
+    if (gpuContext) {
+        auto& backend = gpuContext->getBackend();
+        switch (universal->getNumChannels()) {
+            case 1:
+                if (backend->supportedTextureFormat(gpu::Element::COLOR_COMPRESSED_BCX_RED)) {
+                    targets.push_back(Target::BC4);
+                }
+                if (backend->supportedTextureFormat(gpu::Element::COLOR_COMPRESSED_EAC_RED)) {
+                    targets.push_back(Target::EAC_R11);
+                }
+                break;
+            case 2:
+                if (backend->supportedTextureFormat(gpu::Element::COLOR_COMPRESSED_BCX_XY)) {
+                    targets.push_back(Target::BC5);
+                }
+                if (backend->supportedTextureFormat(gpu::Element::COLOR_COMPRESSED_EAC_XY)) {
+                    targets.push_back(Target::EAC_RG11);
+                }
+                break;
+            default:
+                if (backend->supportedTextureFormat(hasAlpha ? gpu::Element::COLOR_COMPRESSED_BCX_SRGBA : gpu::Element::COLOR_COMPRESSED_BCX_SRGB)) {
+                    targets.push_back(hasAlpha ? Target::BC3 : Target::BC1);
+                }
+                if (backend->supportedTextureFormat(hasAlpha ? gpu::Element::COLOR_COMPRESSED_ETC2_SRGBA : gpu::Element::COLOR_COMPRESSED_ETC2_SRGB)) {
+                    targets.push_back(hasAlpha ? Target::ETC2_RGBA : Target::ETC2_RGB);
+                }
+                break;
+        }
+    }
+    targets.push_back(Target::UNCOMPRESSED);
+
+    for (auto target : targets) {
+        // Only the levels that fit in the texture's pixel budget, like an original scaled down by processImage
+        auto result = universal->transcode(target, (size_t)_maxNumPixels);
+        if (result) {
+            return result;
+        }
+    }
+    qCWarning(materialnetworking) << "Failed to transcode universal texture" << _url;
+    return nullptr;
+}
+
 void ImageReader::read() {
     auto resource = _resource.lock(); // to ensure the resource is still needed
     if (!resource) {
@@ -1254,7 +1452,23 @@ void ImageReader::read() {
 
     // Proccess new texture
     gpu::TexturePointer texture;
-    {
+    ktx::KTXUniquePointer memKtx;
+    if (ktx::UniversalKTX::isUniversal(_content.size(), reinterpret_cast<const ktx::Byte*>(_content.constData()))) {
+        PROFILE_RANGE_EX(resource_parse_image_raw, "transcodeUniversal", 0xffff0000, 0);
+
+        // IMPORTANT: _content is empty past this point
+        auto storage = std::make_shared<storage::MemoryStorage>(_content.size(), reinterpret_cast<const uint8_t*>(_content.constData()));
+        _content.clear();
+
+        memKtx = transcodeUniversalTexture(storage);
+        if (memKtx) {
+            texture = gpu::Texture::build(memKtx->toDescriptor());
+        }
+        if (texture) {
+            texture->setKtxBacking(memKtx->getStorage());
+            texture->setSource(_url.toString().toStdString());
+        }
+    } else {
         PROFILE_RANGE_EX(resource_parse_image_raw, __FUNCTION__, 0xffff0000, 0);
 
         // IMPORTANT: _content is empty past this point
@@ -1267,22 +1481,24 @@ void ImageReader::read() {
 #endif
         auto target = getBackendTarget();
         texture = image::processImage(std::move(buffer), _url.toString().toStdString(), _sourceChannel, _maxNumPixels, networkTexture->getTextureType(), shouldCompress, target);
+    }
 
-        if (!texture) {
-            QMetaObject::invokeMethod(resource.data(), "setImage",
-                                      Q_ARG(gpu::TexturePointer, texture),
-                                      Q_ARG(int, 0),
-                                      Q_ARG(int, 0));
-            return;
-        }
-
-        texture->setSourceHash(hash);
-        texture->setFallbackTexture(networkTexture->getFallbackTexture());
+    if (!texture) {
+        QMetaObject::invokeMethod(resource.data(), "setImage",
+                                  Q_ARG(gpu::TexturePointer, texture),
+                                  Q_ARG(int, 0),
+                                  Q_ARG(int, 0));
+        return;
     }
 
+    texture->setSourceHash(hash);
+    texture->setFallbackTexture(networkTexture->getFallbackTexture());
+
     // Save the image into a KTXFile
     if (texture && textureCache) {
-        auto memKtx = gpu::Texture::serialize(*texture);
+        if (!memKtx) {
+            memKtx = gpu::Texture::serialize(*texture);
+        }
 
         // Move the texture into a memory mapped file
         if (memKtx) {
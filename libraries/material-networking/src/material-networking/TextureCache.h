@@ -14,6 +14,8 @@
 
 #include <gpu/Texture.h>
 
+#include <mutex>
+
 #include <QImage>
 #include <QMap>
 #include <QColor>
@@ -92,6 +94,11 @@ protected:
     void startMipRangeRequest(uint16_t low, uint16_t high);
     void handleFinishedInitialLoad();
 
+    // Whether there is a mip worth downloading, and how soon, higher first
+    bool wantsNextMip(const gpu::Texture& texture) const;
+    float evalMipRequestPriority(const gpu::Texture& texture) const;
+    void releaseMipRequest();
+
 private:
     friend class KTXReader;
     friend class ImageReader;
@@ -129,6 +136,8 @@ private:
 
     uint16_t _lowestRequestedMipLevel { NULL_MIP_LEVEL };
     uint16_t _lowestKnownPopulatedMip { NULL_MIP_LEVEL };
+    // Holds one of the mip requests of the texture cache's budget, from PENDING_MIP_REQUEST until the mip arrives
+    bool _holdsMipRequest { false };
 
     // This is a copy of the original KTX descriptor from the source url.
     // We need this because the KTX that will be cached will likely include extra data
@@ -198,6 +207,11 @@ public:
     void setGPUContext(const gpu::ContextPointer& context) { _gpuContext = context; }
     gpu::ContextPointer getGPUContext() const { return _gpuContext; }
 
+    static const int DEFAULT_MIP_REQUEST_BUDGET { 4 };
+    /// The most KTX mip downloads in flight or queued at once, the textures that want more wait in order of priority
+    void setMipRequestBudget(int budget);
+    int getMipRequestBudget() const;
+
 signals:
     void spectatorCameraFramebufferReset();
 
@@ -209,6 +223,9 @@ protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
 
+    // Starts the mip requests of the waiting textures that want one the most, as far as the budget allows
+    Q_INVOKABLE void startMipRequests();
+
 private:
     friend class ImageReader;
     friend class NetworkTexture;
@@ -218,6 +235,11 @@ private:
     TextureCache();
     virtual ~TextureCache();
 
+    // Takes one of the mip requests of the budget, or puts the texture on the waiting list when they are all taken
+    bool reserveMipRequest(const QWeakPointer<Resource>& texture);
+    void releaseMipRequest();
+    void waitForMipRequest(const QWeakPointer<Resource>& texture);
+
     static const std::string KTX_DIRNAME;
     static const std::string KTX_EXT;
 
@@ -229,6 +251,12 @@ private:
     std::unordered_map<std::string, std::weak_ptr<gpu::Texture>> _texturesByHashes;
     std::mutex _texturesByHashesMutex;
 
+    mutable std::mutex _mipRequestsMutex;
+    int _mipRequestBudget { DEFAULT_MIP_REQUEST_BUDGET };
+    int _mipRequestsInFlight { 0 };
+    // The textures with mips left to download, which either wait for room in the budget or to be drawn larger
+    QList<QWeakPointer<Resource>> _texturesWaitingForMips;
+
     gpu::TexturePointer _permutationNormalTexture;
     gpu::TexturePointer _whiteTexture;
     gpu::TexturePointer _grayTexture;
@@ -63,11 +63,11 @@ namespace baker {
             indexedTrianglesMeshOut.clear();
             indexedTrianglesMeshOut.resize(meshesIn.size());
 
-            for (size_t i = 0; i < meshesIn.size(); i++) {
+            parallelFor(meshesIn.size(), [&](size_t i) {
                 auto& mesh = meshesIn[i];
                 const auto verticesStd = mesh.vertices.toStdVector();
                 indexedTrianglesMeshOut[i] = hfm::generateTriangleListMesh(verticesStd, mesh.parts);
-            }
+            });
         }
     };
 
@@ -173,61 +173,77 @@ namespace baker {
             const auto modelExtentsIn = modelPartsIn.getN<GetModelPartsTask::Output>(7);
             const auto materialsIn = modelPartsIn.getN<GetModelPartsTask::Output>(8);
 
-            // Calculate normals and tangents for meshes and blendshapes if they do not exist
+            // The jobs are grouped into stages, each of which only depends on the stages before it. The jobs of a stage run concurrently.
+
+            // Stage 1: everything that only depends on the model parts
             // Note: Normals are never calculated here for OBJ models. OBJ files optionally define normals on a per-face basis, so for consistency normals are calculated beforehand in OBJSerializer.
-            const auto normalsPerMesh = model.addJob<CalculateMeshNormalsTask>("CalculateMeshNormals", meshesIn);
-            const auto calculateMeshTangentsInputs = CalculateMeshTangentsTask::Input(normalsPerMesh, meshesIn).asVarying();
-            const auto tangentsPerMesh = model.addJob<CalculateMeshTangentsTask>("CalculateMeshTangents", calculateMeshTangentsInputs);
-            const auto calculateBlendshapeNormalsInputs = CalculateBlendshapeNormalsTask::Input(blendshapesPerMeshIn, meshesIn).asVarying();
-            const auto normalsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeNormalsTask>("CalculateBlendshapeNormals", calculateBlendshapeNormalsInputs);
-            const auto calculateBlendshapeTangentsInputs = CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMeshIn, meshesIn).asVarying();
-            const auto tangentsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeTangentsTask>("CalculateBlendshapeTangents", calculateBlendshapeTangentsInputs);
-
-            // Calculate shape vertices. These rely on the weight-normalized clusterIndices/clusterWeights in the mesh, and are used later for computing the joint kdops
-            const auto collectShapeVerticesInputs = CollectShapeVerticesTask::Input(meshesIn, shapesIn, jointsIn, skinDeformersIn).asVarying();
-            const auto shapeVerticesPerJoint = model.addJob<CollectShapeVerticesTask>("CollectShapeVertices", collectShapeVerticesInputs);
-
-            // Build the slim triangle list mesh for each hfm::mesh
-            const auto triangleListMeshes = model.addJob<BuildMeshTriangleListTask>("BuildMeshTriangleListTask", meshesIn);
-
-            // Build the graphics::MeshPointer for each hfm::Mesh
-            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh, shapesIn, skinDeformersIn).asVarying();
-            const auto graphicsMeshes = model.addJob<BuildGraphicsMeshTask>("BuildGraphicsMesh", buildGraphicsMeshInputs);
-
-            // Prepare joint information
-            const auto prepareJointsInputs = PrepareJointsTask::Input(jointsIn, mapping).asVarying();
-            const auto jointInfoOut = model.addJob<PrepareJointsTask>("PrepareJoints", prepareJointsInputs);
+            Varying normalsPerMesh, normalsPerBlendshapePerMesh, shapeVerticesPerJoint, triangleListMeshes, jointInfoOut, materialMapping, flowData;
+            model.addJob<ParallelJobs>("ModelPartsStage", [&](ParallelJobs::JobModel& stage) {
+                // Calculate normals for meshes and blendshapes if they do not exist
+                normalsPerMesh = stage.addJob<CalculateMeshNormalsTask>("CalculateMeshNormals", meshesIn);
+                const auto calculateBlendshapeNormalsInputs = CalculateBlendshapeNormalsTask::Input(blendshapesPerMeshIn, meshesIn).asVarying();
+                normalsPerBlendshapePerMesh = stage.addJob<CalculateBlendshapeNormalsTask>("CalculateBlendshapeNormals", calculateBlendshapeNormalsInputs);
+
+                // Calculate shape vertices. These rely on the weight-normalized clusterIndices/clusterWeights in the mesh, and are used later for computing the joint kdops
+                const auto collectShapeVerticesInputs = CollectShapeVerticesTask::Input(meshesIn, shapesIn, jointsIn, skinDeformersIn).asVarying();
+                shapeVerticesPerJoint = stage.addJob<CollectShapeVerticesTask>("CollectShapeVertices", collectShapeVerticesInputs);
+
+                // Build the slim triangle list mesh for each hfm::mesh
+                triangleListMeshes = stage.addJob<BuildMeshTriangleListTask>("BuildMeshTriangleListTask", meshesIn);
+
+                // Prepare joint information
+                const auto prepareJointsInputs = PrepareJointsTask::Input(jointsIn, mapping).asVarying();
+                jointInfoOut = stage.addJob<PrepareJointsTask>("PrepareJoints", prepareJointsInputs);
+
+                // Parse material mapping
+                const auto parseMaterialMappingInputs = ParseMaterialMappingTask::Input(mapping, materialMappingBaseURL).asVarying();
+                materialMapping = stage.addJob<ParseMaterialMappingTask>("ParseMaterialMapping", parseMaterialMappingInputs);
+
+                // Parse flow data
+                flowData = stage.addJob<ParseFlowDataTask>("ParseFlowData", mapping);
+            });
             const auto jointsOut = jointInfoOut.getN<PrepareJointsTask::Output>(0);
             const auto jointRotationOffsets = jointInfoOut.getN<PrepareJointsTask::Output>(1);
             const auto jointIndices = jointInfoOut.getN<PrepareJointsTask::Output>(2);
 
-            // Use transform information to compute extents
-            const auto calculateExtentsInputs = CalculateTransformedExtentsTask::Input(modelExtentsIn, triangleListMeshes, shapesIn, jointsOut).asVarying();
-            const auto calculateExtentsOutputs = model.addJob<CalculateTransformedExtentsTask>("CalculateExtents", calculateExtentsInputs);
+            // Stage 2: tangents, which need the normals, and the extents, which need the triangle lists and the joints
+            Varying tangentsPerMesh, tangentsPerBlendshapePerMesh, calculateExtentsOutputs;
+            model.addJob<ParallelJobs>("TangentsAndExtentsStage", [&](ParallelJobs::JobModel& stage) {
+                const auto calculateMeshTangentsInputs = CalculateMeshTangentsTask::Input(normalsPerMesh, meshesIn).asVarying();
+                tangentsPerMesh = stage.addJob<CalculateMeshTangentsTask>("CalculateMeshTangents", calculateMeshTangentsInputs);
+                const auto calculateBlendshapeTangentsInputs = CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMeshIn, meshesIn).asVarying();
+                tangentsPerBlendshapePerMesh = stage.addJob<CalculateBlendshapeTangentsTask>("CalculateBlendshapeTangents", calculateBlendshapeTangentsInputs);
+
+                // Use transform information to compute extents
+                const auto calculateExtentsInputs = CalculateTransformedExtentsTask::Input(modelExtentsIn, triangleListMeshes, shapesIn, jointsOut).asVarying();
+                calculateExtentsOutputs = stage.addJob<CalculateTransformedExtentsTask>("CalculateExtents", calculateExtentsInputs);
+            });
             const auto modelExtentsOut = calculateExtentsOutputs.getN<CalculateTransformedExtentsTask::Output>(0);
             const auto shapesOut = calculateExtentsOutputs.getN<CalculateTransformedExtentsTask::Output>(1);
 
-            // Parse material mapping
-            const auto parseMaterialMappingInputs = ParseMaterialMappingTask::Input(mapping, materialMappingBaseURL).asVarying();
-            const auto materialMapping = model.addJob<ParseMaterialMappingTask>("ParseMaterialMapping", parseMaterialMappingInputs);
-
-            // Build Draco meshes
-            // NOTE: This task is disabled by default and must be enabled through configuration
-            // TODO: Tangent support (Needs changes to FBXSerializer_Mesh as well)
-            // NOTE: Due to an unresolved linker error, BuildDracoMeshTask is not functional on Android
-            // TODO: Figure out why BuildDracoMeshTask.cpp won't link with draco on Android
-            const auto buildDracoMeshInputs = BuildDracoMeshTask::Input(shapesOut, meshesIn, materialsIn, normalsPerMesh, tangentsPerMesh).asVarying();
-            const auto buildDracoMeshOutputs = model.addJob<BuildDracoMeshTask>("BuildDracoMesh", buildDracoMeshInputs);
+            // Stage 3: the meshes built from the normals and tangents
+            Varying graphicsMeshes, buildDracoMeshOutputs, blendshapesPerMeshOut;
+            model.addJob<ParallelJobs>("BuildMeshesStage", [&](ParallelJobs::JobModel& stage) {
+                // Build the graphics::MeshPointer for each hfm::Mesh
+                const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh, shapesIn, skinDeformersIn).asVarying();
+                graphicsMeshes = stage.addJob<BuildGraphicsMeshTask>("BuildGraphicsMesh", buildGraphicsMeshInputs);
+
+                // Build Draco meshes
+                // NOTE: This task is disabled by default and must be enabled through configuration
+                // TODO: Tangent support (Needs changes to FBXSerializer_Mesh as well)
+                // NOTE: Due to an unresolved linker error, BuildDracoMeshTask is not functional on Android
+                // TODO: Figure out why BuildDracoMeshTask.cpp won't link with draco on Android
+                const auto buildDracoMeshInputs = BuildDracoMeshTask::Input(shapesOut, meshesIn, materialsIn, normalsPerMesh, tangentsPerMesh).asVarying();
+                buildDracoMeshOutputs = stage.addJob<BuildDracoMeshTask>("BuildDracoMesh", buildDracoMeshInputs);
+
+                const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
+                blendshapesPerMeshOut = stage.addJob<BuildBlendshapesTask>("BuildBlendshapes", buildBlendshapesInputs);
+            });
             const auto dracoMeshes = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(0);
             const auto dracoErrors = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(1);
             const auto materialList = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(2);
 
-            // Parse flow data
-            const auto flowData = model.addJob<ParseFlowDataTask>("ParseFlowData", mapping);
-
             // Combine the outputs into a new hfm::Model
-            const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
-            const auto blendshapesPerMeshOut = model.addJob<BuildBlendshapesTask>("BuildBlendshapes", buildBlendshapesInputs);
             const auto buildMeshesInputs = BuildMeshesTask::Input(meshesIn, triangleListMeshes, graphicsMeshes, normalsPerMesh, tangentsPerMesh, blendshapesPerMeshOut).asVarying();
             const auto meshesOut = model.addJob<BuildMeshesTask>("BuildMeshes", buildMeshesInputs);
             const auto buildModelInputs = BuildModelTask::Input(hfmModelIn, meshesOut, jointsOut, jointRotationOffsets, jointIndices, flowData, shapeVerticesPerJoint, shapesOut, modelExtentsOut).asVarying();
@@ -237,6 +253,8 @@ namespace baker {
         }
     };
 
+    const int Baker::VERSION { 1 };
+
     Baker::Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL) :
         _engine(std::make_shared<Engine>(BakerEngineBuilder::JobModel::create("Baker"), std::make_shared<BakeContext>())) {
         _engine->feedInput<BakerEngineBuilder::Input>(0, hfmModel);
@@ -271,4 +289,29 @@ namespace baker {
     std::vector<std::vector<hifi::ByteArray>> Baker::getDracoMaterialLists() const {
         return _engine->getOutput().get<BakerEngineBuilder::Output>().get4();
     }
+
+    MaterialMapping Baker::restoreBakedModel(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL) {
+        // The normals and tangents the baker calculated are in the meshes by now
+        const auto& meshes = hfmModel->meshes;
+        NormalsPerMesh normalsPerMesh;
+        TangentsPerMesh tangentsPerMesh;
+        normalsPerMesh.reserve(meshes.size());
+        tangentsPerMesh.reserve(meshes.size());
+        for (const auto& mesh : meshes) {
+            normalsPerMesh.push_back(mesh.normals.toStdVector());
+            tangentsPerMesh.push_back(mesh.tangents.toStdVector());
+        }
+
+        std::vector<graphics::MeshPointer> graphicsMeshes;
+        BuildGraphicsMeshTask::buildGraphicsMeshes(meshes, hifi::URL(hfmModel->originalURL), hfmModel->meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh,
+            hfmModel->shapes, hfmModel->skinDeformers, graphicsMeshes);
+        for (size_t i = 0; i < meshes.size(); i++) {
+            hfmModel->meshes[i]._mesh = graphicsMeshes[i];
+        }
+
+        MaterialMapping materialMapping;
+        auto context = std::make_shared<BakeContext>();
+        ParseMaterialMappingTask().run(context, ParseMaterialMappingTask::Input(mapping, materialMappingBaseURL), materialMapping);
+        return materialMapping;
+    }
 };
@@ -23,6 +23,10 @@
 namespace baker {
     class Baker {
     public:
+        // Bump whenever what the baker, or the serializers feeding it, make of a model changes,
+        // so that models baked and cached by an older version are not used
+        static const int VERSION;
+
         Baker(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL);
 
         std::shared_ptr<TaskConfig> getConfiguration();
@@ -37,6 +41,10 @@ namespace baker {
         // This is a ByteArray and not a std::string because the character sequence can contain the null character (particularly for FBX materials)
         std::vector<std::vector<hifi::ByteArray>> getDracoMaterialLists() const;
 
+        // Builds what a model baked before and read back with readModel() needs at runtime but can't be cached,
+        // which are its graphics meshes and its material mapping, and returns the mapping
+        static MaterialMapping restoreBakedModel(const hfm::Model::Pointer& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& materialMappingBaseURL);
+
     protected:
         EnginePointer _engine;
     };
@@ -380,6 +380,12 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
     const auto& shapes = input.get5();
     const auto& skinDeformers = input.get6();
 
+    buildGraphicsMeshes(meshes, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh, shapes, skinDeformers, output);
+}
+
+void BuildGraphicsMeshTask::buildGraphicsMeshes(const std::vector<hfm::Mesh>& meshes, const hifi::URL& url, const baker::MeshIndicesToModelNames& meshIndicesToModelNames,
+        const baker::NormalsPerMesh& normalsPerMesh, const baker::TangentsPerMesh& tangentsPerMesh, const std::vector<hfm::Shape>& shapes,
+        const std::vector<hfm::SkinDeformer>& skinDeformers, Output& graphicsMeshes) {
     // Currently, there is only (at most) one skinDeformer per mesh
     // An undefined shape.skinDeformer has the value hfm::UNDEFINED_KEY
     std::vector<uint32_t> skinDeformerPerMesh;
@@ -389,11 +395,9 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
         skinDeformerPerMesh[shape.mesh] = skinDeformerIndex;
     }
 
-    auto& graphicsMeshes = output;
-
-    int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    graphicsMeshes.resize(meshes.size());
+    baker::parallelFor(meshes.size(), [&](size_t meshIndex) {
+        int i = (int)meshIndex;
         auto& graphicsMesh = graphicsMeshes[i];
 
         uint16_t numDeformerControllers = 0;
@@ -413,5 +417,5 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
                 graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
             }
         }
-    }
+    });
 }
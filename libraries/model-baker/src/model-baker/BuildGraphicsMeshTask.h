@@ -25,6 +25,10 @@ public:
     using JobModel = baker::Job::ModelIO<BuildGraphicsMeshTask, Input, Output>;
 
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+    static void buildGraphicsMeshes(const std::vector<hfm::Mesh>& meshes, const hifi::URL& url, const baker::MeshIndicesToModelNames& meshIndicesToModelNames,
+        const baker::NormalsPerMesh& normalsPerMesh, const baker::TangentsPerMesh& tangentsPerMesh, const std::vector<hfm::Shape>& shapes,
+        const std::vector<hfm::SkinDeformer>& skinDeformers, Output& graphicsMeshes);
 };
 
 #endif // hifi_BuildGraphicsMeshTask_h
@@ -0,0 +1,159 @@
+//
+//  CoarseModel.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CoarseModel.h"
+
+#include <unordered_map>
+
+#include <TBBHelpers.h>
+
+namespace baker {
+
+size_t countTriangles(const hfm::Model& hfmModel) {
+    size_t numTriangles = 0;
+    for (const auto& mesh : hfmModel.meshes) {
+        for (const auto& part : mesh.parts) {
+            numTriangles += (part.quadTrianglesIndices.size() + part.triangleIndices.size()) / 3;
+        }
+    }
+    return numTriangles;
+}
+
+template <typename T>
+static void keepVertices(QVector<T>& attribute, const std::vector<int>& keptVertices) {
+    if (attribute.empty()) {
+        return;
+    }
+    QVector<T> kept;
+    kept.reserve((int)keptVertices.size());
+    for (int vertex : keptVertices) {
+        kept.push_back(vertex < attribute.size() ? attribute[vertex] : T());
+    }
+    attribute = kept;
+}
+
+static void addTriangles(const QVector<int>& indices, const std::vector<int>& newIndices, QVector<int>& triangles) {
+    for (int i = 0; (i + 2) < indices.size(); i += 3) {
+        int a = newIndices[indices[i]];
+        int b = newIndices[indices[i + 1]];
+        int c = newIndices[indices[i + 2]];
+        // the triangles whose vertices merged together are gone
+        if (a != b && b != c && c != a) {
+            triangles << a << b << c;
+        }
+    }
+}
+
+static hfm::Mesh makeCoarseMesh(const hfm::Mesh& mesh, int resolution) {
+    hfm::Mesh coarseMesh;
+    coarseMesh.meshExtents = mesh.meshExtents;
+    coarseMesh.modelTransform = mesh.modelTransform;
+    coarseMesh.meshIndex = mesh.meshIndex;
+    coarseMesh.wasCompressed = mesh.wasCompressed;
+    coarseMesh.clusterWeightsPerVertex = mesh.clusterWeightsPerVertex;
+
+    const int numVertices = mesh.vertices.size();
+    Extents extents;
+    for (const auto& vertex : mesh.vertices) {
+        extents.addPoint(vertex);
+    }
+    float cellSize = extents.largestDimension() / (float)resolution;
+    if (cellSize <= 0.0f) {
+        cellSize = 1.0f;
+    }
+
+    // every vertex is merged into the first one found in its cell
+    std::vector<int> newIndices(numVertices);
+    std::vector<int> keptVertices;
+    std::unordered_map<uint64_t, int> cells;
+    const uint64_t CELL_BITS = 21;
+    const uint64_t CELL_MASK = ((uint64_t)1 << CELL_BITS) - 1;
+    for (int i = 0; i < numVertices; ++i) {
+        glm::vec3 cell = glm::floor((mesh.vertices[i] - extents.minimum) / cellSize);
+        uint64_t key = ((uint64_t)cell.x & CELL_MASK) | (((uint64_t)cell.y & CELL_MASK) << CELL_BITS) |
+            (((uint64_t)cell.z & CELL_MASK) << (2 * CELL_BITS));
+        auto inserted = cells.emplace(key, (int)keptVertices.size());
+        if (inserted.second) {
+            keptVertices.push_back(i);
+        }
+        newIndices[i] = inserted.first->second;
+    }
+
+    coarseMesh.vertices = mesh.vertices;
+    coarseMesh.normals = mesh.normals;
+    coarseMesh.tangents = mesh.tangents;
+    coarseMesh.colors = mesh.colors;
+    coarseMesh.texCoords = mesh.texCoords;
+    coarseMesh.texCoords1 = mesh.texCoords1;
+    coarseMesh.originalIndices = mesh.originalIndices;
+    keepVertices(coarseMesh.vertices, keptVertices);
+    keepVertices(coarseMesh.normals, keptVertices);
+    keepVertices(coarseMesh.tangents, keptVertices);
+    keepVertices(coarseMesh.colors, keptVertices);
+    keepVertices(coarseMesh.texCoords, keptVertices);
+    keepVertices(coarseMesh.texCoords1, keptVertices);
+    keepVertices(coarseMesh.originalIndices, keptVertices);
+
+    const size_t weightsPerVertex = mesh.clusterWeightsPerVertex;
+    if (weightsPerVertex > 0 && mesh.clusterIndices.size() >= numVertices * weightsPerVertex) {
+        coarseMesh.clusterIndices.reserve(keptVertices.size() * weightsPerVertex);
+        coarseMesh.clusterWeights.reserve(keptVertices.size() * weightsPerVertex);
+        for (int vertex : keptVertices) {
+            auto first = vertex * weightsPerVertex;
+            coarseMesh.clusterIndices.insert(coarseMesh.clusterIndices.end(),
+                mesh.clusterIndices.begin() + first, mesh.clusterIndices.begin() + first + weightsPerVertex);
+            if (mesh.clusterWeights.size() >= numVertices * weightsPerVertex) {
+                coarseMesh.clusterWeights.insert(coarseMesh.clusterWeights.end(),
+                    mesh.clusterWeights.begin() + first, mesh.clusterWeights.begin() + first + weightsPerVertex);
+            }
+        }
+    }
+
+    // the blendshapes only move the vertices that were kept
+    for (const auto& blendshape : mesh.blendshapes) {
+        hfm::Blendshape coarseBlendshape;
+        for (int i = 0; i < blendshape.indices.size(); ++i) {
+            int vertex = blendshape.indices[i];
+            if (vertex < 0 || vertex >= numVertices || keptVertices[newIndices[vertex]] != vertex) {
+                continue;
+            }
+            coarseBlendshape.indices.push_back(newIndices[vertex]);
+            if (i < blendshape.vertices.size()) {
+                coarseBlendshape.vertices.push_back(blendshape.vertices[i]);
+            }
+            if (i < blendshape.normals.size()) {
+                coarseBlendshape.normals.push_back(blendshape.normals[i]);
+            }
+            if (i < blendshape.tangents.size()) {
+                coarseBlendshape.tangents.push_back(blendshape.tangents[i]);
+            }
+        }
+        coarseMesh.blendshapes.push_back(coarseBlendshape);
+    }
+
+    // the quads are triangulated, so the normals of the coarse mesh aren't made to match them
+    coarseMesh.parts.resize(mesh.parts.size());
+    for (size_t i = 0; i < mesh.parts.size(); ++i) {
+        addTriangles(mesh.parts[i].quadTrianglesIndices, newIndices, coarseMesh.parts[i].triangleIndices);
+        addTriangles(mesh.parts[i].triangleIndices, newIndices, coarseMesh.parts[i].triangleIndices);
+    }
+
+    return coarseMesh;
+}
+
+hfm::Model::Pointer makeCoarseModel(const hfm::Model& hfmModel, int resolution) {
+    auto coarseModel = std::make_shared<hfm::Model>(hfmModel);
+    tbb::parallel_for((size_t)0, hfmModel.meshes.size(), [&](size_t i) {
+        coarseModel->meshes[i] = makeCoarseMesh(hfmModel.meshes[i], resolution);
+    });
+    return coarseModel;
+}
+
+};
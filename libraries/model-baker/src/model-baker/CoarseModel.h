@@ -0,0 +1,28 @@
+//
+//  CoarseModel.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_baker_CoarseModel_h
+#define hifi_baker_CoarseModel_h
+
+#include <hfm/HFM.h>
+
+namespace baker {
+    // How many cells the longest side of each mesh is split into by makeCoarseModel()
+    static const int COARSE_MODEL_RESOLUTION = 48;
+
+    size_t countTriangles(const hfm::Model& hfmModel);
+
+    // A stand-in for a model that hasn't been baked yet, to be shown until it is. Each mesh is simplified by merging all
+    // the vertices that fall in the same cell of a grid, resolution cells across, into the first of them.
+    // Everything else is kept as it is, so the stand-in has the same meshes, parts, joints and materials as the model.
+    hfm::Model::Pointer makeCoarseModel(const hfm::Model& hfmModel, int resolution = COARSE_MODEL_RESOLUTION);
+};
+
+#endif // hifi_baker_CoarseModel_h
@@ -12,7 +12,10 @@
 #ifndef hifi_baker_Engine_h
 #define hifi_baker_Engine_h
 
+#include <functional>
+
 #include <task/Task.h>
+#include <TBBHelpers.h>
 
 namespace baker {
 
@@ -27,6 +30,57 @@ namespace baker {
 
     using EnginePointer = std::shared_ptr<Engine>;
 
+    // A task whose jobs don't depend on each other's outputs, so they can all run at the same time.
+    // Each job runs with its own copy of the context, since running a job sets the context's job config.
+    template <class T, class C = JobConfig, class I = Job::None, class O = Job::None>
+    class ParallelTaskModel : public Task::TaskModel<T, C, I, O> {
+    public:
+        using Base = Task::TaskModel<T, C, I, O>;
+
+        ParallelTaskModel(const std::string& name, const Varying& input, task::QConfigPointer config) : Base(name, input, config) {}
+
+        template <class... A>
+        static std::shared_ptr<ParallelTaskModel> create(const std::string& name, const Varying& input, A&&... args) {
+            auto model = std::make_shared<ParallelTaskModel>(name, input, std::make_shared<C>());
+
+            {
+                BakerTimeProfiler probe("build::" + model->getName());
+                model->_data.build(*(model), model->_input, model->_output, std::forward<A>(args)...);
+            }
+
+            return model;
+        }
+
+        void run(const BakeContextPointer& jobContext) override {
+            auto config = std::static_pointer_cast<C>(Base::_config);
+            if (config->isEnabled()) {
+                auto& jobs = Base::_jobs;
+                tbb::parallel_for(0, (int)jobs.size(), [&](int i) {
+                    auto context = std::make_shared<BakeContext>(*jobContext);
+                    jobs[i].run(context);
+                });
+            }
+        }
+    };
+
+    // Groups the jobs added by the builder into a ParallelTaskModel. The builder passes the jobs' outputs on
+    // to the rest of the graph by capturing the varyings it assigns them to.
+    class ParallelJobs {
+    public:
+        using JobModel = ParallelTaskModel<ParallelJobs>;
+        using Builder = std::function<void(JobModel& model)>;
+
+        void build(JobModel& model, const Varying& input, Varying& output, const Builder& builder) { builder(model); }
+    };
+
+    // Calls function(i) for every i in [0, count), spread across the worker threads
+    template <typename F>
+    void parallelFor(size_t count, F&& function) {
+        tbb::parallel_for((size_t)0, count, [&](size_t i) {
+            function(i);
+        });
+    }
+
 };
 
 #endif // hifi_baker_Engine_h
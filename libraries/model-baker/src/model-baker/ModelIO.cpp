@@ -0,0 +1,457 @@
+//
+//  ModelIO.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelIO.h"
+
+#include <algorithm>
+
+#include <QtCore/QDataStream>
+
+namespace {
+
+const quint32 MODEL_MAGIC { 0x4c444d48 }; // "HMDL"
+const QDataStream::Version MODEL_STREAM_VERSION { QDataStream::Qt_5_9 };
+
+// Plain data is written as it is laid out in memory, which is fine for a cache that never leaves the machine.
+// The writer and the reader have the same interface, so one set of functions below describes both directions.
+class ModelWriter {
+public:
+    ModelWriter(QDataStream& stream) : _stream(stream) {}
+
+    template <typename T>
+    void raw(const T& value) {
+        _stream.writeRawData(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void rawVector(const std::vector<T>& values) {
+        writeRawArray(values.data(), values.size());
+    }
+
+    template <typename T>
+    void rawVector(const QVector<T>& values) {
+        writeRawArray(values.constData(), (size_t)values.size());
+    }
+
+    template <typename K, typename V>
+    void rawMap(const QMap<K, V>& values) {
+        raw((quint64)values.size());
+        for (auto it = values.cbegin(); it != values.cend(); ++it) {
+            raw(it.key());
+            raw(it.value());
+        }
+    }
+
+    template <typename Container, typename F>
+    void vector(const Container& values, F transfer) {
+        raw((quint64)values.size());
+        for (const auto& value : values) {
+            transfer(value);
+        }
+    }
+
+    // Anything Qt can stream
+    template <typename T>
+    void qt(const T& value) {
+        _stream << value;
+    }
+
+    void transform(const Transform& transform) {
+        raw(transform.getTranslation());
+        raw(transform.getRotation());
+        raw(transform.getScale());
+    }
+
+    void material(const graphics::MaterialPointer& material) {
+        raw((bool)material);
+        if (!material) {
+            return;
+        }
+        // What the serializers set, which is all done through setters that the reader calls again
+        const auto& key = material->getKey();
+        qt(QString::fromStdString(material->getName()));
+        qt(QString::fromStdString(material->getModel()));
+        raw(key.isAlbedo());
+        raw(key.isUnlit());
+        raw(material->getOpacityMapMode());
+        raw(material->getCullFaceMode());
+        raw(material->getAlbedo(false));
+        raw(material->getEmissive(false));
+        raw(material->getOpacity());
+        raw(material->getOpacityCutoff());
+        raw(material->getMetallic());
+        raw(material->getRoughness());
+        raw(material->getScattering());
+    }
+
+private:
+    template <typename T>
+    void writeRawArray(const T* values, size_t count) {
+        raw((quint64)count);
+        if (count > 0) {
+            _stream.writeRawData(reinterpret_cast<const char*>(values), (int)(count * sizeof(T)));
+        }
+    }
+
+    QDataStream& _stream;
+};
+
+class ModelReader {
+public:
+    ModelReader(QDataStream& stream) : _stream(stream) {}
+
+    bool isValid() const { return _stream.status() == QDataStream::Ok; }
+
+    template <typename T>
+    void raw(T& value) {
+        readRaw(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void rawVector(std::vector<T>& values) {
+        values.resize(readCount(sizeof(T)));
+        readRaw(values.data(), values.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void rawVector(QVector<T>& values) {
+        values.resize((int)readCount(sizeof(T)));
+        readRaw(values.data(), (size_t)values.size() * sizeof(T));
+    }
+
+    template <typename K, typename V>
+    void rawMap(QMap<K, V>& values) {
+        values.clear();
+        size_t count = readCount(sizeof(K) + sizeof(V));
+        for (size_t i = 0; i < count && isValid(); ++i) {
+            K key;
+            V value;
+            raw(key);
+            raw(value);
+            values.insert(key, value);
+        }
+    }
+
+    template <typename Container, typename F>
+    void vector(Container& values, F transfer) {
+        // Everything written element by element takes at least a byte
+        values.resize(static_cast<typename Container::size_type>(readCount(1)));
+        for (auto& value : values) {
+            if (!isValid()) {
+                break;
+            }
+            transfer(value);
+        }
+    }
+
+    template <typename T>
+    void qt(T& value) {
+        if (isValid()) {
+            _stream >> value;
+        }
+    }
+
+    void transform(Transform& transform) {
+        glm::vec3 translation;
+        glm::quat rotation;
+        glm::vec3 scale;
+        raw(translation);
+        raw(rotation);
+        raw(scale);
+        transform = Transform();
+        transform.setTranslation(translation);
+        transform.setRotation(rotation);
+        transform.setScale(scale);
+    }
+
+    void material(graphics::MaterialPointer& material) {
+        bool hasMaterial { false };
+        raw(hasMaterial);
+        if (!hasMaterial) {
+            material.reset();
+            return;
+        }
+        QString name;
+        QString model;
+        bool isAlbedo { false };
+        bool isUnlit { false };
+        graphics::MaterialKey::OpacityMapMode opacityMapMode;
+        graphics::MaterialKey::CullFaceMode cullFaceMode;
+        glm::vec3 albedo;
+        glm::vec3 emissive;
+        float opacity;
+        float opacityCutoff;
+        float metallic;
+        float roughness;
+        float scattering;
+        qt(name);
+        qt(model);
+        raw(isAlbedo);
+        raw(isUnlit);
+        raw(opacityMapMode);
+        raw(cullFaceMode);
+        raw(albedo);
+        raw(emissive);
+        raw(opacity);
+        raw(opacityCutoff);
+        raw(metallic);
+        raw(roughness);
+        raw(scattering);
+        if (!isValid()) {
+            return;
+        }
+
+        material = std::make_shared<graphics::Material>();
+        material->setName(name.toStdString());
+        material->setModel(model.toStdString());
+        material->setEmissive(emissive, false);
+        material->setOpacity(opacity);
+        material->setOpacityMapMode(opacityMapMode);
+        material->setOpacityCutoff(opacityCutoff);
+        material->setCullFaceMode(cullFaceMode);
+        material->setUnlit(isUnlit);
+        if (isAlbedo) {
+            material->setAlbedo(albedo, false);
+        }
+        material->setMetallic(metallic);
+        material->setRoughness(roughness);
+        material->setScattering(scattering);
+    }
+
+private:
+    // The number of elements that follows, which can't be more than fit in the bytes left
+    size_t readCount(size_t elementSize) {
+        quint64 count { 0 };
+        raw(count);
+        quint64 available = (quint64)std::max<qint64>(_stream.device()->bytesAvailable(), 0);
+        if (!isValid() || count > available / elementSize) {
+            _stream.setStatus(QDataStream::ReadCorruptData);
+            return 0;
+        }
+        return (size_t)count;
+    }
+
+    void readRaw(void* data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        if (!isValid() || _stream.readRawData(reinterpret_cast<char*>(data), (int)size) != (int)size) {
+            _stream.setStatus(QDataStream::ReadPastEnd);
+        }
+    }
+
+    QDataStream& _stream;
+};
+
+template <typename IO, typename Texture>
+void transferTexture(IO& io, Texture& texture) {
+    io.qt(texture.id);
+    io.qt(texture.name);
+    io.qt(texture.filename);
+    io.qt(texture.content);
+    io.raw(texture.sourceChannel);
+    io.transform(texture.transform);
+    io.raw(texture.maxNumPixels);
+    io.raw(texture.texcoordSet);
+    io.qt(texture.texcoordSetName);
+    io.raw(texture.isBumpmap);
+}
+
+template <typename IO, typename Material>
+void transferMaterial(IO& io, Material& material) {
+    io.raw(material.diffuseColor);
+    io.raw(material.diffuseFactor);
+    io.raw(material.specularColor);
+    io.raw(material.specularFactor);
+    io.raw(material.emissiveColor);
+    io.raw(material.emissiveFactor);
+    io.raw(material.shininess);
+    io.raw(material.opacity);
+    io.raw(material.metallic);
+    io.raw(material.roughness);
+    io.raw(material.emissiveIntensity);
+    io.raw(material.ambientFactor);
+    io.raw(material.bumpMultiplier);
+    io.raw(material.alphaMode);
+    io.raw(material.alphaCutoff);
+    io.qt(material.materialID);
+    io.qt(material.name);
+    io.qt(material.shadingModel);
+    io.material(material._material);
+    transferTexture(io, material.normalTexture);
+    transferTexture(io, material.albedoTexture);
+    transferTexture(io, material.opacityTexture);
+    transferTexture(io, material.glossTexture);
+    transferTexture(io, material.roughnessTexture);
+    transferTexture(io, material.specularTexture);
+    transferTexture(io, material.metallicTexture);
+    transferTexture(io, material.emissiveTexture);
+    transferTexture(io, material.occlusionTexture);
+    transferTexture(io, material.scatteringTexture);
+    transferTexture(io, material.lightmapTexture);
+    io.raw(material.lightmapParams);
+    io.raw(material.isPBSMaterial);
+    io.raw(material.useNormalMap);
+    io.raw(material.useAlbedoMap);
+    io.raw(material.useOpacityMap);
+    io.raw(material.useRoughnessMap);
+    io.raw(material.useSpecularMap);
+    io.raw(material.useMetallicMap);
+    io.raw(material.useEmissiveMap);
+    io.raw(material.useOcclusionMap);
+}
+
+template <typename IO, typename Joint>
+void transferJoint(IO& io, Joint& joint) {
+    io.raw(joint.shapeInfo.avgPoint);
+    io.rawVector(joint.shapeInfo.dots);
+    io.rawVector(joint.shapeInfo.points);
+    io.rawVector(joint.shapeInfo.debugLines);
+    io.raw(joint.parentIndex);
+    io.raw(joint.distanceToParent);
+    io.raw(joint.translation);
+    io.raw(joint.preTransform);
+    io.raw(joint.preRotation);
+    io.raw(joint.rotation);
+    io.raw(joint.postRotation);
+    io.raw(joint.postTransform);
+    io.raw(joint.transform);
+    io.raw(joint.rotationMin);
+    io.raw(joint.rotationMax);
+    io.raw(joint.inverseDefaultRotation);
+    io.raw(joint.inverseBindRotation);
+    io.raw(joint.bindTransform);
+    io.qt(joint.name);
+    io.raw(joint.isSkeletonJoint);
+    io.raw(joint.bindTransformFoundInCluster);
+    io.raw(joint.geometricOffset);
+    io.raw(joint.localTransform);
+    io.raw(joint.globalTransform);
+}
+
+template <typename IO, typename Mesh>
+void transferMesh(IO& io, Mesh& mesh) {
+    io.vector(mesh.parts, [&](auto& part) {
+        io.rawVector(part.quadIndices);
+        io.rawVector(part.quadTrianglesIndices);
+        io.rawVector(part.triangleIndices);
+    });
+    io.rawVector(mesh.vertices);
+    io.rawVector(mesh.normals);
+    io.rawVector(mesh.tangents);
+    io.rawVector(mesh.colors);
+    io.rawVector(mesh.texCoords);
+    io.rawVector(mesh.texCoords1);
+    io.raw(mesh.meshExtents);
+    io.raw(mesh.modelTransform);
+    io.rawVector(mesh.clusterIndices);
+    io.rawVector(mesh.clusterWeights);
+    io.raw(mesh.clusterWeightsPerVertex);
+    io.vector(mesh.blendshapes, [&](auto& blendshape) {
+        io.rawVector(blendshape.indices);
+        io.rawVector(blendshape.vertices);
+        io.rawVector(blendshape.normals);
+        io.rawVector(blendshape.tangents);
+    });
+    io.rawVector(mesh.triangleListMesh.vertices);
+    io.rawVector(mesh.triangleListMesh.indices);
+    io.rawVector(mesh.triangleListMesh.parts);
+    io.rawVector(mesh.triangleListMesh.partExtents);
+    io.rawVector(mesh.originalIndices);
+    io.raw(mesh.meshIndex);
+    io.raw(mesh.wasCompressed);
+}
+
+template <typename IO, typename Model>
+void transferModel(IO& io, Model& hfmModel) {
+    io.qt(hfmModel.originalURL);
+    io.qt(hfmModel.author);
+    io.qt(hfmModel.applicationName);
+    io.vector(hfmModel.shapes, [&](auto& shape) {
+        io.raw(shape.mesh);
+        io.raw(shape.meshPart);
+        io.raw(shape.material);
+        io.raw(shape.joint);
+        io.raw(shape.transformedExtents);
+        io.raw(shape.skinDeformer);
+    });
+    io.vector(hfmModel.meshes, [&](auto& mesh) {
+        transferMesh(io, mesh);
+    });
+    io.vector(hfmModel.materials, [&](auto& material) {
+        transferMaterial(io, material);
+    });
+    io.vector(hfmModel.skinDeformers, [&](auto& skinDeformer) {
+        io.vector(skinDeformer.clusters, [&](auto& cluster) {
+            io.raw(cluster.jointIndex);
+            io.raw(cluster.inverseBindMatrix);
+            io.transform(cluster.inverseBindTransform);
+        });
+    });
+    io.vector(hfmModel.joints, [&](auto& joint) {
+        transferJoint(io, joint);
+    });
+    io.qt(hfmModel.jointIndices);
+    io.raw(hfmModel.hasSkeletonJoints);
+    io.qt(hfmModel.scripts);
+    io.raw(hfmModel.offset);
+    io.raw(hfmModel.neckPivot);
+    io.raw(hfmModel.bindExtents);
+    io.raw(hfmModel.meshExtents);
+    io.vector(hfmModel.animationFrames, [&](auto& animationFrame) {
+        io.rawVector(animationFrame.rotations);
+        io.rawVector(animationFrame.translations);
+    });
+    io.qt(hfmModel.meshIndicesToModelNames);
+    io.qt(hfmModel.blendshapeChannelNames);
+    io.rawMap(hfmModel.jointRotationOffsets);
+    io.vector(hfmModel.shapeVertices, [&](auto& shapeVertices) {
+        io.rawVector(shapeVertices);
+    });
+    io.qt(hfmModel.flowData._physicsConfig);
+    io.qt(hfmModel.flowData._collisionsConfig);
+}
+
+}
+
+namespace baker {
+
+hifi::ByteArray writeModel(const hfm::Model& hfmModel) {
+    hifi::ByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(MODEL_STREAM_VERSION);
+        stream << MODEL_MAGIC << (qint32)MODEL_IO_VERSION;
+        ModelWriter writer(stream);
+        transferModel(writer, hfmModel);
+    }
+    return data;
+}
+
+hfm::Model::Pointer readModel(const hifi::ByteArray& data) {
+    QDataStream stream(data);
+    stream.setVersion(MODEL_STREAM_VERSION);
+    quint32 magic { 0 };
+    qint32 version { 0 };
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != MODEL_MAGIC || version != MODEL_IO_VERSION) {
+        return nullptr;
+    }
+
+    auto hfmModel = std::make_shared<hfm::Model>();
+    ModelReader reader(stream);
+    transferModel(reader, *hfmModel);
+    if (!reader.isValid() || !stream.atEnd()) {
+        return nullptr;
+    }
+    return hfmModel;
+}
+
+};
@@ -0,0 +1,29 @@
+//
+//  ModelIO.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_baker_ModelIO_h
+#define hifi_baker_ModelIO_h
+
+#include <hfm/HFM.h>
+#include <shared/HifiTypes.h>
+
+namespace baker {
+    // The version of what writeModel() writes. Bump it whenever hfm::Model, or how it is written, changes.
+    static const int MODEL_IO_VERSION = 1;
+
+    // Writes a baked model so it can be kept in a cache on this machine, and read back instead of baked again.
+    // Everything is written but the graphics meshes, which Baker::restoreBakedModel() builds again.
+    hifi::ByteArray writeModel(const hfm::Model& hfmModel);
+
+    // Answers nullptr if the data was not written by this version of writeModel(), or is cut short
+    hfm::Model::Pointer readModel(const hifi::ByteArray& data);
+};
+
+#endif // hifi_baker_ModelIO_h
@@ -16,6 +16,7 @@
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
+#include <QDataStream>
 #include <QThreadPool>
 
 #include <Gzip.h>
@@ -28,6 +29,8 @@
 #include <OBJSerializer.h>
 #include <GLTFSerializer.h>
 #include <model-baker/Baker.h>
+#include <model-baker/CoarseModel.h>
+#include <model-baker/ModelIO.h>
 
 Q_LOGGING_CATEGORY(trace_resource_parse_geometry, "trace.resource.parse.geometry")
 
@@ -36,6 +39,7 @@ public:
     const GeometryMappingPair& mapping;
     const QUrl& textureBaseUrl;
     bool combineParts;
+    bool progressive;
 };
 
 int geometryMappingPairTypeId = qRegisterMetaType<GeometryMappingPair>("GeometryMappingPair");
@@ -79,17 +83,56 @@ namespace std {
         size_t operator()(const GeometryExtra& geometryExtra) const {
             size_t result = 0;
             hash_combine(result, geometryExtra.mapping.first, geometryExtra.mapping.second, geometryExtra.textureBaseUrl,
-                geometryExtra.combineParts);
+                geometryExtra.combineParts, geometryExtra.progressive);
             return result;
         }
     };
 }
 
+// QVariantHash iterates in an order that changes from run to run, so mappings are turned into maps before being
+// hashed into the key of a baked model
+static QVariant canonicalizeMapping(const QVariant& value) {
+    if (value.type() == QVariant::Hash) {
+        const auto hash = value.toHash();
+        QVariantMap map;
+        for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+            map.insertMulti(it.key(), canonicalizeMapping(it.value()));
+        }
+        return map;
+    } else if (value.type() == QVariant::Map) {
+        const auto original = value.toMap();
+        QVariantMap map;
+        for (auto it = original.cbegin(); it != original.cend(); ++it) {
+            map.insertMulti(it.key(), canonicalizeMapping(it.value()));
+        }
+        return map;
+    } else if (value.type() == QVariant::List) {
+        QVariantList list;
+        for (const auto& element : value.toList()) {
+            list.push_back(canonicalizeMapping(element));
+        }
+        return list;
+    }
+    return value;
+}
+
+static cache::Key makeBakedModelKey(const QByteArray& data, const QVariantHash& serializerMapping) {
+    QByteArray options;
+    QDataStream stream(&options, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << (qint32)baker::MODEL_IO_VERSION << canonicalizeMapping(serializerMapping);
+    return cache::BakedAssetCache::makeKey("model", baker::Baker::VERSION, data, options);
+}
+
+// Models with fewer triangles than this are shown once they are baked, without a coarse stand-in first
+static const size_t PROGRESSIVE_MIN_TRIANGLES = 100000;
+
 class GeometryReader : public QRunnable {
 public:
     GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
-                   const QByteArray& data, bool combineParts, const QString& webMediaType) :
-        _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType) {
+                   const QByteArray& data, bool combineParts, bool progressive, const QString& webMediaType) :
+        _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts),
+        _progressive(progressive), _webMediaType(webMediaType) {
 
         DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
@@ -103,6 +146,7 @@ private:
     GeometryMappingPair _mapping;
     QByteArray _data;
     bool _combineParts;
+    bool _progressive;
     QString _webMediaType;
 };
 
@@ -123,6 +167,7 @@ void GeometryReader::run() {
         return;
     }
 
+    bool isRefining = false;
     try {
         if (_data.isEmpty()) {
             throw QString("reply is NULL");
@@ -144,6 +189,9 @@ void GeometryReader::run() {
         serializerMapping["combineParts"] = _combineParts;
         serializerMapping["deduplicateIndices"] = true;
 
+        QByteArray modelData = _data;
+        QUrl modelUrl = _url;
+        std::string webMediaType = _webMediaType.toStdString();
         if (_url.path().toLower().endsWith(".gz")) {
             QByteArray uncompressedData;
             if (!gunzip(_data, uncompressedData)) {
@@ -151,13 +199,32 @@ void GeometryReader::run() {
             }
             // Strip the compression extension from the path, so the loader can infer the file type from what remains.
             // This is okay because we don't expect the serializer to be able to read the contents of a compressed model file.
-            auto strippedUrl = _url;
-            strippedUrl.setPath(_url.path().left(_url.path().size() - 3));
-            hfmModel = _modelLoader.load(uncompressedData, serializerMapping, strippedUrl, "");
-        } else {
-            hfmModel = _modelLoader.load(_data, serializerMapping, _url, _webMediaType.toStdString());
+            modelData = uncompressedData;
+            modelUrl.setPath(_url.path().left(_url.path().size() - 3));
+            webMediaType = "";
         }
 
+        // Models that load nothing besides their own data are read back as they were baked the last time
+        auto modelCache = DependencyManager::get<ModelCache>();
+        auto bakedAssetCache = modelCache ? modelCache->getBakedAssetCache() : cache::BakedAssetCachePointer();
+        cache::Key bakedModelKey;
+        if (bakedAssetCache && _modelLoader.isSelfContained(modelData, modelUrl, webMediaType)) {
+            bakedModelKey = makeBakedModelKey(modelData, serializerMapping);
+            cache::BakedAssetCache::Entries entries;
+            if (bakedAssetCache->load(bakedModelKey, entries) && entries.size() == 1) {
+                auto bakedModel = baker::readModel(entries.front().second);
+                if (bakedModel) {
+                    bakedModel->originalURL = modelUrl.toString();
+                    auto materialMapping = baker::Baker::restoreBakedModel(bakedModel, _mapping.second, _mapping.first);
+                    QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
+                            Q_ARG(HFMModel::Pointer, bakedModel), Q_ARG(MaterialMapping, materialMapping));
+                    return;
+                }
+            }
+        }
+
+        hfmModel = _modelLoader.load(modelData, serializerMapping, modelUrl, webMediaType);
+
         if (!hfmModel) {
             throw QString("unsupported format");
         }
@@ -174,6 +241,23 @@ void GeometryReader::run() {
             }
         }
 
+        // Large models are shown coarse while they bake. Those with blendshapes aren't, since what is blended for the
+        // coarse meshes wouldn't fit the refined ones.
+        size_t numTriangles = baker::countTriangles(*hfmModel);
+        if (_progressive && numTriangles >= PROGRESSIVE_MIN_TRIANGLES &&
+                std::none_of(hfmModel->meshes.cbegin(), hfmModel->meshes.cend(), [](const HFMMesh& mesh) {
+                    return !mesh.blendshapes.empty();
+                })) {
+            auto coarseModel = baker::makeCoarseModel(*hfmModel);
+            if (baker::countTriangles(*coarseModel) * 2 <= numTriangles) {
+                baker::Baker coarseBaker(coarseModel, _mapping.second, _mapping.first);
+                coarseBaker.run();
+                QMetaObject::invokeMethod(resource.data(), "setCoarseGeometryDefinition",
+                        Q_ARG(HFMModel::Pointer, coarseBaker.getHFMModel()), Q_ARG(MaterialMapping, coarseBaker.getMaterialMapping()));
+                isRefining = true;
+            }
+        }
+
         // Do processing on the model
         baker::Baker modelBaker(hfmModel, _mapping.second, _mapping.first);
         modelBaker.run();
@@ -181,18 +265,36 @@ void GeometryReader::run() {
         auto processedHFMModel = modelBaker.getHFMModel();
         auto materialMapping = modelBaker.getMaterialMapping();
 
-        QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
-                Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
+        // written before the model is handed over, and stored once it is
+        QByteArray bakedModel;
+        if (!bakedModelKey.empty()) {
+            bakedModel = baker::writeModel(*processedHFMModel);
+        }
+
+        if (isRefining) {
+            QMetaObject::invokeMethod(resource.data(), "refineGeometryDefinition", Q_ARG(HFMModel::Pointer, processedHFMModel));
+        } else {
+            QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
+                    Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
+        }
+
+        if (!bakedModelKey.empty()) {
+            bakedAssetCache->store(bakedModelKey, { { "model", bakedModel } });
+        }
     } catch (const std::exception&) {
         auto resource = _resource.toStrongRef();
-        if (resource) {
+        if (resource && isRefining) {
+            QMetaObject::invokeMethod(resource.data(), "refineGeometryDefinition", Q_ARG(HFMModel::Pointer, nullptr));
+        } else if (resource) {
             QMetaObject::invokeMethod(resource.data(), "finishedLoading",
                 Q_ARG(bool, false));
         }
     } catch (QString& e) {
         qCWarning(modelnetworking) << "Exception while loading model --" << e;
         auto resource = _resource.toStrongRef();
-        if (resource) {
+        if (resource && isRefining) {
+            QMetaObject::invokeMethod(resource.data(), "refineGeometryDefinition", Q_ARG(HFMModel::Pointer, nullptr));
+        } else if (resource) {
             QMetaObject::invokeMethod(resource.data(), "finishedLoading",
                                       Q_ARG(bool, false));
         }
@@ -210,11 +312,19 @@ ModelResource::ModelResource(const ModelResource& other) :
     _mappingPair(other._mappingPair),
     _textureBaseURL(other._textureBaseURL),
     _combineParts(other._combineParts),
+    _progressive(other._progressive),
     _isCacheable(other._isCacheable)
 {
-    if (other._modelResource) {
+    if (other._modelResource || other._isRefining) {
         _startedLoading = false;
     }
+    if (other._isRefining) {
+        // loaded again, rather than left with the coarse stand-in
+        _loaded = false;
+        _hfmModel.reset();
+        _meshes.reset();
+        _materials.clear();
+    }
 }
 
 void ModelResource::downloadFinished(const QByteArray& data) {
@@ -265,7 +375,7 @@ void ModelResource::downloadFinished(const QByteArray& data) {
             }
 
             auto modelCache = DependencyManager::get<ModelCache>();
-            GeometryExtra extra { GeometryMappingPair(base, _mapping), _textureBaseURL, false };
+            GeometryExtra extra { GeometryMappingPair(base, _mapping), _textureBaseURL, false, _progressive };
 
             // Get the raw ModelResource
             _modelResource = modelCache->getResource(url, QUrl(), &extra, std::hash<GeometryExtra>()(extra)).staticCast<ModelResource>();
@@ -287,7 +397,8 @@ void ModelResource::downloadFinished(const QByteArray& data) {
             _url = _effectiveBaseURL;
             _textureBaseURL = _effectiveBaseURL;
         }
-        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+        DependencyManager::get<ModelCache>()->startReading(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data,
+            _combineParts, _progressive, _request->getWebMediaType()), getLoadPriority());
     }
 }
 
@@ -298,8 +409,14 @@ void ModelResource::onGeometryMappingLoaded(bool success) {
         _meshes = _modelResource->_meshes;
         _materials = _modelResource->_materials;
 
-        // Avoid holding onto extra references
-        _modelResource.reset();
+        // Refined along with the raw model
+        _isRefining = _modelResource->_isRefining;
+        if (_isRefining) {
+            _refinedConnection = connect(_modelResource.data(), &ModelResource::refined, this, &ModelResource::onGeometryMappingRefined);
+        } else {
+            // Avoid holding onto extra references
+            _modelResource.reset();
+        }
         // Make sure connection will not trigger again
         disconnect(_connection); // FIXME Should not have to do this
     }
@@ -308,11 +425,24 @@ void ModelResource::onGeometryMappingLoaded(bool success) {
     finishedLoading(success);
 }
 
+void ModelResource::onGeometryMappingRefined() {
+    if (_modelResource) {
+        _hfmModel = _modelResource->_hfmModel;
+        _meshes = _modelResource->_meshes;
+        _modelResource.reset();
+    }
+    disconnect(_refinedConnection);
+
+    _isRefining = false;
+    emit refined();
+}
+
 void ModelResource::setExtra(void* extra) {
     const GeometryExtra* geometryExtra = static_cast<const GeometryExtra*>(extra);
     _mappingPair = geometryExtra ? geometryExtra->mapping : GeometryMappingPair(QUrl(), QVariantHash());
     _textureBaseURL = geometryExtra ? resolveTextureBaseUrl(_url, geometryExtra->textureBaseUrl) : QUrl();
     _combineParts = geometryExtra ? geometryExtra->combineParts : true;
+    _progressive = geometryExtra ? geometryExtra->progressive : false;
 }
 
 void ModelResource::setGeometryDefinition(HFMModel::Pointer hfmModel, const MaterialMapping& materialMapping) {
@@ -339,6 +469,31 @@ void ModelResource::setGeometryDefinition(HFMModel::Pointer hfmModel, const Mate
     finishedLoading(true);
 }
 
+void ModelResource::setCoarseGeometryDefinition(HFMModel::Pointer hfmModel, const MaterialMapping& materialMapping) {
+    _isRefining = true;
+    setGeometryDefinition(hfmModel, materialMapping);
+}
+
+void ModelResource::refineGeometryDefinition(HFMModel::Pointer hfmModel) {
+    if (!_isRefining) {
+        return;
+    }
+
+    if (hfmModel) {
+        _hfmModel = hfmModel;
+        std::shared_ptr<GeometryMeshes> meshes = std::make_shared<GeometryMeshes>();
+        for (const HFMMesh& mesh : _hfmModel->meshes) {
+            meshes->emplace_back(mesh._mesh);
+        }
+        _meshes = meshes;
+    } else {
+        qCWarning(modelnetworking) << "Failed to refine" << _url << "; keeping its coarse stand-in";
+    }
+
+    _isRefining = false;
+    emit refined();
+}
+
 void ModelResource::deleter() {
     resetTextures();
     Resource::deleter();
@@ -356,6 +511,9 @@ void ModelResource::resetTextures() {
     _materials.clear();
 }
 
+// the oven and the asset server keep their own baked asset caches
+static const QString BAKED_ASSET_CACHE_OWNER = "interface";
+
 ModelCache::ModelCache() {
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
@@ -365,6 +523,19 @@ ModelCache::ModelCache() {
     modelFormatRegistry->addFormat(FBXSerializer());
     modelFormatRegistry->addFormat(OBJSerializer());
     modelFormatRegistry->addFormat(GLTFSerializer());
+
+    _bakedAssetCache = std::make_shared<cache::BakedAssetCache>(cache::BakedAssetCache::getDefaultDirectory(BAKED_ASSET_CACHE_OWNER).toStdString());
+    _bakedAssetCache->initialize();
+
+    // Leave a core to the texture readers and everything else on the global pool
+    _readerPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+}
+
+void ModelCache::startReading(QRunnable* reader, float loadPriority) {
+    // QThreadPool runs the readers with the highest priority first, the load priorities of models are the angle they span
+    const float READER_PRIORITY_SCALE = 1000.0f;
+    const float MAX_READER_PRIORITY = 1.0e6f;
+    _readerPool.start(reader, (int)glm::clamp(loadPriority * READER_PRIORITY_SCALE, -MAX_READER_PRIORITY, MAX_READER_PRIORITY));
 }
 
 QSharedPointer<Resource> ModelCache::createResource(const QUrl& url) {
@@ -377,7 +548,8 @@ QSharedPointer<Resource> ModelCache::createResourceCopy(const QSharedPointer<Res
 
 ModelResource::Pointer ModelCache::getModelResource(const QUrl& url, const GeometryMappingPair& mapping, const QUrl& textureBaseUrl) {
     bool combineParts = true;
-    GeometryExtra geometryExtra = { mapping, textureBaseUrl, combineParts };
+    bool progressive = true;
+    GeometryExtra geometryExtra = { mapping, textureBaseUrl, combineParts, progressive };
     ModelResource::Pointer resource = getResource(url, QUrl(), &geometryExtra, std::hash<GeometryExtra>()(geometryExtra)).staticCast<ModelResource>();
     if (resource) {
         if (resource->isLoaded() && resource->shouldSetTextures()) {
@@ -391,7 +563,8 @@ ModelResource::Pointer ModelCache::getCollisionModelResource(const QUrl& url,
                                                                    const GeometryMappingPair& mapping,
                                                                    const QUrl& textureBaseUrl) {
     bool combineParts = false;
-    GeometryExtra geometryExtra = { mapping, textureBaseUrl, combineParts };
+    bool progressive = false;
+    GeometryExtra geometryExtra = { mapping, textureBaseUrl, combineParts, progressive };
     ModelResource::Pointer resource = getResource(url, QUrl(), &geometryExtra, std::hash<GeometryExtra>()(geometryExtra)).staticCast<ModelResource>();
     if (resource) {
         if (resource->isLoaded() && resource->shouldSetTextures()) {
@@ -490,6 +663,11 @@ bool NetworkModel::areTexturesLoaded() const {
     return true;
 }
 
+void NetworkModel::setRefinedGeometry(const NetworkModel& refined) {
+    _hfmModel = refined._hfmModel;
+    _meshes = refined._meshes;
+}
+
 const std::shared_ptr<NetworkMaterial> NetworkModel::getShapeMaterial(int shapeID) const {
     uint32_t materialID = getHFMModel().shapes[shapeID].material;
     if (materialID < (uint32_t)_materials.size()) {
@@ -501,6 +679,7 @@ const std::shared_ptr<NetworkMaterial> NetworkModel::getShapeMaterial(int shapeI
 void ModelResourceWatcher::startWatching() {
     connect(_resource.data(), &Resource::finished, this, &ModelResourceWatcher::resourceFinished);
     connect(_resource.data(), &Resource::onRefresh, this, &ModelResourceWatcher::resourceRefreshed);
+    connect(_resource.data(), &ModelResource::refined, this, &ModelResourceWatcher::resourceRefined);
     if (_resource->isLoaded()) {
         resourceFinished(!_resource->getURL().isEmpty());
     }
@@ -509,6 +688,7 @@ void ModelResourceWatcher::startWatching() {
 void ModelResourceWatcher::stopWatching() {
     disconnect(_resource.data(), &Resource::finished, this, &ModelResourceWatcher::resourceFinished);
     disconnect(_resource.data(), &Resource::onRefresh, this, &ModelResourceWatcher::resourceRefreshed);
+    disconnect(_resource.data(), &ModelResource::refined, this, &ModelResourceWatcher::resourceRefined);
 }
 
 void ModelResourceWatcher::setResource(ModelResource::Pointer resource) {
@@ -519,6 +699,9 @@ void ModelResourceWatcher::setResource(ModelResource::Pointer resource) {
     if (_resource) {
         if (_resource->isLoaded()) {
             resourceFinished(true);
+            if (_resource->isRefining()) {
+                connect(_resource.data(), &ModelResource::refined, this, &ModelResourceWatcher::resourceRefined);
+            }
         } else {
             startWatching();
         }
@@ -532,6 +715,15 @@ void ModelResourceWatcher::resourceFinished(bool success) {
     emit finished(success);
 }
 
+void ModelResourceWatcher::resourceRefined() {
+    if (_networkModelRef) {
+        auto networkModel = std::make_shared<NetworkModel>(*_networkModelRef);
+        networkModel->setRefinedGeometry(*_resource);
+        _networkModelRef = networkModel;
+        emit refined();
+    }
+}
+
 void ModelResourceWatcher::resourceRefreshed() {
     // FIXME: Model is not set up to handle a refresh
     // _instance.reset();
@@ -12,10 +12,13 @@
 #ifndef hifi_ModelCache_h
 #define hifi_ModelCache_h
 
+#include <QtCore/QThreadPool>
+
 #include <DependencyManager.h>
 #include <ResourceCache.h>
 
 #include <graphics/Asset.h>
+#include <shared/BakedAssetCache.h>
 
 #include "FBXSerializer.h"
 #include <procedural/ProceduralMaterialCache.h>
@@ -55,6 +58,9 @@ public:
     const QUrl& getAnimGraphOverrideUrl() const { return _animGraphOverrideUrl; }
     const QVariantHash& getMapping() const { return _mapping; }
 
+    // Takes the geometry of the refined model, which has the same meshes, parts and materials, and keeps the materials
+    void setRefinedGeometry(const NetworkModel& refined);
+
 protected:
     // Shared across all geometries, constant throughout lifetime
     HFMModel::ConstPointer _hfmModel;
@@ -89,13 +95,24 @@ public:
 
     virtual bool areTexturesLoaded() const override { return isLoaded() && NetworkModel::areTexturesLoaded(); }
 
+    // Whether the model is loaded with a coarse stand-in, while the model itself is still being baked
+    bool isRefining() const { return _isRefining; }
+
+signals:
+    // The coarse stand-in has been replaced by the model itself
+    void refined();
+
 private slots:
     void onGeometryMappingLoaded(bool success);
+    void onGeometryMappingRefined();
 
 protected:
     friend class ModelCache;
 
     Q_INVOKABLE void setGeometryDefinition(HFMModel::Pointer hfmModel, const MaterialMapping& materialMapping);
+    Q_INVOKABLE void setCoarseGeometryDefinition(HFMModel::Pointer hfmModel, const MaterialMapping& materialMapping);
+    // A null model leaves the coarse stand-in in place, when the model itself failed to bake
+    Q_INVOKABLE void refineGeometryDefinition(HFMModel::Pointer hfmModel);
 
     // Geometries may not hold onto textures while cached - that is for the texture cache
     // Instead, these methods clear and reset textures from the geometry when caching/loading
@@ -110,9 +127,12 @@ private:
     GeometryMappingPair _mappingPair;
     QUrl _textureBaseURL;
     bool _combineParts;
+    bool _progressive { false };
+    bool _isRefining { false };
 
     ModelResource::Pointer _modelResource;
     QMetaObject::Connection _connection;
+    QMetaObject::Connection _refinedConnection;
 
     bool _isCacheable{ true };
 };
@@ -130,6 +150,7 @@ public:
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
+    bool isRefining() const { return _resource && _resource->isRefining(); }
 
 private:
     void startWatching();
@@ -137,10 +158,12 @@ private:
 
 signals:
     void finished(bool success);
+    void refined();
 
 private slots:
     void resourceFinished(bool success);
     void resourceRefreshed();
+    void resourceRefined();
 
 private:
     ModelResource::Pointer _resource;
@@ -154,6 +177,7 @@ class ModelCache : public ResourceCache, public Dependency {
 
 public:
 
+    // Large models are shown as a coarse stand-in while they bake, see ModelResource::isRefining()
     ModelResource::Pointer getModelResource(const QUrl& url,
                                                   const GeometryMappingPair& mapping =
                                                         GeometryMappingPair(QUrl(), QVariantHash()),
@@ -164,9 +188,16 @@ public:
                                                                  GeometryMappingPair(QUrl(), QVariantHash()),
                                                            const QUrl& textureBaseUrl = QUrl());
 
+    // Where models that took long to bake are kept, to be read back the next time the same content loads
+    cache::BakedAssetCachePointer getBakedAssetCache() const { return _bakedAssetCache; }
+
 protected:
     friend class ModelResource;
 
+    // The models are read and baked on threads of their own, so they don't wait behind the textures,
+    // nearest and largest first as set by Resource::setLoadPriority()
+    void startReading(QRunnable* reader, float loadPriority);
+
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
 
@@ -174,6 +205,8 @@ private:
     ModelCache();
     virtual ~ModelCache() = default;
     ModelLoader _modelLoader;
+    cache::BakedAssetCachePointer _bakedAssetCache;
+    QThreadPool _readerPool;
 };
 
 #endif // hifi_ModelCache_h
@@ -22,3 +22,8 @@ hfm::Model::Pointer ModelLoader::load(const hifi::ByteArray& data, const hifi::V
     }
     return serializer->read(data, mapping, url);
 }
+
+bool ModelLoader::isSelfContained(const hifi::ByteArray& data, const hifi::URL& url, const std::string& webMediaType) const {
+    auto serializer = DependencyManager::get<ModelFormatRegistry>()->getSerializerForMediaType(data, url, webMediaType);
+    return serializer && serializer->getMediaType().name == "fbx";
+}
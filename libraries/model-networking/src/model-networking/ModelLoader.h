@@ -21,6 +21,10 @@ public:
     // If successful, return an owned reference to the newly loaded model.
     // If failed, return an empty reference.
     hfm::Model::Pointer load(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url, const std::string& webMediaType) const;
+
+    // True if loading the model needs nothing but its data and mapping, so what it bakes to can be reused by content.
+    // FBX files embed or only name their textures, whereas OBJ and glTF files load materials and buffers of their own.
+    bool isSelfContained(const hifi::ByteArray& data, const hifi::URL& url, const std::string& webMediaType) const;
 };
 
 #endif // hifi_ModelLoader_h
@@ -36,7 +36,8 @@ public:
         MessagesMixerType = 4,
         EntityScriptServerType = 5,
         EntityServerType = 6,
-        AllTypes = 7
+        EntityPhysicsServerType = 7,
+        AllTypes = 8
     };
 
     enum Command {
@@ -116,6 +116,16 @@ public:
     };
     Q_ENUM(ConnectReason);
 
+    // DomainList packets carry a revision of the domain-server's node list, and each node entry is
+    // prefixed with the kind of change it describes so that a list can be a delta from an earlier revision
+    using DomainListRevision = quint32;
+    static const DomainListRevision NULL_DOMAIN_LIST_REVISION = 0;
+
+    enum DomainListEntryType : quint8 {
+        NodeAddedOrUpdated = 0,
+        NodeRemoved
+    };
+
     QUuid getSessionUUID() const;
     void setSessionUUID(const QUuid& sessionUUID);
     Node::LocalID getSessionLocalID() const;
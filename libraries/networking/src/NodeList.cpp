@@ -110,6 +110,9 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // anytime we get a new node we may need to re-send our set of ignored node IDs to it
     connect(this, &LimitedNodeList::nodeActivated, this, &NodeList::maybeSendIgnoreSetToNode);
 
+    // nodes we drop on our own are not part of the domain-server's delta updates
+    connect(this, &LimitedNodeList::nodeKilled, this, &NodeList::handleNodeKilled);
+
     // setup our timer to send keepalive pings (it's started and stopped on domain connect/disconnect)
     _keepAlivePingTimer.setInterval(KEEPALIVE_PING_INTERVAL_MS); // 1s, Qt::CoarseTimer acceptable
     connect(&_keepAlivePingTimer, &QTimer::timeout, this, &NodeList::sendKeepAlivePings);
@@ -288,6 +291,11 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    // we no longer know any nodes, so ask for a full domain list next time
+    _domainListRevision = NULL_DOMAIN_LIST_REVISION;
+    _pendingDomainListSequenceNumber = 0;
+    _pendingDomainListEntries = 0;
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -296,10 +304,19 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
 
 void NodeList::addNodeTypeToInterestSet(NodeType_t nodeTypeToAdd) {
     _nodeTypesOfInterest << nodeTypeToAdd;
+
+    // we need a full domain list to hear about the nodes of this type that we don't know yet
+    _domainListRevision = NULL_DOMAIN_LIST_REVISION;
 }
 
 void NodeList::addSetOfNodeTypesToNodeInterestSet(const NodeSet& setOfNodeTypes) {
     _nodeTypesOfInterest.unite(setOfNodeTypes);
+    _domainListRevision = NULL_DOMAIN_LIST_REVISION;
+}
+
+void NodeList::resetNodeInterestSet() {
+    _nodeTypesOfInterest.clear();
+    _domainListRevision = NULL_DOMAIN_LIST_REVISION;
 }
 
 void NodeList::sendDomainServerCheckIn() {
@@ -466,7 +483,10 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << publicSockAddr << localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
-        if (!domainIsConnected) {
+        if (domainIsConnected) {
+            // let the domain-server know which revision of the node list we have, so it only sends us what changed
+            packetStream << _domainListRevision.load();
+        } else {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
 
@@ -707,6 +727,18 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     bool newConnection;
     packetStream >> newConnection;
 
+    DomainListRevision listRevision;
+    packetStream >> listRevision;
+
+    DomainListRevision baseRevision;
+    packetStream >> baseRevision;
+
+    quint32 listSequenceNumber;
+    packetStream >> listSequenceNumber;
+
+    quint32 numListEntries;
+    packetStream >> numListEntries;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -786,9 +818,41 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
+    if (newConnection) {
+        // a fresh connection always comes with a full list, anything we knew before is stale
+        _domainListRevision = NULL_DOMAIN_LIST_REVISION;
+    }
+
+    // a list can be spread over several unreliable packets, each with this same header - keep count of the entries
+    // we've received of this list and only claim its revision once all of them are in. Several lists can bring us to
+    // the same revision, so the entries are counted per list and not per revision, or the entries of one could make up
+    // for a lost packet of another.
+    if (listSequenceNumber != _pendingDomainListSequenceNumber) {
+        _pendingDomainListSequenceNumber = listSequenceNumber;
+        _pendingDomainListEntries = 0;
+    }
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        quint8 entryType;
+        packetStream >> entryType;
+
+        if (entryType == NodeRemoved) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            removeNodeForDomainServer(nodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
+
+        ++_pendingDomainListEntries;
+    }
+
+    // a delta is only useful to us if it starts at or before a revision we have completely, since the domain-server
+    // collapses every change after its base revision into the delta it sends
+    bool canApplyRevision = baseRevision == NULL_DOMAIN_LIST_REVISION || baseRevision <= _domainListRevision;
+    if (canApplyRevision && _pendingDomainListEntries == numListEntries && listRevision > _domainListRevision) {
+        _domainListRevision = listRevision;
     }
 }
 
@@ -804,10 +868,25 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+    removeNodeForDomainServer(nodeUUID);
+}
+
+void NodeList::removeNodeForDomainServer(const QUuid& nodeUUID) {
+    _isRemovingNodeForDomainServer = true;
     killNodeWithUUID(nodeUUID);
+    _isRemovingNodeForDomainServer = false;
+
     removeDelayedAdd(nodeUUID);
 }
 
+void NodeList::handleNodeKilled(SharedNodePointer node) {
+    if (!_isRemovingNodeForDomainServer) {
+        // we dropped a node the domain-server may still have (e.g. it went silent on us)
+        // so we need a full domain list to get it back if it is still around
+        _domainListRevision = NULL_DOMAIN_LIST_REVISION;
+    }
+}
+
 void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     NewNodeInfo info;
 
@@ -65,7 +65,7 @@ public:
     const NodeSet& getNodeInterestSet() const { return _nodeTypesOfInterest; }
     void addNodeTypeToInterestSet(NodeType_t nodeTypeToAdd);
     void addSetOfNodeTypesToNodeInterestSet(const NodeSet& setOfNodeTypes);
-    void resetNodeInterestSet() { _nodeTypesOfInterest.clear(); }
+    void resetNodeInterestSet();
 
     void setAssignmentServerSocket(const HifiSockAddr& serverSocket) { _assignmentServerSocket = serverSocket; }
     void sendAssignment(Assignment& assignment);
@@ -147,6 +147,8 @@ private slots:
 
     void maybeSendIgnoreSetToNode(SharedNodePointer node);
 
+    void handleNodeKilled(SharedNodePointer node);
+
 private:
     NodeList() : LimitedNodeList(INVALID_PORT, INVALID_PORT) { assert(false); } // Not implemented, needed for DependencyManager templates compile
     NodeList(char ownerType, int socketListenPort = INVALID_PORT, int dtlsListenPort = INVALID_PORT);
@@ -161,6 +163,7 @@ private:
     void sendDSPathQuery(const QString& newPath);
 
     void parseNodeFromPacketStream(QDataStream& packetStream);
+    void removeNodeForDomainServer(const QUuid& nodeUUID);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -174,6 +177,12 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData { false };
 
+    // the last revision of the domain-server's node list we received completely, and the list we are receiving
+    std::atomic<DomainListRevision> _domainListRevision { NULL_DOMAIN_LIST_REVISION };
+    quint32 _pendingDomainListSequenceNumber { 0 };
+    quint32 _pendingDomainListEntries { 0 };
+    bool _isRemovingNodeForDomainServer { false };
+
     bool _sendDomainServerCheckInEnabled { true };
 
     mutable QReadWriteLock _ignoredSetLock;
@@ -27,7 +27,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::StunResponse:
             return 17;
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::HasConnectReason);
+            return static_cast<PacketVersion>(DomainListVersion::HasDeltaUpdates);
         case PacketType::EntityAdd:
         case PacketType::EntityClone:
         case PacketType::EntityEdit:
@@ -99,6 +99,9 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::BulkAvatarTraitsAck:
         case PacketType::BulkAvatarTraits:
             return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarTraitsAck);
+        case PacketType::RequestAssignment:
+        case PacketType::CreateAssignment:
+            return static_cast<PacketVersion>(AssignmentVersion::EntityPhysicsServerType);
         default:
             return 22;
     }
@@ -136,6 +136,9 @@ public:
         BulkAvatarTraitsAck,
         StopInjector,
         AvatarZonePresence,
+        AssignmentClientFailed,
+        AudioShardPeers,
+        AudioShardHandoff,
         NUM_PACKET_TYPE
     };
 
@@ -187,7 +190,8 @@ public:
             << PacketTypeEnum::Value::ReplicatedMicrophoneAudioWithEcho << PacketTypeEnum::Value::ReplicatedInjectAudio
             << PacketTypeEnum::Value::ReplicatedSilentAudioFrame << PacketTypeEnum::Value::ReplicatedAvatarIdentity
             << PacketTypeEnum::Value::ReplicatedKillAvatar << PacketTypeEnum::Value::ReplicatedBulkAvatarData
-            << PacketTypeEnum::Value::AvatarZonePresence;
+            << PacketTypeEnum::Value::AvatarZonePresence << PacketTypeEnum::Value::AssignmentClientFailed
+            << PacketTypeEnum::Value::AudioShardPeers;
         return NON_SOURCED_PACKETS;
     }
 
@@ -377,7 +381,8 @@ enum class DomainListVersion : PacketVersion {
     GetMachineFingerprintFromUUIDSupport,
     AuthenticationOptional,
     HasTimestamp,
-    HasConnectReason
+    HasConnectReason,
+    HasDeltaUpdates
 };
 
 enum class AudioVersion : PacketVersion {
@@ -408,4 +413,8 @@ enum class AvatarQueryVersion : PacketVersion {
     ConicalFrustums = 22
 };
 
+enum class AssignmentVersion : PacketVersion {
+    EntityPhysicsServerType = 23
+};
+
 #endif // hifi_PacketHeaders_h
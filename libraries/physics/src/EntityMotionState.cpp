@@ -28,6 +28,7 @@
 const uint8_t LOOPS_FOR_SIMULATION_ORPHAN = 50;
 const quint64 USECS_BETWEEN_OWNERSHIP_BIDS = USECS_PER_SECOND / 5;
 
+uint8_t EntityMotionState::_volunteerPriority { VOLUNTEER_SIMULATION_PRIORITY };
 
 EntityMotionState::EntityMotionState(btCollisionShape* shape, EntityItemPointer entity) :
     ObjectMotionState(nullptr),
@@ -748,7 +749,7 @@ bool EntityMotionState::shouldSendBid() const {
     return _body->isActive()
         && (_region == workload::Region::R1)
         && _ownershipState != EntityMotionState::OwnershipState::Unownable
-        && glm::max(glm::max(VOLUNTEER_SIMULATION_PRIORITY, _bumpedPriority), _entity->getScriptSimulationPriority()) >= _entity->getSimulationPriority()
+        && glm::max(glm::max(_volunteerPriority, _bumpedPriority), _entity->getScriptSimulationPriority()) >= _entity->getSimulationPriority()
         && !_entity->getLocked()
         && (!_body->isStaticOrKinematicObject() || _entity->stillHasMyGrab());
 }
@@ -764,7 +765,7 @@ void EntityMotionState::setRigidBody(btRigidBody* body) {
 
 uint8_t EntityMotionState::computeFinalBidPriority() const {
     return (_region == workload::Region::R1) ?
-        glm::max(glm::max(VOLUNTEER_SIMULATION_PRIORITY, _bumpedPriority), _entity->getScriptSimulationPriority()) : 0;
+        glm::max(glm::max(_volunteerPriority, _bumpedPriority), _entity->getScriptSimulationPriority()) : 0;
 }
 
 bool EntityMotionState::isLocallyOwned() const {
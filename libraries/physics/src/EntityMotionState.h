@@ -37,6 +37,10 @@ public:
     EntityMotionState(btCollisionShape* shape, EntityItemPointer item);
     virtual ~EntityMotionState();
 
+    // The least priority active entities in R1 are bid for, VOLUNTEER unless this participant is a physics server
+    static void setVolunteerPriority(uint8_t priority) { _volunteerPriority = priority; }
+    static uint8_t getVolunteerPriority() { return _volunteerPriority; }
+
     void handleDeactivation();
     virtual void handleEasyChanges(uint32_t& flags) override;
 
@@ -157,6 +161,8 @@ protected:
     uint8_t _bumpedPriority { 0 }; // the target simulation priority according to collision history
     uint8_t _region { workload::Region::INVALID };
 
+    static uint8_t _volunteerPriority;
+
     bool isServerlessMode();
 };
 
@@ -18,6 +18,7 @@
 #include "PhysicsLogging.h"
 #include "ShapeManager.h"
 
+const float PhysicalEntitySimulation::SIMULATION_REGION_MARGIN { 2.0f }; // meters
 
 PhysicalEntitySimulation::PhysicalEntitySimulation() {
 }
@@ -39,11 +40,41 @@ void PhysicalEntitySimulation::init(
     _entityPacketSender = packetSender;
 }
 
+void PhysicalEntitySimulation::setSimulationRegion(const AABox& region) {
+    QMutexLocker lock(&_mutex);
+    _simulationRegion = region;
+}
+
+uint8_t PhysicalEntitySimulation::computeRegion(const EntityItemPointer& entity) {
+    if (_space) {
+        return _space->getRegion(entity->getSpaceIndex());
+    }
+    AABox simulationRegion;
+    {
+        // setSimulationRegion() may be called from another thread
+        QMutexLocker lock(&_mutex);
+        simulationRegion = _simulationRegion;
+    }
+    // headless: we own what is inside the simulation region and keep simulating what is just outside it,
+    // without bidding, so that another simulation can take it over as it crosses the edge
+    bool success;
+    glm::vec3 position = entity->getWorldPosition(success);
+    if (!success) {
+        return workload::Region::UNKNOWN;
+    }
+    if (simulationRegion.contains(position)) {
+        return workload::Region::R1;
+    }
+    const glm::vec3 MARGIN(SIMULATION_REGION_MARGIN);
+    AABox margin(simulationRegion.getCorner() - MARGIN, simulationRegion.getScale() + 2.0f * MARGIN);
+    return margin.contains(position) ? workload::Region::R2 : workload::Region::R3;
+}
+
 // begin EntitySimulation overrides
 void PhysicalEntitySimulation::addEntityToInternalLists(EntityItemPointer entity) {
     EntitySimulation::addEntityToInternalLists(entity);
     entity->deserializeActions(); // TODO: do this elsewhere
-    uint8_t region = _space->getRegion(entity->getSpaceIndex());
+    uint8_t region = computeRegion(entity);
     bool maybeShouldBePhysical = (region < workload::Region::R3 || region == workload::Region::UNKNOWN) && entity->shouldBePhysical();
     bool canBeKinematic = region <= workload::Region::R3;
     if (maybeShouldBePhysical) {
@@ -117,7 +148,7 @@ void PhysicalEntitySimulation::processChangedEntity(const EntityItemPointer& ent
 
     // queue incoming changes: from external sources (script, EntityServer, etc) to physics engine
     EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
-    uint8_t region = _space->getRegion(entity->getSpaceIndex());
+    uint8_t region = computeRegion(entity);
     bool shouldBePhysical = region < workload::Region::R3 && entity->shouldBePhysical();
     bool canBeKinematic = region <= workload::Region::R3;
     if (motionState) {
@@ -264,7 +295,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     auto buildMotionState = [&](btCollisionShape* shape, EntityItemPointer entity) {
         EntityMotionState* motionState = new EntityMotionState(shape, entity);
         entity->setPhysicsInfo(static_cast<void*>(motionState));
-        motionState->setRegion(_space->getRegion(entity->getSpaceIndex()));
+        motionState->setRegion(computeRegion(entity));
         _physicalObjects.insert(motionState);
         _incomingChanges.insert(motionState);
     };
@@ -352,7 +383,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
             continue;
         }
 
-        uint8_t region = _space->getRegion(entity->getSpaceIndex());
+        uint8_t region = computeRegion(entity);
         if (region == workload::Region::UNKNOWN) {
             // the workload hasn't categorized it yet --> skip for later
             ++entityItr;
@@ -541,6 +572,10 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
         if (state->getType() == MOTIONSTATE_TYPE_ENTITY) {
             EntityMotionState* entityState = static_cast<EntityMotionState*>(state);
             _entitiesToSort.insert(entityState->getEntity());
+            if (!_space && computeRegion(entityState->getEntity()) != entityState->_region) {
+                // without a workload nothing else notices the entity crossing the edge of the simulation region
+                changeEntity(entityState->getEntity());
+            }
             if (entityState->getOwnershipState() == EntityMotionState::OwnershipState::NotLocallyOwned) {
                 // NOTE: entityState->getOwnershipState() reflects what ownership list (_bids or _owned) it is in
                 // and is distinct from entityState->isLocallyOwned() which checks the simulation ownership
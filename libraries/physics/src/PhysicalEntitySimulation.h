@@ -19,6 +19,7 @@
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
+#include <AABox.h>
 #include <EntityDynamicInterface.h>
 #include <EntityItem.h>
 #include <EntitySimulation.h>
@@ -59,6 +60,15 @@ public:
     void init(EntityTreePointer tree, PhysicsEnginePointer engine, EntityEditPacketSender* packetSender);
     void setWorkloadSpace(const workload::SpacePointer space) { _space = space; }
 
+    // How far outside the simulation region entities are still simulated, but not owned
+    static const float SIMULATION_REGION_MARGIN;
+
+    // Without a workload space (e.g. in the entity-physics-server) the entities inside region are simulated and owned,
+    // those within SIMULATION_REGION_MARGIN of it are simulated and the others are left alone
+    void setSimulationRegion(const AABox& region);
+    // The workload region of the entity, from the workload space if there is one, else from the simulation region
+    uint8_t computeRegion(const EntityItemPointer& entity);
+
     void addDynamic(EntityDynamicPointer dynamic) override;
     void removeDynamic(const QUuid dynamicID) override;
     void applyDynamicChanges() override;
@@ -132,6 +142,7 @@ private:
     QMutex _dynamicsMutex { QMutex::Recursive };
 
     workload::SpacePointer _space;
+    AABox _simulationRegion;
     uint64_t _nextBidExpiry;
     uint32_t _lastStepSendPackets { 0 };
     uint32_t _lastWorkDeliveryCount { 0 };
@@ -19,6 +19,10 @@
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#if BT_THREADSAFE
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#endif
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
@@ -45,10 +49,19 @@ PhysicsEngine::~PhysicsEngine() {
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
+        if (_numThreads > 1) {
+            initMultithreading();
+        }
+        if (!_collisionDispatcher) {
+            _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+            _constraintSolver = new btSequentialImpulseConstraintSolver;
+        }
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        if (_isMultithreaded) {
+            // all the constraints are handed to the solver at once, which splits them into batches for its threads
+            _dynamicsWorld->getSimulationIslandManager()->setSplitIslands(false);
+        }
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -70,6 +83,29 @@ void PhysicsEngine::init() {
     }
 }
 
+void PhysicsEngine::initMultithreading() {
+#if BT_THREADSAFE
+    // Bullet's own scheduler, never deleted. Its pool has no more threads than Bullet keeps per thread data for, and they
+    // are the only threads besides this one that ask Bullet for their index.
+    static btITaskScheduler* scheduler = btCreateDefaultTaskScheduler();
+    if (!scheduler) {
+        qCWarning(physics) << "PhysicsEngine::initMultithreading() could not create a task scheduler, stepping on one thread";
+        return;
+    }
+    btSetTaskScheduler(scheduler);
+
+    // The dispatcher sizes its per thread data for the threads of the scheduler when it is created, so it is created
+    // with all of them even though fewer may run
+    scheduler->setNumThreads(scheduler->getMaxNumThreads());
+    _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
+    _constraintSolver = new btSequentialImpulseConstraintSolverMt();
+    scheduler->setNumThreads(_numThreads);
+    _isMultithreaded = true;
+#else
+    qCWarning(physics) << "PhysicsEngine::initMultithreading() Bullet isn't built for multithreading, stepping on one thread";
+#endif
+}
+
 uint32_t PhysicsEngine::getNumSubsteps() const {
     return _dynamicsWorld->getNumSubsteps();
 }
@@ -322,6 +358,12 @@ void PhysicsEngine::stepSimulation() {
 
     int numSubsteps = _dynamicsWorld->stepSimulationWithSubstepCallback(timeStep, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS,
                                                                         PHYSICS_ENGINE_FIXED_SUBSTEP, onSubStep);
+#if BT_THREADSAFE
+    if (_isMultithreaded) {
+        // let the threads of the scheduler sleep until the next step
+        btGetTaskScheduler()->sleepWorkerThreadsHint();
+    }
+#endif
     if (numSubsteps > 0) {
         _hasOutgoingChanges = true;
         if (_physicsDebugDraw->getDebugMode()) {
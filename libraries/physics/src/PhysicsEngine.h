@@ -94,6 +94,11 @@ public:
 
     PhysicsEngine(const glm::vec3& offset);
     ~PhysicsEngine();
+    // Steps the world on this many threads, 1 (the default) steps it on the calling thread alone. Set before init(), from the
+    // main thread, and only when Bullet is built for multithreading.
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+    bool isMultithreaded() const { return _isMultithreaded; }
     void init();
 
     uint32_t getNumSubsteps() const;
@@ -160,6 +165,7 @@ public:
     void removeContacts(ObjectMotionState* motionState);
 
 private:
+    void initMultithreading();
     QList<EntityDynamicPointer> removeDynamicsForBody(btRigidBody* body);
     void addObjectToDynamicsWorld(ObjectMotionState* motionState);
 
@@ -189,6 +195,8 @@ private:
     CharacterController* _myAvatarController;
 
     uint32_t _numContactFrames { 0 };
+    int _numThreads { 1 };
+    bool _isMultithreaded { false };
 
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
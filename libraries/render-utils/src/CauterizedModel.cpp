@@ -151,11 +151,7 @@ void CauterizedModel::updateClusterMatrices() {
     }
 
     // post the blender if we're not currently waiting for one to finish
-    auto modelBlender = DependencyManager::get<ModelBlender>();
-    if (modelBlender->shouldComputeBlendshapes() && getHFMModel().hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
-    }
+    maybeRequireBlend();
 }
 
 void CauterizedModel::updateRenderItems() {
@@ -206,9 +202,9 @@ void CauterizedModel::updateRenderItems() {
                     const auto& meshState = self->getMeshState(skinDeformerIndex);
                     const auto& cauterizedMeshState = self->getCauterizeMeshState(skinDeformerIndex);
 
-                    transaction.updateItem<ModelMeshPartPayload>(itemID,
-                        [modelTransform, shapeState, meshState, useDualQuaternionSkinning, cauterizedMeshState, invalidatePayloadShapeKey,
-                            primitiveMode, renderItemKeyGlobalFlags, enableCauterization](ModelMeshPartPayload& mmppData) {
+                    transaction.updateIndependentItem<ModelMeshPartPayload>(itemID,
+                        [modelTransform, shapeState, meshState, useDualQuaternionSkinning, cauterizedMeshState,
+                            enableCauterization](ModelMeshPartPayload& mmppData) {
                         CauterizedMeshPartPayload& data = static_cast<CauterizedMeshPartPayload&>(mmppData);
                         if (useDualQuaternionSkinning) {
                             data.updateClusterBuffer(meshState.clusterDualQuaternions, cauterizedMeshState.clusterDualQuaternions);
@@ -225,13 +221,10 @@ void CauterizedModel::updateRenderItems() {
                         data.updateTransformAndBound(modelTransform.worldTransform(shapeState._rootFromJointTransform));
 
                         data.setEnableCauterization(enableCauterization);
-                        data.updateKey(renderItemKeyGlobalFlags);
-                        data.setShapeKey(invalidatePayloadShapeKey, primitiveMode, useDualQuaternionSkinning);
                     });
                 } else {
-                    transaction.updateItem<ModelMeshPartPayload>(itemID,
-                        [modelTransform, shapeState, invalidatePayloadShapeKey, primitiveMode, renderItemKeyGlobalFlags, enableCauterization]
-                             (ModelMeshPartPayload& mmppData) {
+                    transaction.updateIndependentItem<ModelMeshPartPayload>(itemID,
+                        [modelTransform, shapeState, enableCauterization](ModelMeshPartPayload& mmppData) {
                         CauterizedMeshPartPayload& data = static_cast<CauterizedMeshPartPayload&>(mmppData);
 
                         Transform renderTransform = modelTransform;
@@ -241,11 +234,16 @@ void CauterizedModel::updateRenderItems() {
                         data.updateTransformForCauterizedMesh(renderTransform);
 
                         data.setEnableCauterization(enableCauterization);
-                        data.updateKey(renderItemKeyGlobalFlags);
-                        data.setShapeKey(invalidatePayloadShapeKey, primitiveMode, false);
                     });
-                    
                 }
+
+                // Applied on the render thread, after the parts are moved, since the keys read the shared materials
+                bool useDualQuaternionShapeKey = skinDeformerIndex != hfm::UNDEFINED_KEY && useDualQuaternionSkinning;
+                transaction.updateItem<ModelMeshPartPayload>(itemID, [invalidatePayloadShapeKey, primitiveMode, renderItemKeyGlobalFlags,
+                                                                      useDualQuaternionShapeKey](ModelMeshPartPayload& data) {
+                    data.updateKey(renderItemKeyGlobalFlags);
+                    data.setShapeKey(invalidatePayloadShapeKey, primitiveMode, useDualQuaternionShapeKey);
+                });
             }
 
             scene->enqueueTransaction(transaction);
@@ -711,6 +711,7 @@ gpu::Stream::FormatPointer& getInstancedWireFadeStreamFormat() {
 }
 
 QHash<SimpleProgramKey, gpu::PipelinePointer> GeometryCache::_simplePrograms;
+std::mutex GeometryCache::_pipelinesMutex;
 
 gpu::ShaderPointer GeometryCache::_simpleShader;
 gpu::ShaderPointer GeometryCache::_transparentShader;
@@ -742,6 +743,7 @@ GeometryCache::~GeometryCache() {
 }
 
 void GeometryCache::releaseID(int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
     _registeredQuad3DTextures.remove(id);
     _lastRegisteredQuad2DTexture.remove(id);
     _registeredQuad2DTextures.remove(id);
@@ -923,6 +925,7 @@ void GeometryCache::renderGrid(gpu::Batch& batch, const glm::vec2& minCorner, co
     // Make the gridbuffer
     GridBuffer gridBuffer;
     if (id != UNKNOWN_ID) {
+        std::lock_guard<std::mutex> lock(_registeredMutex);
         auto gridBufferIter = _registeredGridBuffers.find(id);
         bool hadGridBuffer = gridBufferIter != _registeredGridBuffers.end();
         if (hadGridBuffer) {
@@ -956,6 +959,7 @@ void GeometryCache::renderGrid(gpu::Batch& batch, const glm::vec2& minCorner, co
 }
 
 void GeometryCache::updateVertices(int id, const QVector<glm::vec2>& points, const QVector<glm::vec4>& colors) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
     BatchItemDetails& details = _registeredVertices[id];
 
     if (details.isCreated) {
@@ -1034,6 +1038,7 @@ void GeometryCache::updateVertices(int id, const QVector<glm::vec2>& points, con
 }
 
 void GeometryCache::updateVertices(int id, const QVector<glm::vec3>& points, const QVector<glm::vec4>& colors) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
     BatchItemDetails& details = _registeredVertices[id];
     if (details.isCreated) {
         details.clear();
@@ -1113,6 +1118,7 @@ void GeometryCache::updateVertices(int id, const QVector<glm::vec3>& points, con
 }
 
 void GeometryCache::updateVertices(int id, const QVector<glm::vec3>& points, const QVector<glm::vec2>& texCoords, const glm::vec4& color) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
     BatchItemDetails& details = _registeredVertices[id];
 
     if (details.isCreated) {
@@ -1192,6 +1198,7 @@ void GeometryCache::updateVertices(int id, const QVector<glm::vec3>& points, con
 }
 
 void GeometryCache::renderVertices(gpu::Batch& batch, gpu::Primitive primitiveType, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
     BatchItemDetails& details = _registeredVertices[id];
     if (details.isCreated) {
         batch.setInputFormat(details.streamFormat);
@@ -1202,6 +1209,7 @@ void GeometryCache::renderVertices(gpu::Batch& batch, gpu::Primitive primitiveTy
 
 
 void GeometryCache::renderBevelCornersRect(gpu::Batch& batch, int x, int y, int width, int height, int bevelDistance, const glm::vec4& color, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
     bool registered = (id != UNKNOWN_ID);
     Vec3Pair key(glm::vec3(x, y, 0.0f), glm::vec3(width, height, bevelDistance));
     BatchItemDetails& details = _registeredBevelRects[id];
@@ -1303,6 +1311,7 @@ void GeometryCache::renderBevelCornersRect(gpu::Batch& batch, int x, int y, int
 }
 
 void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, const glm::vec2& maxCorner, const glm::vec4& color, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
     bool registered = (id != UNKNOWN_ID);
     Vec4Pair key(glm::vec4(minCorner.x, minCorner.y, maxCorner.x, maxCorner.y), color);
     BatchItemDetails& details = _registeredQuad2D[id];
@@ -1388,6 +1397,7 @@ void GeometryCache::renderUnitQuad(gpu::Batch& batch, const glm::vec4& color, in
 void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, const glm::vec2& maxCorner,
     const glm::vec2& texCoordMinCorner, const glm::vec2& texCoordMaxCorner,
     const glm::vec4& color, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
 
     Vec4PairVec4 key(Vec4Pair(glm::vec4(minCorner.x, minCorner.y, maxCorner.x, maxCorner.y),
         glm::vec4(texCoordMinCorner.x, texCoordMinCorner.y, texCoordMaxCorner.x, texCoordMaxCorner.y)),
@@ -1472,6 +1482,7 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, co
 }
 
 void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& minCorner, const glm::vec3& maxCorner, const glm::vec4& color, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
     bool registered = (id != UNKNOWN_ID);
     Vec3PairVec4 key(Vec3Pair(minCorner, maxCorner), color);
     BatchItemDetails& details = _registeredQuad3D[id];
@@ -1553,6 +1564,7 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& topLeft, cons
     const glm::vec2& texCoordTopLeft, const glm::vec2& texCoordBottomLeft,
     const glm::vec2& texCoordBottomRight, const glm::vec2& texCoordTopRight,
     const glm::vec4& color, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
 
 #ifdef WANT_DEBUG
     qCDebug(renderutils) << "renderQuad() vec3 + texture VBO...";
@@ -1648,6 +1660,7 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& topLeft, cons
 
 void GeometryCache::renderDashedLine(gpu::Batch& batch, const glm::vec3& start, const glm::vec3& end, const glm::vec4& color,
     const float dash_length, const float gap_length, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
 
     bool registered = (id != UNKNOWN_ID);
     Vec3PairVec2Pair key(Vec3Pair(start, end), Vec2Pair(glm::vec2(color.x, color.y), glm::vec2(color.z, color.w)));
@@ -1817,6 +1830,7 @@ void GeometryCache::BatchItemDetails::clear() {
 
 void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec3& p1, const glm::vec3& p2,
     const glm::vec4& color1, const glm::vec4& color2, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
 
     bool registered = (id != UNKNOWN_ID);
     Vec3Pair key(p1, p2);
@@ -1906,6 +1920,7 @@ void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec3& p1, const glm
 
 void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec2& p1, const glm::vec2& p2,
     const glm::vec4& color1, const glm::vec4& color2, int id) {
+    std::lock_guard<std::mutex> lock(_registeredMutex);
 
     bool registered = (id != UNKNOWN_ID);
     Vec2Pair key(p1, p2);
@@ -2017,6 +2032,7 @@ void GeometryCache::useSimpleDrawPipeline(gpu::Batch& batch, bool noBlend) {
 }
 
 void GeometryCache::useGridPipeline(gpu::Batch& batch, GridBuffer gridBuffer, bool transparent, bool forward) {
+    std::unique_lock<std::mutex> lock(_pipelinesMutex);
     if (_gridPipelines.empty()) {
         using namespace shader::render_utils::program;
         const float DEPTH_BIAS = 0.001f;
@@ -2043,7 +2059,10 @@ void GeometryCache::useGridPipeline(gpu::Batch& batch, GridBuffer gridBuffer, bo
         }
     }
 
-    batch.setPipeline(_gridPipelines[{ transparent, forward }]);
+    auto pipeline = _gridPipelines[{ transparent, forward }];
+    lock.unlock();
+
+    batch.setPipeline(pipeline);
     batch.setUniformBuffer(0, gridBuffer);
 }
 
@@ -2124,6 +2143,7 @@ void GeometryCache::bindWebBrowserProgram(gpu::Batch& batch, bool transparent, b
 }
 
 gpu::PipelinePointer GeometryCache::getWebBrowserProgram(bool transparent, bool forward) {
+    std::lock_guard<std::mutex> lock(_pipelinesMutex);
     if (_webPipelines.empty()) {
         using namespace shader::render_utils::program;
         const int NUM_WEB_PIPELINES = 4;
@@ -2166,6 +2186,7 @@ gpu::PipelinePointer GeometryCache::getSimplePipeline(bool textured, bool transp
     SimpleProgramKey config { textured, transparent, unlit, depthBiased, fading, isAntiAliased, forward, cullFaceMode };
 
     // If the pipeline already exists, return it
+    std::lock_guard<std::mutex> lock(_pipelinesMutex);
     auto it = _simplePrograms.find(config);
     if (it != _simplePrograms.end()) {
         return it.value();
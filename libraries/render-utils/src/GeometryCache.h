@@ -15,6 +15,8 @@
 #include "model-networking/ModelCache.h"
 
 #include <array>
+#include <atomic>
+#include <mutex>
 
 #include <QMap>
 #include <QRunnable>
@@ -414,7 +416,10 @@ private:
 
     QHash<IntPair, VerticesIndices> _coneVBOs;
 
-    int _nextID{ 1 };
+    std::atomic<int> _nextID{ 1 };
+
+    // the registered buffers are filled lazily by the item renderers, which can record on several threads at once
+    std::mutex _registeredMutex;
 
     QHash<int, Vec3PairVec4Pair> _lastRegisteredQuad3DTexture;
     QHash<int, BatchItemDetails> _registeredQuad3DTextures;
@@ -459,6 +464,8 @@ private:
 
     static std::map<std::tuple<bool, bool, bool, graphics::MaterialKey::CullFaceMode>, render::ShapePipelinePointer> _shapePipelines;
     static QHash<SimpleProgramKey, gpu::PipelinePointer> _simplePrograms;
+    // guards the pipelines above that are made on first use
+    static std::mutex _pipelinesMutex;
 
     static render::ShapePipelinePointer getShapePipeline(bool textured = false, bool transparent = false, bool unlit = false,
         bool depthBias = false, bool forward = false, graphics::MaterialKey::CullFaceMode cullFaceMode = graphics::MaterialKey::CullFaceMode::CULL_BACK);
@@ -208,6 +208,7 @@ void MeshPartPayload::render(RenderArgs* args) {
         if (RenderPipelines::bindMaterials(_drawMaterials, batch, args->_renderMode, args->_enableTexturing)) {
             args->_details._materialSwitches++;
         }
+        RenderPipelines::reportScreenSize(_drawMaterials, args, _worldBound);
     }
 
     // Draw!
@@ -495,6 +496,7 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
         if (RenderPipelines::bindMaterials(_drawMaterials, batch, args->_renderMode, args->_enableTexturing)) {
             args->_details._materialSwitches++;
         }
+        RenderPipelines::reportScreenSize(_drawMaterials, args, _worldBound);
     }
 
     // Draw!
@@ -22,6 +22,7 @@
 #include <GeometryUtil.h>
 #include <PathUtils.h>
 #include <PerfStat.h>
+#include <SharedUtil.h>
 #include <ViewFrustum.h>
 #include <GLMHelpers.h>
 #include <TBBHelpers.h>
@@ -75,6 +76,7 @@ Model::Model(QObject* parent, SpatiallyNestable* spatiallyNestableOverride, uint
     setSnapModelToRegistrationPoint(true, glm::vec3(0.5f));
 
     connect(&_renderWatcher, &ModelResourceWatcher::finished, this, &Model::loadURLFinished);
+    connect(&_renderWatcher, &ModelResourceWatcher::refined, this, &Model::loadURLRefined);
 }
 
 Model::~Model() {
@@ -243,8 +245,8 @@ void Model::updateRenderItems() {
                 const auto& meshState = self->getMeshState(skinDeformerIndex);
                 bool useDualQuaternionSkinning = self->getUseDualQuaternionSkinning();
 
-                transaction.updateItem<ModelMeshPartPayload>(itemID, [modelTransform, shapeState, meshState, useDualQuaternionSkinning,
-                                                                      invalidatePayloadShapeKey, primitiveMode, renderItemKeyGlobalFlags, cauterized](ModelMeshPartPayload& data) {
+                transaction.updateIndependentItem<ModelMeshPartPayload>(itemID, [modelTransform, shapeState, meshState, useDualQuaternionSkinning,
+                                                                                 cauterized](ModelMeshPartPayload& data) {
                     if (useDualQuaternionSkinning) {
                         data.updateClusterBuffer(meshState.clusterDualQuaternions);
                     } else {
@@ -256,20 +258,22 @@ void Model::updateRenderItems() {
                     data.updateTransformAndBound(modelTransform.worldTransform(shapeState._rootFromJointTransform));
 
                     data.setCauterized(cauterized);
-                    data.updateKey(renderItemKeyGlobalFlags);
-                    data.setShapeKey(invalidatePayloadShapeKey, primitiveMode, useDualQuaternionSkinning);
                 });
             } else {
-                transaction.updateItem<ModelMeshPartPayload>(itemID, [modelTransform, shapeState, invalidatePayloadShapeKey, primitiveMode, renderItemKeyGlobalFlags](ModelMeshPartPayload& data) {
-                    
+                transaction.updateIndependentItem<ModelMeshPartPayload>(itemID, [modelTransform, shapeState](ModelMeshPartPayload& data) {
                     Transform renderTransform = modelTransform;
                     renderTransform = modelTransform.worldTransform(shapeState._rootFromJointTransform);
                     data.updateTransform(renderTransform);
-
-                    data.updateKey(renderItemKeyGlobalFlags);
-                    data.setShapeKey(invalidatePayloadShapeKey, primitiveMode, false);
-                }); 
+                });
             }
+
+            // The keys come from the materials, which are shared with the other parts and models that use them
+            bool useDualQuaternionSkinning = skinDeformerIndex != hfm::UNDEFINED_KEY && self->getUseDualQuaternionSkinning();
+            transaction.updateItem<ModelMeshPartPayload>(itemID, [invalidatePayloadShapeKey, primitiveMode, renderItemKeyGlobalFlags,
+                                                                  useDualQuaternionSkinning](ModelMeshPartPayload& data) {
+                data.updateKey(renderItemKeyGlobalFlags);
+                data.setShapeKey(invalidatePayloadShapeKey, primitiveMode, useDualQuaternionSkinning);
+            });
         }
 
         AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
@@ -1245,6 +1249,12 @@ void Model::loadURLFinished(bool success) {
     emit setURLFinished(success);
 }
 
+void Model::loadURLRefined() {
+    // The refined geometry has the same meshes and parts as the coarse one, only the render items are made again
+    _needsFixupInScene = true;
+    invalidCalculatedMeshBoxes();
+}
+
 bool Model::getJointPositionInWorldFrame(int jointIndex, glm::vec3& position) const {
     return _rig.getJointPositionInWorldFrame(jointIndex, position, _translation, _rotation);
 }
@@ -1440,11 +1450,36 @@ void Model::updateClusterMatrices() {
     }
 
     // post the blender if we're not currently waiting for one to finish
+    maybeRequireBlend();
+}
+
+void Model::maybeRequireBlend() {
     auto modelBlender = DependencyManager::get<ModelBlender>();
-    if (modelBlender->shouldComputeBlendshapes() && getHFMModel().hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
+    if (!modelBlender->shouldComputeBlendshapes() || !getHFMModel().hasBlendedMeshes() ||
+        _blendshapeCoefficients == _blendedBlendshapeCoefficients) {
+        return;
+    }
+    if (!ModelBlender::isBlendVisible(_blendshapeCoefficients, _blendedBlendshapeCoefficients)) {
+        modelBlender->noteSkippedBlend();
+        return;
     }
+    // the coefficients are compared with the ones last blended, so the ones put off are blended once the interval is over
+    float priority = evalBlendPriority();
+    uint64_t now = usecTimestampNow();
+    if (now - _lastBlendRequest < ModelBlender::evalBlendInterval(priority, modelBlender->getFrameUsecs())) {
+        modelBlender->noteSkippedBlend();
+        return;
+    }
+    _lastBlendRequest = now;
+    _blendedBlendshapeCoefficients = _blendshapeCoefficients;
+    modelBlender->noteRequiresBlend(getThisPointer(), priority);
+}
+
+float Model::evalBlendPriority() const {
+    const float MIN_BLEND_DISTANCE = 0.1f;
+    float size = getMeshExtents().largestDimension();
+    float distance = glm::distance(getTranslation(), DependencyManager::get<ModelBlender>()->getViewPosition());
+    return size / std::max(distance, MIN_BLEND_DISTANCE);
 }
 
 void Model::deleteGeometry() {
@@ -1453,6 +1488,7 @@ void Model::deleteGeometry() {
     _meshStates.clear();
     _rig.destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
+    _blendshapeBuffers.reset();
     _renderGeometry.reset();
 }
 
@@ -1722,11 +1758,22 @@ static void packBlendshapeOffsetTo_Pos_F32_3xSN10_Nor_3xSN10_Tan_3xSN10(glm::uve
     );
 }
 
-static void packBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, BlendshapeOffsetPacked* packed, int size) {
+// The offsets are accumulated as 9 arrays of stride floats: the x, y and z of the positions, then the normals, then the tangents
+static const int NUM_BLENDSHAPE_COMPONENTS = 9;
+
+static void packBlendshapeOffsetsSoA_ref(const float* accumulated, int stride, BlendshapeOffsetPacked* packed, int size) {
+    for (int i = 0; i < size; ++i) {
+        BlendshapeOffsetUnpacked unpacked;
+        unpacked.positionOffset = glm::vec3(accumulated[i], accumulated[stride + i], accumulated[2 * stride + i]);
+        unpacked.normalOffset = glm::vec3(accumulated[3 * stride + i], accumulated[4 * stride + i], accumulated[5 * stride + i]);
+        unpacked.tangentOffset = glm::vec3(accumulated[6 * stride + i], accumulated[7 * stride + i], accumulated[8 * stride + i]);
+        packBlendshapeOffsetTo_Pos_F32_3xSN10_Nor_3xSN10_Tan_3xSN10(packed[i].packedPosNorTan, unpacked);
+    }
+}
+
+static void accumulateBlendshapeOffsets_ref(float* accumulated, const float* offsets, float coefficient, int size) {
     for (int i = 0; i < size; ++i) {
-        packBlendshapeOffsetTo_Pos_F32_3xSN10_Nor_3xSN10_Tan_3xSN10((*packed).packedPosNorTan, (*unpacked));
-        ++unpacked;
-        ++packed;
+        accumulated[i] += offsets[i] * coefficient;
     }
 }
 
@@ -1736,84 +1783,224 @@ static void packBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, Blends
 //
 #include <CPUDetect.h>
 
-void packBlendshapeOffsets_AVX2(float (*unpacked)[9], uint32_t (*packed)[4], int size);
+void packBlendshapeOffsetsSoA_AVX2(const float* accumulated, int stride, uint32_t (*packed)[4], int size);
+void accumulateBlendshapeOffsets_AVX2(float* accumulated, const float* offsets, float coefficient, int size);
 
-static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, BlendshapeOffsetPacked* packed, int size) {
-    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+static void packBlendshapeOffsetsSoA(const float* accumulated, int stride, BlendshapeOffsetPacked* packed, int size) {
+    // the AVX2 sources are built with FMA too
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2() && cpuSupportsFMA();
     if (_cpuSupportsAVX2) {
-        static_assert(sizeof(BlendshapeOffsetUnpacked) == 9 * sizeof(float), "struct BlendshapeOffsetUnpacked size doesn't match.");
         static_assert(sizeof(BlendshapeOffsetPacked) == 4 * sizeof(uint32_t), "struct BlendshapeOffsetPacked size doesn't match.");
-        packBlendshapeOffsets_AVX2((float(*)[9])unpacked, (uint32_t(*)[4])packed, size);
+        packBlendshapeOffsetsSoA_AVX2(accumulated, stride, (uint32_t(*)[4])packed, size);
     } else {
-        packBlendshapeOffsets_ref(unpacked, packed, size);
+        packBlendshapeOffsetsSoA_ref(accumulated, stride, packed, size);
+    }
+}
+
+static void accumulateBlendshapeOffsets(float* accumulated, const float* offsets, float coefficient, int size) {
+    // the AVX2 sources are built with FMA too
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2() && cpuSupportsFMA();
+    if (_cpuSupportsAVX2) {
+        accumulateBlendshapeOffsets_AVX2(accumulated, offsets, coefficient, size);
+    } else {
+        accumulateBlendshapeOffsets_ref(accumulated, offsets, coefficient, size);
     }
 }
 
 #else   // portable reference code
-static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
+static auto& packBlendshapeOffsetsSoA = packBlendshapeOffsetsSoA_ref;
+static auto& accumulateBlendshapeOffsets = accumulateBlendshapeOffsets_ref;
 #endif
 
+// The blendshapes of a model, laid out for the Blender once, the first time the model blends.
+// Each blendshape keeps its offsets as 9 arrays like the accumulated ones. Those that move most of the vertices in the range
+// they span are kept dense over that range, zeros included, and accumulated with the SIMD kernel. The others are kept sparse,
+// with the index of each vertex they move.
+class BlendshapeBuffers {
+public:
+    struct Blendshape {
+        bool isDense { false };
+        int firstVertex { 0 }; // Dense only
+        int numOffsets { 0 };
+        std::vector<int> indices; // Sparse only
+        std::vector<float> offsets; // NUM_BLENDSHAPE_COMPONENTS * numOffsets
+    };
+    struct Mesh {
+        int numVertices { 0 };
+        std::vector<Blendshape> blendshapes;
+    };
+
+    BlendshapeBuffers(const HFMModel::ConstPointer& hfmModel) : _hfmModel(hfmModel) {}
+
+    bool isFor(const HFMModel::ConstPointer& hfmModel) const { return _hfmModel == hfmModel; }
+
+    // Lays the blendshapes out the first time it is called, from whichever thread
+    const std::vector<Mesh>& getMeshes();
+
+    QVector<BlendshapeOffset> acquireOffsets();
+    void releaseOffsets(const QVector<BlendshapeOffset>& offsets);
+
+private:
+    HFMModel::ConstPointer _hfmModel;
+    std::once_flag _layoutFlag;
+    std::vector<Mesh> _meshes;
+
+    std::mutex _offsetsMutex;
+    std::vector<QVector<BlendshapeOffset>> _freeOffsets;
+};
+
+const std::vector<BlendshapeBuffers::Mesh>& BlendshapeBuffers::getMeshes() {
+    std::call_once(_layoutFlag, [this] {
+        // blendshapes spanning a range of vertices they mostly move are denser than this
+        const float MIN_DENSE_FRACTION = 0.5f;
+
+        _meshes.resize(_hfmModel->meshes.size());
+        for (size_t m = 0; m < _hfmModel->meshes.size(); ++m) {
+            const HFMMesh& hfmMesh = _hfmModel->meshes[m];
+            if (hfmMesh.blendshapes.isEmpty()) {
+                continue;
+            }
+            Mesh& mesh = _meshes[m];
+            mesh.numVertices = hfmMesh.vertices.size();
+            mesh.blendshapes.resize(hfmMesh.blendshapes.size());
+
+            for (int b = 0; b < hfmMesh.blendshapes.size(); ++b) {
+                const HFMBlendshape& hfmBlendshape = hfmMesh.blendshapes.at(b);
+                Blendshape& blendshape = mesh.blendshapes[b];
+
+                int numIndices = 0;
+                int firstVertex = mesh.numVertices;
+                int lastVertex = -1;
+                for (int index : hfmBlendshape.indices) {
+                    if (index >= 0 && index < mesh.numVertices) {
+                        firstVertex = std::min(firstVertex, index);
+                        lastVertex = std::max(lastVertex, index);
+                        ++numIndices;
+                    }
+                }
+                if (numIndices == 0) {
+                    continue;
+                }
+
+                int span = lastVertex - firstVertex + 1;
+                blendshape.isDense = (float)numIndices >= MIN_DENSE_FRACTION * (float)span;
+                blendshape.firstVertex = blendshape.isDense ? firstVertex : 0;
+                blendshape.numOffsets = blendshape.isDense ? span : numIndices;
+                blendshape.offsets.resize(NUM_BLENDSHAPE_COMPONENTS * blendshape.numOffsets, 0.0f);
+
+                int offset = 0;
+                for (int j = 0; j < hfmBlendshape.indices.size(); ++j) {
+                    int index = hfmBlendshape.indices.at(j);
+                    if (index < 0 || index >= mesh.numVertices) {
+                        continue;
+                    }
+                    if (blendshape.isDense) {
+                        offset = index - firstVertex;
+                    } else {
+                        blendshape.indices.push_back(index);
+                    }
+                    glm::vec3 components[3] = {
+                        j < hfmBlendshape.vertices.size() ? hfmBlendshape.vertices.at(j) : glm::vec3(),
+                        j < hfmBlendshape.normals.size() ? hfmBlendshape.normals.at(j) : glm::vec3(),
+                        j < hfmBlendshape.tangents.size() ? hfmBlendshape.tangents.at(j) : glm::vec3()
+                    };
+                    for (int c = 0; c < NUM_BLENDSHAPE_COMPONENTS; ++c) {
+                        blendshape.offsets[c * blendshape.numOffsets + offset] += components[c / 3][c % 3];
+                    }
+                    if (!blendshape.isDense) {
+                        ++offset;
+                    }
+                }
+            }
+        }
+    });
+    return _meshes;
+}
+
+QVector<BlendshapeOffset> BlendshapeBuffers::acquireOffsets() {
+    std::unique_lock<std::mutex> lock(_offsetsMutex);
+    for (auto it = _freeOffsets.begin(); it != _freeOffsets.end(); ++it) {
+        // the ones that are still held onto, until the render items they were passed to take them in, are left for later
+        if (it->isDetached()) {
+            QVector<BlendshapeOffset> offsets = std::move(*it);
+            _freeOffsets.erase(it);
+            return offsets;
+        }
+    }
+    return QVector<BlendshapeOffset>();
+}
+
+void BlendshapeBuffers::releaseOffsets(const QVector<BlendshapeOffset>& offsets) {
+    const size_t MAX_FREE_OFFSETS = 3;
+    std::unique_lock<std::mutex> lock(_offsetsMutex);
+    if (_freeOffsets.size() < MAX_FREE_OFFSETS) {
+        _freeOffsets.push_back(offsets);
+    }
+}
+
 class Blender : public QRunnable {
 public:
 
-    Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients);
+    Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, std::shared_ptr<BlendshapeBuffers> buffers, int blendNumber,
+            const QVector<float>& blendshapeCoefficients);
 
     virtual void run() override;
 
 private:
     ModelPointer _model;
     HFMModel::ConstPointer _hfmModel;
+    std::shared_ptr<BlendshapeBuffers> _buffers;
     int _blendNumber;
     QVector<float> _blendshapeCoefficients;
 };
 
-Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients) :
+Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, std::shared_ptr<BlendshapeBuffers> buffers, int blendNumber,
+                 const QVector<float>& blendshapeCoefficients) :
     _model(model),
     _hfmModel(hfmModel),
+    _buffers(buffers),
     _blendNumber(blendNumber),
     _blendshapeCoefficients(blendshapeCoefficients) {
 }
 
 void Blender::run() {
     DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
+    uint64_t start = usecTimestampNow();
+    const auto& meshes = _buffers->getMeshes();
+
     int numBlendshapeOffsets = 0;  // number of offsets required for all meshes.
     int maxBlendshapeOffsets = 0;  // number of offsets in the largest mesh.
-    int numMeshes = 0;  // number of meshes in this model.
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
-        numMeshes++;
-        if (meshIter->blendshapes.isEmpty()) {
-            continue;
-        }
-        int numVertsInMesh = meshIter->vertices.size();
-        numBlendshapeOffsets += numVertsInMesh;
-        maxBlendshapeOffsets = std::max(maxBlendshapeOffsets, numVertsInMesh);
+    for (const auto& mesh : meshes) {
+        numBlendshapeOffsets += mesh.numVertices;
+        maxBlendshapeOffsets = std::max(maxBlendshapeOffsets, mesh.numVertices);
     }
 
-    // allocate the required sizes
+    // allocate the required sizes, unless the offsets of an earlier blend are free to fill again
     QVector<int> blendedMeshSizes;
-    blendedMeshSizes.reserve(numMeshes);
+    blendedMeshSizes.reserve((int)meshes.size());
 
-    QVector<BlendshapeOffset> packedBlendshapeOffsets;
+    QVector<BlendshapeOffset> packedBlendshapeOffsets = _buffers->acquireOffsets();
     packedBlendshapeOffsets.resize(numBlendshapeOffsets);
 
-    QVector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
-    unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    // reused by all the blends that run on this thread
+    thread_local std::vector<float> accumulatedBlendshapeOffsets;
+    accumulatedBlendshapeOffsets.resize(NUM_BLENDSHAPE_COMPONENTS * maxBlendshapeOffsets);
 
     int offset = 0;
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
-        if (meshIter->blendshapes.isEmpty()) {
-            blendedMeshSizes.push_back(0);
+    for (const auto& mesh : meshes) {
+        blendedMeshSizes.push_back(mesh.numVertices);
+        if (mesh.numVertices == 0) {
             continue;
         }
-        int numVertsInMesh = meshIter->vertices.size();
-        blendedMeshSizes.push_back(numVertsInMesh);
+        const int stride = mesh.numVertices;
 
         // initialize offsets to zero
-        memset(unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
+        float* accumulated = accumulatedBlendshapeOffsets.data();
+        memset(accumulated, 0, NUM_BLENDSHAPE_COMPONENTS * stride * sizeof(float));
 
-        // for each blendshape in this mesh, accumulate the offsets into unpackedBlendshapeOffsets.
+        // for each blendshape in this mesh, accumulate the offsets into accumulatedBlendshapeOffsets.
         const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-        for (int i = 0, n = qMin(_blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
+        for (int i = 0, n = std::min(_blendshapeCoefficients.size(), (int)mesh.blendshapes.size()); i < n; i++) {
             float vertexCoefficient = _blendshapeCoefficients.at(i);
             const float EPSILON = 0.0001f;
             if (vertexCoefficient < EPSILON) {
@@ -1821,30 +2008,40 @@ void Blender::run() {
             }
 
             float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
-            const HFMBlendshape& blendshape = meshIter->blendshapes.at(i);
-            for (int j = 0; j < blendshape.indices.size(); ++j) {
-                int index = blendshape.indices.at(j);
-
-                auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
-                currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
-                currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
-                if (j < blendshape.tangents.size()) {
-                    currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
+            const auto& blendshape = mesh.blendshapes[i];
+            const float* offsets = blendshape.offsets.data();
+            const int numOffsets = blendshape.numOffsets;
+            if (blendshape.isDense) {
+                for (int c = 0; c < NUM_BLENDSHAPE_COMPONENTS; ++c) {
+                    accumulateBlendshapeOffsets(accumulated + c * stride + blendshape.firstVertex, offsets + c * numOffsets,
+                                                c < 3 ? vertexCoefficient : normalCoefficient, numOffsets);
+                }
+            } else {
+                for (int c = 0; c < NUM_BLENDSHAPE_COMPONENTS; ++c) {
+                    float coefficient = c < 3 ? vertexCoefficient : normalCoefficient;
+                    float* accumulatedComponent = accumulated + c * stride;
+                    const float* componentOffsets = offsets + c * numOffsets;
+                    for (int j = 0; j < numOffsets; ++j) {
+                        accumulatedComponent[blendshape.indices[j]] += componentOffsets[j] * coefficient;
+                    }
                 }
             }
         }
 
-        // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
-        auto unpacked = unpackedBlendshapeOffsets.data();
-        auto packed = packedBlendshapeOffsets.data() + offset;
-        packBlendshapeOffsets(unpacked, packed, numVertsInMesh);
+        // convert accumulatedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
+        packBlendshapeOffsetsSoA(accumulated, stride, packedBlendshapeOffsets.data() + offset, mesh.numVertices);
 
-        offset += numVertsInMesh;
+        offset += mesh.numVertices;
     }
     Q_ASSERT(offset == numBlendshapeOffsets);
 
-    // post the result to the ModelBlender, which will dispatch to the model if still alive
-    QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
+    auto modelBlender = DependencyManager::get<ModelBlender>();
+    modelBlender->shareBlend(_hfmModel, _blendshapeCoefficients, packedBlendshapeOffsets, blendedMeshSizes);
+    modelBlender->addBlendTime(usecTimestampNow() - start);
+
+    // post the result to the ModelBlender, which will dispatch to the model if still alive.
+    // The offsets are shared, not copied, on their way to the render items.
+    QMetaObject::invokeMethod(modelBlender.data(), "setBlendedVertices",
                               Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
                               Q_ARG(QVector<BlendshapeOffset>, packedBlendshapeOffsets),
                               Q_ARG(QVector<int>, blendedMeshSizes));
@@ -1852,61 +2049,206 @@ void Blender::run() {
 
 bool Model::maybeStartBlender() {
     if (isLoaded()) {
-        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getNetworkModel()->getConstHFMModelPointer(),
-                                                         ++_blendNumber, _blendshapeCoefficients));
+        auto hfmModel = getNetworkModel()->getConstHFMModelPointer();
+        auto modelBlender = DependencyManager::get<ModelBlender>();
+
+        // another model with the same geometry may have just blended about the same coefficients
+        QVector<BlendshapeOffset> blendshapeOffsets;
+        QVector<int> blendedMeshSizes;
+        if (modelBlender->findSharedBlend(hfmModel, _blendshapeCoefficients, blendshapeOffsets, blendedMeshSizes)) {
+            QMetaObject::invokeMethod(modelBlender.data(), "setBlendedVertices", Qt::QueuedConnection,
+                                      Q_ARG(ModelPointer, getThisPointer()), Q_ARG(int, ++_blendNumber),
+                                      Q_ARG(QVector<BlendshapeOffset>, blendshapeOffsets),
+                                      Q_ARG(QVector<int>, blendedMeshSizes));
+            return true;
+        }
+
+        if (!_blendshapeBuffers || !_blendshapeBuffers->isFor(hfmModel)) {
+            _blendshapeBuffers = std::make_shared<BlendshapeBuffers>(hfmModel);
+        }
+        modelBlender->startBlender(new Blender(getThisPointer(), hfmModel, _blendshapeBuffers,
+                                               ++_blendNumber, _blendshapeCoefficients));
         return true;
     }
     return false;
 }
 
+void Model::releaseBlendshapeOffsets(const QVector<BlendshapeOffset>& blendshapeOffsets) {
+    if (_blendshapeBuffers) {
+        _blendshapeBuffers->releaseOffsets(blendshapeOffsets);
+    }
+}
+
+const float ModelBlender::BLEND_COEFFICIENT_THRESHOLD { 0.01f };
+const float ModelBlender::FULL_RATE_BLEND_ANGLE { 0.5f };
+const float ModelBlender::MAX_BLEND_DECIMATION { 8.0f };
+const uint64_t ModelBlender::DEFAULT_BLEND_FRAME_USECS { USECS_PER_SECOND / 60 };
+
+bool ModelBlender::isBlendVisible(const QVector<float>& blendshapeCoefficients, const QVector<float>& blendedCoefficients) {
+    if (blendshapeCoefficients.size() != blendedCoefficients.size()) {
+        return true;
+    }
+    for (int i = 0; i < blendshapeCoefficients.size(); i++) {
+        if (fabsf(blendshapeCoefficients[i] - blendedCoefficients[i]) > BLEND_COEFFICIENT_THRESHOLD) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t ModelBlender::evalBlendInterval(float priority, uint64_t frameUsecs) {
+    // a model half the angle is blended every other frame, a quarter of it every fourth, and so on
+    float decimation = glm::clamp(FULL_RATE_BLEND_ANGLE / std::max(priority, EPSILON), 1.0f, MAX_BLEND_DECIMATION);
+    return (uint64_t)((decimation - 1.0f) * (float)frameUsecs);
+}
+
+float ModelBlender::evalWaitingBlendPriority(float priority, uint64_t waitUsecs, uint64_t frameUsecs) {
+    float framesWaited = (float)waitUsecs / (float)std::max(frameUsecs, (uint64_t)1);
+    return priority + framesWaited * FULL_RATE_BLEND_ANGLE;
+}
+
 ModelBlender::ModelBlender() :
     _pendingBlenders(0) {
+    // blends are many and short, a few threads keep up with a crowd
+    const int MIN_BLENDER_THREADS = 2;
+    _blenderPool.setMaxThreadCount(std::max(MIN_BLENDER_THREADS, QThread::idealThreadCount() / 4));
 }
 
 ModelBlender::~ModelBlender() {
 }
 
-void ModelBlender::noteRequiresBlend(ModelPointer model) {
+void ModelBlender::noteRequiresBlend(ModelPointer model, float priority) {
     Lock lock(_mutex);
-    if (_modelsRequiringBlendsSet.find(model) == _modelsRequiringBlendsSet.end()) {
-        _modelsRequiringBlendsQueue.push(model);
-        _modelsRequiringBlendsSet.insert(model);
-    }
-
-    if (_pendingBlenders < QThread::idealThreadCount()) {
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                return;
-            }
+    auto it = _modelsRequiringBlends.find(model);
+    if (it == _modelsRequiringBlends.end()) {
+        _modelsRequiringBlends.emplace(model, BlendRequest { priority, usecTimestampNow() });
+    } else {
+        // the blend has waited since the first request
+        it->second.priority = priority;
+    }
+
+    if (_pendingBlenders < _blenderPool.maxThreadCount()) {
+        startNextBlender();
+    }
+}
+
+bool ModelBlender::startNextBlender() {
+    uint64_t now = usecTimestampNow();
+    uint64_t frameUsecs = getFrameUsecsLocked();
+    auto evalPriority = [&](const BlendRequest& request) {
+        return evalWaitingBlendPriority(request.priority, now - std::min(request.time, now), frameUsecs);
+    };
+    while (!_modelsRequiringBlends.empty()) {
+        auto next = std::max_element(_modelsRequiringBlends.begin(), _modelsRequiringBlends.end(),
+                                     [&](const std::pair<const ModelWeakPointer, BlendRequest>& a,
+                                         const std::pair<const ModelWeakPointer, BlendRequest>& b) {
+            return evalPriority(a.second) < evalPriority(b.second);
+        });
+        ModelPointer nextModel = next->first.lock();
+        _modelsRequiringBlends.erase(next);
+        if (nextModel && nextModel->maybeStartBlender()) {
+            _pendingBlenders++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ModelBlender::beginFrame(const glm::vec3& viewPosition) {
+    {
+        Lock lock(_mutex);
+        _viewPosition = viewPosition;
+
+        // a frame that hitched, or the first one, doesn't say how often the models are blended
+        const uint64_t MAX_BLEND_FRAME_USECS = USECS_PER_SECOND / 10;
+        uint64_t now = usecTimestampNow();
+        if (_lastFrameTime != 0 && now - _lastFrameTime < MAX_BLEND_FRAME_USECS) {
+            _frameUsecs.addSample((float)(now - _lastFrameTime));
+        }
+        _lastFrameTime = now;
+
+        _stats.blends = _blends.exchange(0);
+        _stats.sharedBlends = _sharedBlendCount.exchange(0);
+        _stats.skippedBlends = _skippedBlends.exchange(0);
+        _stats.blendTime = (float)_blendTime.exchange(0) / (float)USECS_PER_MSEC;
+    }
+
+    // forget the blends of the geometries that are gone
+    Lock lock(_sharedBlendsMutex);
+    for (auto it = _sharedBlends.begin(); it != _sharedBlends.end();) {
+        if (it->second.hfmModel.expired()) {
+            it = _sharedBlends.erase(it);
+        } else {
+            ++it;
         }
     }
 }
 
+glm::vec3 ModelBlender::getViewPosition() {
+    Lock lock(_mutex);
+    return _viewPosition;
+}
+
+uint64_t ModelBlender::getFrameUsecs() {
+    Lock lock(_mutex);
+    return getFrameUsecsLocked();
+}
+
+uint64_t ModelBlender::getFrameUsecsLocked() const {
+    return _frameUsecs.isAverageValid() ? (uint64_t)_frameUsecs.average : DEFAULT_BLEND_FRAME_USECS;
+}
+
+void ModelBlender::startBlender(QRunnable* blender) {
+    _blenderPool.start(blender);
+}
+
+void ModelBlender::addBlendTime(uint64_t usecs) {
+    _blends++;
+    _blendTime += usecs;
+}
+
+void ModelBlender::shareBlend(const HFMModel::ConstPointer& hfmModel, const QVector<float>& blendshapeCoefficients,
+                              const QVector<BlendshapeOffset>& blendshapeOffsets, const QVector<int>& blendedMeshSizes) {
+    Lock lock(_sharedBlendsMutex);
+    auto& sharedBlend = _sharedBlends[hfmModel.get()];
+    sharedBlend.hfmModel = hfmModel;
+    sharedBlend.blendshapeCoefficients = blendshapeCoefficients;
+    sharedBlend.blendshapeOffsets = blendshapeOffsets;
+    sharedBlend.blendedMeshSizes = blendedMeshSizes;
+}
+
+bool ModelBlender::findSharedBlend(const HFMModel::ConstPointer& hfmModel, const QVector<float>& blendshapeCoefficients,
+                                   QVector<BlendshapeOffset>& blendshapeOffsets, QVector<int>& blendedMeshSizes) {
+    Lock lock(_sharedBlendsMutex);
+    auto it = _sharedBlends.find(hfmModel.get());
+    // the address of a geometry that is gone may have been taken by another one
+    if (it == _sharedBlends.end() || it->second.hfmModel.lock() != hfmModel ||
+        isBlendVisible(blendshapeCoefficients, it->second.blendshapeCoefficients)) {
+        return false;
+    }
+    blendshapeOffsets = it->second.blendshapeOffsets;
+    blendedMeshSizes = it->second.blendedMeshSizes;
+    _sharedBlendCount++;
+    return true;
+}
+
+ModelBlender::Stats ModelBlender::getStats() {
+    Lock lock(_mutex);
+    return _stats;
+}
+
 void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes) {
     if (model) {
         auto blendshapeOperator = model->getModelBlendshapeOperator();
         if (blendshapeOperator) {
             blendshapeOperator(blendNumber, blendshapeOffsets, blendedMeshSizes, model->fetchRenderItemIDs());
         }
+        model->releaseBlendshapeOffsets(blendshapeOffsets);
     }
 
     {
         Lock lock(_mutex);
         _pendingBlenders--;
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                break;
-            }
-        }
+        startNextBlender();
     }
 }
@@ -16,7 +16,10 @@
 #include <QObject>
 #include <QUrl>
 #include <QMutex>
+#include <QThreadPool>
 
+#include <atomic>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -32,6 +35,7 @@
 #include <SpatiallyNestable.h>
 #include <TriangleSet.h>
 #include <DualQuaternion.h>
+#include <SimpleMovingAverage.h>
 
 #include "RenderHifi.h"
 #include "GeometryCache.h"
@@ -87,6 +91,7 @@ struct BlendshapeOffsetUnpacked {
 };
 
 using BlendshapeOffset = BlendshapeOffsetPacked;
+class BlendshapeBuffers;
 using BlendShapeOperator = std::function<void(int, const QVector<BlendshapeOffset>&, const QVector<int>&, const render::ItemIDs&)>;
 
 /// A generic 3D model displaying geometry loaded from a URL.
@@ -164,8 +169,12 @@ public:
     const render::ItemIDs& fetchRenderItemIDs() const;
 
     bool maybeStartBlender();
+    // The angle the model spans from where it is seen, in radians, which is how much a blend of it shows
+    float evalBlendPriority() const;
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
+    // Whether what is loaded is a coarse stand-in for the model, which is still being baked
+    bool isRefining() const { return _renderWatcher.isRefining(); }
     bool isAddedToScene() const { return _addedToScene; }
 
     void setPrimitiveMode(PrimitiveMode primitiveMode);
@@ -359,6 +368,8 @@ public:
     uint32_t getGeometryCounter() const { return _deleteGeometryCounter; }
 
     BlendShapeOperator getModelBlendshapeOperator() const { return _modelBlendshapeOperator; }
+    // Hands the offsets of a blend back once they are passed on, for later blends to fill again if nothing holds onto them
+    void releaseBlendshapeOffsets(const QVector<BlendshapeOffset>& blendshapeOffsets);
 
     void renderDebugMeshBoxes(gpu::Batch& batch, bool forward);
 
@@ -378,6 +389,7 @@ public:
 
 public slots:
     void loadURLFinished(bool success);
+    void loadURLRefined();
 
 signals:
     void setURLFinished(bool success);
@@ -461,6 +473,8 @@ protected:
     QVector<float> _blendshapeCoefficients;
     QVector<float> _blendedBlendshapeCoefficients;
     int _blendNumber { 0 };
+    // The blendshapes of the geometry laid out for blending, and the offsets of the last blends to reuse
+    std::shared_ptr<BlendshapeBuffers> _blendshapeBuffers;
 
     mutable QMutex _mutex{ QMutex::Recursive };
 
@@ -469,6 +483,11 @@ protected:
     void calculateTriangleSets(const HFMModel& hfmModel);
     std::vector<std::vector<TriangleSet>> _modelSpaceMeshTriangleSets; // model space triangles for all sub meshes
 
+    // Has the model blended if its blendshape coefficients changed enough to show since the last blend, and it has been
+    // long enough since then for how far away it is
+    void maybeRequireBlend();
+    uint64_t _lastBlendRequest { 0 };
+
     virtual void createRenderItemSet();
 
     PrimitiveMode _primitiveMode { PrimitiveMode::SOLID };
@@ -541,12 +560,55 @@ class ModelBlender : public QObject, public Dependency {
     SINGLETON_DEPENDENCY
 
 public:
+    struct Stats {
+        int blends { 0 }; // Blends that ran
+        int sharedBlends { 0 }; // Blends that took the result of another model's
+        int skippedBlends { 0 }; // Blends that wouldn't have shown, or were put off for models far away
+        float blendTime { 0.0f }; // The time the blends that ran took, in ms
+    };
 
-    /// Adds the specified model to the list requiring vertex blends.
-    void noteRequiresBlend(ModelPointer model);
+    // Blendshape coefficients that don't change by more than this aren't blended again
+    static const float BLEND_COEFFICIENT_THRESHOLD;
+    // Models that span a smaller angle than this, in radians, are blended less often
+    static const float FULL_RATE_BLEND_ANGLE;
+    // Models far away are blended no less often than every this many frames
+    static const float MAX_BLEND_DECIMATION;
+    // The frame time until one has been measured, in usecs
+    static const uint64_t DEFAULT_BLEND_FRAME_USECS;
+
+    static bool isBlendVisible(const QVector<float>& blendshapeCoefficients, const QVector<float>& blendedCoefficients);
+    // How long to wait after a blend of a model with priority before blending it again, in usecs
+    static uint64_t evalBlendInterval(float priority, uint64_t frameUsecs);
+    // The priority of a blend that has waited to start, which grows by that of a model blended every frame for each frame
+    // waited, so that the blends of models far away aren't put off for ever by those of the models close by
+    static float evalWaitingBlendPriority(float priority, uint64_t waitUsecs, uint64_t frameUsecs);
+
+    /// Adds the specified model to the list requiring vertex blends, the ones with the highest priority are blended first.
+    void noteRequiresBlend(ModelPointer model, float priority = 0.0f);
+    void noteSkippedBlend() { _skippedBlends++; }
 
     bool shouldComputeBlendshapes() { return _computeBlendshapes; }
 
+    // Called once per frame before the models are simulated, with where they are seen from
+    void beginFrame(const glm::vec3& viewPosition);
+    glm::vec3 getViewPosition();
+    // The time between the last frames, in usecs
+    uint64_t getFrameUsecs();
+
+    // Blends run on a pool of their own, so that many avatars don't hold up the loading
+    void startBlender(QRunnable* blender);
+    void addBlendTime(uint64_t usecs);
+
+    // The last blend of each geometry is kept, for the other models with the same geometry that come to about the same
+    // coefficients to take as their own
+    void shareBlend(const HFMModel::ConstPointer& hfmModel, const QVector<float>& blendshapeCoefficients,
+                    const QVector<BlendshapeOffset>& blendshapeOffsets, const QVector<int>& blendedMeshSizes);
+    bool findSharedBlend(const HFMModel::ConstPointer& hfmModel, const QVector<float>& blendshapeCoefficients,
+                         QVector<BlendshapeOffset>& blendshapeOffsets, QVector<int>& blendedMeshSizes);
+
+    // Of the last frame
+    Stats getStats();
+
 public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
@@ -558,10 +620,39 @@ private:
     ModelBlender();
     virtual ~ModelBlender();
 
-    std::queue<ModelWeakPointer> _modelsRequiringBlendsQueue;
-    std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> _modelsRequiringBlendsSet;
+    // Starts the blend of the model with the highest priority, called with _mutex locked
+    bool startNextBlender();
+    uint64_t getFrameUsecsLocked() const;
+
+    struct SharedBlend {
+        std::weak_ptr<const HFMModel> hfmModel;
+        QVector<float> blendshapeCoefficients;
+        QVector<BlendshapeOffset> blendshapeOffsets;
+        QVector<int> blendedMeshSizes;
+    };
+
+    struct BlendRequest {
+        float priority;
+        uint64_t time; // of the first request since the last blend
+    };
+
+    std::map<ModelWeakPointer, BlendRequest, std::owner_less<ModelWeakPointer>> _modelsRequiringBlends;
     int _pendingBlenders;
     Mutex _mutex;
+    glm::vec3 _viewPosition { 0.0f };
+    uint64_t _lastFrameTime { 0 };
+    MovingAverage<float, 10> _frameUsecs;
+
+    QThreadPool _blenderPool;
+
+    Mutex _sharedBlendsMutex;
+    std::unordered_map<const HFMModel*, SharedBlend> _sharedBlends;
+
+    std::atomic<int> _blends { 0 };
+    std::atomic<int> _sharedBlendCount { 0 };
+    std::atomic<int> _skippedBlends { 0 };
+    std::atomic<uint64_t> _blendTime { 0 };
+    Stats _stats;
 
     bool _computeBlendshapes { true };
 };
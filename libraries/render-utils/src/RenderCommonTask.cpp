@@ -10,6 +10,7 @@
 
 #include <gpu/Context.h>
 #include <graphics/ShaderConstants.h>
+#include <render/BatchRecorder.h>
 
 #include "render-utils/ShaderConstants.h"
 #include "DeferredLightingEffect.h"
@@ -58,9 +59,7 @@ void DrawLayered3D::run(const RenderContextPointer& renderContext, const Inputs&
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
 
     const auto& inItems = inputs.get0();
-    const auto& lightingModel = inputs.get1();
     const auto& hazeFrame = inputs.get2();
-    const auto jitter = inputs.get3();
     
     config->setNumDrawn((int)inItems.size());
     emit config->numDrawnChanged();
@@ -86,7 +85,16 @@ void DrawLayered3D::run(const RenderContextPointer& renderContext, const Inputs&
 
     if (!inItems.empty()) {
         // Render the items
-        gpu::doInBatch("DrawLayered3D::main", args->_context, [&](gpu::Batch& batch) {
+        auto shapePlumber = _shapePlumber;
+        auto maxDrawn = _maxDrawn;
+        auto opaquePass = _opaquePass;
+        BatchRecorder::record(renderContext, "DrawLayered3D::main", _parallelRecording,
+                              [inputs, haze, shapePlumber, maxDrawn, opaquePass](const RenderContextPointer& renderContext, gpu::Batch& batch) {
+            const auto& inItems = inputs.get0();
+            const auto& lightingModel = inputs.get1();
+            const auto jitter = inputs.get3();
+
+            RenderArgs* args = renderContext->args;
             args->_batch = &batch;
             batch.setViewportTransform(args->_viewport);
             batch.setStateScissorRect(args->_viewport);
@@ -108,10 +116,10 @@ void DrawLayered3D::run(const RenderContextPointer& renderContext, const Inputs&
                 batch.setUniformBuffer(graphics::slot::buffer::Buffer::HazeParams, haze->getHazeParametersBuffer());
             }
 
-            if (_opaquePass) {
-                renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn);
+            if (opaquePass) {
+                renderStateSortShapes(renderContext, shapePlumber, inItems, maxDrawn);
             } else {
-                renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn);
+                renderShapes(renderContext, shapePlumber, inItems, maxDrawn);
             }
             args->_batch = nullptr;
         });
@@ -45,11 +45,13 @@ class DrawLayered3DConfig : public render::Job::Config {
     Q_OBJECT
         Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
         Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
+        Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
 public:
     int getNumDrawn() { return numDrawn; }
     void setNumDrawn(int num) { numDrawn = num; emit numDrawnChanged(); }
 
     int maxDrawn{ -1 };
+    bool parallelRecording{ false };
 
 signals:
     void numDrawnChanged();
@@ -67,12 +69,13 @@ public:
 
     DrawLayered3D(bool opaque);
 
-    void configure(const Config& config) { _maxDrawn = config.maxDrawn; }
+    void configure(const Config& config) { _maxDrawn = config.maxDrawn; _parallelRecording = config.parallelRecording; }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn; // initialized by Config
+    bool _parallelRecording; // initialized by Config
     bool _opaquePass { true };
 };
 
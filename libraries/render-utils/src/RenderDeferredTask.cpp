@@ -22,6 +22,7 @@
 #include <gpu/Context.h>
 #include <graphics/ShaderConstants.h>
 
+#include <render/BatchRecorder.h>
 #include <render/CullTask.h>
 #include <render/FilterTask.h>
 #include <render/SortTask.h>
@@ -528,12 +529,18 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
     auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
 
     const auto& inItems = inputs.get0();
-    const auto& lightingModel = inputs.get1();
-    const auto jitter = inputs.get2();
 
-    RenderArgs* args = renderContext->args;
-
-    gpu::doInBatch("DrawStateSortDeferred::run", args->_context, [&](gpu::Batch& batch) {
+    // The batch can be recorded after this returns, so it holds on to the inputs and the settings of the job
+    auto shapePlumber = _shapePlumber;
+    auto maxDrawn = _maxDrawn;
+    auto stateSort = _stateSort;
+    BatchRecorder::record(renderContext, "DrawStateSortDeferred::run", _parallelRecording,
+                          [inputs, shapePlumber, maxDrawn, stateSort](const RenderContextPointer& renderContext, gpu::Batch& batch) {
+        const auto& inItems = inputs.get0();
+        const auto& lightingModel = inputs.get1();
+        const auto jitter = inputs.get2();
+
+        RenderArgs* args = renderContext->args;
         args->_batch = &batch;
 
         // Setup camera, projection and viewport for all items
@@ -562,10 +569,10 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
         ShapeKey globalKey = keyBuilder.build();
         args->_globalShapeKey = globalKey._flags.to_ulong();
 
-        if (_stateSort) {
-            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+        if (stateSort) {
+            renderStateSortShapes(renderContext, shapePlumber, inItems, maxDrawn, globalKey);
         } else {
-            renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            renderShapes(renderContext, shapePlumber, inItems, maxDrawn, globalKey);
         }
         args->_batch = nullptr;
         args->_globalShapeKey = 0;
@@ -63,6 +63,7 @@ class DrawStateSortConfig : public render::Job::Config {
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
     Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
 public:
     int getNumDrawn() { return numDrawn; }
     void setNumDrawn(int num) {
@@ -72,6 +73,9 @@ public:
 
     int maxDrawn{ -1 };
     bool stateSort{ true };
+    // Record the batch on a worker thread, while the next jobs run. Off until every entity renderer
+    // drawn in the main passes is safe to call from a worker thread
+    bool parallelRecording{ false };
 
 signals:
     void numDrawnChanged();
@@ -95,6 +99,7 @@ public:
     void configure(const Config& config) {
         _maxDrawn = config.maxDrawn;
         _stateSort = config.stateSort;
+        _parallelRecording = config.parallelRecording;
     }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
@@ -102,6 +107,7 @@ protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn;  // initialized by Config
     bool _stateSort;
+    bool _parallelRecording;
 };
 
 class SetSeparateDeferredDepthBuffer {
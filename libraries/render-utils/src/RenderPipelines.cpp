@@ -13,8 +13,10 @@
 #include "RenderPipelines.h"
 
 #include <functional>
+#include <mutex>
 
 #include <gpu/Context.h>
+#include <gpu/TextureStreaming.h>
 #include <material-networking/TextureCache.h>
 #include <render/DrawTask.h>
 #include <shaders/Shaders.h>
@@ -743,8 +745,12 @@ void RenderPipelines::updateMultiMaterial(graphics::MultiMaterial& multiMaterial
 }
 
 bool RenderPipelines::bindMaterials(graphics::MultiMaterial& multiMaterial, gpu::Batch& batch, render::Args::RenderMode renderMode, bool enableTextures) {
+    // Only the materials that need it take their lock, and the first thread to get it does the update
     if (multiMaterial.shouldUpdate()) {
-        updateMultiMaterial(multiMaterial);
+        std::lock_guard<std::mutex> lock(multiMaterial.getUpdateMutex());
+        if (multiMaterial.shouldUpdate()) {
+            updateMultiMaterial(multiMaterial);
+        }
     }
 
     auto textureCache = DependencyManager::get<TextureCache>();
@@ -792,3 +798,24 @@ bool RenderPipelines::bindMaterials(graphics::MultiMaterial& multiMaterial, gpu:
     }
 }
 
+void RenderPipelines::reportScreenSize(const graphics::MultiMaterial& multiMaterial, const render::Args* args, const AABox& bound) {
+    // Only the main view counts, the textures of shadows and mirrors are seen from afar or through the main view anyway
+    if (args->_renderMode != render::Args::RenderMode::DEFAULT_RENDER_MODE || !args->_enableTexturing) {
+        return;
+    }
+    const auto& textureTable = multiMaterial.getTextureTable();
+    if (!textureTable) {
+        return;
+    }
+
+    // The textures are assumed to be mapped once across what is drawn, so they want a texel for every pixel it spans
+    const auto& viewFrustum = args->getViewFrustum();
+    float radius = 0.5f * glm::length(bound.getScale());
+    float distance = std::max(viewFrustum.distanceToCamera(bound.calcCenter()), radius);
+    if (distance <= 0.0f) {
+        return;
+    }
+    float tanHalfFieldOfView = tanf(0.5f * glm::radians(viewFrustum.getFieldOfView()));
+    float pixels = (radius / distance) / tanHalfFieldOfView * (float)args->_viewport.w;
+    gpu::TextureStreaming::reportScreenSize(*textureTable, pixels);
+}
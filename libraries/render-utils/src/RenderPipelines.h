@@ -19,6 +19,8 @@ public:
     static void updateMultiMaterial(graphics::MultiMaterial& multiMaterial);
     static bool bindMaterial(graphics::MaterialPointer& material, gpu::Batch& batch, render::Args::RenderMode renderMode, bool enableTextures);
     static bool bindMaterials(graphics::MultiMaterial& multiMaterial, gpu::Batch& batch, render::Args::RenderMode renderMode, bool enableTextures);
+    // Lets the texture streaming know how large the textures of the material are on screen, when drawing something with this bound
+    static void reportScreenSize(const graphics::MultiMaterial& multiMaterial, const render::Args* args, const AABox& bound);
 };
 
 
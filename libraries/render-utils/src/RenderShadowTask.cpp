@@ -13,8 +13,10 @@
 
 #include <gpu/Context.h>
 
+#include <PerfStat.h>
 #include <ViewFrustum.h>
 
+#include <render/BatchRecorder.h>
 #include <render/CullTask.h>
 #include <render/SortTask.h>
 #include <render/DrawTask.h>
@@ -78,6 +80,10 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
     const auto sortedPipelines = task.addJob<PipelineSortShapes>("PipelineSortShadow", culledShadowItems);
     const auto sortedShapes = task.addJob<DepthSortShapes>("DepthSortShadow", sortedPipelines, true);
 
+    // Cull them against all the cascades at once
+    const auto cullCascadesInputs = CullShadowCascades::Inputs(sortedShapes, shadowFrame).asVarying();
+    const auto cascadeShapes = task.addJob<CullShadowCascades>("CullShadowCascades", cullCascadesInputs);
+
     render::Varying cascadeFrustums[SHADOW_CASCADE_MAX_COUNT] = {
         ViewFrustumPointer()
 #if SHADOW_CASCADE_MAX_COUNT>1
@@ -100,9 +106,9 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
             antiFrustum = cascadeFrustums[i - 2];
         }
 
-        const auto cullInputs = CullShadowBounds::Inputs(sortedShapes, shadowFilter, antiFrustum, currentKeyLight, cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2)).asVarying();
+        const auto cullInputs = CullShadowBounds::Inputs(cascadeShapes, shadowFilter, antiFrustum, currentKeyLight).asVarying();
         sprintf(jobName, "CullShadowCascade%d", i);
-        const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs);
+        const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs, i);
 
         // GPU jobs: Render to shadow map
         sprintf(jobName, "RenderShadowMap%d", i);
@@ -207,7 +213,6 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    const auto& inShapes = inputs.get0();
     const auto& inShapeBounds = inputs.get1();
     const auto& shadowFrame = inputs.get2();
 
@@ -233,7 +238,14 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
     args->popViewFrustum();
     args->pushViewFrustum(adjustedShadowFrustum);
 
-    gpu::doInBatch("RenderShadowMap::run", args->_context, [&](gpu::Batch& batch) {
+    // The adjusted frustum goes with the copy of the args the batch may be recorded with
+    auto shapePlumber = _shapePlumber;
+    BatchRecorder::record(renderContext, "RenderShadowMap::run", _parallelRecording,
+                          [inputs, shapePlumber, fbo](const render::RenderContextPointer& renderContext, gpu::Batch& batch) {
+        const auto& inShapes = inputs.get0();
+        const auto& inShapeBounds = inputs.get1();
+
+        RenderArgs* args = renderContext->args;
         args->_batch = &batch;
         batch.enableStereo(false);
 
@@ -284,10 +296,10 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
             for (size_t i = 0; i < OWN_PIPELINE_INDEX; i++) {
                 auto& shapeKeys = sortedShapeKeys[i];
                 if (shapeKeys.size() > 0) {
-                    const auto& shapePipeline = _shapePlumber->pickPipeline(args, keys[i]);
+                    const auto& shapePipeline = shapePlumber->pickPipeline(args, keys[i]);
                     args->_shapePipeline = shapePipeline;
                     for (const auto& key : shapeKeys) {
-                        renderShapes(renderContext, _shapePlumber, inShapes.at(key));
+                        renderShapes(renderContext, shapePlumber, inShapes.at(key));
                     }
                 }
             }
@@ -299,7 +311,7 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
                     args->_shapePipeline = nullptr;
                     for (const auto& key : shapeKeys) {
                         args->_itemShapeKey = key._flags.to_ulong();
-                        renderShapes(renderContext, _shapePlumber, inShapes.at(key));
+                        renderShapes(renderContext, shapePlumber, inShapes.at(key));
                     }
                 }
             }
@@ -477,7 +489,6 @@ void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderCon
     // Cache old render args
     RenderArgs* args = renderContext->args;
 
-    RenderShadowTask::CullFunctor cullFunctor;
     if (shadowFrame && !shadowFrame->_objects.empty() && shadowFrame->_objects[0]) {
         const auto globalShadow = shadowFrame->_objects[0];
 
@@ -488,12 +499,6 @@ void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderCon
             auto& cascade = globalShadow->getCascade(_cascadeIndex);
             auto& cascadeFrustum = cascade.getFrustum();
             args->pushViewFrustum(*cascadeFrustum);
-            auto texelSize = glm::min(cascadeFrustum->getHeight(), cascadeFrustum->getWidth()) / cascade.framebuffer->getSize().x;
-            // Set the cull threshold to 24 shadow texels. This is totally arbitrary
-            const auto minTexelCount = 24.0f;
-            // TODO : maybe adapt that with LOD management system?
-            texelSize *= minTexelCount;
-            cullFunctor._minSquareSize = texelSize * texelSize;
 
             output.edit1() = cascadeFrustum;
 
@@ -506,8 +511,6 @@ void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderCon
         output.edit0() = ItemFilter::Builder::nothing();
         output.edit1() = ViewFrustumPointer();
     }
-
-    output.edit2() = cullFunctor;
 }
 
 void RenderShadowCascadeTeardown::run(const render::RenderContextPointer& renderContext, const Input& input) {
@@ -548,33 +551,103 @@ static AABox& merge(AABox& box, const AABox& otherBox, const glm::vec3& dir) {
     return box;
 }
 
+static_assert(SHADOW_CASCADE_MAX_COUNT <= render::CullBatch::MAX_NUM_VIEWS, "All the cascades are culled in one batch");
+
+void CullShadowCascades::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
+    assert(renderContext->args);
+    RenderArgs* args = renderContext->args;
+
+    const auto& inShapes = inputs.get0();
+    const auto& shadowFrame = inputs.get1();
+
+    for (auto& cascadeShapes : outputs) {
+        cascadeShapes.clear();
+    }
+    if (!shadowFrame || shadowFrame->_objects.empty() || !shadowFrame->_objects[0]) {
+        return;
+    }
+    const auto globalShadow = shadowFrame->_objects[0];
+    int numCascades = (int)std::min(globalShadow->getCascadeCount(), (unsigned int)SHADOW_CASCADE_MAX_COUNT);
+
+    render::CullBatch::View views[SHADOW_CASCADE_MAX_COUNT];
+    for (int i = 0; i < numCascades; i++) {
+        auto& cascade = globalShadow->getCascade(i);
+        auto& cascadeFrustum = cascade.getFrustum();
+        // The anti-frustums are left to CullShadowBounds, the near and far of the cascades aren't fitted yet
+        views[i].frustum = cascadeFrustum.get();
+
+        auto texelSize = glm::min(cascadeFrustum->getHeight(), cascadeFrustum->getWidth()) / cascade.framebuffer->getSize().x;
+        // Set the cull threshold to 24 shadow texels. This is totally arbitrary
+        const auto minTexelCount = 24.0f;
+        // TODO : maybe adapt that with LOD management system?
+        texelSize *= minTexelCount;
+        RenderShadowTask::CullFunctor cullFunctor;
+        cullFunctor._minSquareSize = texelSize * texelSize;
+        views[i].functor = cullFunctor;
+    }
+
+    _batch.clear();
+    size_t numItems = 0;
+    for (auto& inItems : inShapes) {
+        numItems += inItems.second.size();
+    }
+    _batch.reserve(numItems);
+    for (auto& inItems : inShapes) {
+        for (auto& item : inItems.second) {
+            _batch.add(item.bound);
+        }
+    }
+
+    render::CullBatch::Stats stats;
+    {
+        PerformanceTimer perfTimer("cullBatch");
+        _batch.cull(args, views, numCascades, _masks, stats);
+    }
+
+    auto& details = args->_details.edit(RenderDetails::SHADOW);
+    for (int i = 0; i < numCascades; i++) {
+        details._considered += (int)numItems;
+        details._outOfView += stats.outOfView[i];
+        details._tooSmall += stats.tooSmall[i];
+    }
+
+    size_t index = 0;
+    for (auto& inItems : inShapes) {
+        render::ItemBounds* outItems[SHADOW_CASCADE_MAX_COUNT];
+        for (int i = 0; i < numCascades; i++) {
+            outItems[i] = &outputs[i][inItems.first];
+            outItems[i]->reserve(inItems.second.size());
+        }
+        for (auto& item : inItems.second) {
+            auto mask = _masks[index++];
+            for (int i = 0; i < numCascades; i++) {
+                if (mask & (1 << i)) {
+                    outItems[i]->emplace_back(item);
+                }
+            }
+        }
+    }
+}
+
 void CullShadowBounds::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
     RenderArgs* args = renderContext->args;
 
-    const auto& inShapes = inputs.get0();
+    // Already culled against the frustum of the cascade
+    const auto& inShapes = inputs.get0()[_cascadeIndex];
     const auto& filter = inputs.get1();
-    ViewFrustumPointer antiFrustum;
+    const auto& antiFrustum = inputs.get2();
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
 
-    if (!inputs[3].isNull()) {
-        antiFrustum = inputs.get2();
-    }
     outShapes.clear();
     outBounds = AABox();
 
     const auto currentKeyLight = inputs.get3();
-    auto cullFunctor = inputs.get4();
-
-    render::CullFunctor shadowCullFunctor = [cullFunctor](const RenderArgs* args, const AABox& bounds) {
-        return cullFunctor(args, bounds);
-    };
 
     if (!filter.selectsNothing() && currentKeyLight) {
         auto& details = args->_details.edit(RenderDetails::SHADOW);
-        render::CullTest test(shadowCullFunctor, args, details, antiFrustum);
         auto scene = args->_scene;
         auto lightStage = renderContext->_scene->getStage<LightStage>();
         assert(lightStage);
@@ -589,37 +662,21 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
                 outItems->second.reserve(inItems.second.size());
             }
 
-            details._considered += (int)inItems.second.size();
-
-            if (antiFrustum == nullptr) {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
-                    }
+            for (auto& item : inItems.second) {
+                // From the third cascade on, what is inside the cascade two before is left out
+                if (antiFrustum && antiFrustum->boxInsideFrustum(item.bound)) {
+                    details._outOfView++;
+                    continue;
                 }
-            } else {
-                for (auto& item : inItems.second) {
-                    if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
-                        if (castersFilter.test(shapeKey)) {
-                            outItems->second.emplace_back(item);
-                            outBounds += item.bound;
-                        } else {
-                            // Receivers are not rendered but they still increase the bounds of the shadow scene
-                            // although only in the direction of the light direction so as to have a correct far
-                            // distance without decreasing the near distance.
-                            merge(outBounds, item.bound, globalLightDir);
-                        }
-                    }
+                const auto shapeKey = scene->getItem(item.id).getKey();
+                if (castersFilter.test(shapeKey)) {
+                    outItems->second.emplace_back(item);
+                    outBounds += item.bound;
+                } else {
+                    // Receivers are not rendered but they still increase the bounds of the shadow scene
+                    // although only in the direction of the light direction so as to have a correct far
+                    // distance without decreasing the near distance.
+                    merge(outBounds, item.bound, globalLightDir);
                 }
             }
             details._rendered += (int)outItems->second.size();
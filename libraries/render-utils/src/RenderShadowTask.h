@@ -12,6 +12,8 @@
 #ifndef hifi_RenderShadowTask_h
 #define hifi_RenderShadowTask_h
 
+#include <array>
+
 #include <gpu/Framebuffer.h>
 #include <gpu/Pipeline.h>
 
@@ -24,17 +26,32 @@
 
 class ViewFrustum;
 
+class RenderShadowMapConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
+public:
+    // The cascades are then recorded side by side on worker threads
+    bool parallelRecording{ true };
+
+signals:
+    void dirty();
+};
+
 class RenderShadowMap {
 public:
     using Inputs = render::VaryingSet3<render::ShapeBounds, AABox, LightStage::ShadowFramePointer>;
-    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs>;
+    using Config = RenderShadowMapConfig;
+    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs, Config>;
 
     RenderShadowMap(render::ShapePlumberPointer shapePlumber, unsigned int cascadeIndex) : _shapePlumber{ shapePlumber }, _cascadeIndex{ cascadeIndex } {}
+
+    void configure(const Config& config) { _parallelRecording = config.parallelRecording; }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     unsigned int _cascadeIndex;
+    bool _parallelRecording; // initialized by Config
 };
 
 //class RenderShadowTaskConfig : public render::Task::Config::Persistent {
@@ -147,7 +164,7 @@ private:
 class RenderShadowCascadeSetup {
 public:
     using Inputs = LightStage::ShadowFramePointer;
-    using Outputs = render::VaryingSet3<render::ItemFilter, ViewFrustumPointer, RenderShadowTask::CullFunctor>;
+    using Outputs = render::VaryingSet2<render::ItemFilter, ViewFrustumPointer>;
     using JobModel = render::Job::ModelIO<RenderShadowCascadeSetup, Inputs, Outputs>;
 
     RenderShadowCascadeSetup(unsigned int cascadeIndex, render::ItemFilter filter) : _cascadeIndex(cascadeIndex), _filter(filter) {}
@@ -173,13 +190,34 @@ public:
     void run(const render::RenderContextPointer& renderContext, const Input& input);
 };
 
+// Culls the shadow items against the frustums of all the cascades in a single pass over them
+class CullShadowCascades {
+public:
+    using Inputs = render::VaryingSet2<render::ShapeBounds, LightStage::ShadowFramePointer>;
+    using Outputs = std::array<render::ShapeBounds, SHADOW_CASCADE_MAX_COUNT>;
+    using JobModel = render::Job::ModelIO<CullShadowCascades, Inputs, Outputs>;
+
+    void run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs);
+
+private:
+    render::CullBatch _batch;
+    std::vector<render::CullBatch::ViewMask> _masks;
+};
+
 class CullShadowBounds {
 public:
-    using Inputs = render::VaryingSet5<render::ShapeBounds, render::ItemFilter, ViewFrustumPointer, graphics::LightPointer, RenderShadowTask::CullFunctor>;
+    // The anti-frustum is the frustum of the cascade two before, once RenderShadowMap has fitted its near and far to what it
+    // drew, so it is tested here rather than with the cascade frustums in CullShadowCascades
+    using Inputs = render::VaryingSet4<CullShadowCascades::Outputs, render::ItemFilter, ViewFrustumPointer, graphics::LightPointer>;
     using Outputs = render::VaryingSet2<render::ShapeBounds, AABox>;
     using JobModel = render::Job::ModelIO<CullShadowBounds, Inputs, Outputs>;
 
+    CullShadowBounds(unsigned int cascadeIndex) : _cascadeIndex(cascadeIndex) {}
+
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs);
+
+private:
+    unsigned int _cascadeIndex;
 };
 
 #endif // hifi_RenderShadowTask_h
@@ -0,0 +1,80 @@
+//
+//  CullBatch_avx2.cpp
+//  render/src/avx2
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+// as laid out by render::CullBatch
+enum { CORNER_X = 0, CORNER_Y, CORNER_Z, SCALE_X, SCALE_Y, SCALE_Z };
+static const int NUM_PLANES = 6;
+static const int PLANES_PER_VIEW = 2 * NUM_PLANES;
+
+// The distances from the corners the plane picks, the farthest along its normal or the nearest, 8 bounds at a time
+static inline __m256 planeDistance8(const float* plane, bool farthest, __m256 cornerX, __m256 cornerY, __m256 cornerZ,
+                                    __m256 farX, __m256 farY, __m256 farZ) {
+    __m256 x = (farthest ? plane[0] > 0.0f : plane[0] < 0.0f) ? farX : cornerX;
+    __m256 y = (farthest ? plane[1] > 0.0f : plane[1] < 0.0f) ? farY : cornerY;
+    __m256 z = (farthest ? plane[2] > 0.0f : plane[2] < 0.0f) ? farZ : cornerZ;
+    __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[0]), x),
+                                             _mm256_mul_ps(_mm256_set1_ps(plane[1]), y)),
+                               _mm256_mul_ps(_mm256_set1_ps(plane[2]), z));
+    return _mm256_add_ps(_mm256_set1_ps(plane[3]), dot);
+}
+
+// For the bounds in [begin, end), which are multiples of 8, the bit of each view they are in
+void cullBoundsSoA_AVX2(const float* const* coordinates, size_t begin, size_t end, const float (*planes)[4],
+                        int numViews, uint8_t frustumViews, uint8_t antiFrustumViews, uint8_t* masks) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    for (size_t i = begin; i < end; i += 8) {
+        __m256 cornerX = _mm256_loadu_ps(coordinates[CORNER_X] + i);
+        __m256 cornerY = _mm256_loadu_ps(coordinates[CORNER_Y] + i);
+        __m256 cornerZ = _mm256_loadu_ps(coordinates[CORNER_Z] + i);
+        __m256 farX = _mm256_add_ps(cornerX, _mm256_loadu_ps(coordinates[SCALE_X] + i));
+        __m256 farY = _mm256_add_ps(cornerY, _mm256_loadu_ps(coordinates[SCALE_Y] + i));
+        __m256 farZ = _mm256_add_ps(cornerZ, _mm256_loadu_ps(coordinates[SCALE_Z] + i));
+
+        uint8_t laneMasks[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        for (int view = 0; view < numViews; ++view) {
+            const float (*viewPlanes)[4] = planes + view * PLANES_PER_VIEW;
+            __m256 in = all;
+            if (frustumViews & (1 << view)) {
+                // in unless behind one of the planes
+                for (int j = 0; j < NUM_PLANES && _mm256_movemask_ps(in); ++j) {
+                    __m256 distance = planeDistance8(viewPlanes[j], true, cornerX, cornerY, cornerZ, farX, farY, farZ);
+                    in = _mm256_and_ps(in, _mm256_cmp_ps(distance, zero, _CMP_NLT_US));
+                }
+            }
+            if ((antiFrustumViews & (1 << view)) && _mm256_movemask_ps(in)) {
+                // inside the anti-frustum unless partly behind one of its planes
+                __m256 outside = zero;
+                for (int j = 0; j < NUM_PLANES; ++j) {
+                    __m256 distance = planeDistance8(viewPlanes[NUM_PLANES + j], false,
+                                                     cornerX, cornerY, cornerZ, farX, farY, farZ);
+                    outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_LT_OQ));
+                }
+                in = _mm256_and_ps(in, outside);
+            }
+            int bits = _mm256_movemask_ps(in);
+            for (int lane = 0; lane < 8; ++lane) {
+                laneMasks[lane] |= (uint8_t)((bits >> lane) & 1) << view;
+            }
+        }
+        memcpy(masks + i, laneMasks, sizeof(laneMasks));
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -0,0 +1,86 @@
+//
+//  BatchRecorder.cpp
+//  render/src/render
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchRecorder.h"
+
+#include <tbb/task_group.h>
+
+#include <Profile.h>
+#include <gpu/Context.h>
+
+using namespace render;
+
+class BatchRecorder::Tasks : public tbb::task_group {
+};
+
+BatchRecorder::BatchRecorder() : _tasks(new Tasks()) {
+}
+
+BatchRecorder::~BatchRecorder() {
+    _tasks->wait();
+}
+
+void BatchRecorder::record(const RenderContextPointer& renderContext, const char* name, bool parallel, const Recorder& recorder) {
+    assert(renderContext->args);
+    const auto& batchRecorder = renderContext->_batchRecorder;
+    if (parallel && batchRecorder && canRecordInParallel(renderContext)) {
+        batchRecorder->recordInParallel(renderContext, name, recorder);
+        return;
+    }
+
+    gpu::doInBatch(name, renderContext->args->_context, [&](gpu::Batch& batch) {
+        recorder(renderContext, batch);
+    });
+}
+
+bool BatchRecorder::canRecordInParallel(const RenderContextPointer& renderContext) {
+    // Nothing that runs after a job without outputs can depend on it, as far as the task graph knows
+    const auto& config = renderContext->jobConfig;
+    return config && config->_jobConcept && config->_jobConcept->getOutput().canCast<task::JobNoIO>();
+}
+
+void BatchRecorder::recordInParallel(const RenderContextPointer& renderContext, const char* name, const Recorder& recorder) {
+    auto gpuContext = renderContext->args->_context;
+    auto batch = gpu::Context::acquireBatch(name);
+    if (!gpuContext->appendPendingFrameBatch(batch)) {
+        return;
+    }
+
+    // The args go on changing on this thread as the next jobs run
+    auto args = std::make_shared<RenderArgs>(*renderContext->args);
+    args->_details = RenderDetails();
+    auto workerContext = std::make_shared<RenderContext>();
+    workerContext->args = args.get();
+    workerContext->_scene = renderContext->_scene;
+    workerContext->jobConfig = renderContext->jobConfig;
+
+    _tasks->run([this, gpuContext, batch, args, workerContext, recorder] {
+        PROFILE_RANGE(render, batch->getName().c_str());
+        recorder(workerContext, *batch);
+        {
+            std::lock_guard<std::mutex> lock(_detailsMutex);
+            _details._materialSwitches += args->_details._materialSwitches;
+            _details._trianglesRendered += args->_details._trianglesRendered;
+        }
+        gpuContext->finishPendingFrameBatch();
+    });
+}
+
+void BatchRecorder::wait(RenderArgs* args) {
+    PROFILE_RANGE(render, "BatchRecorder::wait");
+    _tasks->wait();
+
+    std::lock_guard<std::mutex> lock(_detailsMutex);
+    if (args) {
+        args->_details._materialSwitches += _details._materialSwitches;
+        args->_details._trianglesRendered += _details._trianglesRendered;
+    }
+    _details = RenderDetails();
+}
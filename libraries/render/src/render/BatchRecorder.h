@@ -0,0 +1,57 @@
+//
+//  BatchRecorder.h
+//  render/src/render
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_BatchRecorder_h
+#define hifi_render_BatchRecorder_h
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <gpu/Batch.h>
+
+#include "Engine.h"
+
+namespace render {
+
+    // Records the batches of the jobs nothing else in the task graph depends on, the jobs without outputs, on worker
+    // threads. Each batch takes its place in the frame when it is started, so the batches are executed in the order the
+    // jobs ran, and is recorded with its own copy of the args. The render engine waits for them at the end of its run.
+    class BatchRecorder {
+    public:
+        using Recorder = std::function<void(const RenderContextPointer& renderContext, gpu::Batch& batch)>;
+
+        BatchRecorder();
+        ~BatchRecorder();
+
+        // Like gpu::doInBatch, but on a worker thread when parallel is set and the running job has no outputs. The
+        // recorder is given a context of its own, its args are a copy of those of the job, and must only reach the
+        // inputs of the job through copies of them.
+        static void record(const RenderContextPointer& renderContext, const char* name, bool parallel, const Recorder& recorder);
+
+        // Whether the batches of the running job can be recorded on worker threads
+        static bool canRecordInParallel(const RenderContextPointer& renderContext);
+
+        // Waits for the batches being recorded, and adds what they rendered to the details of the args
+        void wait(RenderArgs* args);
+
+    private:
+        void recordInParallel(const RenderContextPointer& renderContext, const char* name, const Recorder& recorder);
+
+        class Tasks;
+        std::unique_ptr<Tasks> _tasks;
+
+        std::mutex _detailsMutex;
+        RenderDetails _details;
+    };
+
+}
+
+#endif // hifi_render_BatchRecorder_h
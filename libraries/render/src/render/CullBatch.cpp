@@ -0,0 +1,283 @@
+//
+//  CullBatch.cpp
+//  render/src/render
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullBatch.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <string.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+using namespace render;
+
+const int CullBatch::MAX_NUM_VIEWS;
+const size_t CullBatch::BLOCK_SIZE;
+
+// The frustum planes of a view, then those of its anti-frustum, as (normal, d)
+static const int PLANES_PER_VIEW = 2 * NUM_FRUSTUM_PLANES;
+
+// Below that many bounds it isn't worth waking up the worker threads
+static const size_t MIN_BOUNDS_TO_CULL_IN_PARALLEL = 4096;
+static const size_t BLOCKS_PER_TASK = 256;
+
+// For the bounds in [begin, end), which are multiples of 8, the bit of each view they are in, before its functor.
+// A bound is in a frustum unless the distance to one of its planes from the farthest corner along the normal is negative,
+// as in ViewFrustum::boxIntersectsFrustum(), and inside an anti-frustum unless it is from the nearest corner, as in
+// ViewFrustum::boxInsideFrustum().
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// The distances from the corners the plane picks, 4 bounds at a time
+static inline __m128 planeDistance4(const float* plane, bool farthest, __m128 cornerX, __m128 cornerY, __m128 cornerZ,
+                                    __m128 farX, __m128 farY, __m128 farZ) {
+    __m128 x = (farthest ? plane[0] > 0.0f : plane[0] < 0.0f) ? farX : cornerX;
+    __m128 y = (farthest ? plane[1] > 0.0f : plane[1] < 0.0f) ? farY : cornerY;
+    __m128 z = (farthest ? plane[2] > 0.0f : plane[2] < 0.0f) ? farZ : cornerZ;
+    __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[0]), x), _mm_mul_ps(_mm_set1_ps(plane[1]), y)),
+                            _mm_mul_ps(_mm_set1_ps(plane[2]), z));
+    return _mm_add_ps(_mm_set1_ps(plane[3]), dot);
+}
+
+static void cullBoundsSoA_SSE(const float* const* coordinates, size_t begin, size_t end, const float (*planes)[4],
+                              int numViews, uint8_t frustumViews, uint8_t antiFrustumViews, uint8_t* masks) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 all = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    for (size_t i = begin; i < end; i += 4) {
+        __m128 cornerX = _mm_loadu_ps(coordinates[CullBatch::CORNER_X] + i);
+        __m128 cornerY = _mm_loadu_ps(coordinates[CullBatch::CORNER_Y] + i);
+        __m128 cornerZ = _mm_loadu_ps(coordinates[CullBatch::CORNER_Z] + i);
+        __m128 farX = _mm_add_ps(cornerX, _mm_loadu_ps(coordinates[CullBatch::SCALE_X] + i));
+        __m128 farY = _mm_add_ps(cornerY, _mm_loadu_ps(coordinates[CullBatch::SCALE_Y] + i));
+        __m128 farZ = _mm_add_ps(cornerZ, _mm_loadu_ps(coordinates[CullBatch::SCALE_Z] + i));
+
+        uint8_t laneMasks[4] = { 0, 0, 0, 0 };
+        for (int view = 0; view < numViews; ++view) {
+            const float (*viewPlanes)[4] = planes + view * PLANES_PER_VIEW;
+            __m128 in = all;
+            if (frustumViews & (1 << view)) {
+                for (int j = 0; j < NUM_FRUSTUM_PLANES && _mm_movemask_ps(in); ++j) {
+                    __m128 distance = planeDistance4(viewPlanes[j], true, cornerX, cornerY, cornerZ, farX, farY, farZ);
+                    in = _mm_and_ps(in, _mm_cmpnlt_ps(distance, zero));
+                }
+            }
+            if ((antiFrustumViews & (1 << view)) && _mm_movemask_ps(in)) {
+                __m128 outside = zero;
+                for (int j = 0; j < NUM_FRUSTUM_PLANES; ++j) {
+                    __m128 distance = planeDistance4(viewPlanes[NUM_FRUSTUM_PLANES + j], false,
+                                                     cornerX, cornerY, cornerZ, farX, farY, farZ);
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+                }
+                in = _mm_and_ps(in, outside);
+            }
+            int bits = _mm_movemask_ps(in);
+            for (int lane = 0; lane < 4; ++lane) {
+                laneMasks[lane] |= (uint8_t)((bits >> lane) & 1) << view;
+            }
+        }
+        memcpy(masks + i, laneMasks, sizeof(laneMasks));
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+#include <CPUDetect.h>
+
+void cullBoundsSoA_AVX2(const float* const* coordinates, size_t begin, size_t end, const float (*planes)[4],
+                        int numViews, uint8_t frustumViews, uint8_t antiFrustumViews, uint8_t* masks);
+
+static void cullBoundsSoA(const float* const* coordinates, size_t begin, size_t end, const float (*planes)[4],
+                          int numViews, uint8_t frustumViews, uint8_t antiFrustumViews, uint8_t* masks) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        cullBoundsSoA_AVX2(coordinates, begin, end, planes, numViews, frustumViews, antiFrustumViews, masks);
+    } else {
+        cullBoundsSoA_SSE(coordinates, begin, end, planes, numViews, frustumViews, antiFrustumViews, masks);
+    }
+}
+
+#else   // portable reference code
+
+static void cullBoundsSoA_ref(const float* const* coordinates, size_t begin, size_t end, const float (*planes)[4],
+                              int numViews, uint8_t frustumViews, uint8_t antiFrustumViews, uint8_t* masks) {
+    for (size_t i = begin; i < end; ++i) {
+        glm::vec3 corner(coordinates[CullBatch::CORNER_X][i], coordinates[CullBatch::CORNER_Y][i],
+                         coordinates[CullBatch::CORNER_Z][i]);
+        glm::vec3 farCorner = corner + glm::vec3(coordinates[CullBatch::SCALE_X][i], coordinates[CullBatch::SCALE_Y][i],
+                                                 coordinates[CullBatch::SCALE_Z][i]);
+        uint8_t mask = 0;
+        for (int view = 0; view < numViews; ++view) {
+            const float (*viewPlanes)[4] = planes + view * PLANES_PER_VIEW;
+            bool in = true;
+            if (frustumViews & (1 << view)) {
+                for (int j = 0; in && j < NUM_FRUSTUM_PLANES; ++j) {
+                    const float* plane = viewPlanes[j];
+                    glm::vec3 vertex(plane[0] > 0.0f ? farCorner.x : corner.x, plane[1] > 0.0f ? farCorner.y : corner.y,
+                                     plane[2] > 0.0f ? farCorner.z : corner.z);
+                    in = !(plane[3] + (plane[0] * vertex.x + plane[1] * vertex.y + plane[2] * vertex.z) < 0.0f);
+                }
+            }
+            if (in && (antiFrustumViews & (1 << view))) {
+                bool inside = true;
+                for (int j = 0; inside && j < NUM_FRUSTUM_PLANES; ++j) {
+                    const float* plane = viewPlanes[NUM_FRUSTUM_PLANES + j];
+                    glm::vec3 vertex(plane[0] < 0.0f ? farCorner.x : corner.x, plane[1] < 0.0f ? farCorner.y : corner.y,
+                                     plane[2] < 0.0f ? farCorner.z : corner.z);
+                    inside = !(plane[3] + (plane[0] * vertex.x + plane[1] * vertex.y + plane[2] * vertex.z) < 0.0f);
+                }
+                in = !inside;
+            }
+            mask |= (uint8_t)in << view;
+        }
+        masks[i] = mask;
+    }
+}
+
+static auto& cullBoundsSoA = cullBoundsSoA_ref;
+
+#endif
+
+static void copyPlanes(const ViewFrustum& frustum, float (*planes)[4]) {
+    const ::Plane* frustumPlanes = frustum.getPlanes();
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+        const glm::vec3& normal = frustumPlanes[i].getNormal();
+        planes[i][0] = normal.x;
+        planes[i][1] = normal.y;
+        planes[i][2] = normal.z;
+        planes[i][3] = frustumPlanes[i].getDCoefficient();
+    }
+}
+
+void CullBatch::clear() {
+    for (auto& coordinates : _coordinates) {
+        coordinates.clear();
+    }
+    _size = 0;
+}
+
+void CullBatch::reserve(size_t numBounds) {
+    size_t paddedSize = (numBounds + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+    for (auto& coordinates : _coordinates) {
+        coordinates.reserve(paddedSize);
+    }
+}
+
+void CullBatch::add(const AABox& bound) {
+    if (_size % BLOCK_SIZE == 0) {
+        // a new block, padded with empty bounds at the origin
+        for (auto& coordinates : _coordinates) {
+            coordinates.resize(_size + BLOCK_SIZE, 0.0f);
+        }
+    }
+    const glm::vec3& corner = bound.getCorner();
+    const glm::vec3& scale = bound.getScale();
+    _coordinates[CORNER_X][_size] = corner.x;
+    _coordinates[CORNER_Y][_size] = corner.y;
+    _coordinates[CORNER_Z][_size] = corner.z;
+    _coordinates[SCALE_X][_size] = scale.x;
+    _coordinates[SCALE_Y][_size] = scale.y;
+    _coordinates[SCALE_Z][_size] = scale.z;
+    ++_size;
+}
+
+void CullBatch::load(const ItemBounds& items) {
+    clear();
+    reserve(items.size());
+    for (const auto& item : items) {
+        add(item.bound);
+    }
+}
+
+AABox CullBatch::getBound(size_t index) const {
+    return AABox(glm::vec3(_coordinates[CORNER_X][index], _coordinates[CORNER_Y][index], _coordinates[CORNER_Z][index]),
+                 glm::vec3(_coordinates[SCALE_X][index], _coordinates[SCALE_Y][index], _coordinates[SCALE_Z][index]));
+}
+
+void CullBatch::cull(const RenderArgs* args, const View* views, int numViews, std::vector<ViewMask>& masks,
+                     Stats& stats) const {
+    assert(numViews >= 0 && numViews <= MAX_NUM_VIEWS);
+    stats = Stats();
+    masks.resize(_coordinates[0].size());
+    if (_size == 0 || numViews <= 0) {
+        masks.assign(_size, 0);
+        return;
+    }
+    numViews = std::min(numViews, MAX_NUM_VIEWS);
+
+    float planes[MAX_NUM_VIEWS * PLANES_PER_VIEW][4];
+    uint8_t frustumViews = 0;
+    uint8_t antiFrustumViews = 0;
+    for (int view = 0; view < numViews; ++view) {
+        if (views[view].frustum) {
+            frustumViews |= 1 << view;
+            copyPlanes(*views[view].frustum, &planes[view * PLANES_PER_VIEW]);
+        }
+        if (views[view].antiFrustum) {
+            antiFrustumViews |= 1 << view;
+            copyPlanes(*views[view].antiFrustum, &planes[view * PLANES_PER_VIEW + NUM_FRUSTUM_PLANES]);
+        }
+    }
+
+    const float* coordinates[NUM_COORDINATES];
+    for (int i = 0; i < NUM_COORDINATES; ++i) {
+        coordinates[i] = _coordinates[i].data();
+    }
+
+    std::atomic<int> outOfView[MAX_NUM_VIEWS];
+    std::atomic<int> tooSmall[MAX_NUM_VIEWS];
+    for (int view = 0; view < MAX_NUM_VIEWS; ++view) {
+        outOfView[view] = 0;
+        tooSmall[view] = 0;
+    }
+
+    auto cullRange = [&](size_t begin, size_t end) {
+        cullBoundsSoA(coordinates, begin, end, planes, numViews, frustumViews, antiFrustumViews, masks.data());
+
+        Stats rangeStats;
+        end = std::min(end, _size);
+        for (size_t i = begin; i < end; ++i) {
+            ViewMask mask = masks[i];
+            for (int view = 0; view < numViews; ++view) {
+                ViewMask bit = (ViewMask)(1 << view);
+                if (!(mask & bit)) {
+                    ++rangeStats.outOfView[view];
+                } else if (views[view].functor && !views[view].functor(args, getBound(i))) {
+                    mask &= ~bit;
+                    ++rangeStats.tooSmall[view];
+                }
+            }
+            masks[i] = mask;
+        }
+        for (int view = 0; view < numViews; ++view) {
+            outOfView[view] += rangeStats.outOfView[view];
+            tooSmall[view] += rangeStats.tooSmall[view];
+        }
+    };
+
+    size_t numBlocks = masks.size() / BLOCK_SIZE;
+    if (_size < MIN_BOUNDS_TO_CULL_IN_PARALLEL) {
+        cullRange(0, numBlocks * BLOCK_SIZE);
+    } else {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, BLOCKS_PER_TASK), [&](const tbb::blocked_range<size_t>& blocks) {
+            cullRange(blocks.begin() * BLOCK_SIZE, blocks.end() * BLOCK_SIZE);
+        });
+    }
+
+    masks.resize(_size);
+    for (int view = 0; view < numViews; ++view) {
+        stats.outOfView[view] = outOfView[view];
+        stats.tooSmall[view] = tooSmall[view];
+    }
+}
@@ -0,0 +1,82 @@
+//
+//  CullBatch.h
+//  render/src/render
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_CullBatch_h
+#define hifi_render_CullBatch_h
+
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+#include <AABox.h>
+#include <ViewFrustum.h>
+
+#include "Item.h"
+
+namespace render {
+
+    using CullFunctor = std::function<bool(const RenderArgs*, const AABox&)>;
+
+    // Culls many bounds against several views in a single pass over them. The bounds are packed as a structure of arrays,
+    // one per coordinate of their corners and dimensions, padded to a multiple of 8, so that they are tested against the
+    // planes of all the views 8 at a time. Enough of them are split across worker threads.
+    class CullBatch {
+    public:
+        static const int MAX_NUM_VIEWS { 8 };
+        static const size_t BLOCK_SIZE { 8 };
+
+        // The bit of each view a bound is in
+        using ViewMask = uint8_t;
+
+        // A bound is in a view when it intersects the frustum, isn't inside the anti-frustum and passes the functor, any of
+        // which can be left out. Like CullTest does, the functor is only called for the bounds in the frustum, but here it
+        // is called from worker threads, with the args given to cull().
+        struct View {
+            const ViewFrustum* frustum { nullptr };
+            const ViewFrustum* antiFrustum { nullptr };
+            CullFunctor functor;
+        };
+
+        // How many bounds each view culled, counted as CullTest counts them in the render details
+        struct Stats {
+            int outOfView[MAX_NUM_VIEWS] {};
+            int tooSmall[MAX_NUM_VIEWS] {};
+        };
+
+        enum Coordinate {
+            CORNER_X = 0,
+            CORNER_Y,
+            CORNER_Z,
+            SCALE_X,
+            SCALE_Y,
+            SCALE_Z,
+            NUM_COORDINATES
+        };
+
+        void clear();
+        void reserve(size_t numBounds);
+        void add(const AABox& bound);
+        void load(const ItemBounds& items);
+
+        size_t size() const { return _size; }
+        AABox getBound(size_t index) const;
+        const float* get(Coordinate coordinate) const { return _coordinates[coordinate].data(); }
+
+        // masks gets the views each bound is in
+        void cull(const RenderArgs* args, const View* views, int numViews, std::vector<ViewMask>& masks, Stats& stats) const;
+
+    private:
+        std::vector<float> _coordinates[NUM_COORDINATES];
+        size_t _size { 0 };
+    };
+
+}
+
+#endif // hifi_render_CullBatch_h
@@ -74,33 +74,34 @@ void render::cullItems(const RenderContextPointer& renderContext, const CullFunc
 
     details._considered += (int)inItems.size();
 
-    // Culling / LOD
-    for (auto item : inItems) {
-        if (item.bound.isNull()) {
-            outItems.emplace_back(item); // One more Item to render
-            continue;
+    // Culling / LOD, in one batch for the items that have a bound
+    thread_local CullBatch batch;
+    thread_local std::vector<CullBatch::ViewMask> masks;
+    batch.clear();
+    batch.reserve(inItems.size());
+    for (const auto& item : inItems) {
+        if (!item.bound.isNull()) {
+            batch.add(item.bound);
         }
+    }
 
-        // TODO: some entity types (like lights) might want to be rendered even
-        // when they are outside of the view frustum...
-        bool inView;
-        {
-            PerformanceTimer perfTimer("boxIntersectsFrustum");
-            inView = frustum.boxIntersectsFrustum(item.bound);
-        }
-        if (inView) {
-            bool bigEnoughToRender;
-            {
-                PerformanceTimer perfTimer("shouldRender");
-                bigEnoughToRender = cullFunctor(args, item.bound);
-            }
-            if (bigEnoughToRender) {
-                outItems.emplace_back(item); // One more Item to render
-            } else {
-                details._tooSmall++;
-            }
-        } else {
-            details._outOfView++;
+    // TODO: some entity types (like lights) might want to be rendered even
+    // when they are outside of the view frustum...
+    CullBatch::View view;
+    view.frustum = &frustum;
+    view.functor = cullFunctor;
+    CullBatch::Stats stats;
+    {
+        PerformanceTimer perfTimer("cullBatch");
+        batch.cull(args, &view, 1, masks, stats);
+    }
+    details._outOfView += stats.outOfView[0];
+    details._tooSmall += stats.tooSmall[0];
+
+    size_t culled = 0;
+    for (const auto& item : inItems) {
+        if (item.bound.isNull() || masks[culled++]) {
+            outItems.emplace_back(item); // One more Item to render
         }
     }
     details._rendered += (int)outItems.size();
@@ -195,8 +196,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -209,136 +208,41 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
+        bool skipCulling = _skipCulling || _overrideSkipCulling;
 
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
+        CullBatch::View distanceCull;
+        distanceCull.functor = _cullFunctor;
+        CullBatch::View frustumCull;
+        frustumCull.frustum = &args->getViewFrustum();
+        CullBatch::View frustumAndDistanceCull;
+        frustumAndDistanceCull.frustum = &args->getViewFrustum();
+        frustumAndDistanceCull.functor = _cullFunctor;
 
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
-
-        } else {
-
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene));
-                        }
-                    }
-                }
-            }
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            cullSelectedItems(args, *scene, filter, inSelection.insideItems, nullptr, details, outItems);
+        }
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            cullSelectedItems(args, *scene, filter, inSelection.insideSubcellItems, skipCulling ? nullptr : &distanceCull,
+                details, outItems);
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene));
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            cullSelectedItems(args, *scene, filter, inSelection.partialItems, skipCulling ? nullptr : &frustumCull,
+                details, outItems);
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey())) {
-                        ItemBound itemBound(id, item.getBound());
-                        if (test.frustumTest(itemBound.bound)) {
-                            if (test.solidAngleTest(itemBound.bound)) {
-                                outItems.emplace_back(itemBound);
-                                if (item.getKey().isMetaCullGroup()) {
-                                    item.fetchMetaSubItemBounds(outItems, (*scene));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            cullSelectedItems(args, *scene, filter, inSelection.partialSubcellItems,
+                skipCulling ? nullptr : &frustumAndDistanceCull, details, outItems);
         }
     }
 
@@ -352,6 +256,37 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
 }
 
+void CullSpatialSelection::cullSelectedItems(const RenderArgs* args, Scene& scene, const ItemFilter& filter,
+                                             const ItemIDs& itemIDs, const CullBatch::View* view, RenderDetails::Item& details,
+                                             ItemBounds& outItems) {
+    _filteredItems.clear();
+    for (auto id : itemIDs) {
+        auto& item = scene.getItem(id);
+        if (filter.test(item.getKey())) {
+            _filteredItems.emplace_back(ItemBound(id, item.getBound()));
+        }
+    }
+
+    if (view) {
+        CullBatch::Stats stats;
+        _batch.load(_filteredItems);
+        _batch.cull(args, view, 1, _masks, stats);
+        details._outOfView += stats.outOfView[0];
+        details._tooSmall += stats.tooSmall[0];
+    }
+
+    for (size_t i = 0; i < _filteredItems.size(); ++i) {
+        if (!view || _masks[i]) {
+            const auto& itemBound = _filteredItems[i];
+            outItems.emplace_back(itemBound);
+            auto& item = scene.getItem(itemBound.id);
+            if (item.getKey().isMetaCullGroup()) {
+                item.fetchMetaSubItemBounds(outItems, scene);
+            }
+        }
+    }
+}
+
 void CullShapeBounds::run(const RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -15,9 +15,9 @@
 #include "Engine.h"
 #include "ViewFrustum.h"
 
-namespace render {
+#include "CullBatch.h"
 
-    using CullFunctor = std::function<bool(const RenderArgs*, const AABox&)>;
+namespace render {
 
     void cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
         const ItemBounds& inItems, ItemBounds& outItems);
@@ -121,6 +121,15 @@ namespace render {
 
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext, const Inputs& inputs, ItemBounds& outItems);
+
+    private:
+        // Adds the items of the list that pass the filter and are in the view, or all that pass it without one
+        void cullSelectedItems(const RenderArgs* args, Scene& scene, const ItemFilter& filter, const ItemIDs& itemIDs,
+            const CullBatch::View* view, RenderDetails::Item& details, ItemBounds& outItems);
+
+        ItemBounds _filteredItems;
+        CullBatch _batch;
+        std::vector<CullBatch::ViewMask> _masks;
     };
 
     class CullShapeBounds {
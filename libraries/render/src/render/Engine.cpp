@@ -17,6 +17,7 @@
 
 #include <gpu/Context.h>
 
+#include "BatchRecorder.h"
 #include "EngineStats.h"
 #include "SceneTask.h"
 
@@ -38,6 +39,16 @@ public:
 
 RenderEngine::RenderEngine() : Engine(EngineTask::JobModel::create("Engine"), std::make_shared<RenderContext>())
 {
+    _context->_batchRecorder = std::make_shared<BatchRecorder>();
+}
+
+void RenderEngine::run(const RenderContextPointer& renderContext) {
+    Engine::run(renderContext);
+
+    // The batches recorded on worker threads are done before the scene changes again
+    if (renderContext->_batchRecorder) {
+        renderContext->_batchRecorder->wait(renderContext->args);
+    }
 }
 
 void RenderEngine::load() {
@@ -30,6 +30,7 @@ namespace render {
 
         RenderArgs* args;
         ScenePointer _scene;
+        BatchRecorderPointer _batchRecorder;
     };
     using RenderContextPointer = std::shared_ptr<RenderContext>;
 
@@ -88,6 +89,8 @@ namespace render {
         RenderEngine();
         ~RenderEngine() = default;
 
+        using Engine::run;
+
         // Load any persisted settings, and set up the presets
         // This should be run after adding all jobs, and before building ui
         void load();
@@ -99,6 +102,7 @@ namespace render {
         RenderContextPointer getRenderContext() const { return _context; }
 
     protected:
+        void run(const RenderContextPointer& renderContext) override;
     };
     using EnginePointer = std::shared_ptr<RenderEngine>;
 
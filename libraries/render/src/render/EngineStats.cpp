@@ -64,5 +64,13 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
 
+    if (renderContext->_scene) {
+        auto transactionStats = renderContext->_scene->getTransactionStats();
+        config->sceneTransactionTime = transactionStats.usecs;
+        config->sceneUpdateCount = transactionStats.numUpdates;
+        config->sceneParallelUpdateCount = transactionStats.numParallelUpdates;
+        config->sceneSpatialResetCount = transactionStats.numSpatialResets;
+    }
+
     // These new stat values are notified with the "newStats" signal triggered by the timer
 }
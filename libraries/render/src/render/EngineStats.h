@@ -61,6 +61,11 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY newStats)
 
+        Q_PROPERTY(quint64 sceneTransactionTime MEMBER sceneTransactionTime NOTIFY newStats)
+        Q_PROPERTY(quint32 sceneUpdateCount MEMBER sceneUpdateCount NOTIFY newStats)
+        Q_PROPERTY(quint32 sceneParallelUpdateCount MEMBER sceneParallelUpdateCount NOTIFY newStats)
+        Q_PROPERTY(quint32 sceneSpatialResetCount MEMBER sceneSpatialResetCount NOTIFY newStats)
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -101,6 +106,12 @@ namespace render {
         quint32 frameSetPipelineCount{ 0 };
 
         quint32 frameSetInputFormatCount{ 0 };
+
+        // the last processing of the scene transactions, in usecs
+        quint64 sceneTransactionTime{ 0 };
+        quint32 sceneUpdateCount{ 0 };
+        quint32 sceneParallelUpdateCount{ 0 };
+        quint32 sceneSpatialResetCount{ 0 };
     };
 
     class EngineStats {
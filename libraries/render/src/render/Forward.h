@@ -29,6 +29,8 @@ namespace render {
     using ScenePointer = std::shared_ptr<Scene>;
     class ShapePipeline;
     class Transaction;
+    class BatchRecorder;
+    using BatchRecorderPointer = std::shared_ptr<BatchRecorder>;
 }
 
 using RenderArgs = render::Args;
@@ -422,6 +422,13 @@ public:
     class UpdateFunctorInterface {
     public:
         virtual ~UpdateFunctorInterface() {}
+
+        // An independent update only touches the payload it is given, and nothing it shares with other payloads, like a
+        // material, so the Scene can run it on a worker thread alongside the updates of other items
+        bool isIndependent() const { return _isIndependent; }
+
+    protected:
+        bool _isIndependent { false };
     };
     typedef std::shared_ptr<UpdateFunctorInterface> UpdateFunctorPointer;
 
@@ -512,7 +519,7 @@ public:
     typedef std::function<void(T&)> Func;
     Func _func;
 
-    UpdateFunctor(Func func): _func(func) {}
+    UpdateFunctor(Func func, bool isIndependent = false): _func(func) { _isIndependent = isIndependent; }
     ~UpdateFunctor() {}
 };
 
@@ -11,7 +11,14 @@
 #include "Scene.h"
 
 #include <numeric>
+#include <unordered_map>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
+
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -240,12 +247,29 @@ void Scene::processTransactionQueue() {
         queuedFrames.swap(_transactionFrames);
     }
 
+    quint64 start = usecTimestampNow();
+    _pendingTransactionStats = TransactionStats();
+
     // go through the queue of frames and process them
     for (auto& frame : queuedFrames) {
         processTransactionFrame(frame);
     }
 
     queuedFrames.clear();
+
+    _transactionUsecs = usecTimestampNow() - start;
+    _numUpdates = _pendingTransactionStats.numUpdates;
+    _numParallelUpdates = _pendingTransactionStats.numParallelUpdates;
+    _numSpatialResets = _pendingTransactionStats.numSpatialResets;
+}
+
+Scene::TransactionStats Scene::getTransactionStats() const {
+    TransactionStats stats;
+    stats.usecs = _transactionUsecs;
+    stats.numUpdates = _numUpdates;
+    stats.numParallelUpdates = _numParallelUpdates;
+    stats.numSpatialResets = _numSpatialResets;
+    return stats;
 }
 
 void Scene::processTransactionFrame(const Transaction& transaction) {
@@ -335,48 +359,189 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
     }
 }
 
+// Fewer updates are applied one at a time
+static const size_t MIN_UPDATES_TO_APPLY_IN_PARALLEL = 256;
+// The independent updates are split by ranges of item IDs, each applied by one task
+static const ItemID MIN_ITEM_IDS_PER_RANGE = 512;
+static const ItemID MAX_NUM_ITEM_ID_RANGES = 64;
+
 void Scene::updateItems(const Transaction::Updates& transactions) {
+    _pendingTransactionStats.numUpdates += (uint32_t)transactions.size();
+
+    if (transactions.size() >= MIN_UPDATES_TO_APPLY_IN_PARALLEL) {
+        updateItemsInParallel(transactions);
+        return;
+    }
     for (auto& update : transactions) {
-        auto updateID = std::get<0>(update);
-        if (updateID == Item::INVALID_ITEM_ID) {
-            continue;
+        updateItem(std::get<0>(update), std::get<1>(update));
+    }
+}
+
+void Scene::updateItem(ItemID updateID, const UpdateFunctorPointer& functor) {
+    if (updateID == Item::INVALID_ITEM_ID) {
+        return;
+    }
+
+    // Access the true item
+    auto& item = _items[updateID];
+
+    // If item doesn't exist it cannot be updated
+    if (!item.exist()) {
+        return;
+    }
+
+    // Good to go, deal with the update
+    auto oldCell = item.getCell();
+    auto oldKey = item.getKey();
+
+    // Update the item
+    item.update(functor);
+    auto newKey = item.getKey();
+
+    // Update the item's container
+    if (oldKey.isSpatial() == newKey.isSpatial()) {
+        if (newKey.isSpatial()) {
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+            if (newCell != oldCell || newKey._flags != oldKey._flags) {
+                _pendingTransactionStats.numSpatialResets++;
+            }
         }
+    } else {
+        if (newKey.isSpatial()) {
+            _masterNonspatialSet.erase(updateID);
 
-        // Access the true item
-        auto& item = _items[updateID];
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+        } else {
+            _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
+            item.resetCell();
 
-        // If item doesn't exist it cannot be updated
-        if (!item.exist()) {
-            continue;
+            _masterNonspatialSet.insert(updateID);
         }
+        _pendingTransactionStats.numSpatialResets++;
+    }
+}
 
-        // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
+void Scene::updateItemsInParallel(const Transaction::Updates& transactions) {
+    PROFILE_RANGE(render, __FUNCTION__);
 
-        // Update the item
-        item.update(std::get<1>(update));
-        auto newKey = item.getKey();
+    // From the first update of an item that isn't independent on, its updates are applied on this thread, in order, after
+    // the others. The independent ones that come before it can still be applied by the tasks.
+    std::unordered_map<ItemID, size_t> firstSerialUpdates;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        const auto& functor = std::get<1>(transactions[i]);
+        if (functor && !functor->isIndependent()) {
+            firstSerialUpdates.emplace(std::get<0>(transactions[i]), i);
+        }
+    }
 
-        // Update the item's container
-        if (oldKey.isSpatial() == newKey.isSpatial()) {
-            if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
-            }
+    // The other updates are split by ranges of item IDs, so that all the updates of an item are applied by the same task
+    ItemID numItems = (ItemID)_items.size();
+    ItemID numRanges = std::max((ItemID)1, std::min(MAX_NUM_ITEM_ID_RANGES, numItems / MIN_ITEM_IDS_PER_RANGE));
+    std::vector<std::vector<size_t>> ranges(numRanges);
+    std::vector<size_t> serialUpdates;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        auto updateID = std::get<0>(transactions[i]);
+        if (updateID == Item::INVALID_ITEM_ID || updateID >= numItems) {
+            continue;
+        }
+        auto firstSerialUpdate = firstSerialUpdates.find(updateID);
+        if (firstSerialUpdate != firstSerialUpdates.end() && i >= firstSerialUpdate->second) {
+            serialUpdates.push_back(i);
         } else {
-            if (newKey.isSpatial()) {
-                _masterNonspatialSet.erase(updateID);
+            ranges[(size_t)((uint64_t)updateID * numRanges / numItems)].push_back(i);
+        }
+    }
+
+    // What the spatial tree needs to know of the items that moved, merged into it once all the tasks are done
+    struct SpatialReset {
+        ItemID id;
+        ItemCell oldCell;
+        ItemKey oldKey;
+        ItemKey newKey;
+        ItemSpatialTree::Location location;
+        bool isSmall;
+    };
+    std::vector<std::vector<SpatialReset>> spatialResets(numRanges);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRanges, 1), [&](const tbb::blocked_range<size_t>& taskRanges) {
+        for (size_t range = taskRanges.begin(); range != taskRanges.end(); ++range) {
+            auto& updates = ranges[range];
+            std::stable_sort(updates.begin(), updates.end(), [&](size_t a, size_t b) {
+                return std::get<0>(transactions[a]) < std::get<0>(transactions[b]);
+            });
+
+            for (size_t i = 0; i < updates.size();) {
+                auto updateID = std::get<0>(transactions[updates[i]]);
+                size_t end = i + 1;
+                while (end < updates.size() && std::get<0>(transactions[updates[end]]) == updateID) {
+                    ++end;
+                }
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
+                // If item doesn't exist it cannot be updated
+                auto& item = _items[updateID];
+                if (!item.exist()) {
+                    i = end;
+                    continue;
+                }
+
+                auto oldCell = item.getCell();
+                auto oldKey = item.getKey();
+                for (; i < end; ++i) {
+                    item.update(std::get<1>(transactions[updates[i]]));
+                }
+                auto newKey = item.getKey();
+
+                SpatialReset reset { updateID, oldCell, oldKey, newKey, ItemSpatialTree::Location(), false };
+                if (newKey.isSpatial() && !newKey.isViewSpace()) {
+                    reset.location = _masterSpatialTree.evalItemLocation(item.getBound(), reset.isSmall);
+
+                    // most items that are updated stay where they were, the tree doesn't need to know about them
+                    newKey.setSmaller(reset.isSmall);
+                    if (oldKey.isSpatial() && oldCell != INVALID_CELL && newKey._flags == oldKey._flags &&
+                        _masterSpatialTree.getCellLocation(oldCell) == reset.location) {
+                        item.resetCell(oldCell, reset.isSmall);
+                        continue;
+                    }
+                } else if (!newKey.isSpatial() && !oldKey.isSpatial()) {
+                    continue;
+                }
+                spatialResets[range].push_back(reset);
+            }
+        }
+    });
+
+    for (const auto& resets : spatialResets) {
+        for (auto reset : resets) {
+            auto& item = _items[reset.id];
+            if (reset.newKey.isSpatial()) {
+                if (!reset.oldKey.isSpatial()) {
+                    _masterNonspatialSet.erase(reset.id);
+                }
+                ItemCell newCell;
+                if (reset.newKey.isViewSpace()) {
+                    newCell = _masterSpatialTree.resetItem(reset.oldCell, reset.oldKey, item.getBound(), reset.id, reset.newKey);
+                } else {
+                    newCell = _masterSpatialTree.resetItem(reset.oldCell, reset.oldKey, reset.location, reset.isSmall, reset.id,
+                                                           reset.newKey);
+                }
+                item.resetCell(newCell, reset.newKey.isSmall());
             } else {
-                _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
+                _masterSpatialTree.removeItem(reset.oldCell, reset.oldKey, reset.id);
                 item.resetCell();
 
-                _masterNonspatialSet.insert(updateID);
+                _masterNonspatialSet.insert(reset.id);
             }
         }
+        _pendingTransactionStats.numSpatialResets += (uint32_t)resets.size();
+    }
+
+    for (const auto& updates : ranges) {
+        _pendingTransactionStats.numParallelUpdates += (uint32_t)updates.size();
+    }
+    for (auto i : serialUpdates) {
+        updateItem(std::get<0>(transactions[i]), std::get<1>(transactions[i]));
     }
 }
 
@@ -55,6 +55,10 @@ public:
     }
     void updateItem(ItemID id, const UpdateFunctorPointer& functor);
     void updateItem(ItemID id) { updateItem(id, nullptr); }
+    // For a func that only touches the payload it is given, see UpdateFunctorInterface::isIndependent()
+    template <class T> void updateIndependentItem(ItemID id, std::function<void(T&)> func) {
+        updateItem(id, std::make_shared<UpdateFunctor<T>>(func, true));
+    }
 
     // Transition (applied to an item) transactions
     void resetTransitionOnItem(ItemID id, Transition::Type transition, ItemID boundId = render::Item::INVALID_ITEM_ID);
@@ -158,6 +162,16 @@ public:
     // Process the pending transactions queued
     void processTransactionQueue();
 
+    // What the last processTransactionQueue() went through
+    struct TransactionStats {
+        uint64_t usecs { 0 };
+        uint32_t numUpdates { 0 };
+        uint32_t numParallelUpdates { 0 }; // the independent updates applied on worker threads
+        uint32_t numSpatialResets { 0 }; // the items moved in the spatial tree or in or out of it
+    };
+    // Thread safe
+    TransactionStats getTransactionStats() const;
+
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
     Selection getSelection(const Selection::Name& name) const;
@@ -222,6 +236,8 @@ protected:
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
     void removeItems(const Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
+    void updateItem(ItemID id, const UpdateFunctorPointer& functor);
+    void updateItemsInParallel(const Transaction::Updates& transactions);
 
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
@@ -245,6 +261,13 @@ protected:
   //  void appendToSelection(const Selection& selection);
   //  void mergeWithSelection(const Selection& selection);
 
+    // Counted by the item transactions as they go, and published at the end of processTransactionQueue()
+    TransactionStats _pendingTransactionStats;
+    std::atomic<uint64_t> _transactionUsecs { 0 };
+    std::atomic<uint32_t> _numUpdates { 0 };
+    std::atomic<uint32_t> _numParallelUpdates { 0 };
+    std::atomic<uint32_t> _numSpatialResets { 0 };
+
     // The Stage map
     mutable std::mutex _stagesMutex; // mutable so it can be used in the thread safe getStage const method
     StageMap _stages;
@@ -126,30 +126,36 @@ const ShapePipelinePointer ShapePlumber::pickPipeline(RenderArgs* args, const Ke
 
     PerformanceTimer perfTimer("ShapePlumber::pickPipeline");
 
-    auto pipelineIterator = _pipelineMap.find(key);
-    if (pipelineIterator == _pipelineMap.end()) {
-        // The first time we can't find a pipeline, we should try things to solve that
-        if (_missingKeys.find(key) == _missingKeys.end()) {
-            if (key.isCustom()) {
-                auto factoryIt = ShapePipeline::_globalCustomFactoryMap.find(key.getCustom());
-                if ((factoryIt != ShapePipeline::_globalCustomFactoryMap.end()) && (factoryIt)->second) {
-                    // found a factory for the custom key, can now generate a shape pipeline for this case:
-                    addPipelineHelper(Filter(key), key, 0, (factoryIt)->second(*this, key, args));
-
-                    return pickPipeline(args, key);
-                } else {
-                    qCDebug(renderlogging) << "ShapePlumber::Couldn't find a custom pipeline factory for " << key.getCustom() << " key is: " << key;
+    PipelinePointer shapePipeline;
+    {
+        std::lock_guard<std::mutex> lock(_pipelineMapMutex);
+        auto pipelineIterator = _pipelineMap.find(key);
+        if (pipelineIterator == _pipelineMap.end()) {
+            // The first time we can't find a pipeline, we should try things to solve that
+            if (_missingKeys.find(key) == _missingKeys.end()) {
+                if (key.isCustom()) {
+                    auto factoryIt = ShapePipeline::_globalCustomFactoryMap.find(key.getCustom());
+                    if ((factoryIt != ShapePipeline::_globalCustomFactoryMap.end()) && (factoryIt)->second) {
+                        // found a factory for the custom key, can now generate a shape pipeline for this case:
+                        addPipelineHelper(Filter(key), key, 0, (factoryIt)->second(*this, key, args));
+                        pipelineIterator = _pipelineMap.find(key);
+                    } else {
+                        qCDebug(renderlogging) << "ShapePlumber::Couldn't find a custom pipeline factory for " << key.getCustom() << " key is: " << key;
+                    }
                 }
-            }
 
-           _missingKeys.insert(key);
-            qCDebug(renderlogging) << "ShapePlumber::Couldn't find a pipeline for" << key;
+                if (pipelineIterator == _pipelineMap.end()) {
+                    _missingKeys.insert(key);
+                    qCDebug(renderlogging) << "ShapePlumber::Couldn't find a pipeline for" << key;
+                }
+            }
+            if (pipelineIterator == _pipelineMap.end()) {
+                return PipelinePointer(nullptr);
+            }
         }
-        return PipelinePointer(nullptr);
+        shapePipeline = pipelineIterator->second;
     }
 
-    PipelinePointer shapePipeline(pipelineIterator->second);
-
     // Setup the one pipeline (to rule them all)
     args->_batch->setPipeline(shapePipeline->pipeline);
 
@@ -12,6 +12,7 @@
 #ifndef hifi_render_ShapePipeline_h
 #define hifi_render_ShapePipeline_h
 
+#include <mutex>
 #include <unordered_set>
 
 #include <gpu/Batch.h>
@@ -349,6 +350,9 @@ protected:
 
 private:
     mutable std::unordered_set<Key, Key::Hash, Key::KeyEqual> _missingKeys;
+
+    // Custom pipelines are added as they are first picked, by whichever thread records the batch
+    mutable std::mutex _pipelineMapMutex;
 };
 
 
@@ -380,27 +380,38 @@ bool ItemSpatialTree::removeItem(Index cellIdx, const ItemKey& key, const ItemID
 }
 
 ItemSpatialTree::Index ItemSpatialTree::resetItem(Index oldCell, const ItemKey& oldKey, const AABox& bound, const ItemID& item, ItemKey& newKey) {
-    auto newCell = INVALID_CELL;
-    if (!newKey.isViewSpace()) {
-        Coord3f minCoordf, maxCoordf;
-        auto location = evalLocation(bound, minCoordf, maxCoordf);
-
-        // Compare range size vs cell location size and tag itemKey accordingly
-        // If Item bound fits in sub cell then tag as small
-        auto rangeSizef = maxCoordf - minCoordf;
-        float cellHalfSize = 0.5f * getCellWidth(location.depth);
-        bool subcellItem = std::max(std::max(rangeSizef.x, rangeSizef.y), rangeSizef.z) < cellHalfSize;
-        if (subcellItem) {
-            newKey.setSmaller(subcellItem);
-        } else {
-            newKey.setSmaller(false);
-        }
-
-        newCell = indexCell(location);
-    } else {
+    if (newKey.isViewSpace()) {
         // A very rare case, if we were adding items with boundary semantic expressed in view space
+        // Remove the item where it was
+        if (oldCell != INVALID_CELL) {
+            removeItem(oldCell, oldKey, item);
+        }
+        return INVALID_CELL;
     }
 
+    bool isSmall;
+    auto location = evalItemLocation(bound, isSmall);
+    return resetItem(oldCell, oldKey, location, isSmall, item, newKey);
+}
+
+ItemSpatialTree::Location ItemSpatialTree::evalItemLocation(const AABox& bound, bool& isSmall) const {
+    Coord3f minCoordf, maxCoordf;
+    auto location = evalLocation(bound, minCoordf, maxCoordf);
+
+    // Compare range size vs cell location size and tag itemKey accordingly
+    // If Item bound fits in sub cell then tag as small
+    auto rangeSizef = maxCoordf - minCoordf;
+    float cellHalfSize = 0.5f * getCellWidth(location.depth);
+    isSmall = std::max(std::max(rangeSizef.x, rangeSizef.y), rangeSizef.z) < cellHalfSize;
+
+    return location;
+}
+
+ItemSpatialTree::Index ItemSpatialTree::resetItem(Index oldCell, const ItemKey& oldKey, const Location& location, bool isSmall,
+                                                  const ItemID& item, ItemKey& newKey) {
+    newKey.setSmaller(isSmall);
+    auto newCell = indexCell(location);
+
     // Did we fail finding a cell for the item?
     if (newCell == INVALID_CELL) {
         // Remove the item where it was
@@ -446,6 +446,12 @@ namespace render {
 
         Index resetItem(Index oldCell, const ItemKey& oldKey, const AABox& bound, const ItemID& item, ItemKey& newKey);
 
+        // resetItem() in two steps: the location of the cell an item belongs in, and whether it is small enough for the
+        // subcells, only read the tree and can be evaluated on any thread, then the item is moved there
+        Location evalItemLocation(const AABox& bound, bool& isSmall) const;
+        Index resetItem(Index oldCell, const ItemKey& oldKey, const Location& location, bool isSmall, const ItemID& item,
+                        ItemKey& newKey);
+
         // Selection and traverse
         int selectCells(CellSelection& selection, const ViewFrustum& frustum, float threshold) const;
 
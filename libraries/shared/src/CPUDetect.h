@@ -13,11 +13,12 @@
 #define hifi_CPUDetect_h
 
 //
-// Lightweight functions to detect SSE/AVX/AVX2/AVX512 support
+// Lightweight functions to detect SSE/AVX/AVX2/FMA/AVX512 support
 //
 
 #define MASK_SSE3       (1 << 0)                // SSE3
 #define MASK_SSSE3      (1 << 9)                // SSSE3
+#define MASK_FMA        (1 << 12)               // FMA3
 #define MASK_SSE41      (1 << 19)               // SSE4.1
 #define MASK_SSE42      ((1 << 20) | (1 << 23)) // SSE4.2 and POPCNT
 #define MASK_OSXSAVE    (1 << 27)               // OSXSAVE
@@ -134,6 +135,21 @@ static inline bool cpuSupportsAVX2() {
     return result;
 }
 
+static inline bool cpuSupportsFMA() {
+    int info[4];
+
+    bool result = false;
+    if (cpuSupportsAVX()) {
+
+        cpuidex(info, 0x1, 0);
+
+        if ((info[2] & MASK_FMA) == MASK_FMA) {
+            result = true;
+        }
+    }
+    return result;
+}
+
 static inline bool cpuSupportsAVX512() {
     int info[4];
 
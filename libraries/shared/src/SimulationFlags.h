@@ -19,6 +19,10 @@ const uint8_t RECRUIT_SIMULATION_PRIORITY = VOLUNTEER_SIMULATION_PRIORITY + 1;
 const uint8_t SCRIPT_GRAB_SIMULATION_PRIORITY = 128;
 const uint8_t SCRIPT_POKE_SIMULATION_PRIORITY = SCRIPT_GRAB_SIMULATION_PRIORITY - 1;
 
+// An entity-physics-server volunteers for the active entities of its region at SERVER priority,
+// so clients only take them over when they poke, grab or bump into them with their avatar
+const uint8_t SERVER_SIMULATION_PRIORITY = SCRIPT_POKE_SIMULATION_PRIORITY - 1;
+
 const uint8_t PERSONAL_SIMULATION_PRIORITY = SCRIPT_GRAB_SIMULATION_PRIORITY;
 const uint8_t AVATAR_ENTITY_SIMULATION_PRIORITY = PERSONAL_SIMULATION_PRIORITY;
 
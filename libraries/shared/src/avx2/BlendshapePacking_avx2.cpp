@@ -11,8 +11,99 @@
 #ifdef __AVX2__
 
 #include <stdint.h>
+#include <string.h>
 #include <immintrin.h>
 
+// Packs 8 offsets, given as the 9 vectors of their components
+static inline void packBlendshapeOffsets8(__m256 px, __m256 py, __m256 pz, __m256 nx, __m256 ny, __m256 nz,
+                                          __m256 tx, __m256 ty, __m256 tz, uint32_t (*packed)[4]) {
+    // abs(pos)
+    __m256 apx = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), px);
+    __m256 apy = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), py);
+    __m256 apz = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), pz);
+
+    // len = compMax(abs(pos))
+    __m256 len = _mm256_max_ps(_mm256_max_ps(apx, apy), apz);
+
+    // detect zeros
+    __m256 mask = _mm256_cmp_ps(len, _mm256_setzero_ps(), _CMP_EQ_OQ);
+
+    // rcp = 1.0f / len
+    __m256 rcp = _mm256_div_ps(_mm256_set1_ps(1.0f), len);
+
+    // replace +inf with 1.0f
+    rcp = _mm256_blendv_ps(rcp, _mm256_set1_ps(1.0f), mask);
+    len = _mm256_blendv_ps(len, _mm256_set1_ps(1.0f), mask);
+
+    // pos *= 1.0f / len
+    px = _mm256_mul_ps(px, rcp);
+    py = _mm256_mul_ps(py, rcp);
+    pz = _mm256_mul_ps(pz, rcp);
+
+    // clamp(vec, -1.0f, 1.0f)
+    px = _mm256_min_ps(_mm256_max_ps(px, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    py = _mm256_min_ps(_mm256_max_ps(py, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    pz = _mm256_min_ps(_mm256_max_ps(pz, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    nx = _mm256_min_ps(_mm256_max_ps(nx, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    ny = _mm256_min_ps(_mm256_max_ps(ny, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    nz = _mm256_min_ps(_mm256_max_ps(nz, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    tx = _mm256_min_ps(_mm256_max_ps(tx, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    ty = _mm256_min_ps(_mm256_max_ps(ty, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+    tz = _mm256_min_ps(_mm256_max_ps(tz, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
+
+    // vec *= 511.0f
+    px = _mm256_mul_ps(px, _mm256_set1_ps(511.0f));
+    py = _mm256_mul_ps(py, _mm256_set1_ps(511.0f));
+    pz = _mm256_mul_ps(pz, _mm256_set1_ps(511.0f));
+    nx = _mm256_mul_ps(nx, _mm256_set1_ps(511.0f));
+    ny = _mm256_mul_ps(ny, _mm256_set1_ps(511.0f));
+    nz = _mm256_mul_ps(nz, _mm256_set1_ps(511.0f));
+    tx = _mm256_mul_ps(tx, _mm256_set1_ps(511.0f));
+    ty = _mm256_mul_ps(ty, _mm256_set1_ps(511.0f));
+    tz = _mm256_mul_ps(tz, _mm256_set1_ps(511.0f));
+
+    // veci = lrint(vec) & 03ff
+    __m256i pxi = _mm256_and_si256(_mm256_cvtps_epi32(px), _mm256_set1_epi32(0x3ff));
+    __m256i pyi = _mm256_and_si256(_mm256_cvtps_epi32(py), _mm256_set1_epi32(0x3ff));
+    __m256i pzi = _mm256_and_si256(_mm256_cvtps_epi32(pz), _mm256_set1_epi32(0x3ff));
+    __m256i nxi = _mm256_and_si256(_mm256_cvtps_epi32(nx), _mm256_set1_epi32(0x3ff));
+    __m256i nyi = _mm256_and_si256(_mm256_cvtps_epi32(ny), _mm256_set1_epi32(0x3ff));
+    __m256i nzi = _mm256_and_si256(_mm256_cvtps_epi32(nz), _mm256_set1_epi32(0x3ff));
+    __m256i txi = _mm256_and_si256(_mm256_cvtps_epi32(tx), _mm256_set1_epi32(0x3ff));
+    __m256i tyi = _mm256_and_si256(_mm256_cvtps_epi32(ty), _mm256_set1_epi32(0x3ff));
+    __m256i tzi = _mm256_and_si256(_mm256_cvtps_epi32(tz), _mm256_set1_epi32(0x3ff));
+
+    // pack = (xi << 0) | (yi << 10) | (zi << 20);
+    __m256i li = _mm256_castps_si256(len);                                                                      // length
+    __m256i pi = _mm256_or_si256(_mm256_or_si256(pxi, _mm256_slli_epi32(pyi, 10)), _mm256_slli_epi32(pzi, 20)); // position
+    __m256i ni = _mm256_or_si256(_mm256_or_si256(nxi, _mm256_slli_epi32(nyi, 10)), _mm256_slli_epi32(nzi, 20)); // normal
+    __m256i ti = _mm256_or_si256(_mm256_or_si256(txi, _mm256_slli_epi32(tyi, 10)), _mm256_slli_epi32(tzi, 20)); // tangent
+
+    //
+    // interleave (4x4 matrix transpose)
+    //
+    __m256i u0 = _mm256_unpacklo_epi32(li, pi);
+    __m256i u1 = _mm256_unpackhi_epi32(li, pi);
+    __m256i u2 = _mm256_unpacklo_epi32(ni, ti);
+    __m256i u3 = _mm256_unpackhi_epi32(ni, ti);
+
+    __m256i v0 = _mm256_unpacklo_epi64(u0, u2);
+    __m256i v1 = _mm256_unpackhi_epi64(u0, u2);
+    __m256i v2 = _mm256_unpacklo_epi64(u1, u3);
+    __m256i v3 = _mm256_unpackhi_epi64(u1, u3);
+
+    __m256i w0 = _mm256_permute2f128_si256(v0, v1, 0x20);
+    __m256i w1 = _mm256_permute2f128_si256(v2, v3, 0x20);
+    __m256i w2 = _mm256_permute2f128_si256(v0, v1, 0x31);
+    __m256i w3 = _mm256_permute2f128_si256(v2, v3, 0x31);
+
+    // store pack x 8
+    _mm256_storeu_si256((__m256i*)packed[0], w0);
+    _mm256_storeu_si256((__m256i*)packed[2], w1);
+    _mm256_storeu_si256((__m256i*)packed[4], w2);
+    _mm256_storeu_si256((__m256i*)packed[6], w3);
+}
+
 void packBlendshapeOffsets_AVX2(float (*unpacked)[9], uint32_t (*packed)[4], int size) {
     
     int i = 0;
@@ -50,91 +141,7 @@ void packBlendshapeOffsets_AVX2(float (*unpacked)[9], uint32_t (*packed)[4], int
 
         __m256 tz = _mm256_i32gather_ps(unpacked[i+0], _mm256_setr_epi32(8,17,26,35,44,53,62,71), sizeof(float));
 
-        // abs(pos)
-        __m256 apx = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), px);
-        __m256 apy = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), py);
-        __m256 apz = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), pz);
-
-        // len = compMax(abs(pos))
-        __m256 len = _mm256_max_ps(_mm256_max_ps(apx, apy), apz);
-
-        // detect zeros
-        __m256 mask = _mm256_cmp_ps(len, _mm256_setzero_ps(), _CMP_EQ_OQ);
-
-        // rcp = 1.0f / len
-        __m256 rcp = _mm256_div_ps(_mm256_set1_ps(1.0f), len);
-
-        // replace +inf with 1.0f
-        rcp = _mm256_blendv_ps(rcp, _mm256_set1_ps(1.0f), mask);
-        len = _mm256_blendv_ps(len, _mm256_set1_ps(1.0f), mask);
-
-        // pos *= 1.0f / len
-        px = _mm256_mul_ps(px, rcp);
-        py = _mm256_mul_ps(py, rcp);
-        pz = _mm256_mul_ps(pz, rcp);
-
-        // clamp(vec, -1.0f, 1.0f)
-        px = _mm256_min_ps(_mm256_max_ps(px, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-        py = _mm256_min_ps(_mm256_max_ps(py, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-        pz = _mm256_min_ps(_mm256_max_ps(pz, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-        nx = _mm256_min_ps(_mm256_max_ps(nx, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-        ny = _mm256_min_ps(_mm256_max_ps(ny, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-        nz = _mm256_min_ps(_mm256_max_ps(nz, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-        tx = _mm256_min_ps(_mm256_max_ps(tx, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-        ty = _mm256_min_ps(_mm256_max_ps(ty, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-        tz = _mm256_min_ps(_mm256_max_ps(tz, _mm256_set1_ps(-1.0f)), _mm256_set1_ps(1.0f));
-
-        // vec *= 511.0f
-        px = _mm256_mul_ps(px, _mm256_set1_ps(511.0f));
-        py = _mm256_mul_ps(py, _mm256_set1_ps(511.0f));
-        pz = _mm256_mul_ps(pz, _mm256_set1_ps(511.0f));
-        nx = _mm256_mul_ps(nx, _mm256_set1_ps(511.0f));
-        ny = _mm256_mul_ps(ny, _mm256_set1_ps(511.0f));
-        nz = _mm256_mul_ps(nz, _mm256_set1_ps(511.0f));
-        tx = _mm256_mul_ps(tx, _mm256_set1_ps(511.0f));
-        ty = _mm256_mul_ps(ty, _mm256_set1_ps(511.0f));
-        tz = _mm256_mul_ps(tz, _mm256_set1_ps(511.0f));
-
-        // veci = lrint(vec) & 03ff
-        __m256i pxi = _mm256_and_si256(_mm256_cvtps_epi32(px), _mm256_set1_epi32(0x3ff));
-        __m256i pyi = _mm256_and_si256(_mm256_cvtps_epi32(py), _mm256_set1_epi32(0x3ff));
-        __m256i pzi = _mm256_and_si256(_mm256_cvtps_epi32(pz), _mm256_set1_epi32(0x3ff));
-        __m256i nxi = _mm256_and_si256(_mm256_cvtps_epi32(nx), _mm256_set1_epi32(0x3ff));
-        __m256i nyi = _mm256_and_si256(_mm256_cvtps_epi32(ny), _mm256_set1_epi32(0x3ff));
-        __m256i nzi = _mm256_and_si256(_mm256_cvtps_epi32(nz), _mm256_set1_epi32(0x3ff));
-        __m256i txi = _mm256_and_si256(_mm256_cvtps_epi32(tx), _mm256_set1_epi32(0x3ff));
-        __m256i tyi = _mm256_and_si256(_mm256_cvtps_epi32(ty), _mm256_set1_epi32(0x3ff));
-        __m256i tzi = _mm256_and_si256(_mm256_cvtps_epi32(tz), _mm256_set1_epi32(0x3ff));
-
-        // pack = (xi << 0) | (yi << 10) | (zi << 20);
-        __m256i li = _mm256_castps_si256(len);                                                                      // length
-        __m256i pi = _mm256_or_si256(_mm256_or_si256(pxi, _mm256_slli_epi32(pyi, 10)), _mm256_slli_epi32(pzi, 20)); // position
-        __m256i ni = _mm256_or_si256(_mm256_or_si256(nxi, _mm256_slli_epi32(nyi, 10)), _mm256_slli_epi32(nzi, 20)); // normal
-        __m256i ti = _mm256_or_si256(_mm256_or_si256(txi, _mm256_slli_epi32(tyi, 10)), _mm256_slli_epi32(tzi, 20)); // tangent
-
-        //
-        // interleave (4x4 matrix transpose)
-        //
-        __m256i u0 = _mm256_unpacklo_epi32(li, pi);
-        __m256i u1 = _mm256_unpackhi_epi32(li, pi);
-        __m256i u2 = _mm256_unpacklo_epi32(ni, ti);
-        __m256i u3 = _mm256_unpackhi_epi32(ni, ti);
-
-        __m256i v0 = _mm256_unpacklo_epi64(u0, u2);
-        __m256i v1 = _mm256_unpackhi_epi64(u0, u2);
-        __m256i v2 = _mm256_unpacklo_epi64(u1, u3);
-        __m256i v3 = _mm256_unpackhi_epi64(u1, u3);
-
-        __m256i w0 = _mm256_permute2f128_si256(v0, v1, 0x20);
-        __m256i w1 = _mm256_permute2f128_si256(v2, v3, 0x20);
-        __m256i w2 = _mm256_permute2f128_si256(v0, v1, 0x31);
-        __m256i w3 = _mm256_permute2f128_si256(v2, v3, 0x31);
-
-        // store pack x 8
-        _mm256_storeu_si256((__m256i*)packed[i+0], w0);
-        _mm256_storeu_si256((__m256i*)packed[i+2], w1);
-        _mm256_storeu_si256((__m256i*)packed[i+4], w2);
-        _mm256_storeu_si256((__m256i*)packed[i+6], w3);
+        packBlendshapeOffsets8(px, py, pz, nx, ny, nz, tx, ty, tz, &packed[i]);
     }
 
     if (i < size) { // remainder
@@ -282,4 +289,66 @@ void packBlendshapeOffsets_AVX2(float (*unpacked)[9], uint32_t (*packed)[4], int
     _mm256_zeroupper();
 }
 
+// Packs offsets accumulated as 9 arrays of stride floats, the x, y and z of the positions, then the normals, then the tangents
+void packBlendshapeOffsetsSoA_AVX2(const float* accumulated, int stride, uint32_t (*packed)[4], int size) {
+
+    const float* c[9];
+    for (int k = 0; k < 9; k++) {
+        c[k] = accumulated + k * stride;
+    }
+
+    int i = 0;
+    for (; i < size - 7; i += 8) {  // blocks of 8
+        packBlendshapeOffsets8(_mm256_loadu_ps(&c[0][i]), _mm256_loadu_ps(&c[1][i]), _mm256_loadu_ps(&c[2][i]),
+                               _mm256_loadu_ps(&c[3][i]), _mm256_loadu_ps(&c[4][i]), _mm256_loadu_ps(&c[5][i]),
+                               _mm256_loadu_ps(&c[6][i]), _mm256_loadu_ps(&c[7][i]), _mm256_loadu_ps(&c[8][i]), &packed[i]);
+    }
+
+    if (i < size) { // remainder, packed through a zero padded block
+        int rem = size - i;
+
+        float block[9][8] = {};
+        for (int k = 0; k < 9; k++) {
+            for (int j = 0; j < rem; j++) {
+                block[k][j] = c[k][i + j];
+            }
+        }
+
+        uint32_t packedBlock[8][4];
+        packBlendshapeOffsets8(_mm256_loadu_ps(block[0]), _mm256_loadu_ps(block[1]), _mm256_loadu_ps(block[2]),
+                               _mm256_loadu_ps(block[3]), _mm256_loadu_ps(block[4]), _mm256_loadu_ps(block[5]),
+                               _mm256_loadu_ps(block[6]), _mm256_loadu_ps(block[7]), _mm256_loadu_ps(block[8]), packedBlock);
+        memcpy(packed[i], packedBlock, rem * sizeof(packedBlock[0]));
+    }
+
+    _mm256_zeroupper();
+}
+
+// accumulated += offsets * coefficient
+void accumulateBlendshapeOffsets_AVX2(float* accumulated, const float* offsets, float coefficient, int size) {
+
+    __m256 k = _mm256_set1_ps(coefficient);
+
+    int i = 0;
+    for (; i < size - 31; i += 32) {  // blocks of 32
+        __m256 a0 = _mm256_fmadd_ps(_mm256_loadu_ps(&offsets[i+0]), k, _mm256_loadu_ps(&accumulated[i+0]));
+        __m256 a1 = _mm256_fmadd_ps(_mm256_loadu_ps(&offsets[i+8]), k, _mm256_loadu_ps(&accumulated[i+8]));
+        __m256 a2 = _mm256_fmadd_ps(_mm256_loadu_ps(&offsets[i+16]), k, _mm256_loadu_ps(&accumulated[i+16]));
+        __m256 a3 = _mm256_fmadd_ps(_mm256_loadu_ps(&offsets[i+24]), k, _mm256_loadu_ps(&accumulated[i+24]));
+        _mm256_storeu_ps(&accumulated[i+0], a0);
+        _mm256_storeu_ps(&accumulated[i+8], a1);
+        _mm256_storeu_ps(&accumulated[i+16], a2);
+        _mm256_storeu_ps(&accumulated[i+24], a3);
+    }
+    for (; i < size - 7; i += 8) {  // blocks of 8
+        __m256 a = _mm256_fmadd_ps(_mm256_loadu_ps(&offsets[i]), k, _mm256_loadu_ps(&accumulated[i]));
+        _mm256_storeu_ps(&accumulated[i], a);
+    }
+    for (; i < size; i++) {  // remainder
+        accumulated[i] += offsets[i] * coefficient;
+    }
+
+    _mm256_zeroupper();
+}
+
 #endif
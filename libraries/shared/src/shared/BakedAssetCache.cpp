@@ -0,0 +1,108 @@
+//
+//  BakedAssetCache.cpp
+//  libraries/shared/src/shared
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakedAssetCache.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QStandardPaths>
+
+using namespace cache;
+
+const std::string BakedAssetCache::EXTENSION { "baked" };
+
+static const quint32 ENTRIES_MAGIC { 0x4b424648 }; // "HFBK"
+static const quint32 ENTRIES_VERSION { 1 };
+static const QDataStream::Version ENTRIES_STREAM_VERSION { QDataStream::Qt_5_9 };
+
+QString BakedAssetCache::getDefaultDirectory(const QString& owner) {
+    // Not in the application's own cache folder, which depends on how the tool was started
+    QDir genericCache(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation));
+    return genericCache.absoluteFilePath(QCoreApplication::organizationName() + "/baked/" + owner);
+}
+
+BakedAssetCache::BakedAssetCache(const std::string& dirname, QObject* parent) :
+    FileCache(dirname, EXTENSION, parent) {
+}
+
+FileCache::Key BakedAssetCache::makeKey(const std::string& baker, int bakerVersion, const QByteArray& source, const QByteArray& options) {
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    // Prefix the options with their size, so the split between them and the source is part of the hash
+    quint64 optionsSize = options.size();
+    hasher.addData((const char*)&optionsSize, sizeof(optionsSize));
+    hasher.addData(options);
+    hasher.addData(source);
+    // Keys are file names, and everything up to the first '.' of a file name is taken as its key
+    return baker + "-" + std::to_string(bakerVersion) + "-" + hasher.result().toHex().toStdString();
+}
+
+bool BakedAssetCache::store(const Key& key, const Entries& entries) {
+    if (getFile(key)) {
+        return true;
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(ENTRIES_STREAM_VERSION);
+        stream << ENTRIES_MAGIC << ENTRIES_VERSION << (quint32)entries.size();
+        for (const auto& entry : entries) {
+            stream << entry.first << entry.second;
+        }
+    }
+    return (bool)writeFile(data.constData(), Metadata(key, data.size()));
+}
+
+bool BakedAssetCache::load(const Key& key, Entries& entries) {
+    entries.clear();
+
+    auto file = getFile(key);
+    if (!file) {
+        ++_numMisses;
+        return false;
+    }
+
+    // A stale entry may have lost its file, and a partly written one fails the checks below, both count as misses
+    QFile cachedFile(QString::fromStdString(file->getFilepath()));
+    if (!cachedFile.open(QIODevice::ReadOnly)) {
+        qCWarning(file_cache) << "Could not read baked asset" << key.c_str();
+        ++_numMisses;
+        return false;
+    }
+
+    QDataStream stream(&cachedFile);
+    stream.setVersion(ENTRIES_STREAM_VERSION);
+    quint32 magic { 0 };
+    quint32 version { 0 };
+    quint32 numEntries { 0 };
+    stream >> magic >> version >> numEntries;
+    if (magic != ENTRIES_MAGIC || version != ENTRIES_VERSION) {
+        qCWarning(file_cache) << "Invalid baked asset" << key.c_str();
+        ++_numMisses;
+        return false;
+    }
+    for (quint32 i = 0; i < numEntries && stream.status() == QDataStream::Ok; ++i) {
+        Entry entry;
+        stream >> entry.first >> entry.second;
+        entries.push_back(std::move(entry));
+    }
+    if (stream.status() != QDataStream::Ok || entries.size() != numEntries) {
+        qCWarning(file_cache) << "Truncated baked asset" << key.c_str();
+        entries.clear();
+        ++_numMisses;
+        return false;
+    }
+
+    ++_numHits;
+    return true;
+}
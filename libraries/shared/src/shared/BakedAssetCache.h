@@ -0,0 +1,64 @@
+//
+//  BakedAssetCache.h
+//  libraries/shared/src/shared
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakedAssetCache_h
+#define hifi_BakedAssetCache_h
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "FileCache.h"
+
+namespace cache {
+
+class BakedAssetCache;
+using BakedAssetCachePointer = std::shared_ptr<BakedAssetCache>;
+
+// A cache of the results of baking assets, kept on disk so they can be reused across runs by the tools that bake, from the
+// oven to Interface preparing unbaked models. Results are keyed by what they were baked from rather than by
+// where it came from, so the same content under another URL, or uploaded again, is only ever baked once.
+class BakedAssetCache : public FileCache {
+    Q_OBJECT
+
+public:
+    static const std::string EXTENSION;
+
+    // The folder of one of the tools that bake, by default. Each cache evicts on its own, so no two of them share a folder.
+    static QString getDefaultDirectory(const QString& owner);
+
+    BakedAssetCache(const std::string& dirname, QObject* parent = nullptr);
+
+    // The key of a result, from the content it was baked from and anything else it depends on, like the baker options.
+    // The baker and its version prefix the key, so a newer version never picks up what an older one baked.
+    static Key makeKey(const std::string& baker, int bakerVersion, const QByteArray& source, const QByteArray& options = QByteArray());
+
+    // A result is one or more named blobs, such as the files one texture bakes to
+    using Entry = std::pair<QString, QByteArray>;
+    using Entries = std::vector<Entry>;
+
+    // Answers true if the result is in the cache, whether it was just written or was there already
+    bool store(const Key& key, const Entries& entries);
+    // Answers false on a miss, including when the cached file can't be read back
+    bool load(const Key& key, Entries& entries);
+
+    size_t getNumHits() const { return _numHits; }
+    size_t getNumMisses() const { return _numMisses; }
+
+private:
+    std::atomic<size_t> _numHits { 0 };
+    std::atomic<size_t> _numMisses { 0 };
+};
+
+}
+
+#endif // hifi_BakedAssetCache_h
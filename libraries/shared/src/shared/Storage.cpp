@@ -36,6 +36,22 @@ StoragePointer Storage::toMemoryStorage() const {
     return std::make_shared<MemoryStorage>(size(), data());
 }
 
+void Storage::prefault() const {
+    if (!isMapped()) {
+        return;
+    }
+    static const size_t PAGE_SIZE = 4096;
+    auto bytes = data();
+    auto byteCount = size();
+    volatile uint8_t sink = 0;
+    for (size_t offset = 0; offset < byteCount; offset += PAGE_SIZE) {
+        sink += bytes[offset];
+    }
+    if (byteCount) {
+        sink += bytes[byteCount - 1];
+    }
+}
+
 StoragePointer Storage::toFileStorage(const QString& filename) const {
     return FileStorage::create(filename, size(), data());
 }
@@ -69,8 +85,11 @@ StoragePointer FileStorage::create(const QString& filename, size_t size, const u
     return std::make_shared<FileStorage>(filename);
 }
 
-FileStorage::FileStorage(const QString& filename) : _file(filename) {
-    bool opened = _file.open(QFile::ReadWrite | QFile::Unbuffered);
+FileStorage::FileStorage(const QString& filename, Access access) : _file(filename) {
+    bool opened = false;
+    if (access == Access::ReadWrite) {
+        opened = _file.open(QFile::ReadWrite | QFile::Unbuffered);
+    }
     if (opened) {
         _hasWriteAccess = true;
     } else {
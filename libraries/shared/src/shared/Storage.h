@@ -35,10 +35,14 @@ namespace storage {
         virtual uint8_t* mutableData() = 0;
         virtual size_t size() const = 0;
         virtual operator bool() const { return true; }
+        // True if the data is a mapping of a file, so reading it may page it in from disk
+        virtual bool isMapped() const { return false; }
 
         StoragePointer createView(size_t size = 0, size_t offset = 0) const;
         StoragePointer toFileStorage(const QString& filename) const;
         StoragePointer toMemoryStorage() const;
+        // Reads every page of a mapped storage so that any disk IO happens on the calling thread
+        void prefault() const;
 
         // Aliases to prevent having to re-write a ton of code
         inline size_t getSize() const { return size(); }
@@ -59,8 +63,10 @@ namespace storage {
 
     class FileStorage : public Storage {
     public:
+        enum class Access { ReadWrite, ReadOnly };
+
         static StoragePointer create(const QString& filename, size_t size, const uint8_t* data);
-        FileStorage(const QString& filename);
+        FileStorage(const QString& filename, Access access = Access::ReadWrite);
         ~FileStorage();
         // Prevent copying
         FileStorage(const FileStorage& other) = delete;
@@ -70,6 +76,7 @@ namespace storage {
         uint8_t* mutableData() override { return _hasWriteAccess ? _mapped : nullptr; }
         size_t size() const override { return _size; }
         operator bool() const override { return _valid; }
+        bool isMapped() const override { return _valid && _fallback.isEmpty(); }
     private:
         // For compressed QRC files we can't map the file object, so we need to read it into memory
         QByteArray _fallback;
@@ -87,6 +94,7 @@ namespace storage {
         uint8_t* mutableData() override { throw std::runtime_error("Cannot modify ViewStorage");  }
         size_t size() const override { return _size; }
         operator bool() const override { return *_owner; }
+        bool isMapped() const override { return _owner->isMapped(); }
     private:
         const storage::StoragePointer _owner;
         const size_t _size;
@@ -0,0 +1,181 @@
+//
+//  AnimPoseBufferTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBufferTests.h"
+
+#include <AnimPoseBuffer.h>
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <GLMHelpers.h>
+
+#include <test-utils/QTestExtensions.h>
+
+#include "TestSkeletons.h"
+
+QTEST_MAIN(AnimPoseBufferTests)
+
+const float TEST_EPSILON = 0.0001f;
+
+static HFMModel humanoidModel;
+static AnimSkeleton::Pointer humanoidSkeleton;
+static AnimPoseVec relativePoses;
+static AnimPoseVec otherRelativePoses;
+
+static void makePoses(AnimPoseVec& poses, int numJoints, float seed) {
+    poses.resize(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        float angle = seed + 0.1f * (float)i;
+        glm::vec3 axis = glm::normalize(glm::vec3(sinf(angle), 1.0f, cosf(angle)));
+        poses[i] = AnimPose(glm::vec3(1.0f + 0.01f * (float)(i % 3)), glm::angleAxis(angle, axis),
+                            glm::vec3(0.01f * (float)i, 0.1f, -0.02f * (float)(i % 5)));
+    }
+}
+
+static bool isClose(const AnimPose& a, const AnimPose& b) {
+    return glm::distance(a.scale(), b.scale()) < TEST_EPSILON &&
+        fabsf(fabsf(glm::dot(a.rot(), b.rot())) - 1.0f) < TEST_EPSILON &&
+        glm::distance(a.trans(), b.trans()) < TEST_EPSILON;
+}
+
+// What the skeleton did before the pose buffer, one AnimPose product at a time
+static void buildAbsolutePosesOneAtATime(const AnimSkeleton& skeleton, const AnimPoseVec& relative, const AnimPose& rootParent,
+                                         AnimPoseVec& absolute) {
+    absolute.resize(relative.size());
+    for (int i = 0; i < (int)relative.size(); i++) {
+        int parentIndex = skeleton.getParentIndex(i);
+        absolute[i] = (parentIndex >= 0 ? absolute[parentIndex] : rootParent) * relative[i];
+    }
+}
+
+void AnimPoseBufferTests::initTestCase() {
+    makeHumanoidSkeleton(humanoidModel, "humanoid.fbx");
+    humanoidSkeleton = std::make_shared<AnimSkeleton>(humanoidModel);
+    makePoses(relativePoses, humanoidSkeleton->getNumJoints(), 0.0f);
+    makePoses(otherRelativePoses, humanoidSkeleton->getNumJoints(), 1.0f);
+}
+
+void AnimPoseBufferTests::testHierarchy() {
+    std::vector<int> parentIndices;
+    for (int i = 0; i < humanoidSkeleton->getNumJoints(); i++) {
+        parentIndices.push_back(humanoidSkeleton->getParentIndex(i));
+    }
+    AnimPoseBuffer::Hierarchy hierarchy;
+    hierarchy.build(parentIndices);
+
+    QVERIFY(hierarchy.getNumSlots() % 4 == 0);
+    for (size_t depth = 0; depth + 1 < hierarchy._depthOffsets.size(); depth++) {
+        int begin = hierarchy._depthOffsets[depth];
+        int end = hierarchy._depthOffsets[depth + 1];
+        QVERIFY(begin % 4 == 0);
+        for (int slot = begin; slot < end; slot++) {
+            // the parents are all done before the depth they are parents of
+            int parentSlot = hierarchy._parentSlots[slot];
+            QVERIFY(parentSlot == hierarchy.getRootSlot() || parentSlot < begin);
+            int jointIndex = hierarchy._jointIndices[slot];
+            if (jointIndex >= 0 && parentIndices[jointIndex] >= 0) {
+                QCOMPARE(hierarchy._jointIndices[parentSlot], parentIndices[jointIndex]);
+            }
+        }
+    }
+
+    // all the joints are in it, once
+    std::vector<int> count(parentIndices.size(), 0);
+    for (int jointIndex : hierarchy._jointIndices) {
+        if (jointIndex >= 0) {
+            count[jointIndex]++;
+        }
+    }
+    for (int jointCount : count) {
+        QCOMPARE(jointCount, 1);
+    }
+}
+
+void AnimPoseBufferTests::testAbsolutePoses() {
+    AnimPose rootParent(glm::vec3(1.5f), glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f, 2.0f, 3.0f));
+
+    AnimPoseVec expected;
+    buildAbsolutePosesOneAtATime(*humanoidSkeleton, relativePoses, rootParent, expected);
+
+    AnimPoseVec absolute;
+    QVERIFY(humanoidSkeleton->buildAbsolutePoses(relativePoses, rootParent, absolute));
+    QCOMPARE(absolute.size(), expected.size());
+    for (size_t i = 0; i < absolute.size(); i++) {
+        QVERIFY(isClose(absolute[i], expected[i]));
+    }
+
+    AnimPoseVec converted = relativePoses;
+    humanoidSkeleton->convertRelativePosesToAbsolute(converted);
+    buildAbsolutePosesOneAtATime(*humanoidSkeleton, relativePoses, AnimPose::identity, expected);
+    for (size_t i = 0; i < converted.size(); i++) {
+        QVERIFY(isClose(converted[i], expected[i]));
+    }
+}
+
+void AnimPoseBufferTests::testNonUniformScale() {
+    AnimPoseVec poses = relativePoses;
+    poses[1].scale() = glm::vec3(1.0f, 2.0f, 1.0f);
+
+    AnimPoseVec absolute;
+    QVERIFY(!humanoidSkeleton->buildAbsolutePoses(poses, AnimPose::identity, absolute));
+    QVERIFY(absolute.empty());
+
+    // falls back on AnimPose products
+    AnimPoseVec expected;
+    buildAbsolutePosesOneAtATime(*humanoidSkeleton, poses, AnimPose::identity, expected);
+    humanoidSkeleton->convertRelativePosesToAbsolute(poses);
+    for (size_t i = 0; i < poses.size(); i++) {
+        QVERIFY(isClose(poses[i], expected[i]));
+    }
+}
+
+void AnimPoseBufferTests::testBlend() {
+    AnimPoseVec other = otherRelativePoses;
+    // one rotation on the other side of the hypersphere
+    other[3].rot() = -other[3].rot();
+
+    const float ALPHA = 0.3f;
+    AnimPoseVec result(relativePoses.size());
+    blend(relativePoses.size(), relativePoses.data(), other.data(), ALPHA, result.data());
+    for (size_t i = 0; i < result.size(); i++) {
+        AnimPose expected(glm::mix(relativePoses[i].scale(), other[i].scale(), ALPHA),
+                          safeLerp(relativePoses[i].rot(), other[i].rot(), ALPHA),
+                          glm::mix(relativePoses[i].trans(), other[i].trans(), ALPHA));
+        QVERIFY(isClose(result[i], expected));
+        QVERIFY(fabsf(glm::length(result[i].rot()) - 1.0f) < TEST_EPSILON);
+    }
+
+    // in place
+    AnimPoseVec inPlace = relativePoses;
+    blend(inPlace.size(), inPlace.data(), other.data(), ALPHA, inPlace.data());
+    for (size_t i = 0; i < inPlace.size(); i++) {
+        QVERIFY(isClose(inPlace[i], result[i]));
+    }
+}
+
+void AnimPoseBufferTests::benchmarkAbsolutePosesOneAtATime() {
+    AnimPoseVec absolute;
+    QBENCHMARK {
+        buildAbsolutePosesOneAtATime(*humanoidSkeleton, relativePoses, AnimPose::identity, absolute);
+    }
+}
+
+void AnimPoseBufferTests::benchmarkAbsolutePosesInBuffer() {
+    AnimPoseVec absolute;
+    QBENCHMARK {
+        humanoidSkeleton->buildAbsolutePoses(relativePoses, AnimPose::identity, absolute);
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBlendOneAtATime() {
+    AnimPoseVec result(relativePoses.size());
+    QBENCHMARK {
+        blend(result.size(), relativePoses.data(), otherRelativePoses.data(), 0.3f, result.data());
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  AnimPoseBufferTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBufferTests_h
+#define hifi_AnimPoseBufferTests_h
+
+#include <QtTest/QtTest>
+
+// Checks the pose buffer kernels against the AnimPose math they replace, and times both on a humanoid skeleton
+class AnimPoseBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testHierarchy();
+    void testAbsolutePoses();
+    void testNonUniformScale();
+    void testBlend();
+    void benchmarkAbsolutePosesOneAtATime();
+    void benchmarkAbsolutePosesInBuffer();
+    void benchmarkBlendOneAtATime();
+};
+
+#endif // hifi_AnimPoseBufferTests_h
@@ -0,0 +1,242 @@
+//
+//  AnimationClipTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimationClipTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <AnimationCache.h>
+#include <AnimationClip.h>
+#include <NodeList.h>
+#include <ResourceManager.h>
+#include <ResourceRequestObserver.h>
+#include <StatTracker.h>
+
+#include <test-utils/QTestExtensions.h>
+
+#include "TestSkeletons.h"
+
+QTEST_MAIN(AnimationClipTests)
+
+// ten seconds of animation at 30 frames per second
+const int NUM_FRAMES = 300;
+const int NUM_AVATARS = 100;
+// the states of the avatar animation graph that play a clip
+const int NUM_CLIPS_PER_AVATAR = 40;
+
+static HFMModel clipModel;
+
+void AnimationClipTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent);
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<AnimationCache>();
+    DependencyManager::set<ResourceRequestObserver>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<StatTracker>();
+
+    makeHumanoidSkeleton(clipModel, "clip.fbx");
+    _skeleton = std::make_shared<AnimSkeleton>(clipModel);
+
+    // a walk: the limbs and the spine swing, the hips bob, the fingers and the eyes don't move
+    _frames.resize(NUM_FRAMES);
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        float phase = TWO_PI * (float)frame / 30.0f;
+        for (int i = 0; i < _skeleton->getNumJoints(); ++i) {
+            AnimPose pose = _skeleton->getRelativeDefaultPose(i);
+            QString name = _skeleton->getJointName(i);
+            if (name.contains("Leg") || name.contains("Arm") || name.contains("Spine") || name.contains("Foot")) {
+                float angle = 0.5f * sinf(phase + 0.3f * (float)i);
+                pose.rot() = pose.rot() * glm::angleAxis(angle, glm::vec3(1.0f, 0.0f, 0.0f));
+            }
+            if (name == "Hips") {
+                pose.trans() += glm::vec3(0.0f, 0.03f * sinf(2.0f * phase), 0.05f * (float)frame / 30.0f);
+            }
+            _frames[frame].push_back(pose);
+        }
+    }
+}
+
+void AnimationClipTests::cleanupTestCase() {
+    _frames.clear();
+    _skeleton.reset();
+    DependencyManager::get<ResourceManager>()->cleanup();
+}
+
+void AnimationClipTests::testSampling() {
+    AnimationClip clip(_frames);
+    QCOMPARE(clip.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(clip.getNumJoints(), _skeleton->getNumJoints());
+
+    // the tolerance of the key reduction, plus what is lost packing the keys
+    const float ROTATION_ERROR = 2.0f * AnimationClip::ROTATION_TOLERANCE;
+    const float TRANSLATION_ERROR = 2.0f * AnimationClip::VECTOR_TOLERANCE;
+
+    AnimPoseVec poses;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        clip.sample(frame, poses);
+        QCOMPARE((int)poses.size(), _skeleton->getNumJoints());
+        for (int i = 0; i < (int)poses.size(); ++i) {
+            const AnimPose& expected = _frames[frame][i];
+            float angle = 2.0f * acosf(std::min(fabsf(glm::dot(poses[i].rot(), expected.rot())), 1.0f));
+            QVERIFY(angle <= ROTATION_ERROR);
+            float translationScale = std::max(glm::length(expected.trans()), 1.0f);
+            QVERIFY(glm::length(poses[i].trans() - expected.trans()) <= TRANSLATION_ERROR * translationScale);
+            QCOMPARE_WITH_ABS_ERROR(poses[i].scale(), expected.scale(), TRANSLATION_ERROR);
+        }
+    }
+
+    // frames out of the clip are clamped to it
+    AnimPoseVec lastPoses;
+    clip.sample(NUM_FRAMES - 1, lastPoses);
+    clip.sample(NUM_FRAMES + 10, poses);
+    for (size_t i = 0; i < poses.size(); ++i) {
+        QVERIFY(poses[i].rot() == lastPoses[i].rot());
+    }
+}
+
+void AnimationClipTests::testKeyReduction() {
+    AnimationClip clip(_frames);
+
+    // joints that don't move keep one key per track, the others far fewer than one per frame
+    size_t numTracks = 3 * clip.getNumJoints();
+    size_t numSamples = numTracks * NUM_FRAMES;
+    qDebug() << "keys:" << clip.getNumKeys() << "of" << numSamples;
+    QVERIFY(clip.getNumKeys() >= numTracks);
+    QVERIFY(clip.getNumKeys() < numSamples / 10);
+
+    // an animation of one frame still plays
+    std::vector<AnimPoseVec> oneFrame(1, _frames[0]);
+    AnimationClip oneFrameClip(oneFrame);
+    QCOMPARE(oneFrameClip.getNumFrames(), 1);
+    QCOMPARE(oneFrameClip.getNumKeys(), numTracks);
+}
+
+void AnimationClipTests::testSharedClips() {
+    auto animationCache = DependencyManager::get<AnimationCache>();
+    size_t numClips = animationCache->getNumClips();
+
+    int numBuilds = 0;
+    auto build = [&] {
+        ++numBuilds;
+        return std::make_shared<AnimationClip>(_frames);
+    };
+
+    AnimationClip::Key key { "walk.fbx", "", 0.0f, 0, false };
+    AnimationClip::Pointer clip = animationCache->getClip(key, _skeleton, build);
+    AnimationClip::Pointer sameClip = animationCache->getClip(key, _skeleton, build);
+    QVERIFY(clip == sameClip);
+    QCOMPARE(numBuilds, 1);
+
+    // the mirrored clip, or the same clip on another skeleton, is another clip
+    AnimationClip::Key mirrorKey = key;
+    mirrorKey.mirror = true;
+    AnimationClip::Pointer mirrorClip = animationCache->getClip(mirrorKey, _skeleton, build);
+    QVERIFY(mirrorClip != clip);
+    {
+        auto otherSkeleton = std::make_shared<AnimSkeleton>(clipModel);
+        AnimationClip::Pointer otherClip = animationCache->getClip(key, otherSkeleton, build);
+        QVERIFY(otherClip != clip);
+        QCOMPARE(numBuilds, 3);
+        QCOMPARE(animationCache->getNumClips(), numClips + 3);
+    }
+    QCOMPARE(animationCache->getNumClips(), numClips + 2);
+
+    // the clips go away with the last node playing them
+    clip.reset();
+    sameClip.reset();
+    mirrorClip.reset();
+    QCOMPARE(animationCache->getNumClips(), numClips);
+    clip = animationCache->getClip(key, _skeleton, build);
+    QCOMPARE(numBuilds, 4);
+}
+
+void AnimationClipTests::testConcurrentClips() {
+    auto animationCache = DependencyManager::get<AnimationCache>();
+
+    // a build can ask for another clip, as it isn't run with the clips locked
+    AnimationClip::Key key { "run.fbx", "", 0.0f, 0, false };
+    AnimationClip::Key otherKey { "jump.fbx", "", 0.0f, 0, false };
+    AnimationClip::Pointer otherClip;
+    AnimationClip::Pointer clip = animationCache->getClip(key, _skeleton, [&] {
+        otherClip = animationCache->getClip(otherKey, _skeleton, [&] {
+            return std::make_shared<AnimationClip>(_frames);
+        });
+        return std::make_shared<AnimationClip>(_frames);
+    });
+    QVERIFY(clip && otherClip);
+    QVERIFY(animationCache->getClip(otherKey, _skeleton, [] { return AnimationClip::Pointer(); }) == otherClip);
+
+    // nodes that build the same clip at once all end up with the one that was kept
+    const int NUM_THREADS = 4;
+    AnimationClip::Key raceKey { "race.fbx", "", 0.0f, 0, false };
+    std::atomic<int> numBuilds { 0 };
+    std::vector<AnimationClip::Pointer> clips(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&, i] {
+            clips[i] = animationCache->getClip(raceKey, _skeleton, [&] {
+                ++numBuilds;
+                return std::make_shared<AnimationClip>(_frames);
+            });
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    QVERIFY(numBuilds >= 1);
+    for (const auto& raceClip : clips) {
+        QVERIFY(raceClip && raceClip == clips[0]);
+    }
+}
+
+void AnimationClipTests::testCrowdMemory() {
+    // each AnimClip node used to keep the frames retargeted for its avatar
+    size_t framesSize = AnimationClip::getMemorySize(_frames);
+    size_t bytesPerAvatarBefore = NUM_CLIPS_PER_AVATAR * framesSize;
+
+    // now the avatars wearing the same skeleton share one compressed clip per state
+    auto animationCache = DependencyManager::get<AnimationCache>();
+    size_t clipsMemorySize = animationCache->getClipsMemorySize();
+    std::vector<AnimationClip::Pointer> clips;
+    for (int avatar = 0; avatar < NUM_AVATARS; ++avatar) {
+        for (int state = 0; state < NUM_CLIPS_PER_AVATAR; ++state) {
+            AnimationClip::Key key { QString("state%1.fbx").arg(state), "", 0.0f, 0, false };
+            clips.push_back(animationCache->getClip(key, _skeleton, [&] {
+                return std::make_shared<AnimationClip>(_frames);
+            }));
+        }
+    }
+    clipsMemorySize = animationCache->getClipsMemorySize() - clipsMemorySize;
+    size_t bytesPerAvatarAfter = clipsMemorySize / NUM_AVATARS;
+
+    qDebug() << NUM_AVATARS << "avatars," << NUM_CLIPS_PER_AVATAR << "clips of" << NUM_FRAMES << "frames each";
+    qDebug() << "bytes per avatar before:" << bytesPerAvatarBefore << "after:" << bytesPerAvatarAfter;
+    qDebug() << "bytes per clip before:" << framesSize << "after:" << clipsMemorySize / NUM_CLIPS_PER_AVATAR;
+
+    // compressing alone has to save most of the memory, sharing does the rest
+    QVERIFY(clipsMemorySize / NUM_CLIPS_PER_AVATAR < framesSize / 10);
+    QVERIFY(bytesPerAvatarAfter < bytesPerAvatarBefore / 100);
+}
+
+void AnimationClipTests::benchmarkSampling() {
+    AnimationClip clip(_frames);
+    AnimPoseVec poses;
+    int frame = 0;
+    QBENCHMARK {
+        clip.sample(frame, poses);
+        frame = (frame + 1) % NUM_FRAMES;
+    }
+}
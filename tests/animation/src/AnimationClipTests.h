@@ -0,0 +1,38 @@
+//
+//  AnimationClipTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimationClipTests_h
+#define hifi_AnimationClipTests_h
+
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <AnimSkeleton.h>
+
+// Compresses an animation retargeted to a humanoid skeleton, and shares it the way the AnimClip nodes of a crowd do
+class AnimationClipTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testSampling();
+    void testKeyReduction();
+    void testSharedClips();
+    void testConcurrentClips();
+    void testCrowdMemory();
+    void benchmarkSampling();
+
+private:
+    AnimSkeleton::Pointer _skeleton;
+    std::vector<AnimPoseVec> _frames;
+};
+
+#endif // hifi_AnimationClipTests_h
@@ -0,0 +1,126 @@
+//
+//  AvatarCrowdTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarCrowdTests.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <AnimSkeleton.h>
+#include <Rig.h>
+
+#include <test-utils/QTestExtensions.h>
+
+#include "TestSkeletons.h"
+
+QTEST_MAIN(AvatarCrowdTests)
+
+const int NUM_AVATARS = 100;
+
+static HFMModel crowdModel;
+
+static void makeJointData(QVector<JointData>& jointData, int numJoints, int avatar, int frame) {
+    jointData.resize(numJoints);
+    for (int i = 0; i < numJoints; ++i) {
+        float angle = 0.01f * (float)(avatar + frame + i);
+        jointData[i].rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, (float)(i % 3), 1.0f)));
+        jointData[i].rotationIsDefaultPose = false;
+        jointData[i].translation = glm::vec3(0.0f, 0.1f, 0.0f);
+        jointData[i].translationIsDefaultPose = (i % 2) == 0;
+    }
+}
+
+void AvatarCrowdTests::initTestCase() {
+    makeHumanoidSkeleton(crowdModel, "crowd.fbx");
+    for (int i = 0; i < NUM_AVATARS; ++i) {
+        auto rig = std::unique_ptr<Rig>(new Rig());
+        rig->initJointStates(crowdModel, glm::mat4());
+        _rigs.push_back(std::move(rig));
+        _jointData.emplace_back();
+    }
+}
+
+void AvatarCrowdTests::cleanupTestCase() {
+    _rigs.clear();
+    _jointData.clear();
+}
+
+void AvatarCrowdTests::testSharedSkeleton() {
+    for (const auto& rig : _rigs) {
+        QVERIFY(rig->getAnimSkeleton() == _rigs[0]->getAnimSkeleton());
+    }
+    QCOMPARE(_rigs[0]->getAnimSkeleton()->getNumJoints(), (int)crowdModel.joints.size());
+
+    // another model gets its own skeleton, which goes away with the last rig wearing it
+    size_t numSkeletons = AnimSkeleton::getNumSharedSkeletons();
+    {
+        HFMModel otherModel;
+        makeHumanoidSkeleton(otherModel, "other.fbx");
+        Rig otherRig;
+        otherRig.initJointStates(otherModel, glm::mat4());
+        QVERIFY(otherRig.getAnimSkeleton() != _rigs[0]->getAnimSkeleton());
+        QCOMPARE(AnimSkeleton::getNumSharedSkeletons(), numSkeletons + 1);
+    }
+    QCOMPARE(AnimSkeleton::getNumSharedSkeletons(), numSkeletons);
+}
+
+void AvatarCrowdTests::poseSerial(int frame) {
+    glm::mat4 rootTransform = glm::scale(glm::vec3(1.0f));
+    for (int i = 0; i < NUM_AVATARS; ++i) {
+        makeJointData(_jointData[i], (int)crowdModel.joints.size(), i, frame);
+        _rigs[i]->copyJointsFromJointData(_jointData[i]);
+        _rigs[i]->computeExternalPoses(rootTransform);
+    }
+}
+
+void AvatarCrowdTests::poseParallel(int frame) {
+    for (int i = 0; i < NUM_AVATARS; ++i) {
+        makeJointData(_jointData[i], (int)crowdModel.joints.size(), i, frame);
+    }
+    glm::mat4 rootTransform = glm::scale(glm::vec3(1.0f));
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _rigs.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            _rigs[i]->copyJointsFromJointData(_jointData[i]);
+            _rigs[i]->computeExternalPoses(rootTransform);
+        }
+    });
+}
+
+void AvatarCrowdTests::testParallelPosesMatchSerial() {
+    const int FRAME = 7;
+    poseSerial(FRAME);
+    std::vector<std::vector<glm::mat4>> serialTransforms(NUM_AVATARS);
+    for (int i = 0; i < NUM_AVATARS; ++i) {
+        for (int j = 0; j < _rigs[i]->getJointStateCount(); ++j) {
+            serialTransforms[i].push_back(_rigs[i]->getJointTransform(j));
+        }
+    }
+
+    poseParallel(FRAME);
+    for (int i = 0; i < NUM_AVATARS; ++i) {
+        for (int j = 0; j < _rigs[i]->getJointStateCount(); ++j) {
+            QVERIFY(_rigs[i]->getJointTransform(j) == serialTransforms[i][j]);
+        }
+    }
+}
+
+void AvatarCrowdTests::benchmarkSerial() {
+    int frame = 0;
+    QBENCHMARK {
+        poseSerial(frame++);
+    }
+}
+
+void AvatarCrowdTests::benchmarkParallel() {
+    int frame = 0;
+    QBENCHMARK {
+        poseParallel(frame++);
+    }
+}
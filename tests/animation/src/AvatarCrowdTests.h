@@ -0,0 +1,42 @@
+//
+//  AvatarCrowdTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarCrowdTests_h
+#define hifi_AvatarCrowdTests_h
+
+#include <memory>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <JointData.h>
+
+class Rig;
+
+// Poses the skeletons of a crowd of avatars from their joint data, the way the interface does for the avatars of others
+class AvatarCrowdTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testSharedSkeleton();
+    void testParallelPosesMatchSerial();
+    void benchmarkSerial();
+    void benchmarkParallel();
+
+private:
+    void poseSerial(int frame);
+    void poseParallel(int frame);
+
+    std::vector<std::unique_ptr<Rig>> _rigs;
+    std::vector<QVector<JointData>> _jointData;
+};
+
+#endif // hifi_AvatarCrowdTests_h
@@ -0,0 +1,77 @@
+//
+//  TestSkeletons.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TestSkeletons_h
+#define hifi_TestSkeletons_h
+
+#include <glm/gtx/transform.hpp>
+
+#include <hfm/HFM.h>
+#include <NumericalConstants.h>
+
+inline void addTestJoint(HFMModel& hfmModel, const QString& name, int parentIndex, const glm::vec3& translation) {
+    HFMJoint joint;
+    joint.isFree = false;
+    joint.parentIndex = parentIndex;
+    joint.distanceToParent = glm::length(translation);
+    joint.translation = translation;
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = glm::quat();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.rotationMin = glm::vec3(-PI);
+    joint.rotationMax = glm::vec3(PI);
+    joint.inverseDefaultRotation = glm::quat();
+    joint.inverseBindRotation = glm::quat();
+    joint.name = name;
+    joint.isSkeletonJoint = true;
+
+    glm::mat4 parentTransform = parentIndex >= 0 ? hfmModel.joints[parentIndex].transform : glm::mat4();
+    joint.transform = parentTransform * glm::translate(translation);
+    joint.bindTransform = joint.transform;
+    hfmModel.joints.push_back(joint);
+}
+
+inline int addTestChain(HFMModel& hfmModel, const QStringList& names, int parentIndex, const glm::vec3& translation) {
+    for (const auto& name : names) {
+        addTestJoint(hfmModel, name, parentIndex, translation);
+        parentIndex = (int)hfmModel.joints.size() - 1;
+    }
+    return parentIndex;
+}
+
+// A skeleton with about as many joints as the avatars people wear, fingers included
+inline void makeHumanoidSkeleton(HFMModel& hfmModel, const QString& url) {
+    hfmModel.originalURL = url;
+    addTestJoint(hfmModel, "Hips", -1, glm::vec3(0.0f, 1.0f, 0.0f));
+    int spine = addTestChain(hfmModel, { "Spine", "Spine1", "Spine2" }, 0, glm::vec3(0.0f, 0.1f, 0.0f));
+    int head = addTestChain(hfmModel, { "Neck", "Head" }, spine, glm::vec3(0.0f, 0.1f, 0.0f));
+    addTestJoint(hfmModel, "LeftEye", head, glm::vec3(0.03f, 0.1f, 0.1f));
+    addTestJoint(hfmModel, "RightEye", head, glm::vec3(-0.03f, 0.1f, 0.1f));
+
+    const QStringList FINGERS = { "Thumb", "Index", "Middle", "Ring", "Pinky" };
+    for (const QString& side : { QString("Left"), QString("Right") }) {
+        float direction = side == "Left" ? 1.0f : -1.0f;
+        int hand = addTestChain(hfmModel, { side + "Shoulder", side + "Arm", side + "ForeArm", side + "Hand" }, spine,
+                                glm::vec3(direction * 0.15f, 0.0f, 0.0f));
+        for (const auto& finger : FINGERS) {
+            QStringList names;
+            for (int i = 1; i <= 4; ++i) {
+                names << side + "Hand" + finger + QString::number(i);
+            }
+            addTestChain(hfmModel, names, hand, glm::vec3(direction * 0.02f, 0.0f, 0.0f));
+        }
+        addTestChain(hfmModel, { side + "UpLeg", side + "Leg", side + "Foot", side + "ToeBase", side + "Toe_End" }, 0,
+                     glm::vec3(direction * 0.1f, -0.2f, 0.0f));
+    }
+}
+
+#endif // hifi_TestSkeletons_h
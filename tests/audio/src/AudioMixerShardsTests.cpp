@@ -0,0 +1,153 @@
+//
+//  AudioMixerShardsTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerShardsTests.h"
+
+#include <QtCore/QJsonArray>
+
+#include <AudioMixerShards.h>
+
+QTEST_MAIN(AudioMixerShardsTests)
+
+const float BORDER_DISTANCE = 10.0f;
+
+static QJsonObject makeShard(float xMin, float xMax, float zMin, float zMax) {
+    // the settings table stores its cells as strings
+    QJsonObject shard;
+    shard["x_min"] = QString::number(xMin);
+    shard["x_max"] = QString::number(xMax);
+    shard["z_min"] = QString::number(zMin);
+    shard["z_max"] = QString::number(zMax);
+    return shard;
+}
+
+// The domain split in two along x = 0, and a third shard further away along z
+static QJsonObject makeSettings() {
+    QJsonArray shards;
+    shards.append(makeShard(-100.0f, 0.0f, -100.0f, 100.0f));
+    shards.append(makeShard(0.0f, 100.0f, -100.0f, 100.0f));
+    shards.append(makeShard(-100.0f, 100.0f, 200.0f, 300.0f));
+
+    QJsonObject sharding;
+    sharding["shards"] = shards;
+    sharding["border_distance"] = BORDER_DISTANCE;
+
+    QJsonObject settings;
+    settings["audio_sharding"] = sharding;
+    return settings;
+}
+
+static AudioMixerShards makeShards(int shard) {
+    AudioMixerShards shards;
+    shards.clear();
+    shards.setShard(shard);
+    shards.parseSettingsObject(makeSettings());
+    return shards;
+}
+
+void AudioMixerShardsTests::testParseSettings() {
+    auto shards = makeShards(1);
+    QCOMPARE(shards.getNumShards(), 3);
+    QCOMPARE(shards.getShard(), 1);
+    QVERIFY(shards.isEnabled());
+
+    // a mixer that wasn't deployed for a shard, or a domain that isn't sharded, mixes everyone
+    QVERIFY(!makeShards(AudioMixerShards::NO_SHARD).isEnabled());
+
+    AudioMixerShards unsharded;
+    unsharded.clear();
+    unsharded.setShard(0);
+    unsharded.parseSettingsObject(QJsonObject());
+    QVERIFY(!unsharded.isEnabled());
+    QCOMPARE(unsharded.getNumShards(), 0);
+}
+
+void AudioMixerShardsTests::testInvalidShard() {
+    auto settings = makeSettings();
+    auto sharding = settings["audio_sharding"].toObject();
+    auto shardsArray = sharding["shards"].toArray();
+    QJsonObject brokenShard = shardsArray[1].toObject();
+    brokenShard["x_max"] = QString("far");
+    shardsArray[1] = brokenShard;
+    sharding["shards"] = shardsArray;
+    settings["audio_sharding"] = sharding;
+
+    // the shards are numbered by their place in the list, so one broken entry disables sharding altogether
+    AudioMixerShards shards;
+    shards.clear();
+    shards.setShard(0);
+    shards.parseSettingsObject(settings);
+    QVERIFY(!shards.isEnabled());
+    QCOMPARE(shards.getNumShards(), 0);
+}
+
+void AudioMixerShardsTests::testShardForPosition() {
+    auto shards = makeShards(0);
+    QCOMPARE(shards.shardForPosition(glm::vec3(-50.0f, 0.0f, 0.0f)), 0);
+    QCOMPARE(shards.shardForPosition(glm::vec3(50.0f, 20.0f, 0.0f)), 1);
+    QCOMPARE(shards.shardForPosition(glm::vec3(0.0f, 0.0f, 250.0f)), 2);
+    QCOMPARE(shards.shardForPosition(glm::vec3(0.0f, 0.0f, 150.0f)), (int)AudioMixerShards::NO_SHARD);
+
+    // the height of a listener doesn't matter
+    QCOMPARE(shards.shardForPosition(glm::vec3(-50.0f, -1000.0f, 0.0f)), 0);
+}
+
+void AudioMixerShardsTests::testHandoff() {
+    auto shards = makeShards(0);
+
+    // listeners in the region, or just across its border, stay on this mixer
+    QCOMPARE(shards.handoffShardForPosition(glm::vec3(-50.0f, 0.0f, 0.0f)), (int)AudioMixerShards::NO_SHARD);
+    QCOMPARE(shards.handoffShardForPosition(glm::vec3(1.0f, 0.0f, 0.0f)), (int)AudioMixerShards::NO_SHARD);
+
+    // and are handed off once well into another one
+    QCOMPARE(shards.handoffShardForPosition(glm::vec3(5.0f, 0.0f, 0.0f)), 1);
+    QCOMPARE(shards.handoffShardForPosition(glm::vec3(0.0f, 0.0f, 250.0f)), 2);
+
+    // listeners outside of every region stay where they are
+    QCOMPARE(shards.handoffShardForPosition(glm::vec3(0.0f, 0.0f, 150.0f)), (int)AudioMixerShards::NO_SHARD);
+    QCOMPARE(shards.handoffShardForPosition(glm::vec3(-500.0f, 0.0f, 0.0f)), (int)AudioMixerShards::NO_SHARD);
+
+    // a mixer that isn't sharded hands nobody off
+    auto unsharded = makeShards(AudioMixerShards::NO_SHARD);
+    QCOMPARE(unsharded.handoffShardForPosition(glm::vec3(50.0f, 0.0f, 0.0f)), (int)AudioMixerShards::NO_SHARD);
+}
+
+void AudioMixerShardsTests::testPeersNear() {
+    auto shards = makeShards(0);
+    HifiSockAddr peer1(QHostAddress::LocalHost, 40001);
+    HifiSockAddr peer2(QHostAddress::LocalHost, 40002);
+    HifiSockAddr stranger(QHostAddress::LocalHost, 40003);
+    shards.setPeers({ { 1, peer1 }, { 2, peer2 } });
+
+    QVERIFY(shards.isPeer(peer1));
+    QVERIFY(shards.isPeer(peer2));
+    QVERIFY(!shards.isPeer(stranger));
+
+    auto peersNear = [&](const glm::vec3& position) {
+        std::vector<int> near;
+        shards.eachPeerNear(position, [&](const AudioMixerShards::Peer& peer) {
+            near.push_back(peer.shard);
+        });
+        return near;
+    };
+
+    // a listener in the middle of the region isn't heard by the other mixers
+    QVERIFY(peersNear(glm::vec3(-50.0f, 0.0f, 0.0f)).empty());
+
+    // one within the border distance of another region is forwarded to its mixer
+    QVERIFY(peersNear(glm::vec3(-5.0f, 0.0f, 0.0f)) == std::vector<int>{ 1 });
+    QVERIFY(peersNear(glm::vec3(-5.0f, 0.0f, 195.0f)) == (std::vector<int>{ 1, 2 }));
+    QVERIFY(peersNear(glm::vec3(-50.0f, 0.0f, 195.0f)) == std::vector<int>{ 2 });
+
+    // the peers are replaced when the domain-server sends new ones
+    shards.setPeers({ { 2, peer2 } });
+    QVERIFY(!shards.isPeer(peer1));
+    QVERIFY(peersNear(glm::vec3(-5.0f, 0.0f, 0.0f)).empty());
+}
@@ -0,0 +1,27 @@
+//
+//  AudioMixerShardsTests.h
+//  tests/audio/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerShardsTests_h
+#define hifi_AudioMixerShardsTests_h
+
+#include <QtTest/QtTest>
+
+// The regions of the audio-mixers of a sharded domain, which listeners they hand off and which streams they forward
+class AudioMixerShardsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testParseSettings();
+    void testInvalidShard();
+    void testShardForPosition();
+    void testHandoff();
+    void testPeersNear();
+};
+
+#endif // hifi_AudioMixerShardsTests_h
@@ -0,0 +1,232 @@
+//
+//  ModelBakerTests.cpp
+//  tests/baking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelBakerTests.h"
+
+#include <map>
+
+#include <tbb/task_arena.h>
+
+#include <FBXSerializer.h>
+#include <NumericalConstants.h>
+#include <model-baker/Baker.h>
+#include <model-baker/CoarseModel.h>
+#include <model-baker/ModelIO.h>
+
+QTEST_GUILESS_MAIN(ModelBakerTests)
+
+// Set HIFI_MODEL_BAKER_TEST_DIR to benchmark another set of models, such as a folder of avatars
+static const char* MODEL_DIR_ENV = "HIFI_MODEL_BAKER_TEST_DIR";
+
+static hfm::Model::Pointer readModel(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    return FBXSerializer().read(file.readAll(), hifi::VariantHash(), hifi::URL::fromLocalFile(path));
+}
+
+// Bakes the model, on a single thread if serial is set, and returns the run time in ms of every job and stage
+static std::map<std::string, double> bakeModel(const hfm::Model::Pointer& model, bool serial, hfm::Model::Pointer& bakedModel) {
+    baker::Baker baker(model, hifi::VariantHash(), hifi::URL());
+    if (serial) {
+        tbb::task_arena arena(1);
+        arena.execute([&] { baker.run(); });
+    } else {
+        baker.run();
+    }
+    bakedModel = baker.getHFMModel();
+
+    std::map<std::string, double> runTimes;
+    auto config = baker.getConfiguration();
+    runTimes["Baker"] = config->getCPURunTime();
+    for (auto jobConfig : config->findChildren<task::JobConfig*>()) {
+        runTimes[jobConfig->objectName().toStdString()] = jobConfig->getCPURunTime();
+    }
+    return runTimes;
+}
+
+void ModelBakerTests::initTestCase() {
+    QStringList directories;
+    if (qEnvironmentVariableIsSet(MODEL_DIR_ENV)) {
+        directories << qEnvironmentVariable(MODEL_DIR_ENV);
+    } else {
+        QDir root = QFileInfo(__FILE__).absoluteDir();
+        root.cd("../../..");
+        directories << root.absoluteFilePath("scripts") << root.absoluteFilePath("unpublishedScripts");
+    }
+
+    for (const auto& directory : directories) {
+        QDirIterator it(directory, { "*.fbx" }, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            _modelFiles << it.next();
+        }
+    }
+    qInfo() << "Found" << _modelFiles.size() << "FBX files";
+}
+
+void ModelBakerTests::testParallelMatchesSerial() {
+    for (const auto& path : _modelFiles) {
+        auto serialModel = readModel(path);
+        auto parallelModel = readModel(path);
+        if (!serialModel || !parallelModel) {
+            continue;
+        }
+
+        hfm::Model::Pointer serialBaked, parallelBaked;
+        bakeModel(serialModel, true, serialBaked);
+        bakeModel(parallelModel, false, parallelBaked);
+        QVERIFY(serialBaked && parallelBaked);
+
+        QCOMPARE(parallelBaked->meshes.size(), serialBaked->meshes.size());
+        for (size_t i = 0; i < serialBaked->meshes.size(); ++i) {
+            const auto& serialMesh = serialBaked->meshes[i];
+            const auto& parallelMesh = parallelBaked->meshes[i];
+            QCOMPARE(parallelMesh.normals, serialMesh.normals);
+            QCOMPARE(parallelMesh.tangents, serialMesh.tangents);
+            QCOMPARE(parallelMesh.blendshapes.size(), serialMesh.blendshapes.size());
+            for (int j = 0; j < serialMesh.blendshapes.size(); ++j) {
+                QCOMPARE(parallelMesh.blendshapes[j].normals, serialMesh.blendshapes[j].normals);
+                QCOMPARE(parallelMesh.blendshapes[j].tangents, serialMesh.blendshapes[j].tangents);
+            }
+            QCOMPARE((bool)parallelMesh._mesh, (bool)serialMesh._mesh);
+        }
+        QCOMPARE(parallelBaked->shapeVertices.size(), serialBaked->shapeVertices.size());
+    }
+}
+
+void ModelBakerTests::benchmarkTasks() {
+    std::map<std::string, double> serialTimes;
+    std::map<std::string, double> parallelTimes;
+    size_t numModels = 0;
+
+    for (const auto& path : _modelFiles) {
+        auto serialModel = readModel(path);
+        auto parallelModel = readModel(path);
+        if (!serialModel || !parallelModel) {
+            continue;
+        }
+        ++numModels;
+
+        hfm::Model::Pointer bakedModel;
+        for (const auto& runTime : bakeModel(serialModel, true, bakedModel)) {
+            serialTimes[runTime.first] += runTime.second;
+        }
+        for (const auto& runTime : bakeModel(parallelModel, false, bakedModel)) {
+            parallelTimes[runTime.first] += runTime.second;
+        }
+    }
+    QVERIFY(numModels > 0);
+
+    qInfo() << "Baked" << numModels << "models on" << tbb::this_task_arena::max_concurrency() << "threads";
+    qInfo().noquote() << QString("%1 %2 %3 %4").arg("job", -40).arg("serial ms", 12).arg("parallel ms", 12).arg("speedup", 8);
+    for (const auto& serialTime : serialTimes) {
+        double parallelTime = parallelTimes[serialTime.first];
+        double speedup = parallelTime > 0.0 ? serialTime.second / parallelTime : 0.0;
+        qInfo().noquote() << QString("%1 %2 %3 %4").arg(QString::fromStdString(serialTime.first), -40)
+            .arg(serialTime.second, 12, 'f', 2).arg(parallelTime, 12, 'f', 2).arg(speedup, 8, 'f', 2);
+    }
+}
+
+void ModelBakerTests::testBakedModelRoundTrip() {
+    double bakeTime = 0.0;
+    double restoreTime = 0.0;
+    size_t numModels = 0;
+
+    for (const auto& path : _modelFiles) {
+        auto model = readModel(path);
+        if (!model) {
+            continue;
+        }
+        ++numModels;
+
+        QElapsedTimer timer;
+        timer.start();
+        hfm::Model::Pointer bakedModel;
+        bakeModel(model, false, bakedModel);
+        bakeTime += timer.nsecsElapsed() / (double)NSECS_PER_MSEC;
+        QVERIFY(bakedModel);
+
+        auto data = baker::writeModel(*bakedModel);
+        timer.restart();
+        auto restoredModel = baker::readModel(data);
+        QVERIFY(restoredModel);
+        baker::Baker::restoreBakedModel(restoredModel, hifi::VariantHash(), hifi::URL());
+        restoreTime += timer.nsecsElapsed() / (double)NSECS_PER_MSEC;
+
+        // what was read back writes the same, and has its graphics meshes built again
+        QCOMPARE(baker::writeModel(*restoredModel), data);
+        QCOMPARE(restoredModel->meshes.size(), bakedModel->meshes.size());
+        for (size_t i = 0; i < bakedModel->meshes.size(); ++i) {
+            QCOMPARE((bool)restoredModel->meshes[i]._mesh, (bool)bakedModel->meshes[i]._mesh);
+            if (bakedModel->meshes[i]._mesh) {
+                QCOMPARE(restoredModel->meshes[i]._mesh->getNumVertices(), bakedModel->meshes[i]._mesh->getNumVertices());
+                QCOMPARE(restoredModel->meshes[i]._mesh->getNumIndices(), bakedModel->meshes[i]._mesh->getNumIndices());
+            }
+        }
+        QCOMPARE(restoredModel->materials.size(), bakedModel->materials.size());
+        for (size_t i = 0; i < bakedModel->materials.size(); ++i) {
+            const auto& bakedMaterial = bakedModel->materials[i]._material;
+            const auto& restoredMaterial = restoredModel->materials[i]._material;
+            QCOMPARE((bool)restoredMaterial, (bool)bakedMaterial);
+            if (bakedMaterial) {
+                QCOMPARE(restoredMaterial->getKey()._flags.to_ulong(), bakedMaterial->getKey()._flags.to_ulong());
+            }
+        }
+    }
+    QVERIFY(numModels > 0);
+
+    qInfo() << "Baked" << numModels << "models in" << bakeTime << "ms, restored them from the cache format in" << restoreTime << "ms";
+}
+
+void ModelBakerTests::testCoarseModel() {
+    size_t numTriangles = 0;
+    size_t numCoarseTriangles = 0;
+
+    for (const auto& path : _modelFiles) {
+        auto model = readModel(path);
+        if (!model) {
+            continue;
+        }
+
+        auto coarseModel = baker::makeCoarseModel(*model);
+        QVERIFY(coarseModel);
+        numTriangles += baker::countTriangles(*model);
+        numCoarseTriangles += baker::countTriangles(*coarseModel);
+
+        // the stand-in has the structure of the model, with fewer vertices and only triangles
+        QCOMPARE(coarseModel->meshes.size(), model->meshes.size());
+        QCOMPARE(coarseModel->joints.size(), model->joints.size());
+        QCOMPARE(coarseModel->shapes.size(), model->shapes.size());
+        QCOMPARE(coarseModel->materials.size(), model->materials.size());
+        for (size_t i = 0; i < model->meshes.size(); ++i) {
+            const auto& mesh = model->meshes[i];
+            const auto& coarseMesh = coarseModel->meshes[i];
+            QCOMPARE(coarseMesh.parts.size(), mesh.parts.size());
+            QVERIFY(coarseMesh.vertices.size() <= mesh.vertices.size());
+            QVERIFY(coarseMesh.clusterIndices.size() <= mesh.clusterIndices.size());
+            for (const auto& part : coarseMesh.parts) {
+                QVERIFY(part.quadIndices.empty());
+                QVERIFY(part.quadTrianglesIndices.empty());
+                for (int index : part.triangleIndices) {
+                    QVERIFY(index >= 0 && index < coarseMesh.vertices.size());
+                }
+            }
+        }
+
+        hfm::Model::Pointer bakedModel;
+        bakeModel(coarseModel, false, bakedModel);
+        QVERIFY(bakedModel);
+        QCOMPARE(bakedModel->meshes.size(), model->meshes.size());
+    }
+
+    QVERIFY(numCoarseTriangles <= numTriangles);
+    qInfo() << "Coarse models have" << numCoarseTriangles << "of" << numTriangles << "triangles";
+}
@@ -0,0 +1,384 @@
+//
+//  FBXParserTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXParserTests.h"
+
+#include <FBXSerializer.h>
+#include <FBXWriter.h>
+
+QTEST_GUILESS_MAIN(FBXParserTests)
+
+// Set HIFI_FBX_TEST_DIR to benchmark another set of models, such as a folder of avatars
+static const char* FBX_DIR_ENV = "HIFI_FBX_TEST_DIR";
+
+template <typename T>
+static bool compareArrays(const QVariant& a, const QVariant& b) {
+    return a.value<QVector<T>>() == b.value<QVector<T>>();
+}
+
+static bool compareProperties(const QVariant& a, const QVariant& b) {
+    if (a.userType() != b.userType()) {
+        return false;
+    }
+    // the arrays are registered metatypes without comparators, so QVariant can't compare them itself
+    const int type = a.userType();
+    if (type == qMetaTypeId<QVector<float>>()) {
+        return compareArrays<float>(a, b);
+    } else if (type == qMetaTypeId<QVector<double>>()) {
+        return compareArrays<double>(a, b);
+    } else if (type == qMetaTypeId<QVector<qint64>>()) {
+        return compareArrays<qint64>(a, b);
+    } else if (type == qMetaTypeId<QVector<qint32>>()) {
+        return compareArrays<qint32>(a, b);
+    } else if (type == qMetaTypeId<QVector<bool>>()) {
+        return compareArrays<bool>(a, b);
+    }
+    return a == b;
+}
+
+// Compares the trees node for node, and answers the path to the first node that differs, or an empty string
+static QString compareNodes(const FBXNode& a, const FBXNode& b, const QString& path = QString()) {
+    const QString nodePath = path + "/" + a.name;
+    if (a.name != b.name) {
+        return nodePath + " is named " + b.name;
+    }
+    if (a.properties.size() != b.properties.size()) {
+        return nodePath + " has " + QString::number(b.properties.size()) + " properties instead of " +
+            QString::number(a.properties.size());
+    }
+    for (int i = 0; i < a.properties.size(); ++i) {
+        if (!compareProperties(a.properties[i], b.properties[i])) {
+            return nodePath + " property " + QString::number(i) + " differs";
+        }
+    }
+    if (a.children.size() != b.children.size()) {
+        return nodePath + " has " + QString::number(b.children.size()) + " children instead of " +
+            QString::number(a.children.size());
+    }
+    for (int i = 0; i < a.children.size(); ++i) {
+        QString difference = compareNodes(a.children[i], b.children[i], nodePath);
+        if (!difference.isEmpty()) {
+            return difference;
+        }
+    }
+    return QString();
+}
+
+template <typename T>
+static QString dumpArray(const QVariant& property, int precision) {
+    QStringList values;
+    for (T value : property.value<QVector<T>>()) {
+        values << QString::number(value, 'g', precision);
+    }
+    return "[" + values.join(',') + "]";
+}
+
+template <typename T>
+static QString dumpIntegerArray(const QVariant& property) {
+    QStringList values;
+    for (T value : property.value<QVector<T>>()) {
+        values << QString::number(value);
+    }
+    return "[" + values.join(',') + "]";
+}
+
+// One property of a node as it is in golden_fbx.txt, with the type it was read as and the strings percent-encoded
+static QString dumpProperty(const QVariant& property) {
+    const int FLOAT_DIGITS = 9;
+    const int DOUBLE_DIGITS = 17;
+    const int type = property.userType();
+    switch (type) {
+        case QMetaType::Short:
+            return "Y:" + QString::number(property.value<qint16>());
+        case QMetaType::Bool:
+            return QString("C:") + (property.toBool() ? "1" : "0");
+        case QMetaType::Int:
+            return "I:" + QString::number(property.toInt());
+        case QMetaType::Float:
+            return "F:" + QString::number(property.toFloat(), 'g', FLOAT_DIGITS);
+        case QMetaType::Double:
+            return "D:" + QString::number(property.toDouble(), 'g', DOUBLE_DIGITS);
+        case QMetaType::LongLong:
+            return "L:" + QString::number(property.toLongLong());
+        case QMetaType::QByteArray:
+            return "S:" + QString::fromLatin1(property.toByteArray().toPercentEncoding());
+        default:
+            break;
+    }
+    if (type == qMetaTypeId<QVector<float>>()) {
+        return "f" + dumpArray<float>(property, FLOAT_DIGITS);
+    } else if (type == qMetaTypeId<QVector<double>>()) {
+        return "d" + dumpArray<double>(property, DOUBLE_DIGITS);
+    } else if (type == qMetaTypeId<QVector<qint64>>()) {
+        return "l" + dumpIntegerArray<qint64>(property);
+    } else if (type == qMetaTypeId<QVector<qint32>>()) {
+        return "i" + dumpIntegerArray<qint32>(property);
+    } else if (type == qMetaTypeId<QVector<bool>>()) {
+        // read as bytes, so a bool that isn't 0 or 1 shows
+        QStringList values;
+        for (const bool& value : property.value<QVector<bool>>()) {
+            values << QString::number(*reinterpret_cast<const quint8*>(&value));
+        }
+        return "b[" + values.join(',') + "]";
+    }
+    return "?";
+}
+
+// A text dump of the tree, a node a line indented by its depth
+static QString dumpNodes(const FBXNodeList& nodes, int depth = 0) {
+    QString dump;
+    for (const auto& node : nodes) {
+        dump += QString(depth * 2, ' ') + QString::fromLatin1(node.name);
+        for (const auto& property : node.properties) {
+            dump += " " + dumpProperty(property);
+        }
+        dump += "\n" + dumpNodes(node.children, depth + 1);
+    }
+    return dump;
+}
+
+static FBXNode parse(const QByteArray& data, bool decodeGeometryArrays = false) {
+    QBuffer buffer(const_cast<QByteArray*>(&data));
+    buffer.open(QIODevice::ReadOnly);
+    return FBXSerializer::parseFBX(&buffer, decodeGeometryArrays);
+}
+
+static void verifySameTree(const FBXNode& expected, const FBXNode& actual, const QString& path) {
+    QString difference = compareNodes(expected, actual);
+    QVERIFY2(difference.isEmpty(), qPrintable(path + ": " + difference));
+}
+
+static QByteArray readFile(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+static const FBXNode* findChild(const FBXNode& node, const QByteArray& name, int index = 0) {
+    for (const auto& child : node.children) {
+        if (child.name == name && index-- == 0) {
+            return &child;
+        }
+    }
+    return nullptr;
+}
+
+// Peak resident memory of the process in KB, or 0 where it can't be measured
+static qint64 getPeakMemory() {
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        for (const auto& line : status.readAll().split('\n')) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ')[0].toLongLong();
+            }
+        }
+    }
+#endif
+    return 0;
+}
+
+static void resetPeakMemory() {
+#ifdef Q_OS_LINUX
+    QFile clearRefs("/proc/self/clear_refs");
+    if (clearRefs.open(QIODevice::WriteOnly)) {
+        clearRefs.write("5");
+    }
+#endif
+}
+
+void FBXParserTests::initTestCase() {
+    QStringList directories;
+    if (qEnvironmentVariableIsSet(FBX_DIR_ENV)) {
+        directories << qEnvironmentVariable(FBX_DIR_ENV);
+    } else {
+        QDir root = QFileInfo(__FILE__).absoluteDir();
+        root.cd("../../..");
+        directories << root.absoluteFilePath("scripts") << root.absoluteFilePath("unpublishedScripts");
+    }
+
+    for (const auto& directory : directories) {
+        QDirIterator it(directory, { "*.fbx" }, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            QString path = it.next();
+            QFile file(path);
+            if (file.open(QIODevice::ReadOnly) && file.peek(FBX_BINARY_PROLOG.size()) == FBX_BINARY_PROLOG) {
+                _binaryFiles << path;
+            }
+        }
+    }
+    qInfo() << "Found" << _binaryFiles.size() << "binary FBX files";
+}
+
+void FBXParserTests::testGolden() {
+    // golden_fbx.txt lists the nodes golden.fbx was written with, which has arrays of every type, plain and compressed,
+    // bools other than 0 and 1, and every other kind of property
+    const QDir data = QFileInfo(__FILE__).absoluteDir().absoluteFilePath("data");
+    const QByteArray model = readFile(data.absoluteFilePath("golden.fbx"));
+    const QString golden = readFile(data.absoluteFilePath("golden_fbx.txt"));
+    QVERIFY(!model.isEmpty());
+    QVERIFY(!golden.isEmpty());
+
+    FBXNode root = parse(model);
+    QCOMPARE(dumpNodes(root.children), golden);
+
+    // and the same once FBXWriter wrote it back out
+    QCOMPARE(dumpNodes(parse(FBXWriter::encodeFBX(root)).children), golden);
+}
+
+void FBXParserTests::testGeometryArrays() {
+    const QDir data = QFileInfo(__FILE__).absoluteDir().absoluteFilePath("data");
+    const QByteArray model = readFile(data.absoluteFilePath("golden.fbx"));
+    FBXNode root = parse(model, true);
+
+    const FBXNode* objects = findChild(root, "Objects");
+    QVERIFY(objects);
+    const FBXNode* mesh = findChild(*objects, "Geometry", 0);
+    const FBXNode* shape = findChild(*objects, "Geometry", 1);
+    QVERIFY(mesh && mesh->geometryArrays);
+    QVERIFY(shape && shape->geometryArrays);
+    QVERIFY(!findChild(*objects, "Model")->geometryArrays);
+
+    // the nodes that only held the arrays are gone, the rest of the tree is as it was
+    QVERIFY(!findChild(*mesh, "Vertices"));
+    QVERIFY(!findChild(*mesh, "PolygonVertexIndex"));
+    const FBXNode* normalLayer = findChild(*mesh, "LayerElementNormal");
+    QVERIFY(normalLayer && findChild(*normalLayer, "MappingInformationType") && !findChild(*normalLayer, "Normals"));
+    const FBXNode* uvLayer = findChild(*mesh, "LayerElementUV");
+    QVERIFY(uvLayer && findChild(*uvLayer, "Name") && !findChild(*uvLayer, "UV") && !findChild(*uvLayer, "UVIndex"));
+    QVERIFY(findChild(*findChild(*mesh, "LayerElementVisibility"), "Visibility"));
+    QCOMPARE(shape->children.size(), 1);
+
+    const auto& arrays = *mesh->geometryArrays;
+    QVERIFY(arrays.vertices == QVector<glm::vec3>({ { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } }));
+    QCOMPARE(arrays.polygonIndices, QVector<int>({ 0, 1, 2, -4 }));
+    QCOMPARE((int)arrays.normalLayers.size(), 1);
+    QVERIFY(arrays.normalLayers[0].values == QVector<glm::vec3>(4, glm::vec3(0, 0, 1)));
+    QVERIFY(arrays.normalLayers[0].indices.isEmpty());
+    // the texture coordinates are flipped like the ones from the tree are
+    QCOMPARE((int)arrays.uvLayers.size(), 2);
+    QVERIFY(arrays.uvLayers[0].values == QVector<glm::vec2>({ { 0, 0 }, { 1, 0 }, { 1, -0.5f }, { 0, -0.5f } }));
+    QCOMPARE(arrays.uvLayers[0].indices, QVector<int>({ 0, 1, 2, 3 }));
+    QVERIFY(arrays.uvLayers[1].values ==
+        QVector<glm::vec2>({ { 0.25f, -0.25f }, { 0.75f, -0.25f }, { 0.75f, -0.75f }, { 0.25f, -0.75f } }));
+    QVERIFY(arrays.uvLayers[1].indices.isEmpty());
+
+    const auto& shapeArrays = *shape->geometryArrays;
+    QCOMPARE(shapeArrays.indexes, QVector<int>({ 1, 2 }));
+    QVERIFY(shapeArrays.vertices == QVector<glm::vec3>(2, glm::vec3(0, 0, 0.5f)));
+    QVERIFY(shapeArrays.normals == QVector<glm::vec3>(2, glm::vec3(0)));
+}
+
+static HFMModel::Pointer read(const QByteArray& data, bool decodeGeometryArrays) {
+    FBXSerializer serializer;
+    serializer._decodeGeometryArrays = decodeGeometryArrays;
+    return serializer.read(data, hifi::VariantHash());
+}
+
+static void verifySameModel(const HFMModel& expected, const HFMModel& actual, const QString& path) {
+    QVERIFY2(actual.meshes.size() == expected.meshes.size(), qPrintable(path));
+    for (size_t i = 0; i < expected.meshes.size(); ++i) {
+        const auto& expectedMesh = expected.meshes[i];
+        const auto& actualMesh = actual.meshes[i];
+        QVERIFY2(actualMesh.vertices == expectedMesh.vertices, qPrintable(path));
+        QVERIFY2(actualMesh.normals == expectedMesh.normals, qPrintable(path));
+        QVERIFY2(actualMesh.texCoords == expectedMesh.texCoords, qPrintable(path));
+        QVERIFY2(actualMesh.texCoords1 == expectedMesh.texCoords1, qPrintable(path));
+        QVERIFY2(actualMesh.blendshapes.size() == expectedMesh.blendshapes.size(), qPrintable(path));
+        for (int j = 0; j < expectedMesh.blendshapes.size(); ++j) {
+            QVERIFY2(actualMesh.blendshapes[j].indices == expectedMesh.blendshapes[j].indices, qPrintable(path));
+            QVERIFY2(actualMesh.blendshapes[j].vertices == expectedMesh.blendshapes[j].vertices, qPrintable(path));
+            QVERIFY2(actualMesh.blendshapes[j].normals == expectedMesh.blendshapes[j].normals, qPrintable(path));
+        }
+        QVERIFY2(actualMesh.parts.size() == expectedMesh.parts.size(), qPrintable(path));
+        for (size_t j = 0; j < expectedMesh.parts.size(); ++j) {
+            QVERIFY2(actualMesh.parts[j].triangleIndices == expectedMesh.parts[j].triangleIndices, qPrintable(path));
+            QVERIFY2(actualMesh.parts[j].quadIndices == expectedMesh.parts[j].quadIndices, qPrintable(path));
+        }
+    }
+}
+
+void FBXParserTests::testDecodedModels() {
+    // the models are built the same from the geometry arrays as from the nodes that held them
+    QStringList paths = _binaryFiles;
+    paths.prepend(QFileInfo(__FILE__).absoluteDir().absoluteFilePath("data/golden.fbx"));
+    for (const auto& path : paths) {
+        const QByteArray data = readFile(path);
+        HFMModel::Pointer expected;
+        try {
+            expected = read(data, false);
+        } catch (const QString& error) {
+            qWarning() << path << error;
+            continue;
+        }
+        HFMModel::Pointer actual = read(data, true);
+        QVERIFY(expected && actual);
+        verifySameModel(*expected, *actual, path);
+    }
+}
+
+void FBXParserTests::testRoundTrip() {
+    for (const auto& path : _binaryFiles) {
+        const QByteArray data = readFile(path);
+
+        // FBXWriter compresses every array that shrinks, so this covers both the plain and the compressed arrays
+        FBXNode original = parse(data);
+        QVERIFY(!original.children.isEmpty());
+        FBXNode reparsed = parse(FBXWriter::encodeFBX(original));
+        verifySameTree(original, reparsed, path + " rewritten");
+    }
+}
+
+void FBXParserTests::benchmarkParse() {
+    qint64 totalBytes = 0;
+    qint64 totalParseNs = 0;
+    qint64 totalReadNs = 0;
+
+    qInfo().noquote() << QString("%1 %2 %3 %4 %5").arg("file", -40).arg("MB", 8).arg("parse ms", 10).arg("read ms", 10).arg("peak/size", 10);
+    for (const auto& path : _binaryFiles) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        const QByteArray data = file.readAll();
+
+        resetPeakMemory();
+        const qint64 baseMemory = getPeakMemory();
+
+        QElapsedTimer timer;
+        timer.start();
+        FBXNode root = parse(data);
+        const qint64 parseNs = timer.nsecsElapsed();
+        QVERIFY(!root.children.isEmpty());
+
+        timer.restart();
+        try {
+            FBXSerializer().read(data, hifi::VariantHash(), QUrl::fromLocalFile(path));
+        } catch (const QString& error) {
+            qWarning() << path << error;
+        }
+        const qint64 readNs = timer.nsecsElapsed();
+
+        // the peak over the file it was parsed from
+        const qint64 peakMemory = getPeakMemory() - baseMemory;
+        const double peakRatio = peakMemory > 0 ? (peakMemory * 1024.0) / data.size() : 0.0;
+
+        qInfo().noquote() << QString("%1 %2 %3 %4 %5").arg(QFileInfo(path).fileName(), -40).arg(data.size() / 1.0e6, 8, 'f', 2)
+            .arg(parseNs / 1.0e6, 10, 'f', 2).arg(readNs / 1.0e6, 10, 'f', 2).arg(peakRatio, 10, 'f', 2);
+        totalBytes += data.size();
+        totalParseNs += parseNs;
+        totalReadNs += readNs;
+    }
+
+    if (totalParseNs > 0) {
+        qInfo() << "Parsed" << totalBytes / 1.0e6 << "MB at" << (totalBytes / 1.0e6) / (totalParseNs / 1.0e9) << "MB/s, read into models at"
+            << (totalBytes / 1.0e6) / (totalReadNs / 1.0e9) << "MB/s";
+    }
+}
@@ -0,0 +1,210 @@
+//
+//  GLTFSerializerTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GLTFSerializerTests.h"
+
+#include <QtEndian>
+
+#include <GLTFSerializer.h>
+#include <ResourceManager.h>
+
+QTEST_GUILESS_MAIN(GLTFSerializerTests)
+
+// The quad in data/quad*.gltf and data/quad_interleaved.glb, with the same vertices however they are laid out
+static const std::vector<glm::vec3> QUAD_POSITIONS {
+    { -1.0f, -1.0f, 0.5f }, { 1.0f, -1.0f, 0.25f }, { 1.0f, 1.0f, -0.5f }, { -1.0f, 1.0f, 0.0f }
+};
+static const std::vector<glm::vec3> QUAD_NORMALS {
+    { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.6f, 0.8f }, { 0.6f, 0.0f, 0.8f }, { 0.0f, -0.6f, 0.8f }
+};
+static const std::vector<glm::vec2> QUAD_TEX_COORDS {
+    { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }
+};
+static const QVector<int> QUAD_INDICES { 0, 1, 2, 0, 2, 3 };
+
+static QByteArray readFile(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+static QString getDataPath(const QString& name) {
+    return QFileInfo(__FILE__).absoluteDir().absoluteFilePath("data/" + name);
+}
+
+// The serializer tells a .glb by the end of its url
+static HFMModel::Pointer read(const QByteArray& data, const QString& name) {
+    return GLTFSerializer().read(data, hifi::VariantHash(), QUrl::fromLocalFile(getDataPath(name)));
+}
+
+static HFMModel::Pointer readFixture(const QString& name) {
+    QByteArray data = readFile(getDataPath(name));
+    if (data.isEmpty()) {
+        return nullptr;
+    }
+    return read(data, name);
+}
+
+static void verifyQuad(const HFMModel::Pointer& model) {
+    QVERIFY(model);
+    QCOMPARE((int)model->meshes.size(), 1);
+    const auto& mesh = model->meshes[0];
+    QCOMPARE(mesh.vertices.size(), (int)QUAD_POSITIONS.size());
+    QCOMPARE(mesh.normals.size(), (int)QUAD_NORMALS.size());
+    QCOMPARE(mesh.texCoords.size(), (int)QUAD_TEX_COORDS.size());
+    for (size_t i = 0; i < QUAD_POSITIONS.size(); ++i) {
+        QCOMPARE(mesh.vertices[(int)i], QUAD_POSITIONS[i]);
+        QCOMPARE(mesh.normals[(int)i], QUAD_NORMALS[i]);
+        QCOMPARE(mesh.texCoords[(int)i], QUAD_TEX_COORDS[i]);
+    }
+    QCOMPARE((int)mesh.parts.size(), 1);
+    QCOMPARE(mesh.parts[0].triangleIndices, QUAD_INDICES);
+}
+
+// A .glb of a JSON chunk and a BIN chunk, each padded to 4 bytes
+static QByteArray makeGLB(const QByteArray& json, const QByteArray& binary) {
+    const quint32 GLB_VERSION = 2;
+    const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+
+    QByteArray paddedJSON = json;
+    while (paddedJSON.size() % 4 != 0) {
+        paddedJSON.append(' ');
+    }
+    QByteArray paddedBinary = binary;
+    while (paddedBinary.size() % 4 != 0) {
+        paddedBinary.append('\0');
+    }
+
+    QByteArray glb;
+    auto appendUInt32 = [&](quint32 value) {
+        quint32 littleEndian = qToLittleEndian(value);
+        glb.append((const char*)&littleEndian, sizeof(littleEndian));
+    };
+    glb.append("glTF");
+    appendUInt32(GLB_VERSION);
+    appendUInt32(12 + 8 + paddedJSON.size() + 8 + paddedBinary.size());
+    appendUInt32(paddedJSON.size());
+    appendUInt32(GLB_CHUNK_TYPE_JSON);
+    glb.append(paddedJSON);
+    appendUInt32(paddedBinary.size());
+    appendUInt32(GLB_CHUNK_TYPE_BIN);
+    glb.append(paddedBinary);
+    return glb;
+}
+
+// A grid of about as many vertices as an avatar, interleaved the way most exporters write them
+static QByteArray makeGridGLB(int gridSize) {
+    QByteArray binary;
+    for (int y = 0; y < gridSize; ++y) {
+        for (int x = 0; x < gridSize; ++x) {
+            float vertex[8] = { (float)x, (float)y, 0.0f, 0.0f, 0.0f, 1.0f, (float)x / gridSize, (float)y / gridSize };
+            binary.append((const char*)vertex, sizeof(vertex));
+        }
+    }
+    int vertexBytes = binary.size();
+    int numIndices = 0;
+    for (int y = 0; y + 1 < gridSize; ++y) {
+        for (int x = 0; x + 1 < gridSize; ++x) {
+            quint32 corner = (quint32)(y * gridSize + x);
+            quint32 quad[6] = { corner, corner + 1, corner + gridSize + 1, corner, corner + gridSize + 1, corner + gridSize };
+            binary.append((const char*)quad, sizeof(quad));
+            numIndices += 6;
+        }
+    }
+    int numVertices = gridSize * gridSize;
+
+    QString json = QString(R"({
+        "asset": { "version": "2.0" },
+        "scene": 0, "scenes": [ { "nodes": [ 0 ] } ], "nodes": [ { "mesh": 0 } ],
+        "materials": [ { "name": "grid" } ],
+        "meshes": [ { "primitives": [ { "attributes": { "POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2 }, "indices": 3, "material": 0 } ] } ],
+        "buffers": [ { "byteLength": %1 } ],
+        "bufferViews": [
+            { "buffer": 0, "byteOffset": 0, "byteLength": %2, "byteStride": 32 },
+            { "buffer": 0, "byteOffset": %2, "byteLength": %3 }
+        ],
+        "accessors": [
+            { "bufferView": 0, "byteOffset": 0, "componentType": 5126, "count": %4, "type": "VEC3" },
+            { "bufferView": 0, "byteOffset": 12, "componentType": 5126, "count": %4, "type": "VEC3" },
+            { "bufferView": 0, "byteOffset": 24, "componentType": 5126, "count": %4, "type": "VEC2" },
+            { "bufferView": 1, "componentType": 5125, "count": %5, "type": "SCALAR" }
+        ]
+    })").arg(binary.size()).arg(vertexBytes).arg(binary.size() - vertexBytes).arg(numVertices).arg(numIndices);
+    return makeGLB(json.toUtf8(), binary);
+}
+
+void GLTFSerializerTests::initTestCase() {
+    // the fixtures embed their buffers, nothing is fetched
+    DependencyManager::set<ResourceManager>(false);
+}
+
+void GLTFSerializerTests::cleanupTestCase() {
+    DependencyManager::get<ResourceManager>()->cleanup();
+    DependencyManager::destroy<ResourceManager>();
+}
+
+void GLTFSerializerTests::testPackedAccessors() {
+    // each attribute in a buffer view of its own, copied in one go
+    verifyQuad(readFixture("quad.gltf"));
+}
+
+void GLTFSerializerTests::testInterleavedAccessors() {
+    // the position, normal and texture coordinates of each vertex side by side, 32 bytes apart
+    verifyQuad(readFixture("quad_interleaved.gltf"));
+}
+
+void GLTFSerializerTests::testGLBChunks() {
+    // the interleaved quad with its buffer in the BIN chunk
+    verifyQuad(readFixture("quad_interleaved.glb"));
+
+    // chunks of other types are skipped
+    QByteArray glb = readFile(getDataPath("quad_interleaved.glb"));
+    QVERIFY(!glb.isEmpty());
+    quint32 jsonLength = qFromLittleEndian<quint32>(glb.constData() + 12);
+    QByteArray json = glb.mid(20, (int)jsonLength);
+    QByteArray binary = glb.mid(20 + (int)jsonLength + 8);
+    QByteArray withExtraChunk = makeGLB(json, binary);
+    const quint32 GLB_CHUNK_TYPE_EXTRA = 0x41524558;
+    quint32 extraHeader[2] = { qToLittleEndian<quint32>(4), qToLittleEndian<quint32>(GLB_CHUNK_TYPE_EXTRA) };
+    withExtraChunk.insert(12, QByteArray((const char*)extraHeader, sizeof(extraHeader)) + QByteArray("xxxx"));
+    qToLittleEndian<quint32>((quint32)withExtraChunk.size(), withExtraChunk.data() + 8);
+    verifyQuad(read(withExtraChunk, "quad_interleaved.glb"));
+}
+
+void GLTFSerializerTests::testTruncatedData() {
+    // a BIN chunk cut short is dropped, and with it the buffer
+    QByteArray glb = readFile(getDataPath("quad_interleaved.glb"));
+    QVERIFY(!glb.isEmpty());
+    auto model = read(glb.left(glb.size() - 16), "quad_interleaved.glb");
+    QVERIFY(!model || model->meshes.empty() || model->meshes[0].vertices.isEmpty());
+
+    // accessors that run past the end of their buffer aren't read, and the primitive is left out
+    QByteArray gltf = readFile(getDataPath("quad_interleaved.gltf"));
+    QVERIFY(!gltf.isEmpty());
+    gltf.replace("\"count\": 4", "\"count\": 6");
+    model = read(gltf, "quad_interleaved.gltf");
+    QVERIFY(model);
+    QVERIFY(model->meshes.empty() || model->meshes[0].vertices.isEmpty());
+}
+
+void GLTFSerializerTests::benchmarkReadGLB() {
+    const int GRID_SIZE = 128;
+    QByteArray glb = makeGridGLB(GRID_SIZE);
+    HFMModel::Pointer model;
+    QBENCHMARK {
+        model = read(glb, "grid.glb");
+    }
+    QVERIFY(model);
+    QCOMPARE((int)model->meshes.size(), 1);
+    QCOMPARE(model->meshes[0].vertices.size(), GRID_SIZE * GRID_SIZE);
+}
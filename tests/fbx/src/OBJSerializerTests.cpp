@@ -0,0 +1,300 @@
+//
+//  OBJSerializerTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OBJSerializerTests.h"
+
+#include <random>
+
+#include <OBJSerializer.h>
+
+QTEST_GUILESS_MAIN(OBJSerializerTests)
+
+// Set HIFI_OBJ_TEST_DIR to also compare and benchmark a folder of real models, such as scanned environments
+static const char* OBJ_DIR_ENV = "HIFI_OBJ_TEST_DIR";
+
+// Keeps the material library from being fetched, so that models with an mtllib can be read offline
+static const QUrl OFFLINE_URL("file:///test.obj?hifiusemat");
+
+// A text dump of what the serializer produces, with floats to the given number of significant digits
+static QString dumpModel(const HFMModel& model, int precision) {
+    QString dump;
+    QTextStream stream(&dump);
+    auto number = [&](float value) {
+        return QString::number(value + 0.0f, 'g', precision); // no negative zeros
+    };
+    auto vec3 = [&](const glm::vec3& value) {
+        return number(value.x) + " " + number(value.y) + " " + number(value.z);
+    };
+    auto vec2 = [&](const glm::vec2& value) {
+        return number(value.x) + " " + number(value.y);
+    };
+
+    for (size_t meshIndex = 0; meshIndex < model.meshes.size(); ++meshIndex) {
+        const auto& mesh = model.meshes[meshIndex];
+        stream << "mesh " << meshIndex << "\n";
+        stream << "vertices " << mesh.vertices.size() << "\n";
+        for (const auto& vertex : mesh.vertices) {
+            stream << vec3(vertex) << "\n";
+        }
+        stream << "colors " << mesh.colors.size() << "\n";
+        for (const auto& color : mesh.colors) {
+            stream << vec3(color) << "\n";
+        }
+        stream << "normals " << mesh.normals.size() << "\n";
+        for (const auto& normal : mesh.normals) {
+            stream << vec3(normal) << "\n";
+        }
+        stream << "texCoords " << mesh.texCoords.size() << "\n";
+        for (const auto& texCoord : mesh.texCoords) {
+            stream << vec2(texCoord) << "\n";
+        }
+        for (size_t partIndex = 0; partIndex < mesh.parts.size(); ++partIndex) {
+            const auto& indices = mesh.parts[partIndex].triangleIndices;
+            stream << "part " << partIndex << " triangles " << indices.size() / 3 << "\n";
+            QStringList line;
+            for (int index : indices) {
+                line << QString::number(index);
+            }
+            stream << line.join(' ') << "\n";
+        }
+    }
+    for (const auto& shape : model.shapes) {
+        QString material = shape.material < model.materials.size() ? model.materials[shape.material].name : QString("none");
+        stream << "shape " << shape.mesh << " " << shape.meshPart << " " << material << "\n";
+    }
+    stream.flush();
+    return dump;
+}
+
+static HFMModel::Pointer read(const QByteArray& data, bool tokenizeAhead, bool combineParts, const QUrl& url = QUrl()) {
+    hifi::VariantHash mapping;
+    mapping["combineParts"] = combineParts;
+    OBJSerializer::setParallelTokenizingEnabled(tokenizeAhead);
+    auto model = OBJSerializer().read(data, mapping, url);
+    OBJSerializer::setParallelTokenizingEnabled(true);
+    return model;
+}
+
+// Reads data with the tokenizer reading the device as it goes and with the tokens read ahead, and compares every bit
+static void compareTokenizing(const QByteArray& data, const QUrl& url = QUrl()) {
+    const int EXACT_FLOAT_DIGITS = 9;
+    for (bool combineParts : { false, true }) {
+        QString expected = dumpModel(*read(data, false, combineParts, url), EXACT_FLOAT_DIGITS);
+        QString actual = dumpModel(*read(data, true, combineParts, url), EXACT_FLOAT_DIGITS);
+        QCOMPARE(actual, expected);
+    }
+}
+
+static QByteArray readFile(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void OBJSerializerTests::testGolden() {
+    // golden.txt was worked out by hand from the rules of the format and the quirks of the serializer, and covers
+    // scale hints, vertex colors, relative indices, polygons, faces without normals and one mesh part per group
+    const QDir data = QFileInfo(__FILE__).absoluteDir().absoluteFilePath("data");
+    const QByteArray model = readFile(data.absoluteFilePath("golden.obj"));
+    const QString golden = readFile(data.absoluteFilePath("golden.txt"));
+    QVERIFY(!model.isEmpty());
+    QVERIFY(!golden.isEmpty());
+
+    const int GOLDEN_FLOAT_DIGITS = 6;
+    for (bool tokenizeAhead : { false, true }) {
+        QCOMPARE(dumpModel(*read(model, tokenizeAhead, false), GOLDEN_FLOAT_DIGITS), golden);
+    }
+}
+
+void OBJSerializerTests::testTokenizingAheadMatches() {
+    // Reading tokens from the device lets the end of one line change how the next one is read, these have to come out the same
+    const std::vector<QByteArray> models {
+        // a comment straight after a vertex is taken as its next number, and its scale hint is lost
+        "v 1 2 3\n# This file uses centimeters as units\nv 4 5 6\nv 7 8 9\nf 1 2 3\n",
+        "v 1 2 3 # This file uses centimeters as units\nv 4 5 6\nv 7 8 9\nf 1 2 3\n",
+        // but not after a colored vertex
+        "v 1 2 3 0.5 0.5 0.5\n# This file uses millimeters as units\nv 4 5 6\nv 7 8 9\nf 1 2 3\n",
+        "v 1 2 3 0.5 0.5 0.5 # This file uses millimeters as units\nv 4 5 6\nv 7 8 9\nf 1 2 3\n",
+        // a fourth number is a w, seven or more the rest of the line is skipped
+        "v 1 2 3 4\nv 1 2 3 0 1 0 7 8\nv 4 5 6\nf 1 2 3\n",
+        // polygons, relative indices and texture coordinates with a w
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0.5 1.5 0\nvt 0 0 0\nvt 1 0 0\nvt 1 1 0\nf -5/-3 -4/-2 -3/-1 -2/-1 -1/-1\n",
+        // a group without a name takes the next datum as its name
+        "g\nv 1 2 3\nv 4 5 6\nv 7 8 9\nf 1 2 3\ng second\nf 3 2 1\no third\nf 1 3 2\n",
+        // tabs, carriage returns and blank lines
+        "v\t1\t2\t3\r\nv 4 5 6\r\n\r\n\r\nv 7 8 9\r\nf\t1//1 2//1 3//1\r\nvn 0 0 1\r\n",
+        // numbers that aren't plain, or need more than a double to round right
+        "v 1e3 -0 0.000001\nv 3.40282e38 1.00000005960464477539 0.1234567890123456789012\nv +1 -2.5E-3 7.\nf 1 2 3\n",
+        // materials, with and without combining parts, and a datum after the material name
+        "v 1 2 3\nv 4 5 6\nv 7 8 9\nusemtl red\nf 1 2 3\nusemtl blue green\nf 3 2 1\nusemtl red\nf 1 3 2\n",
+        // datums after the face indices, and faces that aren't
+        "v 1 2 3\nv 4 5 6\nv 7 8 9\nf 1 2 3 foo\nf 1 2\nf 1 2 3\n",
+        // an index out of range stops the mesh at that triangle
+        "v 1 2 3\nv 4 5 6\nv 7 8 9\nvn 0 0 1\nf 1//1 2//1 3//1\nf 1//1 2//1 3//2\nf 1 2 3\n",
+        // material libraries with spaces in their names
+        "mtllib my library.mtl\tv 1 2 3\nv 4 5 6\nv 7 8 9\nf 1 2 3\n",
+        // no newline at the end
+        "v 1 2 3\nv 4 5 6\nv 7 8 9\nf 1 2 3",
+    };
+    for (const auto& model : models) {
+        compareTokenizing(model, OFFLINE_URL);
+        compareTokenizing(model);
+    }
+}
+
+// A model with a bit of everything, in a random order
+static QByteArray generateModel(int numLines, unsigned int seed) {
+    std::mt19937 random(seed);
+    auto chance = [&](int percent) {
+        return (int)(random() % 100) < percent;
+    };
+    auto number = [&]() -> QByteArray {
+        float value = (float)(random() % 2000000) / 1000.0f - 1000.0f;
+        switch (random() % 4) {
+            case 0:
+                return QByteArray::number(value, 'f', 6);
+            case 1:
+                return QByteArray::number(value, 'g', 9);
+            case 2:
+                return QByteArray::number(value, 'e', 4);
+            default:
+                return QByteArray::number((int)value);
+        }
+    };
+    auto space = [&]() -> QByteArray {
+        return chance(10) ? "\t" : (chance(10) ? "  " : " ");
+    };
+    auto newline = [&]() -> QByteArray {
+        return chance(10) ? "\r\n" : "\n";
+    };
+
+    QByteArray model;
+    int numVertices = 0;
+    int numTextureUVs = 0;
+    int numNormals = 0;
+    for (int line = 0; line < numLines; ++line) {
+        int kind = random() % 100;
+        if (kind < 30) {
+            int numNumbers = chance(80) ? 3 : (chance(50) ? 4 : 6);
+            model += "v";
+            for (int i = 0; i < numNumbers; ++i) {
+                model += space() + number();
+            }
+            ++numVertices;
+        } else if (kind < 40) {
+            model += "vt" + space() + number() + space() + number();
+            ++numTextureUVs;
+        } else if (kind < 50) {
+            model += "vn" + space() + number() + space() + number() + space() + number();
+            ++numNormals;
+        } else if (kind < 85 && numVertices > 0) {
+            // the same kind of face vertex all the way round, as the serializer expects
+            const bool hasTextureUV = numTextureUVs > 0 && chance(50);
+            const bool hasNormal = numNormals > 0 && chance(50);
+            const bool isRelative = chance(20);
+            int numFaceVertices = 3 + random() % 3;
+            model += "f";
+            for (int i = 0; i < numFaceVertices; ++i) {
+                auto index = [&](int count) {
+                    int index = 1 + random() % count;
+                    return QByteArray::number(isRelative ? index - count - 1 : index);
+                };
+                model += space() + index(numVertices);
+                if (hasTextureUV || hasNormal) {
+                    model += "/" + (hasTextureUV ? index(numTextureUVs) : QByteArray()) + (hasNormal ? "/" + index(numNormals) : QByteArray());
+                }
+            }
+        } else if (kind < 88) {
+            model += (chance(50) ? "g" : "o") + space() + "group" + QByteArray::number(line);
+        } else if (kind < 91) {
+            model += "usemtl" + space() + "material" + QByteArray::number(random() % 4);
+        } else if (kind < 94) {
+            model += "# comment " + QByteArray::number(line);
+        } else if (kind < 96) {
+            model += "s" + space() + (chance(50) ? "off" : "1");
+        } else {
+            // blank
+        }
+        model += newline();
+    }
+    return model;
+}
+
+void OBJSerializerTests::testTokenizingAheadMatchesGenerated() {
+    // big enough for several windows of chunks
+    const int NUM_LINES = 200000;
+    for (unsigned int seed : { 1U, 2U, 3U }) {
+        compareTokenizing(generateModel(NUM_LINES, seed));
+    }
+
+    if (qEnvironmentVariableIsSet(OBJ_DIR_ENV)) {
+        QDirIterator it(qEnvironmentVariable(OBJ_DIR_ENV), { "*.obj" }, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            compareTokenizing(readFile(it.next()), OFFLINE_URL);
+        }
+    }
+}
+
+// A grid of quads with texture coordinates and normals, as a scanned environment would be
+static QByteArray generateGrid(int size) {
+    QByteArray model;
+    for (int z = 0; z < size; ++z) {
+        for (int x = 0; x < size; ++x) {
+            model += "v " + QByteArray::number(x * 0.01, 'f', 6) + " " + QByteArray::number(std::sin(x * 0.1) * std::cos(z * 0.1), 'f', 6) +
+                " " + QByteArray::number(z * 0.01, 'f', 6) + "\n";
+            model += "vt " + QByteArray::number((float)x / size, 'f', 6) + " " + QByteArray::number((float)z / size, 'f', 6) + "\n";
+            model += "vn 0.000000 1.000000 0.000000\n";
+        }
+    }
+    for (int z = 0; z < size - 1; ++z) {
+        for (int x = 0; x < size - 1; ++x) {
+            int indices[4] = { z * size + x + 1, z * size + x + 2, (z + 1) * size + x + 2, (z + 1) * size + x + 1 };
+            model += "f";
+            for (int index : indices) {
+                QByteArray i = QByteArray::number(index);
+                model += " " + i + "/" + i + "/" + i;
+            }
+            model += "\n";
+        }
+    }
+    return model;
+}
+
+void OBJSerializerTests::benchmarkRead() {
+    std::vector<std::pair<QString, QByteArray>> models;
+    const int GRID_SIZE = 700;
+    models.emplace_back("grid", generateGrid(GRID_SIZE));
+    if (qEnvironmentVariableIsSet(OBJ_DIR_ENV)) {
+        QDirIterator it(qEnvironmentVariable(OBJ_DIR_ENV), { "*.obj" }, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            QString path = it.next();
+            models.emplace_back(QFileInfo(path).fileName(), readFile(path));
+        }
+    }
+
+    qInfo().noquote() << QString("%1 %2 %3 %4 %5").arg("model", -40).arg("MB", 8).arg("serial ms", 10).arg("ahead ms", 10).arg("speedup", 8);
+    for (const auto& model : models) {
+        const QByteArray& data = model.second;
+        QElapsedTimer timer;
+        timer.start();
+        auto serial = read(data, false, true, OFFLINE_URL);
+        const qint64 serialNs = timer.nsecsElapsed();
+
+        timer.restart();
+        auto ahead = read(data, true, true, OFFLINE_URL);
+        const qint64 aheadNs = timer.nsecsElapsed();
+        QVERIFY(!ahead->meshes.empty());
+
+        qInfo().noquote() << QString("%1 %2 %3 %4 %5").arg(model.first, -40).arg(data.size() / 1.0e6, 8, 'f', 2)
+            .arg(serialNs / 1.0e6, 10, 'f', 2).arg(aheadNs / 1.0e6, 10, 'f', 2).arg((double)serialNs / aheadNs, 8, 'f', 2);
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  OBJSerializerTests.h
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OBJSerializerTests_h
+#define hifi_OBJSerializerTests_h
+
+#include <QtTest/QtTest>
+
+class OBJSerializerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testGolden();
+    void testTokenizingAheadMatches();
+    void testTokenizingAheadMatchesGenerated();
+    void benchmarkRead();
+};
+
+#endif // hifi_OBJSerializerTests_h
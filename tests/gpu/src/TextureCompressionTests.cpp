@@ -0,0 +1,111 @@
+//
+//  TextureCompressionTests.cpp
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureCompressionTests.h"
+
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtGui/QImageReader>
+
+#include <gpu/Texture.h>
+#include <image/TextureProcessing.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(TextureCompressionTests)
+
+Q_DECLARE_METATYPE(gpu::Element)
+
+// a 4K albedo is the worst case Interface and the oven have to compress
+static const int GENERATED_IMAGE_SIZE = 4096;
+static const int MIN_SOURCE_IMAGE_SIZE = 256;
+
+void TextureCompressionTests::initTestCase() {
+    // the test images shipped with Interface
+    QDirIterator imageFiles(getTestResource("interface/resources/images"), { "*.png", "*.jpg" },
+                            QDir::Files, QDirIterator::Subdirectories);
+    while (imageFiles.hasNext()) {
+        QImageReader reader(imageFiles.next());
+        QImage image = reader.read();
+        if (!image.isNull() && std::min(image.width(), image.height()) >= MIN_SOURCE_IMAGE_SIZE) {
+            _sourceImages.emplace_back(image.convertToFormat(QImage::Format_ARGB32));
+        }
+    }
+
+    // and a large generated one, with enough detail that the compressors do not take shortcuts on it
+    QImage generated(GENERATED_IMAGE_SIZE, GENERATED_IMAGE_SIZE, QImage::Format_ARGB32);
+    for (int y = 0; y < GENERATED_IMAGE_SIZE; ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(generated.scanLine(y));
+        for (int x = 0; x < GENERATED_IMAGE_SIZE; ++x) {
+            int noise = (x * 7919 + y * 104729) & 0x3F;
+            line[x] = qRgba((x >> 4) + noise, (y >> 4) + noise, ((x ^ y) & 0xFF), (x + y) & 0xFF);
+        }
+    }
+    _sourceImages.emplace_back(generated);
+
+    QVERIFY(!_sourceImages.empty());
+}
+
+void TextureCompressionTests::benchmarkCompression_data() {
+    QTest::addColumn<gpu::Element>("format");
+    QTest::addColumn<int>("concurrency");
+
+    const std::vector<std::pair<const char*, gpu::Element>> FORMATS {
+        { "BC1", gpu::Element::COLOR_COMPRESSED_BCX_SRGB },
+        { "BC3", gpu::Element::COLOR_COMPRESSED_BCX_SRGBA },
+        { "BC4", gpu::Element::COLOR_COMPRESSED_BCX_RED },
+        { "BC5", gpu::Element::COLOR_COMPRESSED_BCX_XY },
+        { "BC6", gpu::Element::COLOR_COMPRESSED_BCX_HDR_RGB },
+        { "BC7", gpu::Element::COLOR_COMPRESSED_BCX_SRGBA_HIGH }
+    };
+
+    // one thread is how compression ran before it went through the thread pool
+    for (const auto& format : FORMATS) {
+        for (int concurrency : { 1, QThread::idealThreadCount() }) {
+            QTest::newRow(QString("%1 x%2").arg(format.first).arg(concurrency).toUtf8().constData())
+                << format.second << concurrency;
+        }
+    }
+}
+
+void TextureCompressionTests::benchmarkCompression() {
+    QFETCH(gpu::Element, format);
+    QFETCH(int, concurrency);
+
+    image::setTextureCompressionConcurrency(concurrency);
+    bool isHDR = format == gpu::Element::COLOR_COMPRESSED_BCX_HDR_RGB;
+
+    quint64 numPixels = 0;
+    qint64 elapsedNanoseconds = 0;
+
+    for (const auto& sourceImage : _sourceImages) {
+        image::Image input = isHDR ? sourceImage.getConvertedToFormat(image::Image::Format_RGBAF) : sourceImage;
+
+        auto texture = gpu::Texture::create2D(format, input.getWidth(), input.getHeight(), gpu::Texture::MAX_NUM_MIPS);
+        texture->setStoredMipFormat(format);
+
+        QElapsedTimer timer;
+        timer.start();
+        image::convertToTextureWithMips(texture.get(), std::move(input), gpu::BackendTarget::GL45);
+        elapsedNanoseconds += timer.nsecsElapsed();
+
+        for (gpu::uint16 mip = 0; mip < texture->getNumMips(); ++mip) {
+            QVERIFY(texture->isStoredMipFaceAvailable(mip));
+            numPixels += texture->evalMipWidth(mip) * texture->evalMipHeight(mip);
+        }
+    }
+
+    double megapixelsPerSecond = (numPixels / 1.0e6) / (elapsedNanoseconds / 1.0e9);
+    qInfo() << QTest::currentDataTag() << "-" << QString::number(megapixelsPerSecond, 'f', 2) << "megapixels per second";
+
+    // leave the remaining tests with every core
+    image::setTextureCompressionConcurrency(0);
+}
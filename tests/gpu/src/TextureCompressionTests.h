@@ -0,0 +1,30 @@
+//
+//  TextureCompressionTests.h
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureCompressionTests_h
+#define hifi_TextureCompressionTests_h
+
+#include <QtTest/QtTest>
+
+#include <image/Image.h>
+
+class TextureCompressionTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void benchmarkCompression_data();
+    void benchmarkCompression();
+
+private:
+    std::vector<image::Image> _sourceImages;
+};
+
+#endif // hifi_TextureCompressionTests_h
@@ -0,0 +1,148 @@
+//
+//  TextureStreamingTests.cpp
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureStreamingTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <gpu/Texture.h>
+#include <gpu/TextureStreaming.h>
+
+QTEST_GUILESS_MAIN(TextureStreamingTests)
+
+using namespace gpu;
+
+static TexturePointer createTexture(uint16 size) {
+    return Texture::create2D(Element::COLOR_RGBA_32, size, size, Texture::MAX_NUM_MIPS);
+}
+
+void TextureStreamingTests::testMipValues() {
+    TextureStreaming::beginFrame();
+    auto texture = createTexture(1024);
+    QCOMPARE(texture->getMaxMip(), (uint16)10);
+
+    // never drawn, worth nothing and only the coarsest mip is wanted
+    QCOMPARE(TextureStreaming::getScreenSize(*texture), 0.0f);
+    QCOMPARE(TextureStreaming::evalMipValue(*texture, 4), 0.0f);
+    QCOMPARE(TextureStreaming::evalDesiredMip(*texture), texture->getMaxMip());
+
+    // drawn 512 pixels across, the 512 texels mip is as sharp as it gets
+    TextureStreaming::reportScreenSize(*texture, 512.0f);
+    QCOMPARE(TextureStreaming::evalMipValue(*texture, 0), 0.5f);
+    QCOMPARE(TextureStreaming::evalMipValue(*texture, 1), 1.0f);
+    QCOMPARE(TextureStreaming::evalMipValue(*texture, 3), 4.0f);
+    QCOMPARE(TextureStreaming::evalDesiredMip(*texture), (uint16)1);
+
+    // a little larger than a mip and it takes the finer one
+    TextureStreaming::beginFrame();
+    TextureStreaming::reportScreenSize(*texture, 600.0f);
+    QCOMPARE(TextureStreaming::evalDesiredMip(*texture), (uint16)0);
+
+    // much larger than the texture, the finest mip is still the finest there is
+    TextureStreaming::beginFrame();
+    TextureStreaming::reportScreenSize(*texture, 8192.0f);
+    QCOMPARE(TextureStreaming::evalDesiredMip(*texture), (uint16)0);
+}
+
+void TextureStreamingTests::testLargestReportWins() {
+    TextureStreaming::beginFrame();
+    auto texture = createTexture(256);
+
+    // drawn several times in a frame, the largest counts
+    TextureStreaming::reportScreenSize(*texture, 100.0f);
+    TextureStreaming::reportScreenSize(*texture, 300.0f);
+    TextureStreaming::reportScreenSize(*texture, 200.0f);
+    QCOMPARE(TextureStreaming::getScreenSize(*texture), 300.0f);
+
+    // the next frame starts over
+    TextureStreaming::beginFrame();
+    TextureStreaming::reportScreenSize(*texture, 50.0f);
+    QCOMPARE(TextureStreaming::getScreenSize(*texture), 50.0f);
+}
+
+void TextureStreamingTests::testConcurrentReports() {
+    TextureStreaming::beginFrame();
+    auto texture = createTexture(256);
+    TextureStreaming::reportScreenSize(*texture, 1000.0f);
+
+    // the first reports of the next frame, from several threads at once, keep the largest of them and none from before
+    TextureStreaming::beginFrame();
+    const int NUM_THREADS = 8;
+    const int NUM_REPORTS = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&texture, i] {
+            for (int j = 0; j < NUM_REPORTS; ++j) {
+                TextureStreaming::reportScreenSize(*texture, (float)(i * NUM_REPORTS + j) / NUM_THREADS);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    QCOMPARE(TextureStreaming::getScreenSize(*texture), (float)(NUM_THREADS * NUM_REPORTS - 1) / NUM_THREADS);
+}
+
+void TextureStreamingTests::testScreenSizeExpires() {
+    TextureStreaming::beginFrame();
+    auto texture = createTexture(256);
+    TextureStreaming::reportScreenSize(*texture, 128.0f);
+
+    for (uint32_t i = 0; i < TextureStreaming::SCREEN_SIZE_FRAMES; ++i) {
+        TextureStreaming::beginFrame();
+    }
+    QCOMPARE(TextureStreaming::getScreenSize(*texture), 128.0f);
+
+    TextureStreaming::beginFrame();
+    QCOMPARE(TextureStreaming::getScreenSize(*texture), 0.0f);
+    QCOMPARE(TextureStreaming::evalMipValue(*texture, 0), 0.0f);
+}
+
+void TextureStreamingTests::testDownloadMip() {
+    TextureStreaming::beginFrame();
+    auto texture = createTexture(1024);
+
+    // never reported, such as a skybox, it downloads every mip
+    QVERIFY(!TextureStreaming::isScreenSizeReported(*texture));
+    QCOMPARE(TextureStreaming::evalDownloadMip(*texture), (uint16)0);
+
+    // drawn 128 pixels across, it stops at the 128 texels mip
+    TextureStreaming::reportScreenSize(*texture, 128.0f);
+    QVERIFY(TextureStreaming::isScreenSizeReported(*texture));
+    QCOMPARE(TextureStreaming::evalDownloadMip(*texture), (uint16)3);
+
+    // and needs no more once it is off screen
+    for (uint32_t i = 0; i <= TextureStreaming::SCREEN_SIZE_FRAMES; ++i) {
+        TextureStreaming::beginFrame();
+    }
+    QCOMPARE(TextureStreaming::evalDownloadMip(*texture), texture->getMaxMip());
+}
+
+void TextureStreamingTests::testEvictionOrder() {
+    TextureStreaming::beginFrame();
+    auto hiddenLarge = createTexture(2048);
+    auto hiddenSmall = createTexture(512);
+    auto sharp = createTexture(1024);
+    auto blurry = createTexture(1024);
+    TextureStreaming::reportScreenSize(*sharp, 64.0f);
+    TextureStreaming::reportScreenSize(*blurry, 2048.0f);
+
+    const uint16 finestMip = 0;
+    float hiddenLargePriority = TextureStreaming::evalEvictionPriority(*hiddenLarge, finestMip, hiddenLarge->evalTotalSize());
+    float hiddenSmallPriority = TextureStreaming::evalEvictionPriority(*hiddenSmall, finestMip, hiddenSmall->evalTotalSize());
+    float sharpPriority = TextureStreaming::evalEvictionPriority(*sharp, finestMip, sharp->evalTotalSize());
+    float blurryPriority = TextureStreaming::evalEvictionPriority(*blurry, finestMip, blurry->evalTotalSize());
+
+    // what isn't on screen goes first, largest first, then what needs its finest mip the least
+    QVERIFY(hiddenLargePriority > hiddenSmallPriority);
+    QVERIFY(hiddenSmallPriority > sharpPriority);
+    QVERIFY(sharpPriority > blurryPriority);
+}
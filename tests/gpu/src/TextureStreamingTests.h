@@ -0,0 +1,28 @@
+//
+//  TextureStreamingTests.h
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureStreamingTests_h
+#define hifi_TextureStreamingTests_h
+
+#include <QtTest/QtTest>
+
+class TextureStreamingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testMipValues();
+    void testLargestReportWins();
+    void testConcurrentReports();
+    void testScreenSizeExpires();
+    void testDownloadMip();
+    void testEvictionOrder();
+};
+
+#endif // hifi_TextureStreamingTests_h
@@ -140,6 +140,21 @@ void KtxTests::testKtxSerialization() {
         }
     }
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
+
+    {
+        // The mips of a KTX backed texture are views into the mapped file, not copies of it
+        auto mappedTexture = gpu::Texture::unserialize(TEST_IMAGE_KTX.fileName().toStdString());
+        QVERIFY(mappedTexture.get());
+        auto mipCount = (uint16_t)ktxMemory->_images.size();
+        for (uint16_t mip = mappedTexture->minAvailableMipLevel(); mip < mipCount; ++mip) {
+            auto mipFace = mappedTexture->accessStoredMipFace(mip);
+            auto expected = ktxMemory->getMipFaceTexelsData(mip);
+            QVERIFY(mipFace.get());
+            QVERIFY(mipFace->isMapped());
+            QCOMPARE(mipFace->size(), expected->size());
+            QVERIFY(0 == memcmp(mipFace->data(), expected->data(), expected->size()));
+        }
+    }
 }
 
 #if 0
@@ -0,0 +1,302 @@
+//
+//  UniversalTextureTests.cpp
+//  tests/ktx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UniversalTextureTests.h"
+
+#include <cmath>
+#include <limits>
+
+#include <QtTest/QtTest>
+
+#include <ktx/KTX.h>
+#include <ktx/Universal.h>
+#include <gpu/Texture.h>
+#include <image/TextureProcessing.h>
+
+QTEST_GUILESS_MAIN(UniversalTextureTests)
+
+static QString getRootPath() {
+    QFileInfo file(__FILE__);
+    return QDir::cleanPath(file.absolutePath() + "/../../..");
+}
+
+static ktx::KTXUniquePointer bakeKtx(const QString& path, bool compress, gpu::BackendTarget target,
+                                     image::TextureUsage::Type type = image::TextureUsage::Type::DEFAULT_TEXTURE) {
+    auto file = std::make_shared<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    auto texture = image::processImage(file, path.toStdString(), image::ColorChannel::NONE, ABSOLUTE_MAX_TEXTURE_NUM_PIXELS,
+                                       type, compress, target);
+    if (!texture) {
+        return nullptr;
+    }
+    return gpu::Texture::serialize(*texture);
+}
+
+// PSNR in dB of the color and alpha of an uncompressed decode against the RGBA or BGRA source it was encoded from
+static void evalPSNR(const ktx::KTX& source, const ktx::KTX& decoded, double& colorPSNR, double& alphaPSNR) {
+    const bool isBGRA = source._header.getGLFormat() == ktx::GLFormat::BGRA;
+    const auto& sourceImage = source._images[0];
+    const auto& decodedImage = decoded._images[0];
+    const size_t numPixels = source._header.getPixelWidth() * source._header.getPixelHeight();
+
+    double colorError = 0.0;
+    double alphaError = 0.0;
+    for (size_t face = 0; face < sourceImage._numFaces; ++face) {
+        const ktx::Byte* src = sourceImage._faceBytes[face];
+        const ktx::Byte* dst = decodedImage._faceBytes[face];
+        for (size_t i = 0; i < numPixels; ++i, src += 4, dst += 4) {
+            const int srcRGB[3] = { src[isBGRA ? 2 : 0], src[1], src[isBGRA ? 0 : 2] };
+            for (int c = 0; c < 3; ++c) {
+                double delta = srcRGB[c] - dst[c];
+                colorError += delta * delta;
+            }
+            double delta = src[3] - dst[3];
+            alphaError += delta * delta;
+        }
+    }
+
+    auto toPSNR = [](double meanSquaredError) {
+        return meanSquaredError > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / meanSquaredError) : 99.0;
+    };
+    const double numSamples = (double)numPixels * sourceImage._numFaces;
+    colorPSNR = toPSNR(colorError / (numSamples * 3.0));
+    alphaPSNR = toPSNR(alphaError / numSamples);
+}
+
+void UniversalTextureTests::initTestCase() {
+    const QString root = getRootPath();
+    _sourceImages << root + "/scripts/developer/tests/cube_texture.png";
+    QDirIterator it(root + "/interface/resources/images", { "*.png", "*.jpg" }, QDir::Files);
+    while (it.hasNext() && _sourceImages.size() < 16) {
+        _sourceImages << it.next();
+    }
+}
+
+void UniversalTextureTests::testRoundTrip() {
+    for (const auto& path : _sourceImages) {
+        auto source = bakeKtx(path, false, gpu::BackendTarget::GL45);
+        if (!source) {
+            continue;
+        }
+
+        auto universalStorage = ktx::UniversalKTX::encode(*source);
+        QVERIFY(universalStorage);
+        QVERIFY(ktx::UniversalKTX::isUniversal(universalStorage->size(), universalStorage->data()));
+        QVERIFY(!ktx::KTX::validate(universalStorage));
+
+        auto universal = ktx::UniversalKTX::create(universalStorage);
+        QVERIFY(universal);
+        QCOMPARE(universal->getHeader().numberOfMipmapLevels, source->_header.getNumberOfLevels());
+
+        for (int i = 0; i < (int)ktx::UniversalKTX::Target::NUM_TARGETS; ++i) {
+            auto target = (ktx::UniversalKTX::Target)i;
+            auto transcoded = universal->transcode(target);
+            if (!transcoded) {
+                continue;
+            }
+            QVERIFY(ktx::KTX::validate(transcoded->getStorage()));
+            QCOMPARE(transcoded->_header.getPixelWidth(), source->_header.getPixelWidth());
+            QCOMPARE(transcoded->_header.getPixelHeight(), source->_header.getPixelHeight());
+            QCOMPARE(transcoded->_images.size(), source->_images.size());
+            QCOMPARE(transcoded->_keyValues.size(), source->_keyValues.size());
+        }
+
+        auto decoded = universal->transcode(ktx::UniversalKTX::Target::UNCOMPRESSED);
+        QVERIFY(decoded);
+        double colorPSNR, alphaPSNR;
+        evalPSNR(*source, *decoded, colorPSNR, alphaPSNR);
+        qInfo() << QFileInfo(path).fileName() << "PSNR color" << colorPSNR << "dB, alpha" << alphaPSNR << "dB";
+        QVERIFY(colorPSNR > 28.0);
+    }
+}
+
+void UniversalTextureTests::testLinearMaps() {
+    using Target = ktx::UniversalKTX::Target;
+    struct LinearMap {
+        image::TextureUsage::Type type;
+        uint32_t numChannels;
+        Target bc;
+        Target eac;
+        ktx::GLInternalFormat bcFormat;
+        ktx::GLInternalFormat eacFormat;
+    };
+    const std::vector<LinearMap> maps {
+        { image::TextureUsage::Type::ROUGHNESS_TEXTURE, 1, Target::BC4, Target::EAC_R11,
+          ktx::GLInternalFormat::COMPRESSED_RED_RGTC1, ktx::GLInternalFormat::COMPRESSED_R11_EAC },
+        { image::TextureUsage::Type::NORMAL_TEXTURE, 2, Target::BC5, Target::EAC_RG11,
+          ktx::GLInternalFormat::COMPRESSED_RG_RGTC2, ktx::GLInternalFormat::COMPRESSED_RG11_EAC },
+    };
+
+    int numTested = 0;
+    for (const auto& map : maps) {
+        for (const auto& path : _sourceImages) {
+            auto source = bakeKtx(path, false, gpu::BackendTarget::GL45, map.type);
+            if (!source) {
+                continue;
+            }
+            auto universal = ktx::UniversalKTX::create(ktx::UniversalKTX::encode(*source));
+            QVERIFY(universal);
+            QCOMPARE(universal->getNumChannels(), map.numChannels);
+            QVERIFY(!universal->hasAlpha());
+
+            // Linear maps don't go to the sRGB color block formats
+            QVERIFY(!universal->transcode(Target::BC1));
+            QVERIFY(!universal->transcode(Target::ETC2_RGB));
+
+            auto bc = universal->transcode(map.bc);
+            QVERIFY(bc);
+            QCOMPARE(bc->_header.getGLInternaFormat(), map.bcFormat);
+            QCOMPARE(bc->_images.size(), source->_images.size());
+            auto eac = universal->transcode(map.eac);
+            QVERIFY(eac);
+            QCOMPARE(eac->_header.getGLInternaFormat(), map.eacFormat);
+
+            // Decodes to the channels of the source
+            auto decoded = universal->transcode(Target::UNCOMPRESSED);
+            QVERIFY(decoded);
+            QCOMPARE(decoded->_header.getGLInternaFormat(), source->_header.getGLInternaFormat());
+            QCOMPARE(decoded->_images[0]._faceSize, source->_images[0]._faceSize);
+            ++numTested;
+        }
+    }
+    QVERIFY(numTested > 0);
+}
+
+void UniversalTextureTests::testMaxNumPixels() {
+    for (const auto& path : _sourceImages) {
+        auto source = bakeKtx(path, false, gpu::BackendTarget::GL45);
+        if (!source || source->_header.getNumberOfLevels() < 3) {
+            continue;
+        }
+        auto universal = ktx::UniversalKTX::create(ktx::UniversalKTX::encode(*source));
+        QVERIFY(universal);
+        const auto& header = universal->getHeader();
+
+        // Starts at the first level within the budget
+        const size_t maxNumPixels = (size_t)header.evalMipWidth(2) * header.evalMipHeight(2);
+        auto transcoded = universal->transcode(ktx::UniversalKTX::Target::UNCOMPRESSED, maxNumPixels);
+        QVERIFY(transcoded);
+        QVERIFY(ktx::KTX::validate(transcoded->getStorage()));
+        QCOMPARE(transcoded->_header.getPixelWidth(), header.evalMipWidth(2));
+        QCOMPARE(transcoded->_header.getPixelHeight(), header.evalMipHeight(2));
+        QCOMPARE(transcoded->_header.getNumberOfLevels(), header.numberOfMipmapLevels - 2);
+
+        // Keeps the last level however small the budget
+        auto smallest = universal->transcode(ktx::UniversalKTX::Target::UNCOMPRESSED, 0);
+        QVERIFY(smallest);
+        QCOMPARE(smallest->_header.getNumberOfLevels(), (uint32_t)1);
+        QCOMPARE(smallest->_header.getPixelWidth(), header.evalMipWidth(header.numberOfMipmapLevels - 1));
+    }
+}
+
+void UniversalTextureTests::testSizes() {
+    size_t totalUniversal = 0;
+    size_t totalBCn = 0;
+    size_t totalETC2 = 0;
+    for (const auto& path : _sourceImages) {
+        auto source = bakeKtx(path, false, gpu::BackendTarget::GL45);
+        auto bcn = bakeKtx(path, true, gpu::BackendTarget::GL45);
+        auto etc2 = bakeKtx(path, true, gpu::BackendTarget::GLES32);
+        if (!source || !bcn || !etc2) {
+            continue;
+        }
+        auto universalStorage = ktx::UniversalKTX::encode(*source);
+        QVERIFY(universalStorage);
+
+        qInfo() << QFileInfo(path).fileName() << "universal" << universalStorage->size() << "BCn" << bcn->getStorage()->size()
+            << "ETC2" << etc2->getStorage()->size();
+        totalUniversal += universalStorage->size();
+        totalBCn += bcn->getStorage()->size();
+        totalETC2 += etc2->getStorage()->size();
+    }
+
+    qInfo() << "Total universal" << totalUniversal << "BCn" << totalBCn << "ETC2" << totalETC2 << "BCn + ETC2" << totalBCn + totalETC2;
+    // One universal texture replaces a KTX per GPU format, it has to be smaller than the two it replaces
+    QVERIFY(totalUniversal < totalBCn + totalETC2);
+}
+
+// A copy of the universal texture with the index of its first level changed
+static ktx::StoragePointer withFirstLevel(const ktx::StoragePointer& storage, const ktx::UniversalLevel& level) {
+    auto result = std::make_shared<storage::MemoryStorage>(storage->size(), storage->data());
+    memcpy(result->mutableData() + sizeof(ktx::UniversalHeader), &level, sizeof(ktx::UniversalLevel));
+    return result;
+}
+
+void UniversalTextureTests::testMalformedLevels() {
+    int numTested = 0;
+    for (const auto& path : _sourceImages) {
+        auto source = bakeKtx(path, false, gpu::BackendTarget::GL45);
+        if (!source) {
+            continue;
+        }
+        auto storage = ktx::UniversalKTX::encode(*source, false);
+        QVERIFY(storage);
+        auto universal = ktx::UniversalKTX::create(storage);
+        QVERIFY(universal);
+        QVERIFY(universal->transcode(ktx::UniversalKTX::Target::UNCOMPRESSED));
+        const auto level = universal->getLevels()[0];
+
+        // Fewer bytes than the blocks of the level, which is not supercompressed
+        auto shortLevel = level;
+        shortLevel.byteLength -= 1;
+        QVERIFY(!ktx::UniversalKTX::create(withFirstLevel(storage, shortLevel)));
+
+        // An offset and a length whose sum wraps around
+        auto wrappingLevel = level;
+        wrappingLevel.byteOffset = std::numeric_limits<uint64_t>::max() - 8;
+        wrappingLevel.byteLength = 16;
+        QVERIFY(!ktx::UniversalKTX::create(withFirstLevel(storage, wrappingLevel)));
+        wrappingLevel.byteOffset = level.byteOffset;
+        wrappingLevel.byteLength = std::numeric_limits<uint64_t>::max() - level.byteOffset + 2;
+        QVERIFY(!ktx::UniversalKTX::create(withFirstLevel(storage, wrappingLevel)));
+        ++numTested;
+    }
+    QVERIFY(numTested > 0);
+}
+
+void UniversalTextureTests::testTranscodeSpeed() {
+    std::vector<std::unique_ptr<ktx::UniversalKTX>> universals;
+    std::vector<size_t> numPixels;
+    for (const auto& path : _sourceImages) {
+        auto source = bakeKtx(path, false, gpu::BackendTarget::GL45);
+        if (!source) {
+            continue;
+        }
+        auto universal = ktx::UniversalKTX::create(ktx::UniversalKTX::encode(*source));
+        QVERIFY(universal);
+        const auto& header = universal->getHeader();
+        size_t pixels = 0;
+        for (uint32_t level = 0; level < header.numberOfMipmapLevels; ++level) {
+            pixels += header.evalMipWidth(level) * header.evalMipHeight(level) * header.numberOfFaces;
+        }
+        numPixels.push_back(pixels);
+        universals.push_back(std::move(universal));
+    }
+    QVERIFY(!universals.empty());
+
+    static const int NUM_ITERATIONS = 4;
+    for (int i = 0; i < (int)ktx::UniversalKTX::Target::NUM_TARGETS; ++i) {
+        auto target = (ktx::UniversalKTX::Target)i;
+        size_t transcodedPixels = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+            for (size_t u = 0; u < universals.size(); ++u) {
+                if (universals[u]->transcode(target)) {
+                    transcodedPixels += numPixels[u];
+                }
+            }
+        }
+        double seconds = std::max(timer.nsecsElapsed(), (qint64)1) / 1.0e9;
+        qInfo() << ktx::UniversalKTX::toString(target) << "transcodes at" << (transcodedPixels / seconds) / 1.0e6 << "MP/s";
+    }
+}
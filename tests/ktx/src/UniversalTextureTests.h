@@ -0,0 +1,32 @@
+//
+//  UniversalTextureTests.h
+//  tests/ktx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UniversalTextureTests_h
+#define hifi_UniversalTextureTests_h
+
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+class UniversalTextureTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testRoundTrip();
+    void testLinearMaps();
+    void testMaxNumPixels();
+    void testSizes();
+    void testMalformedLevels();
+    void testTranscodeSpeed();
+
+private:
+    QStringList _sourceImages;
+};
+
+#endif // hifi_UniversalTextureTests_h
@@ -0,0 +1,124 @@
+//
+//  EntityPhysicsRegionsTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsRegionsTests.h"
+
+#include <QtCore/QJsonObject>
+
+#include <EntityItem.h>
+#include <EntityPhysicsRegions.h>
+#include <PhysicalEntitySimulation.h>
+#include <workload/Region.h>
+
+QTEST_MAIN(EntityPhysicsRegionsTests)
+
+static QJsonObject makeRegion(const QString& xMin, const QString& xMax, const QString& zMin, const QString& zMax) {
+    QJsonObject region;
+    region["x_min"] = xMin;
+    region["x_max"] = xMax;
+    region["z_min"] = zMin;
+    region["z_max"] = zMax;
+    return region;
+}
+
+// Two regions side by side, split at x = 0, like the table of the physics_server settings
+static QJsonArray makeRegions() {
+    QJsonArray regions;
+    regions.append(makeRegion("-100", "0", "-100", "100"));
+    regions.append(makeRegion("0", "100", "-100", "100"));
+    return regions;
+}
+
+static EntityItemPointer makeEntity(const glm::vec3& position) {
+    auto entity = std::make_shared<EntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setWorldPosition(position);
+    return entity;
+}
+
+void EntityPhysicsRegionsTests::testAssignmentPayload() {
+    // what the domain-server hands each server when the domain has regions
+    for (int region = 0; region < 3; ++region) {
+        QCOMPARE(EntityPhysicsRegions::parseAssignmentPayload(QString("--region %1").arg(region).toUtf8()), region);
+    }
+    QCOMPARE(EntityPhysicsRegions::parseAssignmentPayload("--other x --region 2"), 2);
+    QCOMPARE(EntityPhysicsRegions::parseAssignmentPayload("  --region   1 "), 1);
+
+    // and the server of the whole domain, or one given a payload it can't read
+    QCOMPARE(EntityPhysicsRegions::parseAssignmentPayload(QByteArray()), (int)EntityPhysicsRegions::NO_REGION);
+    QCOMPARE(EntityPhysicsRegions::parseAssignmentPayload("--region"), (int)EntityPhysicsRegions::NO_REGION);
+    QCOMPARE(EntityPhysicsRegions::parseAssignmentPayload("--region one"), (int)EntityPhysicsRegions::NO_REGION);
+    QCOMPARE(EntityPhysicsRegions::parseAssignmentPayload("--region -1"), (int)EntityPhysicsRegions::NO_REGION);
+    QCOMPARE(EntityPhysicsRegions::parseAssignmentPayload("--shard 1"), (int)EntityPhysicsRegions::NO_REGION);
+}
+
+void EntityPhysicsRegionsTests::testParseRegion() {
+    QJsonArray regions = makeRegions();
+    AABox box;
+    QVERIFY(EntityPhysicsRegions::parseRegion(regions, 1, box));
+    QCOMPARE(box.getCorner().x, 0.0f);
+    QCOMPARE(box.getCorner().z, -100.0f);
+    QCOMPARE(box.getScale().x, 100.0f);
+    QCOMPARE(box.getScale().z, 200.0f);
+
+    // all the way up and down
+    AABox wholeDomain = EntityPhysicsRegions::getWholeDomain();
+    QCOMPARE(box.getCorner().y, wholeDomain.getCorner().y);
+    QCOMPARE(box.getScale().y, wholeDomain.getScale().y);
+
+    // regions that aren't there, or aren't boxes
+    QVERIFY(!EntityPhysicsRegions::parseRegion(regions, 2, box));
+    QVERIFY(!EntityPhysicsRegions::parseRegion(regions, EntityPhysicsRegions::NO_REGION, box));
+    regions.append(makeRegion("10", "-10", "-100", "100"));
+    regions.append(makeRegion("-10", "10", "far", "100"));
+    QVERIFY(!EntityPhysicsRegions::parseRegion(regions, 2, box));
+    QVERIFY(!EntityPhysicsRegions::parseRegion(regions, 3, box));
+}
+
+void EntityPhysicsRegionsTests::testComputeRegion() {
+    PhysicalEntitySimulation simulation;
+    simulation.setSimulationRegion(AABox(glm::vec3(0.0f), glm::vec3(10.0f)));
+    const float MARGIN = PhysicalEntitySimulation::SIMULATION_REGION_MARGIN;
+
+    // owned inside, simulated within the margin, left alone beyond it
+    QCOMPARE(simulation.computeRegion(makeEntity(glm::vec3(5.0f))), (uint8_t)workload::Region::R1);
+    QCOMPARE(simulation.computeRegion(makeEntity(glm::vec3(0.0f, 5.0f, 5.0f))), (uint8_t)workload::Region::R1);
+    QCOMPARE(simulation.computeRegion(makeEntity(glm::vec3(-0.5f * MARGIN, 5.0f, 5.0f))), (uint8_t)workload::Region::R2);
+    QCOMPARE(simulation.computeRegion(makeEntity(glm::vec3(5.0f, 10.0f + 0.5f * MARGIN, 5.0f))), (uint8_t)workload::Region::R2);
+    QCOMPARE(simulation.computeRegion(makeEntity(glm::vec3(5.0f, 5.0f, -2.0f * MARGIN))), (uint8_t)workload::Region::R3);
+    QCOMPARE(simulation.computeRegion(makeEntity(glm::vec3(100.0f))), (uint8_t)workload::Region::R3);
+
+    // an entity that crosses the edge moves from one to the next
+    auto entity = makeEntity(glm::vec3(5.0f));
+    QCOMPARE(simulation.computeRegion(entity), (uint8_t)workload::Region::R1);
+    entity->setWorldPosition(glm::vec3(11.0f, 5.0f, 5.0f));
+    QCOMPARE(simulation.computeRegion(entity), (uint8_t)workload::Region::R2);
+    entity->setWorldPosition(glm::vec3(20.0f, 5.0f, 5.0f));
+    QCOMPARE(simulation.computeRegion(entity), (uint8_t)workload::Region::R3);
+}
+
+void EntityPhysicsRegionsTests::testAssignedRegion() {
+    // the two servers of the domain both simulate an entity near their border, only one owns it
+    QJsonArray regions = makeRegions();
+    PhysicalEntitySimulation simulations[2];
+    for (int region = 0; region < 2; ++region) {
+        QByteArray payload = QString("--region %1").arg(region).toUtf8();
+        AABox box;
+        QVERIFY(EntityPhysicsRegions::parseRegion(regions, EntityPhysicsRegions::parseAssignmentPayload(payload), box));
+        simulations[region].setSimulationRegion(box);
+    }
+
+    auto nearBorder = makeEntity(glm::vec3(-0.5f, 1.0f, 0.0f));
+    QCOMPARE(simulations[0].computeRegion(nearBorder), (uint8_t)workload::Region::R1);
+    QCOMPARE(simulations[1].computeRegion(nearBorder), (uint8_t)workload::Region::R2);
+
+    auto farFromBorder = makeEntity(glm::vec3(50.0f, 1.0f, 0.0f));
+    QCOMPARE(simulations[0].computeRegion(farFromBorder), (uint8_t)workload::Region::R3);
+    QCOMPARE(simulations[1].computeRegion(farFromBorder), (uint8_t)workload::Region::R1);
+}
@@ -0,0 +1,27 @@
+//
+//  EntityPhysicsRegionsTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsRegionsTests_h
+#define hifi_EntityPhysicsRegionsTests_h
+
+#include <QtTest/QtTest>
+
+// The region an entity-physics-server is assigned, and the workload regions of the entities around it
+class EntityPhysicsRegionsTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAssignmentPayload();
+    void testParseRegion();
+    void testComputeRegion();
+    void testAssignedRegion();
+};
+
+#endif // hifi_EntityPhysicsRegionsTests_h
@@ -0,0 +1,163 @@
+//
+//  PhysicsEngineTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsEngineTests.h"
+
+#include <QElapsedTimer>
+
+#include <NumericalConstants.h>
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(PhysicsEngineTests)
+
+namespace {
+
+const float BOX_SIZE = 0.5f;
+const int BOXES_PER_STACK = 5;
+const float GRAVITY = -9.8f;
+
+// Stacks of boxes on a floor, stepped by a PhysicsEngine set up for numThreads but without any motion states,
+// so that what is measured is the world alone
+class BoxStacks {
+public:
+    BoxStacks(int numThreads, int numStacks) : _engine(glm::vec3(0.0f)) {
+        _engine.setNumThreads(numThreads);
+        _engine.init();
+        _world = static_cast<ThreadSafeDynamicsWorld*>(_engine.getDynamicsWorld());
+
+        _floorShape = new btBoxShape(btVector3(1000.0f, 0.5f, 1000.0f));
+        btRigidBody::btRigidBodyConstructionInfo floorInfo(0.0f, nullptr, _floorShape);
+        floorInfo.m_startWorldTransform.setOrigin(btVector3(0.0f, -0.5f, 0.0f));
+        _floor = new btRigidBody(floorInfo);
+        _world->addRigidBody(_floor);
+
+        // the stacks are far enough apart to be islands of their own
+        _boxShape = new btBoxShape(btVector3(0.5f * BOX_SIZE, 0.5f * BOX_SIZE, 0.5f * BOX_SIZE));
+        const float MASS = 1.0f;
+        btVector3 inertia;
+        _boxShape->calculateLocalInertia(MASS, inertia);
+        int stacksPerRow = (int)ceilf(sqrtf((float)numStacks));
+        const float STACK_SPACING = 3.0f * BOX_SIZE;
+        for (int i = 0; i < numStacks; i++) {
+            float x = (float)(i % stacksPerRow) * STACK_SPACING;
+            float z = (float)(i / stacksPerRow) * STACK_SPACING;
+            for (int j = 0; j < BOXES_PER_STACK; j++) {
+                btRigidBody::btRigidBodyConstructionInfo boxInfo(MASS, nullptr, _boxShape, inertia);
+                boxInfo.m_startWorldTransform.setOrigin(btVector3(x, (0.5f + (float)j) * BOX_SIZE, z));
+                btRigidBody* box = new btRigidBody(boxInfo);
+                box->setActivationState(DISABLE_DEACTIVATION);
+                _world->addRigidBody(box);
+                // the world has no gravity of its own, each object has its own
+                box->setGravity(btVector3(0.0f, GRAVITY, 0.0f));
+                _boxes.push_back(box);
+            }
+        }
+    }
+
+    ~BoxStacks() {
+        for (auto box : _boxes) {
+            _world->removeRigidBody(box);
+            delete box;
+        }
+        _world->removeRigidBody(_floor);
+        delete _floor;
+        delete _boxShape;
+        delete _floorShape;
+    }
+
+    ThreadSafeDynamicsWorld* getWorld() const { return _world; }
+    bool isMultithreaded() const { return _engine.isMultithreaded(); }
+    const std::vector<btRigidBody*>& getBoxes() const { return _boxes; }
+
+    int step(int numSubsteps) {
+        int numSubstepsTaken = 0;
+        _world->stepSimulationWithSubstepCallback((float)numSubsteps * PHYSICS_ENGINE_FIXED_SUBSTEP, numSubsteps,
+                                                  PHYSICS_ENGINE_FIXED_SUBSTEP, [&] { numSubstepsTaken++; });
+        return numSubstepsTaken;
+    }
+
+private:
+    PhysicsEngine _engine;
+    ThreadSafeDynamicsWorld* _world { nullptr };
+    btCollisionShape* _floorShape { nullptr };
+    btCollisionShape* _boxShape { nullptr };
+    btRigidBody* _floor { nullptr };
+    std::vector<btRigidBody*> _boxes;
+};
+
+void verifyStacksSettle(int numThreads) {
+    const int NUM_STACKS = 16;
+    BoxStacks stacks(numThreads, NUM_STACKS);
+#if BT_THREADSAFE
+    QCOMPARE(stacks.isMultithreaded(), numThreads > 1);
+#else
+    QVERIFY(!stacks.isMultithreaded());
+#endif
+
+    // two seconds, one substep at a time so the callback is seen for each of them
+    const int NUM_STEPS = 2 * (int)NUM_SUBSTEPS_PER_SECOND;
+    for (int i = 0; i < NUM_STEPS; i++) {
+        QCOMPARE(stacks.step(1), 1);
+    }
+
+    // every box is still in its stack, and at rest
+    const float TOLERANCE = 0.05f * BOX_SIZE;
+    const float MAX_SPEED = 0.1f;
+    for (size_t i = 0; i < stacks.getBoxes().size(); i++) {
+        auto box = stacks.getBoxes()[i];
+        float expectedHeight = (0.5f + (float)(i % BOXES_PER_STACK)) * BOX_SIZE;
+        QVERIFY(fabsf(box->getWorldTransform().getOrigin().getY() - expectedHeight) < TOLERANCE);
+        QVERIFY(box->getLinearVelocity().length() < MAX_SPEED);
+    }
+}
+
+}
+
+void PhysicsEngineTests::testStacksSettle() {
+    verifyStacksSettle(1);
+}
+
+void PhysicsEngineTests::testStacksSettleMultithreaded() {
+    verifyStacksSettle(4);
+}
+
+void PhysicsEngineTests::benchmarkStepSimulation() {
+    // NUM_STACKS * BOXES_PER_STACK boxes, all of them kept active
+    const int NUM_STACKS = 200;
+    const int NUM_WARMUP_STEPS = 30;
+    const int NUM_STEPS = 90;
+
+    std::vector<int> threadCounts { 1, 2, 4 };
+    if (QThread::idealThreadCount() > 4) {
+        threadCounts.push_back(QThread::idealThreadCount());
+    }
+
+    double singleThreadedStepTime = 0.0;
+    for (int numThreads : threadCounts) {
+        BoxStacks stacks(numThreads, NUM_STACKS);
+        for (int i = 0; i < NUM_WARMUP_STEPS; i++) {
+            stacks.step(1);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < NUM_STEPS; i++) {
+            stacks.step(1);
+        }
+        double stepTime = (double)timer.nsecsElapsed() / (double)(NUM_STEPS * NSECS_PER_MSEC);
+        if (numThreads == 1) {
+            singleThreadedStepTime = stepTime;
+        }
+        qInfo() << NUM_STACKS * BOXES_PER_STACK << "boxes," << numThreads << "threads:" << stepTime << "ms per substep,"
+                << singleThreadedStepTime / stepTime << "x";
+    }
+}
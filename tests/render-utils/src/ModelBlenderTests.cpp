@@ -0,0 +1,84 @@
+//
+//  ModelBlenderTests.cpp
+//  tests/render-utils/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelBlenderTests.h"
+
+#include <Model.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(ModelBlenderTests)
+
+const uint64_t FRAME_USECS_60HZ = USECS_PER_SECOND / 60;
+const uint64_t FRAME_USECS_90HZ = USECS_PER_SECOND / 90;
+
+void ModelBlenderTests::testBlendVisible() {
+    QVector<float> blended { 0.0f, 0.5f, 1.0f };
+
+    QVERIFY(!ModelBlender::isBlendVisible(blended, blended));
+
+    // changes within the threshold don't show
+    QVector<float> coefficients = blended;
+    coefficients[1] += 0.5f * ModelBlender::BLEND_COEFFICIENT_THRESHOLD;
+    coefficients[2] -= 0.5f * ModelBlender::BLEND_COEFFICIENT_THRESHOLD;
+    QVERIFY(!ModelBlender::isBlendVisible(coefficients, blended));
+
+    // one coefficient beyond it is enough, either way
+    coefficients[0] += 2.0f * ModelBlender::BLEND_COEFFICIENT_THRESHOLD;
+    QVERIFY(ModelBlender::isBlendVisible(coefficients, blended));
+    coefficients[0] = blended[0] - 2.0f * ModelBlender::BLEND_COEFFICIENT_THRESHOLD;
+    QVERIFY(ModelBlender::isBlendVisible(coefficients, blended));
+
+    // as are coefficients that were never blended
+    QVERIFY(ModelBlender::isBlendVisible(blended, QVector<float>()));
+    QVERIFY(ModelBlender::isBlendVisible(blended.mid(0, 2), blended));
+}
+
+void ModelBlenderTests::testBlendInterval() {
+    // models as large as the full rate angle, or larger, are blended every frame
+    QCOMPARE(ModelBlender::evalBlendInterval(ModelBlender::FULL_RATE_BLEND_ANGLE, FRAME_USECS_60HZ), (uint64_t)0);
+    QCOMPARE(ModelBlender::evalBlendInterval(10.0f * ModelBlender::FULL_RATE_BLEND_ANGLE, FRAME_USECS_60HZ), (uint64_t)0);
+
+    // half as large, every other frame of whatever length the frames are
+    float halfAngle = 0.5f * ModelBlender::FULL_RATE_BLEND_ANGLE;
+    QCOMPARE(ModelBlender::evalBlendInterval(halfAngle, FRAME_USECS_60HZ), FRAME_USECS_60HZ);
+    QCOMPARE(ModelBlender::evalBlendInterval(halfAngle, FRAME_USECS_90HZ), FRAME_USECS_90HZ);
+
+    // and no less often than the max decimation, however far or small
+    uint64_t maxInterval = (uint64_t)((ModelBlender::MAX_BLEND_DECIMATION - 1.0f) * (float)FRAME_USECS_60HZ);
+    QCOMPARE(ModelBlender::evalBlendInterval(0.001f * ModelBlender::FULL_RATE_BLEND_ANGLE, FRAME_USECS_60HZ), maxInterval);
+    QCOMPARE(ModelBlender::evalBlendInterval(0.0f, FRAME_USECS_60HZ), maxInterval);
+
+    // the farther, the longer
+    uint64_t lastInterval = 0;
+    for (float priority = ModelBlender::FULL_RATE_BLEND_ANGLE; priority > 0.0f; priority -= 0.05f) {
+        uint64_t interval = ModelBlender::evalBlendInterval(priority, FRAME_USECS_60HZ);
+        QVERIFY(interval >= lastInterval);
+        lastInterval = interval;
+    }
+}
+
+void ModelBlenderTests::testWaitingBlendPriority() {
+    float nearPriority = 2.0f * ModelBlender::FULL_RATE_BLEND_ANGLE;
+    float farPriority = 0.01f * ModelBlender::FULL_RATE_BLEND_ANGLE;
+
+    QCOMPARE(ModelBlender::evalWaitingBlendPriority(farPriority, 0, FRAME_USECS_60HZ), farPriority);
+
+    // a far model that asked a few frames ago goes before a near one that just asked
+    const int FRAMES_WAITED = 3;
+    float waitingPriority = ModelBlender::evalWaitingBlendPriority(farPriority, FRAMES_WAITED * FRAME_USECS_60HZ, FRAME_USECS_60HZ);
+    QVERIFY(waitingPriority > ModelBlender::evalWaitingBlendPriority(nearPriority, 0, FRAME_USECS_60HZ));
+
+    // but not before a near one that waited as long
+    QVERIFY(waitingPriority < ModelBlender::evalWaitingBlendPriority(nearPriority, FRAMES_WAITED * FRAME_USECS_60HZ, FRAME_USECS_60HZ));
+
+    // the wait is counted in frames
+    QCOMPARE(ModelBlender::evalWaitingBlendPriority(farPriority, FRAMES_WAITED * FRAME_USECS_90HZ, FRAME_USECS_90HZ),
+             waitingPriority);
+}
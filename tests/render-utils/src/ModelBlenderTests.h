@@ -0,0 +1,25 @@
+//
+//  ModelBlenderTests.h
+//  tests/render-utils/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelBlenderTests_h
+#define hifi_ModelBlenderTests_h
+
+#include <QtTest/QtTest>
+
+// Decides which blendshape blends are worth running, and when
+class ModelBlenderTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testBlendVisible();
+    void testBlendInterval();
+    void testWaitingBlendPriority();
+};
+
+#endif // hifi_ModelBlenderTests_h
@@ -0,0 +1,208 @@
+//
+//  BatchRecorderTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchRecorderTests.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/null/NullBackend.h>
+#include <render/BatchRecorder.h>
+
+QTEST_MAIN(BatchRecorderTests)
+
+const int NUM_JOBS = 8;
+// About what drawing a few hundred items takes
+const int NUM_COMMANDS = 2000;
+
+struct Recorded {
+    std::atomic<int> withOwnArgs { 0 };
+    std::atomic<int> withEngineArgs { 0 };
+};
+using RecordedPointer = std::shared_ptr<Recorded>;
+
+static std::string getBatchName(int index) {
+    return "RecordJob" + std::to_string(index);
+}
+
+// Records a batch of draws and counts them as rendered triangles, like the item renderers do
+static render::BatchRecorder::Recorder makeRecorder(RenderArgs* engineArgs, int numCommands, const RecordedPointer& recorded) {
+    return [engineArgs, numCommands, recorded](const render::RenderContextPointer& renderContext, gpu::Batch& batch) {
+        for (int i = 0; i < numCommands; ++i) {
+            batch.draw(gpu::TRIANGLES, 3 * (i + 1));
+        }
+        renderContext->args->_details._trianglesRendered += numCommands;
+        if (renderContext->args == engineArgs) {
+            ++recorded->withEngineArgs;
+        } else {
+            ++recorded->withOwnArgs;
+        }
+    };
+}
+
+class RecordJob {
+public:
+    using JobModel = render::Job::Model<RecordJob>;
+
+    RecordJob(int index, bool parallel, const RecordedPointer& recorded) :
+        _name(getBatchName(index)), _parallel(parallel), _recorded(recorded) {}
+
+    void run(const render::RenderContextPointer& renderContext) {
+        render::BatchRecorder::record(renderContext, _name.c_str(), _parallel,
+                                      makeRecorder(renderContext->args, NUM_COMMANDS, _recorded));
+    }
+
+private:
+    std::string _name;
+    bool _parallel;
+    RecordedPointer _recorded;
+};
+
+// Whatever follows it in the task graph could read its output
+class RecordOutputJob {
+public:
+    using JobModel = render::Job::ModelO<RecordOutputJob, int>;
+
+    RecordOutputJob(int index, const RecordedPointer& recorded) : _name(getBatchName(index)), _recorded(recorded) {}
+
+    void run(const render::RenderContextPointer& renderContext, int& output) {
+        render::BatchRecorder::record(renderContext, _name.c_str(), true,
+                                      makeRecorder(renderContext->args, NUM_COMMANDS, _recorded));
+        output = NUM_COMMANDS;
+    }
+
+private:
+    std::string _name;
+    RecordedPointer _recorded;
+};
+
+static gpu::FramePointer runFrame(render::RenderEngine& engine, const gpu::ContextPointer& gpuContext, RenderArgs& args) {
+    engine.getRenderContext()->args = &args;
+    gpuContext->beginFrame();
+    engine.run();
+    return gpuContext->endFrame();
+}
+
+static void verifyBatches(const gpu::FramePointer& frame, int numBatches) {
+    QCOMPARE((int)frame->batches.size(), numBatches);
+    for (int i = 0; i < numBatches; ++i) {
+        QCOMPARE(frame->batches[i]->getName(), getBatchName(i));
+        QCOMPARE((int)frame->batches[i]->getCommands().size(), NUM_COMMANDS);
+    }
+}
+
+void BatchRecorderTests::initTestCase() {
+    gpu::Context::init<gpu::null::Backend>();
+}
+
+void BatchRecorderTests::testPendingFrameBatches() {
+    auto gpuContext = std::make_shared<gpu::Context>();
+    gpuContext->beginFrame();
+
+    auto first = gpu::Context::acquireBatch("first");
+    auto pending = gpu::Context::acquireBatch("pending");
+    auto last = gpu::Context::acquireBatch("last");
+    gpuContext->appendFrameBatch(first);
+    QVERIFY(gpuContext->appendPendingFrameBatch(pending));
+    gpuContext->appendFrameBatch(last);
+
+    std::atomic<bool> finished { false };
+    std::thread recordingThread([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        pending->draw(gpu::TRIANGLES, 3);
+        finished = true;
+        gpuContext->finishPendingFrameBatch();
+    });
+
+    // Waits for the pending batch, which keeps its place
+    auto frame = gpuContext->endFrame();
+    QVERIFY(finished);
+    QCOMPARE((int)frame->batches.size(), 3);
+    QCOMPARE(frame->batches[0]->getName(), std::string("first"));
+    QCOMPARE(frame->batches[1]->getName(), std::string("pending"));
+    QCOMPARE((int)frame->batches[1]->getCommands().size(), 1);
+    QCOMPARE(frame->batches[2]->getName(), std::string("last"));
+    recordingThread.join();
+
+    // Outside of a frame there is no place to take
+    QVERIFY(!gpuContext->appendPendingFrameBatch(gpu::Context::acquireBatch("outside")));
+}
+
+void BatchRecorderTests::testBatchOrder() {
+    auto gpuContext = std::make_shared<gpu::Context>();
+    auto recorded = std::make_shared<Recorded>();
+
+    render::RenderEngine engine;
+    // every other job records on this thread
+    for (int i = 0; i < NUM_JOBS; ++i) {
+        engine.addJob<RecordJob>(getBatchName(i), i, i % 2 == 0, recorded);
+    }
+
+    RenderArgs args(gpuContext);
+    auto frame = runFrame(engine, gpuContext, args);
+    verifyBatches(frame, NUM_JOBS);
+    QCOMPARE(recorded->withOwnArgs.load(), NUM_JOBS / 2);
+    QCOMPARE(recorded->withEngineArgs.load(), NUM_JOBS / 2);
+
+    // What the batches rendered is added up in the args of the engine
+    QCOMPARE(args._details._trianglesRendered, NUM_JOBS * NUM_COMMANDS);
+
+    // and again the next frame
+    args._details = render::RenderDetails();
+    frame = runFrame(engine, gpuContext, args);
+    verifyBatches(frame, NUM_JOBS);
+    QCOMPARE(args._details._trianglesRendered, NUM_JOBS * NUM_COMMANDS);
+}
+
+void BatchRecorderTests::testJobsWithOutputs() {
+    auto gpuContext = std::make_shared<gpu::Context>();
+    auto recorded = std::make_shared<Recorded>();
+
+    render::RenderEngine engine;
+    engine.addJob<RecordJob>(getBatchName(0), 0, true, recorded);
+    engine.addJob<RecordOutputJob>(getBatchName(1), 1, recorded);
+    engine.addJob<RecordJob>(getBatchName(2), 2, true, recorded);
+
+    RenderArgs args(gpuContext);
+    auto frame = runFrame(engine, gpuContext, args);
+    verifyBatches(frame, 3);
+    QCOMPARE(recorded->withOwnArgs.load(), 2);
+    QCOMPARE(recorded->withEngineArgs.load(), 1);
+    QCOMPARE(args._details._trianglesRendered, 3 * NUM_COMMANDS);
+}
+
+static void benchmarkRecording(bool parallel) {
+    auto gpuContext = std::make_shared<gpu::Context>();
+    auto recorded = std::make_shared<Recorded>();
+
+    // Both eyes and the shadow cascades
+    render::RenderEngine engine;
+    for (int i = 0; i < NUM_JOBS; ++i) {
+        engine.addJob<RecordJob>(getBatchName(i), i, parallel, recorded);
+    }
+
+    RenderArgs args(gpuContext);
+    gpu::FramePointer frame;
+    QBENCHMARK {
+        frame = runFrame(engine, gpuContext, args);
+    }
+    verifyBatches(frame, NUM_JOBS);
+}
+
+void BatchRecorderTests::benchmarkSerialRecording() {
+    benchmarkRecording(false);
+}
+
+void BatchRecorderTests::benchmarkParallelRecording() {
+    benchmarkRecording(true);
+}
@@ -0,0 +1,28 @@
+//
+//  BatchRecorderTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_BatchRecorderTests_h
+#define hifi_render_BatchRecorderTests_h
+
+#include <QtTest/QtTest>
+
+// Records the batches of render jobs on worker threads, against the null gpu backend
+class BatchRecorderTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testPendingFrameBatches();
+    void testBatchOrder();
+    void testJobsWithOutputs();
+    void benchmarkSerialRecording();
+    void benchmarkParallelRecording();
+};
+
+#endif // hifi_render_BatchRecorderTests_h
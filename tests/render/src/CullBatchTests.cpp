@@ -0,0 +1,217 @@
+//
+//  CullBatchTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CullBatchTests.h"
+
+#include <atomic>
+
+#include <glm/gtx/norm.hpp>
+
+#include <GLMHelpers.h>
+#include <render/CullBatch.h>
+
+QTEST_MAIN(CullBatchTests)
+
+// Enough for the batch to be split across worker threads
+const int NUM_BOUNDS = 50000;
+const float SCENE_SIZE = 200.0f;
+
+static ViewFrustum makeFrustum(const glm::vec3& position, float yaw, float fieldOfView, float farClip) {
+    ViewFrustum frustum;
+    frustum.setPosition(position);
+    frustum.setOrientation(glm::angleAxis(glm::radians(yaw), Vectors::UNIT_Y));
+    frustum.setProjection(fieldOfView, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, farClip);
+    frustum.calculate();
+    return frustum;
+}
+
+static float randomFloat(float min, float max) {
+    return min + (max - min) * ((float)qrand() / (float)RAND_MAX);
+}
+
+static std::vector<AABox> makeBounds(int numBounds) {
+    qsrand(7);
+    std::vector<AABox> bounds;
+    for (int i = 0; i < numBounds; ++i) {
+        glm::vec3 corner(randomFloat(-SCENE_SIZE, SCENE_SIZE), randomFloat(-10.0f, 10.0f), randomFloat(-SCENE_SIZE, SCENE_SIZE));
+        // some are points
+        glm::vec3 dimensions = (i % 17 == 0) ? glm::vec3(0.0f) :
+            glm::vec3(randomFloat(0.01f, 20.0f), randomFloat(0.01f, 20.0f), randomFloat(0.01f, 20.0f));
+        bounds.push_back(AABox(corner, dimensions));
+    }
+    return bounds;
+}
+
+void CullBatchTests::testMatchesViewFrustum() {
+    auto bounds = makeBounds(NUM_BOUNDS);
+
+    // a camera, another looking the other way, and a wide one that leaves out what the camera sees
+    ViewFrustum frustums[] = {
+        makeFrustum(glm::vec3(0.0f), 0.0f, 60.0f, 150.0f),
+        makeFrustum(glm::vec3(10.0f, 2.0f, -5.0f), 135.0f, 45.0f, 300.0f),
+        makeFrustum(glm::vec3(0.0f), 10.0f, 120.0f, 300.0f)
+    };
+    const int NUM_VIEWS = 3;
+    render::CullBatch::View views[NUM_VIEWS];
+    for (int i = 0; i < NUM_VIEWS; ++i) {
+        views[i].frustum = &frustums[i];
+    }
+    views[2].antiFrustum = &frustums[0];
+
+    // a batch small enough to stay on this thread, and one that doesn't
+    for (int numBounds : { 1000, NUM_BOUNDS }) {
+        render::CullBatch batch;
+        for (int i = 0; i < numBounds; ++i) {
+            batch.add(bounds[i]);
+        }
+        QCOMPARE(batch.size(), (size_t)numBounds);
+
+        std::vector<render::CullBatch::ViewMask> masks;
+        render::CullBatch::Stats stats;
+        batch.cull(nullptr, views, NUM_VIEWS, masks, stats);
+        QCOMPARE(masks.size(), (size_t)numBounds);
+
+        int outOfView[NUM_VIEWS] = { 0, 0, 0 };
+        for (int i = 0; i < numBounds; ++i) {
+            QCOMPARE(batch.getBound(i), bounds[i]);
+            for (int view = 0; view < NUM_VIEWS; ++view) {
+                bool expected = frustums[view].boxIntersectsFrustum(bounds[i]) &&
+                    !(views[view].antiFrustum && views[view].antiFrustum->boxInsideFrustum(bounds[i]));
+                QCOMPARE((bool)(masks[i] & (1 << view)), expected);
+                outOfView[view] += expected ? 0 : 1;
+            }
+        }
+        for (int view = 0; view < NUM_VIEWS; ++view) {
+            QCOMPARE(stats.outOfView[view], outOfView[view]);
+            QCOMPARE(stats.tooSmall[view], 0);
+            // the views see some of the bounds but not all of them
+            QVERIFY(outOfView[view] > 0 && outOfView[view] < numBounds);
+        }
+    }
+}
+
+void CullBatchTests::testCullFunctor() {
+    auto bounds = makeBounds(NUM_BOUNDS);
+    ViewFrustum frustum = makeFrustum(glm::vec3(0.0f), 0.0f, 60.0f, 150.0f);
+
+    std::atomic<int> numCalls { 0 };
+    render::CullBatch::View views[2];
+    views[0].frustum = &frustum;
+    views[0].functor = [&](const RenderArgs* args, const AABox& bound) {
+        ++numCalls;
+        return glm::length2(bound.getDimensions()) > 100.0f;
+    };
+    // without a frustum the functor sees them all
+    views[1].functor = [](const RenderArgs* args, const AABox& bound) {
+        return bound.getCorner().x > 0.0f;
+    };
+
+    render::CullBatch batch;
+    batch.reserve(bounds.size());
+    for (const auto& bound : bounds) {
+        batch.add(bound);
+    }
+    std::vector<render::CullBatch::ViewMask> masks;
+    render::CullBatch::Stats stats;
+    batch.cull(nullptr, views, 2, masks, stats);
+
+    int inFrustum = 0;
+    int tooSmall = 0;
+    int outOfView = 0;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        bool isInFrustum = frustum.boxIntersectsFrustum(bounds[i]);
+        bool isBigEnough = glm::length2(bounds[i].getDimensions()) > 100.0f;
+        inFrustum += isInFrustum ? 1 : 0;
+        tooSmall += (isInFrustum && !isBigEnough) ? 1 : 0;
+        QCOMPARE((bool)(masks[i] & 1), isInFrustum && isBigEnough);
+
+        bool isPositive = bounds[i].getCorner().x > 0.0f;
+        outOfView += isPositive ? 0 : 1;
+        QCOMPARE((bool)(masks[i] & 2), isPositive);
+    }
+    QCOMPARE(numCalls.load(), inFrustum);
+    QCOMPARE(stats.outOfView[0], (int)bounds.size() - inFrustum);
+    QCOMPARE(stats.tooSmall[0], tooSmall);
+    QCOMPARE(stats.outOfView[1], 0);
+    QCOMPARE(stats.tooSmall[1], outOfView);
+}
+
+void CullBatchTests::testEmptyBatch() {
+    ViewFrustum frustum = makeFrustum(glm::vec3(0.0f), 0.0f, 60.0f, 150.0f);
+    render::CullBatch::View view;
+    view.frustum = &frustum;
+
+    render::CullBatch batch;
+    std::vector<render::CullBatch::ViewMask> masks { 1, 2, 3 };
+    render::CullBatch::Stats stats;
+    batch.cull(nullptr, &view, 1, masks, stats);
+    QVERIFY(masks.empty());
+    QCOMPARE(stats.outOfView[0], 0);
+
+    // cleared batches are reused
+    batch.add(AABox(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f));
+    batch.clear();
+    batch.add(AABox(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f));
+    batch.cull(nullptr, &view, 1, masks, stats);
+    QCOMPARE(masks.size(), (size_t)1);
+    QCOMPARE(stats.outOfView[0], (int)(masks[0] == 0));
+}
+
+// The main view and 4 shadow cascades
+static void makeViews(std::vector<ViewFrustum>& frustums) {
+    frustums.push_back(makeFrustum(glm::vec3(0.0f), 0.0f, 60.0f, 150.0f));
+    for (int i = 0; i < 4; ++i) {
+        frustums.push_back(makeFrustum(glm::vec3(0.0f, 50.0f, 0.0f), 0.0f, 30.0f + 20.0f * i, 50.0f * (i + 1)));
+    }
+}
+
+void CullBatchTests::benchmarkViewFrustumCulling() {
+    auto bounds = makeBounds(NUM_BOUNDS);
+    std::vector<ViewFrustum> frustums;
+    makeViews(frustums);
+
+    int numInView = 0;
+    QBENCHMARK {
+        numInView = 0;
+        for (const auto& frustum : frustums) {
+            for (const auto& bound : bounds) {
+                numInView += frustum.boxIntersectsFrustum(bound) ? 1 : 0;
+            }
+        }
+    }
+    qDebug() << "bounds in view:" << numInView;
+}
+
+void CullBatchTests::benchmarkBatchCulling() {
+    auto bounds = makeBounds(NUM_BOUNDS);
+    std::vector<ViewFrustum> frustums;
+    makeViews(frustums);
+    std::vector<render::CullBatch::View> views(frustums.size());
+    for (size_t i = 0; i < frustums.size(); ++i) {
+        views[i].frustum = &frustums[i];
+    }
+
+    render::CullBatch batch;
+    std::vector<render::CullBatch::ViewMask> masks;
+    render::CullBatch::Stats stats;
+    int numInView = 0;
+    QBENCHMARK {
+        // the bounds are packed every frame
+        batch.clear();
+        for (const auto& bound : bounds) {
+            batch.add(bound);
+        }
+        batch.cull(nullptr, views.data(), (int)views.size(), masks, stats);
+    }
+    for (size_t i = 0; i < views.size(); ++i) {
+        numInView += NUM_BOUNDS - stats.outOfView[i];
+    }
+    qDebug() << "bounds in view:" << numInView;
+}
@@ -0,0 +1,27 @@
+//
+//  CullBatchTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_CullBatchTests_h
+#define hifi_render_CullBatchTests_h
+
+#include <QtTest/QtTest>
+
+// Culls packed item bounds against several views at once, 8 at a time and on worker threads
+class CullBatchTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testMatchesViewFrustum();
+    void testCullFunctor();
+    void testEmptyBatch();
+    void benchmarkViewFrustumCulling();
+    void benchmarkBatchCulling();
+};
+
+#endif // hifi_render_CullBatchTests_h
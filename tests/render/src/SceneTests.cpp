@@ -0,0 +1,239 @@
+//
+//  SceneTests.cpp
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneTests.h"
+
+#include <thread>
+
+#include <render/Scene.h>
+
+QTEST_MAIN(SceneTests)
+
+const int NUM_ITEMS = 10000;
+
+// What several items read their key from, like a material that is shared by the parts of models
+class TestMaterial {
+public:
+    int numKeyUpdates { 0 };
+    std::thread::id keyUpdateThread;
+};
+
+// A box that moves around, or leaves the spatial tree when it is made non-spatial
+class TestItem {
+public:
+    using Pointer = std::shared_ptr<TestItem>;
+
+    AABox bound;
+    bool isSpatial { true };
+    std::vector<int> updates;
+    std::shared_ptr<TestMaterial> material;
+};
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const TestItem::Pointer& item) {
+        if (item->isSpatial) {
+            return ItemKey::Builder::opaqueShape().build();
+        }
+        return ItemKey::Builder::background().build();
+    }
+    template <> const Item::Bound payloadGetBound(const TestItem::Pointer& item) {
+        return item->bound;
+    }
+}
+
+using TestPayload = render::Payload<TestItem>;
+
+static std::vector<render::ItemID> addItems(render::Scene& scene, std::vector<TestItem::Pointer>& items) {
+    std::vector<render::ItemID> ids;
+    render::Transaction transaction;
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        auto item = std::make_shared<TestItem>();
+        item->bound = AABox(glm::vec3((float)(i % 100), 0.0f, (float)(i / 100)), 0.5f);
+        items.push_back(item);
+
+        auto id = scene.allocateID();
+        transaction.resetItem(id, std::make_shared<TestPayload>(item));
+        ids.push_back(id);
+    }
+    scene.enqueueTransaction(transaction);
+    scene.enqueueFrame();
+    scene.processTransactionQueue();
+    return ids;
+}
+
+// Most of the items move a little, some far, some grow, and some leave the spatial tree or come back in
+static void moveItems(render::Transaction& transaction, const std::vector<render::ItemID>& ids, int frame, bool independent) {
+    for (int i = 0; i < (int)ids.size(); ++i) {
+        auto func = [i, frame](TestItem& item) {
+            glm::vec3 offset(0.01f * (float)frame, 0.0f, 0.0f);
+            if (i % 10 == 0) {
+                offset.y = 100.0f * (float)frame;
+            }
+            float size = (i % 7 == 0) ? 0.5f + (float)frame : 0.5f;
+            item.bound = AABox(glm::vec3((float)(i % 100), 0.0f, (float)(i / 100)) + offset, size);
+            item.isSpatial = (i + frame) % 13 != 0;
+        };
+        if (independent) {
+            transaction.updateIndependentItem<TestItem>(ids[i], func);
+        } else {
+            transaction.updateItem<TestItem>(ids[i], func);
+        }
+    }
+}
+
+void SceneTests::testParallelUpdatesMatchSerial() {
+    render::Scene serialScene(glm::vec3(-16384.0f), 32768.0f);
+    render::Scene parallelScene(glm::vec3(-16384.0f), 32768.0f);
+    std::vector<TestItem::Pointer> serialItems;
+    std::vector<TestItem::Pointer> parallelItems;
+    auto serialIDs = addItems(serialScene, serialItems);
+    auto parallelIDs = addItems(parallelScene, parallelItems);
+
+    for (int frame = 1; frame <= 3; ++frame) {
+        render::Transaction serialTransaction;
+        moveItems(serialTransaction, serialIDs, frame, false);
+        serialScene.enqueueTransaction(serialTransaction);
+        serialScene.enqueueFrame();
+        serialScene.processTransactionQueue();
+        QCOMPARE(serialScene.getTransactionStats().numParallelUpdates, (uint32_t)0);
+
+        render::Transaction parallelTransaction;
+        moveItems(parallelTransaction, parallelIDs, frame, true);
+        parallelScene.enqueueTransaction(parallelTransaction);
+        parallelScene.enqueueFrame();
+        parallelScene.processTransactionQueue();
+        QCOMPARE(parallelScene.getTransactionStats().numParallelUpdates, (uint32_t)NUM_ITEMS);
+
+        // the items are in the same cells of the spatial tree, with the same keys
+        QCOMPARE(parallelScene.getTransactionStats().numSpatialResets, serialScene.getTransactionStats().numSpatialResets);
+        QCOMPARE(parallelScene.getNonspatialSet().size(), serialScene.getNonspatialSet().size());
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            const auto& serialItem = serialScene.getItem(serialIDs[i]);
+            const auto& parallelItem = parallelScene.getItem(parallelIDs[i]);
+            QVERIFY(serialItem.getKey() == parallelItem.getKey());
+            auto serialLocation = serialScene.getSpatialTree().getCellLocation(serialItem.getCell());
+            auto parallelLocation = parallelScene.getSpatialTree().getCellLocation(parallelItem.getCell());
+            QVERIFY(serialLocation == parallelLocation);
+            QCOMPARE(parallelScene.getNonspatialSet().count(parallelIDs[i]), serialScene.getNonspatialSet().count(serialIDs[i]));
+        }
+    }
+}
+
+void SceneTests::testUpdateOrder() {
+    render::Scene scene(glm::vec3(-16384.0f), 32768.0f);
+    std::vector<TestItem::Pointer> items;
+    auto ids = addItems(scene, items);
+
+    // an item with an update that has to be applied on the render thread gets all its updates applied there, in order
+    render::Transaction transaction;
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        transaction.updateIndependentItem<TestItem>(ids[i], [](TestItem& item) { item.updates.push_back(1); });
+        if (i % 2 == 0) {
+            transaction.updateItem<TestItem>(ids[i], [](TestItem& item) { item.updates.push_back(2); });
+        }
+        transaction.updateIndependentItem<TestItem>(ids[i], [](TestItem& item) { item.updates.push_back(3); });
+    }
+    scene.enqueueTransaction(transaction);
+    scene.enqueueFrame();
+    scene.processTransactionQueue();
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        std::vector<int> expected = (i % 2 == 0) ? std::vector<int>{ 1, 2, 3 } : std::vector<int>{ 1, 3 };
+        QVERIFY(items[i]->updates == expected);
+    }
+    // the independent updates that come before the first one that isn't are still applied by the tasks
+    QCOMPARE(scene.getTransactionStats().numParallelUpdates, (uint32_t)(NUM_ITEMS + NUM_ITEMS / 2));
+}
+
+void SceneTests::testSharedMaterialUpdates() {
+    render::Scene scene(glm::vec3(-16384.0f), 32768.0f);
+    std::vector<TestItem::Pointer> items;
+    auto ids = addItems(scene, items);
+
+    // every item of the scene reads its key from the same material, like the parts of the models do
+    auto material = std::make_shared<TestMaterial>();
+    for (auto& item : items) {
+        item->material = material;
+    }
+
+    // the items move on worker threads, and then update their keys from the material on this one
+    const int NUM_FRAMES = 3;
+    for (int frame = 1; frame <= NUM_FRAMES; ++frame) {
+        render::Transaction transaction;
+        moveItems(transaction, ids, frame, true);
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            transaction.updateItem<TestItem>(ids[i], [](TestItem& item) {
+                item.material->numKeyUpdates++;
+                item.material->keyUpdateThread = std::this_thread::get_id();
+                item.updates.push_back((int)item.bound.getScale().x);
+            });
+        }
+        scene.enqueueTransaction(transaction);
+        scene.enqueueFrame();
+        scene.processTransactionQueue();
+
+        QCOMPARE(scene.getTransactionStats().numParallelUpdates, (uint32_t)NUM_ITEMS);
+        QCOMPARE(material->numKeyUpdates, frame * NUM_ITEMS);
+        QVERIFY(material->keyUpdateThread == std::this_thread::get_id());
+    }
+
+    // each key update saw its item once it had moved
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        QCOMPARE((int)items[i]->updates.size(), NUM_FRAMES);
+        for (int frame = 1; frame <= NUM_FRAMES; ++frame) {
+            int size = (i % 7 == 0) ? (int)(0.5f + (float)frame) : 0;
+            QCOMPARE(items[i]->updates[frame - 1], size);
+        }
+    }
+}
+
+void SceneTests::testTransactionStats() {
+    render::Scene scene(glm::vec3(-16384.0f), 32768.0f);
+    std::vector<TestItem::Pointer> items;
+    auto ids = addItems(scene, items);
+
+    // a few updates are applied on the render thread, and items that don't move don't reach the spatial tree
+    render::Transaction transaction;
+    for (int i = 0; i < 10; ++i) {
+        transaction.updateIndependentItem<TestItem>(ids[i], [](TestItem& item) {});
+    }
+    scene.enqueueTransaction(transaction);
+    scene.enqueueFrame();
+    scene.processTransactionQueue();
+
+    auto stats = scene.getTransactionStats();
+    QCOMPARE(stats.numUpdates, (uint32_t)10);
+    QCOMPARE(stats.numParallelUpdates, (uint32_t)0);
+    QCOMPARE(stats.numSpatialResets, (uint32_t)0);
+}
+
+static void benchmarkUpdates(bool independent) {
+    render::Scene scene(glm::vec3(-16384.0f), 32768.0f);
+    std::vector<TestItem::Pointer> items;
+    auto ids = addItems(scene, items);
+
+    int frame = 0;
+    QBENCHMARK {
+        render::Transaction transaction;
+        moveItems(transaction, ids, ++frame, independent);
+        scene.enqueueTransaction(transaction);
+        scene.enqueueFrame();
+        scene.processTransactionQueue();
+    }
+    qDebug() << "transaction usecs:" << scene.getTransactionStats().usecs;
+}
+
+void SceneTests::benchmarkSerialUpdates() {
+    benchmarkUpdates(false);
+}
+
+void SceneTests::benchmarkParallelUpdates() {
+    benchmarkUpdates(true);
+}
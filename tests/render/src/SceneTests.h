@@ -0,0 +1,28 @@
+//
+//  SceneTests.h
+//  tests/render/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_SceneTests_h
+#define hifi_render_SceneTests_h
+
+#include <QtTest/QtTest>
+
+// Applies the item updates of the scene transactions, on worker threads for the independent ones
+class SceneTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testParallelUpdatesMatchSerial();
+    void testUpdateOrder();
+    void testSharedMaterialUpdates();
+    void testTransactionStats();
+    void benchmarkSerialUpdates();
+    void benchmarkParallelUpdates();
+};
+
+#endif // hifi_render_SceneTests_h
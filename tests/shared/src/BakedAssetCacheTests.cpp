@@ -0,0 +1,120 @@
+//
+//  BakedAssetCacheTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakedAssetCacheTests.h"
+
+#include <shared/BakedAssetCache.h>
+
+QTEST_GUILESS_MAIN(BakedAssetCacheTests)
+
+using namespace cache;
+
+static const QByteArray SOURCE { "the content of a texture" };
+
+static BakedAssetCachePointer makeCache(const QString& location) {
+    auto result = std::make_shared<BakedAssetCache>(location.toStdString());
+    result->initialize();
+    return result;
+}
+
+static BakedAssetCache::Entries makeEntries() {
+    return {
+        { "_COMPRESSED_RGBA_S3TC_DXT5_EXT.ktx", QByteArray(1024, 'a') },
+        { ".ktx", QByteArray(4096, 'b') },
+        { "empty", QByteArray() },
+    };
+}
+
+void BakedAssetCacheTests::testKeys() {
+    auto key = BakedAssetCache::makeKey("texture", 1, SOURCE);
+    QCOMPARE(BakedAssetCache::makeKey("texture", 1, SOURCE), key);
+    QVERIFY(key.find('.') == std::string::npos);
+
+    // Anything the result depends on changes the key
+    QVERIFY(BakedAssetCache::makeKey("model", 1, SOURCE) != key);
+    QVERIFY(BakedAssetCache::makeKey("texture", 2, SOURCE) != key);
+    QVERIFY(BakedAssetCache::makeKey("texture", 1, SOURCE + "!") != key);
+    QVERIFY(BakedAssetCache::makeKey("texture", 1, SOURCE, "options") != key);
+
+    // Moving bytes between the options and the source does too
+    QVERIFY(BakedAssetCache::makeKey("texture", 1, "bc", "a") != BakedAssetCache::makeKey("texture", 1, "c", "ab"));
+}
+
+void BakedAssetCacheTests::testDefaultDirectories() {
+    // Each tool evicts from its own folder
+    auto interfaceDirectory = BakedAssetCache::getDefaultDirectory("interface");
+    auto ovenDirectory = BakedAssetCache::getDefaultDirectory("oven");
+    QVERIFY(interfaceDirectory != ovenDirectory);
+    QVERIFY(!interfaceDirectory.startsWith(ovenDirectory));
+    QVERIFY(!ovenDirectory.startsWith(interfaceDirectory));
+    QCOMPARE(QDir(interfaceDirectory).dirName(), QString("interface"));
+}
+
+void BakedAssetCacheTests::testStoreAndLoad() {
+    auto cache = makeCache(_testDir.path());
+    auto key = BakedAssetCache::makeKey("texture", 1, SOURCE);
+
+    BakedAssetCache::Entries entries;
+    QVERIFY(!cache->load(key, entries));
+    QCOMPARE(cache->getNumMisses(), (size_t)1);
+
+    QVERIFY(cache->store(key, makeEntries()));
+    QVERIFY(cache->load(key, entries));
+    QCOMPARE(cache->getNumHits(), (size_t)1);
+    QVERIFY(entries == makeEntries());
+
+    // Storing again keeps the result that is there
+    QVERIFY(cache->store(key, { { "other", QByteArray(16, 'c') } }));
+    QVERIFY(cache->load(key, entries));
+    QVERIFY(entries == makeEntries());
+}
+
+void BakedAssetCacheTests::testPersistence() {
+    auto key = BakedAssetCache::makeKey("model", 1, SOURCE);
+    {
+        auto cache = makeCache(_testDir.path());
+        QVERIFY(cache->store(key, makeEntries()));
+    }
+
+    // Another run, or another tool, finds it
+    auto cache = makeCache(_testDir.path());
+    BakedAssetCache::Entries entries;
+    QVERIFY(cache->load(key, entries));
+    QVERIFY(entries == makeEntries());
+}
+
+void BakedAssetCacheTests::testInvalidFiles() {
+    auto key = BakedAssetCache::makeKey("model", 2, SOURCE);
+    auto truncatedKey = BakedAssetCache::makeKey("model", 3, SOURCE);
+    {
+        auto cache = makeCache(_testDir.path());
+        QVERIFY(cache->store(key, makeEntries()));
+        QVERIFY(cache->store(truncatedKey, makeEntries()));
+    }
+
+    QDir dir(_testDir.path());
+    {
+        QFile file(dir.absoluteFilePath(QString::fromStdString(key) + "." + QString::fromStdString(BakedAssetCache::EXTENSION)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("not a baked asset");
+    }
+    {
+        QFile file(dir.absoluteFilePath(QString::fromStdString(truncatedKey) + "." + QString::fromStdString(BakedAssetCache::EXTENSION)));
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.resize(file.size() / 2));
+    }
+
+    auto cache = makeCache(_testDir.path());
+    BakedAssetCache::Entries entries;
+    QVERIFY(!cache->load(key, entries));
+    QVERIFY(!cache->load(truncatedKey, entries));
+    QVERIFY(entries.empty());
+    QCOMPARE(cache->getNumMisses(), (size_t)2);
+}
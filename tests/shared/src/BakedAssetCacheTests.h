@@ -0,0 +1,30 @@
+//
+//  BakedAssetCacheTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakedAssetCacheTests_h
+#define hifi_BakedAssetCacheTests_h
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+
+class BakedAssetCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testKeys();
+    void testDefaultDirectories();
+    void testStoreAndLoad();
+    void testPersistence();
+    void testInvalidFiles();
+
+private:
+    QTemporaryDir _testDir;
+};
+
+#endif // hifi_BakedAssetCacheTests_h
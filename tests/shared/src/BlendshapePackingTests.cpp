@@ -13,6 +13,8 @@
 
 #include <vector>
 
+#include <QElapsedTimer>
+
 #include <test-utils/QTestExtensions.h>
 
 #include <GLMHelpers.h>
@@ -55,6 +57,22 @@ static void packBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, Blends
     }
 }
 
+static void packBlendshapeOffsetsSoA_ref(const float* accumulated, int stride, BlendshapeOffsetPacked* packed, int size) {
+    for (int i = 0; i < size; ++i) {
+        BlendshapeOffsetUnpacked unpacked;
+        unpacked.positionOffset = glm::vec3(accumulated[i], accumulated[stride + i], accumulated[2 * stride + i]);
+        unpacked.normalOffset = glm::vec3(accumulated[3 * stride + i], accumulated[4 * stride + i], accumulated[5 * stride + i]);
+        unpacked.tangentOffset = glm::vec3(accumulated[6 * stride + i], accumulated[7 * stride + i], accumulated[8 * stride + i]);
+        packBlendshapeOffsetTo_Pos_F32_3xSN10_Nor_3xSN10_Tan_3xSN10(packed[i].packedPosNorTan, unpacked);
+    }
+}
+
+static void accumulateBlendshapeOffsets_ref(float* accumulated, const float* offsets, float coefficient, int size) {
+    for (int i = 0; i < size; ++i) {
+        accumulated[i] += offsets[i] * coefficient;
+    }
+}
+
 #if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
 //
 // Runtime CPU dispatch
@@ -62,6 +80,8 @@ static void packBlendshapeOffsets_ref(BlendshapeOffsetUnpacked* unpacked, Blends
 #include <CPUDetect.h>
 
 void packBlendshapeOffsets_AVX2(float (*unpacked)[9], uint32_t (*packed)[4], int size);
+void packBlendshapeOffsetsSoA_AVX2(const float* accumulated, int stride, uint32_t (*packed)[4], int size);
+void accumulateBlendshapeOffsets_AVX2(float* accumulated, const float* offsets, float coefficient, int size);
 
 static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, BlendshapeOffsetPacked* packed, int size) {
     static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
@@ -74,8 +94,28 @@ static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, Blendshape
     }
 }
 
+static void packBlendshapeOffsetsSoA(const float* accumulated, int stride, BlendshapeOffsetPacked* packed, int size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        packBlendshapeOffsetsSoA_AVX2(accumulated, stride, (uint32_t(*)[4])packed, size);
+    } else {
+        packBlendshapeOffsetsSoA_ref(accumulated, stride, packed, size);
+    }
+}
+
+static void accumulateBlendshapeOffsets(float* accumulated, const float* offsets, float coefficient, int size) {
+    static bool _cpuSupportsAVX2 = cpuSupportsAVX2();
+    if (_cpuSupportsAVX2) {
+        accumulateBlendshapeOffsets_AVX2(accumulated, offsets, coefficient, size);
+    } else {
+        accumulateBlendshapeOffsets_ref(accumulated, offsets, coefficient, size);
+    }
+}
+
 #else   // portable reference code
 static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
+static auto& packBlendshapeOffsetsSoA = packBlendshapeOffsetsSoA_ref;
+static auto& accumulateBlendshapeOffsets = accumulateBlendshapeOffsets_ref;
 #endif
 
 void comparePacked(BlendshapeOffsetPacked& ref, BlendshapeOffsetPacked& tst) {
@@ -146,3 +186,146 @@ void BlendshapePackingTests::testAVX2() {
         }
     }
 }
+
+void BlendshapePackingTests::testSoAAVX2() {
+
+    for (int numBlendshapeOffsets = 0; numBlendshapeOffsets < 1024; ++numBlendshapeOffsets) {
+
+        // accumulated as 9 arrays, with some room past the end that must be left alone
+        const int stride = numBlendshapeOffsets + 3;
+        std::vector<float> offsets(9 * stride);
+        std::vector<float> accumulated1(9 * stride);
+        for (int i = 0; i < 9 * stride; ++i) {
+            offsets[i] = glm::linearRand(-2.0f, 2.0f);
+            accumulated1[i] = glm::linearRand(-2.0f, 2.0f);
+        }
+        std::vector<float> accumulated2 = accumulated1;
+
+        accumulateBlendshapeOffsets_ref(accumulated1.data(), offsets.data(), 0.75f, numBlendshapeOffsets);
+        accumulateBlendshapeOffsets(accumulated2.data(), offsets.data(), 0.75f, numBlendshapeOffsets);
+        for (int i = 0; i < 9 * stride; ++i) {
+            QCOMPARE_WITH_ABS_ERROR(accumulated2[i], accumulated1[i], 1.0e-5f);
+        }
+
+        std::vector<BlendshapeOffsetPacked> packedBlendshapeOffsets1(numBlendshapeOffsets + 1);
+        std::vector<BlendshapeOffsetPacked> packedBlendshapeOffsets2(numBlendshapeOffsets + 1);
+        packedBlendshapeOffsets2[numBlendshapeOffsets].packedPosNorTan = glm::uvec4(0xdeadbeef);
+
+        packBlendshapeOffsetsSoA_ref(accumulated1.data(), stride, packedBlendshapeOffsets1.data(), numBlendshapeOffsets);
+        packBlendshapeOffsetsSoA(accumulated1.data(), stride, packedBlendshapeOffsets2.data(), numBlendshapeOffsets);
+
+        for (int i = 0; i < numBlendshapeOffsets; ++i) {
+            comparePacked(packedBlendshapeOffsets1[i], packedBlendshapeOffsets2[i]);
+        }
+        QVERIFY(packedBlendshapeOffsets2[numBlendshapeOffsets].packedPosNorTan == glm::uvec4(0xdeadbeef));
+    }
+}
+
+// Blends a face like those of the avatars at a meetup: most blendshapes move a region of the face densely, a few move
+// scattered vertices. The blendshapes are accumulated as the Blender did before, through the AoS offsets one vertex at a time,
+// then as it does now, through the SoA offsets laid out when the model loads.
+void BlendshapePackingTests::benchmarkBlending() {
+    const int NUM_VERTICES = 20000;
+    const int NUM_BLENDSHAPES = 52;
+    const int NUM_SPARSE_BLENDSHAPES = 8;
+    const int REGION_SIZE = 2000;
+    const int NUM_BLENDS = 200;
+
+    struct Blendshape {
+        std::vector<int> indices;
+        std::vector<glm::vec3> vertices, normals, tangents;
+        bool isDense;
+        int firstVertex;
+        std::vector<float> offsets; // 9 arrays of as many offsets as indices, or as the dense region
+    };
+    std::vector<Blendshape> blendshapes(NUM_BLENDSHAPES);
+    for (int b = 0; b < NUM_BLENDSHAPES; ++b) {
+        auto& blendshape = blendshapes[b];
+        blendshape.isDense = b >= NUM_SPARSE_BLENDSHAPES;
+        blendshape.firstVertex = glm::linearRand(0, NUM_VERTICES - REGION_SIZE);
+        for (int i = 0; i < REGION_SIZE; ++i) {
+            // dense blendshapes move 3 out of 4 vertices of their region, sparse ones 1 out of 20 of the whole mesh
+            int index = blendshape.isDense ? blendshape.firstVertex + i : glm::linearRand(0, NUM_VERTICES - 1);
+            if ((blendshape.isDense && (i % 4) == 3) || (!blendshape.isDense && (i % 20) != 0)) {
+                continue;
+            }
+            blendshape.indices.push_back(index);
+            blendshape.vertices.push_back(glm::linearRand(glm::vec3(-0.01f), glm::vec3(0.01f)));
+            blendshape.normals.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+            blendshape.tangents.push_back(glm::linearRand(glm::vec3(-1.0f), glm::vec3(1.0f)));
+        }
+
+        int numOffsets = blendshape.isDense ? REGION_SIZE : (int)blendshape.indices.size();
+        blendshape.offsets.resize(9 * numOffsets);
+        for (size_t j = 0; j < blendshape.indices.size(); ++j) {
+            int offset = blendshape.isDense ? blendshape.indices[j] - blendshape.firstVertex : (int)j;
+            for (int c = 0; c < 3; ++c) {
+                blendshape.offsets[c * numOffsets + offset] += blendshape.vertices[j][c];
+                blendshape.offsets[(3 + c) * numOffsets + offset] += blendshape.normals[j][c];
+                blendshape.offsets[(6 + c) * numOffsets + offset] += blendshape.tangents[j][c];
+            }
+        }
+    }
+    std::vector<float> coefficients(NUM_BLENDSHAPES);
+    for (auto& coefficient : coefficients) {
+        coefficient = glm::linearRand(0.0f, 1.0f);
+    }
+    const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+
+    std::vector<BlendshapeOffsetPacked> packed1(NUM_VERTICES);
+    std::vector<BlendshapeOffsetPacked> packed2(NUM_VERTICES);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int blend = 0; blend < NUM_BLENDS; ++blend) {
+        std::vector<BlendshapeOffsetUnpacked> unpacked(NUM_VERTICES);
+        memset(unpacked.data(), 0, NUM_VERTICES * sizeof(BlendshapeOffsetUnpacked));
+        for (int b = 0; b < NUM_BLENDSHAPES; ++b) {
+            float vertexCoefficient = coefficients[b];
+            float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
+            const auto& blendshape = blendshapes[b];
+            for (size_t j = 0; j < blendshape.indices.size(); ++j) {
+                auto& offset = unpacked[blendshape.indices[j]];
+                offset.positionOffset += blendshape.vertices[j] * vertexCoefficient;
+                offset.normalOffset += blendshape.normals[j] * normalCoefficient;
+                offset.tangentOffset += blendshape.tangents[j] * normalCoefficient;
+            }
+        }
+        packBlendshapeOffsets(unpacked.data(), packed1.data(), NUM_VERTICES);
+    }
+    qint64 aosNs = timer.nsecsElapsed();
+
+    std::vector<float> accumulated(9 * NUM_VERTICES);
+    timer.restart();
+    for (int blend = 0; blend < NUM_BLENDS; ++blend) {
+        memset(accumulated.data(), 0, accumulated.size() * sizeof(float));
+        for (int b = 0; b < NUM_BLENDSHAPES; ++b) {
+            float vertexCoefficient = coefficients[b];
+            float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
+            const auto& blendshape = blendshapes[b];
+            int numOffsets = (int)blendshape.offsets.size() / 9;
+            for (int c = 0; c < 9; ++c) {
+                float coefficient = c < 3 ? vertexCoefficient : normalCoefficient;
+                float* accumulatedComponent = accumulated.data() + c * NUM_VERTICES;
+                const float* offsets = blendshape.offsets.data() + c * numOffsets;
+                if (blendshape.isDense) {
+                    accumulateBlendshapeOffsets(accumulatedComponent + blendshape.firstVertex, offsets, coefficient, numOffsets);
+                } else {
+                    for (int j = 0; j < numOffsets; ++j) {
+                        accumulatedComponent[blendshape.indices[j]] += offsets[j] * coefficient;
+                    }
+                }
+            }
+        }
+        packBlendshapeOffsetsSoA(accumulated.data(), NUM_VERTICES, packed2.data(), NUM_VERTICES);
+    }
+    qint64 soaNs = timer.nsecsElapsed();
+
+    // both blend the same, up to rounding
+    for (int i = 0; i < NUM_VERTICES; ++i) {
+        QCOMPARE_WITH_ABS_ERROR(glm::uintBitsToFloat(packed2[i].packedPosNorTan.x), glm::uintBitsToFloat(packed1[i].packedPosNorTan.x), 1.0e-5f);
+    }
+
+    qInfo() << "Blended" << NUM_VERTICES << "vertices with" << NUM_BLENDSHAPES << "blendshapes in"
+        << aosNs / (1.0e6 * NUM_BLENDS) << "ms with AoS offsets," << soaNs / (1.0e6 * NUM_BLENDS) << "ms with SoA offsets";
+}
@@ -18,6 +18,8 @@ class BlendshapePackingTests : public QObject {
     Q_OBJECT
 private slots:
     void testAVX2();
+    void testSoAAVX2();
+    void benchmarkBlending();
 };
 
 #endif // hifi_BlendshapePackingTests_h
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+#
+#  audio-shard-harness.py
+#  tools/audio-shard-harness
+#
+#  Copyright 2019 High Fidelity, Inc.
+#
+#  Distributed under the Apache License, Version 2.0.
+#  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+#
+#  Runs a local domain with its audio split across 1..N audio-mixer shards and a crowd of scripted agents spread
+#  evenly over the domain, and reports how many listeners each mixer handles and how long it spends mixing them.
+#  With sharding working, the mix time of each mixer drops with the number of mixers while the crowd stays the same.
+#
+#  Usage: python3 audio-shard-harness.py --build-dir <path to build> [--mixers 1,2,4] [--agents 64] [--width 400]
+#
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+import urllib.request
+import uuid
+
+DOMAIN_HTTP_PORT = 40100
+SETTLE_SECONDS = 20
+SAMPLE_SECONDS = 30
+
+AGENT_SCRIPT = """
+var width = %(width)f;
+var position = { x: (Math.random() - 0.5) * width, y: 0, z: (Math.random() - 0.5) * width };
+var sound = %(sound)s ? SoundCache.getSound(%(sound)s) : null;
+
+Agent.isAvatar = true;
+Agent.isListeningToAudioStream = true;
+Avatar.position = position;
+
+Script.update.connect(function () {
+    if (sound && sound.downloaded && !Agent.isPlayingAvatarSound) {
+        Agent.playAvatarSound(sound);
+    }
+});
+"""
+
+
+def findExecutable(buildDir, name):
+    for root, dirs, files in os.walk(buildDir):
+        for candidate in (name, name + ".exe"):
+            if candidate in files:
+                return os.path.join(root, candidate)
+    sys.exit("Could not find " + name + " in " + buildDir)
+
+
+def domainRequest(path, data=None, headers={}, method=None):
+    request = urllib.request.Request("http://localhost:%d%s" % (DOMAIN_HTTP_PORT, path), data, headers, method=method)
+    with urllib.request.urlopen(request, timeout=10) as response:
+        return response.read()
+
+
+def waitForDomain():
+    for attempt in range(60):
+        try:
+            domainRequest("/nodes.json")
+            return
+        except Exception:
+            time.sleep(1)
+    sys.exit("The domain-server did not come up")
+
+
+def shardSettings(numMixers, width):
+    # split the domain into vertical strips, one per mixer
+    stripWidth = width / numMixers
+    shards = []
+    for shard in range(numMixers):
+        xMin = -width / 2 + shard * stripWidth
+        shards.append({
+            "x_min": str(xMin), "x_max": str(xMin + stripWidth),
+            "z_min": str(-width / 2), "z_max": str(width / 2)
+        })
+    return { "audio_sharding": { "shards": shards if numMixers > 1 else [] } }
+
+
+def postAgents(numAgents, width, soundURL):
+    script = AGENT_SCRIPT % { "width": width, "sound": json.dumps(soundURL) }
+    boundary = uuid.uuid4().hex
+    body = ("--%s\r\nContent-Disposition: form-data; name=\"script\"; filename=\"agent.js\"\r\n"
+            "Content-Type: application/javascript\r\n\r\n%s\r\n--%s--\r\n") % (boundary, script, boundary)
+    domainRequest("/assignment", body.encode("utf-8"), {
+        "Content-Type": "multipart/form-data; boundary=" + boundary,
+        "ASSIGNMENT-INSTANCES": str(numAgents)
+    })
+
+
+def sampleMixers():
+    nodes = json.loads(domainRequest("/nodes.json"))["nodes"]
+    samples = []
+    for node in nodes:
+        if node["type"] != "audio-mixer":
+            continue
+        stats = json.loads(domainRequest("/nodes/%s.json" % node["uuid"]))
+        timing = stats.get("avg_timing_stats", {})
+        samples.append({
+            "shard": stats.get("shard", 0),
+            "listeners": float(stats.get("avg_listeners_per_frame", 0)),
+            "us_per_mix": float(timing.get("us_per_mix", 0))
+        })
+    return sorted(samples, key=lambda sample: sample["shard"])
+
+
+def runConfiguration(args, numMixers, domainServer, assignmentClient):
+    processes = []
+    try:
+        processes.append(subprocess.Popen([domainServer], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL))
+        waitForDomain()
+
+        # changing the shards restarts the domain-server so it creates one mixer assignment per shard
+        domainRequest("/settings.json", json.dumps(shardSettings(numMixers, args.width)).encode("utf-8"),
+                      { "Content-Type": "application/json" })
+        time.sleep(3)
+        waitForDomain()
+
+        def launch(arguments):
+            processes.append(subprocess.Popen([assignmentClient] + arguments,
+                                              stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL))
+
+        launch(["-t", "0", "-n", str(numMixers)])
+        launch(["-t", "1"])
+        launch(["-t", "2", "-n", str(args.agents)])
+
+        postAgents(args.agents, args.width, args.sound)
+
+        time.sleep(SETTLE_SECONDS)
+
+        # the mixers report their stats about every second, average a window of them
+        totals = {}
+        for sampleIndex in range(SAMPLE_SECONDS):
+            for sample in sampleMixers():
+                total = totals.setdefault(sample["shard"], { "listeners": 0.0, "us_per_mix": 0.0, "count": 0 })
+                total["listeners"] += sample["listeners"]
+                total["us_per_mix"] += sample["us_per_mix"]
+                total["count"] += 1
+            time.sleep(1)
+
+        return totals
+    finally:
+        for process in reversed(processes):
+            process.terminate()
+        for process in processes:
+            try:
+                process.wait(10)
+            except subprocess.TimeoutExpired:
+                process.kill()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure audio-mixer load as the domain is split across more mixers")
+    parser.add_argument("--build-dir", required=True, help="build directory containing domain-server and assignment-client")
+    parser.add_argument("--mixers", default="1,2,4", help="comma separated numbers of mixers to try")
+    parser.add_argument("--agents", type=int, default=64, help="number of scripted agents")
+    parser.add_argument("--width", type=float, default=400.0, help="width in meters of the square the agents spread over")
+    parser.add_argument("--sound", default=None, help="URL of a sound for the agents to play, they are silent otherwise")
+    args = parser.parse_args()
+
+    domainServer = findExecutable(args.build_dir, "domain-server")
+    assignmentClient = findExecutable(args.build_dir, "assignment-client")
+
+    print("%8s %6s %12s %12s %16s" % ("mixers", "shard", "listeners", "us/frame", "us/listener"))
+    for numMixers in [int(value) for value in args.mixers.split(",")]:
+        totals = runConfiguration(args, numMixers, domainServer, assignmentClient)
+        for shard, total in sorted(totals.items()):
+            count = max(total["count"], 1)
+            listeners = total["listeners"] / count
+            usPerMix = total["us_per_mix"] / count
+            usPerListener = usPerMix / listeners if listeners > 0 else 0
+            print("%8d %6d %12.1f %12.1f %16.2f" % (numMixers, shard, listeners, usPerMix, usPerListener))
+
+
+if __name__ == "__main__":
+    main()
@@ -28,8 +28,13 @@
 #include <OBJSerializer.h>
 
 #include "MaterialBaker.h"
+#include "TextureBaker.h"
 
 Oven* Oven::_staticInstance { nullptr };
+QString Oven::_bakedAssetCacheDirectory;
+bool Oven::_bakedAssetCacheEnabled { true };
+
+static const QString BAKED_ASSET_CACHE_OWNER = "oven";
 
 Oven::Oven() {
     _staticInstance = this;
@@ -54,11 +59,25 @@ Oven::Oven() {
         modelFormatRegistry->addFormat(FBXSerializer());
         modelFormatRegistry->addFormat(OBJSerializer());
     }
+
+    // reuse what was baked before, in a folder of the oven's own unless it was given one
+    if (_bakedAssetCacheEnabled) {
+        auto directory = _bakedAssetCacheDirectory.isEmpty() ?
+            cache::BakedAssetCache::getDefaultDirectory(BAKED_ASSET_CACHE_OWNER) : _bakedAssetCacheDirectory;
+        _bakedAssetCache = std::make_shared<cache::BakedAssetCache>(directory.toStdString());
+        _bakedAssetCache->initialize();
+        TextureBaker::setBakedAssetCache(_bakedAssetCache);
+    }
 }
 
 Oven::~Oven() {
     DependencyManager::get<ResourceManager>()->cleanup();
 
+    if (_bakedAssetCache) {
+        qDebug() << "Baked asset cache hits:" << _bakedAssetCache->getNumHits() << "misses:" << _bakedAssetCache->getNumMisses();
+        TextureBaker::setBakedAssetCache(nullptr);
+    }
+
     // quit all worker threads and wait on them
     for (auto& thread : _workerThreads) {
         thread->quit();
@@ -16,6 +16,10 @@
 #include <memory>
 #include <vector>
 
+#include <QtCore/QString>
+
+#include <shared/BakedAssetCache.h>
+
 class QThread;
 
 class Oven {
@@ -28,6 +32,10 @@ public:
 
     QThread* getNextWorkerThread();
 
+    // Where baked results are kept for reuse, set before the oven is created. Empty for the oven's default folder.
+    static void setBakedAssetCacheDirectory(const QString& directory) { _bakedAssetCacheDirectory = directory; }
+    static void setBakedAssetCacheEnabled(bool enabled) { _bakedAssetCacheEnabled = enabled; }
+
 private:
     void setupWorkerThreads(int numWorkerThreads);
     void setupFBXBakerThread();
@@ -37,7 +45,11 @@ private:
     std::atomic<uint32_t> _nextWorkerThreadIndex;
     int _numWorkerThreads;
 
+    cache::BakedAssetCachePointer _bakedAssetCache;
+
     static Oven* _staticInstance;
+    static QString _bakedAssetCacheDirectory;
+    static bool _bakedAssetCacheEnabled;
 };
 
 
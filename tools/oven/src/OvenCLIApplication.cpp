@@ -25,6 +25,9 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_UNIVERSAL_TEXTURE_COMPRESSION_PARAMETER = "universal-texture-compression";
+static const QString CLI_BAKED_CACHE_DIRECTORY_PARAMETER = "baked-cache-dir";
+static const QString CLI_DISABLE_BAKED_CACHE_PARAMETER = "disable-baked-cache";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
@@ -47,7 +50,10 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_UNIVERSAL_TEXTURE_COMPRESSION_PARAMETER, "Bake one universal texture transcoded by the client instead of one per GPU format." },
+        { CLI_BAKED_CACHE_DIRECTORY_PARAMETER, "Path to the folder baked results are reused from.", "directory" },
+        { CLI_DISABLE_BAKED_CACHE_PARAMETER, "Bake everything again instead of reusing baked results." }
     });
 
     auto versionOption = parser.addVersionOption();
@@ -91,4 +97,18 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         qDebug() << "Disabling texture compression";
         TextureBaker::setCompressionEnabled(false);
     }
+
+    if (parser.isSet(CLI_UNIVERSAL_TEXTURE_COMPRESSION_PARAMETER)) {
+        qDebug() << "Enabling universal texture compression";
+        TextureBaker::setUniversalCompressionEnabled(true);
+    }
+
+    if (parser.isSet(CLI_BAKED_CACHE_DIRECTORY_PARAMETER)) {
+        Oven::setBakedAssetCacheDirectory(QDir::fromNativeSeparators(parser.value(CLI_BAKED_CACHE_DIRECTORY_PARAMETER)));
+    }
+
+    if (parser.isSet(CLI_DISABLE_BAKED_CACHE_PARAMETER)) {
+        qDebug() << "Disabling the baked asset cache";
+        Oven::setBakedAssetCacheEnabled(false);
+    }
 }